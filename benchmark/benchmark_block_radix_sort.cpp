@@ -251,6 +251,7 @@ int main(int argc, char *argv[])
     cli::Parser parser(argc, argv);
     parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
     parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_bandwidth_options(parser, argc, argv);
     parser.run_and_exit_if_error();
 
     // Parse argv
@@ -287,6 +288,6 @@ int main(int argc, char *argv[])
     }
 
     // Run benchmarks
-    benchmark::RunSpecifiedBenchmarks();
+    run_benchmarks(parser);
     return 0;
 }
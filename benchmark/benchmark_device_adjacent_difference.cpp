@@ -63,6 +63,8 @@ int main(int argc, char* argv[])
     cli::Parser parser(argc, argv);
     parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
     parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_data_distribution_option(parser);
+    add_bandwidth_options(parser, argc, argv);
 #ifdef BENCHMARK_CONFIG_TUNING
     // optionally run an evenly split subset of benchmarks, when making multiple program invocations
     parser.set_optional<int>("parallel_instance",
@@ -86,6 +88,7 @@ int main(int argc, char* argv[])
 
     // Benchmark info
     add_common_benchmark_info();
+    set_data_distribution(parser);
     benchmark::AddCustomContext("size", std::to_string(size));
 
     std::vector<benchmark::internal::Benchmark*> benchmarks = {};
@@ -133,7 +136,7 @@ int main(int argc, char* argv[])
     }
 
     // Run benchmarks
-    benchmark::RunSpecifiedBenchmarks();
+    run_benchmarks(parser);
 
     return 0;
 }
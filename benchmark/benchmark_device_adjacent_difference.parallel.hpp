@@ -137,7 +137,7 @@ struct device_adjacent_difference_benchmark : public config_autotune_interface
         static constexpr bool debug_synchronous = false;
 
         // Generate data
-        const std::vector<T> input = get_random_data<T>(size, 1, 100);
+        const std::vector<T> input = get_distributed_data<T>(size, 1, 100);
 
         T*           d_input;
         output_type* d_output = nullptr;
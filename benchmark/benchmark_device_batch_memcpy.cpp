@@ -0,0 +1,232 @@
+// MIT License
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <limits>
+#include <string>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+
+// Google Benchmark
+#include "benchmark/benchmark.h"
+// CmdParser
+#include "cmdparser.hpp"
+#include "benchmark_utils.hpp"
+
+// HIP API
+#include <hip/hip_runtime.h>
+
+// rocPRIM
+#include <rocprim/rocprim.hpp>
+
+#ifndef DEFAULT_N
+const size_t DEFAULT_N = 1024 * 1024 * 32;
+#endif
+
+const unsigned int batch_size = 10;
+const unsigned int warmup_size = 5;
+
+// Copies buffers of sizes in [min_size, max_size] bytes, following the selected data
+// distribution, until about `size` bytes are copied.
+void run_batch_memcpy_benchmark(benchmark::State& state, hipStream_t stream, size_t size,
+                                size_t min_size, size_t max_size)
+{
+    std::vector<size_t> sizes;
+    std::vector<size_t> offsets;
+    size_t total_size = 0;
+    while(total_size < size)
+    {
+        // Generate about as many sizes as needed at once, so sorted distributions stay sorted
+        const std::vector<size_t> buffer_sizes
+            = get_distributed_data<size_t>(size / ((min_size + max_size) / 2) + 1,
+                                           min_size,
+                                           max_size);
+        for(size_t i = 0; i < buffer_sizes.size() && total_size < size; i++)
+        {
+            sizes.push_back(buffer_sizes[i]);
+            offsets.push_back(total_size);
+            total_size += buffer_sizes[i];
+        }
+    }
+    const unsigned int num_copies = static_cast<unsigned int>(sizes.size());
+
+    unsigned char * d_input;
+    unsigned char * d_output;
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_input), total_size));
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_output), total_size));
+
+    std::vector<void*> sources(num_copies);
+    std::vector<void*> destinations(num_copies);
+    for(unsigned int i = 0; i < num_copies; i++)
+    {
+        sources[i] = d_input + offsets[i];
+        destinations[i] = d_output + offsets[i];
+    }
+
+    void ** d_sources;
+    void ** d_destinations;
+    size_t * d_sizes;
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_sources), num_copies * sizeof(void*)));
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_destinations), num_copies * sizeof(void*)));
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_sizes), num_copies * sizeof(size_t)));
+    HIP_CHECK(
+        hipMemcpy(
+            d_sources, sources.data(),
+            num_copies * sizeof(void*),
+            hipMemcpyHostToDevice
+        )
+    );
+    HIP_CHECK(
+        hipMemcpy(
+            d_destinations, destinations.data(),
+            num_copies * sizeof(void*),
+            hipMemcpyHostToDevice
+        )
+    );
+    HIP_CHECK(
+        hipMemcpy(
+            d_sizes, sizes.data(),
+            num_copies * sizeof(size_t),
+            hipMemcpyHostToDevice
+        )
+    );
+
+    void * d_temporary_storage = nullptr;
+    size_t temporary_storage_bytes;
+    HIP_CHECK(
+        rocprim::batch_memcpy(
+            d_temporary_storage, temporary_storage_bytes,
+            d_sources, d_destinations, d_sizes, num_copies,
+            stream
+        )
+    );
+
+    HIP_CHECK(hipMalloc(&d_temporary_storage, temporary_storage_bytes));
+
+    // Warm-up
+    for(size_t i = 0; i < warmup_size; i++)
+    {
+        HIP_CHECK(
+            rocprim::batch_memcpy(
+                d_temporary_storage, temporary_storage_bytes,
+                d_sources, d_destinations, d_sizes, num_copies,
+                stream
+            )
+        );
+    }
+    HIP_CHECK(hipDeviceSynchronize());
+
+    for(auto _ : state)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for(size_t i = 0; i < batch_size; i++)
+        {
+            HIP_CHECK(
+                rocprim::batch_memcpy(
+                    d_temporary_storage, temporary_storage_bytes,
+                    d_sources, d_destinations, d_sizes, num_copies,
+                    stream
+                )
+            );
+        }
+        HIP_CHECK(hipDeviceSynchronize());
+
+        auto end = std::chrono::high_resolution_clock::now();
+        auto elapsed_seconds =
+            std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+        state.SetIterationTime(elapsed_seconds.count());
+    }
+    // Every byte is read and written once
+    state.SetBytesProcessed(state.iterations() * batch_size * total_size * 2);
+    state.SetItemsProcessed(state.iterations() * batch_size * num_copies);
+
+    HIP_CHECK(hipFree(d_temporary_storage));
+    HIP_CHECK(hipFree(d_input));
+    HIP_CHECK(hipFree(d_output));
+    HIP_CHECK(hipFree(d_sources));
+    HIP_CHECK(hipFree(d_destinations));
+    HIP_CHECK(hipFree(d_sizes));
+}
+
+#define CREATE_BATCH_MEMCPY_BENCHMARK(MIN_SIZE, MAX_SIZE) \
+benchmark::RegisterBenchmark( \
+    "batch_memcpy(" #MIN_SIZE " - " #MAX_SIZE " bytes)", \
+    [=](benchmark::State& state) { run_batch_memcpy_benchmark(state, stream, size, MIN_SIZE, MAX_SIZE); } \
+)
+
+int main(int argc, char *argv[])
+{
+    cli::Parser parser(argc, argv);
+    parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of bytes");
+    parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_data_distribution_option(parser);
+    add_bandwidth_options(parser, argc, argv);
+    parser.run_and_exit_if_error();
+
+    // Parse argv
+    benchmark::Initialize(&argc, argv);
+    const size_t size = parser.get<size_t>("size");
+    const int trials = parser.get<int>("trials");
+
+    // HIP
+    hipStream_t stream = 0; // default
+
+    // Benchmark info
+    add_common_benchmark_info();
+    set_data_distribution(parser);
+    benchmark::AddCustomContext("size", std::to_string(size));
+
+    // Add benchmarks
+    std::vector<benchmark::internal::Benchmark*> benchmarks =
+    {
+        CREATE_BATCH_MEMCPY_BENCHMARK(1, 64),
+        CREATE_BATCH_MEMCPY_BENCHMARK(64, 1024),
+        CREATE_BATCH_MEMCPY_BENCHMARK(1024, 8192),
+        CREATE_BATCH_MEMCPY_BENCHMARK(8192, 65536),
+        CREATE_BATCH_MEMCPY_BENCHMARK(65536, 1048576),
+        CREATE_BATCH_MEMCPY_BENCHMARK(1, 1048576)
+    };
+
+    // Use manual timing
+    for(auto& b : benchmarks)
+    {
+        b->UseManualTime();
+        b->Unit(benchmark::kMillisecond);
+    }
+
+    // Force number of iterations
+    if(trials > 0)
+    {
+        for(auto& b : benchmarks)
+        {
+            b->Iterations(trials);
+        }
+    }
+
+    // Run benchmarks
+    run_benchmarks(parser);
+    return 0;
+}
@@ -50,7 +50,7 @@ const unsigned int warmup_size = 5;
 template<class T>
 void run_lower_bound_benchmark(benchmark::State& state, hipStream_t stream,
                                size_t haystack_size, size_t needles_size,
-                               bool sorted_needles)
+                               bool sorted_needles, bool merge_search)
 {
     using haystack_type = T;
     using needle_type = T;
@@ -62,7 +62,7 @@ void run_lower_bound_benchmark(benchmark::State& state, hipStream_t stream,
     std::vector<haystack_type> haystack(haystack_size);
     std::iota(haystack.begin(), haystack.end(), 0);
 
-    std::vector<needle_type> needles = get_random_data<needle_type>(
+    std::vector<needle_type> needles = get_distributed_data<needle_type>(
         needles_size, needle_type(0), needle_type(haystack_size)
     );
     if(sorted_needles)
@@ -91,32 +91,37 @@ void run_lower_bound_benchmark(benchmark::State& state, hipStream_t stream,
         )
     );
 
-    void * d_temporary_storage = nullptr;
-    size_t temporary_storage_bytes;
-    HIP_CHECK(
-        rocprim::lower_bound(
+    auto run = [&](void * d_temporary_storage, size_t& temporary_storage_bytes)
+    {
+        if(merge_search)
+        {
+            return rocprim::sorted_lower_bound(
+                d_temporary_storage, temporary_storage_bytes,
+                d_haystack, d_needles, d_output,
+                haystack_size, needles_size,
+                compare_op,
+                stream
+            );
+        }
+        return rocprim::lower_bound(
             d_temporary_storage, temporary_storage_bytes,
             d_haystack, d_needles, d_output,
             haystack_size, needles_size,
             compare_op,
             stream
-        )
-    );
+        );
+    };
+
+    void * d_temporary_storage = nullptr;
+    size_t temporary_storage_bytes;
+    HIP_CHECK(run(d_temporary_storage, temporary_storage_bytes));
 
     HIP_CHECK(hipMalloc(&d_temporary_storage, temporary_storage_bytes));
 
     // Warm-up
     for(size_t i = 0; i < warmup_size; i++)
     {
-        HIP_CHECK(
-            rocprim::lower_bound(
-                d_temporary_storage, temporary_storage_bytes,
-                d_haystack, d_needles, d_output,
-                haystack_size, needles_size,
-                compare_op,
-                stream
-            )
-        );
+        HIP_CHECK(run(d_temporary_storage, temporary_storage_bytes));
     }
     HIP_CHECK(hipDeviceSynchronize());
 
@@ -126,15 +131,7 @@ void run_lower_bound_benchmark(benchmark::State& state, hipStream_t stream,
 
         for(size_t i = 0; i < batch_size; i++)
         {
-            HIP_CHECK(
-                rocprim::lower_bound(
-                    d_temporary_storage, temporary_storage_bytes,
-                    d_haystack, d_needles, d_output,
-                    haystack_size, needles_size,
-                    compare_op,
-                    stream
-                )
-            );
+            HIP_CHECK(run(d_temporary_storage, temporary_storage_bytes));
         }
         HIP_CHECK(hipDeviceSynchronize());
 
@@ -158,18 +155,31 @@ benchmark::RegisterBenchmark( \
         std::string("lower_bound") + "<" #T ">(" #K "\% " + \
         (SORTED ? "sorted" : "random") + " needles)" \
     ).c_str(), \
-    [=](benchmark::State& state) { run_lower_bound_benchmark<T>(state, stream, size, size * K / 100, SORTED); } \
+    [=](benchmark::State& state) { run_lower_bound_benchmark<T>(state, stream, size, size * K / 100, SORTED, false); } \
+)
+
+#define CREATE_SORTED_LOWER_BOUND_BENCHMARK(T, K) \
+benchmark::RegisterBenchmark( \
+    ( \
+        std::string("sorted_lower_bound") + "<" #T ">(" #K "\% sorted needles)" \
+    ).c_str(), \
+    [=](benchmark::State& state) { run_lower_bound_benchmark<T>(state, stream, size, size * K / 100, true, true); } \
 )
 
 #define BENCHMARK_TYPE(type) \
     CREATE_LOWER_BOUND_BENCHMARK(type, 10, false), \
-    CREATE_LOWER_BOUND_BENCHMARK(type, 10, true)
+    CREATE_LOWER_BOUND_BENCHMARK(type, 10, true), \
+    CREATE_LOWER_BOUND_BENCHMARK(type, 100, true), \
+    CREATE_SORTED_LOWER_BOUND_BENCHMARK(type, 10), \
+    CREATE_SORTED_LOWER_BOUND_BENCHMARK(type, 100)
 
 int main(int argc, char *argv[])
 {
     cli::Parser parser(argc, argv);
     parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
     parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_data_distribution_option(parser);
+    add_bandwidth_options(parser, argc, argv);
     parser.run_and_exit_if_error();
 
     // Parse argv
@@ -182,6 +192,7 @@ int main(int argc, char *argv[])
 
     // Benchmark info
     add_common_benchmark_info();
+    set_data_distribution(parser);
     benchmark::AddCustomContext("size", std::to_string(size));
 
     using custom_float2 = custom_type<float, float>;
@@ -216,6 +227,6 @@ int main(int argc, char *argv[])
     }
 
     // Run benchmarks
-    benchmark::RunSpecifiedBenchmarks();
+    run_benchmarks(parser);
     return 0;
 }
@@ -0,0 +1,220 @@
+// MIT License
+//
+// Copyright (c) 2017-2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// HIP API
+#include <hip/hip_runtime.h>
+
+// rocPRIM HIP API
+#include <rocprim/rocprim.hpp>
+
+// CmdParser
+#include "cmdparser.hpp"
+
+#include "benchmark_utils.hpp"
+
+#ifndef DEFAULT_N
+const size_t DEFAULT_N = 1024 * 1024 * 128;
+#endif
+
+template<class T>
+struct equal_to_value
+{
+    T value;
+
+    ROCPRIM_HOST_DEVICE
+    bool operator()(const T& a) const
+    {
+        return a == value;
+    }
+};
+
+// The searched item is placed at hit_ratio * size, or not placed at all if hit_ratio is 1
+template<typename T = int, typename Config = rocprim::default_config>
+struct device_find_benchmark : public config_autotune_interface
+{
+    double      hit_ratio;
+    std::string hit_name;
+
+    device_find_benchmark(double hit_ratio, std::string hit_name)
+        : hit_ratio(hit_ratio), hit_name(std::move(hit_name))
+    {}
+
+    std::string name() const override
+    {
+        return std::string("device_find_if<" + std::string(Traits<T>::name())
+                           + ", hit_position=" + hit_name + ">");
+    }
+
+    static constexpr unsigned int batch_size  = 10;
+    static constexpr unsigned int warmup_size = 5;
+
+    void run(benchmark::State& state, size_t size, const hipStream_t stream) const override
+    {
+        const size_t hit_position = static_cast<size_t>(hit_ratio * size);
+
+        // Values in [1; 100], the searched value 0 is only present at hit_position
+        std::vector<T> input = get_distributed_data<T>(size, T(1), T(100));
+        if(hit_position < size)
+        {
+            input[hit_position] = T(0);
+        }
+        const equal_to_value<T> predicate{T(0)};
+
+        T*      d_input;
+        size_t* d_output;
+        HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_input), size * sizeof(T)));
+        HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_output), sizeof(size_t)));
+        HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(T), hipMemcpyHostToDevice));
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Allocate temporary storage memory
+        size_t temp_storage_size_bytes;
+        void*  d_temp_storage = nullptr;
+        // Get size of d_temp_storage
+        HIP_CHECK(rocprim::find_if<Config>(d_temp_storage,
+                                           temp_storage_size_bytes,
+                                           d_input,
+                                           d_output,
+                                           size,
+                                           predicate,
+                                           stream));
+        HIP_CHECK(hipMalloc(&d_temp_storage, temp_storage_size_bytes));
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Warm-up
+        for(size_t i = 0; i < warmup_size; i++)
+        {
+            HIP_CHECK(rocprim::find_if<Config>(d_temp_storage,
+                                               temp_storage_size_bytes,
+                                               d_input,
+                                               d_output,
+                                               size,
+                                               predicate,
+                                               stream));
+        }
+        HIP_CHECK(hipDeviceSynchronize());
+
+        for(auto _ : state)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+
+            for(size_t i = 0; i < batch_size; i++)
+            {
+                HIP_CHECK(rocprim::find_if<Config>(d_temp_storage,
+                                                   temp_storage_size_bytes,
+                                                   d_input,
+                                                   d_output,
+                                                   size,
+                                                   predicate,
+                                                   stream));
+            }
+            HIP_CHECK(hipStreamSynchronize(stream));
+
+            auto end = std::chrono::high_resolution_clock::now();
+            auto elapsed_seconds
+                = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+            state.SetIterationTime(elapsed_seconds.count());
+        }
+        // Only the items before the hit need to be read
+        const size_t searched_size = std::min(hit_position + 1, size);
+        state.SetBytesProcessed(state.iterations() * batch_size * searched_size * sizeof(T));
+        state.SetItemsProcessed(state.iterations() * batch_size * searched_size);
+
+        HIP_CHECK(hipFree(d_input));
+        HIP_CHECK(hipFree(d_output));
+        HIP_CHECK(hipFree(d_temp_storage));
+    }
+};
+
+#define CREATE_BENCHMARK(T, HIT_RATIO, HIT_NAME)                      \
+    {                                                                 \
+        const device_find_benchmark<T> instance(HIT_RATIO, HIT_NAME); \
+        REGISTER_BENCHMARK(benchmarks, size, stream, instance);       \
+    }
+
+#define CREATE_BENCHMARKS(T)                     \
+    CREATE_BENCHMARK(T, 0.0, "front")            \
+    CREATE_BENCHMARK(T, 0.01, "1%")              \
+    CREATE_BENCHMARK(T, 0.5, "middle")           \
+    CREATE_BENCHMARK(T, 1.0, "none")
+
+int main(int argc, char* argv[])
+{
+    cli::Parser parser(argc, argv);
+    parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
+    parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_data_distribution_option(parser);
+    add_bandwidth_options(parser, argc, argv);
+    parser.run_and_exit_if_error();
+
+    // Parse argv
+    benchmark::Initialize(&argc, argv);
+    const size_t size   = parser.get<size_t>("size");
+    const int    trials = parser.get<int>("trials");
+
+    // HIP
+    hipStream_t stream = 0; // default
+
+    // Benchmark info
+    add_common_benchmark_info();
+    set_data_distribution(parser);
+    benchmark::AddCustomContext("size", std::to_string(size));
+
+    // Add benchmarks
+    std::vector<benchmark::internal::Benchmark*> benchmarks = {};
+
+    CREATE_BENCHMARKS(int)
+    CREATE_BENCHMARKS(long long)
+    CREATE_BENCHMARKS(float)
+    CREATE_BENCHMARKS(double)
+    CREATE_BENCHMARKS(uint8_t)
+
+    // Use manual timing
+    for(auto& b : benchmarks)
+    {
+        b->UseManualTime();
+        b->Unit(benchmark::kMillisecond);
+    }
+
+    // Force number of iterations
+    if(trials > 0)
+    {
+        for(auto& b : benchmarks)
+        {
+            b->Iterations(trials);
+        }
+    }
+
+    // Run benchmarks
+    run_benchmarks(parser);
+
+    return 0;
+}
@@ -183,6 +183,99 @@ void run_even_benchmark(benchmark::State& state,
     HIP_CHECK(hipFree(d_histogram));
 }
 
+template<class T, class Weight>
+void run_weighted_even_benchmark(benchmark::State& state,
+                                 size_t            bins,
+                                 size_t            scale,
+                                 int               entropy_reduction,
+                                 hipStream_t       stream,
+                                 size_t            size)
+{
+    const T lower_level = 0;
+    const T upper_level = bins * scale;
+
+    // Generate data
+    std::vector<T>      input   = generate<T>(size, entropy_reduction, lower_level, upper_level);
+    std::vector<Weight> weights = get_random_data<Weight>(size, Weight(0), Weight(1));
+
+    T*      d_input;
+    Weight* d_weights;
+    Weight* d_histogram;
+    HIP_CHECK(hipMalloc(&d_input, size * sizeof(T)));
+    HIP_CHECK(hipMalloc(&d_weights, size * sizeof(Weight)));
+    HIP_CHECK(hipMalloc(&d_histogram, bins * sizeof(Weight)));
+    HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(T), hipMemcpyHostToDevice));
+    HIP_CHECK(
+        hipMemcpy(d_weights, weights.data(), size * sizeof(Weight), hipMemcpyHostToDevice));
+
+    void*  d_temporary_storage     = nullptr;
+    size_t temporary_storage_bytes = 0;
+    HIP_CHECK(rp::histogram_even(d_temporary_storage,
+                                 temporary_storage_bytes,
+                                 d_input,
+                                 d_weights,
+                                 size,
+                                 d_histogram,
+                                 bins + 1,
+                                 lower_level,
+                                 upper_level,
+                                 stream,
+                                 false));
+
+    HIP_CHECK(hipMalloc(&d_temporary_storage, temporary_storage_bytes));
+    HIP_CHECK(hipDeviceSynchronize());
+
+    // Warm-up
+    for(size_t i = 0; i < warmup_size; i++)
+    {
+        HIP_CHECK(rp::histogram_even(d_temporary_storage,
+                                     temporary_storage_bytes,
+                                     d_input,
+                                     d_weights,
+                                     size,
+                                     d_histogram,
+                                     bins + 1,
+                                     lower_level,
+                                     upper_level,
+                                     stream,
+                                     false));
+    }
+    HIP_CHECK(hipDeviceSynchronize());
+
+    for(auto _ : state)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for(size_t i = 0; i < batch_size; i++)
+        {
+            HIP_CHECK(rp::histogram_even(d_temporary_storage,
+                                         temporary_storage_bytes,
+                                         d_input,
+                                         d_weights,
+                                         size,
+                                         d_histogram,
+                                         bins + 1,
+                                         lower_level,
+                                         upper_level,
+                                         stream,
+                                         false));
+        }
+        HIP_CHECK(hipDeviceSynchronize());
+
+        auto end = std::chrono::high_resolution_clock::now();
+        auto elapsed_seconds
+            = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+        state.SetIterationTime(elapsed_seconds.count());
+    }
+    state.SetBytesProcessed(state.iterations() * batch_size * size * (sizeof(T) + sizeof(Weight)));
+    state.SetItemsProcessed(state.iterations() * batch_size * size);
+
+    HIP_CHECK(hipFree(d_temporary_storage));
+    HIP_CHECK(hipFree(d_input));
+    HIP_CHECK(hipFree(d_weights));
+    HIP_CHECK(hipFree(d_histogram));
+}
+
 template<class T, unsigned int Channels, unsigned int ActiveChannels>
 void run_multi_even_benchmark(benchmark::State& state,
                               size_t            bins,
@@ -289,7 +382,7 @@ void run_range_benchmark(benchmark::State& state, size_t bins, hipStream_t strea
     using counter_type = unsigned int;
 
     // Generate data
-    std::vector<T> input = get_random_data<T>(size, 0, bins);
+    std::vector<T> input = get_distributed_data<T>(size, 0, bins);
 
     std::vector<T> levels(bins + 1);
     std::iota(levels.begin(), levels.end(), 0);
@@ -384,7 +477,7 @@ void run_multi_range_benchmark(benchmark::State& state,
     }
 
     // Generate data
-    std::vector<T> input = get_random_data<T>(size * Channels, 0, bins);
+    std::vector<T> input = get_distributed_data<T>(size * Channels, 0, bins);
 
     T*            d_input;
     T*            d_levels[ActiveChannels];
@@ -500,13 +593,15 @@ struct num_limits<rocprim::half>
             { run_even_benchmark<T>(state, BINS, SCALE, entropy_reduction, stream, size); })); \
     }
 
-#define BENCHMARK_TYPE(VECTOR, T)                 \
-    CREATE_EVEN_BENCHMARK(VECTOR, T, 10, 1234);   \
-    CREATE_EVEN_BENCHMARK(VECTOR, T, 100, 1234);  \
-    CREATE_EVEN_BENCHMARK(VECTOR, T, 1000, 1234); \
-    CREATE_EVEN_BENCHMARK(VECTOR, T, 16, 10);     \
-    CREATE_EVEN_BENCHMARK(VECTOR, T, 256, 10);    \
-    CREATE_EVEN_BENCHMARK(VECTOR, T, 65536, 1)
+#define BENCHMARK_TYPE(VECTOR, T)                  \
+    CREATE_EVEN_BENCHMARK(VECTOR, T, 10, 1234);    \
+    CREATE_EVEN_BENCHMARK(VECTOR, T, 100, 1234);   \
+    CREATE_EVEN_BENCHMARK(VECTOR, T, 1000, 1234);  \
+    CREATE_EVEN_BENCHMARK(VECTOR, T, 16, 10);      \
+    CREATE_EVEN_BENCHMARK(VECTOR, T, 256, 10);     \
+    CREATE_EVEN_BENCHMARK(VECTOR, T, 16384, 1);    \
+    CREATE_EVEN_BENCHMARK(VECTOR, T, 65536, 1);    \
+    CREATE_EVEN_BENCHMARK(VECTOR, T, 1048576, 1)
 
 void add_even_benchmarks(std::vector<benchmark::internal::Benchmark*>& benchmarks,
                          hipStream_t                                   stream,
@@ -524,6 +619,41 @@ void add_even_benchmarks(std::vector<benchmark::internal::Benchmark*>& benchmark
     };
 }
 
+#define CREATE_WEIGHTED_EVEN_BENCHMARK(VECTOR, T, WEIGHT, BINS, SCALE)                       \
+    VECTOR.push_back(benchmark::RegisterBenchmark(                                           \
+        (std::string("histogram_even_weighted") + "<" #T ", " #WEIGHT ">" + "("              \
+         + std::to_string(get_entropy_percents(entropy_reduction)) + "% entropy, "           \
+         + std::to_string(BINS) + " bins)")                                                  \
+            .c_str(),                                                                        \
+        [=](benchmark::State& state)                                                         \
+        {                                                                                    \
+            run_weighted_even_benchmark<T, WEIGHT>(state,                                    \
+                                                   BINS,                                     \
+                                                   SCALE,                                    \
+                                                   entropy_reduction,                        \
+                                                   stream,                                   \
+                                                   size);                                    \
+        }))
+
+#define BENCHMARK_WEIGHTED_TYPE(VECTOR, T, WEIGHT)                 \
+    CREATE_WEIGHTED_EVEN_BENCHMARK(VECTOR, T, WEIGHT, 10, 1234);   \
+    CREATE_WEIGHTED_EVEN_BENCHMARK(VECTOR, T, WEIGHT, 256, 10);    \
+    CREATE_WEIGHTED_EVEN_BENCHMARK(VECTOR, T, WEIGHT, 4096, 10);   \
+    CREATE_WEIGHTED_EVEN_BENCHMARK(VECTOR, T, WEIGHT, 65536, 10)
+
+// Entropy reductions cover uniform (100%) to skewed samples (0%, all samples in one bin)
+void add_weighted_even_benchmarks(std::vector<benchmark::internal::Benchmark*>& benchmarks,
+                                  hipStream_t                                   stream,
+                                  size_t                                        size)
+{
+    for(int entropy_reduction : entropy_reductions)
+    {
+        BENCHMARK_WEIGHTED_TYPE(benchmarks, int, float);
+        BENCHMARK_WEIGHTED_TYPE(benchmarks, int, double);
+        BENCHMARK_WEIGHTED_TYPE(benchmarks, float, float);
+    };
+}
+
 #define CREATE_MULTI_EVEN_BENCHMARK(CHANNELS, ACTIVE_CHANNELS, T, BINS, SCALE)                 \
     benchmark::RegisterBenchmark(                                                              \
         (std::string("multi_histogram_even") + "<" #CHANNELS ", " #ACTIVE_CHANNELS ", " #T ">" \
@@ -608,6 +738,8 @@ int main(int argc, char* argv[])
     cli::Parser parser(argc, argv);
     parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
     parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_data_distribution_option(parser);
+    add_bandwidth_options(parser, argc, argv);
     parser.run_and_exit_if_error();
 
     // Parse argv
@@ -620,11 +752,13 @@ int main(int argc, char* argv[])
 
     // Benchmark info
     add_common_benchmark_info();
+    set_data_distribution(parser);
     benchmark::AddCustomContext("size", std::to_string(size));
 
     // Add benchmarks
     std::vector<benchmark::internal::Benchmark*> benchmarks;
     add_even_benchmarks(benchmarks, stream, size);
+    add_weighted_even_benchmarks(benchmarks, stream, size);
     add_multi_even_benchmarks(benchmarks, stream, size);
     add_range_benchmarks(benchmarks, stream, size);
     add_multi_range_benchmarks(benchmarks, stream, size);
@@ -646,6 +780,6 @@ int main(int argc, char* argv[])
     }
 
     // Run benchmarks
-    benchmark::RunSpecifiedBenchmarks();
+    run_benchmarks(parser);
     return 0;
 }
@@ -339,11 +339,11 @@ void run_benchmark(benchmark::State& state,
     std::vector<T> input;
     if(std::is_floating_point<T>::value)
     {
-        input = get_random_data<T>(size, (T)-1000, (T)+1000);
+        input = get_distributed_data<T>(size, (T)-1000, (T)+1000);
     }
     else
     {
-        input = get_random_data<T>(
+        input = get_distributed_data<T>(
             size,
             std::numeric_limits<T>::min(),
             std::numeric_limits<T>::max()
@@ -410,11 +410,11 @@ void run_benchmark_memcpy(benchmark::State& state,
     std::vector<T> input;
     if(std::is_floating_point<T>::value)
     {
-        input = get_random_data<T>(size, (T)-1000, (T)+1000);
+        input = get_distributed_data<T>(size, (T)-1000, (T)+1000);
     }
     else
     {
-        input = get_random_data<T>(
+        input = get_distributed_data<T>(
             size,
             std::numeric_limits<T>::min(),
             std::numeric_limits<T>::max()
@@ -476,6 +476,8 @@ int main(int argc, char *argv[])
 {
     cli::Parser parser(argc, argv);
     parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_data_distribution_option(parser);
+    add_bandwidth_options(parser, argc, argv);
     parser.run_and_exit_if_error();
 
     // Parse argv
@@ -487,6 +489,7 @@ int main(int argc, char *argv[])
 
     // Benchmark info
     add_common_benchmark_info();
+    set_data_distribution(parser);
 
     // Add benchmarks
     std::vector<benchmark::internal::Benchmark*> benchmarks =
@@ -968,7 +971,7 @@ int main(int argc, char *argv[])
     }
 
     // Run benchmarks
-    benchmark::RunSpecifiedBenchmarks();
+    run_benchmarks(parser);
 
     return 0;
 }
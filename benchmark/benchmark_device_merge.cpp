@@ -61,8 +61,8 @@ void run_merge_keys_benchmark(benchmark::State& state, hipStream_t stream, size_
     compare_op_type compare_op;
 
     // Generate data
-    std::vector<key_type> keys_input1 = get_random_data<key_type>(size1, 0, size);
-    std::vector<key_type> keys_input2 = get_random_data<key_type>(size2, 0, size);
+    std::vector<key_type> keys_input1 = get_distributed_data<key_type>(size1, 0, size);
+    std::vector<key_type> keys_input2 = get_distributed_data<key_type>(size2, 0, size);
     std::sort(keys_input1.begin(), keys_input1.end(), compare_op);
     std::sort(keys_input2.begin(), keys_input2.end(), compare_op);
 
@@ -155,8 +155,8 @@ void run_merge_pairs_benchmark(benchmark::State& state, hipStream_t stream, size
     compare_op_type compare_op;
 
     // Generate data
-    std::vector<key_type> keys_input1 = get_random_data<key_type>(size1, 0, size);
-    std::vector<key_type> keys_input2 = get_random_data<key_type>(size2, 0, size);
+    std::vector<key_type> keys_input1 = get_distributed_data<key_type>(size1, 0, size);
+    std::vector<key_type> keys_input2 = get_distributed_data<key_type>(size2, 0, size);
     std::sort(keys_input1.begin(), keys_input1.end(), compare_op);
     std::sort(keys_input2.begin(), keys_input2.end(), compare_op);
     std::vector<value_type> values_input1(size1);
@@ -273,6 +273,8 @@ int main(int argc, char *argv[])
     cli::Parser parser(argc, argv);
     parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
     parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_data_distribution_option(parser);
+    add_bandwidth_options(parser, argc, argv);
     parser.run_and_exit_if_error();
 
     // Parse argv
@@ -285,6 +287,7 @@ int main(int argc, char *argv[])
 
     // Benchmark info
     add_common_benchmark_info();
+    set_data_distribution(parser);
     benchmark::AddCustomContext("size", std::to_string(size));
 
     using custom_int2 = custom_type<int, int>;
@@ -329,6 +332,6 @@ int main(int argc, char *argv[])
     }
 
     // Run benchmarks
-    benchmark::RunSpecifiedBenchmarks();
+    run_benchmarks(parser);
     return 0;
 }
@@ -53,6 +53,8 @@ int main(int argc, char *argv[])
     cli::Parser parser(argc, argv);
     parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
     parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_data_distribution_option(parser);
+    add_bandwidth_options(parser, argc, argv);
 #ifdef BENCHMARK_CONFIG_TUNING
     // optionally run an evenly split subset of benchmarks, when making multiple program invocations
     parser.set_optional<int>("parallel_instance",
@@ -76,6 +78,7 @@ int main(int argc, char *argv[])
 
     // Benchmark info
     add_common_benchmark_info();
+    set_data_distribution(parser);
     benchmark::AddCustomContext("size", std::to_string(size));
 
     // Add benchmarks
@@ -103,6 +106,7 @@ int main(int argc, char *argv[])
     using custom_int2            = custom_type<int, int>;
     using custom_char_double     = custom_type<char, double>;
     using custom_longlong_double = custom_type<long long, double>;
+    using custom_double8         = custom_array_type<double, 8>;
 
     CREATE_BENCHMARK(int, float)
     CREATE_BENCHMARK(long long, double)
@@ -112,6 +116,7 @@ int main(int argc, char *argv[])
     CREATE_BENCHMARK(short, short)
     CREATE_BENCHMARK(int, custom_float2)
     CREATE_BENCHMARK(long long, custom_double2)
+    CREATE_BENCHMARK(int, custom_double8)
     CREATE_BENCHMARK(custom_double2, custom_double2)
     CREATE_BENCHMARK(custom_int2, custom_double2)
     CREATE_BENCHMARK(custom_int2, custom_char_double)
@@ -135,6 +140,6 @@ int main(int argc, char *argv[])
     }
 
     // Run benchmarks
-    benchmark::RunSpecifiedBenchmarks();
+    run_benchmarks(parser);
     return 0;
 }
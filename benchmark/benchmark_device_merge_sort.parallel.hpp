@@ -80,13 +80,14 @@ struct device_merge_sort_benchmark : public config_autotune_interface
         std::vector<key_type> keys_input;
         if(std::is_floating_point<key_type>::value)
         {
-            keys_input = get_random_data<key_type>(size, (key_type)-1000, (key_type) + 1000);
+            keys_input
+                = get_distributed_data<key_type>(size, (key_type)-1000, (key_type) + 1000);
         }
         else
         {
-            keys_input = get_random_data<key_type>(size,
-                                                   std::numeric_limits<key_type>::min(),
-                                                   std::numeric_limits<key_type>::max());
+            keys_input = get_distributed_data<key_type>(size,
+                                                        std::numeric_limits<key_type>::min(),
+                                                        std::numeric_limits<key_type>::max());
         }
 
         key_type* d_keys_input;
@@ -170,13 +171,14 @@ struct device_merge_sort_benchmark : public config_autotune_interface
         std::vector<key_type> keys_input;
         if(std::is_floating_point<key_type>::value)
         {
-            keys_input = get_random_data<key_type>(size, (key_type)-1000, (key_type) + 1000);
+            keys_input
+                = get_distributed_data<key_type>(size, (key_type)-1000, (key_type) + 1000);
         }
         else
         {
-            keys_input = get_random_data<key_type>(size,
-                                                   std::numeric_limits<key_type>::min(),
-                                                   std::numeric_limits<key_type>::max());
+            keys_input = get_distributed_data<key_type>(size,
+                                                        std::numeric_limits<key_type>::min(),
+                                                        std::numeric_limits<key_type>::max());
         }
 
         std::vector<value_type> values_input(size);
@@ -56,11 +56,11 @@ void run_flagged_benchmark(benchmark::State& state,
     std::vector<FlagType> flags = get_random_data01<FlagType>(size, true_probability);
     if(std::is_floating_point<T>::value)
     {
-        input = get_random_data<T>(size, T(-1000), T(1000));
+        input = get_distributed_data<T>(size, T(-1000), T(1000));
     }
     else
     {
-        input = get_random_data<T>(
+        input = get_distributed_data<T>(
             size,
             std::numeric_limits<T>::min(),
             std::numeric_limits<T>::max()
@@ -173,7 +173,7 @@ void run_if_benchmark(benchmark::State& state,
         return false;
     };
 
-    std::vector<T> input = get_random_data<T>(size, T(0), T(127));
+    std::vector<T> input = get_distributed_data<T>(size, T(0), T(127));
     T * d_input;
     T * d_output;
     unsigned int * d_selected_count_output;
@@ -274,7 +274,7 @@ void run_three_way_benchmark(benchmark::State& state,
         return value < T(127 * second_probability);
     };
 
-    std::vector<T> input = get_random_data<T>(size, T(0), T(127));
+    std::vector<T> input = get_distributed_data<T>(size, T(0), T(127));
     T * d_input;
     T * d_output_first;
     T * d_output_second;
@@ -415,6 +415,8 @@ int main(int argc, char *argv[])
     cli::Parser parser(argc, argv);
     parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
     parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_data_distribution_option(parser);
+    add_bandwidth_options(parser, argc, argv);
     parser.run_and_exit_if_error();
 
     // Parse argv
@@ -427,6 +429,7 @@ int main(int argc, char *argv[])
 
     // Benchmark info
     add_common_benchmark_info();
+    set_data_distribution(parser);
     benchmark::AddCustomContext("size", std::to_string(size));
 
     using custom_double2 = custom_type<double, double>;
@@ -477,7 +480,7 @@ int main(int argc, char *argv[])
     }
 
     // Run benchmarks
-    benchmark::RunSpecifiedBenchmarks();
+    run_benchmarks(parser);
 
     return 0;
 }
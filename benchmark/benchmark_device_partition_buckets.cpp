@@ -0,0 +1,195 @@
+// MIT License
+//
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <limits>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+
+// Google Benchmark
+#include "benchmark/benchmark.h"
+// CmdParser
+#include "cmdparser.hpp"
+#include "benchmark_utils.hpp"
+
+// HIP API
+#include <hip/hip_runtime.h>
+
+// rocPRIM
+#include <rocprim/rocprim.hpp>
+
+#ifndef DEFAULT_N
+const size_t DEFAULT_N = 1024 * 1024 * 32;
+#endif
+
+const unsigned int batch_size = 10;
+const unsigned int warmup_size = 5;
+
+template<class T>
+struct mod_bucket_op
+{
+    unsigned int num_buckets;
+
+    __device__
+    unsigned int operator()(const T& value) const
+    {
+        return static_cast<unsigned int>(value) % num_buckets;
+    }
+};
+
+template<class T>
+void run_partition_buckets_benchmark(benchmark::State& state,
+                                     hipStream_t stream,
+                                     size_t size,
+                                     unsigned int num_buckets)
+{
+    std::vector<T> input = get_distributed_data<T>(size, T(0), T(100));
+
+    T * d_input;
+    T * d_output;
+    size_t * d_offsets;
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_input), size * sizeof(T)));
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_output), size * sizeof(T)));
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_offsets), (num_buckets + 1) * sizeof(size_t)));
+    HIP_CHECK(
+        hipMemcpy(
+            d_input, input.data(),
+            size * sizeof(T),
+            hipMemcpyHostToDevice
+        )
+    );
+
+    const mod_bucket_op<T> bucket_op{num_buckets};
+
+    auto run = [&](void * d_temporary_storage, size_t& temporary_storage_bytes)
+    {
+        return rocprim::partition_buckets(
+            d_temporary_storage, temporary_storage_bytes,
+            d_input, d_output, d_offsets,
+            size, num_buckets, bucket_op,
+            stream
+        );
+    };
+
+    void * d_temporary_storage = nullptr;
+    size_t temporary_storage_bytes;
+    HIP_CHECK(run(d_temporary_storage, temporary_storage_bytes));
+
+    HIP_CHECK(hipMalloc(&d_temporary_storage, temporary_storage_bytes));
+
+    // Warm-up
+    for(size_t i = 0; i < warmup_size; i++)
+    {
+        HIP_CHECK(run(d_temporary_storage, temporary_storage_bytes));
+    }
+    HIP_CHECK(hipDeviceSynchronize());
+
+    for(auto _ : state)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for(size_t i = 0; i < batch_size; i++)
+        {
+            HIP_CHECK(run(d_temporary_storage, temporary_storage_bytes));
+        }
+        HIP_CHECK(hipDeviceSynchronize());
+
+        auto end = std::chrono::high_resolution_clock::now();
+        auto elapsed_seconds =
+            std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+        state.SetIterationTime(elapsed_seconds.count());
+    }
+    state.SetBytesProcessed(state.iterations() * batch_size * size * sizeof(T));
+    state.SetItemsProcessed(state.iterations() * batch_size * size);
+
+    HIP_CHECK(hipFree(d_temporary_storage));
+    HIP_CHECK(hipFree(d_input));
+    HIP_CHECK(hipFree(d_output));
+    HIP_CHECK(hipFree(d_offsets));
+}
+
+#define CREATE_PARTITION_BUCKETS_BENCHMARK(T, B) \
+benchmark::RegisterBenchmark( \
+    (std::string("partition_buckets") + "<" #T ">(buckets = " #B ")").c_str(), \
+    [=](benchmark::State& state) { run_partition_buckets_benchmark<T>(state, stream, size, B); } \
+)
+
+#define BENCHMARK_TYPE(type) \
+    CREATE_PARTITION_BUCKETS_BENCHMARK(type, 2), \
+    CREATE_PARTITION_BUCKETS_BENCHMARK(type, 16), \
+    CREATE_PARTITION_BUCKETS_BENCHMARK(type, 100), \
+    CREATE_PARTITION_BUCKETS_BENCHMARK(type, 1024)
+
+int main(int argc, char *argv[])
+{
+    cli::Parser parser(argc, argv);
+    parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
+    parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_data_distribution_option(parser);
+    add_bandwidth_options(parser, argc, argv);
+    parser.run_and_exit_if_error();
+
+    // Parse argv
+    benchmark::Initialize(&argc, argv);
+    const size_t size = parser.get<size_t>("size");
+    const int trials = parser.get<int>("trials");
+
+    // HIP
+    hipStream_t stream = 0; // default
+
+    // Benchmark info
+    add_common_benchmark_info();
+    set_data_distribution(parser);
+    benchmark::AddCustomContext("size", std::to_string(size));
+
+    // Add benchmarks
+    std::vector<benchmark::internal::Benchmark*> benchmarks =
+    {
+        BENCHMARK_TYPE(int),
+        BENCHMARK_TYPE(uint8_t),
+        BENCHMARK_TYPE(long long),
+        BENCHMARK_TYPE(double)
+    };
+
+    // Use manual timing
+    for(auto& b : benchmarks)
+    {
+        b->UseManualTime();
+        b->Unit(benchmark::kMillisecond);
+    }
+
+    // Force number of iterations
+    if(trials > 0)
+    {
+        for(auto& b : benchmarks)
+        {
+            b->Iterations(trials);
+        }
+    }
+
+    // Run benchmarks
+    run_benchmarks(parser);
+    return 0;
+}
@@ -88,14 +88,13 @@ struct device_radix_sort_benchmark : public config_autotune_interface
 
         if(std::is_floating_point<key_type>::value)
         {
-            return get_random_data<key_type>(size, (key_type)-1000, (key_type) + 1000, size);
+            return get_distributed_data<key_type>(size, (key_type)-1000, (key_type) + 1000);
         }
         else
         {
-            return get_random_data<key_type>(size,
-                                             std::numeric_limits<key_type>::min(),
-                                             std::numeric_limits<key_type>::max(),
-                                             size);
+            return get_distributed_data<key_type>(size,
+                                                  std::numeric_limits<key_type>::min(),
+                                                  std::numeric_limits<key_type>::max());
         }
     }
 
@@ -400,6 +399,7 @@ inline void add_sort_pairs_benchmarks(std::vector<benchmark::internal::Benchmark
 {
     using custom_float2  = custom_type<float, float>;
     using custom_double2 = custom_type<double, double>;
+    using custom_double8 = custom_array_type<double, 8>;
 
     CREATE_RADIX_SORT_BENCHMARK(int, float)
     CREATE_RADIX_SORT_BENCHMARK(int, double)
@@ -407,6 +407,7 @@ inline void add_sort_pairs_benchmarks(std::vector<benchmark::internal::Benchmark
     CREATE_RADIX_SORT_BENCHMARK(int, custom_float2)
     CREATE_RADIX_SORT_BENCHMARK(int, double2)
     CREATE_RADIX_SORT_BENCHMARK(int, custom_double2)
+    CREATE_RADIX_SORT_BENCHMARK(int, custom_double8)
 
     CREATE_RADIX_SORT_BENCHMARK(long long, float)
     CREATE_RADIX_SORT_BENCHMARK(long long, double)
@@ -77,7 +77,7 @@ struct device_reduce_benchmark : public config_autotune_interface
              const hipStream_t stream) const override
     {
         BinaryFunction reduce_op{};
-        std::vector<T> input = get_random_data<T>(size, T(0), T(1000));
+        std::vector<T> input = get_distributed_data<T>(size, T(0), T(1000));
 
         T * d_input;
         T * d_output;
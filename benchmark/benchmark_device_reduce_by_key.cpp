@@ -58,7 +58,7 @@ void run_benchmark(benchmark::State& state, size_t max_length, hipStream_t strea
     std::vector<key_type> keys_input(size);
 
     unsigned int unique_count = 0;
-    std::vector<size_t> key_counts = get_random_data<size_t>(100000, 1, max_length);
+    std::vector<size_t> key_counts = get_distributed_data<size_t>(100000, 1, max_length);
     size_t offset = 0;
     while(offset < size)
     {
@@ -216,6 +216,8 @@ int main(int argc, char *argv[])
     cli::Parser parser(argc, argv);
     parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
     parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_data_distribution_option(parser);
+    add_bandwidth_options(parser, argc, argv);
     parser.run_and_exit_if_error();
 
     // Parse argv
@@ -228,6 +230,7 @@ int main(int argc, char *argv[])
 
     // Benchmark info
     add_common_benchmark_info();
+    set_data_distribution(parser);
     benchmark::AddCustomContext("size", std::to_string(size));
 
     // Add benchmarks
@@ -252,6 +255,6 @@ int main(int argc, char *argv[])
     }
 
     // Run benchmarks
-    benchmark::RunSpecifiedBenchmarks();
+    run_benchmarks(parser);
     return 0;
 }
@@ -183,7 +183,7 @@ struct device_scan_benchmark : public config_autotune_interface
                        const hipStream_t stream,
                        BinaryFunction    scan_op) const
     {
-        std::vector<T> input         = get_random_data<T>(size, T(0), T(1000));
+        std::vector<T> input         = get_distributed_data<T>(size, T(0), T(1000));
         T              initial_value = T(123);
         T*             d_input;
         T*             d_output;
@@ -259,7 +259,7 @@ struct device_scan_benchmark : public config_autotune_interface
                               const CompareFunction compare = CompareFunction()) const
     {
         constexpr bool       debug = false;
-        const std::vector<T> input = get_random_data<T>(size, T(0), T(1000));
+        const std::vector<T> input = get_distributed_data<T>(size, T(0), T(1000));
 
         const std::vector<K> keys
             = get_random_segments<K>(size, MaxSegmentLength, std::random_device{}());
@@ -93,7 +93,7 @@ void run_sort_keys_benchmark(benchmark::State& state,
     std::vector<key_type> keys_input;
     if(std::is_floating_point<key_type>::value)
     {
-        keys_input = get_random_data<key_type>(
+        keys_input = get_distributed_data<key_type>(
             size,
             static_cast<key_type>(-1000),
             static_cast<key_type>(1000)
@@ -101,7 +101,7 @@ void run_sort_keys_benchmark(benchmark::State& state,
     }
     else
     {
-        keys_input = get_random_data<key_type>(
+        keys_input = get_distributed_data<key_type>(
             size,
             std::numeric_limits<key_type>::min(),
             std::numeric_limits<key_type>::max()
@@ -237,7 +237,7 @@ void run_sort_pairs_benchmark(benchmark::State& state,
     std::vector<key_type> keys_input;
     if(std::is_floating_point<key_type>::value)
     {
-        keys_input = get_random_data<key_type>(
+        keys_input = get_distributed_data<key_type>(
             size,
             static_cast<key_type>(-1000),
             static_cast<key_type>(1000)
@@ -245,7 +245,7 @@ void run_sort_pairs_benchmark(benchmark::State& state,
     }
     else
     {
-        keys_input = get_random_data<key_type>(
+        keys_input = get_distributed_data<key_type>(
             size,
             std::numeric_limits<key_type>::min(),
             std::numeric_limits<key_type>::max()
@@ -422,6 +422,8 @@ int main(int argc, char *argv[])
     cli::Parser parser(argc, argv);
     parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
     parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_data_distribution_option(parser);
+    add_bandwidth_options(parser, argc, argv);
     parser.run_and_exit_if_error();
 
     // Parse argv
@@ -434,6 +436,7 @@ int main(int argc, char *argv[])
 
     // Benchmark info
     add_common_benchmark_info();
+    set_data_distribution(parser);
     benchmark::AddCustomContext("size", std::to_string(size));
 
     // Add benchmarks
@@ -472,6 +475,6 @@ int main(int argc, char *argv[])
     }
 
     // Run benchmarks
-    benchmark::RunSpecifiedBenchmarks();
+    run_benchmarks(parser);
     return 0;
 }
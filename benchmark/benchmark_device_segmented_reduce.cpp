@@ -182,7 +182,9 @@ benchmark::RegisterBenchmark( \
     CREATE_BENCHMARK(type, 10), \
     CREATE_BENCHMARK(type, 100), \
     CREATE_BENCHMARK(type, 1000), \
-    CREATE_BENCHMARK(type, 10000)
+    CREATE_BENCHMARK(type, 10000), \
+    CREATE_BENCHMARK(type, 1000000), \
+    CREATE_BENCHMARK(type, 10000000)
 
 void add_benchmarks(std::vector<benchmark::internal::Benchmark*>& benchmarks,
                     hipStream_t stream,
@@ -211,6 +213,8 @@ int main(int argc, char *argv[])
     cli::Parser parser(argc, argv);
     parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
     parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_data_distribution_option(parser);
+    add_bandwidth_options(parser, argc, argv);
     parser.run_and_exit_if_error();
 
     // Parse argv
@@ -223,6 +227,7 @@ int main(int argc, char *argv[])
 
     // Benchmark info
     add_common_benchmark_info();
+    set_data_distribution(parser);
     benchmark::AddCustomContext("size", std::to_string(size));
 
     // Add benchmarks
@@ -246,6 +251,6 @@ int main(int argc, char *argv[])
     }
 
     // Run benchmarks
-    benchmark::RunSpecifiedBenchmarks();
+    run_benchmarks(parser);
     return 0;
 }
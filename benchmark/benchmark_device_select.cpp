@@ -55,11 +55,11 @@ void run_flagged_benchmark(benchmark::State& state,
     std::vector<unsigned int> selected_count_output(1);
     if(std::is_floating_point<T>::value)
     {
-        input = get_random_data<T>(size, T(-1000), T(1000));
+        input = get_distributed_data<T>(size, T(-1000), T(1000));
     }
     else
     {
-        input = get_random_data<T>(
+        input = get_distributed_data<T>(
             size,
             std::numeric_limits<T>::min(),
             std::numeric_limits<T>::max()
@@ -167,7 +167,7 @@ void run_selectop_benchmark(benchmark::State& state,
                             const hipStream_t stream,
                             float true_probability)
 {
-    std::vector<T> input = get_random_data<T>(size, T(0), T(1000));
+    std::vector<T> input = get_distributed_data<T>(size, T(0), T(1000));
     std::vector<unsigned int> selected_count_output(1);
 
     auto select_op = [true_probability] __device__ (const T& value) -> bool
@@ -389,7 +389,7 @@ void run_unique_by_key_benchmark(benchmark::State& state,
             input_keys[i] = op(acc, input01[i]);
         }
     }
-    const auto                input_values = get_random_data<Value>(size, -1000, 1000);
+    const auto                input_values = get_distributed_data<Value>(size, -1000, 1000);
     std::vector<unsigned int> selected_count_output(1);
     auto                      equality_op = rocprim::equal_to<Key>();
 
@@ -537,6 +537,8 @@ int main(int argc, char *argv[])
     cli::Parser parser(argc, argv);
     parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
     parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_data_distribution_option(parser);
+    add_bandwidth_options(parser, argc, argv);
     parser.run_and_exit_if_error();
 
     // Parse argv
@@ -549,6 +551,7 @@ int main(int argc, char *argv[])
 
     // Benchmark info
     add_common_benchmark_info();
+    set_data_distribution(parser);
     benchmark::AddCustomContext("size", std::to_string(size));
 
     using custom_double2 = custom_type<double, double>;
@@ -607,7 +610,7 @@ int main(int argc, char *argv[])
     }
 
     // Run benchmarks
-    benchmark::RunSpecifiedBenchmarks();
+    run_benchmarks(parser);
 
     return 0;
 }
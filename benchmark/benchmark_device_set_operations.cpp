@@ -0,0 +1,239 @@
+// MIT License
+//
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <limits>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+
+// Google Benchmark
+#include "benchmark/benchmark.h"
+// CmdParser
+#include "cmdparser.hpp"
+#include "benchmark_utils.hpp"
+
+// HIP API
+#include <hip/hip_runtime.h>
+
+// rocPRIM
+#include <rocprim/rocprim.hpp>
+
+#ifndef DEFAULT_N
+const size_t DEFAULT_N = 1024 * 1024 * 32;
+#endif
+
+const unsigned int batch_size = 10;
+const unsigned int warmup_size = 5;
+
+template<class Key>
+struct set_intersection_op
+{
+    template<class... Args>
+    hipError_t operator()(Args&&... args) const
+    {
+        return rocprim::set_intersection(std::forward<Args>(args)...);
+    }
+};
+
+template<class Key>
+struct set_union_op
+{
+    template<class... Args>
+    hipError_t operator()(Args&&... args) const
+    {
+        return rocprim::set_union(std::forward<Args>(args)...);
+    }
+};
+
+template<class Key>
+struct set_difference_op
+{
+    template<class... Args>
+    hipError_t operator()(Args&&... args) const
+    {
+        return rocprim::set_difference(std::forward<Args>(args)...);
+    }
+};
+
+template<class Key>
+struct set_symmetric_difference_op
+{
+    template<class... Args>
+    hipError_t operator()(Args&&... args) const
+    {
+        return rocprim::set_symmetric_difference(std::forward<Args>(args)...);
+    }
+};
+
+// Both ranges have size / 2 keys, key_range controls how many of them are equal
+template<class Key, class SetOp>
+void run_set_operation_benchmark(benchmark::State& state,
+                                 hipStream_t stream,
+                                 size_t size,
+                                 size_t key_range)
+{
+    const size_t size1 = size / 2;
+    const size_t size2 = size - size1;
+
+    std::vector<Key> keys1 = get_distributed_data<Key>(size1, Key(0), Key(key_range));
+    std::vector<Key> keys2 = get_distributed_data<Key>(size2, Key(0), Key(key_range));
+    std::sort(keys1.begin(), keys1.end());
+    std::sort(keys2.begin(), keys2.end());
+
+    Key * d_keys_input1;
+    Key * d_keys_input2;
+    Key * d_keys_output;
+    size_t * d_output_count;
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_keys_input1), size1 * sizeof(Key)));
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_keys_input2), size2 * sizeof(Key)));
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_keys_output), size * sizeof(Key)));
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_output_count), sizeof(size_t)));
+    HIP_CHECK(
+        hipMemcpy(
+            d_keys_input1, keys1.data(),
+            size1 * sizeof(Key),
+            hipMemcpyHostToDevice
+        )
+    );
+    HIP_CHECK(
+        hipMemcpy(
+            d_keys_input2, keys2.data(),
+            size2 * sizeof(Key),
+            hipMemcpyHostToDevice
+        )
+    );
+
+    auto run = [&](void * d_temporary_storage, size_t& temporary_storage_bytes)
+    {
+        return SetOp()(
+            d_temporary_storage, temporary_storage_bytes,
+            d_keys_input1, d_keys_input2, d_keys_output, d_output_count,
+            size1, size2, ::rocprim::less<Key>(),
+            stream, false
+        );
+    };
+
+    void * d_temporary_storage = nullptr;
+    size_t temporary_storage_bytes;
+    HIP_CHECK(run(d_temporary_storage, temporary_storage_bytes));
+
+    HIP_CHECK(hipMalloc(&d_temporary_storage, temporary_storage_bytes));
+
+    // Warm-up
+    for(size_t i = 0; i < warmup_size; i++)
+    {
+        HIP_CHECK(run(d_temporary_storage, temporary_storage_bytes));
+    }
+    HIP_CHECK(hipDeviceSynchronize());
+
+    for(auto _ : state)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for(size_t i = 0; i < batch_size; i++)
+        {
+            HIP_CHECK(run(d_temporary_storage, temporary_storage_bytes));
+        }
+        HIP_CHECK(hipDeviceSynchronize());
+
+        auto end = std::chrono::high_resolution_clock::now();
+        auto elapsed_seconds =
+            std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+        state.SetIterationTime(elapsed_seconds.count());
+    }
+    state.SetBytesProcessed(state.iterations() * batch_size * size * sizeof(Key));
+    state.SetItemsProcessed(state.iterations() * batch_size * size);
+
+    HIP_CHECK(hipFree(d_temporary_storage));
+    HIP_CHECK(hipFree(d_keys_input1));
+    HIP_CHECK(hipFree(d_keys_input2));
+    HIP_CHECK(hipFree(d_keys_output));
+    HIP_CHECK(hipFree(d_output_count));
+}
+
+#define CREATE_SET_OPERATION_BENCHMARK(Op, Key, R) \
+benchmark::RegisterBenchmark( \
+    (std::string(#Op) + "<" #Key ">(key_range = " #R ")").c_str(), \
+    [=](benchmark::State& state) { run_set_operation_benchmark<Key, Op##_op<Key>>(state, stream, size, R); } \
+)
+
+#define BENCHMARK_TYPE(type) \
+    CREATE_SET_OPERATION_BENCHMARK(set_intersection, type, 100), \
+    CREATE_SET_OPERATION_BENCHMARK(set_intersection, type, 100000000), \
+    CREATE_SET_OPERATION_BENCHMARK(set_union, type, 100000000), \
+    CREATE_SET_OPERATION_BENCHMARK(set_difference, type, 100000000), \
+    CREATE_SET_OPERATION_BENCHMARK(set_symmetric_difference, type, 100000000)
+
+int main(int argc, char *argv[])
+{
+    cli::Parser parser(argc, argv);
+    parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
+    parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_data_distribution_option(parser);
+    add_bandwidth_options(parser, argc, argv);
+    parser.run_and_exit_if_error();
+
+    // Parse argv
+    benchmark::Initialize(&argc, argv);
+    const size_t size = parser.get<size_t>("size");
+    const int trials = parser.get<int>("trials");
+
+    // HIP
+    hipStream_t stream = 0; // default
+
+    // Benchmark info
+    add_common_benchmark_info();
+    set_data_distribution(parser);
+    benchmark::AddCustomContext("size", std::to_string(size));
+
+    // Add benchmarks
+    std::vector<benchmark::internal::Benchmark*> benchmarks =
+    {
+        BENCHMARK_TYPE(int),
+        BENCHMARK_TYPE(long long),
+        BENCHMARK_TYPE(double)
+    };
+
+    // Use manual timing
+    for(auto& b : benchmarks)
+    {
+        b->UseManualTime();
+        b->Unit(benchmark::kMillisecond);
+    }
+
+    // Force number of iterations
+    if(trials > 0)
+    {
+        for(auto& b : benchmarks)
+        {
+            b->Iterations(trials);
+        }
+    }
+
+    // Run benchmarks
+    run_benchmarks(parser);
+    return 0;
+}
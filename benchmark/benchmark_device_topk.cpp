@@ -0,0 +1,247 @@
+// MIT License
+//
+// Copyright (c) 2019 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <limits>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+
+// Google Benchmark
+#include "benchmark/benchmark.h"
+// CmdParser
+#include "cmdparser.hpp"
+#include "benchmark_utils.hpp"
+
+// HIP API
+#include <hip/hip_runtime.h>
+
+// rocPRIM
+#include <rocprim/rocprim.hpp>
+
+#ifndef DEFAULT_N
+const size_t DEFAULT_N = 1024 * 1024 * 32;
+#endif
+
+const unsigned int batch_size = 10;
+const unsigned int warmup_size = 5;
+
+template<class T>
+void iota_values(std::vector<T>& values)
+{
+    std::iota(values.begin(), values.end(), 0);
+}
+
+void iota_values(std::vector<::rocprim::empty_type>&) {}
+
+template<class Key, class Value = ::rocprim::empty_type>
+void run_topk_benchmark(benchmark::State& state, hipStream_t stream, size_t size, size_t k)
+{
+    using key_type = Key;
+    using value_type = Value;
+    constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+    // Generate data
+    std::vector<key_type> keys;
+    if(std::is_floating_point<key_type>::value)
+    {
+        keys = get_distributed_data<key_type>(size, key_type(-1000), key_type(1000));
+    }
+    else
+    {
+        keys = get_distributed_data<key_type>(
+            size,
+            std::numeric_limits<key_type>::min(),
+            std::numeric_limits<key_type>::max()
+        );
+    }
+
+    key_type * d_keys_input;
+    key_type * d_keys_output;
+    value_type * d_values_input = nullptr;
+    value_type * d_values_output = nullptr;
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_keys_input), size * sizeof(key_type)));
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_keys_output), k * sizeof(key_type)));
+    HIP_CHECK(
+        hipMemcpy(
+            d_keys_input, keys.data(),
+            size * sizeof(key_type),
+            hipMemcpyHostToDevice
+        )
+    );
+    if(with_values)
+    {
+        std::vector<value_type> values(size);
+        iota_values(values);
+        HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_values_input), size * sizeof(value_type)));
+        HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_values_output), k * sizeof(value_type)));
+        HIP_CHECK(
+            hipMemcpy(
+                d_values_input, values.data(),
+                size * sizeof(value_type),
+                hipMemcpyHostToDevice
+            )
+        );
+    }
+
+    auto run = [&](void * d_temporary_storage, size_t& temporary_storage_bytes)
+    {
+        if(with_values)
+        {
+            return rocprim::topk_pairs(
+                d_temporary_storage, temporary_storage_bytes,
+                d_keys_input, d_keys_output,
+                d_values_input, d_values_output,
+                size, k,
+                stream
+            );
+        }
+        return rocprim::topk_keys(
+            d_temporary_storage, temporary_storage_bytes,
+            d_keys_input, d_keys_output,
+            size, k,
+            stream
+        );
+    };
+
+    void * d_temporary_storage = nullptr;
+    size_t temporary_storage_bytes;
+    HIP_CHECK(run(d_temporary_storage, temporary_storage_bytes));
+
+    HIP_CHECK(hipMalloc(&d_temporary_storage, temporary_storage_bytes));
+
+    // Warm-up
+    for(size_t i = 0; i < warmup_size; i++)
+    {
+        HIP_CHECK(run(d_temporary_storage, temporary_storage_bytes));
+    }
+    HIP_CHECK(hipDeviceSynchronize());
+
+    for(auto _ : state)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for(size_t i = 0; i < batch_size; i++)
+        {
+            HIP_CHECK(run(d_temporary_storage, temporary_storage_bytes));
+        }
+        HIP_CHECK(hipDeviceSynchronize());
+
+        auto end = std::chrono::high_resolution_clock::now();
+        auto elapsed_seconds =
+            std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+        state.SetIterationTime(elapsed_seconds.count());
+    }
+    state.SetBytesProcessed(
+        state.iterations() * batch_size * size * (sizeof(key_type) + (with_values ? sizeof(value_type) : 0))
+    );
+    state.SetItemsProcessed(state.iterations() * batch_size * size);
+
+    HIP_CHECK(hipFree(d_temporary_storage));
+    HIP_CHECK(hipFree(d_keys_input));
+    HIP_CHECK(hipFree(d_keys_output));
+    if(with_values)
+    {
+        HIP_CHECK(hipFree(d_values_input));
+        HIP_CHECK(hipFree(d_values_output));
+    }
+}
+
+#define CREATE_TOPK_KEYS_BENCHMARK(Key, K) \
+benchmark::RegisterBenchmark( \
+    (std::string("topk_keys") + "<" #Key ">(k = " #K ")").c_str(), \
+    [=](benchmark::State& state) { run_topk_benchmark<Key>(state, stream, size, std::min<size_t>(K, size)); } \
+)
+
+#define CREATE_TOPK_PAIRS_BENCHMARK(Key, Value, K) \
+benchmark::RegisterBenchmark( \
+    (std::string("topk_pairs") + "<" #Key ", " #Value ">(k = " #K ")").c_str(), \
+    [=](benchmark::State& state) { run_topk_benchmark<Key, Value>(state, stream, size, std::min<size_t>(K, size)); } \
+)
+
+#define BENCHMARK_KEY_TYPE(type) \
+    CREATE_TOPK_KEYS_BENCHMARK(type, 1), \
+    CREATE_TOPK_KEYS_BENCHMARK(type, 1024), \
+    CREATE_TOPK_KEYS_BENCHMARK(type, 1048576)
+
+#define BENCHMARK_PAIR_TYPE(key_type, value_type) \
+    CREATE_TOPK_PAIRS_BENCHMARK(key_type, value_type, 1), \
+    CREATE_TOPK_PAIRS_BENCHMARK(key_type, value_type, 1024), \
+    CREATE_TOPK_PAIRS_BENCHMARK(key_type, value_type, 1048576)
+
+int main(int argc, char *argv[])
+{
+    cli::Parser parser(argc, argv);
+    parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
+    parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_data_distribution_option(parser);
+    add_bandwidth_options(parser, argc, argv);
+    parser.run_and_exit_if_error();
+
+    // Parse argv
+    benchmark::Initialize(&argc, argv);
+    const size_t size = parser.get<size_t>("size");
+    const int trials = parser.get<int>("trials");
+
+    // HIP
+    hipStream_t stream = 0; // default
+
+    // Benchmark info
+    add_common_benchmark_info();
+    set_data_distribution(parser);
+    benchmark::AddCustomContext("size", std::to_string(size));
+
+    // Add benchmarks
+    std::vector<benchmark::internal::Benchmark*> benchmarks =
+    {
+        BENCHMARK_KEY_TYPE(int),
+        BENCHMARK_KEY_TYPE(float),
+        BENCHMARK_KEY_TYPE(double),
+        BENCHMARK_KEY_TYPE(uint8_t),
+        BENCHMARK_KEY_TYPE(long long),
+        BENCHMARK_PAIR_TYPE(int, int),
+        BENCHMARK_PAIR_TYPE(float, int),
+        BENCHMARK_PAIR_TYPE(double, long long)
+    };
+
+    // Use manual timing
+    for(auto& b : benchmarks)
+    {
+        b->UseManualTime();
+        b->Unit(benchmark::kMillisecond);
+    }
+
+    // Force number of iterations
+    if(trials > 0)
+    {
+        for(auto& b : benchmarks)
+        {
+            b->Iterations(trials);
+        }
+    }
+
+    // Run benchmarks
+    run_benchmarks(parser);
+    return 0;
+}
@@ -66,7 +66,7 @@ void run_benchmark(benchmark::State& state,
                    const hipStream_t stream,
                    BinaryFunction transform_op)
 {
-    std::vector<T> input = get_random_data<T>(size, T(0), T(1000));
+    std::vector<T> input = get_distributed_data<T>(size, T(0), T(1000));
 
     T * d_input;
     T * d_output;
@@ -131,6 +131,8 @@ int main(int argc, char *argv[])
     cli::Parser parser(argc, argv);
     parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
     parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_data_distribution_option(parser);
+    add_bandwidth_options(parser, argc, argv);
     parser.run_and_exit_if_error();
 
     // Parse argv
@@ -143,6 +145,7 @@ int main(int argc, char *argv[])
 
     // Benchmark info
     add_common_benchmark_info();
+    set_data_distribution(parser);
     benchmark::AddCustomContext("size", std::to_string(size));
 
     using custom_float2 = custom_type<float, float>;
@@ -182,7 +185,7 @@ int main(int argc, char *argv[])
     }
 
     // Run benchmarks
-    benchmark::RunSpecifiedBenchmarks();
+    run_benchmarks(parser);
 
     return 0;
 }
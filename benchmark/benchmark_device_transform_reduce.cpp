@@ -0,0 +1,361 @@
+// MIT License
+//
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Google Benchmark
+#include "benchmark/benchmark.h"
+// CmdParser
+#include "cmdparser.hpp"
+#include "benchmark_utils.hpp"
+
+// HIP API
+#include <hip/hip_runtime.h>
+
+// rocPRIM
+#include <rocprim/rocprim.hpp>
+
+#ifndef DEFAULT_N
+const size_t DEFAULT_N = 1024 * 1024 * 32;
+#endif
+
+namespace rp = rocprim;
+
+const unsigned int batch_size  = 10;
+const unsigned int warmup_size = 5;
+
+// The minimum, the maximum, the sum and the sum of squares of the input are computed:
+// - multi_reduce: with multi_reduce, which loads the input once and reduces every accumulator
+//   with its own block reduction,
+// - tuple: with reduce of a transform_iterator to a tuple of all accumulators and a fused tuple
+//   operator, the workaround multi_reduce replaces,
+// - passes: with a transform_reduce per reduction, reading the input four times.
+enum class multi_reduce_method
+{
+    multi_reduce,
+    tuple,
+    passes
+};
+
+template<class T>
+struct identity_op
+{
+    template<class U>
+    __device__ __host__ inline T operator()(const U& value) const
+    {
+        return static_cast<T>(value);
+    }
+};
+
+template<class T>
+struct square_op
+{
+    template<class U>
+    __device__ __host__ inline T operator()(const U& value) const
+    {
+        return static_cast<T>(value) * static_cast<T>(value);
+    }
+};
+
+template<class T, class U>
+struct tuple_transform_op
+{
+    __device__ __host__ inline rp::tuple<T, T, U, U> operator()(const T& value) const
+    {
+        return rp::tuple<T, T, U, U>(value, value, identity_op<U>()(value), square_op<U>()(value));
+    }
+};
+
+template<class T, class U>
+struct tuple_reduce_op
+{
+    __device__ __host__ inline rp::tuple<T, T, U, U>
+        operator()(const rp::tuple<T, T, U, U>& a, const rp::tuple<T, T, U, U>& b) const
+    {
+        return rp::tuple<T, T, U, U>(rp::minimum<T>()(rp::get<0>(a), rp::get<0>(b)),
+                                     rp::maximum<T>()(rp::get<1>(a), rp::get<1>(b)),
+                                     rp::get<2>(a) + rp::get<2>(b),
+                                     rp::get<3>(a) + rp::get<3>(b));
+    }
+};
+
+template<class T, class U>
+hipError_t run_multi_reduce(multi_reduce_method method,
+                            void*               d_temporary_storage,
+                            size_t&             temporary_storage_bytes,
+                            T*                  d_input,
+                            T*                  d_min,
+                            T*                  d_max,
+                            U*                  d_sum,
+                            U*                  d_sum_of_squares,
+                            const size_t        size,
+                            const hipStream_t   stream)
+{
+    const T min_initial = std::numeric_limits<T>::max();
+    const T max_initial = std::numeric_limits<T>::lowest();
+    if(method == multi_reduce_method::multi_reduce)
+    {
+        return rp::multi_reduce(
+            d_temporary_storage,
+            temporary_storage_bytes,
+            d_input,
+            rp::make_tuple(d_min, d_max, d_sum, d_sum_of_squares),
+            size,
+            rp::make_tuple(rp::make_tuple(identity_op<T>(), rp::minimum<T>(), min_initial),
+                           rp::make_tuple(identity_op<T>(), rp::maximum<T>(), max_initial),
+                           rp::make_tuple(identity_op<U>(), rp::plus<U>(), U(0)),
+                           rp::make_tuple(square_op<U>(), rp::plus<U>(), U(0))),
+            stream);
+    }
+    else if(method == multi_reduce_method::tuple)
+    {
+        return rp::reduce(
+            d_temporary_storage,
+            temporary_storage_bytes,
+            rp::make_transform_iterator(d_input, tuple_transform_op<T, U>()),
+            rp::make_zip_iterator(rp::make_tuple(d_min, d_max, d_sum, d_sum_of_squares)),
+            rp::tuple<T, T, U, U>(min_initial, max_initial, U(0), U(0)),
+            size,
+            tuple_reduce_op<T, U>(),
+            stream);
+    }
+
+    // The passes run one after another, so they share the temporary storage
+    size_t     storage_bytes[4] = {temporary_storage_bytes,
+                                   temporary_storage_bytes,
+                                   temporary_storage_bytes,
+                                   temporary_storage_bytes};
+    hipError_t error            = rp::transform_reduce(d_temporary_storage,
+                                            storage_bytes[0],
+                                            d_input,
+                                            d_min,
+                                            min_initial,
+                                            size,
+                                            identity_op<T>(),
+                                            rp::minimum<T>(),
+                                            stream);
+    if(error == hipSuccess)
+    {
+        error = rp::transform_reduce(d_temporary_storage,
+                                     storage_bytes[1],
+                                     d_input,
+                                     d_max,
+                                     max_initial,
+                                     size,
+                                     identity_op<T>(),
+                                     rp::maximum<T>(),
+                                     stream);
+    }
+    if(error == hipSuccess)
+    {
+        error = rp::transform_reduce(d_temporary_storage,
+                                     storage_bytes[2],
+                                     d_input,
+                                     d_sum,
+                                     U(0),
+                                     size,
+                                     identity_op<U>(),
+                                     rp::plus<U>(),
+                                     stream);
+    }
+    if(error == hipSuccess)
+    {
+        error = rp::transform_reduce(d_temporary_storage,
+                                     storage_bytes[3],
+                                     d_input,
+                                     d_sum_of_squares,
+                                     U(0),
+                                     size,
+                                     square_op<U>(),
+                                     rp::plus<U>(),
+                                     stream);
+    }
+    if(d_temporary_storage == nullptr)
+    {
+        temporary_storage_bytes = *std::max_element(storage_bytes, storage_bytes + 4);
+    }
+    return error;
+}
+
+template<class T, class U>
+void run_benchmark(benchmark::State&   state,
+                   multi_reduce_method method,
+                   hipStream_t         stream,
+                   size_t              size)
+{
+    std::vector<T> input = get_random_data<T>(size, T(0), T(100));
+
+    T* d_input;
+    T* d_min;
+    T* d_max;
+    U* d_sum;
+    U* d_sum_of_squares;
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_input), size * sizeof(T)));
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_min), sizeof(T)));
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_max), sizeof(T)));
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_sum), sizeof(U)));
+    HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_sum_of_squares), sizeof(U)));
+    HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(T), hipMemcpyHostToDevice));
+
+    void*  d_temporary_storage     = nullptr;
+    size_t temporary_storage_bytes = 0;
+    HIP_CHECK(run_multi_reduce(method,
+                               d_temporary_storage,
+                               temporary_storage_bytes,
+                               d_input,
+                               d_min,
+                               d_max,
+                               d_sum,
+                               d_sum_of_squares,
+                               size,
+                               stream));
+
+    HIP_CHECK(hipMalloc(&d_temporary_storage, temporary_storage_bytes));
+    HIP_CHECK(hipDeviceSynchronize());
+
+    // Warm-up
+    for(size_t i = 0; i < warmup_size; i++)
+    {
+        HIP_CHECK(run_multi_reduce(method,
+                                   d_temporary_storage,
+                                   temporary_storage_bytes,
+                                   d_input,
+                                   d_min,
+                                   d_max,
+                                   d_sum,
+                                   d_sum_of_squares,
+                                   size,
+                                   stream));
+    }
+    HIP_CHECK(hipDeviceSynchronize());
+
+    for(auto _ : state)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for(size_t i = 0; i < batch_size; i++)
+        {
+            HIP_CHECK(run_multi_reduce(method,
+                                       d_temporary_storage,
+                                       temporary_storage_bytes,
+                                       d_input,
+                                       d_min,
+                                       d_max,
+                                       d_sum,
+                                       d_sum_of_squares,
+                                       size,
+                                       stream));
+        }
+        HIP_CHECK(hipStreamSynchronize(stream));
+
+        auto end = std::chrono::high_resolution_clock::now();
+        auto elapsed_seconds
+            = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+        state.SetIterationTime(elapsed_seconds.count());
+    }
+    state.SetBytesProcessed(state.iterations() * batch_size * size * sizeof(T));
+    state.SetItemsProcessed(state.iterations() * batch_size * size);
+
+    HIP_CHECK(hipFree(d_temporary_storage));
+    HIP_CHECK(hipFree(d_input));
+    HIP_CHECK(hipFree(d_min));
+    HIP_CHECK(hipFree(d_max));
+    HIP_CHECK(hipFree(d_sum));
+    HIP_CHECK(hipFree(d_sum_of_squares));
+}
+
+#define CREATE_BENCHMARK(T, U, METHOD)                                                      \
+    benchmark::RegisterBenchmark(                                                           \
+        (std::string("multi_reduce") + "<" #T ", " #U ">" + "(" #METHOD ")").c_str(),       \
+        run_benchmark<T, U>,                                                                \
+        multi_reduce_method::METHOD,                                                        \
+        stream,                                                                             \
+        size)
+
+#define BENCHMARK_TYPE(T, U)                                                      \
+    CREATE_BENCHMARK(T, U, multi_reduce), CREATE_BENCHMARK(T, U, tuple),          \
+        CREATE_BENCHMARK(T, U, passes)
+
+void add_benchmarks(std::vector<benchmark::internal::Benchmark*>& benchmarks,
+                    hipStream_t                                   stream,
+                    size_t                                        size)
+{
+    std::vector<benchmark::internal::Benchmark*> bs = {
+        BENCHMARK_TYPE(float, double),
+        BENCHMARK_TYPE(int, long long),
+        BENCHMARK_TYPE(uint8_t, unsigned int),
+        BENCHMARK_TYPE(double, double),
+    };
+
+    benchmarks.insert(benchmarks.end(), bs.begin(), bs.end());
+}
+
+int main(int argc, char* argv[])
+{
+    cli::Parser parser(argc, argv);
+    parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
+    parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_data_distribution_option(parser);
+    add_bandwidth_options(parser, argc, argv);
+    parser.run_and_exit_if_error();
+
+    // Parse argv
+    benchmark::Initialize(&argc, argv);
+    const size_t size   = parser.get<size_t>("size");
+    const int    trials = parser.get<int>("trials");
+
+    // HIP
+    hipStream_t stream = 0; // default
+
+    // Benchmark info
+    add_common_benchmark_info();
+    set_data_distribution(parser);
+    benchmark::AddCustomContext("size", std::to_string(size));
+
+    // Add benchmarks
+    std::vector<benchmark::internal::Benchmark*> benchmarks;
+    add_benchmarks(benchmarks, stream, size);
+
+    // Use manual timing
+    for(auto& b : benchmarks)
+    {
+        b->UseManualTime();
+        b->Unit(benchmark::kMillisecond);
+    }
+
+    // Force number of iterations
+    if(trials > 0)
+    {
+        for(auto& b : benchmarks)
+        {
+            b->Iterations(trials);
+        }
+    }
+
+    // Run benchmarks
+    run_benchmarks(parser);
+    return 0;
+}
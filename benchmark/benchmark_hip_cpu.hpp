@@ -0,0 +1,439 @@
+// MIT License
+//
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef ROCPRIM_BENCHMARK_HIP_CPU_HPP_
+#define ROCPRIM_BENCHMARK_HIP_CPU_HPP_
+
+// Device level algorithms with the HIP-CPU runtime. The same benchmarks are compiled with
+// host-native implementations (benchmark_hip_cpu_host_native) and with emulated blocks and warps
+// (benchmark_hip_cpu_emulated, ROCPRIM_DISABLE_HOST_NATIVE is defined), their results can be
+// compared by names.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+// HIP API
+#include <hip/hip_runtime.h>
+
+// rocPRIM HIP API
+#include <rocprim/rocprim.hpp>
+
+// CmdParser
+#include "cmdparser.hpp"
+
+#include "benchmark_utils.hpp"
+
+#ifndef DEFAULT_N
+const size_t DEFAULT_N = 1024 * 1024 * 32;
+#endif
+
+#if ROCPRIM_DETAIL_USE_HOST_NATIVE
+constexpr const char* hip_cpu_execution_name = "host_native";
+#else
+constexpr const char* hip_cpu_execution_name = "emulated";
+#endif
+
+constexpr unsigned int hip_cpu_histogram_bins = 256;
+
+template<class T>
+struct hip_cpu_less_than_value
+{
+    T value;
+
+    ROCPRIM_HOST_DEVICE
+    bool operator()(const T& a) const
+    {
+        return a < value;
+    }
+};
+
+// Every algorithm reads input and writes output (size items of T), it can also read
+// values_input and write values_output (size items of unsigned int)
+struct hip_cpu_reduce
+{
+    static std::string name()
+    {
+        return "reduce";
+    }
+
+    template<class T>
+    hipError_t operator()(void*         temporary_storage,
+                          size_t&       storage_size,
+                          T*            input,
+                          T*            output,
+                          unsigned int*,
+                          unsigned int*,
+                          const size_t      size,
+                          const hipStream_t stream) const
+    {
+        return rocprim::reduce(temporary_storage,
+                               storage_size,
+                               input,
+                               output,
+                               size,
+                               rocprim::plus<T>(),
+                               stream);
+    }
+};
+
+struct hip_cpu_inclusive_scan
+{
+    static std::string name()
+    {
+        return "inclusive_scan";
+    }
+
+    template<class T>
+    hipError_t operator()(void*         temporary_storage,
+                          size_t&       storage_size,
+                          T*            input,
+                          T*            output,
+                          unsigned int*,
+                          unsigned int*,
+                          const size_t      size,
+                          const hipStream_t stream) const
+    {
+        return rocprim::inclusive_scan(temporary_storage,
+                                       storage_size,
+                                       input,
+                                       output,
+                                       size,
+                                       rocprim::plus<T>(),
+                                       stream);
+    }
+};
+
+struct hip_cpu_select
+{
+    static std::string name()
+    {
+        return "select_predicate";
+    }
+
+    template<class T>
+    hipError_t operator()(void*         temporary_storage,
+                          size_t&       storage_size,
+                          T*            input,
+                          T*            output,
+                          unsigned int*,
+                          unsigned int* values_output,
+                          const size_t      size,
+                          const hipStream_t stream) const
+    {
+        // Input values are in [0; 100], about a half of them is selected
+        return rocprim::select(temporary_storage,
+                               storage_size,
+                               input,
+                               output,
+                               values_output,
+                               size,
+                               hip_cpu_less_than_value<T>{T(50)},
+                               stream);
+    }
+};
+
+struct hip_cpu_histogram_even
+{
+    static std::string name()
+    {
+        return "histogram_even";
+    }
+
+    template<class T>
+    hipError_t operator()(void*         temporary_storage,
+                          size_t&       storage_size,
+                          T*            input,
+                          T*,
+                          unsigned int*,
+                          unsigned int* values_output,
+                          const size_t      size,
+                          const hipStream_t stream) const
+    {
+        return rocprim::histogram_even(temporary_storage,
+                                       storage_size,
+                                       input,
+                                       static_cast<unsigned int>(size),
+                                       values_output,
+                                       hip_cpu_histogram_bins + 1,
+                                       T(0),
+                                       T(100),
+                                       stream);
+    }
+};
+
+struct hip_cpu_radix_sort_keys
+{
+    static std::string name()
+    {
+        return "radix_sort_keys";
+    }
+
+    template<class T>
+    hipError_t operator()(void*         temporary_storage,
+                          size_t&       storage_size,
+                          T*            input,
+                          T*            output,
+                          unsigned int*,
+                          unsigned int*,
+                          const size_t      size,
+                          const hipStream_t stream) const
+    {
+        return rocprim::radix_sort_keys(temporary_storage,
+                                        storage_size,
+                                        input,
+                                        output,
+                                        static_cast<unsigned int>(size),
+                                        0,
+                                        sizeof(T) * 8,
+                                        stream);
+    }
+};
+
+struct hip_cpu_radix_sort_pairs
+{
+    static std::string name()
+    {
+        return "radix_sort_pairs";
+    }
+
+    template<class T>
+    hipError_t operator()(void*         temporary_storage,
+                          size_t&       storage_size,
+                          T*            input,
+                          T*            output,
+                          unsigned int* values_input,
+                          unsigned int* values_output,
+                          const size_t      size,
+                          const hipStream_t stream) const
+    {
+        return rocprim::radix_sort_pairs(temporary_storage,
+                                         storage_size,
+                                         input,
+                                         output,
+                                         values_input,
+                                         values_output,
+                                         static_cast<unsigned int>(size),
+                                         0,
+                                         sizeof(T) * 8,
+                                         stream);
+    }
+};
+
+struct hip_cpu_merge_sort
+{
+    static std::string name()
+    {
+        return "merge_sort_keys";
+    }
+
+    template<class T>
+    hipError_t operator()(void*         temporary_storage,
+                          size_t&       storage_size,
+                          T*            input,
+                          T*            output,
+                          unsigned int*,
+                          unsigned int*,
+                          const size_t      size,
+                          const hipStream_t stream) const
+    {
+        return rocprim::merge_sort(temporary_storage,
+                                   storage_size,
+                                   input,
+                                   output,
+                                   static_cast<unsigned int>(size),
+                                   rocprim::less<T>(),
+                                   stream);
+    }
+};
+
+template<class T, class Algorithm>
+struct hip_cpu_benchmark : public config_autotune_interface
+{
+    std::string name() const override
+    {
+        return std::string("hip_cpu_" + Algorithm::name() + "<" + std::string(Traits<T>::name())
+                           + ", " + hip_cpu_execution_name + ">");
+    }
+
+    static constexpr unsigned int batch_size  = 4;
+    static constexpr unsigned int warmup_size = 2;
+
+    void run(benchmark::State& state, size_t size, const hipStream_t stream) const override
+    {
+        const Algorithm algorithm;
+
+        std::vector<T>            input        = get_random_data<T>(size, T(0), T(100));
+        std::vector<unsigned int> values_input = get_random_data<unsigned int>(size, 0, 1 << 20);
+
+        // Histograms and selected counts are also written to values_output
+        const size_t values_output_size = std::max<size_t>(size, hip_cpu_histogram_bins);
+
+        T*            d_input;
+        T*            d_output;
+        unsigned int* d_values_input;
+        unsigned int* d_values_output;
+        HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_input), size * sizeof(T)));
+        HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_output), size * sizeof(T)));
+        HIP_CHECK(
+            hipMalloc(reinterpret_cast<void**>(&d_values_input), size * sizeof(unsigned int)));
+        HIP_CHECK(hipMalloc(reinterpret_cast<void**>(&d_values_output),
+                            values_output_size * sizeof(unsigned int)));
+        HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(T), hipMemcpyHostToDevice));
+        HIP_CHECK(hipMemcpy(d_values_input,
+                            values_input.data(),
+                            size * sizeof(unsigned int),
+                            hipMemcpyHostToDevice));
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Allocate temporary storage memory
+        size_t temp_storage_size_bytes;
+        void*  d_temp_storage = nullptr;
+        // Get size of d_temp_storage
+        HIP_CHECK(algorithm(d_temp_storage,
+                            temp_storage_size_bytes,
+                            d_input,
+                            d_output,
+                            d_values_input,
+                            d_values_output,
+                            size,
+                            stream));
+        HIP_CHECK(hipMalloc(&d_temp_storage, temp_storage_size_bytes));
+        HIP_CHECK(hipDeviceSynchronize());
+
+        // Warm-up
+        for(size_t i = 0; i < warmup_size; i++)
+        {
+            HIP_CHECK(algorithm(d_temp_storage,
+                                temp_storage_size_bytes,
+                                d_input,
+                                d_output,
+                                d_values_input,
+                                d_values_output,
+                                size,
+                                stream));
+        }
+        HIP_CHECK(hipDeviceSynchronize());
+
+        for(auto _ : state)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+
+            for(size_t i = 0; i < batch_size; i++)
+            {
+                HIP_CHECK(algorithm(d_temp_storage,
+                                    temp_storage_size_bytes,
+                                    d_input,
+                                    d_output,
+                                    d_values_input,
+                                    d_values_output,
+                                    size,
+                                    stream));
+            }
+            HIP_CHECK(hipStreamSynchronize(stream));
+
+            auto end = std::chrono::high_resolution_clock::now();
+            auto elapsed_seconds
+                = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+            state.SetIterationTime(elapsed_seconds.count());
+        }
+        state.SetBytesProcessed(state.iterations() * batch_size * size * sizeof(T));
+        state.SetItemsProcessed(state.iterations() * batch_size * size);
+
+        HIP_CHECK(hipFree(d_input));
+        HIP_CHECK(hipFree(d_output));
+        HIP_CHECK(hipFree(d_values_input));
+        HIP_CHECK(hipFree(d_values_output));
+        HIP_CHECK(hipFree(d_temp_storage));
+    }
+};
+
+#define CREATE_BENCHMARK(T, ALGORITHM)                          \
+    {                                                           \
+        const hip_cpu_benchmark<T, ALGORITHM> instance;         \
+        REGISTER_BENCHMARK(benchmarks, size, stream, instance); \
+    }
+
+#define CREATE_BENCHMARKS(T)                          \
+    CREATE_BENCHMARK(T, hip_cpu_reduce)               \
+    CREATE_BENCHMARK(T, hip_cpu_inclusive_scan)       \
+    CREATE_BENCHMARK(T, hip_cpu_select)               \
+    CREATE_BENCHMARK(T, hip_cpu_histogram_even)       \
+    CREATE_BENCHMARK(T, hip_cpu_radix_sort_keys)      \
+    CREATE_BENCHMARK(T, hip_cpu_radix_sort_pairs)     \
+    CREATE_BENCHMARK(T, hip_cpu_merge_sort)
+
+inline int run_hip_cpu_benchmarks(int argc, char* argv[])
+{
+    cli::Parser parser(argc, argv);
+    parser.set_optional<size_t>("size", "size", DEFAULT_N, "number of values");
+    parser.set_optional<int>("trials", "trials", -1, "number of iterations");
+    add_bandwidth_options(parser, argc, argv);
+    parser.run_and_exit_if_error();
+
+    // Parse argv
+    benchmark::Initialize(&argc, argv);
+    const size_t size   = parser.get<size_t>("size");
+    const int    trials = parser.get<int>("trials");
+
+    // HIP
+    hipStream_t stream = 0; // default
+
+    // Benchmark info
+    add_common_benchmark_info();
+    benchmark::AddCustomContext("size", std::to_string(size));
+    benchmark::AddCustomContext("execution", hip_cpu_execution_name);
+
+    // Add benchmarks
+    std::vector<benchmark::internal::Benchmark*> benchmarks = {};
+
+    CREATE_BENCHMARKS(int)
+    CREATE_BENCHMARKS(float)
+
+    // Use manual timing
+    for(auto& b : benchmarks)
+    {
+        b->UseManualTime();
+        b->Unit(benchmark::kMillisecond);
+    }
+
+    // Force number of iterations
+    if(trials > 0)
+    {
+        for(auto& b : benchmarks)
+        {
+            b->Iterations(trials);
+        }
+    }
+
+    // Run benchmarks
+    run_benchmarks(parser);
+
+    return 0;
+}
+
+#endif // ROCPRIM_BENCHMARK_HIP_CPU_HPP_
@@ -22,11 +22,15 @@
 #define ROCPRIM_BENCHMARK_UTILS_HPP_
 
 #include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
 #include <vector>
 #include <random>
 #include <type_traits>
 #include <string>
 #include <memory>
+#include <utility>
 
 #ifdef WIN32
 #include <numeric>
@@ -34,6 +38,7 @@
 
 #include <rocprim/rocprim.hpp>
 #include "benchmark/benchmark.h"
+#include "cmdparser.hpp"
 
 #define HIP_CHECK(condition)         \
   {                                  \
@@ -228,6 +233,22 @@ struct is_custom_type : std::false_type {};
 template<class T, class U>
 struct is_custom_type<custom_type<T,U>> : std::true_type {};
 
+// Custom type of N values, used as a large payload
+template<class T, unsigned int N>
+struct custom_array_type
+{
+    T values[N];
+
+    ROCPRIM_HOST_DEVICE inline
+    custom_array_type(T v = 0)
+    {
+        for(unsigned int i = 0; i < N; i++)
+        {
+            values[i] = v;
+        }
+    }
+};
+
 template<class T>
 inline auto get_random_data(size_t size, T min, T max, size_t max_random_size = 1024 * 1024)
     -> typename std::enable_if<is_custom_type<T>::value, std::vector<T>>::type
@@ -268,6 +289,290 @@ inline auto get_random_data(size_t size, T min, T max, size_t max_random_size =
     return data;
 }
 
+// Distributions of the generated benchmark inputs, selected with the --distribution option.
+enum class data_distribution
+{
+    // Uniform in [min, max].
+    uniform,
+    // Bitwise AND of random words, every bit is set with probability 1/4 (0.81 bits of entropy
+    // per bit). "An Improved Supercomputer Sorting Benchmark", 1992, Kurt Thearling & Stephen Smith
+    entropy_reduced,
+    // Power law: the k-th most frequent value appears with probability proportional to 1/k.
+    zipf,
+    // Uniform values sorted in ascending order.
+    sorted,
+    // Uniform values sorted in descending order.
+    reverse_sorted,
+    // Sorted values, then size / 100 random pairs of items are swapped.
+    nearly_sorted,
+    // Uniform over a small set of distinct values.
+    few_unique
+};
+
+inline const std::vector<std::pair<data_distribution, std::string>>& get_data_distribution_names()
+{
+    static const std::vector<std::pair<data_distribution, std::string>> names
+        = {{data_distribution::uniform, "uniform"},
+           {data_distribution::entropy_reduced, "entropy_reduced"},
+           {data_distribution::zipf, "zipf"},
+           {data_distribution::sorted, "sorted"},
+           {data_distribution::reverse_sorted, "reverse_sorted"},
+           {data_distribution::nearly_sorted, "nearly_sorted"},
+           {data_distribution::few_unique, "few_unique"}};
+    return names;
+}
+
+inline std::string get_data_distribution_name(const data_distribution distribution)
+{
+    for(const auto& name : get_data_distribution_names())
+    {
+        if(name.first == distribution)
+        {
+            return name.second;
+        }
+    }
+    return "unknown";
+}
+
+// The distribution used by get_distributed_data() when none is passed explicitly.
+inline data_distribution& selected_data_distribution()
+{
+    static data_distribution distribution = data_distribution::uniform;
+    return distribution;
+}
+
+// Number of distinct values generated by data_distribution::zipf and data_distribution::few_unique.
+constexpr size_t zipf_max_values       = 1 << 16;
+constexpr size_t few_unique_max_values = 32;
+
+// Every bit of the result is set with probability 1/4
+inline unsigned long long get_entropy_reduced_bits(engine_type& gen)
+{
+    std::uniform_int_distribution<unsigned long long> bits_distribution;
+    return bits_distribution(gen) & bits_distribution(gen);
+}
+
+template<class D>
+inline auto get_entropy_reduced_value(engine_type& gen, D min, D max) ->
+    typename std::enable_if<std::is_integral<D>::value, D>::type
+{
+    using unsigned_type = typename std::make_unsigned<D>::type;
+    // The number of values in [min, max] is 0 if the range covers the whole type
+    const unsigned_type range
+        = static_cast<unsigned_type>(max) - static_cast<unsigned_type>(min) + 1;
+    const unsigned_type bits  = static_cast<unsigned_type>(get_entropy_reduced_bits(gen));
+    return static_cast<D>(static_cast<unsigned_type>(min) + (range == 0 ? bits : bits % range));
+}
+
+template<class D>
+inline auto get_entropy_reduced_value(engine_type& gen, D min, D max) ->
+    typename std::enable_if<std::is_floating_point<D>::value, D>::type
+{
+    const double fraction = static_cast<double>(get_entropy_reduced_bits(gen) >> 11) / (1ull << 53);
+    return static_cast<D>(min + (max - min) * fraction);
+}
+
+// Returns the i-th of count values spread evenly over [min, max]
+template<class D>
+inline auto get_spread_value(D min, D max, size_t i, size_t count) ->
+    typename std::enable_if<std::is_integral<D>::value, D>::type
+{
+    using unsigned_type = typename std::make_unsigned<D>::type;
+    const unsigned_type range = static_cast<unsigned_type>(max) - static_cast<unsigned_type>(min);
+    const unsigned_type step  = std::max<unsigned_type>(range / count, 1);
+    return static_cast<D>(static_cast<unsigned_type>(min) + static_cast<unsigned_type>(i) * step);
+}
+
+template<class D>
+inline auto get_spread_value(D min, D max, size_t i, size_t count) ->
+    typename std::enable_if<std::is_floating_point<D>::value, D>::type
+{
+    return static_cast<D>(min + (max - min) * (static_cast<double>(i) / count));
+}
+
+// get_distributed_data() generates the whole sequence according to the distribution, unlike
+// get_random_data() which replicates a random block: benchmarks of algorithms whose performance
+// depends on the data (sorting, histograms, run lengths) need the real distribution over all items.
+template<class T, class U, class V>
+inline auto get_distributed_data(size_t                  size,
+                                 U                       min,
+                                 V                       max,
+                                 const data_distribution distribution
+                                 = selected_data_distribution())
+    -> typename std::enable_if<rocprim::is_arithmetic<T>::value, std::vector<T>>::type
+{
+    // Generate floats when T is half, and ints when T is not supported by uniform_int_distribution
+    using dis_type = std::conditional_t<
+        rocprim::is_floating_point<T>::value,
+        std::conditional_t<std::is_floating_point<T>::value, T, float>,
+        std::conditional_t<is_valid_for_int_distribution<T>::value,
+                           T,
+                           std::conditional_t<std::is_signed<T>::value, int, unsigned int>>>;
+    using distribution_type = std::conditional_t<std::is_integral<dis_type>::value,
+                                                 std::uniform_int_distribution<dis_type>,
+                                                 std::uniform_real_distribution<dis_type>>;
+
+    const dis_type dis_min = static_cast<dis_type>(min);
+    const dis_type dis_max = static_cast<dis_type>(max);
+
+    engine_type       gen{std::random_device{}()};
+    distribution_type uniform_distribution(dis_min, dis_max);
+    std::vector<dis_type> data(size);
+
+    switch(distribution)
+    {
+        case data_distribution::entropy_reduced:
+            std::generate(data.begin(),
+                          data.end(),
+                          [&]() { return get_entropy_reduced_value(gen, dis_min, dis_max); });
+            break;
+        case data_distribution::zipf:
+        {
+            // Values in order of decreasing frequency, the first one is min
+            const size_t count
+                = std::is_integral<dis_type>::value
+                      ? static_cast<size_t>(std::min<double>(static_cast<double>(dis_max)
+                                                                 - static_cast<double>(dis_min) + 1,
+                                                             zipf_max_values))
+                      : zipf_max_values;
+            std::vector<double> cdf(count);
+            double              sum = 0;
+            for(size_t i = 0; i < count; i++)
+            {
+                sum += 1.0 / (i + 1);
+                cdf[i] = sum;
+            }
+            std::uniform_real_distribution<double> rank_distribution(0, sum);
+            std::generate(data.begin(),
+                          data.end(),
+                          [&]()
+                          {
+                              const size_t rank = std::min<size_t>(
+                                  std::upper_bound(cdf.begin(), cdf.end(), rank_distribution(gen))
+                                      - cdf.begin(),
+                                  count - 1);
+                              return get_spread_value(dis_min, dis_max, rank, count);
+                          });
+            break;
+        }
+        case data_distribution::few_unique:
+        {
+            std::vector<dis_type> values(few_unique_max_values);
+            std::generate(values.begin(),
+                          values.end(),
+                          [&]() { return uniform_distribution(gen); });
+            std::uniform_int_distribution<size_t> index_distribution(0, values.size() - 1);
+            std::generate(data.begin(),
+                          data.end(),
+                          [&]() { return values[index_distribution(gen)]; });
+            break;
+        }
+        default:
+            std::generate(data.begin(),
+                          data.end(),
+                          [&]() { return uniform_distribution(gen); });
+            break;
+    }
+
+    if(distribution == data_distribution::sorted
+       || distribution == data_distribution::nearly_sorted)
+    {
+        std::sort(data.begin(), data.end());
+    }
+    else if(distribution == data_distribution::reverse_sorted)
+    {
+        std::sort(data.begin(), data.end(), std::greater<dis_type>());
+    }
+    if(distribution == data_distribution::nearly_sorted && size > 1)
+    {
+        std::uniform_int_distribution<size_t> index_distribution(0, size - 1);
+        for(size_t i = 0; i < size / 100; i++)
+        {
+            std::swap(data[index_distribution(gen)], data[index_distribution(gen)]);
+        }
+    }
+
+    std::vector<T> result(size);
+    std::transform(data.begin(),
+                   data.end(),
+                   result.begin(),
+                   [](const dis_type value) { return static_cast<T>(value); });
+    return result;
+}
+
+// Custom types get the distribution applied to every field, so sorted fields make sorted values.
+template<class T>
+inline auto get_distributed_data(size_t                  size,
+                                 T                       min,
+                                 T                       max,
+                                 const data_distribution distribution
+                                 = selected_data_distribution())
+    -> typename std::enable_if<is_custom_type<T>::value, std::vector<T>>::type
+{
+    using first_type  = typename T::first_type;
+    using second_type = typename T::second_type;
+    std::vector<T> data(size);
+    auto fdata = get_distributed_data<first_type>(size, min.x, max.x, distribution);
+    auto sdata = get_distributed_data<second_type>(size, min.y, max.y, distribution);
+    for(size_t i = 0; i < size; i++)
+    {
+        data[i] = T(fdata[i], sdata[i]);
+    }
+    return data;
+}
+
+template<class T>
+inline auto get_distributed_data(size_t                  size,
+                                 T                       min,
+                                 T                       max,
+                                 const data_distribution distribution
+                                 = selected_data_distribution())
+    -> typename std::enable_if<!is_custom_type<T>::value
+                                   && !std::is_same<decltype(max.x), void>::value,
+                               std::vector<T>>::type
+{
+    // See the vector type overload of get_random_data() for the post-increment operator
+    using field_type = decltype(max.x++);
+    std::vector<T> data(size);
+    auto field_data = get_distributed_data<field_type>(size, min.x, max.x, distribution);
+    for(size_t i = 0; i < size; i++)
+    {
+        data[i] = T(field_data[i]);
+    }
+    return data;
+}
+
+// Adds the --distribution option to the command line of a benchmark.
+inline void add_data_distribution_option(cli::Parser& parser)
+{
+    std::string names;
+    for(const auto& name : get_data_distribution_names())
+    {
+        names += (names.empty() ? "" : ", ") + name.second;
+    }
+    parser.set_optional<std::string>("distribution",
+                                     "distribution",
+                                     "uniform",
+                                     "distribution of the input data: " + names);
+}
+
+// Selects the distribution parsed from the command line, and adds it to the benchmark context.
+inline void set_data_distribution(const cli::Parser& parser)
+{
+    const std::string name = parser.get<std::string>("distribution");
+    for(const auto& distribution : get_data_distribution_names())
+    {
+        if(distribution.second == name)
+        {
+            selected_data_distribution() = distribution.first;
+            benchmark::AddCustomContext("distribution", name);
+            return;
+        }
+    }
+    std::cerr << "Unknown distribution: " << name << std::endl;
+    exit(EXIT_FAILURE);
+}
+
 inline bool is_warp_size_supported(const unsigned int required_warp_size)
 {
     return ::rocprim::host_warp_size() >= required_warp_size;
@@ -501,6 +806,11 @@ inline const char* Traits<custom_type<long long, double>>::name()
     return "custom_type<int64_t,double>";
 }
 template<>
+inline const char* Traits<custom_array_type<double, 8>>::name()
+{
+    return "custom_array_type<double,8>";
+}
+template<>
 inline const char* Traits<rocprim::empty_type>::name()
 {
     return "empty_type";
@@ -613,4 +923,151 @@ inline void add_common_benchmark_info()
     num("hdp_arch_has_dynamic_parallelism", arch.hasDynamicParallelism);
 }
 
+// Formats of the Google Benchmark reporters requested on the command line. They are captured by
+// add_bandwidth_options() because benchmark::Initialize() removes the benchmark flags from argv.
+struct benchmark_report_formats
+{
+    std::string display_format = "console";
+    std::string file_format    = "json";
+    bool        has_file       = false;
+};
+
+inline benchmark_report_formats& get_benchmark_report_formats()
+{
+    static benchmark_report_formats formats;
+    return formats;
+}
+
+// Adds the --peak_bandwidth option to the command line of a benchmark, must be called before
+// benchmark::Initialize().
+inline void add_bandwidth_options(cli::Parser& parser, int argc, char* argv[])
+{
+    parser.set_optional<double>("peak_bandwidth",
+                                "peak_bandwidth",
+                                0.0,
+                                "peak memory bandwidth in GB/s used for bandwidth_of_peak, "
+                                "0 to use the bandwidth of the device");
+
+    benchmark_report_formats& formats = get_benchmark_report_formats();
+    for(int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        // Google Benchmark accepts flags with one or two dashes
+        argument.erase(0, argument.find_first_not_of('-'));
+        const auto flag_value = [&](const std::string& flag, std::string& value)
+        {
+            if(argument.compare(0, flag.size() + 1, flag + "=") == 0)
+            {
+                value = argument.substr(flag.size() + 1);
+                return true;
+            }
+            return false;
+        };
+        std::string out;
+        flag_value("benchmark_format", formats.display_format);
+        flag_value("benchmark_out_format", formats.file_format);
+        if(flag_value("benchmark_out", out))
+        {
+            formats.has_file = !out.empty();
+        }
+    }
+}
+
+// Peak memory bandwidth of the current device in bytes per second, 0 if it is unknown.
+inline double get_device_peak_bandwidth()
+{
+    hipDeviceProp_t devProp;
+    int             device_id = 0;
+    HIP_CHECK(hipGetDevice(&device_id));
+    HIP_CHECK(hipGetDeviceProperties(&devProp, device_id));
+    // Memory clock rate in kHz, bus width in bits, and two transfers per clock
+    return 2.0 * devProp.memoryClockRate * 1000.0 * devProp.memoryBusWidth / 8.0;
+}
+
+// Forwards the results to a Google Benchmark reporter, adding the achieved bandwidth as a fraction
+// of the peak bandwidth (bandwidth_of_peak) to every benchmark that sets the bytes processed.
+class bandwidth_reporter : public benchmark::BenchmarkReporter
+{
+public:
+    bandwidth_reporter(std::unique_ptr<benchmark::BenchmarkReporter> reporter,
+                       double                                        peak_bandwidth)
+        : reporter_(std::move(reporter)), peak_bandwidth_(peak_bandwidth)
+    {}
+
+    bool ReportContext(const Context& context) override
+    {
+        // The output streams are set on this reporter by Google Benchmark
+        reporter_->SetOutputStream(&GetOutputStream());
+        reporter_->SetErrorStream(&GetErrorStream());
+        return reporter_->ReportContext(context);
+    }
+
+    void ReportRuns(const std::vector<Run>& runs) override
+    {
+        std::vector<Run> bandwidth_runs(runs);
+        for(Run& run : bandwidth_runs)
+        {
+            const auto bytes_per_second = run.counters.find("bytes_per_second");
+            // The coefficient of variation is not a bandwidth
+            if(peak_bandwidth_ > 0 && bytes_per_second != run.counters.end()
+               && run.aggregate_name != "cv")
+            {
+                run.counters["bandwidth_of_peak"]
+                    = benchmark::Counter(bytes_per_second->second.value / peak_bandwidth_);
+            }
+        }
+        reporter_->ReportRuns(bandwidth_runs);
+    }
+
+    void Finalize() override
+    {
+        reporter_->Finalize();
+    }
+
+    // Returns nullptr for the formats that are left to the default reporters of Google Benchmark
+    // (the deprecated csv format).
+    static std::unique_ptr<benchmark::BenchmarkReporter> create(const std::string& format,
+                                                                double             peak_bandwidth)
+    {
+        std::unique_ptr<benchmark::BenchmarkReporter> reporter;
+        if(format == "json")
+        {
+            reporter = std::make_unique<benchmark::JSONReporter>();
+        }
+        else if(format == "console")
+        {
+            reporter = std::make_unique<benchmark::ConsoleReporter>();
+        }
+        else
+        {
+            return nullptr;
+        }
+        return std::make_unique<bandwidth_reporter>(std::move(reporter), peak_bandwidth);
+    }
+
+private:
+    std::unique_ptr<benchmark::BenchmarkReporter> reporter_;
+    double                                        peak_bandwidth_;
+};
+
+// Runs the registered benchmarks, replaces benchmark::RunSpecifiedBenchmarks(). The peak bandwidth
+// is taken from --peak_bandwidth or the device, and added to the benchmark context in GB/s.
+inline void run_benchmarks(const cli::Parser& parser)
+{
+    double peak_bandwidth = parser.get<double>("peak_bandwidth") * 1e9;
+    if(peak_bandwidth <= 0)
+    {
+        peak_bandwidth = get_device_peak_bandwidth();
+    }
+    benchmark::AddCustomContext("peak_bandwidth", std::to_string(peak_bandwidth / 1e9));
+
+    const benchmark_report_formats& formats = get_benchmark_report_formats();
+    std::unique_ptr<benchmark::BenchmarkReporter> display_reporter
+        = bandwidth_reporter::create(formats.display_format, peak_bandwidth);
+    std::unique_ptr<benchmark::BenchmarkReporter> file_reporter
+        = formats.has_file ? bandwidth_reporter::create(formats.file_format, peak_bandwidth)
+                           : nullptr;
+    benchmark::RunSpecifiedBenchmarks(display_reporter.get(), file_reporter.get());
+}
+
 #endif // ROCPRIM_BENCHMARK_UTILS_HPP_
@@ -99,6 +99,21 @@ function(add_matrix)
   endforeach()
 endfunction()
 
+# Adds a source for each of the given candidates, instead of the product of the lists like add_matrix.
+# A candidate is a space separated list of values in the order of NAMES.
+function(add_candidates)
+  set(single_value_args "TARGET" "INPUT" "OUTPUT_PATTERN")
+  cmake_parse_arguments(PARSE_ARGV 0 ARG "" "${single_value_args}" "NAMES;CANDIDATES")
+  foreach(candidate IN LISTS ARG_CANDIDATES)
+    string(REPLACE " " ";" values ${candidate})
+    add_configured_source(TARGET "${ARG_TARGET}"
+            INPUT "${ARG_INPUT}"
+            OUTPUT_PATTERN "${ARG_OUTPUT_PATTERN}"
+            NAMES ${ARG_NAMES}
+            VALUES ${values})
+  endforeach()
+endfunction()
+
 # example of a FILTER rule
 function(reject_odd_blocksize RESULT BlockSize)
   math(EXPR res "${BlockSize} % 2")
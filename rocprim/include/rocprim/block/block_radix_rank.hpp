@@ -0,0 +1,331 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_BLOCK_BLOCK_RADIX_RANK_HPP_
+#define ROCPRIM_BLOCK_BLOCK_RADIX_RANK_HPP_
+
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+#include "../detail/radix_sort.hpp"
+
+#include "../intrinsics.hpp"
+#include "../functional.hpp"
+#include "../types.hpp"
+
+#include "block_scan.hpp"
+
+/// \addtogroup blockmodule
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+template<class Key, bool Descending>
+struct radix_rank_digit_extractor
+{
+    unsigned int bit;
+    unsigned int current_radix_bits;
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    unsigned int operator()(const Key key) const
+    {
+        using key_codec = radix_key_codec<Key, Descending>;
+        return key_codec::extract_digit(key_codec::encode(key), bit, current_radix_bits);
+    }
+};
+
+// Extracts digits of keys already encoded by radix_key_codec
+template<class Key, bool Descending, class Decomposer = identity_decomposer>
+struct radix_rank_bit_key_digit_extractor
+{
+    using key_codec = radix_key_codec<Key, Descending, Decomposer>;
+    using bit_key_type = typename key_codec::bit_key_type;
+
+    unsigned int bit;
+    unsigned int current_radix_bits;
+    key_codec codec;
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    unsigned int operator()(const bit_key_type bit_key) const
+    {
+        return codec.extract_digit(bit_key, bit, current_radix_bits);
+    }
+};
+
+} // end namespace detail
+
+/// \brief The block_radix_rank class is a block level parallel primitive which provides
+/// methods for computing the stable rank of keys partitioned across threads in a block
+/// according to a digit of \p RadixBits bits.
+///
+/// \tparam BlockSizeX - the number of threads in a block's x dimension.
+/// \tparam RadixBits - the maximum number of bits of a digit ranked at once.
+/// \tparam BlockSizeY - the number of threads in a block's y dimension, defaults to 1.
+/// \tparam BlockSizeZ - the number of threads in a block's z dimension, defaults to 1.
+///
+/// \par Overview
+/// * The rank of an item is its position in the block after a stable partitioning of the
+/// items by digit, items are assumed to be in a blocked arrangement.
+/// * Ranking is counter-based: each thread counts digits of its items in a private column of
+/// <tt>2^RadixBits</tt> counters, then all counters are scanned with a single block scan. This
+/// replaces \p RadixBits per-bit scans and exchanges of a bit-by-bit radix sort.
+/// * The number of items in a block (<tt>BlockSize * ItemsPerThread</tt>) must not
+/// exceed 65536.
+/// * Shared memory usage grows linearly with <tt>2^RadixBits</tt>: counters take about
+/// <tt>2^RadixBits * BlockSize * 2</tt> bytes and must fit in 64 KiB, 4 to 8 radix bits are
+/// usually a good choice.
+///
+/// \par Examples
+/// \parblock
+/// In the examples ranking is performed on a block of 256 threads, each thread provides
+/// four \p unsigned \p int keys, the least significant 4 bits of keys are ranked.
+///
+/// \code{.cpp}
+/// __global__ void example_kernel(...)
+/// {
+///     // specialize block_radix_rank for a block of 256 threads and 4-bit digits
+///     using block_rank_type = rocprim::block_radix_rank<256, 4>;
+///     // allocate storage in shared memory
+///     __shared__ block_rank_type::storage_type storage;
+///
+///     unsigned int keys[4] = ...;
+///     unsigned int ranks[4];
+///     block_rank_type().rank_keys(keys, ranks, storage, 0, 4);
+///     ...
+/// }
+/// \endcode
+/// \endparblock
+template<
+    unsigned int BlockSizeX,
+    unsigned int RadixBits,
+    unsigned int BlockSizeY = 1,
+    unsigned int BlockSizeZ = 1
+>
+class block_radix_rank
+{
+    static constexpr unsigned int BlockSize = BlockSizeX * BlockSizeY * BlockSizeZ;
+    static constexpr unsigned int radix_size = 1u << RadixBits;
+
+    static_assert(RadixBits >= 1 && RadixBits <= 8, "RadixBits must be in range [1; 8]");
+
+    // Counters are 16-bit: a prefix is read back only by a thread which has an item with
+    // that digit, so such prefixes are less than the number of items in the block.
+    using counter_type = unsigned short;
+
+    using block_scan_type = ::rocprim::block_scan<
+        unsigned int, BlockSizeX, ::rocprim::block_scan_algorithm::using_warp_scan, BlockSizeY, BlockSizeZ
+    >;
+
+    // Counters are stored digit-major: logical counter digit * BlockSize + flat_id.
+    // Exclusive scan of the counters in this order gives stable ranks for the blocked
+    // arrangement of items. For the scan every thread owns a row of radix_size consecutive
+    // logical counters, rows are padded so that their stride is an odd number of 32-bit
+    // banks and the rows read by a wavefront do not conflict.
+    static constexpr unsigned int row_padding
+        = radix_size * sizeof(counter_type) / sizeof(unsigned int) % 2 == 0
+              ? sizeof(unsigned int) / sizeof(counter_type) : 0;
+    static constexpr unsigned int row_stride = radix_size + row_padding;
+    static constexpr unsigned int counter_count = BlockSize * row_stride;
+
+    // Maps a logical counter to its position in the padded array
+    static ROCPRIM_DEVICE ROCPRIM_INLINE
+    unsigned int counter_index(const unsigned int logical)
+    {
+        return logical + (logical / radix_size) * row_padding;
+    }
+
+    // Struct used for creating a raw_storage object for this primitive's temporary storage.
+    struct storage_type_
+    {
+        counter_type digit_counters[counter_count];
+        typename block_scan_type::storage_type block_scan;
+    };
+
+    // RadixBits up to 8 needs about radix_size * BlockSize * 2 bytes of shared memory
+    static_assert(sizeof(storage_type_) <= 65536,
+                  "block_radix_rank storage exceeds 64 KiB of shared memory, "
+                  "decrease RadixBits or the block size");
+
+public:
+
+    /// \brief Struct used to allocate a temporary memory that is required for thread
+    /// communication during operations provided by related parallel primitive.
+    ///
+    /// Depending on the implemention the operations exposed by parallel primitive may
+    /// require a temporary storage for thread communication. The storage should be allocated
+    /// using keywords <tt>__shared__</tt>. It can be aliased to
+    /// an externally allocated memory, or be a part of a union type with other storage types
+    /// to increase shared memory reusability.
+    #ifndef DOXYGEN_SHOULD_SKIP_THIS // hides storage_type implementation for Doxygen
+    using storage_type = detail::raw_storage<storage_type_>;
+    #else
+    using storage_type = storage_type_; // only for Doxygen
+    #endif
+
+    /// \brief Computes ranks of keys for ascending order of the digit
+    /// <tt>[begin_bit; begin_bit + pass_bits)</tt>.
+    ///
+    /// \tparam Key - the key type, the same types as for block_radix_sort are supported.
+    /// \tparam ItemsPerThread - the number of items contributed by each thread.
+    ///
+    /// \param [in] keys - reference to an array of keys provided by a thread.
+    /// \param [out] ranks - reference to an array of ranks of the keys, in range
+    /// <tt>[0; BlockSize * ItemsPerThread)</tt>.
+    /// \param [in] storage - reference to a temporary storage object of type storage_type.
+    /// \param [in] begin_bit - [optional] index of the first (least significant) bit of the digit.
+    /// Default value: \p 0.
+    /// \param [in] pass_bits - [optional] number of bits of the digit, must not exceed
+    /// \p RadixBits. Default value: \p RadixBits.
+    ///
+    /// \par Storage reusage
+    /// Synchronization barrier should be placed before \p storage is reused
+    /// or repurposed: \p __syncthreads() or \p rocprim::syncthreads().
+    template<class Key, unsigned int ItemsPerThread>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void rank_keys(const Key (&keys)[ItemsPerThread],
+                   unsigned int (&ranks)[ItemsPerThread],
+                   storage_type& storage,
+                   unsigned int begin_bit = 0,
+                   unsigned int pass_bits = RadixBits)
+    {
+        rank_keys(
+            keys, ranks, storage,
+            detail::radix_rank_digit_extractor<Key, false>{begin_bit, pass_bits}
+        );
+    }
+
+    /// \brief Computes ranks of keys for descending order of the digit
+    /// <tt>[begin_bit; begin_bit + pass_bits)</tt>.
+    ///
+    /// \tparam Key - the key type, the same types as for block_radix_sort are supported.
+    /// \tparam ItemsPerThread - the number of items contributed by each thread.
+    ///
+    /// \param [in] keys - reference to an array of keys provided by a thread.
+    /// \param [out] ranks - reference to an array of ranks of the keys, in range
+    /// <tt>[0; BlockSize * ItemsPerThread)</tt>.
+    /// \param [in] storage - reference to a temporary storage object of type storage_type.
+    /// \param [in] begin_bit - [optional] index of the first (least significant) bit of the digit.
+    /// Default value: \p 0.
+    /// \param [in] pass_bits - [optional] number of bits of the digit, must not exceed
+    /// \p RadixBits. Default value: \p RadixBits.
+    ///
+    /// \par Storage reusage
+    /// Synchronization barrier should be placed before \p storage is reused
+    /// or repurposed: \p __syncthreads() or \p rocprim::syncthreads().
+    template<class Key, unsigned int ItemsPerThread>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void rank_keys_desc(const Key (&keys)[ItemsPerThread],
+                        unsigned int (&ranks)[ItemsPerThread],
+                        storage_type& storage,
+                        unsigned int begin_bit = 0,
+                        unsigned int pass_bits = RadixBits)
+    {
+        rank_keys(
+            keys, ranks, storage,
+            detail::radix_rank_digit_extractor<Key, true>{begin_bit, pass_bits}
+        );
+    }
+
+    /// \brief Computes ranks of keys using digits returned by a custom digit extractor.
+    ///
+    /// \tparam Key - the key type.
+    /// \tparam ItemsPerThread - the number of items contributed by each thread.
+    /// \tparam DigitExtractor - type of unary function object with signature
+    /// <tt>unsigned int f(const Key&)</tt>, the returned digit must be less
+    /// than <tt>2^RadixBits</tt>.
+    ///
+    /// \param [in] keys - reference to an array of keys provided by a thread.
+    /// \param [out] ranks - reference to an array of ranks of the keys, in range
+    /// <tt>[0; BlockSize * ItemsPerThread)</tt>.
+    /// \param [in] storage - reference to a temporary storage object of type storage_type.
+    /// \param [in] digit_extractor - function object returning the digit of a key.
+    ///
+    /// \par Storage reusage
+    /// Synchronization barrier should be placed before \p storage is reused
+    /// or repurposed: \p __syncthreads() or \p rocprim::syncthreads().
+    template<class Key, unsigned int ItemsPerThread, class DigitExtractor>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void rank_keys(const Key (&keys)[ItemsPerThread],
+                   unsigned int (&ranks)[ItemsPerThread],
+                   storage_type& storage,
+                   DigitExtractor digit_extractor)
+    {
+        static_assert(BlockSize * ItemsPerThread <= 65536,
+                      "block_radix_rank supports at most 65536 items per block");
+
+        storage_type_& storage_ = storage.get();
+        const unsigned int flat_id = ::rocprim::flat_block_thread_id<BlockSizeX, BlockSizeY, BlockSizeZ>();
+
+        // Every thread uses only its own column of counters, no synchronization is needed
+        // until the counters are scanned
+        ROCPRIM_UNROLL
+        for(unsigned int digit = 0; digit < radix_size; digit++)
+        {
+            storage_.digit_counters[counter_index(digit * BlockSize + flat_id)] = 0;
+        }
+
+        unsigned int counter_ids[ItemsPerThread];
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
+        {
+            counter_ids[i] = counter_index(digit_extractor(keys[i]) * BlockSize + flat_id);
+            const counter_type count = storage_.digit_counters[counter_ids[i]];
+            ranks[i] = count;
+            storage_.digit_counters[counter_ids[i]] = count + 1;
+        }
+        ::rocprim::syncthreads();
+
+        // Each thread scans its padded row of radix_size consecutive counters
+        const unsigned int first_counter = flat_id * row_stride;
+        unsigned int thread_count = 0;
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < radix_size; i++)
+        {
+            thread_count += storage_.digit_counters[first_counter + i];
+        }
+        unsigned int prefix;
+        block_scan_type().exclusive_scan(thread_count, prefix, 0u, storage_.block_scan);
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < radix_size; i++)
+        {
+            const unsigned int count = storage_.digit_counters[first_counter + i];
+            storage_.digit_counters[first_counter + i] = static_cast<counter_type>(prefix);
+            prefix += count;
+        }
+        ::rocprim::syncthreads();
+
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
+        {
+            ranks[i] += storage_.digit_counters[counter_ids[i]];
+        }
+    }
+};
+
+END_ROCPRIM_NAMESPACE
+
+/// @}
+// end of group blockmodule
+
+#endif // ROCPRIM_BLOCK_BLOCK_RADIX_RANK_HPP_
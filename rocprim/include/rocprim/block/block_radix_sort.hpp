@@ -26,122 +26,19 @@
 #include "../config.hpp"
 #include "../detail/various.hpp"
 #include "../detail/radix_sort.hpp"
-#include "../warp/detail/warp_scan_crosslane.hpp"
 
 #include "../intrinsics.hpp"
 #include "../functional.hpp"
 #include "../types.hpp"
 
 #include "block_exchange.hpp"
+#include "block_radix_rank.hpp"
 
 /// \addtogroup blockmodule
 /// @{
 
 BEGIN_ROCPRIM_NAMESPACE
 
-namespace detail
-{
-
-/// Specialized block scan of bool (1 bit values)
-/// It uses warp scan and reduce functions of bool (1 bit values) based on ballot and bit count.
-/// They have much better performance (several times faster) than generic scan and reduce classes
-/// because of using hardware ability to calculate which lanes have true predicate values.
-template<
-    unsigned int BlockSizeX,
-    unsigned int BlockSizeY = 1,
-    unsigned int BlockSizeZ = 1
->
-class block_bit_plus_scan
-{
-    static constexpr unsigned int BlockSize = BlockSizeX * BlockSizeY * BlockSizeZ;
-    // Select warp size
-    static constexpr unsigned int warp_size =
-        detail::get_min_warp_size(BlockSize, ::rocprim::device_warp_size());
-    // Number of warps in block
-    static constexpr unsigned int warps_no = (BlockSize + warp_size - 1) / warp_size;
-
-    // typedef of warp_scan primitive that will be used to get prefix values for
-    // each warp (scanned carry-outs from warps before it)
-    // warp_scan_crosslane is an implementation of warp_scan that does not need storage,
-    // but requires logical warp size to be a power of two.
-    using warp_scan_prefix_type =
-        ::rocprim::detail::warp_scan_crosslane<unsigned int, detail::next_power_of_two(warps_no)>;
-
-public:
-
-    struct storage_type_
-    {
-        unsigned int warp_prefixes[warps_no];
-        // ---------- Shared memory optimisation ----------
-        // Since we use warp_scan_crosslane for warp scan, we don't need to allocate
-        // any temporary memory for it.
-    };
-
-    using storage_type = detail::raw_storage<storage_type_>;
-
-    template<unsigned int ItemsPerThread>
-    ROCPRIM_DEVICE ROCPRIM_INLINE
-    void exclusive_scan(const unsigned int (&input)[ItemsPerThread],
-                        unsigned int (&output)[ItemsPerThread],
-                        unsigned int& reduction,
-                        storage_type& storage)
-    {
-        const unsigned int flat_id = ::rocprim::flat_block_thread_id<BlockSizeX, BlockSizeY, BlockSizeZ>();
-        const unsigned int lane_id = ::rocprim::lane_id();
-        const unsigned int warp_id = ::rocprim::warp_id(flat_id);
-        storage_type_& storage_ = storage.get();
-
-        unsigned int warp_reduction = ::rocprim::bit_count(::rocprim::ballot(input[0]));
-        for(unsigned int i = 1; i < ItemsPerThread; i++)
-        {
-            warp_reduction += ::rocprim::bit_count(::rocprim::ballot(input[i]));
-        }
-        if(lane_id == 0)
-        {
-            storage_.warp_prefixes[warp_id] = warp_reduction;
-        }
-        ::rocprim::syncthreads();
-
-        // Scan the warp reduction results to calculate warp prefixes
-        if(flat_id < warps_no)
-        {
-            unsigned int prefix = storage_.warp_prefixes[flat_id];
-            warp_scan_prefix_type().inclusive_scan(prefix, prefix, ::rocprim::plus<unsigned int>());
-            storage_.warp_prefixes[flat_id] = prefix;
-        }
-#ifdef __HIP_CPU_RT__
-        else
-        {
-            // HIP-CPU doesn't implement lockstep behavior. Need to invoke the same number sync ops in divergent branch.
-            empty_type empty;
-            ::rocprim::detail::warp_scan_crosslane<empty_type, detail::next_power_of_two(warps_no)>().inclusive_scan(empty, empty, empty_binary_op{});
-        }
-#endif
-        ::rocprim::syncthreads();
-
-        // Perform exclusive warp scan of bit values
-        unsigned int lane_prefix = 0;
-        for(unsigned int i = 0; i < ItemsPerThread; i++)
-        {
-            lane_prefix = ::rocprim::masked_bit_count(::rocprim::ballot(input[i]), lane_prefix);
-        }
-
-        // Scan the lane's items and calculate final scan results
-        output[0] = warp_id == 0
-            ? lane_prefix
-            : lane_prefix + storage_.warp_prefixes[warp_id - 1];
-        for(unsigned int i = 1; i < ItemsPerThread; i++)
-        {
-            output[i] = output[i - 1] + input[i - 1];
-        }
-
-        // Get the final inclusive reduction result
-        reduction = storage_.warp_prefixes[warps_no - 1];
-    }
-};
-
-} // end namespace detail
-
 /// \brief The block_radix_sort class is a block level parallel primitive which provides
 /// methods sorting items (keys or key-value pairs) partitioned across threads in a block
 /// using radix sort algorithm.
@@ -151,10 +48,15 @@ public:
 /// \tparam ItemsPerThread - the number of items contributed by each thread.
 /// \tparam Value - the value type. Default type empty_type indicates
 /// a keys-only sort.
+/// \tparam BlockSizeY - the number of threads in a block's y dimension, defaults to 1.
+/// \tparam BlockSizeZ - the number of threads in a block's z dimension, defaults to 1.
+/// \tparam RadixBitsPerPass - the number of bits of keys sorted by each pass, defaults to 4.
 ///
 /// \par Overview
 /// * \p Key type must be an arithmetic type (that is, an integral type or a floating-point
 /// type).
+/// * Each pass ranks a digit of \p RadixBitsPerPass bits with block_radix_rank and exchanges
+/// the items to their ranks, <tt>BlockSize * ItemsPerThread</tt> must not exceed 65536.
 /// * Performance depends on \p BlockSize and \p ItemsPerThread.
 ///   * It is usually better of \p BlockSize is a multiple of the size of the hardware warp.
 ///   * It is usually increased when \p ItemsPerThread is greater than one. However, when there
@@ -194,15 +96,16 @@ template<
     unsigned int ItemsPerThread,
     class Value = empty_type,
     unsigned int BlockSizeY = 1,
-    unsigned int BlockSizeZ = 1
+    unsigned int BlockSizeZ = 1,
+    unsigned int RadixBitsPerPass = 4
 >
 class block_radix_sort
 {
     static constexpr unsigned int BlockSize = BlockSizeX * BlockSizeY * BlockSizeZ;
     static constexpr bool with_values = !std::is_same<Value, empty_type>::value;
 
-    using bit_key_type = typename ::rocprim::detail::radix_key_codec<Key>::bit_key_type;
-    using bit_block_scan = detail::block_bit_plus_scan<BlockSizeX, BlockSizeY, BlockSizeZ>;
+    using bit_key_type = typename ::rocprim::detail::radix_bit_key<Key>::type;
+    using radix_rank_type = ::rocprim::block_radix_rank<BlockSizeX, RadixBitsPerPass, BlockSizeY, BlockSizeZ>;
 
     using bit_keys_exchange_type = ::rocprim::block_exchange<bit_key_type, BlockSizeX, ItemsPerThread, BlockSizeY, BlockSizeZ>;
     using values_exchange_type = ::rocprim::block_exchange<Value, BlockSizeX, ItemsPerThread, BlockSizeY, BlockSizeZ>;
@@ -214,8 +117,8 @@ class block_radix_sort
         {
             typename bit_keys_exchange_type::storage_type bit_keys_exchange;
             typename values_exchange_type::storage_type values_exchange;
+            typename radix_rank_type::storage_type radix_rank;
         };
-        typename block_radix_sort<Key,BlockSizeX,ItemsPerThread,Value,BlockSizeY,BlockSizeZ>::bit_block_scan::storage_type bit_block_scan;
     };
 
 public:
@@ -885,54 +788,346 @@ public:
         sort_desc_to_striped(keys, values, storage, begin_bit, end_bit);
     }
 
+    /// \overload
+    /// \brief Performs ascending radix sort over composite keys partitioned across threads
+    /// in a block.
+    ///
+    /// \tparam Decomposer - type of function object which returns a ::rocprim::tuple of
+    /// references to the key's fields, from the most significant to the least significant.
+    /// Its signature should be <tt>::rocprim::tuple<T1&, T2&, ...> f(Key& key) const</tt>.
+    ///
+    /// \param [in, out] keys - reference to an array of keys provided by a thread.
+    /// \param [in] storage - reference to a temporary storage object of type storage_type.
+    /// \param [in] decomposer - function object that decomposes keys into fields, each field is
+    /// encoded as an arithmetic key and the fields are sorted as a single concatenated bit string.
+    /// \param [in] begin_bit - [optional] index of the first (least significant) bit of the
+    /// concatenated fields used in key comparison. Default value: \p 0.
+    /// \param [in] end_bit - [optional] past-the-end index (most significant) bit of the
+    /// concatenated fields used in key comparison. Default value: the total number of bits
+    /// of the fields.
+    ///
+    /// \par Storage reusage
+    /// Synchronization barrier should be placed before \p storage is reused
+    /// or repurposed: \p __syncthreads() or \p rocprim::syncthreads().
+    template<
+        class Decomposer,
+        class = typename std::enable_if<!std::is_integral<Decomposer>::value>::type
+    >
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void sort(Key (&keys)[ItemsPerThread],
+              storage_type& storage,
+              Decomposer decomposer,
+              unsigned int begin_bit = 0,
+              unsigned int end_bit = detail::radix_key_bits<Key, Decomposer>::value)
+    {
+        empty_type values[ItemsPerThread];
+        sort_impl<false>(keys, values, storage, begin_bit, end_bit, decomposer);
+    }
+
+    /// \overload
+    /// \brief Performs ascending radix sort over key-value pairs with composite keys
+    /// partitioned across threads in a block.
+    ///
+    /// \tparam Decomposer - type of function object which returns a ::rocprim::tuple of
+    /// references to the key's fields, from the most significant to the least significant.
+    /// Its signature should be <tt>::rocprim::tuple<T1&, T2&, ...> f(Key& key) const</tt>.
+    ///
+    /// \param [in, out] keys - reference to an array of keys provided by a thread.
+    /// \param [in, out] values - reference to an array of values provided by a thread.
+    /// \param [in] storage - reference to a temporary storage object of type storage_type.
+    /// \param [in] decomposer - function object that decomposes keys into fields, each field is
+    /// encoded as an arithmetic key and the fields are sorted as a single concatenated bit string.
+    /// \param [in] begin_bit - [optional] index of the first (least significant) bit of the
+    /// concatenated fields used in key comparison. Default value: \p 0.
+    /// \param [in] end_bit - [optional] past-the-end index (most significant) bit of the
+    /// concatenated fields used in key comparison. Default value: the total number of bits
+    /// of the fields.
+    ///
+    /// \par Storage reusage
+    /// Synchronization barrier should be placed before \p storage is reused
+    /// or repurposed: \p __syncthreads() or \p rocprim::syncthreads().
+    template<
+        class Decomposer,
+        bool WithValues = with_values,
+        class = typename std::enable_if<!std::is_integral<Decomposer>::value>::type
+    >
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void sort(Key (&keys)[ItemsPerThread],
+              typename std::enable_if<WithValues, Value>::type (&values)[ItemsPerThread],
+              storage_type& storage,
+              Decomposer decomposer,
+              unsigned int begin_bit = 0,
+              unsigned int end_bit = detail::radix_key_bits<Key, Decomposer>::value)
+    {
+        sort_impl<false>(keys, values, storage, begin_bit, end_bit, decomposer);
+    }
+
+    /// \overload
+    /// \brief Performs descending radix sort over composite keys partitioned across threads
+    /// in a block.
+    ///
+    /// \tparam Decomposer - type of function object which returns a ::rocprim::tuple of
+    /// references to the key's fields, from the most significant to the least significant.
+    /// Its signature should be <tt>::rocprim::tuple<T1&, T2&, ...> f(Key& key) const</tt>.
+    ///
+    /// \param [in, out] keys - reference to an array of keys provided by a thread.
+    /// \param [in] storage - reference to a temporary storage object of type storage_type.
+    /// \param [in] decomposer - function object that decomposes keys into fields, each field is
+    /// encoded as an arithmetic key and the fields are sorted as a single concatenated bit string.
+    /// \param [in] begin_bit - [optional] index of the first (least significant) bit of the
+    /// concatenated fields used in key comparison. Default value: \p 0.
+    /// \param [in] end_bit - [optional] past-the-end index (most significant) bit of the
+    /// concatenated fields used in key comparison. Default value: the total number of bits
+    /// of the fields.
+    ///
+    /// \par Storage reusage
+    /// Synchronization barrier should be placed before \p storage is reused
+    /// or repurposed: \p __syncthreads() or \p rocprim::syncthreads().
+    template<
+        class Decomposer,
+        class = typename std::enable_if<!std::is_integral<Decomposer>::value>::type
+    >
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void sort_desc(Key (&keys)[ItemsPerThread],
+                   storage_type& storage,
+                   Decomposer decomposer,
+                   unsigned int begin_bit = 0,
+                   unsigned int end_bit = detail::radix_key_bits<Key, Decomposer>::value)
+    {
+        empty_type values[ItemsPerThread];
+        sort_impl<true>(keys, values, storage, begin_bit, end_bit, decomposer);
+    }
+
+    /// \overload
+    /// \brief Performs descending radix sort over key-value pairs with composite keys
+    /// partitioned across threads in a block.
+    ///
+    /// \tparam Decomposer - type of function object which returns a ::rocprim::tuple of
+    /// references to the key's fields, from the most significant to the least significant.
+    /// Its signature should be <tt>::rocprim::tuple<T1&, T2&, ...> f(Key& key) const</tt>.
+    ///
+    /// \param [in, out] keys - reference to an array of keys provided by a thread.
+    /// \param [in, out] values - reference to an array of values provided by a thread.
+    /// \param [in] storage - reference to a temporary storage object of type storage_type.
+    /// \param [in] decomposer - function object that decomposes keys into fields, each field is
+    /// encoded as an arithmetic key and the fields are sorted as a single concatenated bit string.
+    /// \param [in] begin_bit - [optional] index of the first (least significant) bit of the
+    /// concatenated fields used in key comparison. Default value: \p 0.
+    /// \param [in] end_bit - [optional] past-the-end index (most significant) bit of the
+    /// concatenated fields used in key comparison. Default value: the total number of bits
+    /// of the fields.
+    ///
+    /// \par Storage reusage
+    /// Synchronization barrier should be placed before \p storage is reused
+    /// or repurposed: \p __syncthreads() or \p rocprim::syncthreads().
+    template<
+        class Decomposer,
+        bool WithValues = with_values,
+        class = typename std::enable_if<!std::is_integral<Decomposer>::value>::type
+    >
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void sort_desc(Key (&keys)[ItemsPerThread],
+                   typename std::enable_if<WithValues, Value>::type (&values)[ItemsPerThread],
+                   storage_type& storage,
+                   Decomposer decomposer,
+                   unsigned int begin_bit = 0,
+                   unsigned int end_bit = detail::radix_key_bits<Key, Decomposer>::value)
+    {
+        sort_impl<true>(keys, values, storage, begin_bit, end_bit, decomposer);
+    }
+
+    /// \overload
+    /// \brief Performs ascending radix sort over composite keys partitioned across threads
+    /// in a block, results are saved in a striped arrangement.
+    ///
+    /// \tparam Decomposer - type of function object which returns a ::rocprim::tuple of
+    /// references to the key's fields, from the most significant to the least significant.
+    /// Its signature should be <tt>::rocprim::tuple<T1&, T2&, ...> f(Key& key) const</tt>.
+    ///
+    /// \param [in, out] keys - reference to an array of keys provided by a thread.
+    /// \param [in] storage - reference to a temporary storage object of type storage_type.
+    /// \param [in] decomposer - function object that decomposes keys into fields, each field is
+    /// encoded as an arithmetic key and the fields are sorted as a single concatenated bit string.
+    /// \param [in] begin_bit - [optional] index of the first (least significant) bit of the
+    /// concatenated fields used in key comparison. Default value: \p 0.
+    /// \param [in] end_bit - [optional] past-the-end index (most significant) bit of the
+    /// concatenated fields used in key comparison. Default value: the total number of bits
+    /// of the fields.
+    ///
+    /// \par Storage reusage
+    /// Synchronization barrier should be placed before \p storage is reused
+    /// or repurposed: \p __syncthreads() or \p rocprim::syncthreads().
+    template<
+        class Decomposer,
+        class = typename std::enable_if<!std::is_integral<Decomposer>::value>::type
+    >
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void sort_to_striped(Key (&keys)[ItemsPerThread],
+                         storage_type& storage,
+                         Decomposer decomposer,
+                         unsigned int begin_bit = 0,
+                         unsigned int end_bit = detail::radix_key_bits<Key, Decomposer>::value)
+    {
+        empty_type values[ItemsPerThread];
+        sort_impl<false, true>(keys, values, storage, begin_bit, end_bit, decomposer);
+    }
+
+    /// \overload
+    /// \brief Performs ascending radix sort over key-value pairs with composite keys
+    /// partitioned across threads in a block, results are saved in a striped arrangement.
+    ///
+    /// \tparam Decomposer - type of function object which returns a ::rocprim::tuple of
+    /// references to the key's fields, from the most significant to the least significant.
+    /// Its signature should be <tt>::rocprim::tuple<T1&, T2&, ...> f(Key& key) const</tt>.
+    ///
+    /// \param [in, out] keys - reference to an array of keys provided by a thread.
+    /// \param [in, out] values - reference to an array of values provided by a thread.
+    /// \param [in] storage - reference to a temporary storage object of type storage_type.
+    /// \param [in] decomposer - function object that decomposes keys into fields, each field is
+    /// encoded as an arithmetic key and the fields are sorted as a single concatenated bit string.
+    /// \param [in] begin_bit - [optional] index of the first (least significant) bit of the
+    /// concatenated fields used in key comparison. Default value: \p 0.
+    /// \param [in] end_bit - [optional] past-the-end index (most significant) bit of the
+    /// concatenated fields used in key comparison. Default value: the total number of bits
+    /// of the fields.
+    ///
+    /// \par Storage reusage
+    /// Synchronization barrier should be placed before \p storage is reused
+    /// or repurposed: \p __syncthreads() or \p rocprim::syncthreads().
+    template<
+        class Decomposer,
+        bool WithValues = with_values,
+        class = typename std::enable_if<!std::is_integral<Decomposer>::value>::type
+    >
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void sort_to_striped(Key (&keys)[ItemsPerThread],
+                         typename std::enable_if<WithValues, Value>::type (&values)[ItemsPerThread],
+                         storage_type& storage,
+                         Decomposer decomposer,
+                         unsigned int begin_bit = 0,
+                         unsigned int end_bit = detail::radix_key_bits<Key, Decomposer>::value)
+    {
+        sort_impl<false, true>(keys, values, storage, begin_bit, end_bit, decomposer);
+    }
+
+    /// \overload
+    /// \brief Performs descending radix sort over composite keys partitioned across threads
+    /// in a block, results are saved in a striped arrangement.
+    ///
+    /// \tparam Decomposer - type of function object which returns a ::rocprim::tuple of
+    /// references to the key's fields, from the most significant to the least significant.
+    /// Its signature should be <tt>::rocprim::tuple<T1&, T2&, ...> f(Key& key) const</tt>.
+    ///
+    /// \param [in, out] keys - reference to an array of keys provided by a thread.
+    /// \param [in] storage - reference to a temporary storage object of type storage_type.
+    /// \param [in] decomposer - function object that decomposes keys into fields, each field is
+    /// encoded as an arithmetic key and the fields are sorted as a single concatenated bit string.
+    /// \param [in] begin_bit - [optional] index of the first (least significant) bit of the
+    /// concatenated fields used in key comparison. Default value: \p 0.
+    /// \param [in] end_bit - [optional] past-the-end index (most significant) bit of the
+    /// concatenated fields used in key comparison. Default value: the total number of bits
+    /// of the fields.
+    ///
+    /// \par Storage reusage
+    /// Synchronization barrier should be placed before \p storage is reused
+    /// or repurposed: \p __syncthreads() or \p rocprim::syncthreads().
+    template<
+        class Decomposer,
+        class = typename std::enable_if<!std::is_integral<Decomposer>::value>::type
+    >
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void sort_desc_to_striped(Key (&keys)[ItemsPerThread],
+                              storage_type& storage,
+                              Decomposer decomposer,
+                              unsigned int begin_bit = 0,
+                              unsigned int end_bit = detail::radix_key_bits<Key, Decomposer>::value)
+    {
+        empty_type values[ItemsPerThread];
+        sort_impl<true, true>(keys, values, storage, begin_bit, end_bit, decomposer);
+    }
+
+    /// \overload
+    /// \brief Performs descending radix sort over key-value pairs with composite keys
+    /// partitioned across threads in a block, results are saved in a striped arrangement.
+    ///
+    /// \tparam Decomposer - type of function object which returns a ::rocprim::tuple of
+    /// references to the key's fields, from the most significant to the least significant.
+    /// Its signature should be <tt>::rocprim::tuple<T1&, T2&, ...> f(Key& key) const</tt>.
+    ///
+    /// \param [in, out] keys - reference to an array of keys provided by a thread.
+    /// \param [in, out] values - reference to an array of values provided by a thread.
+    /// \param [in] storage - reference to a temporary storage object of type storage_type.
+    /// \param [in] decomposer - function object that decomposes keys into fields, each field is
+    /// encoded as an arithmetic key and the fields are sorted as a single concatenated bit string.
+    /// \param [in] begin_bit - [optional] index of the first (least significant) bit of the
+    /// concatenated fields used in key comparison. Default value: \p 0.
+    /// \param [in] end_bit - [optional] past-the-end index (most significant) bit of the
+    /// concatenated fields used in key comparison. Default value: the total number of bits
+    /// of the fields.
+    ///
+    /// \par Storage reusage
+    /// Synchronization barrier should be placed before \p storage is reused
+    /// or repurposed: \p __syncthreads() or \p rocprim::syncthreads().
+    template<
+        class Decomposer,
+        bool WithValues = with_values,
+        class = typename std::enable_if<!std::is_integral<Decomposer>::value>::type
+    >
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void sort_desc_to_striped(Key (&keys)[ItemsPerThread],
+                              typename std::enable_if<WithValues, Value>::type (&values)[ItemsPerThread],
+                              storage_type& storage,
+                              Decomposer decomposer,
+                              unsigned int begin_bit = 0,
+                              unsigned int end_bit = detail::radix_key_bits<Key, Decomposer>::value)
+    {
+        sort_impl<true, true>(keys, values, storage, begin_bit, end_bit, decomposer);
+    }
+
 private:
 
-    template<bool Descending, bool ToStriped = false, class SortedValue>
+    template<
+        bool Descending,
+        bool ToStriped = false,
+        class SortedValue,
+        class Decomposer = ::rocprim::detail::identity_decomposer
+    >
     ROCPRIM_DEVICE ROCPRIM_INLINE
     void sort_impl(Key (&keys)[ItemsPerThread],
                    SortedValue (&values)[ItemsPerThread],
                    storage_type& storage,
                    unsigned int begin_bit,
-                   unsigned int end_bit)
+                   unsigned int end_bit,
+                   Decomposer decomposer = Decomposer())
     {
-        using key_codec = ::rocprim::detail::radix_key_codec<Key, Descending>;
+        using key_codec = ::rocprim::detail::radix_key_codec<Key, Descending, Decomposer>;
+        static_assert(std::is_same<typename key_codec::bit_key_type, bit_key_type>::value,
+                      "Decomposers are only supported for non-arithmetic keys");
         storage_type_& storage_ = storage.get();
-
-        const unsigned int flat_id = ::rocprim::flat_block_thread_id<BlockSizeX, BlockSizeY, BlockSizeZ>();
+        const key_codec codec(decomposer);
 
         bit_key_type bit_keys[ItemsPerThread];
         for(unsigned int i = 0; i < ItemsPerThread; i++)
         {
-            bit_keys[i] = key_codec::encode(keys[i]);
+            bit_keys[i] = codec.encode(keys[i]);
         }
 
-        // Use binary digits (i.e. digits can be 0 or 1)
-        for(unsigned int bit = begin_bit; bit < end_bit; bit++)
+        for(unsigned int bit = begin_bit; bit < end_bit; bit += RadixBitsPerPass)
         {
-            unsigned int bits[ItemsPerThread];
-            for(unsigned int i = 0; i < ItemsPerThread; i++)
-            {
-                bits[i] = key_codec::extract_digit(bit_keys[i], bit, 1);
-            }
+            const unsigned int pass_bits = ::rocprim::min(RadixBitsPerPass, end_bit - bit);
 
-            unsigned int ranks[ItemsPerThread];
-#ifdef __HIP_CPU_RT__
-            // TODO: Check if really necessary
-            // Initialize contents, as non-hipcc compilers don't unconditionally zero out allocated memory
-            std::memset(ranks, 0, ItemsPerThread * sizeof(decltype(ranks[0])));
-#endif
-            unsigned int count;
-            bit_block_scan().exclusive_scan(bits, ranks, count, storage_.bit_block_scan);
-
-            // Scatter keys to computed positions considering starting positions of their digit values
-            const unsigned int start = BlockSize * ItemsPerThread - count;
-            for(unsigned int i = 0; i < ItemsPerThread; i++)
+            if(bit != begin_bit)
             {
-                // Calculate position for the first digit (0) value based on positions of the second (1)
-                ranks[i] = bits[i] != 0
-                    ? (start + ranks[i])
-                    : (flat_id * ItemsPerThread + i - ranks[i]);
+                ::rocprim::syncthreads(); // Storage will be reused (union), synchronization is needed
             }
+            unsigned int ranks[ItemsPerThread];
+            radix_rank_type().rank_keys(
+                bit_keys, ranks, storage_.radix_rank,
+                detail::radix_rank_bit_key_digit_extractor<Key, Descending, Decomposer>{
+                    bit, pass_bits, codec
+                }
+            );
+
             exchange_keys(storage, bit_keys, ranks);
             exchange_values(storage, values, ranks);
         }
@@ -945,7 +1140,7 @@ private:
 
         for(unsigned int i = 0; i < ItemsPerThread; i++)
         {
-            keys[i] = key_codec::decode(bit_keys[i]);
+            keys[i] = codec.decode(bit_keys[i]);
         }
     }
 
@@ -955,7 +1150,7 @@ private:
                        const unsigned int (&ranks)[ItemsPerThread])
     {
         storage_type_& storage_ = storage.get();
-        // Synchronization is omitted here because bit_block_scan already calls it
+        ::rocprim::syncthreads(); // Storage will be reused (union), synchronization is needed
         bit_keys_exchange_type().scatter_to_blocked(bit_keys, bit_keys, ranks, storage_.bit_keys_exchange);
     }
 
@@ -71,6 +71,14 @@
     #define ROCPRIM_DETAIL_USE_LOOKBACK_SCAN true
 #endif
 
+// With the HIP-CPU runtime, device level algorithms which have host-native implementations run
+// them on host threads instead of emulating blocks and warps.
+#if defined(__HIP_CPU_RT__) && !defined(ROCPRIM_DISABLE_HOST_NATIVE)
+    #define ROCPRIM_DETAIL_USE_HOST_NATIVE 1
+#else
+    #define ROCPRIM_DETAIL_USE_HOST_NATIVE 0
+#endif
+
 #ifndef ROCPRIM_THREAD_LOAD_USE_CACHE_MODIFIERS
     #define ROCPRIM_THREAD_LOAD_USE_CACHE_MODIFIERS 1
 #endif
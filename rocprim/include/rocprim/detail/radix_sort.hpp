@@ -25,6 +25,7 @@
 
 #include "../config.hpp"
 #include "../type_traits.hpp"
+#include "../types/tuple.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 namespace detail
@@ -220,14 +221,27 @@ struct radix_key_codec_base<float> : radix_key_codec_floating<float, unsigned in
 template<>
 struct radix_key_codec_base<double> : radix_key_codec_floating<double, unsigned long long> { };
 
-template<class Key, bool Descending = false>
-class radix_key_codec : protected radix_key_codec_base<Key>
+// Decomposer used when keys are sorted as a whole, i.e. keys are of an arithmetic type.
+struct identity_decomposer
+{
+};
+
+template<class Key, bool Descending = false, class Decomposer = identity_decomposer>
+class radix_key_codec;
+
+template<class Key, bool Descending>
+class radix_key_codec<Key, Descending, identity_decomposer> : protected radix_key_codec_base<Key>
 {
     using base_type = radix_key_codec_base<Key>;
 
 public:
     using bit_key_type = typename base_type::bit_key_type;
 
+    ROCPRIM_HOST_DEVICE ROCPRIM_INLINE
+    explicit radix_key_codec(identity_decomposer = identity_decomposer())
+    {
+    }
+
     ROCPRIM_DEVICE ROCPRIM_INLINE
     static bit_key_type encode(Key key)
     {
@@ -247,6 +261,219 @@ public:
     {
         return base_type::extract_digit(bit_key, start, radix_bits);
     }
+
+    // Key which goes after all other keys
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    static Key get_out_of_bounds_key()
+    {
+        return decode(bit_key_type(-1));
+    }
+};
+
+template<unsigned int... Values>
+struct radix_fields_bits_sum;
+
+template<>
+struct radix_fields_bits_sum<> : std::integral_constant<unsigned int, 0>
+{
+};
+
+template<unsigned int Value, unsigned int... Values>
+struct radix_fields_bits_sum<Value, Values...>
+    : std::integral_constant<unsigned int, Value + radix_fields_bits_sum<Values...>::value>
+{
+};
+
+template<class FieldRefs>
+struct radix_decomposed_key_bits;
+
+template<class... FieldRefs>
+struct radix_decomposed_key_bits<::rocprim::tuple<FieldRefs...>>
+    : radix_fields_bits_sum<8 * sizeof(typename std::decay<FieldRefs>::type)...>
+{
+};
+
+// Number of bits of keys which are sorted by radix sort, for a composite key it is the total
+// number of bits of its fields (padding is excluded).
+template<class Key, class Decomposer>
+struct radix_key_bits
+    : radix_decomposed_key_bits<decltype(std::declval<Decomposer>()(std::declval<Key&>()))>
+{
+};
+
+template<class Key>
+struct radix_key_bits<Key, identity_decomposer>
+    : std::integral_constant<unsigned int, 8 * sizeof(Key)>
+{
+};
+
+// Type of encoded keys: composite (non-arithmetic) keys are encoded in place.
+template<class Key, bool = ::rocprim::is_arithmetic<Key>::value>
+struct radix_bit_key
+{
+    using type = Key;
+};
+
+template<class Key>
+struct radix_bit_key<Key, true>
+{
+    using type = typename radix_key_codec<Key>::bit_key_type;
+};
+
+// Codec for composite keys: the decomposer returns a ::rocprim::tuple of references to fields of
+// the key, the first field is the most significant one. Every field is encoded in place by the
+// codec of its type, so "bit keys" have the same type as keys, and digits are extracted from
+// the concatenation of the fields' bits.
+template<class Key, bool Descending, class Decomposer>
+class radix_key_codec
+{
+    using field_refs_type = decltype(std::declval<Decomposer>()(std::declval<Key&>()));
+    static constexpr size_t fields = ::rocprim::tuple_size<field_refs_type>::value;
+
+    template<size_t I>
+    using field_type = typename std::decay<::rocprim::tuple_element_t<I, field_refs_type>>::type;
+
+    template<size_t I>
+    using field_codec = radix_key_codec<field_type<I>, Descending>;
+
+    template<size_t I>
+    using field_bit_key_type = typename field_codec<I>::bit_key_type;
+
+public:
+    using bit_key_type = Key;
+
+    ROCPRIM_HOST_DEVICE ROCPRIM_INLINE
+    explicit radix_key_codec(Decomposer decomposer = Decomposer())
+        : decomposer_(decomposer)
+    {
+    }
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    bit_key_type encode(Key key) const
+    {
+        auto field_refs = decomposer_(key);
+        encode_fields(field_refs);
+        return key;
+    }
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    Key decode(bit_key_type bit_key) const
+    {
+        auto field_refs = decomposer_(bit_key);
+        decode_fields(field_refs);
+        return bit_key;
+    }
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    unsigned int extract_digit(bit_key_type bit_key, unsigned int start, unsigned int radix_bits) const
+    {
+        auto field_refs = decomposer_(bit_key);
+        unsigned int digit = 0;
+        extract_fields_digit<fields>(field_refs, start, radix_bits, 0, digit);
+        return digit;
+    }
+
+    // Key which goes after all other keys
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    Key get_out_of_bounds_key() const
+    {
+        Key bit_key{};
+        auto field_refs = decomposer_(bit_key);
+        fill_fields(field_refs);
+        return decode(bit_key);
+    }
+
+private:
+    template<size_t I = 0>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    static auto encode_fields(field_refs_type& field_refs)
+        -> typename std::enable_if<(I < fields)>::type
+    {
+        static_assert(!std::is_same<field_type<I>, bool>::value,
+                      "bool fields of composite keys are not supported");
+        auto& field = ::rocprim::get<I>(field_refs);
+        field = __builtin_bit_cast(field_type<I>, field_codec<I>::encode(field));
+        encode_fields<I + 1>(field_refs);
+    }
+
+    template<size_t I = 0>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    static auto encode_fields(field_refs_type&)
+        -> typename std::enable_if<(I == fields)>::type
+    {
+    }
+
+    template<size_t I = 0>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    static auto decode_fields(field_refs_type& field_refs)
+        -> typename std::enable_if<(I < fields)>::type
+    {
+        auto& field = ::rocprim::get<I>(field_refs);
+        field = field_codec<I>::decode(__builtin_bit_cast(field_bit_key_type<I>, field));
+        decode_fields<I + 1>(field_refs);
+    }
+
+    template<size_t I = 0>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    static auto decode_fields(field_refs_type&)
+        -> typename std::enable_if<(I == fields)>::type
+    {
+    }
+
+    template<size_t I = 0>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    static auto fill_fields(field_refs_type& field_refs)
+        -> typename std::enable_if<(I < fields)>::type
+    {
+        ::rocprim::get<I>(field_refs) = __builtin_bit_cast(field_type<I>, field_bit_key_type<I>(-1));
+        fill_fields<I + 1>(field_refs);
+    }
+
+    template<size_t I = 0>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    static auto fill_fields(field_refs_type&)
+        -> typename std::enable_if<(I == fields)>::type
+    {
+    }
+
+    // Fields are visited from the least significant (the last one), field_start is the index
+    // of the first bit of the I-1-th field in the concatenated bit key
+    template<size_t I>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    static auto extract_fields_digit(const field_refs_type& field_refs,
+                                     unsigned int start,
+                                     unsigned int radix_bits,
+                                     unsigned int field_start,
+                                     unsigned int& digit)
+        -> typename std::enable_if<(I > 0)>::type
+    {
+        constexpr unsigned int field_bits = 8 * sizeof(field_type<I - 1>);
+        const unsigned int field_end = field_start + field_bits;
+        const unsigned int end = start + radix_bits;
+        if(start < field_end && field_start < end)
+        {
+            const unsigned int from = start > field_start ? start : field_start;
+            const unsigned int to = end < field_end ? end : field_end;
+            const field_bit_key_type<I - 1> field_bit_key
+                = __builtin_bit_cast(field_bit_key_type<I - 1>, ::rocprim::get<I - 1>(field_refs));
+            digit |= field_codec<I - 1>::extract_digit(field_bit_key, from - field_start, to - from)
+                << (from - start);
+        }
+        extract_fields_digit<I - 1>(field_refs, start, radix_bits, field_end, digit);
+    }
+
+    template<size_t I>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    static auto extract_fields_digit(const field_refs_type&,
+                                     unsigned int,
+                                     unsigned int,
+                                     unsigned int,
+                                     unsigned int&)
+        -> typename std::enable_if<(I == 0)>::type
+    {
+    }
+
+    Decomposer decomposer_;
 };
 
 } // end namespace detail
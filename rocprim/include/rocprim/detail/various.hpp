@@ -21,6 +21,7 @@
 #ifndef ROCPRIM_DETAIL_VARIOUS_HPP_
 #define ROCPRIM_DETAIL_VARIOUS_HPP_
 
+#include <iterator>
 #include <type_traits>
 
 #include "../config.hpp"
@@ -212,6 +213,30 @@ bool are_iterators_equal(Iterator iter1, Iterator iter2)
     return iter1 == iter2;
 }
 
+// Checks if sorts with Config move values of type Value through 32-bit indices (values larger
+// than Config::indirect_value_bytes) instead of moving them on every pass
+template<class Config, class Value>
+struct is_indirect_sort
+    : std::integral_constant<bool,
+                             (!std::is_same<Value, empty_type>::value
+                              && sizeof(Value) > Config::indirect_value_bytes
+                              && sizeof(Value) > sizeof(unsigned int))>
+{};
+
+// Gathers values of an indirect sort: returns the value at the given index
+template<class InputIterator>
+struct indirect_gather_op
+{
+    InputIterator input;
+
+    ROCPRIM_HOST_DEVICE inline
+    typename std::iterator_traits<InputIterator>::value_type
+        operator()(const unsigned int index) const
+    {
+        return input[index];
+    }
+};
+
 template<class...>
 using void_t = void;
 
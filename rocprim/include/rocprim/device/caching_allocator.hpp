@@ -0,0 +1,425 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_CACHING_ALLOCATOR_HPP_
+#define ROCPRIM_DEVICE_CACHING_ALLOCATOR_HPP_
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "../config.hpp"
+
+/// \file
+///
+/// Stream-ordered caching allocator for the temporary storage of device level primitives
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule
+/// @{
+
+/// \brief Statistics of a \p caching_allocator.
+struct caching_allocator_statistics
+{
+    /// Number of allocations served from the cache.
+    size_t hits = 0;
+    /// Number of allocations which required a new device allocation.
+    size_t misses = 0;
+    /// Number of bytes held in the cache, available for reuse.
+    size_t cached_bytes = 0;
+    /// Number of bytes currently allocated by the users of the allocator.
+    size_t live_bytes = 0;
+};
+
+/// \brief A stream-ordered caching allocator of device memory.
+///
+/// Allocating the temporary storage of a device level primitive with \p hipMalloc and releasing
+/// it with \p hipFree after every call serializes the host and the device, which dominates the run
+/// time of small problems. caching_allocator keeps the deallocated blocks and hands them out
+/// again to later allocations.
+///
+/// \par Overview
+/// * The requested sizes are rounded up to size classes (bins), which are powers of
+/// \p bin_growth between <tt>bin_growth^min_bin</tt> and <tt>bin_growth^max_bin</tt> bytes.
+/// Allocations larger than the largest bin are not rounded up and are never cached.
+/// * Allocations are stream-ordered: a deallocated block can be reused by the stream which
+/// used it right away, and by other streams once the work enqueued on that stream before the
+/// deallocation has completed.
+/// * Blocks are allocated on the current device and only reused on the same device.
+/// * At most \p max_cached_bytes bytes are kept in the cache, blocks deallocated beyond that
+/// are freed.
+/// * All member functions are thread-safe.
+/// * The cached blocks are freed by \p trim and by the destructor. Blocks which are still
+/// allocated when the allocator is destroyed are not freed.
+///
+/// \par Example
+/// \parblock
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// rocprim::caching_allocator allocator;
+///
+/// for(/* every batch */)
+/// {
+///     // The temporary storage of the reduction is taken from the cache after the first batch
+///     rocprim::run_with_allocator(allocator, stream,
+///         [&](void * temporary_storage, size_t& storage_size)
+///         {
+///             return rocprim::reduce(temporary_storage, storage_size,
+///                                    input, output, input_size,
+///                                    rocprim::plus<int>(), stream);
+///         });
+/// }
+/// \endcode
+/// \endparblock
+class caching_allocator
+{
+public:
+    /// \brief Constructs the allocator.
+    ///
+    /// \param bin_growth - growth factor between the sizes of the bins.
+    /// \param min_bin - the smallest bin holds <tt>bin_growth^min_bin</tt> bytes.
+    /// \param max_bin - the largest bin holds <tt>bin_growth^max_bin</tt> bytes.
+    /// \param max_cached_bytes - maximum number of bytes kept in the cache.
+    caching_allocator(unsigned int bin_growth       = 8,
+                      unsigned int min_bin          = 3,
+                      unsigned int max_bin          = 7,
+                      size_t       max_cached_bytes = size_t(6) * 1024 * 1024)
+        : bin_growth_(bin_growth)
+        , min_bin_bytes_(power(bin_growth, min_bin))
+        , max_bin_bytes_(power(bin_growth, max_bin))
+        , max_cached_bytes_(max_cached_bytes)
+    {}
+
+    caching_allocator(const caching_allocator&) = delete;
+    caching_allocator& operator=(const caching_allocator&) = delete;
+
+    /// \brief Frees all cached blocks.
+    ~caching_allocator()
+    {
+        trim();
+    }
+
+    /// \brief Allocates \p bytes bytes of device memory on the current device, for use on
+    /// \p stream.
+    ///
+    /// \param [out] ptr - pointer to the allocated memory.
+    /// \param [in] bytes - number of bytes to allocate.
+    /// \param [in] stream - [optional] HIP stream on which the memory is used. Default is \p 0
+    /// (default stream).
+    ///
+    /// \returns \p hipSuccess (\p 0) after successful allocation; otherwise a HIP runtime error
+    /// of type \p hipError_t.
+    hipError_t allocate(void** ptr, size_t bytes, hipStream_t stream = 0)
+    {
+        if(ptr == nullptr)
+        {
+            return hipErrorInvalidValue;
+        }
+        *ptr = nullptr;
+
+        int        device;
+        hipError_t result = hipGetDevice(&device);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+
+        block_descriptor block;
+        block.device = device;
+        block.stream = stream;
+        block.bytes  = bin_bytes(bytes);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if(block.bytes <= max_bin_bytes_)
+        {
+            // Find a cached block of the same bin, which is idle or used by the same stream
+            const auto range = cached_blocks_.equal_range(block_key{device, block.bytes});
+            for(auto it = range.first; it != range.second; ++it)
+            {
+                const bool same_stream = it->second.stream == stream;
+                if(!same_stream && hipEventQuery(it->second.ready_event) != hipSuccess)
+                {
+                    continue;
+                }
+                block        = it->second;
+                block.stream = stream;
+                cached_blocks_.erase(it);
+
+                statistics_.hits++;
+                statistics_.cached_bytes -= block.bytes;
+                statistics_.live_bytes += block.bytes;
+                live_blocks_.emplace(block.ptr, block);
+                *ptr = block.ptr;
+                return hipSuccess;
+            }
+        }
+
+        result = hipMalloc(&block.ptr, block.bytes);
+        if(result == hipErrorOutOfMemory)
+        {
+            // Free the cached blocks of this device and retry
+            (void)hipGetLastError();
+            result = trim_device(device, 0);
+            if(result != hipSuccess)
+            {
+                return result;
+            }
+            result = hipMalloc(&block.ptr, block.bytes);
+        }
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+        result = hipEventCreateWithFlags(&block.ready_event, hipEventDisableTiming);
+        if(result != hipSuccess)
+        {
+            (void)hipFree(block.ptr);
+            return result;
+        }
+
+        statistics_.misses++;
+        statistics_.live_bytes += block.bytes;
+        live_blocks_.emplace(block.ptr, block);
+        *ptr = block.ptr;
+        return hipSuccess;
+    }
+
+    /// \brief Returns memory allocated by \p allocate to the allocator.
+    ///
+    /// The memory can be deallocated while work using it is still enqueued on its stream.
+    ///
+    /// \param [in] ptr - pointer returned by \p allocate.
+    ///
+    /// \returns \p hipSuccess (\p 0) after successful deallocation; \p hipErrorInvalidValue if
+    /// \p ptr was not allocated by this allocator; otherwise a HIP runtime error of type
+    /// \p hipError_t.
+    hipError_t deallocate(void* ptr)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        const auto it = live_blocks_.find(ptr);
+        if(it == live_blocks_.end())
+        {
+            return hipErrorInvalidValue;
+        }
+        const block_descriptor block = it->second;
+        live_blocks_.erase(it);
+        statistics_.live_bytes -= block.bytes;
+
+        if(block.bytes <= max_bin_bytes_
+           && statistics_.cached_bytes + block.bytes <= max_cached_bytes_)
+        {
+            const hipError_t result = hipEventRecord(block.ready_event, block.stream);
+            if(result != hipSuccess)
+            {
+                // The block can not be cached without its ready event, free it instead
+                (void)free_block(block);
+                return result;
+            }
+            cached_blocks_.emplace(block_key{block.device, block.bytes}, block);
+            statistics_.cached_bytes += block.bytes;
+            return hipSuccess;
+        }
+        return free_block(block);
+    }
+
+    /// \brief Frees cached blocks of all devices until at most \p max_cached_bytes bytes remain
+    /// in the cache. The largest blocks are freed first.
+    ///
+    /// \param [in] max_cached_bytes - [optional] number of bytes which may remain cached.
+    /// Default is \p 0 (all cached blocks are freed).
+    ///
+    /// \returns \p hipSuccess (\p 0) after successful trimming; otherwise a HIP runtime error of
+    /// type \p hipError_t.
+    hipError_t trim(size_t max_cached_bytes = 0)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return trim_device(-1, max_cached_bytes);
+    }
+
+    /// \brief Returns the hit/miss counters and the current numbers of cached and live bytes.
+    caching_allocator_statistics statistics() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return statistics_;
+    }
+
+    /// \brief Resets the hit and miss counters.
+    void reset_statistics()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        statistics_.hits   = 0;
+        statistics_.misses = 0;
+    }
+
+    /// \brief Returns the size of the block allocated for a request of \p bytes bytes.
+    size_t bin_bytes(size_t bytes) const
+    {
+        if(bytes > max_bin_bytes_)
+        {
+            return bytes;
+        }
+        size_t bin = min_bin_bytes_;
+        while(bin < bytes)
+        {
+            bin *= bin_growth_;
+        }
+        return bin;
+    }
+
+private:
+    struct block_descriptor
+    {
+        void*       ptr         = nullptr;
+        size_t      bytes       = 0;
+        int         device      = 0;
+        hipStream_t stream      = 0;
+        hipEvent_t  ready_event = nullptr;
+    };
+
+    // Cached blocks are ordered by device and size
+    using block_key = std::pair<int, size_t>;
+
+    static size_t power(size_t base, unsigned int exponent)
+    {
+        size_t result = 1;
+        for(unsigned int i = 0; i < exponent; i++)
+        {
+            result *= base;
+        }
+        return result;
+    }
+
+    // Frees a block, which is not in the cache, on its device
+    hipError_t free_block(const block_descriptor& block)
+    {
+        int        current_device;
+        hipError_t result = hipGetDevice(&current_device);
+        if(result != hipSuccess)
+        {
+            return result;
+        }
+        if(current_device != block.device)
+        {
+            result = hipSetDevice(block.device);
+            if(result != hipSuccess)
+            {
+                return result;
+            }
+        }
+        result                   = hipFree(block.ptr);
+        const hipError_t destroy = hipEventDestroy(block.ready_event);
+        if(current_device != block.device)
+        {
+            const hipError_t restore = hipSetDevice(current_device);
+            result                   = result != hipSuccess ? result : restore;
+        }
+        return result != hipSuccess ? result : destroy;
+    }
+
+    // Frees the largest cached blocks of device (or of all devices if it is -1) until at most
+    // max_cached_bytes bytes remain cached. The mutex must be held.
+    hipError_t trim_device(const int device, const size_t max_cached_bytes)
+    {
+        auto it = cached_blocks_.end();
+        while(it != cached_blocks_.begin() && statistics_.cached_bytes > max_cached_bytes)
+        {
+            --it;
+            if(device != -1 && it->second.device != device)
+            {
+                continue;
+            }
+            const block_descriptor block = it->second;
+            it                           = cached_blocks_.erase(it);
+            statistics_.cached_bytes -= block.bytes;
+
+            const hipError_t result = free_block(block);
+            if(result != hipSuccess)
+            {
+                return result;
+            }
+        }
+        return hipSuccess;
+    }
+
+    const unsigned int bin_growth_;
+    const size_t       min_bin_bytes_;
+    const size_t       max_bin_bytes_;
+    const size_t       max_cached_bytes_;
+
+    mutable std::mutex                          mutex_;
+    std::multimap<block_key, block_descriptor>  cached_blocks_;
+    std::unordered_map<void*, block_descriptor> live_blocks_;
+    caching_allocator_statistics                statistics_;
+};
+
+/// \brief Runs a device level primitive with its temporary storage taken from \p allocator.
+///
+/// \p function is called twice, in the same way as a device level primitive is: first with a
+/// null \p temporary_storage to query the required size, then with the allocated storage.
+/// The storage is returned to the allocator when \p function returns, it is reused by later
+/// calls on the same stream without synchronization.
+///
+/// \tparam Allocator - type of the allocator, e.g. \p caching_allocator. It must provide
+/// <tt>hipError_t allocate(void**, size_t, hipStream_t)</tt> and
+/// <tt>hipError_t deallocate(void*)</tt>.
+/// \tparam Function - type of the callable, with signature
+/// <tt>hipError_t (void* temporary_storage, size_t& storage_size)</tt>.
+///
+/// \param [in] allocator - allocator of the temporary storage.
+/// \param [in] stream - HIP stream on which \p function runs the primitive.
+/// \param [in] function - callable running the primitive.
+///
+/// \returns \p hipSuccess (\p 0) if the primitive ran successfully; otherwise the first error
+/// returned by \p function or by the allocator.
+template<class Allocator, class Function>
+inline hipError_t run_with_allocator(Allocator& allocator, hipStream_t stream, Function&& function)
+{
+    size_t     storage_size = 0;
+    hipError_t result       = function(nullptr, storage_size);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+
+    void* temporary_storage = nullptr;
+    result                  = allocator.allocate(&temporary_storage, storage_size, stream);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+
+    result = function(temporary_storage, storage_size);
+
+    const hipError_t deallocate_result = allocator.deallocate(temporary_storage);
+    return result != hipSuccess ? result : deallocate_result;
+}
+
+/// @}
+// end of group devicemodule
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_CACHING_ALLOCATOR_HPP_
@@ -25,6 +25,7 @@
 #include <atomic>
 #include <limits>
 #include <type_traits>
+#include <utility>
 
 #include <cassert>
 
@@ -39,7 +40,8 @@ BEGIN_ROCPRIM_NAMESPACE
 
 /// \brief Special type used to show that the given device-level operation
 /// will be executed with optimal configuration dependent on types of the function's parameters
-/// and the target device architecture specified by ROCPRIM_TARGET_ARCH.
+/// and the architecture of the device, which is queried at runtime from the stream
+/// the operation is launched on.
 struct default_config { };
 
 /// \brief Configuration of particular kernels launched by device-level operation
@@ -103,15 +105,23 @@ struct select_arch_case
 };
 
 template<unsigned int TargetArch, class Case, class... OtherCases>
-struct select_arch
+struct select_arch_impl
     : std::conditional<
         Case::arch == TargetArch,
-        extract_type<typename Case::type>,
-        select_arch<TargetArch, OtherCases...>
+        type_identity<extract_type<typename Case::type>>,
+        select_arch_impl<TargetArch, OtherCases...>
     >::type { };
 
 template<unsigned int TargetArch, class Universal>
-struct select_arch<TargetArch, Universal> : extract_type<Universal> { };
+struct select_arch_impl<TargetArch, Universal> : type_identity<extract_type<Universal>> { };
+
+template<unsigned int TargetArch, class... Cases>
+struct select_arch : select_arch_impl<TargetArch, Cases...>::type
+{
+    // The selected config itself, so architectures selecting the same config
+    // also share the kernels instantiated with it (see extract_type).
+    using type = typename select_arch_impl<TargetArch, Cases...>::type;
+};
 
 template<class Config, class Default>
 using default_or_custom_config =
@@ -238,6 +248,68 @@ constexpr auto device_params()
     return Config::template architecture_config<device_target_arch()>::params;
 }
 
+/// \brief The config type selected for \p Arch by a wrapped config, which provides
+/// <tt>architecture_config<Arch>::type</tt>.
+template<typename Config, target_arch Arch>
+using target_arch_config_t = typename Config::template architecture_config<Arch>::type;
+
+/// \brief The config type that the wrapped config \p Config selects for the architecture of the
+/// current device compilation, the counterpart of `device_params` for config types.
+///
+/// Kernels templated on the wrapped config select their config with this, so they are
+/// instantiated once and every offload target only compiles the config that it runs.
+template<typename Config>
+using device_target_arch_config_t = target_arch_config_t<Config, device_target_arch()>;
+
+/// \brief The config type of a device-level operation: \p Config if it is a custom config,
+/// otherwise the tuned config \p Default selected for a single architecture.
+template<class Config, class Default>
+using arch_config_t = extract_type<default_or_custom_config<Config, Default>>;
+
+/// \brief The argument of the function called by `dispatch_target_arch_config`: a
+/// `type_identity` of the config type selected for \p Arch, which also names \p Arch, so
+/// nested operations can select their own configs for it without dispatching again.
+template<class Config, target_arch Arch>
+struct target_arch_config_identity : type_identity<target_arch_config_t<Config, Arch>>
+{
+    static constexpr target_arch arch = Arch;
+};
+
+/**
+ * \brief Calls `function` with a `target_arch_config_identity` of the config type that the
+ * wrapped config `Config` selects for `target_arch`.
+ *
+ * This is the counterpart of `dispatch_target_arch` for algorithms, whose host code needs
+ * config types instead of `params`. Every architecture instantiates `function`, so it must
+ * return the same type for all of them. Only the host code should depend on the selected config:
+ * the kernels it launches are templated on `Config` itself and select their config with
+ * `device_target_arch_config_t`, so they are not instantiated once per architecture.
+ */
+template<class Config, class Function>
+auto dispatch_target_arch_config(const target_arch target_arch, Function&& function)
+{
+    switch(target_arch)
+    {
+        case target_arch::unknown:
+            return function(target_arch_config_identity<Config, target_arch::unknown>{});
+        case target_arch::gfx803:
+            return function(target_arch_config_identity<Config, target_arch::gfx803>{});
+        case target_arch::gfx900:
+            return function(target_arch_config_identity<Config, target_arch::gfx900>{});
+        case target_arch::gfx906:
+            return function(target_arch_config_identity<Config, target_arch::gfx906>{});
+        case target_arch::gfx908:
+            return function(target_arch_config_identity<Config, target_arch::gfx908>{});
+        case target_arch::gfx90a:
+            return function(target_arch_config_identity<Config, target_arch::gfx90a>{});
+        case target_arch::gfx1030:
+            return function(target_arch_config_identity<Config, target_arch::gfx1030>{});
+        case target_arch::invalid:
+            assert(false && "Invalid target architecture selected at runtime.");
+    }
+    return function(target_arch_config_identity<Config, target_arch::unknown>{});
+}
+
 inline target_arch parse_gcn_arch(const char* arch_name)
 {
     static constexpr auto length = sizeof(hipDeviceProp_t::gcnArchName);
@@ -307,24 +379,57 @@ inline hipError_t get_device_from_stream(const hipStream_t stream, int& device_i
 }
 #endif
 
+// Architecture which the last host_target_arch call of the thread selected the configs for,
+// reported by the kernel trace as the config of the kernels launched afterwards
+inline target_arch& get_thread_selected_target_arch()
+{
+    thread_local target_arch arch = target_arch::invalid;
+    return arch;
+}
+
 inline hipError_t host_target_arch(const hipStream_t stream, target_arch& arch)
 {
 #ifdef WIN32
     (void)stream;
     arch = target_arch::unknown;
+    get_thread_selected_target_arch() = arch;
     return hipSuccess;
 #else
     int              device_id;
-    const hipError_t result = get_device_from_stream(stream, device_id);
+    hipError_t result = get_device_from_stream(stream, device_id);
     if(result != hipSuccess)
     {
         return result;
     }
 
-    return get_device_arch(device_id, arch);
+    result = get_device_arch(device_id, arch);
+    if(result == hipSuccess)
+    {
+        get_thread_selected_target_arch() = arch;
+    }
+    return result;
 #endif
 }
 
+/**
+ * \brief Calls `function` with a `type_identity` of the config type that the wrapped config
+ * `Config` selects for the architecture of the device of `stream`.
+ *
+ * Device-level operations use this to pick their tuned config at runtime, so a binary compiled
+ * for several architectures launches the kernels tuned for the device it runs on.
+ */
+template<class Config, class Function>
+hipError_t dispatch_target_arch_config(const hipStream_t stream, Function&& function)
+{
+    target_arch      arch;
+    const hipError_t result = host_target_arch(stream, arch);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    return dispatch_target_arch_config<Config>(arch, std::forward<Function>(function));
+}
+
 } // end namespace detail
 
 END_ROCPRIM_NAMESPACE
@@ -0,0 +1,396 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_BATCH_MEMCPY_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_BATCH_MEMCPY_HPP_
+
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#include "../../config.hpp"
+#include "../../detail/various.hpp"
+#include "../../intrinsics.hpp"
+#include "../../functional.hpp"
+#include "../../types.hpp"
+
+#include "../../block/block_scan.hpp"
+
+#include "device_binary_search.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Every buffer is classified by its size in bytes. Small buffers are copied by the thread that
+// classified them, medium buffers are queued in shared memory and copied by logical warps
+// of the same block, and large buffers are queued in global memory. A single block computes
+// offsets of the tiles of the queued large buffers, then all blocks of a third kernel copy
+// the tiles, so no kernel needs the number of large buffers on the host.
+
+// Copies the bytes [0, size) by `lanes` threads. Vector words are used for the part of the buffer
+// in which both source and destination are aligned to the word size.
+template<class Word>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void batch_memcpy_words(const unsigned char* source,
+                        unsigned char*       destination,
+                        const size_t         size,
+                        const unsigned int   lane,
+                        const unsigned int   lanes)
+{
+    const size_t misalignment = reinterpret_cast<uintptr_t>(destination) % sizeof(Word);
+    const size_t head_size
+        = ::rocprim::min(size, misalignment == 0 ? size_t(0) : sizeof(Word) - misalignment);
+    const size_t words = (size - head_size) / sizeof(Word);
+
+    for(size_t i = lane; i < head_size; i += lanes)
+    {
+        destination[i] = source[i];
+    }
+
+    const Word* source_words      = reinterpret_cast<const Word*>(source + head_size);
+    Word*       destination_words = reinterpret_cast<Word*>(destination + head_size);
+    for(size_t i = lane; i < words; i += lanes)
+    {
+        destination_words[i] = source_words[i];
+    }
+
+    for(size_t i = head_size + words * sizeof(Word) + lane; i < size; i += lanes)
+    {
+        destination[i] = source[i];
+    }
+}
+
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void batch_memcpy_bytes(const unsigned char* source,
+                        unsigned char*       destination,
+                        const size_t         size,
+                        const unsigned int   lane,
+                        const unsigned int   lanes)
+{
+    using vector_type = typename match_vector_type<unsigned int, 4>::type;
+
+    // Words can only be used if the source and the destination are equally misaligned
+    const uintptr_t relative_alignment
+        = reinterpret_cast<uintptr_t>(source) ^ reinterpret_cast<uintptr_t>(destination);
+    if(relative_alignment % sizeof(vector_type) == 0)
+    {
+        batch_memcpy_words<vector_type>(source, destination, size, lane, lanes);
+    }
+    else if(relative_alignment % sizeof(unsigned int) == 0)
+    {
+        batch_memcpy_words<unsigned int>(source, destination, size, lane, lanes);
+    }
+    else
+    {
+        batch_memcpy_words<unsigned char>(source, destination, size, lane, lanes);
+    }
+}
+
+// Element access of the buffers: bytes of untyped pointers for batch_memcpy and
+// elements of iterators for batch_copy.
+template<bool IsMemCpy>
+struct batch_copy_ops;
+
+template<>
+struct batch_copy_ops<true>
+{
+    // Number of bytes copied by a thread in every tile of a large buffer
+    template<class Source>
+    static constexpr unsigned int items_per_thread()
+    {
+        return 16;
+    }
+
+    template<class Source, class Size>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    static size_t size_in_bytes(Source, const Size size)
+    {
+        return static_cast<size_t>(size);
+    }
+
+    template<class Source, class Destination>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    static void copy(Source             source,
+                     Destination        destination,
+                     const size_t       begin,
+                     const size_t       end,
+                     const unsigned int lane,
+                     const unsigned int lanes)
+    {
+        batch_memcpy_bytes(reinterpret_cast<const unsigned char*>(source) + begin,
+                           reinterpret_cast<unsigned char*>(destination) + begin,
+                           end - begin,
+                           lane,
+                           lanes);
+    }
+};
+
+template<>
+struct batch_copy_ops<false>
+{
+    template<class Source>
+    static constexpr unsigned int items_per_thread()
+    {
+        using value_type = typename std::iterator_traits<Source>::value_type;
+        return ::rocprim::max(1u, 16u / static_cast<unsigned int>(sizeof(value_type)));
+    }
+
+    template<class Source, class Size>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    static size_t size_in_bytes(Source, const Size size)
+    {
+        using value_type = typename std::iterator_traits<Source>::value_type;
+        return static_cast<size_t>(size) * sizeof(value_type);
+    }
+
+    template<class Source, class Destination>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    static void copy(Source             source,
+                     Destination        destination,
+                     const size_t       begin,
+                     const size_t       end,
+                     const unsigned int lane,
+                     const unsigned int lanes)
+    {
+        for(size_t i = begin + lane; i < end; i += lanes)
+        {
+            destination[i] = source[i];
+        }
+    }
+};
+
+template<class Config,
+         bool IsMemCpy,
+         class InputBufferIterator,
+         class OutputBufferIterator,
+         class BufferSizeIterator>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void batch_copy_small_and_medium(InputBufferIterator  sources,
+                                 OutputBufferIterator destinations,
+                                 BufferSizeIterator   sizes,
+                                 const unsigned int   num_copies,
+                                 unsigned int*        large_buffer_indices,
+                                 unsigned int*        large_buffer_count)
+{
+    constexpr unsigned int block_size        = Config::block_size;
+    constexpr unsigned int logical_warp_size = Config::logical_warp_size;
+    constexpr unsigned int warps_per_block   = block_size / logical_warp_size;
+
+    static_assert(block_size % logical_warp_size == 0,
+                  "LogicalWarpSize must divide BlockSize");
+    static_assert(block_size < (1u << 16), "BlockSize must be less than 65536");
+
+    using ops       = batch_copy_ops<IsMemCpy>;
+    using scan_type = ::rocprim::block_scan<unsigned int, block_size>;
+
+    ROCPRIM_SHARED_MEMORY struct
+    {
+        typename scan_type::storage_type scan;
+        unsigned int                     medium_buffer_indices[block_size];
+        unsigned int                     large_buffer_offset;
+    } storage;
+
+    const unsigned int flat_id   = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int buffer_id = ::rocprim::detail::block_id<0>() * block_size + flat_id;
+
+    bool is_medium = false;
+    bool is_large  = false;
+    if(buffer_id < num_copies)
+    {
+        const auto   source        = sources[buffer_id];
+        const auto   size          = sizes[buffer_id];
+        const size_t size_in_bytes = ops::size_in_bytes(source, size);
+        if(size_in_bytes <= Config::small_buffer_size_threshold)
+        {
+            ops::copy(source, destinations[buffer_id], 0, static_cast<size_t>(size), 0, 1);
+        }
+        else
+        {
+            is_medium = size_in_bytes <= Config::medium_buffer_size_threshold;
+            is_large  = !is_medium;
+        }
+    }
+
+    // Medium buffers are counted in the low and large buffers in the high 16 bits,
+    // so a single scan finds the queue positions of both
+    const unsigned int flags = (is_medium ? 1u : 0u) | (is_large ? 1u << 16 : 0u);
+    unsigned int       positions;
+    unsigned int       counts;
+    scan_type().exclusive_scan(flags,
+                               positions,
+                               0u,
+                               counts,
+                               storage.scan,
+                               ::rocprim::plus<unsigned int>());
+    const unsigned int medium_count = counts & 0xFFFFu;
+    const unsigned int large_count  = counts >> 16;
+
+    if(flat_id == 0 && large_count > 0)
+    {
+        storage.large_buffer_offset
+            = ::rocprim::detail::atomic_add(large_buffer_count, large_count);
+    }
+    if(is_medium)
+    {
+        storage.medium_buffer_indices[positions & 0xFFFFu] = buffer_id;
+    }
+    ::rocprim::syncthreads();
+
+    if(is_large)
+    {
+        large_buffer_indices[storage.large_buffer_offset + (positions >> 16)] = buffer_id;
+    }
+
+    const unsigned int warp_id = flat_id / logical_warp_size;
+    const unsigned int lane    = flat_id % logical_warp_size;
+    for(unsigned int i = warp_id; i < medium_count; i += warps_per_block)
+    {
+        const unsigned int medium_buffer_id = storage.medium_buffer_indices[i];
+        ops::copy(sources[medium_buffer_id],
+                  destinations[medium_buffer_id],
+                  0,
+                  static_cast<size_t>(sizes[medium_buffer_id]),
+                  lane,
+                  logical_warp_size);
+    }
+}
+
+// Number of items (bytes for batch_memcpy, elements for batch_copy) in a tile of a large buffer
+template<class Config, bool IsMemCpy, class InputBufferIterator>
+constexpr size_t batch_copy_large_tile_size()
+{
+    using source_type = typename std::iterator_traits<InputBufferIterator>::value_type;
+    return Config::block_size
+           * batch_copy_ops<IsMemCpy>::template items_per_thread<source_type>();
+}
+
+// Computes the inclusive prefix sum of the numbers of tiles of the queued large buffers,
+// processing block_size buffers per iteration. Launched as a single block.
+template<class Config, bool IsMemCpy, class InputBufferIterator, class BufferSizeIterator>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void batch_copy_large_tile_offsets(BufferSizeIterator        sizes,
+                                   const unsigned int* const large_buffer_indices,
+                                   const unsigned int* const large_buffer_count,
+                                   size_t*                   large_buffer_tile_offsets)
+{
+    constexpr unsigned int block_size = Config::block_size;
+    constexpr size_t       tile_size
+        = batch_copy_large_tile_size<Config, IsMemCpy, InputBufferIterator>();
+
+    using scan_type = ::rocprim::block_scan<size_t, block_size>;
+
+    ROCPRIM_SHARED_MEMORY typename scan_type::storage_type storage;
+
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int count   = *large_buffer_count;
+
+    size_t previous_tiles = 0;
+    for(unsigned int offset = 0; offset < count; offset += block_size)
+    {
+        const unsigned int i     = offset + flat_id;
+        size_t             tiles = 0;
+        if(i < count)
+        {
+            tiles = ceiling_div(static_cast<size_t>(sizes[large_buffer_indices[i]]), tile_size);
+        }
+
+        size_t tiles_end;
+        size_t reduction;
+        scan_type().inclusive_scan(tiles,
+                                   tiles_end,
+                                   reduction,
+                                   storage,
+                                   ::rocprim::plus<size_t>());
+        if(i < count)
+        {
+            large_buffer_tile_offsets[i] = previous_tiles + tiles_end;
+        }
+        previous_tiles += reduction;
+        ::rocprim::syncthreads();
+    }
+}
+
+// Tiles of all large buffers are numbered consecutively and distributed round-robin over all
+// blocks, so buffers of only a few tiles do not all go to the first blocks. The buffer of a tile
+// is found by binary search in the tile offsets; tiles of a block are increasing, so the search
+// starts from the buffer of the previous tile and is skipped while it contains the tile.
+template<class Config,
+         bool IsMemCpy,
+         class InputBufferIterator,
+         class OutputBufferIterator,
+         class BufferSizeIterator>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void batch_copy_large(InputBufferIterator       sources,
+                      OutputBufferIterator      destinations,
+                      BufferSizeIterator        sizes,
+                      const unsigned int* const large_buffer_indices,
+                      const unsigned int* const large_buffer_count,
+                      const size_t* const       large_buffer_tile_offsets)
+{
+    constexpr unsigned int block_size = Config::block_size;
+    constexpr size_t       tile_size
+        = batch_copy_large_tile_size<Config, IsMemCpy, InputBufferIterator>();
+
+    using ops = batch_copy_ops<IsMemCpy>;
+
+    const unsigned int flat_id   = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int block_id  = ::rocprim::detail::block_id<0>();
+    const unsigned int grid_size = ::rocprim::detail::grid_size<0>();
+    const unsigned int count     = *large_buffer_count;
+    if(count == 0)
+    {
+        return;
+    }
+    const size_t total_tiles = large_buffer_tile_offsets[count - 1];
+
+    unsigned int i            = 0;
+    size_t       buffer_begin = 0;
+    size_t       buffer_end   = 0;
+    for(size_t tile = block_id; tile < total_tiles; tile += grid_size)
+    {
+        if(tile >= buffer_end)
+        {
+            i += upper_bound_n(large_buffer_tile_offsets + i,
+                               count - i,
+                               tile,
+                               ::rocprim::less<size_t>());
+            buffer_begin = i == 0 ? 0 : large_buffer_tile_offsets[i - 1];
+            buffer_end   = large_buffer_tile_offsets[i];
+        }
+
+        const unsigned int buffer_id  = large_buffer_indices[i];
+        const size_t       size       = static_cast<size_t>(sizes[buffer_id]);
+        const size_t       local_tile = tile - buffer_begin;
+        ops::copy(sources[buffer_id],
+                  destinations[buffer_id],
+                  local_tile * tile_size,
+                  ::rocprim::min(size, (local_tile + 1) * tile_size),
+                  flat_id,
+                  block_size);
+    }
+}
+
+} // end namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_BATCH_MEMCPY_HPP_
@@ -21,6 +21,15 @@
 #ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_BINARY_SEARCH_HPP_
 #define ROCPRIM_DEVICE_DETAIL_DEVICE_BINARY_SEARCH_HPP_
 
+#include <iterator>
+
+#include "../../config.hpp"
+#include "../../detail/various.hpp"
+
+#include "../../intrinsics.hpp"
+
+#include "../../detail/merge_path.hpp"
+
 BEGIN_ROCPRIM_NAMESPACE
 
 namespace detail
@@ -82,28 +91,111 @@ Size upper_bound_n(RandomAccessIterator first,
     return left;
 }
 
+// Adapts compare_op for merging sorted needles into the haystack with merge_path. A needle
+// is placed before a haystack value if it compares true, so the number of haystack values
+// preceding a needle in the merged sequence is its lower bound.
+template<class CompareOp>
+struct lower_bound_merge_compare
+{
+    CompareOp compare_op;
+
+    template<class T, class U>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    bool operator()(const T& needle, const U& value) const
+    {
+        return !compare_op(value, needle);
+    }
+};
+
+// Same as lower_bound_merge_compare, but equal haystack values precede the needle, which
+// yields the upper bound.
+template<class CompareOp>
+struct upper_bound_merge_compare
+{
+    CompareOp compare_op;
+
+    template<class T, class U>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    bool operator()(const T& needle, const U& value) const
+    {
+        return compare_op(needle, value);
+    }
+};
+
 struct lower_bound_search_op
 {
+    using sorted_result_type = size_t;
+
     template<class HaystackIterator, class CompareOp, class Size, class T>
     ROCPRIM_DEVICE ROCPRIM_INLINE
     Size operator()(HaystackIterator haystack, Size size, const T& value, CompareOp compare_op) const
     {
         return lower_bound_n(haystack, size, value, compare_op);
     }
+
+    template<class CompareOp>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    lower_bound_merge_compare<CompareOp> merge_compare(CompareOp compare_op) const
+    {
+        return lower_bound_merge_compare<CompareOp>{compare_op};
+    }
+
+    // index is the lower bound of value, haystack_value points to haystack[index] (only
+    // valid if index < size)
+    template<class T, class U, class CompareOp>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    size_t sorted_result(size_t index,
+                         size_t size,
+                         const T& value,
+                         const U* haystack_value,
+                         CompareOp compare_op) const
+    {
+        (void) size;
+        (void) value;
+        (void) haystack_value;
+        (void) compare_op;
+        return index;
+    }
 };
 
 struct upper_bound_search_op
 {
+    using sorted_result_type = size_t;
+
     template<class HaystackIterator, class CompareOp, class Size, class T>
     ROCPRIM_DEVICE ROCPRIM_INLINE
     Size operator()(HaystackIterator haystack, Size size, const T& value, CompareOp compare_op) const
     {
         return upper_bound_n(haystack, size, value, compare_op);
     }
+
+    template<class CompareOp>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    upper_bound_merge_compare<CompareOp> merge_compare(CompareOp compare_op) const
+    {
+        return upper_bound_merge_compare<CompareOp>{compare_op};
+    }
+
+    template<class T, class U, class CompareOp>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    size_t sorted_result(size_t index,
+                         size_t size,
+                         const T& value,
+                         const U* haystack_value,
+                         CompareOp compare_op) const
+    {
+        (void) size;
+        (void) value;
+        (void) haystack_value;
+        (void) compare_op;
+        return index;
+    }
 };
 
 struct binary_search_op
 {
+    using sorted_result_type = bool;
+
     template<class HaystackIterator, class CompareOp, class Size, class T>
     ROCPRIM_DEVICE ROCPRIM_INLINE
     bool operator()(HaystackIterator haystack, Size size, const T& value, CompareOp compare_op) const
@@ -111,8 +203,192 @@ struct binary_search_op
         const Size n = lower_bound_n(haystack, size, value, compare_op);
         return n != size && !compare_op(value, haystack[n]);
     }
+
+    template<class CompareOp>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    lower_bound_merge_compare<CompareOp> merge_compare(CompareOp compare_op) const
+    {
+        return lower_bound_merge_compare<CompareOp>{compare_op};
+    }
+
+    template<class T, class U, class CompareOp>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    bool sorted_result(size_t index,
+                       size_t size,
+                       const T& value,
+                       const U* haystack_value,
+                       CompareOp compare_op) const
+    {
+        return index != size && !compare_op(value, *haystack_value);
+    }
 };
 
+// Computes, for every tile of the merged sequence of haystack and needles, the number of
+// haystack values preceding the tile.
+template<
+    class HaystackIterator,
+    class NeedlesIterator,
+    class SearchOp,
+    class CompareOp
+>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void sorted_search_partition_kernel_impl(size_t * indices,
+                                         HaystackIterator haystack,
+                                         NeedlesIterator needles,
+                                         const size_t haystack_size,
+                                         const size_t needles_size,
+                                         const size_t partitions,
+                                         const unsigned int spacing,
+                                         SearchOp search_op,
+                                         CompareOp compare_op)
+{
+    const size_t id = ::rocprim::detail::block_id<0>() * ::rocprim::detail::block_size<0>()
+        + ::rocprim::detail::block_thread_id<0>();
+    if(id > partitions)
+    {
+        return;
+    }
+
+    const size_t diag = ::rocprim::min(id * spacing, haystack_size + needles_size);
+    indices[id] = merge_path(
+        haystack, needles, haystack_size, needles_size, diag,
+        search_op.merge_compare(compare_op)
+    );
+}
+
+// Each block merges a tile of the haystack with a tile of needles in shared memory. Every
+// needle is resolved by the number of haystack values preceding it in the merged sequence,
+// so all global memory accesses are coalesced.
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    class HaystackIterator,
+    class NeedlesIterator,
+    class OutputIterator,
+    class SearchOp,
+    class CompareOp
+>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE
+void sorted_search_kernel_impl(const size_t * indices,
+                               HaystackIterator haystack,
+                               NeedlesIterator needles,
+                               OutputIterator output,
+                               const size_t haystack_size,
+                               const size_t needles_size,
+                               SearchOp search_op,
+                               CompareOp compare_op)
+{
+    using haystack_type = typename std::iterator_traits<HaystackIterator>::value_type;
+    using needle_type = typename std::iterator_traits<NeedlesIterator>::value_type;
+    using result_type = typename SearchOp::sorted_result_type;
+
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+
+    ROCPRIM_SHARED_MEMORY union
+    {
+        struct
+        {
+            // One more haystack value than the tile contains, so the value at the lower bound
+            // of the last needles is available too
+            typename detail::raw_storage<haystack_type[items_per_block + 1]> haystack;
+            typename detail::raw_storage<needle_type[items_per_block]> needles;
+        } inputs;
+        typename detail::raw_storage<result_type[items_per_block]> results;
+    } storage;
+
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int flat_block_id = ::rocprim::detail::block_id<0>();
+
+    const size_t diag_begin = static_cast<size_t>(flat_block_id) * items_per_block;
+    const size_t diag_end = ::rocprim::min(diag_begin + items_per_block, haystack_size + needles_size);
+    const size_t haystack_begin = indices[flat_block_id];
+    const size_t haystack_end = indices[flat_block_id + 1];
+    const size_t needles_begin = diag_begin - haystack_begin;
+
+    const unsigned int haystack_count = haystack_end - haystack_begin;
+    const unsigned int needles_count = (diag_end - haystack_end) - needles_begin;
+    const unsigned int count = haystack_count + needles_count;
+
+    haystack_type * haystack_shared = storage.inputs.haystack.get();
+    needle_type * needles_shared = storage.inputs.needles.get();
+
+    ROCPRIM_UNROLL
+    for(unsigned int i = 0; i < ItemsPerThread; ++i)
+    {
+        const unsigned int index = BlockSize * i + flat_id;
+        if(index < haystack_count)
+        {
+            haystack_shared[index] = haystack[haystack_begin + index];
+        }
+        if(index < needles_count)
+        {
+            needles_shared[index] = needles[needles_begin + index];
+        }
+    }
+    if(flat_id == 0 && haystack_end < haystack_size)
+    {
+        haystack_shared[haystack_count] = haystack[haystack_end];
+    }
+    ::rocprim::syncthreads();
+
+    const auto merge_compare = search_op.merge_compare(compare_op);
+
+    const unsigned int diag = ::rocprim::min(flat_id * ItemsPerThread, count);
+    unsigned int h = merge_path(
+        haystack_shared, needles_shared, haystack_count, needles_count, diag, merge_compare
+    );
+    unsigned int n = diag - h;
+
+    result_type results[ItemsPerThread];
+    unsigned int result_indices[ItemsPerThread];
+
+    ROCPRIM_UNROLL
+    for(unsigned int i = 0; i < ItemsPerThread; ++i)
+    {
+        result_indices[i] = items_per_block;
+        if(diag + i < count)
+        {
+            const bool take_needle = n < needles_count
+                && (h >= haystack_count || merge_compare(needles_shared[n], haystack_shared[h]));
+            if(take_needle)
+            {
+                results[i] = search_op.sorted_result(
+                    haystack_begin + h, haystack_size,
+                    needles_shared[n], haystack_shared + h,
+                    compare_op
+                );
+                result_indices[i] = n++;
+            }
+            else
+            {
+                ++h;
+            }
+        }
+    }
+    ::rocprim::syncthreads();
+
+    result_type * results_shared = storage.results.get();
+    ROCPRIM_UNROLL
+    for(unsigned int i = 0; i < ItemsPerThread; ++i)
+    {
+        if(result_indices[i] < items_per_block)
+        {
+            results_shared[result_indices[i]] = results[i];
+        }
+    }
+    ::rocprim::syncthreads();
+
+    ROCPRIM_UNROLL
+    for(unsigned int i = 0; i < ItemsPerThread; ++i)
+    {
+        const unsigned int index = BlockSize * i + flat_id;
+        if(index < needles_count)
+        {
+            output[needles_begin + index] = results_shared[index];
+        }
+    }
+}
+
 } // end of detail namespace
 
 END_ROCPRIM_NAMESPACE
@@ -47,7 +47,8 @@ template<unsigned int SortBlockSize,
          unsigned int MergeImplMPPartitionBlockSize,
          unsigned int MergeImplMPBlockSize,
          unsigned int MergeImplMPItemsPerThread,
-         unsigned int MinInputSizeMergepath>
+         unsigned int MinInputSizeMergepath,
+         unsigned int IndirectValueBytes>
 struct merge_sort_config_impl
 {
     using sort_config                      = kernel_config<SortBlockSize, SortItemsPerThread>;
@@ -55,6 +56,7 @@ struct merge_sort_config_impl
     using merge_mergepath_partition_config = kernel_config<MergeImplMPPartitionBlockSize, 1>;
     using merge_mergepath_config = kernel_config<MergeImplMPBlockSize, MergeImplMPItemsPerThread>;
     static constexpr unsigned int min_input_size_mergepath = MinInputSizeMergepath;
+    static constexpr unsigned int indirect_value_bytes     = IndirectValueBytes;
 };
 
 } // namespace detail
@@ -68,6 +70,8 @@ struct merge_sort_config_impl
 /// \tparam MergeImplMPBlockSize - block size in the block merge step using mergepath impl
 /// \tparam MergeImplMPItemsPerThread - ItemsPerThread in the block merge step using mergepath impl
 /// \tparam MinInputSizeMergepath - breakpoint of input-size to use mergepath impl for block merge step
+/// \tparam IndirectValueBytes - values larger than this (in bytes) are not moved by the merge steps:
+/// keys are sorted together with 32-bit indices and the values are gathered once at the end.
 template<unsigned int     MergeImpl1BlockSize           = 512,
          unsigned int     SortBlockSize                 = MergeImpl1BlockSize,
          unsigned int     SortItemsPerThread            = 1,
@@ -75,14 +79,16 @@ template<unsigned int     MergeImpl1BlockSize           = 512,
          unsigned int     MergeImplMPBlockSize          = std::min(SortBlockSize, 128u),
          unsigned int     MergeImplMPItemsPerThread
          = SortBlockSize* SortItemsPerThread / MergeImplMPBlockSize,
-         unsigned int     MinInputSizeMergepath = 200000>
+         unsigned int     MinInputSizeMergepath = 200000,
+         unsigned int     IndirectValueBytes    = 32>
 using merge_sort_config = detail::merge_sort_config_impl<SortBlockSize,
                                                          SortItemsPerThread,
                                                          MergeImpl1BlockSize,
                                                          MergeImplMPPartitionBlockSize,
                                                          MergeImplMPBlockSize,
                                                          MergeImplMPItemsPerThread,
-                                                         MinInputSizeMergepath>;
+                                                         MinInputSizeMergepath,
+                                                         IndirectValueBytes>;
 
 namespace detail
 {
@@ -135,8 +141,16 @@ struct default_merge_sort_config_base : default_merge_sort_config_base_helper<Ke
 ///
 /// \tparam LongRadixBits - number of bits in long iterations.
 /// \tparam ShortRadixBits - number of bits in short iterations, must be equal to or less than \p LongRadixBits.
-/// \tparam ScanConfig - configuration of digits scan kernel. Must be \p kernel_config.
+/// \tparam ScanConfig - configuration of the kernel counting digits of all iterations. Must be \p kernel_config.
 /// \tparam SortConfig - configuration of radix sort kernel. Must be \p kernel_config.
+/// Its size limit bounds the number of items whose digit offsets are resolved by a single look-back.
+/// \tparam SortSingleConfig - configuration of radix sort single kernel. Must be \p kernel_config.
+/// \tparam SortMergeConfig - configuration of radix sort merge kernel. Must be \p kernel_config.
+/// \tparam MergeSizeLimitBlocks - limit number of blocks to use merge kernel.
+/// \tparam ForceSingleKernelConfig - force use radix sort single kernel configuration.
+/// \tparam IndirectValueBytes - when sorting inputs that do not fit into a single block, values
+/// larger than this (in bytes) are not moved by the sorting passes: keys are sorted together with
+/// 32-bit indices and the values are gathered once at the end.
 template<unsigned int LongRadixBits,
          unsigned int ShortRadixBits,
          class ScanConfig,
@@ -144,7 +158,8 @@ template<unsigned int LongRadixBits,
          class SortSingleConfig               = kernel_config<256, 10>,
          class SortMergeConfig                = kernel_config<1024, 1>,
          unsigned int MergeSizeLimitBlocks    = 1024U,
-         bool         ForceSingleKernelConfig = false>
+         bool         ForceSingleKernelConfig = false,
+         unsigned int IndirectValueBytes      = 32>
 struct radix_sort_config
 {
     /// \brief Number of bits in long iterations.
@@ -154,7 +169,7 @@ struct radix_sort_config
     /// \brief Limit number of blocks to use merge kernel.
     static constexpr unsigned int merge_size_limit_blocks = MergeSizeLimitBlocks;
 
-    /// \brief Configuration of digits scan kernel.
+    /// \brief Configuration of digits counting kernel.
     using scan = ScanConfig;
     /// \brief Configuration of radix sort kernel.
     using sort = SortConfig;
@@ -164,6 +179,8 @@ struct radix_sort_config
     using sort_merge = SortMergeConfig;
     /// \brief Force use radix sort single kernel configuration.
     static constexpr bool force_single_kernel_config = ForceSingleKernelConfig;
+    /// \brief Values larger than this (in bytes) are sorted indirectly through 32-bit indices.
+    static constexpr unsigned int indirect_value_bytes = IndirectValueBytes;
 };
 
 namespace detail
@@ -288,7 +305,8 @@ struct default_reduce_config_base : default_reduce_config_base_helper<Value>::ty
 /// \tparam BlockLoadMethod - method for loading input values.
 /// \tparam StoreLoadMethod - method for storing values.
 /// \tparam BlockScanMethod - algorithm for block scan.
-/// \tparam SizeLimit - limit on the number of items for a single scan kernel launch.
+/// \tparam SizeLimit - limit on the number of items covered at once by the blocks of a scan
+/// kernel launch. Larger inputs are still scanned by a single look-back scan launch.
 template<unsigned int                    BlockSize,
          unsigned int                    ItemsPerThread,
          bool                            UseLookback,
@@ -310,7 +328,7 @@ struct scan_config
     static constexpr ::rocprim::block_store_method block_store_method = BlockStoreMethod;
     /// \brief Algorithm for block scan.
     static constexpr ::rocprim::block_scan_algorithm block_scan_method = BlockScanMethod;
-    /// \brief Limit on the number of items for a single scan kernel launch.
+    /// \brief Limit on the number of items covered at once by the blocks of a scan kernel launch.
     static constexpr unsigned int size_limit = SizeLimit;
 };
 
@@ -345,7 +363,8 @@ struct default_scan_config_base : default_scan_config_base_helper<Value>::type
 /// \tparam BlockLoadMethod - method for loading input values.
 /// \tparam StoreLoadMethod - method for storing values.
 /// \tparam BlockScanMethod - algorithm for block scan.
-/// \tparam SizeLimit - limit on the number of items for a single scan kernel launch.
+/// \tparam SizeLimit - limit on the number of items covered at once by the blocks of a scan
+/// kernel launch. Larger inputs are still scanned by a single launch.
 template<unsigned int                    BlockSize,
          unsigned int                    ItemsPerThread,
          bool                            UseLookback,
@@ -367,7 +386,7 @@ struct scan_by_key_config
     static constexpr ::rocprim::block_store_method block_store_method = BlockStoreMethod;
     /// \brief Algorithm for block scan.
     static constexpr ::rocprim::block_scan_algorithm block_scan_method = BlockScanMethod;
-    /// \brief Limit on the number of items for a single scan kernel launch.
+    /// \brief Limit on the number of items covered at once by the blocks of a scan kernel launch.
     static constexpr unsigned int size_limit = SizeLimit;
 };
 
@@ -0,0 +1,183 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_FIND_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_FIND_HPP_
+
+#include <iterator>
+#include <type_traits>
+
+#include "../../config.hpp"
+#include "../../detail/various.hpp"
+
+#include "../../functional.hpp"
+#include "../../intrinsics.hpp"
+#include "../../types.hpp"
+
+#include "../../block/block_reduce.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+template<class InputIterator, class UnaryPredicate>
+struct find_if_flag_op
+{
+    InputIterator  input;
+    UnaryPredicate predicate;
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    bool operator()(const size_t index) const
+    {
+        return predicate(input[index]);
+    }
+};
+
+template<class InputIterator, class KeysIterator, class BinaryPredicate>
+struct find_first_of_flag_op
+{
+    InputIterator   input;
+    KeysIterator    keys;
+    size_t          keys_size;
+    BinaryPredicate compare_function;
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    bool operator()(const size_t index) const
+    {
+        const auto value = input[index];
+        for(size_t k = 0; k < keys_size; k++)
+        {
+            if(compare_function(value, keys[k]))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+template<class InputIterator, class BinaryPredicate>
+struct adjacent_find_flag_op
+{
+    InputIterator   input;
+    BinaryPredicate compare_function;
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    bool operator()(const size_t index) const
+    {
+        return compare_function(input[index], input[index + 1]);
+    }
+};
+
+template<class InputIterator1, class InputIterator2, class BinaryPredicate>
+struct mismatch_flag_op
+{
+    InputIterator1  input1;
+    InputIterator2  input2;
+    BinaryPredicate compare_function;
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    bool operator()(const size_t index) const
+    {
+        return !compare_function(input1[index], input2[index]);
+    }
+};
+
+template<class Result>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void find_first_init_kernel_impl(Result* result, const size_t not_found)
+{
+    if(::rocprim::detail::block_thread_id<0>() == 0)
+    {
+        *result = not_found;
+    }
+}
+
+// Blocks take tiles in ascending order with a grid-stride loop and publish the smallest index
+// found so far with an atomic minimum. A block stops as soon as its next tile starts after
+// that index, so only the tiles before the first flagged item (and the ones in flight) are read.
+template<class Config, class FlagOp>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE
+void find_first_kernel_impl(FlagOp flag_op, const size_t size, unsigned long long* result)
+{
+    constexpr unsigned int block_size       = Config::block_size;
+    constexpr unsigned int items_per_thread = Config::items_per_thread;
+    constexpr unsigned int items_per_tile   = block_size * items_per_thread;
+
+    using block_reduce_type = ::rocprim::block_reduce<unsigned long long, block_size>;
+
+    ROCPRIM_SHARED_MEMORY struct
+    {
+        typename block_reduce_type::storage_type reduce;
+        unsigned long long                       best;
+    } storage;
+
+    const unsigned int flat_id    = ::rocprim::detail::block_thread_id<0>();
+    const size_t       grid_items = static_cast<size_t>(::rocprim::detail::grid_size<0>())
+                              * items_per_tile;
+
+    for(size_t tile_offset = ::rocprim::detail::block_id<0>() * size_t(items_per_tile);
+        tile_offset < size;
+        tile_offset += grid_items)
+    {
+        if(flat_id == 0)
+        {
+            // The result only decreases, so a stale value is safe to use here
+            storage.best = *static_cast<volatile unsigned long long*>(result);
+        }
+        ::rocprim::syncthreads();
+        if(storage.best <= tile_offset)
+        {
+            // All remaining tiles of the block are after the found item
+            break;
+        }
+
+        // Items are flagged in striped arrangement, so the reads are coalesced and the first
+        // flagged item of a thread is the one with the smallest index
+        unsigned long long found = size;
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < items_per_thread; i++)
+        {
+            const size_t index = tile_offset + i * block_size + flat_id;
+            if(found == size && index < size && flag_op(index))
+            {
+                found = index;
+            }
+        }
+
+        unsigned long long block_found;
+        block_reduce_type().reduce(found,
+                                   block_found,
+                                   storage.reduce,
+                                   ::rocprim::minimum<unsigned long long>());
+        if(flat_id == 0 && block_found < size)
+        {
+            ::rocprim::detail::atomic_min(result, block_found);
+        }
+        ::rocprim::syncthreads();
+    }
+}
+
+} // end of detail namespace
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_FIND_HPP_
@@ -33,6 +33,7 @@
 
 #include "../../block/block_load.hpp"
 
+#include "device_binary_search.hpp"
 #include "uint_fast_div.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
@@ -516,6 +517,317 @@ ROCPRIM_DEVICE ROCPRIM_INLINE void
     }
 }
 
+// Same as histogram_shared, but the block histogram only holds tile_bins bins (the tile selected
+// by blockIdx.z) of the concatenated bins of all active channels. Samples of other bins are
+// skipped, so large histograms are computed in shared memory by reading the samples once per tile.
+template<unsigned int BlockSize,
+         unsigned int ItemsPerThread,
+         unsigned int Channels,
+         unsigned int ActiveChannels,
+         class SampleIterator,
+         class Counter,
+         class SampleToBinOp>
+ROCPRIM_DEVICE ROCPRIM_INLINE void
+    histogram_tiled(SampleIterator                             samples,
+                    unsigned int                               columns,
+                    unsigned int                               rows,
+                    unsigned int                               row_stride,
+                    unsigned int                               rows_per_block,
+                    fixed_array<Counter*, ActiveChannels>      histogram,
+                    fixed_array<SampleToBinOp, ActiveChannels> sample_to_bin_op,
+                    fixed_array<unsigned int, ActiveChannels>  bins,
+                    unsigned int                               tile_bins,
+                    unsigned int*                              block_histogram)
+{
+    using sample_type        = typename std::iterator_traits<SampleIterator>::value_type;
+    using sample_vector_type = sample_vector<sample_type, Channels>;
+
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+
+    const unsigned int flat_id    = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int block_id0  = ::rocprim::detail::block_id<0>();
+    const unsigned int block_id1  = ::rocprim::detail::block_id<1>();
+    const unsigned int grid_size0 = ::rocprim::detail::grid_size<0>();
+
+    const unsigned int tile_begin = ::rocprim::detail::block_id<2>() * tile_bins;
+    const unsigned int tile_end   = tile_begin + tile_bins;
+
+    // offsets of the bins of each channel in the concatenated bins
+    unsigned int bin_offsets[ActiveChannels];
+    unsigned int total_bins = 0;
+    for(unsigned int channel = 0; channel < ActiveChannels; channel++)
+    {
+        bin_offsets[channel] = total_bins;
+        total_bins += bins[channel];
+    }
+
+    for(unsigned int i = flat_id; i < tile_bins; i += BlockSize)
+    {
+        block_histogram[i] = 0;
+    }
+    ::rocprim::syncthreads();
+
+    const unsigned int start_row = block_id1 * rows_per_block;
+    const unsigned int end_row   = ::rocprim::min(rows, start_row + rows_per_block);
+    for(unsigned int row = start_row; row < end_row; row++)
+    {
+        SampleIterator row_samples = samples + row * row_stride;
+
+        unsigned int block_offset = block_id0 * items_per_block;
+        while(block_offset < columns)
+        {
+            sample_vector_type values[ItemsPerThread];
+            unsigned int       valid_count;
+
+            if(block_offset + items_per_block <= columns)
+            {
+                valid_count = items_per_block;
+                load_samples<BlockSize>(flat_id, row_samples + Channels * block_offset, values);
+            }
+            else
+            {
+                valid_count = columns - block_offset;
+                load_samples<BlockSize>(flat_id,
+                                        row_samples + Channels * block_offset,
+                                        values,
+                                        valid_count);
+            }
+
+            for(unsigned int i = 0; i < ItemsPerThread; i++)
+            {
+                if(flat_id * ItemsPerThread + i < valid_count)
+                {
+                    for(unsigned int channel = 0; channel < ActiveChannels; channel++)
+                    {
+                        unsigned int bin;
+                        if(sample_to_bin_op[channel](values[i].values[channel], bin))
+                        {
+                            // bins before the tile wrap around to large values
+                            const unsigned int tile_bin = bin_offsets[channel] + bin - tile_begin;
+                            if(tile_bin < tile_bins)
+                            {
+                                ::rocprim::detail::atomic_add(block_histogram + tile_bin, 1);
+                            }
+                        }
+                    }
+                }
+            }
+
+            block_offset += grid_size0 * items_per_block;
+        }
+    }
+    ::rocprim::syncthreads();
+
+    for(unsigned int channel = 0; channel < ActiveChannels; channel++)
+    {
+        const unsigned int begin = ::rocprim::max(bin_offsets[channel], tile_begin);
+        const unsigned int end   = ::rocprim::min(bin_offsets[channel] + bins[channel], tile_end);
+        for(unsigned int i = begin + flat_id; i < end; i += BlockSize)
+        {
+            const unsigned int total = block_histogram[i - tile_begin];
+            if(total > 0)
+            {
+                ::rocprim::detail::atomic_add(&histogram[channel][i - bin_offsets[channel]],
+                                              total);
+            }
+        }
+    }
+}
+
+// Maps the index of a sample of a (possibly 2D) range of samples to the bin of the sample in
+// the given channel, or to bins if the sample does not belong to any bin.
+template<unsigned int Channels, class SampleIterator, class SampleToBinOp>
+struct histogram_sample_to_bin_key_op
+{
+    SampleIterator samples;
+    unsigned int   columns;
+    unsigned int   row_stride;
+    unsigned int   channel;
+    unsigned int   bins;
+    SampleToBinOp  sample_to_bin_op;
+
+    ROCPRIM_HOST_DEVICE inline unsigned int operator()(size_t index) const
+    {
+        const size_t row    = index / columns;
+        const size_t column = index - row * columns;
+
+        unsigned int bin;
+        if(sample_to_bin_op(samples[row * row_stride + column * Channels + channel], bin))
+        {
+            return bin;
+        }
+        return bins;
+    }
+};
+
+// Writes the length of every run of the sorted bins to the histogram. Only the first item of
+// a run does work: it finds the end of the run by an exponential search followed by a binary
+// search, so long runs (e.g. of skewed samples) are resolved in logarithmic time.
+template<unsigned int BlockSize, class Counter>
+ROCPRIM_DEVICE ROCPRIM_INLINE void histogram_sorted_runs(const unsigned int* sorted_bins,
+                                                         size_t              size,
+                                                         Counter*            histogram,
+                                                         unsigned int        bins)
+{
+    const unsigned int flat_id  = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int block_id = ::rocprim::detail::block_id<0>();
+
+    const size_t index = static_cast<size_t>(block_id) * BlockSize + flat_id;
+    if(index >= size)
+    {
+        return;
+    }
+
+    const unsigned int bin = sorted_bins[index];
+    if(bin >= bins || (index > 0 && sorted_bins[index - 1] == bin))
+    {
+        return;
+    }
+
+    // sorted_bins[last] == bin, the run ends at or before last + step
+    size_t last = index;
+    size_t step = 1;
+    while(last + step < size && sorted_bins[last + step] == bin)
+    {
+        last += step;
+        step *= 2;
+    }
+    const size_t search_size = ::rocprim::min(step, size - last) - 1;
+    const size_t run_end     = last + 1
+                           + upper_bound_n(sorted_bins + last + 1,
+                                           search_size,
+                                           bin,
+                                           ::rocprim::less<unsigned int>());
+
+    histogram[bin] = static_cast<Counter>(run_end - index);
+}
+
+// Weighted histogram of a single channel: adds the weight of every sample to its bin instead of
+// counting the sample. Like histogram_tiled, the block only privatizes the bins of the tile
+// selected by blockIdx.z, in SharedHistograms copies to reduce conflicts of atomic operations.
+template<unsigned int BlockSize,
+         unsigned int ItemsPerThread,
+         unsigned int SharedHistograms,
+         class SampleIterator,
+         class WeightIterator,
+         class Weight,
+         class SampleToBinOp>
+ROCPRIM_DEVICE ROCPRIM_INLINE void histogram_weighted_shared(SampleIterator samples,
+                                                             WeightIterator weights,
+                                                             unsigned int   size,
+                                                             Weight*        histogram,
+                                                             SampleToBinOp  sample_to_bin_op,
+                                                             unsigned int   bins,
+                                                             unsigned int   tile_bins,
+                                                             Weight*        block_histogram)
+{
+    using sample_type = typename std::iterator_traits<SampleIterator>::value_type;
+
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+
+    const unsigned int flat_id    = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int block_id0  = ::rocprim::detail::block_id<0>();
+    const unsigned int grid_size0 = ::rocprim::detail::grid_size<0>();
+
+    const unsigned int tile_begin = ::rocprim::detail::block_id<2>() * tile_bins;
+    const unsigned int tile_end   = ::rocprim::min(bins, tile_begin + tile_bins);
+
+    // partial histogram to work with
+    Weight* thread_histogram = block_histogram + (flat_id % SharedHistograms) * tile_bins;
+
+    for(unsigned int i = flat_id; i < tile_bins * SharedHistograms; i += BlockSize)
+    {
+        block_histogram[i] = Weight(0);
+    }
+    ::rocprim::syncthreads();
+
+    for(unsigned int block_offset = block_id0 * items_per_block; block_offset < size;
+        block_offset += grid_size0 * items_per_block)
+    {
+        const unsigned int valid_count = ::rocprim::min(size - block_offset, items_per_block);
+
+        sample_type sample_values[ItemsPerThread];
+        Weight      weight_values[ItemsPerThread];
+        block_load_direct_striped<BlockSize>(flat_id,
+                                             samples + block_offset,
+                                             sample_values,
+                                             valid_count);
+        block_load_direct_striped<BlockSize>(flat_id,
+                                             weights + block_offset,
+                                             weight_values,
+                                             valid_count);
+
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
+        {
+            unsigned int bin;
+            if(i * BlockSize + flat_id < valid_count && sample_to_bin_op(sample_values[i], bin))
+            {
+                // bins before the tile wrap around to large values
+                const unsigned int tile_bin = bin - tile_begin;
+                if(tile_bin < tile_bins)
+                {
+                    ::rocprim::detail::atomic_add(thread_histogram + tile_bin, weight_values[i]);
+                }
+            }
+        }
+    }
+    ::rocprim::syncthreads();
+
+    for(unsigned int bin = tile_begin + flat_id; bin < tile_end; bin += BlockSize)
+    {
+        Weight total = Weight(0);
+        for(unsigned int i = 0; i < SharedHistograms; i++)
+        {
+            total += block_histogram[bin - tile_begin + i * tile_bins];
+        }
+        if(total != Weight(0))
+        {
+            ::rocprim::detail::atomic_add(&histogram[bin], total);
+        }
+    }
+}
+
+template<unsigned int BlockSize,
+         unsigned int ItemsPerThread,
+         class SampleIterator,
+         class WeightIterator,
+         class Weight,
+         class SampleToBinOp>
+ROCPRIM_DEVICE ROCPRIM_INLINE void histogram_weighted_global(SampleIterator samples,
+                                                             WeightIterator weights,
+                                                             unsigned int   size,
+                                                             Weight*        histogram,
+                                                             SampleToBinOp  sample_to_bin_op)
+{
+    using sample_type = typename std::iterator_traits<SampleIterator>::value_type;
+
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+
+    const unsigned int flat_id      = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int block_offset = ::rocprim::detail::block_id<0>() * items_per_block;
+    const unsigned int valid_count  = ::rocprim::min(size - block_offset, items_per_block);
+
+    sample_type sample_values[ItemsPerThread];
+    Weight      weight_values[ItemsPerThread];
+    block_load_direct_striped<BlockSize>(flat_id,
+                                         samples + block_offset,
+                                         sample_values,
+                                         valid_count);
+    block_load_direct_striped<BlockSize>(flat_id,
+                                         weights + block_offset,
+                                         weight_values,
+                                         valid_count);
+
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        unsigned int bin;
+        if(i * BlockSize + flat_id < valid_count && sample_to_bin_op(sample_values[i], bin))
+        {
+            ::rocprim::detail::atomic_add(&histogram[bin], weight_values[i]);
+        }
+    }
+}
+
 } // namespace detail
 
 END_ROCPRIM_NAMESPACE
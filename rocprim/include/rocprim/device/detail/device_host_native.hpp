@@ -0,0 +1,810 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_HOST_NATIVE_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_HOST_NATIVE_HPP_
+
+#include "../../config.hpp"
+
+#if ROCPRIM_DETAIL_USE_HOST_NATIVE
+
+    #include <algorithm>
+    #include <chrono>
+    #include <execution>
+    #include <iostream>
+    #include <iterator>
+    #include <numeric>
+    #include <type_traits>
+    #include <vector>
+
+    #include "../../detail/match_result_type.hpp"
+    #include "../../detail/radix_sort.hpp"
+    #include "../../detail/various.hpp"
+    #include "../../types.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Host-native implementations of device level algorithms, used with the HIP-CPU runtime.
+//
+// Device memory is host memory there, so instead of emulating blocks and warps the algorithms
+// split their inputs into tiles which fit into the L2 cache and process the tiles by parallel
+// algorithms of the standard library. HIP-CPU runs kernels by the same algorithms, with
+// libstdc++ they are backed by the work-stealing scheduler of TBB. Loops over the items of a
+// tile are kept free of dependencies between iterations where the operation allows it, so they
+// can be vectorized. The functions have the same temporary storage protocol as the device
+// implementations, they wait for the work already enqueued to the stream and return when the
+// results are written.
+
+// Number of items processed by a single task
+constexpr size_t host_native_tile_size = 16384;
+
+// Number of independent accumulators of reductions, which breaks the dependency chain of
+// the reduction of a tile
+constexpr unsigned int host_native_reduce_lanes = 8;
+
+// Upper bound of counters of the private histograms of all tasks
+constexpr size_t host_native_max_private_counters = size_t(1) << 22;
+
+// Calls function(i) for all i in [0, count) in parallel
+template<class Function>
+inline void host_native_parallel_for(const size_t count, Function&& function)
+{
+    std::vector<size_t> ids(count);
+    std::iota(ids.begin(), ids.end(), size_t(0));
+    std::for_each(std::execution::par,
+                  ids.begin(),
+                  ids.end(),
+                  [&function](const size_t i) { function(i); });
+}
+
+// Calls function(tile, begin, end) for all tiles of [0, size) in parallel
+template<class Function>
+inline void host_native_for_each_tile(const size_t size, const size_t tile_size, Function&& function)
+{
+    host_native_parallel_for(ceiling_div(size, tile_size),
+                             [&](const size_t tile)
+                             {
+                                 const size_t begin = tile * tile_size;
+                                 const size_t end   = std::min(size, begin + tile_size);
+                                 function(tile, begin, end);
+                             });
+}
+
+template<class InputIterator, class OutputIterator>
+inline void host_native_copy(InputIterator input, OutputIterator output, const size_t size)
+{
+    host_native_for_each_tile(size,
+                              host_native_tile_size,
+                              [&](size_t, const size_t begin, const size_t end)
+                              {
+                                  for(size_t i = begin; i < end; i++)
+                                  {
+                                      output[i] = input[i];
+                                  }
+                              });
+}
+
+// Waits for the work enqueued to the stream, host-native algorithms must not overlap it
+inline hipError_t host_native_begin(const hipStream_t stream,
+                                    const bool        debug_synchronous,
+                                    std::chrono::high_resolution_clock::time_point& start)
+{
+    const hipError_t error = hipStreamSynchronize(stream);
+    if(debug_synchronous)
+    {
+        start = std::chrono::high_resolution_clock::now();
+    }
+    return error;
+}
+
+inline void host_native_end(const char*  name,
+                            const size_t size,
+                            const bool   debug_synchronous,
+                            const std::chrono::high_resolution_clock::time_point start)
+{
+    if(debug_synchronous)
+    {
+        const auto end = std::chrono::high_resolution_clock::now();
+        const auto d   = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+        std::cout << name << "(" << size << ")"
+                  << " " << d.count() * 1000 << " ms" << '\n';
+    }
+}
+
+inline size_t host_native_storage_size(const size_t bytes)
+{
+    // Make sure user won't try to allocate 0 bytes memory
+    return bytes == 0 ? 4 : bytes;
+}
+
+// Reduction of a tile with independent accumulators, the operator is required to be
+// commutative and associative like by the device reduction
+template<class Result, class InputIterator, class BinaryFunction>
+inline Result host_native_reduce_tile(InputIterator        input,
+                                      const size_t         begin,
+                                      const size_t         end,
+                                      BinaryFunction&      reduce_op)
+{
+    constexpr unsigned int lanes = host_native_reduce_lanes;
+    if(end - begin < lanes)
+    {
+        Result result = input[begin];
+        for(size_t i = begin + 1; i < end; i++)
+        {
+            result = reduce_op(result, input[i]);
+        }
+        return result;
+    }
+
+    Result accumulators[lanes];
+    for(unsigned int lane = 0; lane < lanes; lane++)
+    {
+        accumulators[lane] = input[begin + lane];
+    }
+    size_t i = begin + lanes;
+    for(; i + lanes <= end; i += lanes)
+    {
+        for(unsigned int lane = 0; lane < lanes; lane++)
+        {
+            accumulators[lane] = reduce_op(accumulators[lane], input[i + lane]);
+        }
+    }
+    for(; i < end; i++)
+    {
+        accumulators[0] = reduce_op(accumulators[0], input[i]);
+    }
+    Result result = accumulators[0];
+    for(unsigned int lane = 1; lane < lanes; lane++)
+    {
+        result = reduce_op(result, accumulators[lane]);
+    }
+    return result;
+}
+
+template<bool WithInitialValue,
+         class InputIterator,
+         class OutputIterator,
+         class InitValueType,
+         class BinaryFunction>
+inline hipError_t host_native_reduce(void*               temporary_storage,
+                                     size_t&             storage_size,
+                                     InputIterator       input,
+                                     OutputIterator      output,
+                                     const InitValueType initial_value,
+                                     const size_t        size,
+                                     BinaryFunction      reduce_op,
+                                     const hipStream_t   stream,
+                                     bool                debug_synchronous)
+{
+    using input_type = typename std::iterator_traits<InputIterator>::value_type;
+    using result_type =
+        typename ::rocprim::detail::match_result_type<input_type, BinaryFunction>::type;
+
+    const size_t tiles = ceiling_div(size, host_native_tile_size);
+    if(temporary_storage == nullptr)
+    {
+        storage_size = host_native_storage_size(align_size(tiles * sizeof(result_type)));
+        return hipSuccess;
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+    hipError_t error = host_native_begin(stream, debug_synchronous, start);
+    if(error != hipSuccess) return error;
+
+    if(size == 0)
+    {
+        if(WithInitialValue)
+        {
+            output[0] = static_cast<result_type>(initial_value);
+        }
+        return hipSuccess;
+    }
+
+    result_type* partials = static_cast<result_type*>(temporary_storage);
+    host_native_for_each_tile(size,
+                              host_native_tile_size,
+                              [&](const size_t tile, const size_t begin, const size_t end) {
+                                  partials[tile] = host_native_reduce_tile<result_type>(
+                                      input, begin, end, reduce_op);
+                              });
+
+    result_type result = partials[0];
+    for(size_t tile = 1; tile < tiles; tile++)
+    {
+        result = reduce_op(result, partials[tile]);
+    }
+    if(WithInitialValue)
+    {
+        result = reduce_op(static_cast<result_type>(initial_value), result);
+    }
+    output[0] = result;
+
+    host_native_end("host_native_reduce", size, debug_synchronous, start);
+    return hipSuccess;
+}
+
+// Reduce-then-scan: tiles are reduced, the tile reductions are scanned and the tiles are scanned
+// with their prefixes. Unlike reductions, scans support non-commutative operators, so tiles
+// are processed from left to right.
+template<bool Exclusive,
+         class InputIterator,
+         class OutputIterator,
+         class InitValueType,
+         class BinaryFunction>
+inline hipError_t host_native_scan(void*               temporary_storage,
+                                   size_t&             storage_size,
+                                   InputIterator       input,
+                                   OutputIterator      output,
+                                   const InitValueType initial_value,
+                                   const size_t        size,
+                                   BinaryFunction      scan_op,
+                                   const hipStream_t   stream,
+                                   bool                debug_synchronous)
+{
+    using accumulator_type = input_type_t<InitValueType>;
+
+    const size_t tiles = ceiling_div(size, host_native_tile_size);
+    if(temporary_storage == nullptr)
+    {
+        storage_size = host_native_storage_size(align_size(tiles * sizeof(accumulator_type)));
+        return hipSuccess;
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+    hipError_t error = host_native_begin(stream, debug_synchronous, start);
+    if(error != hipSuccess) return error;
+
+    if(size == 0)
+        return hipSuccess;
+
+    accumulator_type* prefixes = static_cast<accumulator_type*>(temporary_storage);
+    host_native_for_each_tile(size,
+                              host_native_tile_size,
+                              [&](const size_t tile, const size_t begin, const size_t end)
+                              {
+                                  accumulator_type reduction = input[begin];
+                                  for(size_t i = begin + 1; i < end; i++)
+                                  {
+                                      reduction = scan_op(reduction, input[i]);
+                                  }
+                                  prefixes[tile] = reduction;
+                              });
+
+    // Exclusive scan of tile reductions, the first tile of inclusive scans has no prefix
+    accumulator_type prefix = Exclusive ? static_cast<accumulator_type>(get_input_value(initial_value))
+                                        : prefixes[0];
+    for(size_t tile = Exclusive ? 0 : 1; tile < tiles; tile++)
+    {
+        const accumulator_type reduction = prefixes[tile];
+        prefixes[tile]                   = prefix;
+        prefix                           = scan_op(prefix, reduction);
+    }
+
+    host_native_for_each_tile(size,
+                              host_native_tile_size,
+                              [&](const size_t tile, const size_t begin, const size_t end)
+                              {
+                                  if(Exclusive)
+                                  {
+                                      accumulator_type value = prefixes[tile];
+                                      for(size_t i = begin; i < end; i++)
+                                      {
+                                          // Read before write, input and output can be equal
+                                          const accumulator_type item = input[i];
+                                          output[i]                   = value;
+                                          value                       = scan_op(value, item);
+                                      }
+                                  }
+                                  else
+                                  {
+                                      size_t           i     = begin;
+                                      accumulator_type value = tile == 0
+                                          ? static_cast<accumulator_type>(input[i++])
+                                          : prefixes[tile];
+                                      if(tile == 0)
+                                      {
+                                          output[begin] = value;
+                                      }
+                                      for(; i < end; i++)
+                                      {
+                                          value     = scan_op(value, input[i]);
+                                          output[i] = value;
+                                      }
+                                  }
+                              });
+
+    host_native_end("host_native_scan", size, debug_synchronous, start);
+    return hipSuccess;
+}
+
+// Stable selection: selected items of tiles are counted, the counts are scanned and selected
+// items are written. IsSelected is called with the index of an item.
+template<class InputIterator,
+         class OutputIterator,
+         class SelectedCountOutputIterator,
+         class IsSelected>
+inline hipError_t host_native_select(void*                       temporary_storage,
+                                     size_t&                     storage_size,
+                                     InputIterator               input,
+                                     OutputIterator              output,
+                                     SelectedCountOutputIterator selected_count_output,
+                                     const size_t                size,
+                                     IsSelected                  is_selected,
+                                     const hipStream_t           stream,
+                                     const bool                  debug_synchronous)
+{
+    const size_t tiles = ceiling_div(size, host_native_tile_size);
+    if(temporary_storage == nullptr)
+    {
+        storage_size = host_native_storage_size(align_size(tiles * sizeof(size_t)));
+        return hipSuccess;
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+    hipError_t error = host_native_begin(stream, debug_synchronous, start);
+    if(error != hipSuccess) return error;
+
+    size_t* offsets = static_cast<size_t*>(temporary_storage);
+    host_native_for_each_tile(size,
+                              host_native_tile_size,
+                              [&](const size_t tile, const size_t begin, const size_t end)
+                              {
+                                  size_t count = 0;
+                                  for(size_t i = begin; i < end; i++)
+                                  {
+                                      count += is_selected(i) ? 1 : 0;
+                                  }
+                                  offsets[tile] = count;
+                              });
+
+    size_t selected_count = 0;
+    for(size_t tile = 0; tile < tiles; tile++)
+    {
+        const size_t count = offsets[tile];
+        offsets[tile]      = selected_count;
+        selected_count += count;
+    }
+
+    host_native_for_each_tile(size,
+                              host_native_tile_size,
+                              [&](const size_t tile, const size_t begin, const size_t end)
+                              {
+                                  size_t offset = offsets[tile];
+                                  for(size_t i = begin; i < end; i++)
+                                  {
+                                      if(is_selected(i))
+                                      {
+                                          output[offset++] = input[i];
+                                      }
+                                  }
+                              });
+    selected_count_output[0] = selected_count;
+
+    host_native_end("host_native_select", size, debug_synchronous, start);
+    return hipSuccess;
+}
+
+// Every task counts its samples in a private histogram of all channels, the private histograms
+// are added up afterwards. The number of tasks is bounded by the total size of private histograms.
+template<unsigned int Channels,
+         unsigned int ActiveChannels,
+         class SampleIterator,
+         class Counter,
+         class SampleToBinOp>
+inline hipError_t host_native_histogram(void*          temporary_storage,
+                                        size_t&        storage_size,
+                                        SampleIterator samples,
+                                        unsigned int   columns,
+                                        unsigned int   rows,
+                                        size_t         row_stride_bytes,
+                                        Counter*       histogram[ActiveChannels],
+                                        unsigned int   levels[ActiveChannels],
+                                        SampleToBinOp  sample_to_bin_op[ActiveChannels],
+                                        hipStream_t    stream,
+                                        bool           debug_synchronous)
+{
+    using sample_type = typename std::iterator_traits<SampleIterator>::value_type;
+
+    if(row_stride_bytes % sizeof(sample_type) != 0)
+    {
+        // Row stride must be a whole multiple of the sample data type size
+        return hipErrorInvalidValue;
+    }
+    const size_t row_stride = row_stride_bytes / sizeof(sample_type);
+
+    unsigned int bins_offsets[ActiveChannels];
+    size_t       total_bins = 0;
+    for(unsigned int channel = 0; channel < ActiveChannels; channel++)
+    {
+        bins_offsets[channel] = static_cast<unsigned int>(total_bins);
+        total_bins += levels[channel] - 1;
+    }
+
+    const size_t samples_count = static_cast<size_t>(columns) * rows;
+    const size_t tasks         = std::max<size_t>(
+        1,
+        std::min(ceiling_div(samples_count, host_native_tile_size),
+                 host_native_max_private_counters / std::max<size_t>(total_bins, 1)));
+    const size_t task_size = std::max<size_t>(ceiling_div(samples_count, tasks), 1);
+
+    if(temporary_storage == nullptr)
+    {
+        storage_size
+            = host_native_storage_size(align_size(tasks * total_bins * sizeof(Counter)));
+        return hipSuccess;
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+    hipError_t error = host_native_begin(stream, debug_synchronous, start);
+    if(error != hipSuccess) return error;
+
+    Counter* private_histograms = static_cast<Counter*>(temporary_storage);
+    host_native_parallel_for(
+        tasks,
+        [&](const size_t task)
+        {
+            Counter* task_histogram = private_histograms + task * total_bins;
+            std::fill(task_histogram, task_histogram + total_bins, Counter(0));
+
+            const size_t begin = std::min(task * task_size, samples_count);
+            const size_t end   = std::min(begin + task_size, samples_count);
+            if(begin == end)
+                return;
+            size_t row    = begin / columns;
+            size_t column = begin % columns;
+            for(size_t i = begin; i < end; i++)
+            {
+                const SampleIterator pixel = samples + row * row_stride + column * Channels;
+                for(unsigned int channel = 0; channel < ActiveChannels; channel++)
+                {
+                    unsigned int bin;
+                    if(sample_to_bin_op[channel](pixel[channel], bin))
+                    {
+                        ++task_histogram[bins_offsets[channel] + bin];
+                    }
+                }
+                if(++column == columns)
+                {
+                    column = 0;
+                    row++;
+                }
+            }
+        });
+
+    for(unsigned int channel = 0; channel < ActiveChannels; channel++)
+    {
+        Counter* channel_histogram = histogram[channel];
+        const unsigned int offset  = bins_offsets[channel];
+        host_native_for_each_tile(levels[channel] - 1,
+                                  host_native_tile_size,
+                                  [&](size_t, const size_t begin, const size_t end)
+                                  {
+                                      for(size_t bin = begin; bin < end; bin++)
+                                      {
+                                          Counter count = 0;
+                                          for(size_t task = 0; task < tasks; task++)
+                                          {
+                                              count += private_histograms[task * total_bins
+                                                                          + offset + bin];
+                                          }
+                                          channel_histogram[bin] = count;
+                                      }
+                                  });
+    }
+
+    host_native_end("host_native_histogram", samples_count, debug_synchronous, start);
+    return hipSuccess;
+}
+
+// Least significant digit radix sort: digits of tiles are counted, counts are scanned in
+// digit-major order and tiles scatter their items stably. Passes alternate between the output
+// and the temporary buffers like the device implementation.
+template<bool Descending,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class Size,
+         class Decomposer>
+inline hipError_t host_native_radix_sort(
+    void*                                                                temporary_storage,
+    size_t&                                                              storage_size,
+    KeysInputIterator                                                    keys_input,
+    typename std::iterator_traits<KeysInputIterator>::value_type*       keys_tmp,
+    KeysOutputIterator                                                   keys_output,
+    ValuesInputIterator                                                  values_input,
+    typename std::iterator_traits<ValuesInputIterator>::value_type*     values_tmp,
+    ValuesOutputIterator                                                 values_output,
+    Size                                                                 size_,
+    bool&                                                                is_result_in_output,
+    unsigned int                                                         begin_bit,
+    unsigned int                                                         end_bit,
+    Decomposer                                                           decomposer,
+    hipStream_t                                                          stream,
+    bool                                                                 debug_synchronous)
+{
+    using key_type   = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+    using codec_type = radix_key_codec<key_type, Descending, Decomposer>;
+
+    constexpr bool         with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+    constexpr unsigned int radix_bits  = 8;
+    constexpr unsigned int radix_size  = 1u << radix_bits;
+
+    const size_t size               = static_cast<size_t>(size_);
+    const bool   with_double_buffer = keys_tmp != nullptr;
+    const size_t tiles              = ceiling_div(size, host_native_tile_size);
+
+    const size_t counts_bytes = align_size(tiles * radix_size * sizeof(size_t));
+    const size_t keys_bytes   = with_double_buffer ? 0 : align_size(size * sizeof(key_type));
+    const size_t values_bytes
+        = with_double_buffer || !with_values ? 0 : align_size(size * sizeof(value_type));
+    if(temporary_storage == nullptr)
+    {
+        storage_size = host_native_storage_size(counts_bytes + keys_bytes + values_bytes);
+        return hipSuccess;
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+    hipError_t error = host_native_begin(stream, debug_synchronous, start);
+    if(error != hipSuccess) return error;
+
+    const unsigned int passes = ceiling_div(end_bit - begin_bit, radix_bits);
+    is_result_in_output       = false;
+    if(size == 0)
+        return hipSuccess;
+
+    char*   ptr    = static_cast<char*>(temporary_storage);
+    size_t* counts = reinterpret_cast<size_t*>(ptr);
+    ptr += counts_bytes;
+    if(!with_double_buffer)
+    {
+        keys_tmp = reinterpret_cast<key_type*>(ptr);
+        ptr += keys_bytes;
+        values_tmp = with_values ? reinterpret_cast<value_type*>(ptr) : nullptr;
+    }
+
+    if(passes == 0)
+    {
+        if(!with_double_buffer)
+        {
+            host_native_copy(keys_input, keys_output, size);
+            if constexpr(with_values)
+            {
+                host_native_copy(values_input, values_output, size);
+            }
+            is_result_in_output = true;
+        }
+        return hipSuccess;
+    }
+
+    const codec_type codec(decomposer);
+
+    const auto sort_pass = [&](auto         keys_src,
+                               auto         keys_dst,
+                               auto         values_src,
+                               auto         values_dst,
+                               unsigned int bit)
+    {
+        const unsigned int current_bits = std::min(radix_bits, end_bit - bit);
+        const auto digit_of = [&](const key_type& key)
+        { return codec.extract_digit(codec.encode(key), bit, current_bits); };
+
+        host_native_for_each_tile(size,
+                                  host_native_tile_size,
+                                  [&](const size_t tile, const size_t begin, const size_t end)
+                                  {
+                                      size_t* tile_counts = counts + tile * radix_size;
+                                      std::fill(tile_counts, tile_counts + radix_size, size_t(0));
+                                      for(size_t i = begin; i < end; i++)
+                                      {
+                                          ++tile_counts[digit_of(keys_src[i])];
+                                      }
+                                  });
+
+        size_t offset = 0;
+        for(unsigned int digit = 0; digit < radix_size; digit++)
+        {
+            for(size_t tile = 0; tile < tiles; tile++)
+            {
+                const size_t count                = counts[tile * radix_size + digit];
+                counts[tile * radix_size + digit] = offset;
+                offset += count;
+            }
+        }
+
+        host_native_for_each_tile(size,
+                                  host_native_tile_size,
+                                  [&](const size_t tile, const size_t begin, const size_t end)
+                                  {
+                                      size_t* tile_offsets = counts + tile * radix_size;
+                                      for(size_t i = begin; i < end; i++)
+                                      {
+                                          const key_type key      = keys_src[i];
+                                          const size_t   position = tile_offsets[digit_of(key)]++;
+                                          keys_dst[position]      = key;
+                                          if constexpr(with_values)
+                                          {
+                                              values_dst[position] = values_src[i];
+                                          }
+                                      }
+                                  });
+    };
+
+    bool to_output  = with_double_buffer || (passes - 1) % 2 == 0;
+    bool from_input = true;
+    if(!with_double_buffer && to_output)
+    {
+        // Copy input keys and values if necessary (in-place sorting: input and output iterators are equal)
+        const bool keys_equal = are_iterators_equal(keys_input, keys_output);
+        const bool values_equal
+            = with_values && are_iterators_equal(values_input, values_output);
+        if(keys_equal || values_equal)
+        {
+            host_native_copy(keys_input, keys_tmp, size);
+            if constexpr(with_values)
+            {
+                host_native_copy(values_input, values_tmp, size);
+            }
+            from_input = false;
+        }
+    }
+
+    unsigned int bit = begin_bit;
+    for(unsigned int pass = 0; pass < passes; pass++)
+    {
+        if(from_input && to_output)
+        {
+            sort_pass(keys_input, keys_output, values_input, values_output, bit);
+        }
+        else if(from_input)
+        {
+            sort_pass(keys_input, keys_tmp, values_input, values_tmp, bit);
+        }
+        else if(to_output)
+        {
+            sort_pass(keys_tmp, keys_output, values_tmp, values_output, bit);
+        }
+        else
+        {
+            sort_pass(keys_output, keys_tmp, values_output, values_tmp, bit);
+        }
+
+        is_result_in_output = to_output;
+        from_input          = false;
+        to_output           = !to_output;
+        bit += radix_bits;
+    }
+
+    host_native_end("host_native_radix_sort", size, debug_synchronous, start);
+    return hipSuccess;
+}
+
+// Keys are copied to the temporary storage and sorted by the parallel stable sort of the standard
+// library. Pairs sort 32-bit indices by their keys and gather keys and values once.
+template<class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class BinaryFunction>
+inline hipError_t host_native_merge_sort(void*                temporary_storage,
+                                         size_t&              storage_size,
+                                         KeysInputIterator    keys_input,
+                                         KeysOutputIterator   keys_output,
+                                         ValuesInputIterator  values_input,
+                                         ValuesOutputIterator values_output,
+                                         const unsigned int   size,
+                                         BinaryFunction       compare_function,
+                                         const hipStream_t    stream,
+                                         bool                 debug_synchronous)
+{
+    using key_type   = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+    using index_type = unsigned int;
+
+    constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+    // In-place sorts gather values from a copy
+    const bool copy_values = with_values && are_iterators_equal(values_input, values_output);
+
+    const size_t keys_bytes    = align_size(size * sizeof(key_type));
+    const size_t indices_bytes = with_values ? align_size(size * sizeof(index_type)) : 0;
+    const size_t values_bytes  = copy_values ? align_size(size * sizeof(value_type)) : 0;
+    if(temporary_storage == nullptr)
+    {
+        storage_size = host_native_storage_size(keys_bytes + indices_bytes + values_bytes);
+        return hipSuccess;
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+    hipError_t error = host_native_begin(stream, debug_synchronous, start);
+    if(error != hipSuccess) return error;
+
+    if(size == 0)
+        return hipSuccess;
+
+    char*     ptr  = static_cast<char*>(temporary_storage);
+    key_type* keys = reinterpret_cast<key_type*>(ptr);
+    ptr += keys_bytes;
+    host_native_copy(keys_input, keys, size);
+
+    if constexpr(!with_values)
+    {
+        std::stable_sort(std::execution::par, keys, keys + size, compare_function);
+        host_native_copy(keys, keys_output, size);
+    }
+    else
+    {
+        index_type* indices = reinterpret_cast<index_type*>(ptr);
+        ptr += indices_bytes;
+        host_native_for_each_tile(size,
+                                  host_native_tile_size,
+                                  [&](size_t, const size_t begin, const size_t end)
+                                  {
+                                      for(size_t i = begin; i < end; i++)
+                                      {
+                                          indices[i] = static_cast<index_type>(i);
+                                      }
+                                  });
+        std::stable_sort(std::execution::par,
+                         indices,
+                         indices + size,
+                         [&](const index_type a, const index_type b)
+                         { return compare_function(keys[a], keys[b]); });
+
+        const auto gather = [&](auto values)
+        {
+            host_native_for_each_tile(size,
+                                      host_native_tile_size,
+                                      [&](size_t, const size_t begin, const size_t end)
+                                      {
+                                          for(size_t i = begin; i < end; i++)
+                                          {
+                                              keys_output[i]   = keys[indices[i]];
+                                              values_output[i] = values[indices[i]];
+                                          }
+                                      });
+        };
+        if(copy_values)
+        {
+            value_type* values = reinterpret_cast<value_type*>(ptr);
+            host_native_copy(values_input, values, size);
+            gather(values);
+        }
+        else
+        {
+            gather(values_input);
+        }
+    }
+
+    host_native_end("host_native_merge_sort", size, debug_synchronous, start);
+    return hipSuccess;
+}
+
+} // end namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DETAIL_USE_HOST_NATIVE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_HOST_NATIVE_HPP_
@@ -324,12 +324,10 @@ ROCPRIM_DEVICE ROCPRIM_INLINE auto partition_scatter(ValueType (&values)[ItemsPe
                                                      const OffsetType    selected_prefix,
                                                      const OffsetType    selected_in_block,
                                                      ScatterStorageType& storage,
-                                                     const unsigned int  flat_block_id,
+                                                     const size_t        tile_id,
                                                      const unsigned int  flat_block_thread_id,
-                                                     const bool          is_last_block,
-                                                     const unsigned int  valid_in_last_block,
-                                                     size_t (&prev_selected_count_values)[1],
-                                                     size_t prev_processed) ->
+                                                     const bool          is_last_tile,
+                                                     const unsigned int  valid_in_last_tile) ->
     typename std::enable_if<!OnlySelected>::type
 {
     constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
@@ -357,19 +355,18 @@ ROCPRIM_DEVICE ROCPRIM_INLINE auto partition_scatter(ValueType (&values)[ItemsPe
 
     const auto calculate_scatter_index = [=](const unsigned int item_index) -> size_t
     {
-        const size_t selected_output_index
-            = prev_selected_count_values[0] + selected_prefix + item_index;
-        const size_t rejected_output_index = total_size + selected_output_index - prev_processed
-                                             - flat_block_id * items_per_block - 2 * item_index
+        const size_t selected_output_index = selected_prefix + item_index;
+        const size_t rejected_output_index = total_size + selected_output_index
+                                             - tile_id * items_per_block - 2 * item_index
                                              + selected_in_block - 1;
         return item_index < selected_in_block ? selected_output_index : rejected_output_index;
     };
-    if(is_last_block)
+    if(is_last_tile)
     {
         for(unsigned int i = 0; i < ItemsPerThread; i++)
         {
             const unsigned int item_index = i * BlockSize + flat_block_thread_id;
-            if(item_index < valid_in_last_block)
+            if(item_index < valid_in_last_tile)
             {
                 output[calculate_scatter_index(item_index)] = reloaded_values[i];
             }
@@ -400,12 +397,10 @@ ROCPRIM_DEVICE ROCPRIM_INLINE auto partition_scatter(ValueType (&values)[ItemsPe
                                                      const OffsetType    selected_prefix,
                                                      const OffsetType    selected_in_block,
                                                      ScatterStorageType& storage,
-                                                     const unsigned int /*flat_block_id*/,
+                                                     const size_t /*tile_id*/,
                                                      const unsigned int flat_block_thread_id,
-                                                     const bool         is_last_block,
-                                                     const unsigned int /*valid_in_last_block*/,
-                                                     size_t (&prev_selected_count_values)[1],
-                                                     size_t /*prev_processed*/) ->
+                                                     const bool         is_last_tile,
+                                                     const unsigned int /*valid_in_last_tile*/) ->
     typename std::enable_if<OnlySelected>::type
 {
     if(selected_in_block > BlockSize)
@@ -426,7 +421,7 @@ ROCPRIM_DEVICE ROCPRIM_INLINE auto partition_scatter(ValueType (&values)[ItemsPe
         // Coalesced write from shared memory to global memory
         for(unsigned int i = flat_block_thread_id; i < selected_in_block; i += BlockSize)
         {
-            output[prev_selected_count_values[0] + selected_prefix + i] = scatter_storage[i];
+            output[static_cast<size_t>(selected_prefix) + i] = scatter_storage[i];
         }
     }
     else
@@ -434,11 +429,11 @@ ROCPRIM_DEVICE ROCPRIM_INLINE auto partition_scatter(ValueType (&values)[ItemsPe
         ROCPRIM_UNROLL
         for(unsigned int i = 0; i < ItemsPerThread; i++)
         {
-            if(!is_last_block || output_indices[i] < (selected_prefix + selected_in_block))
+            if(!is_last_tile || output_indices[i] < (selected_prefix + selected_in_block))
             {
                 if(is_selected[i])
                 {
-                    output[prev_selected_count_values[0] + output_indices[i]] = values[i];
+                    output[output_indices[i]] = values[i];
                 }
             }
         }
@@ -460,28 +455,28 @@ ROCPRIM_DEVICE ROCPRIM_INLINE void partition_scatter(ValueType (&values)[ItemsPe
                                                      const OffsetType    selected_prefix,
                                                      const OffsetType    selected_in_block,
                                                      ScatterStorageType& storage,
-                                                     const unsigned int  flat_block_id,
+                                                     const size_t        tile_id,
                                                      const unsigned int  flat_block_thread_id,
-                                                     const bool          is_last_block,
-                                                     const unsigned int  valid_in_last_block,
-                                                     size_t (&prev_selected_count_values)[2],
-                                                     size_t prev_processed)
+                                                     const bool          is_last_tile,
+                                                     const unsigned int  valid_in_last_tile)
 {
     constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
     auto                   scatter_storage = storage.get();
-    const size_t first_selected_prefix     = prev_selected_count_values[0] + selected_prefix.x;
+    const size_t first_selected_prefix     = selected_prefix.x;
     const size_t second_selected_prefix
-        = prev_selected_count_values[1] - selected_in_block.x + selected_prefix.y;
-    const size_t unselected_prefix = prev_processed - first_selected_prefix - second_selected_prefix
-                                     + items_per_block * flat_block_id - 2 * selected_in_block.x
+        = static_cast<size_t>(selected_prefix.y) - selected_in_block.x;
+    const size_t unselected_prefix = items_per_block * tile_id - first_selected_prefix
+                                     - second_selected_prefix - 2 * selected_in_block.x
                                      - selected_in_block.y;
 
     ROCPRIM_UNROLL
     for(unsigned int i = 0; i < ItemsPerThread; i++)
     {
-        const unsigned int first_selected_item_index = output_indices[i].x - selected_prefix.x;
-        const unsigned int second_selected_item_index = output_indices[i].y - selected_prefix.y
-            + selected_in_block.x;
+        const unsigned int first_selected_item_index
+            = static_cast<unsigned int>(output_indices[i].x - selected_prefix.x);
+        const unsigned int second_selected_item_index
+            = static_cast<unsigned int>(output_indices[i].y - selected_prefix.y
+                                        + selected_in_block.x);
         unsigned int scatter_index{};
 
         if(is_selected[0][i])
@@ -522,12 +517,12 @@ ROCPRIM_DEVICE ROCPRIM_INLINE void partition_scatter(ValueType (&values)[ItemsPe
         }
     };
 
-    if(is_last_block)
+    if(is_last_tile)
     {
         for(unsigned int i = 0; i < ItemsPerThread; i++)
         {
             const unsigned int item_index = (i * BlockSize) + flat_block_thread_id;
-            if(item_index < valid_in_last_block)
+            if(item_index < valid_in_last_tile)
             {
                 save_to_output(item_index);
             }
@@ -559,10 +554,11 @@ void convert_selected_to_indices(offset_type (&output_indices)[items_per_thread]
 }
 
 template<
-    unsigned int items_per_thread
+    unsigned int items_per_thread,
+    class offset_type
 >
 ROCPRIM_DEVICE ROCPRIM_INLINE
-void convert_selected_to_indices(uint2 (&output_indices)[items_per_thread],
+void convert_selected_to_indices(offset_type (&output_indices)[items_per_thread],
                                  bool (&is_selected)[2][items_per_thread])
 {
     ROCPRIM_UNROLL
@@ -574,31 +570,27 @@ void convert_selected_to_indices(uint2 (&output_indices)[items_per_thread],
 }
 
 template<class OffsetT>
-ROCPRIM_DEVICE ROCPRIM_INLINE void store_selected_count(size_t* selected_count,
-                                                        size_t (&prev_selected_count_values)[1],
+ROCPRIM_DEVICE ROCPRIM_INLINE void store_selected_count(size_t*       selected_count,
                                                         const OffsetT selected_prefix,
                                                         const OffsetT selected_in_block)
 {
-    selected_count[0] = prev_selected_count_values[0] + selected_prefix + selected_in_block;
+    selected_count[0] = selected_prefix + selected_in_block;
 }
 
-ROCPRIM_DEVICE ROCPRIM_INLINE void store_selected_count(size_t* selected_count,
-                                                        size_t (&prev_selected_count_values)[2],
+ROCPRIM_DEVICE ROCPRIM_INLINE void store_selected_count(size_t*     selected_count,
                                                         const uint2 selected_prefix,
                                                         const uint2 selected_in_block)
 {
-    selected_count[0] = prev_selected_count_values[0] + selected_prefix.x + selected_in_block.x;
-    selected_count[1] = prev_selected_count_values[1] + selected_prefix.y + selected_in_block.y;
+    selected_count[0] = selected_prefix.x + selected_in_block.x;
+    selected_count[1] = selected_prefix.y + selected_in_block.y;
 }
 
-template<unsigned int Size>
-ROCPRIM_DEVICE void load_selected_count(const size_t* const prev_selected_count,
-                                        size_t (&loaded_values)[Size])
+ROCPRIM_DEVICE ROCPRIM_INLINE void store_selected_count(size_t*          selected_count,
+                                                        const ulonglong2 selected_prefix,
+                                                        const ulonglong2 selected_in_block)
 {
-    for(unsigned int i = 0; i < Size; ++i)
-    {
-        loaded_values[i] = prev_selected_count[i];
-    }
+    selected_count[0] = selected_prefix.x + selected_in_block.x;
+    selected_count[1] = selected_prefix.y + selected_in_block.y;
 }
 
 template<select_method SelectMethod,
@@ -613,19 +605,17 @@ template<select_method SelectMethod,
          class OffsetLookbackScanState,
          class... UnaryPredicates>
 ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
-    partition_kernel_impl(KeyIterator                    keys_input,
-                          ValueIterator                  values_input,
-                          FlagIterator                   flags,
-                          OutputKeyIterator              keys_output,
-                          OutputValueIterator            values_output,
-                          size_t*                        selected_count,
-                          size_t*                        prev_selected_count,
-                          size_t                         prev_processed,
-                          const size_t                   total_size,
-                          InequalityOp                   inequality_op,
-                          OffsetLookbackScanState        offset_scan_state,
-                          const unsigned int             number_of_blocks,
-                          ordered_block_id<unsigned int> ordered_bid,
+    partition_kernel_impl(KeyIterator                             keys_input,
+                          ValueIterator                           values_input,
+                          FlagIterator                            flags,
+                          OutputKeyIterator                       keys_output,
+                          OutputValueIterator                     values_output,
+                          size_t*                                 selected_count,
+                          const size_t                            total_size,
+                          InequalityOp                            inequality_op,
+                          OffsetLookbackScanState                 offset_scan_state,
+                          const size_t                            number_of_tiles,
+                          ordered_block_id<lookback_tile_id_type> ordered_tile_id,
                           UnaryPredicates... predicates)
 {
     constexpr auto block_size = Config::block_size;
@@ -656,7 +646,7 @@ ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
     using block_discontinuity_key_type = ::rocprim::block_discontinuity<
         key_type, block_size
     >;
-    using order_bid_type = ordered_block_id<unsigned int>;
+    using order_tile_id_type = ordered_block_id<lookback_tile_id_type>;
 
     // Offset prefix operation type
     using offset_scan_prefix_op_type = offset_lookback_scan_prefix_op<
@@ -676,7 +666,7 @@ ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
 
     ROCPRIM_SHARED_MEMORY struct
     {
-        typename order_bid_type::storage_type ordered_bid;
+        typename order_tile_id_type::storage_type ordered_tile_id;
         union
         {
             raw_exchange_keys_storage_type exchange_keys;
@@ -689,181 +679,182 @@ ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
         };
     } storage;
 
-    // For better performance this must stay before the `ordered_block_id.get` (and other writes).
-    // `ordered_block_id.get` includes an atomic write and syncthreads (a memory fence) that the
-    // compiler thinks could alias with the read of `prev_selected_count`.
-    // This makes the load a vector load instead of scalar because (quoting llvm's amdgpu backend)
-    // "Scalar memory operations are only used to access memory that is proven to not change during
-    // the execution of the kernel dispatch".
-    size_t prev_selected_count_values[sizeof...(UnaryPredicates)]{};
-    load_selected_count(prev_selected_count, prev_selected_count_values);
-
     const auto flat_block_thread_id = ::rocprim::detail::block_thread_id<0>();
-    const auto flat_block_id = ordered_bid.get(flat_block_thread_id, storage.ordered_bid);
-    const auto block_offset         = flat_block_id * items_per_block;
-    const auto valid_in_last_block
-        = total_size - prev_processed - items_per_block * (number_of_blocks - 1);
+    const unsigned int valid_in_last_tile
+        = static_cast<unsigned int>(total_size - items_per_block * (number_of_tiles - 1));
 
-    key_type         keys[items_per_thread];
-    is_selected_type is_selected;
-    offset_type      output_indices[items_per_thread];
-
-    // Load input values into values
-    const bool is_last_block = flat_block_id == (number_of_blocks - 1);
-    if(is_last_block) // last block
-    {
-        block_load_key_type()
-            .load(
-                keys_input + block_offset,
-                keys,
-                valid_in_last_block,
-                storage.load_keys
-            );
-    }
-    else
-    {
-        block_load_key_type()
-            .load(
-                keys_input + block_offset,
-                keys,
-                storage.load_keys
-            );
-    }
-    ::rocprim::syncthreads(); // sync threads to reuse shared memory
+    // When the grid has fewer blocks than there are tiles, blocks take tiles until all of them
+    // are processed. The tile ids are ordered, so the look-back never waits for a tile that has
+    // not been taken by a running block.
+    const bool is_grid_persistent = number_of_tiles > ::rocprim::detail::grid_size<0>();
 
-    // Load selection flags into is_selected, generate them using
-    // input value and selection predicate, or generate them using
-    // block_discontinuity primitive
-    const bool is_first_block = flat_block_id == 0 && prev_processed == 0;
-    partition_block_load_flags<SelectMethod,
-                               block_size,
-                               block_load_flag_type,
-                               block_discontinuity_key_type>(keys_input + block_offset - 1,
-                                                             flags + block_offset,
-                                                             keys,
-                                                             is_selected,
-                                                             predicates...,
-                                                             inequality_op,
-                                                             storage,
-                                                             is_first_block,
-                                                             flat_block_thread_id,
-                                                             is_last_block,
-                                                             valid_in_last_block);
-
-    // Convert true/false is_selected flags to 0s and 1s
-    convert_selected_to_indices(output_indices, is_selected);
-
-    // Number of selected values in previous blocks
-    offset_type selected_prefix{};
-    // Number of selected values in this block
-    offset_type selected_in_block{};
-
-    // Calculate number of selected values in block and their indices
-    if(flat_block_id == 0)
-    {
-        block_scan_offset_type()
-            .exclusive_scan(
-                output_indices,
-                output_indices,
-                offset_type{}, /** initial value */
-                selected_in_block,
-                storage.scan_offsets,
-                ::rocprim::plus<offset_type>()
-            );
-        if(flat_block_thread_id == 0)
-        {
-            offset_scan_state.set_complete(flat_block_id, selected_in_block);
-        }
-        ::rocprim::syncthreads(); // sync threads to reuse shared memory
-    }
-    else
+    for(size_t tile_id = ordered_tile_id.get(flat_block_thread_id, storage.ordered_tile_id);
+        tile_id < number_of_tiles;
+        tile_id = ordered_tile_id.get(flat_block_thread_id, storage.ordered_tile_id))
     {
-        ROCPRIM_SHARED_MEMORY typename offset_scan_prefix_op_type::storage_type storage_prefix_op;
-        auto prefix_op = offset_scan_prefix_op_type(
-            flat_block_id,
-            offset_scan_state,
-            storage_prefix_op
-        );
-        block_scan_offset_type()
-            .exclusive_scan(
-                output_indices,
-                output_indices,
-                storage.scan_offsets,
-                prefix_op,
-                ::rocprim::plus<offset_type>()
-            );
-        ::rocprim::syncthreads(); // sync threads to reuse shared memory
-
-        selected_in_block = prefix_op.get_reduction();
-        selected_prefix   = prefix_op.get_prefix();
-    }
+        const size_t tile_offset = tile_id * items_per_block;
 
-    // Scatter selected and rejected values
-    partition_scatter<OnlySelected, block_size>(keys,
-                                                is_selected,
-                                                output_indices,
-                                                keys_output,
-                                                total_size,
-                                                selected_prefix,
-                                                selected_in_block,
-                                                storage.exchange_keys,
-                                                flat_block_id,
-                                                flat_block_thread_id,
-                                                is_last_block,
-                                                valid_in_last_block,
-                                                prev_selected_count_values,
-                                                prev_processed);
-
-    static constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
-
-    if ROCPRIM_IF_CONSTEXPR (with_values) {
-        value_type values[items_per_thread];
+        key_type         keys[items_per_thread];
+        is_selected_type is_selected;
+        offset_type      output_indices[items_per_thread];
 
-        ::rocprim::syncthreads(); // sync threads to reuse shared memory
-        if(is_last_block)
+        // Load input values into values
+        const bool is_last_tile = tile_id == (number_of_tiles - 1);
+        if(is_last_tile) // last tile
         {
-            block_load_value_type()
+            block_load_key_type()
                 .load(
-                    values_input + block_offset,
-                    values,
-                    valid_in_last_block,
-                    storage.load_values
+                    keys_input + tile_offset,
+                    keys,
+                    valid_in_last_tile,
+                    storage.load_keys
                 );
         }
         else
         {
-            block_load_value_type()
+            block_load_key_type()
                 .load(
-                    values_input + block_offset,
-                    values,
-                    storage.load_values
+                    keys_input + tile_offset,
+                    keys,
+                    storage.load_keys
                 );
         }
         ::rocprim::syncthreads(); // sync threads to reuse shared memory
 
-        partition_scatter<OnlySelected, block_size>(values,
+        // Load selection flags into is_selected, generate them using
+        // input value and selection predicate, or generate them using
+        // block_discontinuity primitive
+        const bool is_first_tile = tile_id == 0;
+        partition_block_load_flags<SelectMethod,
+                                   block_size,
+                                   block_load_flag_type,
+                                   block_discontinuity_key_type>(keys_input + tile_offset - 1,
+                                                                 flags + tile_offset,
+                                                                 keys,
+                                                                 is_selected,
+                                                                 predicates...,
+                                                                 inequality_op,
+                                                                 storage,
+                                                                 is_first_tile,
+                                                                 flat_block_thread_id,
+                                                                 is_last_tile,
+                                                                 valid_in_last_tile);
+
+        // Convert true/false is_selected flags to 0s and 1s
+        convert_selected_to_indices(output_indices, is_selected);
+
+        // Number of selected values in previous tiles
+        offset_type selected_prefix{};
+        // Number of selected values in this tile
+        offset_type selected_in_block{};
+
+        // Calculate number of selected values in tile and their indices
+        if(is_first_tile)
+        {
+            block_scan_offset_type()
+                .exclusive_scan(
+                    output_indices,
+                    output_indices,
+                    offset_type{}, /** initial value */
+                    selected_in_block,
+                    storage.scan_offsets,
+                    ::rocprim::plus<offset_type>()
+                );
+            if(flat_block_thread_id == 0)
+            {
+                offset_scan_state.set_complete(tile_id, selected_in_block);
+            }
+            ::rocprim::syncthreads(); // sync threads to reuse shared memory
+        }
+        else
+        {
+            ROCPRIM_SHARED_MEMORY typename offset_scan_prefix_op_type::storage_type storage_prefix_op;
+            auto prefix_op = offset_scan_prefix_op_type(
+                tile_id,
+                offset_scan_state,
+                storage_prefix_op
+            );
+            block_scan_offset_type()
+                .exclusive_scan(
+                    output_indices,
+                    output_indices,
+                    storage.scan_offsets,
+                    prefix_op,
+                    ::rocprim::plus<offset_type>()
+                );
+            ::rocprim::syncthreads(); // sync threads to reuse shared memory
+
+            selected_in_block = prefix_op.get_reduction();
+            selected_prefix   = prefix_op.get_prefix();
+        }
+
+        // Scatter selected and rejected values
+        partition_scatter<OnlySelected, block_size>(keys,
                                                     is_selected,
                                                     output_indices,
-                                                    values_output,
+                                                    keys_output,
                                                     total_size,
                                                     selected_prefix,
                                                     selected_in_block,
-                                                    storage.exchange_values,
-                                                    flat_block_id,
+                                                    storage.exchange_keys,
+                                                    tile_id,
                                                     flat_block_thread_id,
-                                                    is_last_block,
-                                                    valid_in_last_block,
-                                                    prev_selected_count_values,
-                                                    prev_processed);
-    }
+                                                    is_last_tile,
+                                                    valid_in_last_tile);
 
-    // Last block in grid stores number of selected values
-    if(is_last_block && flat_block_thread_id == 0)
-    {
-        store_selected_count(selected_count,
-                             prev_selected_count_values,
-                             selected_prefix,
-                             selected_in_block);
+        static constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+        if ROCPRIM_IF_CONSTEXPR (with_values) {
+            value_type values[items_per_thread];
+
+            ::rocprim::syncthreads(); // sync threads to reuse shared memory
+            if(is_last_tile)
+            {
+                block_load_value_type()
+                    .load(
+                        values_input + tile_offset,
+                        values,
+                        valid_in_last_tile,
+                        storage.load_values
+                    );
+            }
+            else
+            {
+                block_load_value_type()
+                    .load(
+                        values_input + tile_offset,
+                        values,
+                        storage.load_values
+                    );
+            }
+            ::rocprim::syncthreads(); // sync threads to reuse shared memory
+
+            partition_scatter<OnlySelected, block_size>(values,
+                                                        is_selected,
+                                                        output_indices,
+                                                        values_output,
+                                                        total_size,
+                                                        selected_prefix,
+                                                        selected_in_block,
+                                                        storage.exchange_values,
+                                                        tile_id,
+                                                        flat_block_thread_id,
+                                                        is_last_tile,
+                                                        valid_in_last_tile);
+        }
+
+        // Last tile stores number of selected values
+        if(is_last_tile && flat_block_thread_id == 0)
+        {
+            store_selected_count(selected_count, selected_prefix, selected_in_block);
+        }
+
+        if(!is_grid_persistent)
+        {
+            // Every tile was taken by a block of the grid
+            break;
+        }
+        ::rocprim::syncthreads(); // sync threads to reuse shared memory
     }
 }
 
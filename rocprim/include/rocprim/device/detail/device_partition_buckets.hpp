@@ -0,0 +1,399 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_PARTITION_BUCKETS_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_PARTITION_BUCKETS_HPP_
+
+#include <iterator>
+#include <type_traits>
+
+#include "../../config.hpp"
+#include "../../detail/various.hpp"
+#include "../../functional.hpp"
+#include "../../intrinsics.hpp"
+#include "../../types.hpp"
+
+#include "../../block/block_discontinuity.hpp"
+#include "../../block/block_exchange.hpp"
+#include "../../block/block_load.hpp"
+#include "../../block/block_load_func.hpp"
+#include "../../block/block_radix_sort.hpp"
+#include "../../block/block_scan.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Bucket partitioning works like an iteration of the batched radix sort with buckets in place
+// of digits: the buckets of items are counted per batch of consecutive tiles, the counts are
+// scanned bucket-major (so the items of a bucket are ordered by batch), and every batch scatters
+// its tiles in order. Within a tile the items are stably sorted by bucket, so the partitioning
+// is stable.
+
+// Computes the range [begin, end) of items of a batch. The first full_batches batches have
+// tiles_per_full_batch tiles, the remaining ones have one tile less.
+template<unsigned int ItemsPerTile>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void partition_buckets_batch_range(const unsigned int batch_id,
+                                   const unsigned int tiles_per_full_batch,
+                                   const unsigned int full_batches,
+                                   const size_t       size,
+                                   size_t&            begin,
+                                   size_t&            end)
+{
+    size_t       first_tile;
+    unsigned int tiles;
+    if(batch_id < full_batches)
+    {
+        tiles      = tiles_per_full_batch;
+        first_tile = static_cast<size_t>(batch_id) * tiles;
+    }
+    else
+    {
+        tiles      = tiles_per_full_batch - 1;
+        first_tile = static_cast<size_t>(batch_id) * tiles + full_batches;
+    }
+    begin = first_tile * ItemsPerTile;
+    end   = ::rocprim::min(begin + static_cast<size_t>(tiles) * ItemsPerTile, size);
+}
+
+template<class Config, class InputIterator, class BucketOp>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void partition_buckets_count(InputIterator      input,
+                             const size_t       size,
+                             BucketOp           bucket_op,
+                             const unsigned int num_buckets,
+                             size_t*            batch_bucket_counts,
+                             const unsigned int batches,
+                             const unsigned int tiles_per_full_batch,
+                             const unsigned int full_batches)
+{
+    constexpr unsigned int block_size       = Config::block_size;
+    constexpr unsigned int items_per_thread = Config::items_per_thread;
+    constexpr unsigned int items_per_tile   = block_size * items_per_thread;
+
+    using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+    ROCPRIM_SHARED_MEMORY unsigned int block_bucket_counts[Config::max_buckets];
+
+    const unsigned int flat_id  = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int batch_id = ::rocprim::detail::block_id<0>();
+
+    for(unsigned int bucket = flat_id; bucket < num_buckets; bucket += block_size)
+    {
+        block_bucket_counts[bucket] = 0;
+    }
+    ::rocprim::syncthreads();
+
+    size_t begin;
+    size_t end;
+    partition_buckets_batch_range<items_per_tile>(batch_id,
+                                                  tiles_per_full_batch,
+                                                  full_batches,
+                                                  size,
+                                                  begin,
+                                                  end);
+
+    for(size_t tile_offset = begin; tile_offset < end; tile_offset += items_per_tile)
+    {
+        const unsigned int valid_count
+            = static_cast<unsigned int>(::rocprim::min<size_t>(end - tile_offset, items_per_tile));
+
+        // The order of items is irrelevant, only the counts matter
+        value_type values[items_per_thread];
+        block_load_direct_striped<block_size>(flat_id, input + tile_offset, values, valid_count);
+
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < items_per_thread; i++)
+        {
+            if(flat_id + i * block_size < valid_count)
+            {
+                const unsigned int bucket = bucket_op(values[i]);
+                ::rocprim::detail::atomic_add(&block_bucket_counts[bucket], 1u);
+            }
+        }
+    }
+    ::rocprim::syncthreads();
+
+    for(unsigned int bucket = flat_id; bucket < num_buckets; bucket += block_size)
+    {
+        batch_bucket_counts[static_cast<size_t>(bucket) * batches + batch_id]
+            = block_bucket_counts[bucket];
+    }
+}
+
+// Replaces the counts of a bucket in every batch by their exclusive scan, and writes the total
+// count of the bucket to bucket_counts. Each block scans one bucket.
+template<class Config>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void partition_buckets_scan_batches(size_t*            batch_bucket_counts,
+                                    size_t*            bucket_counts,
+                                    const unsigned int batches)
+{
+    constexpr unsigned int block_size       = Config::block_size;
+    constexpr unsigned int items_per_thread = Config::items_per_thread;
+
+    using scan_type = ::rocprim::block_scan<size_t, block_size>;
+
+    ROCPRIM_SHARED_MEMORY typename scan_type::storage_type storage;
+
+    const unsigned int bucket  = ::rocprim::detail::block_id<0>();
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+
+    size_t* counts = batch_bucket_counts + static_cast<size_t>(bucket) * batches;
+
+    size_t values[items_per_thread];
+    for(unsigned int i = 0; i < items_per_thread; i++)
+    {
+        const unsigned int batch_id = flat_id * items_per_thread + i;
+        values[i] = batch_id < batches ? counts[batch_id] : 0;
+    }
+
+    size_t bucket_count;
+    scan_type().exclusive_scan(values, values, size_t(0), bucket_count, storage);
+
+    for(unsigned int i = 0; i < items_per_thread; i++)
+    {
+        const unsigned int batch_id = flat_id * items_per_thread + i;
+        if(batch_id < batches)
+        {
+            counts[batch_id] = values[i];
+        }
+    }
+
+    if(flat_id == 0)
+    {
+        bucket_counts[bucket] = bucket_count;
+    }
+}
+
+// Replaces the total counts of buckets by their exclusive scan, and writes it together with
+// the number of all items to bucket_offsets. A single block scans all buckets.
+template<class Config, class OffsetsOutputIterator>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void partition_buckets_scan_buckets(size_t*               bucket_starts,
+                                    OffsetsOutputIterator bucket_offsets,
+                                    const unsigned int    num_buckets)
+{
+    constexpr unsigned int block_size       = Config::block_size;
+    constexpr unsigned int items_per_thread = Config::items_per_thread;
+
+    using scan_type = ::rocprim::block_scan<size_t, block_size>;
+
+    ROCPRIM_SHARED_MEMORY typename scan_type::storage_type storage;
+
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+
+    size_t values[items_per_thread];
+    for(unsigned int i = 0; i < items_per_thread; i++)
+    {
+        const unsigned int bucket = flat_id * items_per_thread + i;
+        values[i] = bucket < num_buckets ? bucket_starts[bucket] : 0;
+    }
+
+    size_t total_count;
+    scan_type().exclusive_scan(values, values, size_t(0), total_count, storage);
+
+    for(unsigned int i = 0; i < items_per_thread; i++)
+    {
+        const unsigned int bucket = flat_id * items_per_thread + i;
+        if(bucket < num_buckets)
+        {
+            bucket_starts[bucket]  = values[i];
+            bucket_offsets[bucket] = values[i];
+        }
+    }
+
+    if(flat_id == 0)
+    {
+        bucket_offsets[num_buckets] = total_count;
+    }
+}
+
+template<class Config, class InputIterator, class OutputIterator, class BucketOp>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void partition_buckets_scatter(InputIterator       input,
+                               OutputIterator      output,
+                               const size_t        size,
+                               BucketOp            bucket_op,
+                               const unsigned int  num_buckets,
+                               const unsigned int  bucket_bits,
+                               const size_t* const batch_bucket_starts,
+                               const size_t* const bucket_starts,
+                               const unsigned int  batches,
+                               const unsigned int  tiles_per_full_batch,
+                               const unsigned int  full_batches)
+{
+    constexpr unsigned int block_size       = Config::block_size;
+    constexpr unsigned int items_per_thread = Config::items_per_thread;
+    constexpr unsigned int items_per_tile   = block_size * items_per_thread;
+    constexpr unsigned int max_buckets      = Config::max_buckets;
+
+    // Positions in starts and ends go up to items_per_tile inclusive
+    static_assert(items_per_tile < (1u << 16), "Tile positions must fit in unsigned short");
+
+    using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+    using load_type = ::rocprim::block_load<value_type,
+                                            block_size,
+                                            items_per_thread,
+                                            ::rocprim::block_load_method::block_load_transpose>;
+    using sort_type = ::rocprim::block_radix_sort<unsigned int, block_size, items_per_thread, value_type>;
+    using discontinuity_type     = ::rocprim::block_discontinuity<unsigned int, block_size>;
+    using buckets_exchange_type  = ::rocprim::block_exchange<unsigned int, block_size, items_per_thread>;
+    using values_exchange_type   = ::rocprim::block_exchange<value_type, block_size, items_per_thread>;
+
+    ROCPRIM_SHARED_MEMORY struct
+    {
+        union
+        {
+            typename load_type::storage_type             load;
+            typename sort_type::storage_type             sort;
+            typename discontinuity_type::storage_type    discontinuity;
+            typename buckets_exchange_type::storage_type buckets_exchange;
+            typename values_exchange_type::storage_type  values_exchange;
+        };
+
+        unsigned short starts[max_buckets];
+        unsigned short ends[max_buckets];
+
+        size_t bucket_starts[max_buckets];
+    } storage;
+
+    const unsigned int flat_id  = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int batch_id = ::rocprim::detail::block_id<0>();
+
+    for(unsigned int bucket = flat_id; bucket < num_buckets; bucket += block_size)
+    {
+        storage.bucket_starts[bucket]
+            = bucket_starts[bucket]
+              + batch_bucket_starts[static_cast<size_t>(bucket) * batches + batch_id];
+    }
+
+    size_t begin;
+    size_t end;
+    partition_buckets_batch_range<items_per_tile>(batch_id,
+                                                  tiles_per_full_batch,
+                                                  full_batches,
+                                                  size,
+                                                  begin,
+                                                  end);
+
+    for(size_t tile_offset = begin; tile_offset < end; tile_offset += items_per_tile)
+    {
+        const unsigned int valid_count
+            = static_cast<unsigned int>(::rocprim::min<size_t>(end - tile_offset, items_per_tile));
+
+        value_type values[items_per_thread];
+        if(valid_count == items_per_tile)
+        {
+            load_type().load(input + tile_offset, values, storage.load);
+        }
+        else
+        {
+            load_type().load(input + tile_offset, values, valid_count, storage.load);
+        }
+
+        // Out of bounds items get the largest digit, the stable sort leaves them after all
+        // valid items
+        unsigned int buckets[items_per_thread];
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < items_per_thread; i++)
+        {
+            const unsigned int pos = flat_id * items_per_thread + i;
+            buckets[i]             = pos < valid_count ? bucket_op(values[i]) : ~0u;
+        }
+
+        for(unsigned int bucket = flat_id; bucket < num_buckets; bucket += block_size)
+        {
+            storage.starts[bucket] = valid_count;
+            storage.ends[bucket]   = valid_count;
+        }
+
+        ::rocprim::syncthreads();
+        sort_type().sort(buckets, values, storage.sort, 0, bucket_bits);
+
+        bool head_flags[items_per_thread];
+        bool tail_flags[items_per_thread];
+        ::rocprim::syncthreads();
+        discontinuity_type().flag_heads_and_tails(head_flags,
+                                                  tail_flags,
+                                                  buckets,
+                                                  ::rocprim::not_equal_to<unsigned int>(),
+                                                  storage.discontinuity);
+
+        // Fill start and end position of the items of every bucket
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < items_per_thread; i++)
+        {
+            const unsigned int pos = flat_id * items_per_thread + i;
+            if(pos < valid_count)
+            {
+                if(head_flags[i])
+                {
+                    storage.starts[buckets[i]] = pos;
+                }
+                if(tail_flags[i] || pos == valid_count - 1)
+                {
+                    storage.ends[buckets[i]] = pos;
+                }
+            }
+        }
+
+        ::rocprim::syncthreads();
+        // Rearrange to striped arrangement to have faster coalesced writes instead of
+        // scattering of blocked-arranged items
+        buckets_exchange_type().blocked_to_striped(buckets, buckets, storage.buckets_exchange);
+        ::rocprim::syncthreads();
+        values_exchange_type().blocked_to_striped(values, values, storage.values_exchange);
+
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < items_per_thread; i++)
+        {
+            const unsigned int pos = i * block_size + flat_id;
+            if(pos < valid_count)
+            {
+                const unsigned int bucket = buckets[i];
+                output[pos - storage.starts[bucket] + storage.bucket_starts[bucket]] = values[i];
+            }
+        }
+
+        ::rocprim::syncthreads();
+
+        // Accumulate counts of the current tile
+        for(unsigned int bucket = flat_id; bucket < num_buckets; bucket += block_size)
+        {
+            const unsigned int start = storage.starts[bucket];
+            if(start < valid_count)
+            {
+                storage.bucket_starts[bucket] += storage.ends[bucket] - start + 1;
+            }
+        }
+
+        ::rocprim::syncthreads();
+    }
+}
+
+} // end namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_PARTITION_BUCKETS_HPP_
@@ -38,6 +38,10 @@
 #include "../../block/block_load_func.hpp"
 #include "../../block/block_scan.hpp"
 #include "../../block/block_radix_sort.hpp"
+#include "../../warp/detail/warp_reduce_crosslane.hpp"
+
+#include "lookback_scan_state.hpp"
+#include "ordered_block_id.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -46,42 +50,57 @@ namespace detail
 
 // Wrapping functions that allow to call proper methods (with or without values)
 // (a variant with values is enabled only when Value is not empty_type)
-template<bool Descending = false, class SortType, class SortKey, class SortValue, unsigned int ItemsPerThread>
+template<
+    bool Descending = false,
+    class SortType,
+    class SortKey,
+    class SortValue,
+    unsigned int ItemsPerThread,
+    class Decomposer = identity_decomposer
+>
 ROCPRIM_DEVICE ROCPRIM_INLINE
 void sort_block(SortType sorter,
                 SortKey (&keys)[ItemsPerThread],
                 SortValue (&values)[ItemsPerThread],
                 typename SortType::storage_type& storage,
                 unsigned int begin_bit,
-                unsigned int end_bit)
+                unsigned int end_bit,
+                Decomposer decomposer = Decomposer())
 {
     if(Descending)
     {
-        sorter.sort_desc(keys, values, storage, begin_bit, end_bit);
+        sorter.sort_desc(keys, values, storage, decomposer, begin_bit, end_bit);
     }
     else
     {
-        sorter.sort(keys, values, storage, begin_bit, end_bit);
+        sorter.sort(keys, values, storage, decomposer, begin_bit, end_bit);
     }
 }
 
-template<bool Descending = false, class SortType, class SortKey, unsigned int ItemsPerThread>
+template<
+    bool Descending = false,
+    class SortType,
+    class SortKey,
+    unsigned int ItemsPerThread,
+    class Decomposer = identity_decomposer
+>
 ROCPRIM_DEVICE ROCPRIM_INLINE
 void sort_block(SortType sorter,
                 SortKey (&keys)[ItemsPerThread],
                 ::rocprim::empty_type (&values)[ItemsPerThread],
                 typename SortType::storage_type& storage,
                 unsigned int begin_bit,
-                unsigned int end_bit)
+                unsigned int end_bit,
+                Decomposer decomposer = Decomposer())
 {
     (void) values;
     if(Descending)
     {
-        sorter.sort_desc(keys, storage, begin_bit, end_bit);
+        sorter.sort_desc(keys, storage, decomposer, begin_bit, end_bit);
     }
     else
     {
-        sorter.sort(keys, storage, begin_bit, end_bit);
+        sorter.sort(keys, storage, decomposer, begin_bit, end_bit);
     }
 }
 
@@ -196,7 +215,8 @@ template<
     unsigned int ItemsPerThread,
     bool Descending,
     class Key,
-    class Value
+    class Value,
+    class Decomposer = identity_decomposer
 >
 struct radix_sort_single_helper
 {
@@ -205,8 +225,7 @@ struct radix_sort_single_helper
     using key_type = Key;
     using value_type = Value;
 
-    using key_codec = radix_key_codec<key_type, Descending>;
-    using bit_key_type = typename key_codec::bit_key_type;
+    using key_codec = radix_key_codec<key_type, Descending, Decomposer>;
     using keys_load_type = ::rocprim::block_load<
         key_type, BlockSize, ItemsPerThread,
         ::rocprim::block_load_method::block_load_transpose>;
@@ -241,7 +260,8 @@ struct radix_sort_single_helper
                      unsigned int size,
                      unsigned int bit,
                      unsigned int current_radix_bits,
-                     storage_type& storage)
+                     storage_type& storage,
+                     Decomposer decomposer = Decomposer())
     {
         const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
         const unsigned int flat_block_id = ::rocprim::detail::block_id<0>();
@@ -250,11 +270,6 @@ struct radix_sort_single_helper
         unsigned int valid_in_last_block;
         const bool last_block = flat_block_id == (number_of_blocks - 1);
 
-        using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
-
-        using key_codec = radix_key_codec<key_type, Descending>;
-        using bit_key_type = typename key_codec::bit_key_type;
-
         key_type keys[ItemsPerThread];
         value_type values[ItemsPerThread];
         if(!last_block)
@@ -269,7 +284,7 @@ struct radix_sort_single_helper
         }
         else
         {
-            const key_type out_of_bounds = key_codec::decode(bit_key_type(-1));
+            const key_type out_of_bounds = key_codec(decomposer).get_out_of_bounds_key();
             valid_in_last_block = size - items_per_block * (number_of_blocks - 1);
             keys_load_type().load(keys_input + block_offset, keys, valid_in_last_block, out_of_bounds, storage.keys_load);
             if(with_values)
@@ -281,7 +296,7 @@ struct radix_sort_single_helper
 
         ::rocprim::syncthreads();
 
-        sort_block<Descending>(sort_type(), keys, values, storage.sort, bit, bit + current_radix_bits);
+        sort_block<Descending>(sort_type(), keys, values, storage.sort, bit, bit + current_radix_bits, decomposer);
 
         // Store keys and values
         #pragma unroll
@@ -486,112 +501,141 @@ struct radix_sort_and_scatter_helper
 template<
     unsigned int BlockSize,
     unsigned int ItemsPerThread,
-    unsigned int RadixBits,
     bool Descending,
     class KeysInputIterator,
-    class Offset
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class Decomposer
 >
 ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE
-void fill_digit_counts(KeysInputIterator keys_input,
-                       Offset size,
-                       Offset * batch_digit_counts,
-                       unsigned int bit,
-                       unsigned int current_radix_bits,
-                       unsigned int blocks_per_full_batch,
-                       unsigned int full_batches)
+void sort_single(KeysInputIterator keys_input,
+                 KeysOutputIterator keys_output,
+                 ValuesInputIterator values_input,
+                 ValuesOutputIterator values_output,
+                 unsigned int size,
+                 unsigned int bit,
+                 unsigned int current_radix_bits,
+                 Decomposer decomposer)
 {
-    constexpr unsigned int radix_size = 1 << RadixBits;
-    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
-
-    using count_helper_type = radix_digit_count_helper<::rocprim::device_warp_size(), BlockSize, ItemsPerThread, RadixBits, Descending>;
-
-    ROCPRIM_SHARED_MEMORY typename count_helper_type::storage_type storage;
-
-    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
-    const unsigned int batch_id = ::rocprim::detail::block_id<0>();
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
 
-    Offset block_offset;
-    unsigned int blocks_per_batch;
-    if(batch_id < full_batches)
-    {
-        blocks_per_batch = blocks_per_full_batch;
-        block_offset = batch_id * blocks_per_batch;
-    }
-    else
-    {
-        blocks_per_batch = blocks_per_full_batch - 1;
-        block_offset = batch_id * blocks_per_batch + full_batches;
-    }
-    block_offset *= items_per_block;
+    using sort_single_helper = radix_sort_single_helper<
+        BlockSize, ItemsPerThread, Descending,
+        key_type, value_type, Decomposer
+    >;
 
-    unsigned int digit_count;
-    if(batch_id < ::rocprim::detail::grid_size<0>() - 1)
-    {
-        count_helper_type().template count_digits<true>(
-            keys_input,
-            block_offset, block_offset + blocks_per_batch * items_per_block,
-            bit, current_radix_bits,
-            storage,
-            digit_count
-        );
-    }
-    else
-    {
-        count_helper_type().template count_digits<false>(
-            keys_input,
-            block_offset, size,
-            bit, current_radix_bits,
-            storage,
-            digit_count
-        );
-    }
+    ROCPRIM_SHARED_MEMORY typename sort_single_helper::storage_type storage;
 
-    if(flat_id < radix_size)
-    {
-        batch_digit_counts[batch_id * radix_size + flat_id] = digit_count;
-    }
+    sort_single_helper().template sort_single(
+        keys_input, keys_output, values_input, values_output,
+        size, bit, current_radix_bits,
+        storage, decomposer
+    );
 }
 
+// Onesweep radix sort was implemented based on:
+// Adinets, A. and Merrill, D. Onesweep: A Faster Least Significant Digit Radix Sort for GPUs.
+// arXiv:2206.01784. Jun. 2022.
+//
+// Digit counts of all passes are computed by a single upfront pass over the keys, after that
+// every pass sorts and scatters each tile exactly once: global offsets of the tile's digits
+// are resolved by decoupled look-back over the per-digit counts of preceding tiles.
+// Large inputs are sorted in portions by consecutive launches, the last tile of a portion
+// passes the offsets of the digits after the portion to the next launch.
+
+// Every key is counted for all iterations at once: the first long_iterations passes use
+// LongRadixBits, the remaining ones use ShortRadixBits. Histograms are stored as [iteration][digit]
+// with 2^LongRadixBits digits per iteration.
 template<
     unsigned int BlockSize,
     unsigned int ItemsPerThread,
-    unsigned int RadixBits,
-    class Offset
+    unsigned int LongRadixBits,
+    unsigned int ShortRadixBits,
+    bool Descending,
+    class KeysInputIterator,
+    class Decomposer
 >
 ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE
-void scan_batches(Offset * batch_digit_counts,
-                  Offset * digit_counts,
-                  unsigned int batches)
+void onesweep_histograms(KeysInputIterator keys_input,
+                         unsigned int * histograms,
+                         unsigned int size,
+                         unsigned int begin_bit,
+                         unsigned int end_bit,
+                         unsigned int long_iterations,
+                         unsigned int iterations,
+                         Decomposer decomposer)
 {
-    constexpr unsigned int radix_size = 1 << RadixBits;
+    constexpr unsigned int radix_size = 1 << LongRadixBits;
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using key_codec = radix_key_codec<key_type, Descending, Decomposer>;
+    using bit_key_type = typename key_codec::bit_key_type;
+
+    static_assert(ShortRadixBits <= LongRadixBits, "ShortRadixBits must not exceed LongRadixBits");
+    constexpr unsigned int max_iterations = ::rocprim::detail::ceiling_div<unsigned int>(
+        radix_key_bits<key_type, Decomposer>::value, ShortRadixBits);
 
-    using scan_type = typename ::rocprim::block_scan<Offset, BlockSize>;
+    const key_codec codec(decomposer);
+
+    ROCPRIM_SHARED_MEMORY unsigned int digit_counts[max_iterations * radix_size];
 
-    const unsigned int digit = ::rocprim::detail::block_id<0>();
     const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int block_id = ::rocprim::detail::block_id<0>();
+    const unsigned int grid_size = ::rocprim::detail::grid_size<0>();
 
-    Offset values[ItemsPerThread];
-    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    for(unsigned int i = flat_id; i < iterations * radix_size; i += BlockSize)
     {
-        const unsigned int batch_id = flat_id * ItemsPerThread + i;
-        values[i] = (batch_id < batches ? batch_digit_counts[batch_id * radix_size + digit] : 0);
+        digit_counts[i] = 0;
     }
+    ::rocprim::syncthreads();
 
-    Offset digit_count;
-    scan_type().exclusive_scan(values, values, 0, digit_count);
-
-    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    const unsigned int tiles = ::rocprim::detail::ceiling_div(size, items_per_block);
+    for(unsigned int tile_id = block_id; tile_id < tiles; tile_id += grid_size)
     {
-        const unsigned int batch_id = flat_id * ItemsPerThread + i;
-        if(batch_id < batches)
+        const unsigned int block_offset = tile_id * items_per_block;
+
+        key_type keys[ItemsPerThread];
+        // Use loading into a striped arrangement because an order of items is irrelevant,
+        // only totals matter
+        const unsigned int valid_count = ::rocprim::min(size - block_offset, items_per_block);
+        if(valid_count == items_per_block)
+        {
+            block_load_direct_striped<BlockSize>(flat_id, keys_input + block_offset, keys);
+        }
+        else
         {
-            batch_digit_counts[batch_id * radix_size + digit] = values[i];
+            block_load_direct_striped<BlockSize>(flat_id, keys_input + block_offset, keys, valid_count);
+        }
+
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
+        {
+            if(i * BlockSize + flat_id < valid_count)
+            {
+                const bit_key_type bit_key = codec.encode(keys[i]);
+                unsigned int bit = begin_bit;
+                for(unsigned int iteration = 0; iteration < iterations; iteration++)
+                {
+                    const unsigned int radix_bits = iteration < long_iterations ? LongRadixBits : ShortRadixBits;
+                    const unsigned int digit = codec.extract_digit(
+                        bit_key, bit, ::rocprim::min(radix_bits, end_bit - bit));
+                    ::rocprim::detail::atomic_add(&digit_counts[iteration * radix_size + digit], 1u);
+                    bit += radix_bits;
+                }
+            }
         }
     }
+    ::rocprim::syncthreads();
 
-    if(flat_id == 0)
+    for(unsigned int i = flat_id; i < iterations * radix_size; i += BlockSize)
     {
-        digit_counts[digit] = digit_count;
+        const unsigned int count = digit_counts[i];
+        if(count != 0)
+        {
+            ::rocprim::detail::atomic_add(&histograms[i], count);
+        }
     }
 }
 
@@ -600,53 +644,281 @@ template<
     class Offset
 >
 ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE
-void scan_digits(Offset * digit_counts)
+void onesweep_scan_histograms(const unsigned int * histograms,
+                              Offset * digit_offsets,
+                              unsigned int portions,
+                              unsigned int iterations)
 {
     constexpr unsigned int radix_size = 1 << RadixBits;
 
     using scan_type = typename ::rocprim::block_scan<Offset, radix_size>;
 
-    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int digit = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int iteration = ::rocprim::detail::block_id<0>();
+
+    // Histograms are stored as [portion][iteration][digit], offsets as [iteration][digit].
+    // Portions of the input are reordered by every pass, so only the total counts of a digit
+    // are the same for all passes.
+    Offset digit_count = 0;
+    for(unsigned int portion = 0; portion < portions; portion++)
+    {
+        digit_count += histograms[(portion * iterations + iteration) * radix_size + digit];
+    }
 
-    Offset value = digit_counts[flat_id];
-    scan_type().exclusive_scan(value, value, 0);
-    digit_counts[flat_id] = value;
+    Offset digit_offset;
+    scan_type().exclusive_scan(digit_count, digit_offset, 0);
+    digit_offsets[iteration * radix_size + digit] = digit_offset;
 }
 
 template<
     unsigned int BlockSize,
     unsigned int ItemsPerThread,
+    unsigned int RadixBits,
     bool Descending,
-    class KeysInputIterator,
-    class KeysOutputIterator,
-    class ValuesInputIterator,
-    class ValuesOutputIterator
+    class Key,
+    class Value,
+    class Offset,
+    class Decomposer
 >
-ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE
-void sort_single(KeysInputIterator keys_input,
-                 KeysOutputIterator keys_output,
-                 ValuesInputIterator values_input,
-                 ValuesOutputIterator values_output,
-                 unsigned int size,
-                 unsigned int bit,
-                 unsigned int current_radix_bits)
+struct radix_sort_onesweep_helper
 {
-    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
-    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+    static constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+    static constexpr unsigned int radix_size = 1 << RadixBits;
 
-    using sort_single_helper = radix_sort_single_helper<
-        BlockSize, ItemsPerThread, Descending,
-        key_type, value_type
-    >;
+    static_assert(radix_size <= BlockSize, "Radix size must not exceed BlockSize");
+    static_assert(items_per_block <= (1u << 16), "Tile positions must fit in unsigned short");
+    static_assert(BlockSize % ::rocprim::device_warp_size() == 0,
+                  "BlockSize must be divisible by warp size");
 
-    ROCPRIM_SHARED_MEMORY typename sort_single_helper::storage_type storage;
+    using key_type = Key;
+    using value_type = Value;
 
-    sort_single_helper().template sort_single(
-        keys_input, keys_output, values_input, values_output,
-        size, bit, current_radix_bits,
-        storage
-    );
-}
+    using key_codec = radix_key_codec<key_type, Descending, Decomposer>;
+    using bit_key_type = typename key_codec::bit_key_type;
+    using keys_load_type = ::rocprim::block_load<
+        key_type, BlockSize, ItemsPerThread,
+        ::rocprim::block_load_method::block_load_transpose>;
+    using values_load_type = ::rocprim::block_load<
+        value_type, BlockSize, ItemsPerThread,
+        ::rocprim::block_load_method::block_load_transpose>;
+    using sort_type = ::rocprim::block_radix_sort<key_type, BlockSize, ItemsPerThread, value_type>;
+    using discontinuity_type = ::rocprim::block_discontinuity<unsigned int, BlockSize>;
+    using bit_keys_exchange_type = ::rocprim::block_exchange<bit_key_type, BlockSize, ItemsPerThread>;
+    using values_exchange_type = ::rocprim::block_exchange<value_type, BlockSize, ItemsPerThread>;
+    using ordered_block_id_type = ::rocprim::detail::ordered_block_id<unsigned int>;
+    using warp_reduce_type = warp_reduce_crosslane<unsigned int, ::rocprim::device_warp_size(), true>;
+
+    static constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+    static constexpr unsigned int warps = BlockSize / ::rocprim::device_warp_size();
+
+    struct storage_type
+    {
+        union
+        {
+            typename keys_load_type::storage_type keys_load;
+            typename values_load_type::storage_type values_load;
+            typename sort_type::storage_type sort;
+            typename discontinuity_type::storage_type discontinuity;
+            typename bit_keys_exchange_type::storage_type bit_keys_exchange;
+            typename values_exchange_type::storage_type values_exchange;
+        };
+
+        typename ordered_block_id_type::storage_type ordered_bid;
+
+        unsigned int digit_counts[radix_size];
+        unsigned short starts[radix_size];
+
+        Offset digit_starts[radix_size];
+    };
+
+    template<
+        class KeysInputIterator,
+        class KeysOutputIterator,
+        class ValuesInputIterator,
+        class ValuesOutputIterator,
+        class LookbackScanState
+    >
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void sort_and_scatter(KeysInputIterator keys_input,
+                          KeysOutputIterator keys_output,
+                          ValuesInputIterator values_input,
+                          ValuesOutputIterator values_output,
+                          unsigned int size,
+                          const Offset * digit_offsets,
+                          Offset * next_digit_offsets,
+                          LookbackScanState lookback_scan_state,
+                          ordered_block_id_type ordered_bid,
+                          unsigned int bit,
+                          unsigned int current_radix_bits,
+                          storage_type& storage,
+                          Decomposer decomposer)
+    {
+        const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+        const key_codec codec(decomposer);
+
+        if(flat_id < radix_size)
+        {
+            storage.digit_counts[flat_id] = 0;
+        }
+
+        // Tiles are processed in the order in which blocks start, so look-back never waits
+        // for a block that has not been scheduled yet
+        const unsigned int tile_id = ordered_bid.get(flat_id, storage.ordered_bid);
+        const unsigned int block_offset = tile_id * items_per_block;
+        const unsigned int valid_count = ::rocprim::min(size - block_offset, items_per_block);
+
+        key_type keys[ItemsPerThread];
+        value_type values[ItemsPerThread];
+        if(valid_count == items_per_block)
+        {
+            keys_load_type().load(keys_input + block_offset, keys, storage.keys_load);
+        }
+        else
+        {
+            // Sort will leave "invalid" (out of size) items at the end of the sorted sequence
+            const key_type out_of_bounds = codec.get_out_of_bounds_key();
+            keys_load_type().load(keys_input + block_offset, keys, valid_count, out_of_bounds, storage.keys_load);
+        }
+
+        // Count digits of the tile and publish them as soon as possible, so the following
+        // tiles can proceed with their look-back while this tile is being sorted
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
+        {
+            if(flat_id * ItemsPerThread + i < valid_count)
+            {
+                const unsigned int digit = codec.extract_digit(
+                    codec.encode(keys[i]), bit, current_radix_bits);
+                ::rocprim::detail::atomic_add(&storage.digit_counts[digit], 1u);
+            }
+        }
+        ::rocprim::syncthreads();
+
+        if(flat_id < radix_size)
+        {
+            const unsigned int digit_count = storage.digit_counts[flat_id];
+            if(tile_id == 0)
+            {
+                lookback_scan_state.set_complete(flat_id, digit_count);
+            }
+            else
+            {
+                lookback_scan_state.set_partial(tile_id * radix_size + flat_id, digit_count);
+            }
+        }
+
+        if(with_values)
+        {
+            if(valid_count == items_per_block)
+            {
+                values_load_type().load(values_input + block_offset, values, storage.values_load);
+            }
+            else
+            {
+                values_load_type().load(values_input + block_offset, values, valid_count, storage.values_load);
+            }
+            ::rocprim::syncthreads();
+        }
+
+        sort_block<Descending>(sort_type(), keys, values, storage.sort, bit, bit + current_radix_bits, decomposer);
+
+        bit_key_type bit_keys[ItemsPerThread];
+        unsigned int digits[ItemsPerThread];
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
+        {
+            bit_keys[i] = codec.encode(keys[i]);
+            digits[i] = codec.extract_digit(bit_keys[i], bit, current_radix_bits);
+        }
+
+        bool head_flags[ItemsPerThread];
+        ::rocprim::not_equal_to<unsigned int> flag_op;
+
+        ::rocprim::syncthreads();
+        discontinuity_type().flag_heads(head_flags, digits, flag_op, storage.discontinuity);
+
+        // Fill start position of subsequence for every digit
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
+        {
+            if(head_flags[i])
+            {
+                storage.starts[digits[i]] = flat_id * ItemsPerThread + i;
+            }
+        }
+
+        // Look back over the counts of the digits in the preceding tiles: every warp resolves
+        // its digits one by one, lanes read the counts of consecutive preceding tiles
+        const unsigned int lane_id = ::rocprim::lane_id();
+        const bool is_last_tile = block_offset + valid_count == size;
+        for(unsigned int digit = ::rocprim::warp_id(flat_id); digit < radix_size; digit += warps)
+        {
+            unsigned int prefix = 0;
+            if(tile_id != 0)
+            {
+                unsigned int look_back_tile_id = tile_id;
+                while(true)
+                {
+                    // Lanes before the first tile see an empty complete prefix
+                    typename LookbackScanState::flag_type flag = PREFIX_COMPLETE;
+                    unsigned int value = 0;
+                    if(lane_id < look_back_tile_id)
+                    {
+                        lookback_scan_state.get(
+                            (look_back_tile_id - lane_id - 1) * radix_size + digit, flag, value);
+                    }
+                    // Only counts up to the nearest complete prefix are added
+                    const lane_mask_type complete = ::rocprim::ballot(flag == PREFIX_COMPLETE);
+                    const unsigned int partial_value
+                        = ::rocprim::masked_bit_count(complete) == 0 ? value : 0;
+                    unsigned int window_prefix;
+                    warp_reduce_type().reduce(partial_value, window_prefix, ::rocprim::plus<unsigned int>());
+                    prefix += window_prefix;
+                    if(complete != 0)
+                    {
+                        break;
+                    }
+                    look_back_tile_id -= ::rocprim::device_warp_size();
+                }
+            }
+            if(lane_id == 0)
+            {
+                const unsigned int count = storage.digit_counts[digit];
+                if(tile_id != 0)
+                {
+                    lookback_scan_state.set_complete(tile_id * radix_size + digit, prefix + count);
+                }
+                storage.digit_starts[digit] = digit_offsets[digit] + prefix;
+                if(is_last_tile && next_digit_offsets != nullptr)
+                {
+                    next_digit_offsets[digit] = digit_offsets[digit] + prefix + count;
+                }
+            }
+        }
+
+        ::rocprim::syncthreads();
+        // Rearrange to striped arrangement to have faster coalesced writes instead of
+        // scattering of blocked-arranged items
+        bit_keys_exchange_type().blocked_to_striped(bit_keys, bit_keys, storage.bit_keys_exchange);
+        if(with_values)
+        {
+            ::rocprim::syncthreads();
+            values_exchange_type().blocked_to_striped(values, values, storage.values_exchange);
+        }
+
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
+        {
+            const unsigned int digit = codec.extract_digit(bit_keys[i], bit, current_radix_bits);
+            const unsigned int pos = i * BlockSize + flat_id;
+            if(pos < valid_count)
+            {
+                const Offset dst = storage.digit_starts[digit] + (pos - storage.starts[digit]);
+                keys_output[dst] = codec.decode(bit_keys[i]);
+                if(with_values)
+                {
+                    values_output[dst] = values[i];
+                }
+            }
+        }
+    }
+};
 
 template<
     unsigned int BlockSize,
@@ -657,77 +929,41 @@ template<
     class KeysOutputIterator,
     class ValuesInputIterator,
     class ValuesOutputIterator,
-    class Offset
+    class Offset,
+    class LookbackScanState,
+    class Decomposer
 >
 ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE
-void sort_and_scatter(KeysInputIterator keys_input,
-                      KeysOutputIterator keys_output,
-                      ValuesInputIterator values_input,
-                      ValuesOutputIterator values_output,
-                      Offset size,
-                      const Offset * batch_digit_starts,
-                      const Offset * digit_starts,
-                      unsigned int bit,
-                      unsigned int current_radix_bits,
-                      unsigned int blocks_per_full_batch,
-                      unsigned int full_batches)
+void onesweep_iteration(KeysInputIterator keys_input,
+                        KeysOutputIterator keys_output,
+                        ValuesInputIterator values_input,
+                        ValuesOutputIterator values_output,
+                        unsigned int size,
+                        const Offset * digit_offsets,
+                        Offset * next_digit_offsets,
+                        LookbackScanState lookback_scan_state,
+                        ordered_block_id<unsigned int> ordered_bid,
+                        unsigned int bit,
+                        unsigned int current_radix_bits,
+                        Decomposer decomposer)
 {
-    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
-    constexpr unsigned int radix_size = 1 << RadixBits;
-
     using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
     using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
 
-    using sort_and_scatter_helper = radix_sort_and_scatter_helper<
+    using onesweep_helper = radix_sort_onesweep_helper<
         BlockSize, ItemsPerThread, RadixBits, Descending,
-        key_type, value_type, Offset
+        key_type, value_type, Offset, Decomposer
     >;
 
-    ROCPRIM_SHARED_MEMORY typename sort_and_scatter_helper::storage_type storage;
-
-    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
-    const unsigned int batch_id = ::rocprim::detail::block_id<0>();
+    ROCPRIM_SHARED_MEMORY typename onesweep_helper::storage_type storage;
 
-    Offset block_offset;
-    unsigned int blocks_per_batch;
-    if(batch_id < full_batches)
-    {
-        blocks_per_batch = blocks_per_full_batch;
-        block_offset = batch_id * blocks_per_batch;
-    }
-    else
-    {
-        blocks_per_batch = blocks_per_full_batch - 1;
-        block_offset = batch_id * blocks_per_batch + full_batches;
-    }
-    block_offset *= items_per_block;
-
-    Offset digit_start = 0;
-    if(flat_id < radix_size)
-    {
-        digit_start = digit_starts[flat_id] + batch_digit_starts[batch_id * radix_size + flat_id];
-    }
-
-    if(batch_id < ::rocprim::detail::grid_size<0>() - 1)
-    {
-        sort_and_scatter_helper().template sort_and_scatter<true>(
-            keys_input, keys_output, values_input, values_output,
-            block_offset, block_offset + blocks_per_batch * items_per_block,
-            bit, current_radix_bits,
-            digit_start,
-            storage
-        );
-    }
-    else
-    {
-        sort_and_scatter_helper().template sort_and_scatter<false>(
-            keys_input, keys_output, values_input, values_output,
-            block_offset, size,
-            bit, current_radix_bits,
-            digit_start,
-            storage
-        );
-    }
+    onesweep_helper().sort_and_scatter(
+        keys_input, keys_output, values_input, values_output,
+        size, digit_offsets, next_digit_offsets,
+        lookback_scan_state, ordered_bid,
+        bit, current_radix_bits,
+        storage, decomposer
+    );
 }
 
 template<class T>
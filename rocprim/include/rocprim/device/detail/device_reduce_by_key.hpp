@@ -52,12 +52,13 @@ template<typename ValueIterator, typename BinaryOp>
 using accumulator_type_t =
     typename detail::match_result_type<reduce_by_key::value_type_t<ValueIterator>, BinaryOp>::type;
 
-template<typename AccumulatorType>
-using wrapped_type_t = rocprim::tuple<unsigned int, AccumulatorType>;
+// The segment head count is OffsetType, it is 64-bit only if the input has more than 2^32 - 1 items
+template<typename AccumulatorType, typename OffsetType>
+using wrapped_type_t = rocprim::tuple<OffsetType, AccumulatorType>;
 
-template<typename AccumulatorType, bool UseSleep = false>
+template<typename AccumulatorType, typename OffsetType, bool UseSleep = false>
 using lookback_scan_state_t
-    = detail::lookback_scan_state<wrapped_type_t<AccumulatorType>, UseSleep>;
+    = detail::lookback_scan_state<wrapped_type_t<AccumulatorType, OffsetType>, UseSleep>;
 
 template<typename KeyType,
          typename AccumulatorType,
@@ -188,6 +189,7 @@ struct scatter_helper
 
 template<typename KeyType,
          typename AccumulatorType,
+         typename OffsetType,
          unsigned int         BlockSize,
          unsigned int         ItemsPerThread,
          block_load_method    load_keys_method,
@@ -203,7 +205,7 @@ private:
                                                  load_keys_method,
                                                  load_values_method>;
 
-    using wrapped_type = reduce_by_key::wrapped_type_t<AccumulatorType>;
+    using wrapped_type = reduce_by_key::wrapped_type_t<AccumulatorType, OffsetType>;
 
     using discontinuity_type = reduce_by_key::discontinuity_helper<KeyType, BlockSize>;
     using block_scan_type    = rocprim::block_scan<wrapped_type, BlockSize, scan_algorithm>;
@@ -244,13 +246,10 @@ public:
                      BinaryOp                     reduce_op,
                      const CompareFunction        compare,
                      LookbackScanState            scan_state,
-                     const unsigned int           tile_id,
-                     const std::size_t            starting_tile,
-                     const std::size_t            total_number_of_tiles,
+                     const std::size_t            tile_id,
+                     const std::size_t            number_of_tiles,
                      const std::size_t            size,
-                     storage_type&                storage,
-                     const std::size_t* const     global_head_count,
-                     const AccumulatorType* const previous_accumulated)
+                     storage_type&                storage)
     {
 
         static constexpr unsigned int items_per_tile = BlockSize * ItemsPerThread;
@@ -263,15 +262,11 @@ public:
                                     : rocprim::get<1>(rhs)};
         };
 
-        const std::size_t global_tile_id = starting_tile + tile_id;
-        // first and last tiles across all launches
-        const bool is_global_first_tile = global_tile_id == 0;
-        const bool is_global_last_tile  = global_tile_id == total_number_of_tiles - 1;
-        // first tile in this launch
-        const bool is_first_tile = tile_id == 0;
+        const bool is_global_first_tile = tile_id == 0;
+        const bool is_global_last_tile  = tile_id == number_of_tiles - 1;
 
         const unsigned int valid_in_global_last_tile
-            = static_cast<unsigned int>(size - ((total_number_of_tiles - 1) * items_per_tile));
+            = static_cast<unsigned int>(size - ((number_of_tiles - 1) * items_per_tile));
 
         const unsigned int flat_thread_id = threadIdx.x;
 
@@ -302,21 +297,14 @@ public:
             rocprim::get<1>(wrapped_values[i]) = values[i];
         }
 
-        unsigned int segment_heads_before   = 0;
-        unsigned int segment_heads_in_block = 0;
+        OffsetType   segment_heads_before   = 0;
+        OffsetType   segment_heads_in_block = 0;
         wrapped_type reduction;
 
-        // This branch is taken for the first tile in each launch when
-        // multiple launches occur due to large indices
-        if(is_first_tile)
+        if(is_global_first_tile)
         {
-            wrapped_type initial_value = ::rocprim::make_tuple(0u, values[0] /* dummy value */);
-
-            // previous_accumulated is used to pass the accumulated value from the previous launch
-            if(previous_accumulated != nullptr)
-            {
-                initial_value = ::rocprim::make_tuple(0u, *previous_accumulated);
-            }
+            const wrapped_type initial_value
+                = ::rocprim::make_tuple(OffsetType{0}, values[0] /* dummy value */);
 
             block_scan_type{}.exclusive_scan(wrapped_values,
                                              wrapped_values,
@@ -360,19 +348,19 @@ public:
         }
         rocprim::syncthreads();
 
-        const std::size_t segment_heads_in_previous_launches
-            = global_head_count != nullptr ? *global_head_count : 0u;
-
         // At this point each item that is flagged as segment head has
         // - The first key of the segment
         // - The number of segments before it (exclusive scan of head_flags)
         // - The reduction of the previous segment
         scatter_keys_type{}.scatter(
-            unique_keys + segment_heads_in_previous_launches + segment_heads_before,
+            unique_keys + segment_heads_before,
             [&keys](unsigned int i) { return keys[i]; },
             head_flags,
             [&](const unsigned int i)
-            { return rocprim::get<0>(wrapped_values[i]) - segment_heads_before; },
+            {
+                return static_cast<unsigned int>(rocprim::get<0>(wrapped_values[i])
+                                                 - segment_heads_before);
+            },
             segment_heads_in_block,
             flat_thread_id,
             storage.scatter_keys);
@@ -381,7 +369,7 @@ public:
         // The first item in the global first tile does not have a reduction
         // The first out of bounds item in the global last tile has the reduction for the last segment
         const unsigned int reductions_in_block
-            = segment_heads_in_block - (is_global_first_tile ? 1 : 0)
+            = static_cast<unsigned int>(segment_heads_in_block) - (is_global_first_tile ? 1 : 0)
               + (is_global_last_tile && valid_in_global_last_tile != items_per_tile ? 1 : 0);
 
         if(is_global_first_tile && flat_thread_id == 0)
@@ -393,20 +381,20 @@ public:
             head_flags[valid_in_global_last_tile - flat_thread_id * ItemsPerThread] = 1;
         }
         scatter_values_type{}.scatter(
-            reductions + segment_heads_in_previous_launches + segment_heads_before
-                - (!is_global_first_tile ? 1 : 0),
+            reductions + segment_heads_before - (!is_global_first_tile ? 1 : 0),
             [&wrapped_values](unsigned int i) { return rocprim::get<1>(wrapped_values[i]); },
             head_flags,
             [&, offset = segment_heads_before + (is_global_first_tile ? 1 : 0)](
-                const unsigned int i) { return rocprim::get<0>(wrapped_values[i]) - offset; },
+                const unsigned int i)
+            { return static_cast<unsigned int>(rocprim::get<0>(wrapped_values[i]) - offset); },
             reductions_in_block,
             flat_thread_id,
             storage.scatter_values);
 
         if(is_global_last_tile && flat_thread_id == BlockSize - 1)
         {
-            const std::size_t total_segment_heads = segment_heads_in_previous_launches
-                                                    + segment_heads_before + segment_heads_in_block;
+            const std::size_t total_segment_heads
+                = static_cast<std::size_t>(segment_heads_before) + segment_heads_in_block;
             *unique_count = total_segment_heads;
             if(valid_in_global_last_tile == items_per_tile)
             {
@@ -418,6 +406,7 @@ public:
 
 template<typename Config,
          typename AccumulatorType,
+         typename OffsetType,
          typename KeyIterator,
          typename ValueIterator,
          typename UniqueIterator,
@@ -427,25 +416,20 @@ template<typename Config,
          typename BinaryOp,
          typename LookbackScanState>
 ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
-    kernel_impl(KeyIterator                    keys_input,
-                ValueIterator                  values_input,
-                const UniqueIterator           unique_keys,
-                const ReductionIterator        reductions,
-                const UniqueCountIterator      unique_count,
-                const BinaryOp                 reduce_op,
-                const CompareFunction          compare,
-                const LookbackScanState        scan_state,
-                ordered_block_id<unsigned int> ordered_tile_id,
-                const std::size_t              starting_tile,
-                const std::size_t              total_number_of_tiles,
-                const std::size_t              size,
-                const std::size_t* const       global_head_count,
-                const AccumulatorType* const   previous_accumulated,
-                const std::size_t              number_of_tiles_launch)
+    kernel_impl(KeyIterator                             keys_input,
+                ValueIterator                           values_input,
+                const UniqueIterator                    unique_keys,
+                const ReductionIterator                 reductions,
+                const UniqueCountIterator               unique_count,
+                const BinaryOp                          reduce_op,
+                const CompareFunction                   compare,
+                const LookbackScanState                 scan_state,
+                ordered_block_id<lookback_tile_id_type> ordered_tile_id,
+                const std::size_t                       number_of_tiles,
+                const std::size_t                       size)
 {
     static constexpr unsigned int         block_size         = Config::block_size;
     static constexpr unsigned int         items_per_thread   = Config::items_per_thread;
-    static constexpr unsigned int         tiles_per_block    = Config::tiles_per_block;
     static constexpr block_load_method    load_keys_method   = Config::load_keys_method;
     static constexpr block_load_method    load_values_method = Config::load_values_method;
     static constexpr block_scan_algorithm scan_algorithm     = Config::scan_algorithm;
@@ -455,6 +439,7 @@ ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
 
     using tile_processor = tile_helper<key_type,
                                        AccumulatorType,
+                                       OffsetType,
                                        block_size,
                                        items_per_thread,
                                        load_keys_method,
@@ -467,11 +452,13 @@ ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
         typename tile_processor::storage_type            tile;
     } storage;
 
-    for(unsigned int i = 0; i < tiles_per_block; ++i)
+    // Blocks take tiles until all tiles are processed. The grid is sized for Config::tiles_per_block
+    // tiles per block, but it is smaller if that would exceed Config::size_limit items.
+    while(true)
     {
         rocprim::syncthreads();
         const std::size_t tile_id = ordered_tile_id.get(threadIdx.x, storage.tile_id);
-        if(tile_id >= number_of_tiles_launch)
+        if(tile_id >= number_of_tiles)
         {
             return;
         }
@@ -490,12 +477,9 @@ ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
                                       compare,
                                       scan_state,
                                       tile_id,
-                                      starting_tile,
-                                      total_number_of_tiles,
+                                      number_of_tiles,
                                       size,
-                                      storage.tile,
-                                      global_head_count,
-                                      previous_accumulated);
+                                      storage.tile);
     }
 }
 
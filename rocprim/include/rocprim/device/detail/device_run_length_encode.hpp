@@ -0,0 +1,371 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_RUN_LENGTH_ENCODE_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_RUN_LENGTH_ENCODE_HPP_
+
+#include "device_reduce_by_key.hpp"
+#include "lookback_scan_state.hpp"
+#include "ordered_block_id.hpp"
+
+#include "../../block/block_discontinuity.hpp"
+#include "../../block/block_load.hpp"
+#include "../../block/block_scan.hpp"
+#include "../../detail/various.hpp"
+#include "../../intrinsics/thread.hpp"
+#include "../../types/tuple.hpp"
+
+#include "../../config.hpp"
+
+#include <iterator>
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+namespace run_length_encode
+{
+
+// The scanned value of each item is the number of non-trivial run heads up to the item and
+// the offset of the last run head (trivial or not) up to the item. Offsets only grow, so
+// the latter is scanned with max.
+using non_trivial_runs_scan_type = ::rocprim::tuple<unsigned int, unsigned int>;
+
+template<bool UseSleep = false>
+using non_trivial_runs_scan_state_t
+    = detail::lookback_scan_state<non_trivial_runs_scan_type, UseSleep>;
+
+struct non_trivial_runs_scan_op
+{
+    ROCPRIM_DEVICE ROCPRIM_INLINE non_trivial_runs_scan_type
+        operator()(const non_trivial_runs_scan_type& lhs,
+                   const non_trivial_runs_scan_type& rhs) const
+    {
+        return non_trivial_runs_scan_type{
+            ::rocprim::get<0>(lhs) + ::rocprim::get<0>(rhs),
+            ::rocprim::max(::rocprim::get<1>(lhs), ::rocprim::get<1>(rhs))};
+    }
+};
+
+template<typename KeyType,
+         unsigned int         BlockSize,
+         unsigned int         ItemsPerThread,
+         block_load_method    load_keys_method,
+         block_scan_algorithm scan_algorithm>
+class non_trivial_runs_tile_helper
+{
+private:
+    using scan_type = non_trivial_runs_scan_type;
+
+    using block_load_type          = block_load<KeyType, BlockSize, ItemsPerThread, load_keys_method>;
+    using block_discontinuity_type = block_discontinuity<KeyType, BlockSize>;
+    using block_scan_type          = block_scan<scan_type, BlockSize, scan_algorithm>;
+    using prefix_op_factory        = detail::offset_lookback_scan_factory<scan_type>;
+
+    using scatter_type = reduce_by_key::scatter_helper<unsigned int, BlockSize, ItemsPerThread>;
+
+public:
+    struct storage_type
+    {
+        union
+        {
+            typename block_load_type::storage_type load;
+            struct
+            {
+                typename block_discontinuity_type::storage_type flags;
+                typename prefix_op_factory::storage_type        prefix;
+                typename block_scan_type::storage_type          scan;
+            } scan;
+            typename scatter_type::storage_type scatter;
+        };
+        // Whether a non-trivial run continues from the previous tile / into the next tile
+        bool open_at_start;
+        bool open_at_end;
+    };
+
+    template<typename KeyIterator,
+             typename OffsetsOutputIterator,
+             typename CountsOutputIterator,
+             typename RunsCountOutputIterator,
+             typename CompareFunction,
+             typename LookbackScanState>
+    ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
+        process_tile(const KeyIterator       tile_keys,
+                     OffsetsOutputIterator   offsets_output,
+                     CountsOutputIterator    counts_output,
+                     RunsCountOutputIterator runs_count_output,
+                     const CompareFunction   compare,
+                     LookbackScanState       scan_state,
+                     const unsigned int      tile_id,
+                     const unsigned int      number_of_tiles,
+                     const unsigned int      size,
+                     storage_type&           storage)
+    {
+        static constexpr unsigned int items_per_tile = BlockSize * ItemsPerThread;
+
+        const bool is_first_tile = tile_id == 0;
+        const bool is_last_tile  = tile_id == number_of_tiles - 1;
+
+        const unsigned int tile_offset    = tile_id * items_per_tile;
+        const unsigned int valid_in_tile  = is_last_tile ? size - tile_offset : items_per_tile;
+        const unsigned int flat_thread_id = threadIdx.x;
+
+        KeyType keys[ItemsPerThread];
+        if(!is_last_tile)
+        {
+            block_load_type{}.load(tile_keys, keys, storage.load);
+        }
+        else
+        {
+            // Pad with the last valid key so out-of-bound items do not start runs
+            block_load_type{}.load(tile_keys,
+                                   keys,
+                                   valid_in_tile,
+                                   tile_keys[valid_in_tile - 1],
+                                   storage.load);
+        }
+        ::rocprim::syncthreads();
+
+        auto not_equal = [compare](const KeyType& a, const KeyType& b) mutable
+        { return !compare(a, b); };
+
+        unsigned int head_flags[ItemsPerThread];
+        unsigned int tail_flags[ItemsPerThread];
+        if(!is_first_tile && !is_last_tile)
+        {
+            block_discontinuity_type{}.flag_heads_and_tails(head_flags,
+                                                            tile_keys[-1],
+                                                            tail_flags,
+                                                            tile_keys[items_per_tile],
+                                                            keys,
+                                                            not_equal,
+                                                            storage.scan.flags);
+        }
+        else if(!is_first_tile)
+        {
+            block_discontinuity_type{}.flag_heads_and_tails(head_flags,
+                                                            tile_keys[-1],
+                                                            tail_flags,
+                                                            keys,
+                                                            not_equal,
+                                                            storage.scan.flags);
+        }
+        else if(!is_last_tile)
+        {
+            block_discontinuity_type{}.flag_heads_and_tails(head_flags,
+                                                            tail_flags,
+                                                            tile_keys[items_per_tile],
+                                                            keys,
+                                                            not_equal,
+                                                            storage.scan.flags);
+        }
+        else
+        {
+            block_discontinuity_type{}.flag_heads_and_tails(head_flags,
+                                                            tail_flags,
+                                                            keys,
+                                                            not_equal,
+                                                            storage.scan.flags);
+        }
+
+        scan_type values[ItemsPerThread];
+        for(unsigned int i = 0; i < ItemsPerThread; ++i)
+        {
+            const unsigned int index = flat_thread_id * ItemsPerThread + i;
+            if(is_last_tile && index >= valid_in_tile)
+            {
+                head_flags[i] = 0;
+                tail_flags[i] = 0;
+            }
+            else if(is_last_tile && index == valid_in_tile - 1)
+            {
+                tail_flags[i] = 1;
+            }
+            rocprim::get<0>(values[i]) = head_flags[i] && !tail_flags[i] ? 1 : 0;
+            rocprim::get<1>(values[i]) = head_flags[i] ? tile_offset + index : 0;
+        }
+
+        if(flat_thread_id == 0)
+        {
+            // The first item continues a run that started in a previous tile, this run
+            // has at least two items.
+            storage.open_at_start = !is_first_tile && !head_flags[0];
+        }
+        if(flat_thread_id == BlockSize - 1)
+        {
+            storage.open_at_end = !is_last_tile && !tail_flags[ItemsPerThread - 1];
+        }
+
+        unsigned int heads_before  = 0;
+        unsigned int heads_in_tile = 0;
+        if(is_first_tile)
+        {
+            scan_type reduction;
+            block_scan_type{}.exclusive_scan(values,
+                                             values,
+                                             scan_type{0, 0},
+                                             reduction,
+                                             storage.scan.scan,
+                                             non_trivial_runs_scan_op{});
+            if(flat_thread_id == 0)
+            {
+                scan_state.set_complete(0, reduction);
+            }
+            heads_in_tile = rocprim::get<0>(reduction);
+        }
+        else
+        {
+            auto lookback_op
+                = detail::lookback_scan_prefix_op<scan_type,
+                                                  non_trivial_runs_scan_op,
+                                                  LookbackScanState>{tile_id,
+                                                                     non_trivial_runs_scan_op{},
+                                                                     scan_state};
+            auto offset_lookback_op = prefix_op_factory::create(lookback_op, storage.scan.prefix);
+
+            block_scan_type{}.exclusive_scan(values,
+                                             values,
+                                             storage.scan.scan,
+                                             offset_lookback_op,
+                                             non_trivial_runs_scan_op{});
+            ::rocprim::syncthreads();
+
+            heads_before  = rocprim::get<0>(prefix_op_factory::get_prefix(storage.scan.prefix));
+            heads_in_tile = rocprim::get<0>(prefix_op_factory::get_reduction(storage.scan.prefix));
+        }
+        ::rocprim::syncthreads();
+
+        const unsigned int open_at_start = storage.open_at_start ? 1 : 0;
+        const unsigned int open_at_end   = storage.open_at_end ? 1 : 0;
+
+        // At this point the exclusive scan of each item holds the number of non-trivial runs
+        // that start before it and the offset of the last run head before it.
+        bool is_non_trivial_head[ItemsPerThread];
+        bool is_non_trivial_tail[ItemsPerThread];
+        for(unsigned int i = 0; i < ItemsPerThread; ++i)
+        {
+            is_non_trivial_head[i] = head_flags[i] && !tail_flags[i];
+            is_non_trivial_tail[i] = tail_flags[i] && !head_flags[i];
+        }
+
+        scatter_type{}.scatter(
+            offsets_output + heads_before,
+            [&](const unsigned int i) { return tile_offset + flat_thread_id * ItemsPerThread + i; },
+            is_non_trivial_head,
+            [&](const unsigned int i) { return rocprim::get<0>(values[i]) - heads_before; },
+            heads_in_tile,
+            flat_thread_id,
+            storage.scatter);
+        ::rocprim::syncthreads();
+
+        // The tail of the run that is open at the start of the tile is the first tail in the tile,
+        // its head is counted in heads_before.
+        const unsigned int tails_before  = heads_before - open_at_start;
+        const unsigned int tails_in_tile = heads_in_tile + open_at_start - open_at_end;
+        scatter_type{}.scatter(
+            counts_output + tails_before,
+            [&](const unsigned int i)
+            {
+                return tile_offset + flat_thread_id * ItemsPerThread + i
+                       - rocprim::get<1>(values[i]) + 1;
+            },
+            is_non_trivial_tail,
+            [&](const unsigned int i) { return rocprim::get<0>(values[i]) - 1 - tails_before; },
+            tails_in_tile,
+            flat_thread_id,
+            storage.scatter);
+
+        if(is_last_tile && flat_thread_id == 0)
+        {
+            *runs_count_output = heads_before + heads_in_tile;
+        }
+    }
+};
+
+template<typename Config,
+         typename KeyIterator,
+         typename OffsetsOutputIterator,
+         typename CountsOutputIterator,
+         typename RunsCountOutputIterator,
+         typename CompareFunction,
+         typename LookbackScanState>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE void
+    non_trivial_runs_kernel_impl(const KeyIterator              keys_input,
+                                 const OffsetsOutputIterator    offsets_output,
+                                 const CountsOutputIterator     counts_output,
+                                 const RunsCountOutputIterator  runs_count_output,
+                                 const CompareFunction          compare,
+                                 const LookbackScanState        scan_state,
+                                 ordered_block_id<unsigned int> ordered_tile_id,
+                                 const unsigned int             number_of_tiles,
+                                 const unsigned int             size)
+{
+    static constexpr unsigned int         block_size       = Config::block_size;
+    static constexpr unsigned int         items_per_thread = Config::items_per_thread;
+    static constexpr unsigned int         tiles_per_block  = Config::tiles_per_block;
+    static constexpr block_load_method    load_keys_method = Config::load_keys_method;
+    static constexpr block_scan_algorithm scan_algorithm   = Config::scan_algorithm;
+    static constexpr unsigned int         items_per_tile   = block_size * items_per_thread;
+
+    using key_type = typename std::iterator_traits<KeyIterator>::value_type;
+
+    using tile_processor = non_trivial_runs_tile_helper<key_type,
+                                                        block_size,
+                                                        items_per_thread,
+                                                        load_keys_method,
+                                                        scan_algorithm>;
+
+    ROCPRIM_SHARED_MEMORY union
+    {
+        typename decltype(ordered_tile_id)::storage_type tile_id;
+        typename tile_processor::storage_type            tile;
+    } storage;
+
+    for(unsigned int i = 0; i < tiles_per_block; ++i)
+    {
+        ::rocprim::syncthreads();
+        const unsigned int tile_id = ordered_tile_id.get(threadIdx.x, storage.tile_id);
+        if(tile_id >= number_of_tiles)
+        {
+            return;
+        }
+
+        ::rocprim::syncthreads();
+        tile_processor{}.process_tile(keys_input + tile_id * items_per_tile,
+                                      offsets_output,
+                                      counts_output,
+                                      runs_count_output,
+                                      compare,
+                                      scan_state,
+                                      tile_id,
+                                      number_of_tiles,
+                                      size,
+                                      storage.tile);
+    }
+}
+
+} // namespace run_length_encode
+
+} // namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_RUN_LENGTH_ENCODE_HPP_
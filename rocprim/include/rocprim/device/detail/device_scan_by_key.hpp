@@ -78,16 +78,15 @@ namespace detail
                  ValueIterator      values_input,
                  CompareFunction    compare,
                  const result_type  initial_value,
-                 const unsigned int flat_block_id,
-                 const size_t       starting_block,
-                 const size_t       number_of_blocks,
+                 const size_t       tile_id,
+                 const size_t       number_of_tiles,
                  const unsigned int flat_thread_id,
                  const size_t       size,
                  rocprim::tuple<result_type, bool> (&wrapped_values)[items_per_thread],
                  storage_type& storage)
         {
             constexpr static unsigned int items_per_block = items_per_thread * block_size;
-            const unsigned int            block_offset    = flat_block_id * items_per_block;
+            const size_t                  block_offset    = tile_id * items_per_block;
             KeyIterator                   block_keys      = keys_input + block_offset;
             ValueIterator                 block_values    = values_input + block_offset;
 
@@ -102,7 +101,7 @@ namespace detail
                 if(Exclusive)
                 {
                     const key_type tile_successor
-                        = starting_block + flat_block_id < number_of_blocks - 1
+                        = tile_id < number_of_tiles - 1
                               ? block_keys[items_per_block]
                               : *block_keys;
                     block_discontinuity {}.flag_tails(
@@ -110,7 +109,7 @@ namespace detail
                 }
                 else
                 {
-                    const key_type tile_predecessor = starting_block + flat_block_id > 0
+                    const key_type tile_predecessor = tile_id > 0
                                                           ? block_keys[-1]
                                                           : *block_keys;
                     block_discontinuity {}.flag_heads(
@@ -118,7 +117,7 @@ namespace detail
                 }
             };
 
-            if(starting_block + flat_block_id < number_of_blocks - 1)
+            if(tile_id < number_of_tiles - 1)
             {
                 block_load_keys{}.load(
                     block_keys,
@@ -146,7 +145,7 @@ namespace detail
             else
             {
                 const unsigned int valid_in_last_block
-                    = static_cast<unsigned int>(size - items_per_block * (number_of_blocks - 1));
+                    = static_cast<unsigned int>(size - items_per_block * (number_of_tiles - 1));
 
                 block_load_keys {}.load(
                     block_keys,
@@ -194,21 +193,20 @@ namespace detail
         template <typename OutputIterator>
         ROCPRIM_DEVICE void
             store(OutputIterator     output,
-                  const unsigned int flat_block_id,
-                  const size_t       starting_block,
-                  const size_t       number_of_blocks,
+                  const size_t       tile_id,
+                  const size_t       number_of_tiles,
                   const unsigned int flat_thread_id,
                   const size_t       size,
                   const rocprim::tuple<result_type, bool> (&wrapped_values)[items_per_thread],
                   storage_type& storage)
         {
             constexpr static unsigned int items_per_block = items_per_thread * block_size;
-            const unsigned int block_offset = flat_block_id * items_per_block;
+            const size_t block_offset = tile_id * items_per_block;
             OutputIterator block_output = output + block_offset;
 
             result_type thread_values[items_per_thread];
 
-            if(starting_block + flat_block_id < number_of_blocks - 1)
+            if(tile_id < number_of_tiles - 1)
             {
                 ROCPRIM_UNROLL
                 for(unsigned int i = 0; i < items_per_thread; ++i) {
@@ -223,7 +221,7 @@ namespace detail
             else
             {
                 const unsigned int valid_in_last_block
-                    = static_cast<unsigned int>(size - items_per_block * (number_of_blocks - 1));
+                    = static_cast<unsigned int>(size - items_per_block * (number_of_tiles - 1));
 
                 ROCPRIM_UNROLL
                 for(unsigned int i = 0; i < items_per_thread; ++i) {
@@ -261,10 +259,8 @@ namespace detail
         const BinaryFunction                          scan_op,
         LookbackScanState                             scan_state,
         const size_t                                  size,
-        const size_t                                  starting_block,
-        const size_t                                  number_of_blocks,
-        ordered_block_id<unsigned int>                ordered_bid,
-        const rocprim::tuple<ResultType, bool>* const previous_last_value)
+        const size_t                                  number_of_tiles,
+        ordered_block_id<lookback_tile_id_type>       ordered_tile_id)
     {
         using result_type = ResultType;
         static_assert(std::is_same<rocprim::tuple<ResultType, bool>,
@@ -294,92 +290,94 @@ namespace detail
         constexpr auto store_method = Config::block_store_method;
         using store_unwrap = unwrap_store<block_size, items_per_thread, result_type, store_method>;
 
-        using order_bid_type = ordered_block_id<unsigned int>;
+        using order_tile_id_type = ordered_block_id<lookback_tile_id_type>;
 
         ROCPRIM_SHARED_MEMORY union
         {
             struct
             {
-                typename load_flagged::storage_type   load;
-                typename order_bid_type::storage_type ordered_bid;
+                typename load_flagged::storage_type       load;
+                typename order_tile_id_type::storage_type ordered_tile_id;
             };
             typename block_scan_type::storage_type scan;
             typename store_unwrap::storage_type    store;
         } storage;
 
         const auto flat_thread_id = ::rocprim::detail::block_thread_id<0>();
-        const auto flat_block_id = ordered_bid.get(flat_thread_id, storage.ordered_bid);
-
-        // Load input
-        wrapped_type wrapped_values[items_per_thread];
-        load_flagged {}.load(keys,
-                             values,
-                             compare,
-                             initial_value,
-                             flat_block_id,
-                             starting_block,
-                             number_of_blocks,
-                             flat_thread_id,
-                             size,
-                             wrapped_values,
-                             storage.load);
-
-        // Reusing the storage from load to perform the scan
-        ::rocprim::syncthreads();
-
-        // Perform look back scan scan
-        if(flat_block_id == 0)
-        {
-            auto wrapped_initial_value = rocprim::make_tuple(initial_value, false);
+        // If the grid is smaller than the number of tiles, blocks continue with the next tile
+        // that is not taken yet
+        const bool is_grid_persistent = number_of_tiles > ::rocprim::detail::grid_size<0>();
 
-            // previous_last_value is used to pass the value from the previous grid, if this is a
-            // multi grid launch
-            if(previous_last_value != nullptr)
+        for(size_t tile_id = ordered_tile_id.get(flat_thread_id, storage.ordered_tile_id);
+            tile_id < number_of_tiles;
+            tile_id = ordered_tile_id.get(flat_thread_id, storage.ordered_tile_id))
+        {
+            // Load input
+            wrapped_type wrapped_values[items_per_thread];
+            load_flagged {}.load(keys,
+                                 values,
+                                 compare,
+                                 initial_value,
+                                 tile_id,
+                                 number_of_tiles,
+                                 flat_thread_id,
+                                 size,
+                                 wrapped_values,
+                                 storage.load);
+
+            // Reusing the storage from load to perform the scan
+            ::rocprim::syncthreads();
+
+            // Perform look back scan scan
+            if(tile_id == 0)
             {
-                if(Exclusive) {
-                    rocprim::get<0>(wrapped_initial_value) = rocprim::get<0>(*previous_last_value);
-                } else if (flat_thread_id == 0) {
-                    wrapped_values[0] = wrapped_op(*previous_last_value, wrapped_values[0]);
+                auto wrapped_initial_value = rocprim::make_tuple(initial_value, false);
+
+                wrapped_type reduction;
+                lookback_block_scan<Exclusive, block_scan_type>(wrapped_values,
+                                                                wrapped_initial_value,
+                                                                reduction,
+                                                                storage.scan,
+                                                                wrapped_op);
+
+                if(flat_thread_id == 0)
+                {
+                    scan_state.set_complete(tile_id, reduction);
                 }
             }
+            else
+            {
+                auto prefix_op = lookback_scan_prefix_op<wrapped_type,
+                                                         decltype(wrapped_op),
+                                                         decltype(scan_state)> {
+                    tile_id, wrapped_op, scan_state};
+
+                // Scan of block values
+                lookback_block_scan<Exclusive, block_scan_type>(
+                    wrapped_values,
+                    storage.scan,
+                    prefix_op,
+                    wrapped_op);
+            }
 
-            wrapped_type reduction;
-            lookback_block_scan<Exclusive, block_scan_type>(wrapped_values,
-                                                            wrapped_initial_value,
-                                                            reduction,
-                                                            storage.scan,
-                                                            wrapped_op);
-
-            if(flat_thread_id == 0)
+            // Store output
+            // synchronization is inside the function after unwrapping
+            store_unwrap {}.store(output,
+                                  tile_id,
+                                  number_of_tiles,
+                                  flat_thread_id,
+                                  size,
+                                  wrapped_values,
+                                  storage.store);
+
+            if(!is_grid_persistent)
             {
-                scan_state.set_complete(flat_block_id, reduction);
+                // Every tile was taken by a block of the grid
+                break;
             }
+            // Reusing the storage from store to load the next tile
+            ::rocprim::syncthreads();
         }
-        else
-        {
-            auto prefix_op = lookback_scan_prefix_op<wrapped_type,
-                                                     decltype(wrapped_op),
-                                                     decltype(scan_state)> {
-                flat_block_id, wrapped_op, scan_state};
-
-            // Scan of block values
-            lookback_block_scan<Exclusive, block_scan_type>(
-                wrapped_values,
-                storage.scan,
-                prefix_op,
-                wrapped_op);
-        }
-
-        // Store output
-        // synchronization is inside the function after unwrapping
-        store_unwrap {}.store(output,
-                              flat_block_id,
-                              starting_block,
-                              number_of_blocks,
-                              flat_thread_id,
-                              size,
-                              wrapped_values,
-                              storage.store);
     }
 } // namespace detail
 
@@ -22,6 +22,8 @@
 #define ROCPRIM_DEVICE_SCAN_COMMON_HPP_
 
 #include "../../config.hpp"
+#include "../../detail/various.hpp"
+#include "../../functional.hpp"
 #include "../../intrinsics/thread.hpp"
 
 #include "lookback_scan_state.hpp"
@@ -29,37 +31,30 @@
 
 #include <hip/hip_runtime.h>
 
+#include <algorithm>
+
 BEGIN_ROCPRIM_NAMESPACE
 
 namespace detail
 {
 
-template<typename LookBackScanState, typename AccessFunction>
-ROCPRIM_DEVICE ROCPRIM_INLINE void
-    access_indexed_lookback_value(LookBackScanState  lookback_scan_state,
-                                  const unsigned int number_of_blocks,
-                                  unsigned int       save_index,
-                                  unsigned int       flat_thread_id,
-                                  AccessFunction     access_function)
+// Returns the number of blocks of a look-back kernel processing number_of_tiles tiles of
+// items_per_tile items. The blocks cover at most size_limit items at once and take the remaining
+// tiles after finishing their current one, so any number of tiles is processed by one launch.
+inline unsigned int lookback_grid_size(const size_t       number_of_tiles,
+                                       const unsigned int items_per_tile,
+                                       const size_t       size_limit)
 {
-    // If the thread that resets the reduction of save_index in init_lookback_scan_state is
-    // participating, this thread saves the value. Otherwise, the first thread saves it
-    // (it will not be reset by any thread in init_lookback_scan_state).
-    if((number_of_blocks <= save_index && flat_thread_id == 0) || flat_thread_id == save_index)
-    {
-        typename LookBackScanState::value_type value;
-        typename LookBackScanState::flag_type  dummy_flag;
-        lookback_scan_state.get(save_index, dummy_flag, value);
-        access_function(value);
-    }
+    const size_t max_grid_size = ::rocprim::max<size_t>(size_limit / items_per_tile, 1);
+    return static_cast<unsigned int>(std::min(number_of_tiles, max_grid_size));
 }
 
-template<typename LookBackScanState>
+template<typename LookBackScanState, typename BlockIdType>
 ROCPRIM_DEVICE ROCPRIM_INLINE void
-    init_lookback_scan_state(LookBackScanState              lookback_scan_state,
-                             const unsigned int             number_of_blocks,
-                             ordered_block_id<unsigned int> ordered_bid,
-                             unsigned int                   flat_thread_id)
+    init_lookback_scan_state(LookBackScanState             lookback_scan_state,
+                             const size_t                  number_of_blocks,
+                             ordered_block_id<BlockIdType> ordered_bid,
+                             const size_t                  flat_thread_id)
 {
     // Reset ordered_block_id.
     if(flat_thread_id == 0)
@@ -71,30 +66,17 @@ ROCPRIM_DEVICE ROCPRIM_INLINE void
     lookback_scan_state.initialize_prefix(flat_thread_id, number_of_blocks);
 }
 
-template<typename LookBackScanState>
+template<typename LookBackScanState, typename BlockIdType>
 ROCPRIM_KERNEL
     __launch_bounds__(ROCPRIM_DEFAULT_MAX_BLOCK_SIZE) void init_lookback_scan_state_kernel(
-        LookBackScanState                             lookback_scan_state,
-        const unsigned int                            number_of_blocks,
-        ordered_block_id<unsigned int>                ordered_bid,
-        unsigned int                                  save_index = 0,
-        typename LookBackScanState::value_type* const save_dest  = nullptr)
+        LookBackScanState             lookback_scan_state,
+        const size_t                  number_of_blocks,
+        ordered_block_id<BlockIdType> ordered_bid)
 {
-    const unsigned int block_id        = ::rocprim::detail::block_id<0>();
-    const unsigned int block_size      = ::rocprim::detail::block_size<0>();
-    const unsigned int block_thread_id = ::rocprim::detail::block_thread_id<0>();
-    const unsigned int flat_thread_id  = (block_id * block_size) + block_thread_id;
-
-    // Save the reduction (i.e. the last prefix) from the previous user of lookback_scan_state.
-    if(save_dest != nullptr)
-    {
-        access_indexed_lookback_value(lookback_scan_state,
-                                      number_of_blocks,
-                                      save_index,
-                                      flat_thread_id,
-                                      [&](typename LookBackScanState::value_type value)
-                                      { *save_dest = value; });
-    }
+    const size_t block_id        = ::rocprim::detail::block_id<0>();
+    const size_t block_size      = ::rocprim::detail::block_size<0>();
+    const size_t block_thread_id = ::rocprim::detail::block_thread_id<0>();
+    const size_t flat_thread_id  = (block_id * block_size) + block_thread_id;
 
     init_lookback_scan_state(lookback_scan_state, number_of_blocks, ordered_bid, flat_thread_id);
 }
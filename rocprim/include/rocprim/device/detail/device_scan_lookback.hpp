@@ -62,12 +62,8 @@ void lookback_scan_kernel_impl(InputIterator input,
                                ResultType initial_value,
                                BinaryFunction scan_op,
                                LookbackScanState scan_state,
-                               const unsigned int number_of_blocks,
-                               ordered_block_id<unsigned int> ordered_bid,
-                               ResultType * previous_last_element = nullptr,
-                               ResultType * new_last_element = nullptr,
-                               bool override_first_value = false,
-                               bool save_last_value = false)
+                               const size_t number_of_tiles,
+                               ordered_block_id<lookback_tile_id_type> ordered_tile_id)
 {
     using result_type = ResultType;
     static_assert(
@@ -92,14 +88,14 @@ void lookback_scan_kernel_impl(InputIterator input,
         Config::block_scan_method
     >;
 
-    using order_bid_type = ordered_block_id<unsigned int>;
+    using order_tile_id_type = ordered_block_id<lookback_tile_id_type>;
     using lookback_scan_prefix_op_type = lookback_scan_prefix_op<
         result_type, BinaryFunction, LookbackScanState
     >;
 
     ROCPRIM_SHARED_MEMORY struct
     {
-        typename order_bid_type::storage_type ordered_bid;
+        typename order_tile_id_type::storage_type ordered_tile_id;
         union
         {
             typename block_load_type::storage_type load;
@@ -109,109 +105,104 @@ void lookback_scan_kernel_impl(InputIterator input,
     } storage;
 
     const auto flat_block_thread_id = ::rocprim::detail::block_thread_id<0>();
-    const auto flat_block_id = ordered_bid.get(flat_block_thread_id, storage.ordered_bid);
-    const unsigned int block_offset = flat_block_id * items_per_block;
-    const auto valid_in_last_block = size - items_per_block * (number_of_blocks - 1);
-
-    // For input values
-    result_type values[items_per_thread];
-
-    // load input values into values
-    if(flat_block_id == (number_of_blocks - 1)) // last block
-    {
-        block_load_type()
-            .load(
-                input + block_offset,
-                values,
-                valid_in_last_block,
-                *(input + block_offset),
-                storage.load
-            );
-    }
-    else
+    const auto valid_in_last_tile
+        = static_cast<unsigned int>(size - items_per_block * (number_of_tiles - 1));
+    // If the grid is smaller than the number of tiles, blocks continue with the next tile that
+    // is not taken yet. Tiles are taken in order, so look-back only waits for tiles that are
+    // being processed by running blocks.
+    const bool is_grid_persistent = number_of_tiles > ::rocprim::detail::grid_size<0>();
+
+    for(size_t tile_id = ordered_tile_id.get(flat_block_thread_id, storage.ordered_tile_id);
+        tile_id < number_of_tiles;
+        tile_id = ordered_tile_id.get(flat_block_thread_id, storage.ordered_tile_id))
     {
-        block_load_type()
-            .load(
-                input + block_offset,
-                values,
-                storage.load
-            );
-    }
-    ::rocprim::syncthreads(); // sync threads to reuse shared memory
+        const size_t tile_offset = tile_id * items_per_block;
+        const bool is_last_tile = tile_id == (number_of_tiles - 1);
 
-    if(flat_block_id == 0)
-    {
-        // override_first_value only true when the first chunk already processed
-        // and input iterator starts from an offset.
-        if(override_first_value)
+        // For input values
+        result_type values[items_per_thread];
+
+        // load input values into values
+        if(is_last_tile)
         {
-            if(Exclusive)
-                initial_value = scan_op(previous_last_element[0], static_cast<result_type>(*(input-1)));
-            else if(flat_block_thread_id == 0)
-                values[0] = scan_op(previous_last_element[0], values[0]);
+            block_load_type()
+                .load(
+                    input + tile_offset,
+                    values,
+                    valid_in_last_tile,
+                    *(input + tile_offset),
+                    storage.load
+                );
         }
-
-        result_type reduction;
-        lookback_block_scan<Exclusive, block_scan_type>(
-            values, // input/output
-            initial_value,
-            reduction,
-            storage.scan,
-            scan_op
-        );
-
-        if(flat_block_thread_id == 0)
+        else
         {
-            scan_state.set_complete(flat_block_id, reduction);
+            block_load_type()
+                .load(
+                    input + tile_offset,
+                    values,
+                    storage.load
+                );
         }
-    }
-    else
-    {
-        // Scan of block values
-        auto prefix_op = lookback_scan_prefix_op_type(
-            flat_block_id, scan_op, scan_state
-        );
-        lookback_block_scan<Exclusive, block_scan_type>(
-            values, // input/output
-            storage.scan,
-            prefix_op,
-            scan_op
-        );
-    }
-    ::rocprim::syncthreads(); // sync threads to reuse shared memory
+        ::rocprim::syncthreads(); // sync threads to reuse shared memory
 
-    // Save values into output array
-    if(flat_block_id == (number_of_blocks - 1)) // last block
-    {
-        block_store_type()
-            .store(
-                output + block_offset,
-                values,
-                valid_in_last_block,
-                storage.store
+        if(tile_id == 0)
+        {
+            result_type reduction;
+            lookback_block_scan<Exclusive, block_scan_type>(
+                values, // input/output
+                initial_value,
+                reduction,
+                storage.scan,
+                scan_op
             );
 
-        if(save_last_value &&
-           (::rocprim::detail::block_thread_id<0>() ==
-           (valid_in_last_block - 1) / items_per_thread))
-        {
-            for(unsigned int i = 0; i < items_per_thread; i++)
+            if(flat_block_thread_id == 0)
             {
-                if(i == (valid_in_last_block - 1) % items_per_thread)
-                {
-                    new_last_element[0] = values[i];
-                }
+                scan_state.set_complete(tile_id, reduction);
             }
         }
-    }
-    else
-    {
-        block_store_type()
-            .store(
-                output + block_offset,
-                values,
-                storage.store
+        else
+        {
+            // Scan of block values
+            auto prefix_op = lookback_scan_prefix_op_type(
+                tile_id, scan_op, scan_state
+            );
+            lookback_block_scan<Exclusive, block_scan_type>(
+                values, // input/output
+                storage.scan,
+                prefix_op,
+                scan_op
             );
+        }
+        ::rocprim::syncthreads(); // sync threads to reuse shared memory
+
+        // Save values into output array
+        if(is_last_tile)
+        {
+            block_store_type()
+                .store(
+                    output + tile_offset,
+                    values,
+                    valid_in_last_tile,
+                    storage.store
+                );
+        }
+        else
+        {
+            block_store_type()
+                .store(
+                    output + tile_offset,
+                    values,
+                    storage.store
+                );
+        }
+
+        if(!is_grid_persistent)
+        {
+            // Every tile was taken by a block of the grid
+            break;
+        }
+        ::rocprim::syncthreads(); // sync threads to reuse shared memory
     }
 }
 
@@ -0,0 +1,742 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_SEGMENTED_MERGE_SORT_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_SEGMENTED_MERGE_SORT_HPP_
+
+#include <iterator>
+#include <type_traits>
+
+#include "../../config.hpp"
+#include "../../detail/merge_path.hpp"
+#include "../../detail/various.hpp"
+
+#include "../../intrinsics.hpp"
+#include "../../functional.hpp"
+#include "../../types.hpp"
+
+#include "../../warp/warp_load.hpp"
+#include "../../warp/warp_sort.hpp"
+#include "../../warp/warp_store.hpp"
+
+#include "device_merge_sort.hpp"
+#include "device_merge_sort_mergepath.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Sorts segments of up to LogicalWarpSize * ItemsPerThread items by logical warps
+template<unsigned int LogicalWarpSize, unsigned int ItemsPerThread, class Key, class Value>
+class segmented_merge_sort_warp_helper
+{
+    using key_type          = Key;
+    using value_type        = Value;
+    using stable_key_type   = ::rocprim::tuple<key_type, unsigned int>;
+    using keys_load_type    = ::rocprim::warp_load<key_type,
+                                                ItemsPerThread,
+                                                LogicalWarpSize,
+                                                ::rocprim::warp_load_method::warp_load_striped>;
+    using values_load_type  = ::rocprim::warp_load<value_type,
+                                                  ItemsPerThread,
+                                                  LogicalWarpSize,
+                                                  ::rocprim::warp_load_method::warp_load_striped>;
+    using keys_store_type   = ::rocprim::warp_store<key_type, ItemsPerThread, LogicalWarpSize>;
+    using values_store_type = ::rocprim::warp_store<value_type, ItemsPerThread, LogicalWarpSize>;
+    using sort_type         = ::rocprim::warp_sort<stable_key_type, LogicalWarpSize, value_type>;
+
+    static constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+public:
+    static constexpr unsigned int items_per_warp = LogicalWarpSize * ItemsPerThread;
+
+    union storage_type
+    {
+        typename keys_load_type::storage_type    keys_load;
+        typename values_load_type::storage_type  values_load;
+        typename keys_store_type::storage_type   keys_store;
+        typename values_store_type::storage_type values_store;
+        typename sort_type::storage_type         sort;
+    };
+
+    template<class KeysInputIterator,
+             class KeysOutputIterator,
+             class ValuesInputIterator,
+             class ValuesOutputIterator,
+             class BinaryFunction>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void sort(KeysInputIterator    keys_input,
+              KeysOutputIterator   keys_output,
+              ValuesInputIterator  values_input,
+              ValuesOutputIterator values_output,
+              const unsigned int   num_items,
+              BinaryFunction       compare_function,
+              storage_type&        storage)
+    {
+        key_type        keys[ItemsPerThread];
+        stable_key_type stable_keys[ItemsPerThread];
+        value_type      values[ItemsPerThread];
+        keys_load_type().load(keys_input, keys, num_items, storage.keys_load);
+
+        // Striped items of a warp are numbered by their positions in the segment
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
+        {
+            stable_keys[i] = ::rocprim::make_tuple(
+                keys[i],
+                ::rocprim::detail::logical_lane_id<LogicalWarpSize>() + LogicalWarpSize * i);
+        }
+
+        if ROCPRIM_IF_CONSTEXPR(with_values)
+        {
+            ::rocprim::wave_barrier();
+            values_load_type().load(values_input, values, num_items, storage.values_load);
+        }
+
+        // Out of range items are ordered after all valid items, equal keys by their positions
+        auto stable_compare_function
+            = [compare_function, num_items](const stable_key_type& a,
+                                            const stable_key_type& b) mutable -> bool
+        {
+            const bool a_oor = ::rocprim::get<1>(a) >= num_items;
+            const bool b_oor = ::rocprim::get<1>(b) >= num_items;
+            if(a_oor || b_oor)
+            {
+                return !a_oor;
+            }
+            const bool ab = compare_function(::rocprim::get<0>(a), ::rocprim::get<0>(b));
+            return ab
+                   || (!compare_function(::rocprim::get<0>(b), ::rocprim::get<0>(a))
+                       && (::rocprim::get<1>(a) < ::rocprim::get<1>(b)));
+        };
+
+        ::rocprim::wave_barrier();
+        sort_type().sort(stable_keys, values, storage.sort, stable_compare_function);
+
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < ItemsPerThread; i++)
+        {
+            keys[i] = ::rocprim::get<0>(stable_keys[i]);
+        }
+        ::rocprim::wave_barrier();
+        keys_store_type().store(keys_output, keys, num_items, storage.keys_store);
+
+        if ROCPRIM_IF_CONSTEXPR(with_values)
+        {
+            ::rocprim::wave_barrier();
+            values_store_type().store(values_output, values, num_items, storage.values_store);
+        }
+    }
+};
+
+// Sorts tiles of BlockSize * ItemsPerThread items by blocks and merges sorted runs of tiles
+template<unsigned int BlockSize, unsigned int ItemsPerThread, class Key, class Value>
+class segmented_merge_sort_block_helper
+{
+    using key_type   = Key;
+    using value_type = Value;
+
+    static constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+    using load_keys_type = block_load_keys_impl<BlockSize, ItemsPerThread, key_type>;
+    using sort_type      = block_sort_impl<BlockSize, ItemsPerThread, key_type>;
+    using load_values_type
+        = block_load_values_impl<with_values, BlockSize, ItemsPerThread, value_type>;
+    using store_type
+        = block_store_impl<with_values, BlockSize, ItemsPerThread, key_type, value_type>;
+    using stable_key_type = typename sort_type::stable_key_type;
+
+public:
+    static constexpr unsigned int items_per_tile = BlockSize * ItemsPerThread;
+
+    struct storage_type
+    {
+        union
+        {
+            typename load_keys_type::storage_type   load_keys;
+            typename sort_type::storage_type        sort;
+            typename load_values_type::storage_type load_values;
+            typename store_type::storage_type       store;
+            raw_storage<key_type[items_per_tile + 1]>   keys;
+            raw_storage<value_type[items_per_tile + 1]> values;
+        };
+        unsigned int partitions[2];
+    };
+
+    // Sorts the tile of valid items at tile_offset from the input to the output
+    template<class KeysInputIterator,
+             class KeysOutputIterator,
+             class ValuesInputIterator,
+             class ValuesOutputIterator,
+             class BinaryFunction>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void sort_tile(KeysInputIterator    keys_input,
+                   KeysOutputIterator   keys_output,
+                   ValuesInputIterator  values_input,
+                   ValuesOutputIterator values_output,
+                   const unsigned int   tile_offset,
+                   const unsigned int   valid,
+                   BinaryFunction       compare_function,
+                   storage_type&        storage)
+    {
+        const unsigned int flat_id            = block_thread_id<0>();
+        const bool         is_incomplete_tile = valid < items_per_tile;
+
+        key_type keys[ItemsPerThread];
+        load_keys_type().load(tile_offset,
+                              valid,
+                              is_incomplete_tile,
+                              keys_input,
+                              keys,
+                              storage.load_keys);
+
+        // Special comparison that preserves relative order of equal keys
+        auto stable_compare_function
+            = [compare_function](const stable_key_type& a, const stable_key_type& b) mutable -> bool
+        {
+            const bool ab = compare_function(::rocprim::get<0>(a), ::rocprim::get<0>(b));
+            return ab
+                   || (!compare_function(::rocprim::get<0>(b), ::rocprim::get<0>(a))
+                       && (::rocprim::get<1>(a) < ::rocprim::get<1>(b)));
+        };
+
+        stable_key_type stable_keys[ItemsPerThread];
+        ROCPRIM_UNROLL
+        for(unsigned int item = 0; item < ItemsPerThread; ++item)
+        {
+            stable_keys[item] = ::rocprim::make_tuple(keys[item], ItemsPerThread * flat_id + item);
+        }
+
+        // Synchronize before reusing shared memory
+        ::rocprim::syncthreads();
+
+        sort_type().sort(stable_keys,
+                         storage.sort,
+                         valid,
+                         is_incomplete_tile,
+                         stable_compare_function);
+
+        unsigned int ranks[ItemsPerThread];
+        ROCPRIM_UNROLL
+        for(unsigned int item = 0; item < ItemsPerThread; ++item)
+        {
+            keys[item]  = ::rocprim::get<0>(stable_keys[item]);
+            ranks[item] = ::rocprim::get<1>(stable_keys[item]);
+        }
+
+        value_type values[ItemsPerThread];
+        // Load the values with the already sorted indices
+        load_values_type().load(flat_id,
+                                ranks,
+                                tile_offset,
+                                valid,
+                                is_incomplete_tile,
+                                values_input,
+                                values,
+                                storage.load_values);
+
+        store_type().store(tile_offset,
+                           valid,
+                           is_incomplete_tile,
+                           keys_output,
+                           values_output,
+                           keys,
+                           values,
+                           storage.store);
+        ::rocprim::syncthreads();
+    }
+
+    // Merges the tile at tile_offset of the sorted runs [keys1_begin, keys1_end) and
+    // [keys1_end, keys2_end) from the input to the output. Like the mergepath kernel, the tile
+    // is partitioned by merge paths of its first and last items.
+    template<class KeysInputIterator,
+             class KeysOutputIterator,
+             class ValuesInputIterator,
+             class ValuesOutputIterator,
+             class BinaryFunction>
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    void merge_tile(KeysInputIterator    keys_input,
+                    KeysOutputIterator   keys_output,
+                    ValuesInputIterator  values_input,
+                    ValuesOutputIterator values_output,
+                    const unsigned int   tile_offset,
+                    const unsigned int   keys1_begin,
+                    const unsigned int   keys1_end,
+                    const unsigned int   keys2_end,
+                    BinaryFunction       compare_function,
+                    storage_type&        storage)
+    {
+        const unsigned int flat_id = block_thread_id<0>();
+
+        const unsigned int count1     = keys1_end - keys1_begin;
+        const unsigned int count2     = keys2_end - keys1_end;
+        const unsigned int diag_begin = tile_offset - keys1_begin;
+        const unsigned int diag_end
+            = ::rocprim::min(tile_offset + items_per_tile, keys2_end) - keys1_begin;
+
+        if(flat_id < 2)
+        {
+            storage.partitions[flat_id] = merge_path(keys_input + keys1_begin,
+                                                     keys_input + keys1_end,
+                                                     count1,
+                                                     count2,
+                                                     flat_id == 0 ? diag_begin : diag_end,
+                                                     compare_function);
+        }
+        ::rocprim::syncthreads();
+        const unsigned int partition_begin = storage.partitions[0];
+        const unsigned int partition_end   = storage.partitions[1];
+
+        const unsigned int num_keys1 = partition_end - partition_begin;
+        const unsigned int num_keys2 = (diag_end - partition_end) - (diag_begin - partition_begin);
+        const unsigned int valid     = num_keys1 + num_keys2;
+        const bool         is_incomplete_tile = valid < items_per_tile;
+
+        const unsigned int tile_keys1_begin = keys1_begin + partition_begin;
+        const unsigned int tile_keys2_begin = keys1_end + diag_begin - partition_begin;
+
+        auto& keys_shared   = storage.keys.get();
+        auto& values_shared = storage.values.get();
+
+        key_type keys[ItemsPerThread];
+        gmem_to_reg<ItemsPerThread>(keys,
+                                    keys_input + tile_keys1_begin,
+                                    keys_input + tile_keys2_begin,
+                                    num_keys1,
+                                    num_keys2,
+                                    is_incomplete_tile);
+        reg_to_shared<BlockSize, ItemsPerThread>(keys_shared, keys);
+
+        value_type values[ItemsPerThread];
+        if ROCPRIM_IF_CONSTEXPR(with_values)
+        {
+            gmem_to_reg<ItemsPerThread>(values,
+                                        values_input + tile_keys1_begin,
+                                        values_input + tile_keys2_begin,
+                                        num_keys1,
+                                        num_keys2,
+                                        is_incomplete_tile);
+        }
+        ::rocprim::syncthreads();
+
+        const unsigned int diag0_local = ::rocprim::min(valid, ItemsPerThread * flat_id);
+        const unsigned int keys1_begin_local = merge_path(keys_shared,
+                                                          &keys_shared[num_keys1],
+                                                          num_keys1,
+                                                          num_keys2,
+                                                          diag0_local,
+                                                          compare_function);
+        const range_t range_local = {keys1_begin_local,
+                                     num_keys1,
+                                     diag0_local - keys1_begin_local + num_keys1,
+                                     valid};
+
+        unsigned int indices[ItemsPerThread];
+        serial_merge(keys_shared, keys, indices, range_local, compare_function);
+
+        if ROCPRIM_IF_CONSTEXPR(with_values)
+        {
+            reg_to_shared<BlockSize, ItemsPerThread>(values_shared, values);
+            ::rocprim::syncthreads();
+
+            ROCPRIM_UNROLL
+            for(unsigned int item = 0; item < ItemsPerThread; ++item)
+            {
+                values[item] = values_shared[indices[item]];
+            }
+            ::rocprim::syncthreads();
+        }
+
+        store_type().store(tile_offset,
+                           valid,
+                           is_incomplete_tile,
+                           keys_output,
+                           values_output,
+                           keys,
+                           values,
+                           storage.store);
+        ::rocprim::syncthreads();
+    }
+};
+
+// Number of segments known on the host, used when the segments are not partitioned
+struct segmented_merge_sort_segment_count
+{
+    unsigned int segments;
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    unsigned int operator()() const
+    {
+        return segments;
+    }
+};
+
+template<class Config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class SegmentCount,
+         class SegmentIndexIterator,
+         class OffsetIterator,
+         class BinaryFunction>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE
+void segmented_merge_sort_small(KeysInputIterator    keys_input,
+                                KeysOutputIterator   keys_output,
+                                ValuesInputIterator  values_input,
+                                ValuesOutputIterator values_output,
+                                SegmentCount         segment_count,
+                                SegmentIndexIterator segment_indices,
+                                OffsetIterator       begin_offsets,
+                                OffsetIterator       end_offsets,
+                                BinaryFunction       compare_function)
+{
+    static constexpr unsigned int block_size        = Config::warp_block_size;
+    static constexpr unsigned int logical_warp_size = Config::logical_warp_size;
+    static_assert(block_size % logical_warp_size == 0,
+                  "logical_warp_size must be a divisor of warp_block_size");
+    static constexpr unsigned int warps_per_block = block_size / logical_warp_size;
+
+    using key_type   = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+
+    using warp_helper_type = segmented_merge_sort_warp_helper<logical_warp_size,
+                                                              Config::warp_items_per_thread,
+                                                              key_type,
+                                                              value_type>;
+
+    ROCPRIM_SHARED_MEMORY typename warp_helper_type::storage_type storage[warps_per_block];
+
+    const unsigned int block_id        = ::rocprim::detail::block_id<0>();
+    const unsigned int logical_warp_id = ::rocprim::detail::logical_warp_id<logical_warp_size>();
+    const unsigned int segment_index   = block_id * warps_per_block + logical_warp_id;
+    if(segment_index >= segment_count())
+    {
+        return;
+    }
+
+    const unsigned int segment_id   = segment_indices[segment_index];
+    const unsigned int begin_offset = begin_offsets[segment_id];
+    const unsigned int end_offset   = end_offsets[segment_id];
+    if(end_offset <= begin_offset)
+    {
+        return;
+    }
+    warp_helper_type().sort(keys_input + begin_offset,
+                            keys_output + begin_offset,
+                            values_input + begin_offset,
+                            values_output + begin_offset,
+                            end_offset - begin_offset,
+                            compare_function,
+                            storage[logical_warp_id]);
+}
+
+template<class Config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class SegmentCount,
+         class SegmentIndexIterator,
+         class OffsetIterator,
+         class BinaryFunction>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE
+void segmented_merge_sort_medium(KeysInputIterator    keys_input,
+                                 KeysOutputIterator   keys_output,
+                                 ValuesInputIterator  values_input,
+                                 ValuesOutputIterator values_output,
+                                 SegmentCount         segment_count,
+                                 SegmentIndexIterator segment_indices,
+                                 OffsetIterator       begin_offsets,
+                                 OffsetIterator       end_offsets,
+                                 BinaryFunction       compare_function)
+{
+    using key_type   = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+
+    using block_helper_type = segmented_merge_sort_block_helper<Config::block_size,
+                                                                Config::items_per_thread,
+                                                                key_type,
+                                                                value_type>;
+
+    ROCPRIM_SHARED_MEMORY typename block_helper_type::storage_type storage;
+
+    // The grid is sized for the worst case, the surplus blocks exit
+    const unsigned int block_id = ::rocprim::detail::block_id<0>();
+    if(block_id >= segment_count())
+    {
+        return;
+    }
+    const unsigned int segment_id   = segment_indices[block_id];
+    const unsigned int begin_offset = begin_offsets[segment_id];
+    const unsigned int end_offset   = end_offsets[segment_id];
+    if(end_offset <= begin_offset)
+    {
+        return;
+    }
+    block_helper_type().sort_tile(keys_input + begin_offset,
+                                  keys_output + begin_offset,
+                                  values_input + begin_offset,
+                                  values_output + begin_offset,
+                                  0,
+                                  end_offset - begin_offset,
+                                  compare_function,
+                                  storage);
+}
+
+// Number of tiles of the segments, scanned so that the blocks sorting and merging the tiles of
+// large segments find their segments. Segments past the count have no tiles.
+template<class SegmentCount, class SegmentIndexIterator, class OffsetIterator>
+struct segmented_merge_sort_tile_count_op
+{
+    SegmentCount         segment_count;
+    SegmentIndexIterator segment_indices;
+    OffsetIterator       begin_offsets;
+    OffsetIterator       end_offsets;
+    unsigned int         items_per_tile;
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    unsigned int operator()(const unsigned int segment_index) const
+    {
+        if(segment_index >= segment_count())
+        {
+            return 0;
+        }
+        const unsigned int segment_id   = segment_indices[segment_index];
+        const unsigned int begin_offset = begin_offsets[segment_id];
+        const unsigned int end_offset   = end_offsets[segment_id];
+        return end_offset > begin_offset
+                   ? ::rocprim::detail::ceiling_div(end_offset - begin_offset, items_per_tile)
+                   : 0;
+    }
+};
+
+// Finds the segment and the tile of the block in the inclusive scan of the numbers of tiles of
+// the segments. Returns false for the surplus blocks of a grid sized for the worst case.
+template<class SegmentCount>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+bool segmented_merge_sort_find_tile(const unsigned int* tile_ends,
+                                    SegmentCount        segment_count,
+                                    unsigned int&       segment_index,
+                                    unsigned int&       tile)
+{
+    const unsigned int block_id = ::rocprim::detail::block_id<0>();
+    const unsigned int count    = segment_count();
+    if(count == 0 || block_id >= tile_ends[count - 1])
+    {
+        return false;
+    }
+    unsigned int first = 0;
+    unsigned int last  = count - 1;
+    while(first < last)
+    {
+        const unsigned int middle = first + (last - first) / 2;
+        if(tile_ends[middle] > block_id)
+        {
+            last = middle;
+        }
+        else
+        {
+            first = middle + 1;
+        }
+    }
+    segment_index = first;
+    tile          = block_id - (first == 0 ? 0 : tile_ends[first - 1]);
+    return true;
+}
+
+// Number of passes merging pairs of sorted runs of a segment of size items
+ROCPRIM_DEVICE ROCPRIM_INLINE
+unsigned int segmented_merge_sort_passes(const unsigned int size, const unsigned int items_per_tile)
+{
+    const unsigned int tiles  = ::rocprim::detail::ceiling_div(size, items_per_tile);
+    unsigned int       passes = 0;
+    for(unsigned int runs = 1; runs < tiles; runs *= 2)
+    {
+        passes++;
+    }
+    return passes;
+}
+
+// The tiles of large segments are spread across the grid: a block sorts one tile, then every
+// merge pass merges one tile of pairs of sorted runs. Passes alternate between the output and
+// the temporary buffers, the tiles are sorted into the buffer which makes the last merge pass of
+// their segment write the output.
+template<class Config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class SegmentCount,
+         class SegmentIndexIterator,
+         class OffsetIterator,
+         class BinaryFunction>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE
+void segmented_merge_sort_large_tiles(
+    KeysInputIterator                                               keys_input,
+    typename std::iterator_traits<KeysInputIterator>::value_type*   keys_tmp,
+    KeysOutputIterator                                              keys_output,
+    ValuesInputIterator                                             values_input,
+    typename std::iterator_traits<ValuesInputIterator>::value_type* values_tmp,
+    ValuesOutputIterator                                            values_output,
+    const unsigned int*                                             tile_ends,
+    SegmentCount                                                    segment_count,
+    SegmentIndexIterator                                            segment_indices,
+    OffsetIterator                                                  begin_offsets,
+    OffsetIterator                                                  end_offsets,
+    BinaryFunction                                                  compare_function)
+{
+    using key_type   = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+
+    using block_helper_type = segmented_merge_sort_block_helper<Config::block_size,
+                                                                Config::items_per_thread,
+                                                                key_type,
+                                                                value_type>;
+    static constexpr unsigned int items_per_tile = block_helper_type::items_per_tile;
+
+    ROCPRIM_SHARED_MEMORY typename block_helper_type::storage_type storage;
+
+    unsigned int segment_index;
+    unsigned int tile;
+    if(!segmented_merge_sort_find_tile(tile_ends, segment_count, segment_index, tile))
+    {
+        return;
+    }
+    const unsigned int segment_id   = segment_indices[segment_index];
+    const unsigned int begin_offset = begin_offsets[segment_id];
+    const unsigned int size         = end_offsets[segment_id] - begin_offset;
+    const unsigned int tile_offset  = tile * items_per_tile;
+    const unsigned int valid        = ::rocprim::min(items_per_tile, size - tile_offset);
+
+    if(segmented_merge_sort_passes(size, items_per_tile) % 2 == 0)
+    {
+        block_helper_type().sort_tile(keys_input + begin_offset,
+                                      keys_output + begin_offset,
+                                      values_input + begin_offset,
+                                      values_output + begin_offset,
+                                      tile_offset,
+                                      valid,
+                                      compare_function,
+                                      storage);
+    }
+    else
+    {
+        block_helper_type().sort_tile(keys_input + begin_offset,
+                                      keys_tmp + begin_offset,
+                                      values_input + begin_offset,
+                                      values_tmp + begin_offset,
+                                      tile_offset,
+                                      valid,
+                                      compare_function,
+                                      storage);
+    }
+}
+
+// Merges a tile of the pass which merges pairs of sorted runs of sorted_size items. Segments
+// which are already sorted are not touched, their last pass has written the output.
+template<class Config,
+         class KeysOutputIterator,
+         class ValuesOutputIterator,
+         class SegmentCount,
+         class SegmentIndexIterator,
+         class OffsetIterator,
+         class BinaryFunction>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE
+void segmented_merge_sort_large_merge(
+    typename std::iterator_traits<KeysOutputIterator>::value_type*   keys_tmp,
+    KeysOutputIterator                                               keys_output,
+    typename std::iterator_traits<ValuesOutputIterator>::value_type* values_tmp,
+    ValuesOutputIterator                                             values_output,
+    const unsigned int*                                              tile_ends,
+    SegmentCount                                                     segment_count,
+    SegmentIndexIterator                                             segment_indices,
+    OffsetIterator                                                   begin_offsets,
+    OffsetIterator                                                   end_offsets,
+    const unsigned int                                               sorted_size,
+    const unsigned int                                               pass,
+    BinaryFunction                                                   compare_function)
+{
+    using key_type   = typename std::iterator_traits<KeysOutputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesOutputIterator>::value_type;
+
+    using block_helper_type = segmented_merge_sort_block_helper<Config::block_size,
+                                                                Config::items_per_thread,
+                                                                key_type,
+                                                                value_type>;
+    static constexpr unsigned int items_per_tile = block_helper_type::items_per_tile;
+
+    ROCPRIM_SHARED_MEMORY typename block_helper_type::storage_type storage;
+
+    unsigned int segment_index;
+    unsigned int tile;
+    if(!segmented_merge_sort_find_tile(tile_ends, segment_count, segment_index, tile))
+    {
+        return;
+    }
+    const unsigned int segment_id   = segment_indices[segment_index];
+    const unsigned int begin_offset = begin_offsets[segment_id];
+    const unsigned int size         = end_offsets[segment_id] - begin_offset;
+    if(size <= sorted_size)
+    {
+        return;
+    }
+
+    const unsigned int tile_offset = tile * items_per_tile;
+    const unsigned int keys1_begin = tile_offset - tile_offset % (2 * sorted_size);
+    const unsigned int keys1_end   = ::rocprim::min(size, keys1_begin + sorted_size);
+    const unsigned int keys2_end   = ::rocprim::min(size, keys1_end + sorted_size);
+
+    // The last pass of the segment writes the output
+    const bool to_output = (segmented_merge_sort_passes(size, items_per_tile) - pass) % 2 == 1;
+    if(to_output)
+    {
+        block_helper_type().merge_tile(keys_tmp + begin_offset,
+                                       keys_output + begin_offset,
+                                       values_tmp + begin_offset,
+                                       values_output + begin_offset,
+                                       tile_offset,
+                                       keys1_begin,
+                                       keys1_end,
+                                       keys2_end,
+                                       compare_function,
+                                       storage);
+    }
+    else
+    {
+        block_helper_type().merge_tile(keys_output + begin_offset,
+                                       keys_tmp + begin_offset,
+                                       values_output + begin_offset,
+                                       values_tmp + begin_offset,
+                                       tile_offset,
+                                       keys1_begin,
+                                       keys1_end,
+                                       keys2_end,
+                                       compare_function,
+                                       storage);
+    }
+}
+
+} // end namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_SEGMENTED_MERGE_SORT_HPP_
@@ -502,6 +502,14 @@ using select_warp_sort_helper_config_medium_t
                                               Config::items_per_thread_medium,
                                               Config::block_size_medium>>;
 
+// The warp sort helper config of the medium segments if Medium, otherwise of the small segments,
+// of the segmented radix sort config Config
+template<class Config, bool Medium>
+using select_warp_sort_helper_config_t = std::conditional_t<
+    Medium,
+    select_warp_sort_helper_config_medium_t<typename Config::warp_sort_config>,
+    select_warp_sort_helper_config_small_t<typename Config::warp_sort_config>>;
+
 template<
     class Config,
     class Key,
@@ -819,7 +827,8 @@ template<
     class ValuesInputIterator,
     class ValuesOutputIterator,
     class SegmentIndexIterator,
-    class OffsetIterator
+    class OffsetIterator,
+    class SegmentCount
 >
 ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE
 void segmented_sort_large(KeysInputIterator keys_input,
@@ -829,6 +838,7 @@ void segmented_sort_large(KeysInputIterator keys_input,
                           typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
                           ValuesOutputIterator values_output,
                           bool to_output,
+                          SegmentCount segment_count,
                           SegmentIndexIterator segment_indices,
                           OffsetIterator begin_offsets,
                           OffsetIterator end_offsets,
@@ -869,7 +879,12 @@ void segmented_sort_large(KeysInputIterator keys_input,
         typename short_radix_helper_type::storage_type short_radix_helper;
     } storage;
 
+    // The grid is sized for the worst case, the surplus blocks exit
     const unsigned int block_id = ::rocprim::detail::block_id<0>();
+    if(block_id >= segment_count())
+    {
+        return;
+    }
     const unsigned int segment_id = segment_indices[block_id];
     const unsigned int begin_offset = begin_offsets[segment_id];
     const unsigned int end_offset = end_offsets[segment_id];
@@ -929,7 +944,8 @@ template<
     class ValuesInputIterator,
     class ValuesOutputIterator,
     class SegmentIndexIterator,
-    class OffsetIterator
+    class OffsetIterator,
+    class SegmentCount
 >
 ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE
 void segmented_sort_small(KeysInputIterator keys_input,
@@ -939,7 +955,7 @@ void segmented_sort_small(KeysInputIterator keys_input,
                           typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
                           ValuesOutputIterator values_output,
                           bool to_output,
-                          unsigned int num_segments,
+                          SegmentCount segment_count,
                           SegmentIndexIterator segment_indices,
                           OffsetIterator begin_offsets,
                           OffsetIterator end_offsets,
@@ -963,7 +979,7 @@ void segmented_sort_small(KeysInputIterator keys_input,
     const unsigned int block_id = ::rocprim::detail::block_id<0>();
     const unsigned int logical_warp_id = ::rocprim::detail::logical_warp_id<logical_warp_size>();
     const unsigned int segment_index = block_id * warps_per_block + logical_warp_id;
-    if(segment_index >= num_segments)
+    if(segment_index >= segment_count())
     {
         return;
     }
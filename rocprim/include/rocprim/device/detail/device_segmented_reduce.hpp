@@ -32,6 +32,7 @@
 
 #include "../../block/block_load_func.hpp"
 #include "../../block/block_reduce.hpp"
+#include "../../warp/warp_reduce.hpp"
 #include "rocprim/device/config_types.hpp"
 #include "rocprim/device/device_reduce_config.hpp"
 
@@ -51,6 +52,7 @@ template<
 ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE
 void segmented_reduce(InputIterator input,
                       OutputIterator output,
+                      const unsigned int segment_id,
                       OffsetIterator begin_offsets,
                       OffsetIterator end_offsets,
                       BinaryFunction reduce_op,
@@ -67,7 +69,6 @@ void segmented_reduce(InputIterator input,
     ROCPRIM_SHARED_MEMORY typename reduce_type::storage_type reduce_storage;
 
     const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
-    const unsigned int segment_id = ::rocprim::detail::block_id<0>();
 
     const unsigned int begin_offset = begin_offsets[segment_id];
     const unsigned int end_offset = end_offsets[segment_id];
@@ -160,6 +161,90 @@ void segmented_reduce(InputIterator input,
     }
 }
 
+// Reduces each of the segments selected by segment_indices by a single logical warp.
+// The segments must not be longer than LogicalWarpSize * ItemsPerThread. With a logical warp
+// size of 1 every thread reduces a whole segment on its own.
+template<
+    unsigned int LogicalWarpSize,
+    unsigned int ItemsPerThread,
+    unsigned int BlockSize,
+    class InputIterator,
+    class OutputIterator,
+    class SegmentIndexIterator,
+    class OffsetIterator,
+    class ResultType,
+    class BinaryFunction
+>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE
+void segmented_warp_reduce(InputIterator input,
+                           OutputIterator output,
+                           const unsigned int num_segments,
+                           SegmentIndexIterator segment_indices,
+                           OffsetIterator begin_offsets,
+                           OffsetIterator end_offsets,
+                           BinaryFunction reduce_op,
+                           ResultType initial_value)
+{
+    static_assert(BlockSize % LogicalWarpSize == 0, "LogicalWarpSize must be a divisor of BlockSize");
+    static constexpr unsigned int warps_per_block = BlockSize / LogicalWarpSize;
+
+    using warp_reduce_type = ::rocprim::warp_reduce<ResultType, LogicalWarpSize>;
+
+    ROCPRIM_SHARED_MEMORY typename warp_reduce_type::storage_type storage[warps_per_block];
+
+    const unsigned int lane_id = ::rocprim::detail::logical_lane_id<LogicalWarpSize>();
+    const unsigned int logical_warp_id = ::rocprim::detail::logical_warp_id<LogicalWarpSize>();
+    const unsigned int segment_index
+        = ::rocprim::detail::block_id<0>() * warps_per_block + logical_warp_id;
+    if(segment_index >= num_segments)
+    {
+        return;
+    }
+
+    const unsigned int segment_id = segment_indices[segment_index];
+    const unsigned int begin_offset = begin_offsets[segment_id];
+    const unsigned int end_offset = end_offsets[segment_id];
+
+    // Empty segment
+    if(end_offset <= begin_offset)
+    {
+        if(lane_id == 0)
+        {
+            output[segment_id] = initial_value;
+        }
+        return;
+    }
+
+    const unsigned int valid_count = end_offset - begin_offset;
+
+    // Reduce the current thread's values, consecutive lanes load consecutive values
+    ResultType result;
+    if(lane_id < valid_count)
+    {
+        result = input[begin_offset + lane_id];
+        ROCPRIM_UNROLL
+        for(unsigned int i = 1; i < ItemsPerThread; i++)
+        {
+            const unsigned int offset = i * LogicalWarpSize + lane_id;
+            if(offset < valid_count)
+            {
+                result = reduce_op(result, static_cast<ResultType>(input[begin_offset + offset]));
+            }
+        }
+    }
+
+    warp_reduce_type().reduce(
+        result, result,
+        ::rocprim::min(valid_count, LogicalWarpSize),
+        storage[logical_warp_id], reduce_op
+    );
+
+    if(lane_id == 0)
+    {
+        output[segment_id] = reduce_op(initial_value, result);
+    }
+}
+
 } // end of detail namespace
 
 END_ROCPRIM_NAMESPACE
@@ -0,0 +1,399 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_SET_OPERATIONS_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_SET_OPERATIONS_HPP_
+
+#include <iterator>
+#include <type_traits>
+
+#include "../../config.hpp"
+#include "../../detail/merge_path.hpp"
+#include "../../detail/various.hpp"
+
+#include "../../functional.hpp"
+#include "../../intrinsics.hpp"
+#include "../../types.hpp"
+
+#include "../../block/block_scan.hpp"
+
+#include "device_binary_search.hpp"
+#include "lookback_scan_state.hpp"
+#include "ordered_block_id.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// The set operations follow the multiset semantics of the standard library. The i-th of
+// the m items of the first input equal to a key is matched with the i-th of the n items of
+// the second input equal to the same key, if n > i. Every operation keeps or drops the items
+// depending on their input and on whether they are matched.
+struct set_union_op
+{
+    static constexpr bool keep_matched1   = true;
+    static constexpr bool keep_unmatched1 = true;
+    static constexpr bool keep_matched2   = false;
+    static constexpr bool keep_unmatched2 = true;
+};
+
+struct set_intersection_op
+{
+    static constexpr bool keep_matched1   = true;
+    static constexpr bool keep_unmatched1 = false;
+    static constexpr bool keep_matched2   = false;
+    static constexpr bool keep_unmatched2 = false;
+};
+
+struct set_difference_op
+{
+    static constexpr bool keep_matched1   = false;
+    static constexpr bool keep_unmatched1 = true;
+    static constexpr bool keep_matched2   = false;
+    static constexpr bool keep_unmatched2 = false;
+};
+
+struct set_symmetric_difference_op
+{
+    static constexpr bool keep_matched1   = false;
+    static constexpr bool keep_unmatched1 = true;
+    static constexpr bool keep_matched2   = false;
+    static constexpr bool keep_unmatched2 = true;
+};
+
+template<class T, class BinaryFunction>
+ROCPRIM_DEVICE ROCPRIM_INLINE bool
+    set_operation_equal(const T& a, const T& b, BinaryFunction compare_function)
+{
+    return !compare_function(a, b) && !compare_function(b, a);
+}
+
+// Computes, for every tile of the merged sequence of both inputs, the number of items of
+// the first input preceding the tile. Items of the first input precede equal items of the
+// second input.
+template<class KeysInputIterator1, class KeysInputIterator2, class BinaryFunction>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void set_operation_partition_kernel_impl(size_t*            indices,
+                                         KeysInputIterator1 keys_input1,
+                                         KeysInputIterator2 keys_input2,
+                                         const size_t       input1_size,
+                                         const size_t       input2_size,
+                                         const size_t       number_of_tiles,
+                                         const unsigned int spacing,
+                                         BinaryFunction     compare_function)
+{
+    const size_t id = ::rocprim::detail::block_id<0>() * ::rocprim::detail::block_size<0>()
+                      + ::rocprim::detail::block_thread_id<0>();
+    if(id > number_of_tiles)
+    {
+        return;
+    }
+
+    const size_t diag = ::rocprim::min(id * spacing, input1_size + input2_size);
+    indices[id]       = merge_path(keys_input1,
+                             keys_input2,
+                             input1_size,
+                             input2_size,
+                             diag,
+                             compare_function);
+}
+
+// Each tile of the merged sequence is merged in shared memory. Whether an item is matched
+// depends on the runs of its key in both inputs, which are found by binary searches in the
+// tile. Only the runs of the first and the last key of the tile may continue outside of it,
+// their bounds are searched in global memory once per tile. The kept items are compacted
+// with a look-back scan of their counts.
+template<class SetOp,
+         class Config,
+         class KeysInputIterator1,
+         class KeysInputIterator2,
+         class KeysOutputIterator,
+         class ValuesInputIterator1,
+         class ValuesInputIterator2,
+         class ValuesOutputIterator,
+         class BinaryFunction,
+         class OffsetLookbackScanState>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE
+void set_operation_kernel_impl(const size_t*                           indices,
+                               KeysInputIterator1                      keys_input1,
+                               KeysInputIterator2                      keys_input2,
+                               KeysOutputIterator                      keys_output,
+                               ValuesInputIterator1                    values_input1,
+                               ValuesInputIterator2                    values_input2,
+                               ValuesOutputIterator                    values_output,
+                               size_t*                                 output_count,
+                               const size_t                            input1_size,
+                               const size_t                            input2_size,
+                               BinaryFunction                          compare_function,
+                               OffsetLookbackScanState                 offset_scan_state,
+                               const size_t                            number_of_tiles,
+                               ordered_block_id<lookback_tile_id_type> ordered_tile_id)
+{
+    constexpr unsigned int block_size       = Config::block_size;
+    constexpr unsigned int items_per_thread = Config::items_per_thread;
+    constexpr unsigned int items_per_block  = block_size * items_per_thread;
+
+    using key_type    = typename std::iterator_traits<KeysInputIterator1>::value_type;
+    using value_type  = typename std::iterator_traits<ValuesInputIterator1>::value_type;
+    using offset_type = typename OffsetLookbackScanState::value_type;
+
+    constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+    using block_scan_offset_type     = ::rocprim::block_scan<offset_type, block_size>;
+    using order_tile_id_type         = ordered_block_id<lookback_tile_id_type>;
+    using offset_scan_prefix_op_type
+        = offset_lookback_scan_prefix_op<offset_type, OffsetLookbackScanState>;
+
+    ROCPRIM_SHARED_MEMORY struct
+    {
+        typename order_tile_id_type::storage_type         ordered_tile_id;
+        typename block_scan_offset_type::storage_type     scan_offsets;
+        typename offset_scan_prefix_op_type::storage_type prefix_op;
+        // Keys of the tile, items of the first input are followed by items of the second input
+        typename detail::raw_storage<key_type[items_per_block]> keys;
+        // Positions of the kept items in keys, compacted
+        unsigned int kept[items_per_block];
+        // Bounds of the runs of the first and the last key, which may continue outside the tile
+        size_t first_lower_bound1;
+        size_t first_lower_bound2;
+        size_t last_upper_bound2;
+    } storage;
+
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const size_t       size    = input1_size + input2_size;
+
+    // When the grid has fewer blocks than there are tiles, blocks take tiles until all of them
+    // are processed. The tile ids are ordered, so the look-back never waits for a tile that has
+    // not been taken by a running block.
+    const bool is_grid_persistent = number_of_tiles > ::rocprim::detail::grid_size<0>();
+
+    for(size_t tile_id = ordered_tile_id.get(flat_id, storage.ordered_tile_id);
+        tile_id < number_of_tiles;
+        tile_id = ordered_tile_id.get(flat_id, storage.ordered_tile_id))
+    {
+        const size_t diag_begin = tile_id * items_per_block;
+        const size_t diag_end   = ::rocprim::min(diag_begin + items_per_block, size);
+        const size_t begin1     = indices[tile_id];
+        const size_t end1       = indices[tile_id + 1];
+        const size_t begin2     = diag_begin - begin1;
+        const size_t end2       = diag_end - end1;
+
+        const unsigned int count1 = static_cast<unsigned int>(end1 - begin1);
+        const unsigned int count2 = static_cast<unsigned int>(end2 - begin2);
+        const unsigned int count  = count1 + count2;
+
+        key_type* keys1_shared = storage.keys.get();
+        key_type* keys2_shared = keys1_shared + count1;
+
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < items_per_thread; ++i)
+        {
+            const unsigned int index = block_size * i + flat_id;
+            if(index < count1)
+            {
+                keys1_shared[index] = keys_input1[begin1 + index];
+            }
+            else if(index < count)
+            {
+                keys2_shared[index - count1] = keys_input2[begin2 + index - count1];
+            }
+        }
+        ::rocprim::syncthreads();
+
+        // Items of the first input precede equal items of the second input, so the first key
+        // is the smallest key of the first input unless a key of the second input is smaller
+        const key_type& first_key
+            = count1 > 0 && (count2 == 0 || !compare_function(keys2_shared[0], keys1_shared[0]))
+                  ? keys1_shared[0]
+                  : keys2_shared[0];
+        const key_type& last_key
+            = count2 > 0
+                      && (count1 == 0
+                          || !compare_function(keys2_shared[count2 - 1], keys1_shared[count1 - 1]))
+                  ? keys2_shared[count2 - 1]
+                  : keys1_shared[count1 - 1];
+
+        // All items before the tile are not greater than the first key, and all items after
+        // the tile are not less than the last key
+        if(flat_id == 0)
+        {
+            storage.first_lower_bound1
+                = lower_bound_n(keys_input1, begin1, first_key, compare_function);
+        }
+        if(flat_id == block_size / 2)
+        {
+            storage.first_lower_bound2
+                = lower_bound_n(keys_input2, begin2, first_key, compare_function);
+        }
+        if(flat_id == block_size - 1)
+        {
+            storage.last_upper_bound2
+                = end2
+                  + upper_bound_n(keys_input2 + end2, input2_size - end2, last_key, compare_function);
+        }
+        ::rocprim::syncthreads();
+
+        const unsigned int diag = ::rocprim::min(flat_id * items_per_thread, count);
+        unsigned int       a
+            = merge_path(keys1_shared, keys2_shared, count1, count2, diag, compare_function);
+        unsigned int b = diag - a;
+
+        unsigned int kept_indices[items_per_thread];
+        bool         is_kept[items_per_thread];
+        offset_type  ranks[items_per_thread];
+
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < items_per_thread; ++i)
+        {
+            is_kept[i] = false;
+            if(diag + i < count)
+            {
+                const bool take2
+                    = b < count2 && (a >= count1 || compare_function(keys2_shared[b], keys1_shared[a]));
+                if(!take2)
+                {
+                    bool kept = SetOp::keep_unmatched1;
+                    if(SetOp::keep_matched1 != SetOp::keep_unmatched1)
+                    {
+                        const key_type& key = keys1_shared[a];
+                        const size_t    lower_bound1
+                            = set_operation_equal(key, first_key, compare_function)
+                                  ? storage.first_lower_bound1
+                                  : begin1 + lower_bound_n(keys1_shared, a, key, compare_function);
+                        const size_t lower_bound2
+                            = begin2 + lower_bound_n(keys2_shared, count2, key, compare_function);
+                        const size_t upper_bound2
+                            = set_operation_equal(key, last_key, compare_function)
+                                  ? storage.last_upper_bound2
+                                  : begin2 + upper_bound_n(keys2_shared, count2, key, compare_function);
+                        const bool matched = begin1 + a - lower_bound1 < upper_bound2 - lower_bound2;
+                        kept = matched ? SetOp::keep_matched1 : SetOp::keep_unmatched1;
+                    }
+                    kept_indices[i] = a++;
+                    is_kept[i]      = kept;
+                }
+                else
+                {
+                    bool kept = SetOp::keep_unmatched2;
+                    if(SetOp::keep_matched2 != SetOp::keep_unmatched2)
+                    {
+                        const key_type& key = keys2_shared[b];
+                        const bool is_first = set_operation_equal(key, first_key, compare_function);
+                        const size_t lower_bound2
+                            = is_first ? storage.first_lower_bound2
+                                       : begin2 + lower_bound_n(keys2_shared, b, key, compare_function);
+                        const size_t lower_bound1
+                            = is_first ? storage.first_lower_bound1
+                                       : begin1 + lower_bound_n(keys1_shared, count1, key, compare_function);
+                        const size_t upper_bound1
+                            = begin1 + upper_bound_n(keys1_shared, count1, key, compare_function);
+                        const bool matched = begin2 + b - lower_bound2 < upper_bound1 - lower_bound1;
+                        kept = matched ? SetOp::keep_matched2 : SetOp::keep_unmatched2;
+                    }
+                    kept_indices[i] = count1 + b++;
+                    is_kept[i]      = kept;
+                }
+            }
+            ranks[i] = is_kept[i] ? 1 : 0;
+        }
+
+        // Number of kept items in previous tiles
+        offset_type kept_prefix{};
+        // Number of kept items in this tile
+        offset_type kept_in_tile{};
+
+        if(tile_id == 0)
+        {
+            block_scan_offset_type().exclusive_scan(ranks,
+                                                    ranks,
+                                                    offset_type{},
+                                                    kept_in_tile,
+                                                    storage.scan_offsets,
+                                                    ::rocprim::plus<offset_type>());
+            if(flat_id == 0)
+            {
+                offset_scan_state.set_complete(tile_id, kept_in_tile);
+            }
+        }
+        else
+        {
+            auto prefix_op
+                = offset_scan_prefix_op_type(tile_id, offset_scan_state, storage.prefix_op);
+            block_scan_offset_type().exclusive_scan(ranks,
+                                                    ranks,
+                                                    storage.scan_offsets,
+                                                    prefix_op,
+                                                    ::rocprim::plus<offset_type>());
+            ::rocprim::syncthreads();
+
+            kept_in_tile = prefix_op.get_reduction();
+            kept_prefix  = prefix_op.get_prefix();
+        }
+
+        // Compact the positions of the kept items in shared memory, so that the items are
+        // written with coalesced accesses
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < items_per_thread; ++i)
+        {
+            if(is_kept[i])
+            {
+                storage.kept[ranks[i] - kept_prefix] = kept_indices[i];
+            }
+        }
+        ::rocprim::syncthreads();
+
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < items_per_thread; ++i)
+        {
+            const unsigned int rank = block_size * i + flat_id;
+            if(rank < kept_in_tile)
+            {
+                const unsigned int index = storage.kept[rank];
+                keys_output[kept_prefix + rank] = keys1_shared[index];
+                if ROCPRIM_IF_CONSTEXPR(with_values)
+                {
+                    values_output[kept_prefix + rank] = index < count1
+                                                            ? values_input1[begin1 + index]
+                                                            : values_input2[begin2 + index - count1];
+                }
+            }
+        }
+
+        // Last tile stores number of kept items
+        if(tile_id == number_of_tiles - 1 && flat_id == 0)
+        {
+            *output_count = kept_prefix + kept_in_tile;
+        }
+
+        if(!is_grid_persistent)
+        {
+            // Every tile was taken by a block of the grid
+            break;
+        }
+        ::rocprim::syncthreads(); // sync threads to reuse shared memory
+    }
+}
+
+} // end of detail namespace
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_SET_OPERATIONS_HPP_
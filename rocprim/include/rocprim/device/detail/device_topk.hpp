@@ -0,0 +1,504 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_TOPK_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_TOPK_HPP_
+
+#include <iterator>
+#include <type_traits>
+
+#include "../../config.hpp"
+#include "../../detail/radix_sort.hpp"
+#include "../../detail/various.hpp"
+#include "../../intrinsics.hpp"
+#include "../../functional.hpp"
+#include "../../types.hpp"
+
+#include "../../block/block_load_func.hpp"
+#include "../../block/block_scan.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// Radix select: the k-th smallest encoded key is found digit by digit from the most significant
+// one. Each pass counts the digits of the keys whose higher digits match the already selected
+// prefix (the candidates) and selects the digit containing the k-th candidate, so the candidate
+// bucket shrinks with every pass. Selecting the largest keys is done with descending encoding.
+
+// Device-side state of a device-wide radix select.
+template<class BitKey>
+struct topk_state
+{
+    // Already selected digits of the k-th key
+    BitKey prefix;
+    // Rank of the k-th key among the candidates
+    unsigned long long rank;
+    // Output counters of keys before the k-th key and of keys equal to it
+    unsigned long long less_output;
+    unsigned long long equal_output;
+};
+
+// Returns true if the digits of bit_key above shift are equal to the digits of prefix
+template<class BitKey>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+bool topk_matches_prefix(const BitKey bit_key, const BitKey prefix, const unsigned int shift)
+{
+    return shift >= 8 * sizeof(BitKey) || (bit_key >> shift) == (prefix >> shift);
+}
+
+// Extracts a digit of an encoded key. radix_key_codec::extract_digit is not used because it
+// folds -0.0 into +0.0, so the selected digits would not match the prefix of any key.
+template<class BitKey>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+unsigned int
+    topk_extract_digit(const BitKey bit_key, const unsigned int bit, const unsigned int length)
+{
+    return static_cast<unsigned int>(bit_key >> bit) & ((1u << length) - 1);
+}
+
+template<unsigned int RadixSize, class BitKey>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void topk_init(topk_state<BitKey>* state,
+               unsigned long long* digit_counts,
+               const unsigned long long rank)
+{
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    if(flat_id == 0)
+    {
+        state->prefix       = 0;
+        state->rank         = rank;
+        state->less_output  = 0;
+        state->equal_output = 0;
+    }
+    if(flat_id < RadixSize)
+    {
+        digit_counts[flat_id] = 0;
+    }
+}
+
+template<class Config, bool Descending, class KeysInputIterator, class BitKey>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void topk_count_digits(KeysInputIterator keys_input,
+                       const size_t size,
+                       const topk_state<BitKey>* state,
+                       unsigned long long* digit_counts,
+                       const unsigned int bit,
+                       const unsigned int current_radix_bits)
+{
+    constexpr unsigned int block_size       = Config::block_size;
+    constexpr unsigned int items_per_thread = Config::items_per_thread;
+    constexpr unsigned int items_per_block  = block_size * items_per_thread;
+    constexpr unsigned int radix_size       = 1u << Config::radix_bits;
+
+    using key_type  = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using key_codec = radix_key_codec<key_type, Descending>;
+
+    ROCPRIM_SHARED_MEMORY unsigned int block_digit_counts[radix_size];
+
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const size_t block_offset
+        = static_cast<size_t>(::rocprim::detail::block_id<0>()) * items_per_block;
+    const unsigned int valid_count
+        = static_cast<unsigned int>(::rocprim::min<size_t>(size - block_offset, items_per_block));
+
+    for(unsigned int digit = flat_id; digit < radix_size; digit += block_size)
+    {
+        block_digit_counts[digit] = 0;
+    }
+    ::rocprim::syncthreads();
+
+    // The order of keys is irrelevant, only the counts matter
+    key_type keys[items_per_thread];
+    block_load_direct_striped<block_size>(flat_id, keys_input + block_offset, keys, valid_count);
+
+    const BitKey prefix = state->prefix;
+    const unsigned int shift = bit + current_radix_bits;
+    ROCPRIM_UNROLL
+    for(unsigned int i = 0; i < items_per_thread; i++)
+    {
+        const BitKey bit_key = key_codec::encode(keys[i]);
+        if(flat_id + i * block_size < valid_count && topk_matches_prefix(bit_key, prefix, shift))
+        {
+            const unsigned int digit = topk_extract_digit(bit_key, bit, current_radix_bits);
+            ::rocprim::detail::atomic_add(&block_digit_counts[digit], 1u);
+        }
+    }
+    ::rocprim::syncthreads();
+
+    for(unsigned int digit = flat_id; digit < radix_size; digit += block_size)
+    {
+        const unsigned int count = block_digit_counts[digit];
+        if(count > 0)
+        {
+            ::rocprim::detail::atomic_add(&digit_counts[digit], count);
+        }
+    }
+}
+
+// Finds the digit of the candidate with the given rank, returns it in selected_digit
+// and the rank of the candidate among the candidates with this digit in rank.
+template<unsigned int BlockSize, unsigned int RadixSize, class Count, class ScanStorage>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void topk_select_digit(const Count digit_count,
+                       Count& rank,
+                       unsigned int& selected_digit,
+                       ScanStorage& storage)
+{
+    static_assert(RadixSize <= BlockSize, "Radix size must not exceed BlockSize");
+
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+
+    Count digit_start;
+    block_scan<Count, BlockSize>().exclusive_scan(digit_count,
+                                                  digit_start,
+                                                  Count(0),
+                                                  storage.scan,
+                                                  ::rocprim::plus<Count>());
+    if(flat_id < RadixSize && digit_start <= rank && rank < digit_start + digit_count)
+    {
+        storage.selected_digit = flat_id;
+        storage.rank           = rank - digit_start;
+    }
+    ::rocprim::syncthreads();
+    selected_digit = storage.selected_digit;
+    rank           = storage.rank;
+}
+
+template<class Config, class BitKey>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void topk_select_digit_device(topk_state<BitKey>* state,
+                              unsigned long long* digit_counts,
+                              const unsigned int bit)
+{
+    constexpr unsigned int block_size = Config::block_size;
+    constexpr unsigned int radix_size = 1u << Config::radix_bits;
+
+    using count_type = unsigned long long;
+
+    ROCPRIM_SHARED_MEMORY struct
+    {
+        typename block_scan<count_type, block_size>::storage_type scan;
+        unsigned int selected_digit;
+        count_type   rank;
+    } storage;
+
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+
+    count_type digit_count = 0;
+    if(flat_id < radix_size)
+    {
+        digit_count = digit_counts[flat_id];
+        // Reset the counts for the next pass
+        digit_counts[flat_id] = 0;
+    }
+    count_type rank = state->rank;
+
+    unsigned int selected_digit;
+    topk_select_digit<block_size, radix_size>(digit_count, rank, selected_digit, storage);
+
+    if(flat_id == 0)
+    {
+        state->prefix |= static_cast<BitKey>(selected_digit) << bit;
+        state->rank = rank;
+    }
+}
+
+// Writes the keys smaller than the k-th key and enough keys equal to it. The order of
+// the selected keys is unspecified.
+template<class Config,
+         bool Descending,
+         bool WithValues,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class BitKey>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void topk_scatter(KeysInputIterator    keys_input,
+                  KeysOutputIterator   keys_output,
+                  ValuesInputIterator  values_input,
+                  ValuesOutputIterator values_output,
+                  const size_t         size,
+                  const size_t         k,
+                  topk_state<BitKey>*  state)
+{
+    constexpr unsigned int block_size       = Config::block_size;
+    constexpr unsigned int items_per_thread = Config::items_per_thread;
+    constexpr unsigned int items_per_block  = block_size * items_per_thread;
+
+    using key_type  = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using key_codec = radix_key_codec<key_type, Descending>;
+    using scan_type = block_scan<unsigned int, block_size>;
+
+    ROCPRIM_SHARED_MEMORY struct
+    {
+        typename scan_type::storage_type scan;
+        unsigned long long less_start;
+        unsigned long long equal_start;
+    } storage;
+
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const size_t block_offset
+        = static_cast<size_t>(::rocprim::detail::block_id<0>()) * items_per_block;
+    const unsigned int valid_count
+        = static_cast<unsigned int>(::rocprim::min<size_t>(size - block_offset, items_per_block));
+
+    key_type keys[items_per_thread];
+    block_load_direct_striped<block_size>(flat_id, keys_input + block_offset, keys, valid_count);
+
+    const BitKey pivot = state->prefix;
+    // The k-th key and the keys equal to it which precede it
+    const unsigned long long equal_count = state->rank + 1;
+    const unsigned long long less_count  = k - equal_count;
+
+    unsigned int less_flags[items_per_thread];
+    unsigned int equal_flags[items_per_thread];
+    ROCPRIM_UNROLL
+    for(unsigned int i = 0; i < items_per_thread; i++)
+    {
+        const bool   is_valid = flat_id + i * block_size < valid_count;
+        const BitKey bit_key  = key_codec::encode(keys[i]);
+        less_flags[i]  = is_valid && bit_key < pivot;
+        equal_flags[i] = is_valid && bit_key == pivot;
+    }
+
+    unsigned int less_indices[items_per_thread];
+    unsigned int equal_indices[items_per_thread];
+    unsigned int block_less_count;
+    unsigned int block_equal_count;
+    scan_type().exclusive_scan(less_flags, less_indices, 0u, block_less_count, storage.scan);
+    ::rocprim::syncthreads();
+    scan_type().exclusive_scan(equal_flags, equal_indices, 0u, block_equal_count, storage.scan);
+    if(flat_id == 0)
+    {
+        storage.less_start  = block_less_count == 0
+                                  ? 0
+                                  : ::rocprim::detail::atomic_add(&state->less_output,
+                                                                  block_less_count);
+        storage.equal_start = block_equal_count == 0
+                                  ? 0
+                                  : ::rocprim::detail::atomic_add(&state->equal_output,
+                                                                  block_equal_count);
+    }
+    ::rocprim::syncthreads();
+    const unsigned long long less_start  = storage.less_start;
+    const unsigned long long equal_start = storage.equal_start;
+
+    ROCPRIM_UNROLL
+    for(unsigned int i = 0; i < items_per_thread; i++)
+    {
+        unsigned long long position = size;
+        if(less_flags[i])
+        {
+            position = less_start + less_indices[i];
+        }
+        else if(equal_flags[i] && equal_start + equal_indices[i] < equal_count)
+        {
+            position = less_count + equal_start + equal_indices[i];
+        }
+        if(position < size)
+        {
+            keys_output[position] = keys[i];
+            if(WithValues)
+            {
+                values_output[position] = values_input[block_offset + flat_id + i * block_size];
+            }
+        }
+    }
+}
+
+template<class Key, bool Descending, class BitKey, class KeysOutputIterator>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void topk_write_key(const topk_state<BitKey>* state, KeysOutputIterator key_output)
+{
+    *key_output = radix_key_codec<Key, Descending>::decode(state->prefix);
+}
+
+// Selects the k smallest keys (in encoded order) of a segment by a single block. The selected
+// keys are written in their input order.
+template<class Config,
+         bool Descending,
+         bool WithValues,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class OffsetIterator>
+ROCPRIM_DEVICE ROCPRIM_INLINE
+void segmented_topk(KeysInputIterator    keys_input,
+                    KeysOutputIterator   keys_output,
+                    ValuesInputIterator  values_input,
+                    ValuesOutputIterator values_output,
+                    OffsetIterator       begin_offsets,
+                    OffsetIterator       end_offsets,
+                    const unsigned int   k)
+{
+    constexpr unsigned int block_size       = Config::block_size;
+    constexpr unsigned int items_per_thread = Config::items_per_thread;
+    constexpr unsigned int items_per_block  = block_size * items_per_thread;
+    constexpr unsigned int radix_bits       = Config::radix_bits;
+    constexpr unsigned int radix_size       = 1u << radix_bits;
+
+    using key_type     = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using key_codec    = radix_key_codec<key_type, Descending>;
+    using bit_key_type = typename key_codec::bit_key_type;
+    using scan_type    = block_scan<unsigned int, block_size>;
+
+    constexpr unsigned int key_bits = 8 * sizeof(bit_key_type);
+
+    ROCPRIM_SHARED_MEMORY struct
+    {
+        typename scan_type::storage_type scan;
+        unsigned int                     selected_digit;
+        unsigned int                     rank;
+        unsigned int                     digit_counts[radix_size];
+    } storage;
+
+    const unsigned int flat_id = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int segment = ::rocprim::detail::block_id<0>();
+
+    const unsigned int begin_offset = begin_offsets[segment];
+    const unsigned int end_offset   = end_offsets[segment];
+    const unsigned int segment_size = end_offset > begin_offset ? end_offset - begin_offset : 0;
+    const unsigned int output_size  = ::rocprim::min(k, segment_size);
+    if(output_size == 0)
+    {
+        return;
+    }
+
+    keys_input += begin_offset;
+    values_input += begin_offset;
+    keys_output += static_cast<size_t>(segment) * k;
+    values_output += static_cast<size_t>(segment) * k;
+
+    if(output_size == segment_size)
+    {
+        // All keys of the segment are selected
+        for(unsigned int i = flat_id; i < segment_size; i += block_size)
+        {
+            keys_output[i] = keys_input[i];
+            if(WithValues)
+            {
+                values_output[i] = values_input[i];
+            }
+        }
+        return;
+    }
+
+    bit_key_type pivot = 0;
+    unsigned int rank  = output_size - 1;
+    for(unsigned int bit = key_bits; bit > 0;)
+    {
+        const unsigned int current_radix_bits = ::rocprim::min(radix_bits, bit);
+        const unsigned int shift              = bit;
+        bit -= current_radix_bits;
+
+        for(unsigned int digit = flat_id; digit < radix_size; digit += block_size)
+        {
+            storage.digit_counts[digit] = 0;
+        }
+        ::rocprim::syncthreads();
+
+        for(unsigned int offset = 0; offset < segment_size; offset += items_per_block)
+        {
+            const unsigned int valid_count = ::rocprim::min(segment_size - offset, items_per_block);
+            key_type keys[items_per_thread];
+            block_load_direct_striped<block_size>(flat_id, keys_input + offset, keys, valid_count);
+            ROCPRIM_UNROLL
+            for(unsigned int i = 0; i < items_per_thread; i++)
+            {
+                const bit_key_type bit_key = key_codec::encode(keys[i]);
+                if(flat_id + i * block_size < valid_count
+                   && topk_matches_prefix(bit_key, pivot, shift))
+                {
+                    const unsigned int digit
+                        = topk_extract_digit(bit_key, bit, current_radix_bits);
+                    ::rocprim::detail::atomic_add(&storage.digit_counts[digit], 1u);
+                }
+            }
+        }
+        ::rocprim::syncthreads();
+
+        const unsigned int digit_count = flat_id < radix_size ? storage.digit_counts[flat_id] : 0;
+        unsigned int selected_digit;
+        topk_select_digit<block_size, radix_size>(digit_count, rank, selected_digit, storage);
+        pivot |= static_cast<bit_key_type>(selected_digit) << bit;
+    }
+
+    // The k-th key and the keys equal to it which precede it are selected
+    const unsigned int equal_count = rank + 1;
+
+    // Write the selected keys in their input order
+    unsigned int equal_start    = 0;
+    unsigned int selected_start = 0;
+    for(unsigned int offset = 0; offset < segment_size && selected_start < output_size;
+        offset += items_per_block)
+    {
+        const unsigned int valid_count = ::rocprim::min(segment_size - offset, items_per_block);
+        key_type keys[items_per_thread];
+        block_load_direct_blocked(flat_id, keys_input + offset, keys, valid_count);
+
+        unsigned int equal_flags[items_per_thread];
+        unsigned int selected_flags[items_per_thread];
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < items_per_thread; i++)
+        {
+            const bool is_valid = flat_id * items_per_thread + i < valid_count;
+            const bit_key_type bit_key = key_codec::encode(keys[i]);
+            selected_flags[i] = is_valid && bit_key < pivot;
+            equal_flags[i]    = is_valid && bit_key == pivot;
+        }
+
+        unsigned int indices[items_per_thread];
+        unsigned int block_count;
+        ::rocprim::syncthreads();
+        scan_type().exclusive_scan(equal_flags, indices, equal_start, block_count, storage.scan);
+        equal_start += block_count;
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < items_per_thread; i++)
+        {
+            selected_flags[i] |= equal_flags[i] && indices[i] < equal_count;
+        }
+
+        ::rocprim::syncthreads();
+        scan_type().exclusive_scan(selected_flags, indices, selected_start, block_count, storage.scan);
+        selected_start += block_count;
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < items_per_thread; i++)
+        {
+            if(selected_flags[i])
+            {
+                keys_output[indices[i]] = keys[i];
+                if(WithValues)
+                {
+                    values_output[indices[i]] = values_input[offset + flat_id * items_per_thread + i];
+                }
+            }
+        }
+    }
+}
+
+} // end namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_TOPK_HPP_
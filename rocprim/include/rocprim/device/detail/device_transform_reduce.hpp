@@ -0,0 +1,243 @@
+// Copyright (c) 2017-2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DETAIL_DEVICE_TRANSFORM_REDUCE_HPP_
+#define ROCPRIM_DEVICE_DETAIL_DEVICE_TRANSFORM_REDUCE_HPP_
+
+#include <iterator>
+#include <type_traits>
+
+#include "../../config.hpp"
+#include "../../detail/various.hpp"
+#include "../config_types.hpp"
+#include "../device_reduce_config.hpp"
+
+#include "../../intrinsics.hpp"
+#include "../../types/integer_sequence.hpp"
+#include "../../types/tuple.hpp"
+
+#include "../../block/block_load.hpp"
+#include "../../block/block_reduce.hpp"
+
+#include "device_reduce.hpp"
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+// A reduction of multi_reduce is a tuple of (transform, reduce_op, initial_value), its
+// accumulator type is the type of the initial value.
+template<size_t Index, class Reductions>
+using multi_reduce_accumulator_t = typename std::decay<typename ::rocprim::tuple_element<
+    2,
+    typename ::rocprim::tuple_element<Index, Reductions>::type>::type>::type;
+
+// Arrays of the partial results of the blocks, one array per reduction
+template<class Reductions,
+         class Indices = ::rocprim::make_index_sequence<::rocprim::tuple_size<Reductions>::value>>
+struct multi_reduce_partials;
+
+template<class Reductions, size_t... Indices>
+struct multi_reduce_partials<Reductions, ::rocprim::index_sequence<Indices...>>
+{
+    using type = ::rocprim::tuple<multi_reduce_accumulator_t<Indices, Reductions>*...>;
+
+    // Size of the partial results of one block
+    static constexpr size_t accumulators_bytes()
+    {
+        const size_t sizes[] = {sizeof(multi_reduce_accumulator_t<Indices, Reductions>)...};
+        size_t       bytes   = 0;
+        for(const size_t size : sizes)
+        {
+            bytes += size;
+        }
+        return bytes;
+    }
+
+    static size_t get_storage_bytes(const size_t count)
+    {
+        const size_t sizes[]
+            = {align_size(count * sizeof(multi_reduce_accumulator_t<Indices, Reductions>))...};
+        size_t bytes = 0;
+        for(const size_t size : sizes)
+        {
+            bytes += size;
+        }
+        return bytes;
+    }
+
+    static type get(void* temporary_storage, const size_t count)
+    {
+        const size_t sizes[]
+            = {align_size(count * sizeof(multi_reduce_accumulator_t<Indices, Reductions>))...};
+        size_t offsets[sizeof...(Indices)];
+        size_t offset = 0;
+        for(size_t i = 0; i < sizeof...(Indices); i++)
+        {
+            offsets[i] = offset;
+            offset += sizes[i];
+        }
+        return type(reinterpret_cast<multi_reduce_accumulator_t<Indices, Reductions>*>(
+            static_cast<char*>(temporary_storage) + offsets[Indices])...);
+    }
+
+    static type advance(const type& partials, const size_t count)
+    {
+        return type((::rocprim::get<Indices>(partials) + count)...);
+    }
+};
+
+// Reduces the values loaded by the block with reduction Index. Only the accumulator of this
+// reduction is live next to the loaded values, so the register use does not grow with the
+// number of reductions, and the block reduction exchanges a single accumulator type.
+template<bool WithInitialValue,
+         class Config,
+         size_t Index,
+         class InputType,
+         unsigned int ItemsPerThread,
+         class OutputIterators,
+         class Reductions>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE
+void multi_reduce_block(const InputType (&values)[ItemsPerThread],
+                        const unsigned int valid_in_block,
+                        const size_t       input_size,
+                        OutputIterators    outputs,
+                        const Reductions&  reductions)
+{
+    static constexpr reduce_config_params params = device_params<Config>();
+
+    constexpr unsigned int block_size      = params.block_size;
+    constexpr unsigned int items_per_block = block_size * ItemsPerThread;
+
+    using accumulator_type = multi_reduce_accumulator_t<Index, Reductions>;
+    using block_reduce_type
+        = ::rocprim::block_reduce<accumulator_type, block_size, params.block_reduce_method>;
+
+    ROCPRIM_SHARED_MEMORY typename block_reduce_type::storage_type storage;
+
+    const auto& reduction    = ::rocprim::get<Index>(reductions);
+    const auto& transform_op = ::rocprim::get<0>(reduction);
+    const auto& reduce_op    = ::rocprim::get<1>(reduction);
+
+    const unsigned int flat_id       = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int flat_block_id = ::rocprim::detail::block_id<0>();
+
+    accumulator_type output_value;
+    if(valid_in_block == items_per_block)
+    {
+        output_value = static_cast<accumulator_type>(transform_op(values[0]));
+        ROCPRIM_UNROLL
+        for(unsigned int i = 1; i < ItemsPerThread; i++)
+        {
+            output_value
+                = reduce_op(output_value, static_cast<accumulator_type>(transform_op(values[i])));
+        }
+        block_reduce_type().reduce(output_value, output_value, storage, reduce_op);
+    }
+    else
+    {
+        // The transform is only applied to loaded values
+        if(flat_id < valid_in_block)
+        {
+            output_value = static_cast<accumulator_type>(transform_op(values[0]));
+        }
+        ROCPRIM_UNROLL
+        for(unsigned int i = 1; i < ItemsPerThread; i++)
+        {
+            if(flat_id + i * block_size < valid_in_block)
+            {
+                output_value = reduce_op(output_value,
+                                         static_cast<accumulator_type>(transform_op(values[i])));
+            }
+        }
+        block_reduce_type().reduce(output_value,
+                                   output_value,
+                                   valid_in_block,
+                                   storage,
+                                   reduce_op);
+    }
+
+    if(flat_id == 0)
+    {
+        const accumulator_type initial_value
+            = static_cast<accumulator_type>(::rocprim::get<2>(reduction));
+        ::rocprim::get<Index>(outputs)[flat_block_id]
+            = input_size == 0
+                  ? initial_value
+                  : reduce_with_initial<WithInitialValue>(output_value, initial_value, reduce_op);
+    }
+}
+
+template<bool WithInitialValue,
+         class Config,
+         class InputIterator,
+         class OutputIterators,
+         class Reductions,
+         size_t... Indices>
+ROCPRIM_DEVICE ROCPRIM_FORCE_INLINE
+void multi_reduce_kernel_impl(InputIterator input,
+                              const size_t  input_size,
+                              OutputIterators outputs,
+                              const Reductions& reductions,
+                              ::rocprim::index_sequence<Indices...>)
+{
+    static constexpr reduce_config_params params = device_params<Config>();
+
+    constexpr unsigned int block_size       = params.block_size;
+    constexpr unsigned int items_per_thread = params.items_per_thread;
+    constexpr unsigned int items_per_block  = block_size * items_per_thread;
+
+    // The input is loaded once, the reductions transform the loaded values
+    using input_type = typename std::iterator_traits<InputIterator>::value_type;
+
+    const unsigned int flat_id       = ::rocprim::detail::block_thread_id<0>();
+    const unsigned int flat_block_id = ::rocprim::detail::block_id<0>();
+    const unsigned int block_offset  = flat_block_id * items_per_block;
+    const unsigned int valid_in_block
+        = ::rocprim::min<size_t>(input_size - block_offset, items_per_block);
+
+    input_type values[items_per_thread];
+    if(valid_in_block == items_per_block)
+    {
+        block_load_direct_striped<block_size>(flat_id, input + block_offset, values);
+    }
+    else
+    {
+        block_load_direct_striped<block_size>(flat_id,
+                                              input + block_offset,
+                                              values,
+                                              valid_in_block);
+    }
+
+    auto swallow = {(multi_reduce_block<WithInitialValue, Config, Indices>(values,
+                                                                          valid_in_block,
+                                                                          input_size,
+                                                                          outputs,
+                                                                          reductions),
+                     0)...};
+    (void)swallow;
+}
+
+} // end of detail namespace
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DETAIL_DEVICE_TRANSFORM_REDUCE_HPP_
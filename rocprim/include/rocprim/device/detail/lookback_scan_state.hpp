@@ -98,7 +98,7 @@ public:
 
     // temp_storage must point to allocation of get_storage_size(number_of_blocks) bytes
     ROCPRIM_HOST static inline
-    lookback_scan_state create(void* temp_storage, const unsigned int number_of_blocks)
+    lookback_scan_state create(void* temp_storage, const size_t number_of_blocks)
     {
         (void) number_of_blocks;
         lookback_scan_state state;
@@ -107,14 +107,14 @@ public:
     }
 
     ROCPRIM_HOST static inline
-    size_t get_storage_size(const unsigned int number_of_blocks)
+    size_t get_storage_size(const size_t number_of_blocks)
     {
         return sizeof(prefix_underlying_type) * (::rocprim::host_warp_size() + number_of_blocks);
     }
 
     ROCPRIM_DEVICE ROCPRIM_INLINE
-    void initialize_prefix(const unsigned int block_id,
-                           const unsigned int number_of_blocks)
+    void initialize_prefix(const size_t block_id,
+                           const size_t number_of_blocks)
     {
         constexpr unsigned int padding = ::rocprim::device_warp_size();
 
@@ -145,20 +145,20 @@ public:
     }
 
     ROCPRIM_DEVICE ROCPRIM_INLINE
-    void set_partial(const unsigned int block_id, const T value)
+    void set_partial(const size_t block_id, const T value)
     {
         this->set(block_id, PREFIX_PARTIAL, value);
     }
 
     ROCPRIM_DEVICE ROCPRIM_INLINE
-    void set_complete(const unsigned int block_id, const T value)
+    void set_complete(const size_t block_id, const T value)
     {
         this->set(block_id, PREFIX_COMPLETE, value);
     }
 
     // block_id must be > 0
     ROCPRIM_DEVICE ROCPRIM_INLINE
-    void get(const unsigned int block_id, flag_type& flag, T& value)
+    void get(const size_t block_id, flag_type& flag, T& value)
     {
         constexpr unsigned int padding = ::rocprim::device_warp_size();
 
@@ -202,7 +202,7 @@ public:
 
 private:
     ROCPRIM_DEVICE ROCPRIM_INLINE
-    void set(const unsigned int block_id, const flag_type flag, const T value)
+    void set(const size_t block_id, const flag_type flag, const T value)
     {
         constexpr unsigned int padding = ::rocprim::device_warp_size();
 
@@ -231,7 +231,7 @@ public:
 
     // temp_storage must point to allocation of get_storage_size(number_of_blocks) bytes
     ROCPRIM_HOST static inline
-    lookback_scan_state create(void* temp_storage, const unsigned int number_of_blocks)
+    lookback_scan_state create(void* temp_storage, const size_t number_of_blocks)
     {
         const auto n = ::rocprim::host_warp_size() + number_of_blocks;
         lookback_scan_state state;
@@ -249,7 +249,7 @@ public:
     }
 
     ROCPRIM_HOST static inline
-    size_t get_storage_size(const unsigned int number_of_blocks)
+    size_t get_storage_size(const size_t number_of_blocks)
     {
         const auto n = ::rocprim::host_warp_size() + number_of_blocks;
         size_t size = ::rocprim::detail::align_size(n * sizeof(flag_type));
@@ -258,8 +258,8 @@ public:
     }
 
     ROCPRIM_DEVICE ROCPRIM_INLINE
-    void initialize_prefix(const unsigned int block_id,
-                           const unsigned int number_of_blocks)
+    void initialize_prefix(const size_t block_id,
+                           const size_t number_of_blocks)
     {
         constexpr unsigned int padding = ::rocprim::device_warp_size();
         if(block_id < number_of_blocks)
@@ -273,7 +273,7 @@ public:
     }
 
     ROCPRIM_DEVICE ROCPRIM_INLINE
-    void set_partial(const unsigned int block_id, const T value)
+    void set_partial(const size_t block_id, const T value)
     {
         constexpr unsigned int padding = ::rocprim::device_warp_size();
 
@@ -283,7 +283,7 @@ public:
     }
 
     ROCPRIM_DEVICE ROCPRIM_INLINE
-    void set_complete(const unsigned int block_id, const T value)
+    void set_complete(const size_t block_id, const T value)
     {
         constexpr unsigned int padding = ::rocprim::device_warp_size();
 
@@ -294,7 +294,7 @@ public:
 
     // block_id must be > 0
     ROCPRIM_DEVICE ROCPRIM_INLINE
-    void get(const unsigned int block_id, flag_type& flag, T& value)
+    void get(const size_t block_id, flag_type& flag, T& value)
     {
         constexpr unsigned int padding = ::rocprim::device_warp_size();
 
@@ -348,7 +348,7 @@ class lookback_scan_prefix_op
 
 public:
     ROCPRIM_DEVICE ROCPRIM_INLINE
-    lookback_scan_prefix_op(unsigned int block_id,
+    lookback_scan_prefix_op(size_t block_id,
                             BinaryFunction scan_op,
                             LookbackScanState &scan_state)
         : block_id_(block_id),
@@ -361,7 +361,7 @@ public:
     ~lookback_scan_prefix_op() = default;
 
     ROCPRIM_DEVICE ROCPRIM_INLINE
-    void reduce_partial_prefixes(unsigned int block_id,
+    void reduce_partial_prefixes(size_t block_id,
                                  flag_type& flag,
                                  T& partial_prefix)
     {
@@ -393,7 +393,7 @@ public:
     {
         flag_type flag;
         T partial_prefix;
-        unsigned int previous_block_id = block_id_ - ::rocprim::lane_id() - 1;
+        size_t previous_block_id = block_id_ - ::rocprim::lane_id() - 1;
 
         // reduce last warp_size() number of prefixes to
         // get the complete prefix for this block.
@@ -431,7 +431,7 @@ public:
     }
 
 protected:
-    unsigned int       block_id_;
+    size_t             block_id_;
     BinaryFunction     scan_op_;
     LookbackScanState& scan_state_;
 };
@@ -512,7 +512,7 @@ private:
 public:
     using storage_type = typename factory::storage_type;
 
-    ROCPRIM_DEVICE ROCPRIM_INLINE offset_lookback_scan_prefix_op(unsigned int       block_id,
+    ROCPRIM_DEVICE ROCPRIM_INLINE offset_lookback_scan_prefix_op(size_t             block_id,
                                                                  LookbackScanState& state,
                                                                  storage_type&      storage,
                                                                  BinaryOp binary_op = BinaryOp())
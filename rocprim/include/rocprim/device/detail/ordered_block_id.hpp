@@ -80,6 +80,10 @@ struct ordered_block_id
     id_type* id;
 };
 
+// Type of the ordered tile ids of single-pass look-back kernels. It is 64-bit, so that inputs
+// of any size are processed by a single launch.
+using lookback_tile_id_type = unsigned long long;
+
 } // end of detail namespace
 
 END_ROCPRIM_NAMESPACE
@@ -34,6 +34,7 @@
 #include "../detail/various.hpp"
 #include "../iterator/counting_iterator.hpp"
 #include "../iterator/transform_iterator.hpp"
+#include "device_trace.hpp"
 
 #include <hip/hip_runtime.h>
 
@@ -56,6 +57,7 @@ BEGIN_ROCPRIM_NAMESPACE
         auto _error = hipGetLastError();                                                         \
         if(_error != hipSuccess)                                                                 \
             return _error;                                                                       \
+        ::rocprim::detail::kernel_trace_end(name, size, stream);                                 \
         if(debug_synchronous)                                                                    \
         {                                                                                        \
             std::cout << name << "(" << size << ")";                                             \
@@ -76,38 +78,53 @@ template <typename Config,
           typename InputIt,
           typename OutputIt,
           typename BinaryFunction>
-void ROCPRIM_KERNEL __launch_bounds__(Config::block_size) adjacent_difference_kernel(
-    const InputIt                                             input,
-    const OutputIt                                            output,
-    const std::size_t                                         size,
-    const BinaryFunction                                      op,
-    const typename std::iterator_traits<InputIt>::value_type* previous_values,
-    const std::size_t                                         starting_block)
+void ROCPRIM_KERNEL
+    __launch_bounds__(device_target_arch_config_t<Config>::block_size) adjacent_difference_kernel(
+        const InputIt                                             input,
+        const OutputIt                                            output,
+        const std::size_t                                         size,
+        const BinaryFunction                                      op,
+        const typename std::iterator_traits<InputIt>::value_type* previous_values,
+        const std::size_t                                         starting_block)
 {
-    adjacent_difference_kernel_impl<Config, InPlace, Right>(
+    adjacent_difference_kernel_impl<device_target_arch_config_t<Config>, InPlace, Right>(
         input, output, size, op, previous_values, starting_block);
 }
 
+// Reads every stride-th item of base. The stride is a member, so the transform copying the
+// predecessors of the blocks is the same for the configs of all architectures.
+template <typename InputIt>
+struct strided_read_op
+{
+    InputIt     base;
+    std::size_t stride;
+
+    ROCPRIM_HOST_DEVICE ROCPRIM_INLINE
+    typename std::iterator_traits<InputIt>::value_type operator()(const std::size_t i) const
+    {
+        return base[i * stride];
+    }
+};
+
 template <typename Config,
+          typename ArchConfig,
           bool InPlace,
           bool Right,
           typename InputIt,
           typename OutputIt,
           typename BinaryFunction>
-hipError_t adjacent_difference_impl(void* const          temporary_storage,
-                                    std::size_t&         storage_size,
-                                    const InputIt        input,
-                                    const OutputIt       output,
-                                    const std::size_t    size,
-                                    const BinaryFunction op,
-                                    const hipStream_t    stream,
-                                    const bool           debug_synchronous)
+hipError_t adjacent_difference_arch_impl(void* const          temporary_storage,
+                                         std::size_t&         storage_size,
+                                         const InputIt        input,
+                                         const OutputIt       output,
+                                         const std::size_t    size,
+                                         const BinaryFunction op,
+                                         const hipStream_t    stream,
+                                         const bool           debug_synchronous)
 {
     using value_type = typename std::iterator_traits<InputIt>::value_type;
 
-    using config = detail::default_or_custom_config<
-        Config,
-        detail::default_adjacent_difference_config<ROCPRIM_TARGET_ARCH, value_type>>;
+    using config = ArchConfig;
 
     static constexpr unsigned int block_size       = config::block_size;
     static constexpr unsigned int items_per_thread = config::items_per_thread;
@@ -145,9 +162,9 @@ hipError_t adjacent_difference_impl(void* const          temporary_storage,
         // next block, otherwise the first item is needed for the previous block
         static constexpr auto offset = items_per_block - (Right ? 0 : 1);
 
-        const auto block_starts_iter = make_transform_iterator(
-            rocprim::make_counting_iterator(std::size_t {0}),
-            [base = input + offset](std::size_t i) { return base[i * items_per_block]; });
+        const auto block_starts_iter
+            = make_transform_iterator(rocprim::make_counting_iterator(std::size_t {0}),
+                                      strided_read_op<InputIt> {input + offset, items_per_block});
 
         const hipError_t error = ::rocprim::transform(block_starts_iter,
                                                       previous_values,
@@ -196,7 +213,7 @@ hipError_t adjacent_difference_impl(void* const          temporary_storage,
 
             start = std::chrono::high_resolution_clock::now();
         }
-        hipLaunchKernelGGL(HIP_KERNEL_NAME(adjacent_difference_kernel<config, InPlace, Right>),
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(adjacent_difference_kernel<Config, InPlace, Right>),
                            dim3(current_blocks),
                            dim3(block_size),
                            0,
@@ -212,6 +229,45 @@ hipError_t adjacent_difference_impl(void* const          temporary_storage,
     }
     return hipSuccess;
 }
+
+template <typename Config,
+          bool InPlace,
+          bool Right,
+          typename InputIt,
+          typename OutputIt,
+          typename BinaryFunction>
+hipError_t adjacent_difference_impl(void* const          temporary_storage,
+                                    std::size_t&         storage_size,
+                                    const InputIt        input,
+                                    const OutputIt       output,
+                                    const std::size_t    size,
+                                    const BinaryFunction op,
+                                    const hipStream_t    stream,
+                                    const bool           debug_synchronous)
+{
+    using value_type = typename std::iterator_traits<InputIt>::value_type;
+
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = wrapped_adjacent_difference_config<Config, value_type>;
+
+    return dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            return adjacent_difference_arch_impl<config,
+                                                 typename decltype(arch_config)::type,
+                                                 InPlace,
+                                                 Right>(
+                temporary_storage,
+                storage_size,
+                input,
+                output,
+                size,
+                op,
+                stream,
+                debug_synchronous);
+        });
+}
 } // namespace detail
 
 #undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
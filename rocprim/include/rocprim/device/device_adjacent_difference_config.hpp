@@ -74,6 +74,18 @@ struct default_adjacent_difference_config
 {
 };
 
+// Config of adjacent_difference and its variants per target architecture.
+template<class Config, class Value>
+struct wrapped_adjacent_difference_config
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        using type
+            = arch_config_t<Config, default_adjacent_difference_config<static_cast<unsigned int>(Arch), Value>>;
+    };
+};
+
 } // end namespace detail
 
 END_ROCPRIM_NAMESPACE
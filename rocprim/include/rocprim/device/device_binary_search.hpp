@@ -23,13 +23,17 @@
 
 #include <type_traits>
 #include <iterator>
+#include <chrono>
+#include <iostream>
 
 #include "../config.hpp"
 #include "../detail/various.hpp"
 
 #include "detail/device_binary_search.hpp"
 
+#include "device_merge_config.hpp"
 #include "device_transform.hpp"
+#include "device_trace.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -83,6 +87,194 @@ hipError_t binary_search(void * temporary_storage,
     );
 }
 
+#define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start) \
+    { \
+        auto _error = hipGetLastError(); \
+        if(_error != hipSuccess) return _error; \
+        ::rocprim::detail::kernel_trace_end(name, size, stream); \
+        if(debug_synchronous) \
+        { \
+            std::cout << name << "(" << size << ")"; \
+            auto __error = hipStreamSynchronize(stream); \
+            if(__error != hipSuccess) return __error; \
+            auto _end = std::chrono::high_resolution_clock::now(); \
+            auto _d = std::chrono::duration_cast<std::chrono::duration<double>>(_end - start); \
+            std::cout << " " << _d.count() * 1000 << " ms" << '\n'; \
+        } \
+    }
+
+template<
+    class HaystackIterator,
+    class NeedlesIterator,
+    class SearchOp,
+    class CompareOp
+>
+ROCPRIM_KERNEL
+void sorted_search_partition_kernel(size_t * indices,
+                                    HaystackIterator haystack,
+                                    NeedlesIterator needles,
+                                    const size_t haystack_size,
+                                    const size_t needles_size,
+                                    const size_t partitions,
+                                    const unsigned int spacing,
+                                    SearchOp search_op,
+                                    CompareOp compare_op)
+{
+    sorted_search_partition_kernel_impl(
+        indices, haystack, needles, haystack_size, needles_size,
+        partitions, spacing, search_op, compare_op
+    );
+}
+
+template<
+    class Config,
+    class HaystackIterator,
+    class NeedlesIterator,
+    class OutputIterator,
+    class SearchOp,
+    class CompareOp
+>
+ROCPRIM_KERNEL
+__launch_bounds__(device_target_arch_config_t<Config>::block_size)
+void sorted_search_kernel(const size_t * indices,
+                          HaystackIterator haystack,
+                          NeedlesIterator needles,
+                          OutputIterator output,
+                          const size_t haystack_size,
+                          const size_t needles_size,
+                          SearchOp search_op,
+                          CompareOp compare_op)
+{
+    using config = device_target_arch_config_t<Config>;
+    sorted_search_kernel_impl<config::block_size, config::items_per_thread>(
+        indices, haystack, needles, output,
+        haystack_size, needles_size, search_op, compare_op
+    );
+}
+
+template<
+    class Config,
+    class ArchConfig,
+    class HaystackIterator,
+    class NeedlesIterator,
+    class OutputIterator,
+    class SearchOp,
+    class CompareOp
+>
+inline
+hipError_t sorted_search_arch_impl(void * temporary_storage,
+                                   size_t& storage_size,
+                                   HaystackIterator haystack,
+                                   NeedlesIterator needles,
+                                   OutputIterator output,
+                                   size_t haystack_size,
+                                   size_t needles_size,
+                                   SearchOp search_op,
+                                   CompareOp compare_op,
+                                   hipStream_t stream,
+                                   bool debug_synchronous)
+{
+    using config = ArchConfig;
+
+    static constexpr unsigned int block_size = config::block_size;
+    static constexpr unsigned int items_per_thread = config::items_per_thread;
+    static constexpr unsigned int items_per_block = block_size * items_per_thread;
+
+    const size_t partitions = ceiling_div(haystack_size + needles_size, items_per_block);
+    const size_t partition_bytes = (partitions + 1) * sizeof(size_t);
+
+    if(temporary_storage == nullptr)
+    {
+        // storage_size is never zero
+        storage_size = partition_bytes;
+        return hipSuccess;
+    }
+
+    if(needles_size == 0)
+        return hipSuccess;
+
+    // Start point for time measurements
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(debug_synchronous)
+    {
+        std::cout << "block_size " << block_size << '\n';
+        std::cout << "number of blocks " << partitions << '\n';
+        std::cout << "items_per_block " << items_per_block << '\n';
+    }
+
+    size_t * indices = reinterpret_cast<size_t *>(temporary_storage);
+
+    const size_t partition_blocks = ceiling_div(partitions + 1, block_size);
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(detail::sorted_search_partition_kernel),
+        dim3(partition_blocks), dim3(block_size), 0, stream,
+        indices, haystack, needles, haystack_size, needles_size,
+        partitions, items_per_block, search_op, compare_op
+    );
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("sorted_search_partition_kernel", partitions + 1, start);
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(detail::sorted_search_kernel<Config>),
+        dim3(partitions), dim3(block_size), 0, stream,
+        indices, haystack, needles, output,
+        haystack_size, needles_size, search_op, compare_op
+    );
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("sorted_search_kernel", haystack_size + needles_size, start);
+
+    return hipSuccess;
+}
+
+template<
+    class Config,
+    class HaystackIterator,
+    class NeedlesIterator,
+    class OutputIterator,
+    class SearchOp,
+    class CompareOp
+>
+inline
+hipError_t sorted_search(void * temporary_storage,
+                         size_t& storage_size,
+                         HaystackIterator haystack,
+                         NeedlesIterator needles,
+                         OutputIterator output,
+                         size_t haystack_size,
+                         size_t needles_size,
+                         SearchOp search_op,
+                         CompareOp compare_op,
+                         hipStream_t stream,
+                         bool debug_synchronous)
+{
+    using needle_type = typename std::iterator_traits<NeedlesIterator>::value_type;
+
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = wrapped_merge_config<Config, needle_type, empty_type>;
+
+    return dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            return sorted_search_arch_impl<config, typename decltype(arch_config)::type>(
+                temporary_storage,
+                storage_size,
+                haystack,
+                needles,
+                output,
+                haystack_size,
+                needles_size,
+                search_op,
+                compare_op,
+                stream,
+                debug_synchronous);
+        });
+}
+
+#undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
+
 } // end of detail namespace
 
 template<
@@ -169,6 +361,204 @@ hipError_t binary_search(void * temporary_storage,
     );
 }
 
+/// \brief Parallel lower bound search for sorted needles.
+///
+/// Same as <tt>lower_bound</tt>, but requires the needles to be sorted with respect to
+/// \p compare_op as well. Both sequences are partitioned into tiles of their merged order,
+/// and each block merges its tile of the haystack with its tile of needles in shared memory.
+/// In contrast to the independent binary search of every needle, this takes
+/// <tt>O(haystack_size + needles_size)</tt> work with coalesced memory accesses only, so it
+/// is the better choice when the needles are not much sparser than the haystack.
+///
+/// \par Overview
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage is a null pointer.
+/// * Ranges specified by \p haystack and \p needles must be sorted with respect to \p compare_op.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p merge_config or
+/// a custom class with the same members.
+/// \tparam HaystackIterator - random-access iterator type of the haystack.
+/// \tparam NeedlesIterator - random-access iterator type of the needles.
+/// \tparam OutputIterator - random-access iterator type of the output, receiving the index of the first haystack element that does not compare less than the needle.
+/// \tparam CompareFunction - type of binary function used for comparisons. Default type
+/// is \p rocprim::less<>.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the search.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] haystack - iterator to the first element in the sorted range to search in.
+/// \param [in] needles - iterator to the first element in the sorted range of values to search for.
+/// \param [out] output - iterator to the first element in the range of results.
+/// \param [in] haystack_size - number of elements in the haystack.
+/// \param [in] needles_size - number of needles (and results).
+/// \param [in] compare_op - binary function used for comparisons. Default is \p rocprim::less<>.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful search; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<
+    class Config = default_config,
+    class HaystackIterator,
+    class NeedlesIterator,
+    class OutputIterator,
+    class CompareFunction = ::rocprim::less<>
+>
+inline
+hipError_t sorted_lower_bound(void * temporary_storage,
+                                   size_t& storage_size,
+                                   HaystackIterator haystack,
+                                   NeedlesIterator needles,
+                                   OutputIterator output,
+                                   size_t haystack_size,
+                                   size_t needles_size,
+                                   CompareFunction compare_op = CompareFunction(),
+                                   hipStream_t stream = 0,
+                                   bool debug_synchronous = false)
+{
+    return detail::sorted_search<Config>(
+        temporary_storage, storage_size,
+        haystack, needles, output,
+        haystack_size, needles_size,
+        detail::lower_bound_search_op(), compare_op,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief Parallel upper bound search for sorted needles.
+///
+/// Same as <tt>upper_bound</tt>, but requires the needles to be sorted with respect to
+/// \p compare_op as well. Both sequences are partitioned into tiles of their merged order,
+/// and each block merges its tile of the haystack with its tile of needles in shared memory.
+/// In contrast to the independent binary search of every needle, this takes
+/// <tt>O(haystack_size + needles_size)</tt> work with coalesced memory accesses only, so it
+/// is the better choice when the needles are not much sparser than the haystack.
+///
+/// \par Overview
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage is a null pointer.
+/// * Ranges specified by \p haystack and \p needles must be sorted with respect to \p compare_op.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p merge_config or
+/// a custom class with the same members.
+/// \tparam HaystackIterator - random-access iterator type of the haystack.
+/// \tparam NeedlesIterator - random-access iterator type of the needles.
+/// \tparam OutputIterator - random-access iterator type of the output, receiving the index of the first haystack element that compares greater than the needle.
+/// \tparam CompareFunction - type of binary function used for comparisons. Default type
+/// is \p rocprim::less<>.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the search.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] haystack - iterator to the first element in the sorted range to search in.
+/// \param [in] needles - iterator to the first element in the sorted range of values to search for.
+/// \param [out] output - iterator to the first element in the range of results.
+/// \param [in] haystack_size - number of elements in the haystack.
+/// \param [in] needles_size - number of needles (and results).
+/// \param [in] compare_op - binary function used for comparisons. Default is \p rocprim::less<>.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful search; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<
+    class Config = default_config,
+    class HaystackIterator,
+    class NeedlesIterator,
+    class OutputIterator,
+    class CompareFunction = ::rocprim::less<>
+>
+inline
+hipError_t sorted_upper_bound(void * temporary_storage,
+                                   size_t& storage_size,
+                                   HaystackIterator haystack,
+                                   NeedlesIterator needles,
+                                   OutputIterator output,
+                                   size_t haystack_size,
+                                   size_t needles_size,
+                                   CompareFunction compare_op = CompareFunction(),
+                                   hipStream_t stream = 0,
+                                   bool debug_synchronous = false)
+{
+    return detail::sorted_search<Config>(
+        temporary_storage, storage_size,
+        haystack, needles, output,
+        haystack_size, needles_size,
+        detail::upper_bound_search_op(), compare_op,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief Parallel binary search for sorted needles.
+///
+/// Same as <tt>binary_search</tt>, but requires the needles to be sorted with respect to
+/// \p compare_op as well. Both sequences are partitioned into tiles of their merged order,
+/// and each block merges its tile of the haystack with its tile of needles in shared memory.
+/// In contrast to the independent binary search of every needle, this takes
+/// <tt>O(haystack_size + needles_size)</tt> work with coalesced memory accesses only, so it
+/// is the better choice when the needles are not much sparser than the haystack.
+///
+/// \par Overview
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage is a null pointer.
+/// * Ranges specified by \p haystack and \p needles must be sorted with respect to \p compare_op.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p merge_config or
+/// a custom class with the same members.
+/// \tparam HaystackIterator - random-access iterator type of the haystack.
+/// \tparam NeedlesIterator - random-access iterator type of the needles.
+/// \tparam OutputIterator - random-access iterator type of the output, receiving whether the needle is present in the haystack.
+/// \tparam CompareFunction - type of binary function used for comparisons. Default type
+/// is \p rocprim::less<>.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the search.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] haystack - iterator to the first element in the sorted range to search in.
+/// \param [in] needles - iterator to the first element in the sorted range of values to search for.
+/// \param [out] output - iterator to the first element in the range of results.
+/// \param [in] haystack_size - number of elements in the haystack.
+/// \param [in] needles_size - number of needles (and results).
+/// \param [in] compare_op - binary function used for comparisons. Default is \p rocprim::less<>.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful search; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<
+    class Config = default_config,
+    class HaystackIterator,
+    class NeedlesIterator,
+    class OutputIterator,
+    class CompareFunction = ::rocprim::less<>
+>
+inline
+hipError_t sorted_binary_search(void * temporary_storage,
+                                     size_t& storage_size,
+                                     HaystackIterator haystack,
+                                     NeedlesIterator needles,
+                                     OutputIterator output,
+                                     size_t haystack_size,
+                                     size_t needles_size,
+                                     CompareFunction compare_op = CompareFunction(),
+                                     hipStream_t stream = 0,
+                                     bool debug_synchronous = false)
+{
+    return detail::sorted_search<Config>(
+        temporary_storage, storage_size,
+        haystack, needles, output,
+        haystack_size, needles_size,
+        detail::binary_search_op(), compare_op,
+        stream, debug_synchronous
+    );
+}
+
 /// @}
 // end of group devicemodule
 
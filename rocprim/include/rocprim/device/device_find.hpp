@@ -0,0 +1,641 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_FIND_HPP_
+#define ROCPRIM_DEVICE_DEVICE_FIND_HPP_
+
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../functional.hpp"
+#include "../detail/various.hpp"
+
+#include "config_types.hpp"
+#include "detail/device_find.hpp"
+#include "device_transform.hpp"
+#include "device_transform_config.hpp"
+#include "device_trace.hpp"
+
+/// \file
+///
+/// Device level find primitives
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule
+/// @{
+
+namespace detail
+{
+
+template<class Result>
+ROCPRIM_KERNEL __launch_bounds__(1) void find_first_init_kernel(Result* result, const size_t not_found)
+{
+    find_first_init_kernel_impl(result, not_found);
+}
+
+template<class Config, class FlagOp>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::block_size) void find_first_kernel(
+    FlagOp flag_op, const size_t size, unsigned long long* result)
+{
+    find_first_kernel_impl<device_target_arch_config_t<Config>>(flag_op, size, result);
+}
+
+#define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start)                           \
+    {                                                                                            \
+        auto _error = hipGetLastError();                                                         \
+        if(_error != hipSuccess)                                                                 \
+            return _error;                                                                       \
+        ::rocprim::detail::kernel_trace_end(name, size, stream);                                 \
+        if(debug_synchronous)                                                                    \
+        {                                                                                        \
+            std::cout << name << "(" << size << ")";                                             \
+            auto __error = hipStreamSynchronize(stream);                                         \
+            if(__error != hipSuccess)                                                            \
+                return __error;                                                                  \
+            auto _end = std::chrono::high_resolution_clock::now();                               \
+            auto _d   = std::chrono::duration_cast<std::chrono::duration<double>>(_end - start); \
+            std::cout << " " << _d.count() * 1000 << " ms" << '\n';                              \
+        }                                                                                        \
+    }
+
+// Number of resident blocks per multiprocessor the grid of find_first_kernel is limited to.
+// Blocks of a smaller grid finish their tiles in order, so the search stops soon after a hit.
+static constexpr unsigned int find_first_blocks_per_processor = 8;
+
+inline hipError_t find_first_multiprocessor_count(const hipStream_t stream, int& count)
+{
+    int device_id;
+#ifdef WIN32
+    (void)stream;
+    hipError_t result = hipGetDevice(&device_id);
+#else
+    hipError_t result = get_device_from_stream(stream, device_id);
+#endif
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    return hipDeviceGetAttribute(&count, hipDeviceAttributeMultiprocessorCount, device_id);
+}
+
+template<class Config, class ArchConfig, class FlagOp, class OutputIterator>
+inline hipError_t find_first_arch_impl(void*             temporary_storage,
+                                       size_t&           storage_size,
+                                       FlagOp            flag_op,
+                                       OutputIterator    output,
+                                       const size_t      search_size,
+                                       const size_t      not_found,
+                                       const hipStream_t stream,
+                                       const bool        debug_synchronous)
+{
+    using config = ArchConfig;
+
+    constexpr unsigned int block_size     = config::block_size;
+    constexpr unsigned int items_per_tile = block_size * config::items_per_thread;
+
+    const size_t result_bytes = align_size(sizeof(unsigned long long));
+    if(temporary_storage == nullptr)
+    {
+        // storage_size is never zero
+        storage_size = result_bytes;
+        return hipSuccess;
+    }
+
+    auto* result = static_cast<unsigned long long*>(temporary_storage);
+
+    int        multiprocessor_count;
+    hipError_t error = find_first_multiprocessor_count(stream, multiprocessor_count);
+    if(error != hipSuccess)
+    {
+        return error;
+    }
+
+    const size_t       number_of_tiles = ceiling_div(search_size, items_per_tile);
+    const unsigned int grid_size       = static_cast<unsigned int>(
+        ::rocprim::min<size_t>(number_of_tiles,
+                               static_cast<size_t>(multiprocessor_count)
+                                   * find_first_blocks_per_processor));
+
+    if(debug_synchronous)
+    {
+        std::cout << "search_size:     " << search_size << '\n';
+        std::cout << "block_size:      " << block_size << '\n';
+        std::cout << "items_per_tile:  " << items_per_tile << '\n';
+        std::cout << "number_of_tiles: " << number_of_tiles << '\n';
+        std::cout << "grid_size:       " << grid_size << '\n';
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(debug_synchronous)
+        start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(find_first_init_kernel<unsigned long long>),
+                       dim3(1),
+                       dim3(1),
+                       0,
+                       stream,
+                       result,
+                       not_found);
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("find_first_init_kernel", 1, start);
+
+    if(grid_size > 0)
+    {
+        if(debug_synchronous)
+            start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(find_first_kernel<Config>),
+                           dim3(grid_size),
+                           dim3(block_size),
+                           0,
+                           stream,
+                           flag_op,
+                           search_size,
+                           result);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("find_first_kernel", search_size, start);
+    }
+
+    return ::rocprim::transform(result,
+                                output,
+                                1,
+                                ::rocprim::identity<>{},
+                                stream,
+                                debug_synchronous);
+}
+
+template<class Config, class Value, class FlagOp, class OutputIterator>
+inline hipError_t find_first_impl(void*             temporary_storage,
+                                  size_t&           storage_size,
+                                  FlagOp            flag_op,
+                                  OutputIterator    output,
+                                  const size_t      search_size,
+                                  const size_t      not_found,
+                                  const hipStream_t stream,
+                                  const bool        debug_synchronous)
+{
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = wrapped_transform_config<Config, Value>;
+
+    return dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            return find_first_arch_impl<config, typename decltype(arch_config)::type>(
+                temporary_storage,
+                storage_size,
+                flag_op,
+                output,
+                search_size,
+                not_found,
+                stream,
+                debug_synchronous);
+        });
+}
+
+#undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
+
+} // end namespace detail
+
+/// \brief Parallel find_if primitive for device level.
+///
+/// find_if function writes to \p output the index of the first item of the range of \p input
+/// for which \p predicate returns \p true, or \p size if there is no such item. Blocks process
+/// tiles in order and skip all tiles after the first item found so far, so the running time
+/// depends on the position of the first match rather than on \p size.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Range specified by \p input must have at least \p size elements.
+/// * \p predicate may be called for items after the first match.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p transform_config or a custom class with the same members.
+/// \tparam InputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam OutputIterator - random-access iterator type of the output. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam UnaryPredicate - type of unary function object used to test the items.
+/// The signature of the function should be equivalent to the following:
+/// <tt>bool f(const T &a);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the object passed to it.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the search.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to search.
+/// \param [out] output - iterator to the index of the first matching element.
+/// \param [in] size - number of element in the input range.
+/// \param [in] predicate - unary function object returning \p true for the searched items.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful search; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level search for the first negative \p int value is performed.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// auto predicate = [] __device__ (int a) -> bool { return a < 0; };
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size;      // e.g., 8
+/// int * input;            // e.g., [1, 2, 3, -4, 5, -6, 7, 8]
+/// size_t * output;        // empty array of 1 element
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::find_if(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size, predicate
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // search
+/// rocprim::find_if(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size, predicate
+/// );
+/// // output: [3]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class InputIterator,
+         class OutputIterator,
+         class UnaryPredicate>
+inline hipError_t find_if(void*          temporary_storage,
+                          size_t&        storage_size,
+                          InputIterator  input,
+                          OutputIterator output,
+                          size_t         size,
+                          UnaryPredicate predicate,
+                          hipStream_t    stream            = 0,
+                          bool           debug_synchronous = false)
+{
+    using value_type = typename std::iterator_traits<InputIterator>::value_type;
+    using flag_op_type = detail::find_if_flag_op<InputIterator, UnaryPredicate>;
+
+    return detail::find_first_impl<Config, value_type>(temporary_storage,
+                                                       storage_size,
+                                                       flag_op_type{input, predicate},
+                                                       output,
+                                                       size,
+                                                       size,
+                                                       stream,
+                                                       debug_synchronous);
+}
+
+/// \brief Parallel find_first_of primitive for device level.
+///
+/// find_first_of function writes to \p output the index of the first item of the range of
+/// \p input that is equal to any of the items of the range of \p keys, or \p size if there
+/// is no such item. Blocks skip all tiles after the first item found so far.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Range specified by \p input must have at least \p size elements.
+/// * Range specified by \p keys must have at least \p keys_size elements. Every item of
+/// \p input is compared with all keys, so this primitive is intended for short key ranges.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p transform_config or a custom class with the same members.
+/// \tparam InputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysIterator - random-access iterator type of the keys range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam OutputIterator - random-access iterator type of the output. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam BinaryPredicate - type of binary function object used to compare items with keys.
+/// The signature of the function should be equivalent to the following:
+/// <tt>bool f(const T &a, const U &b);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the objects passed to it.
+/// Default is \p rocprim::equal_to<T>.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the search.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to search.
+/// \param [in] keys - iterator to the first element in the range of searched keys.
+/// \param [out] output - iterator to the index of the first matching element.
+/// \param [in] size - number of element in the input range.
+/// \param [in] keys_size - number of element in the keys range.
+/// \param [in] compare_function - binary function object returning \p true if an item
+/// matches a key. Default is \p rocprim::equal_to<T>.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful search; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level search for the first of two \p int values is performed.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size;      // e.g., 8
+/// int * input;            // e.g., [1, 2, 3, 4, 5, 6, 7, 8]
+/// size_t keys_size;       // e.g., 2
+/// int * keys;             // e.g., [7, 5]
+/// size_t * output;        // empty array of 1 element
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::find_first_of(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, keys, output, input_size, keys_size
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // search
+/// rocprim::find_first_of(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, keys, output, input_size, keys_size
+/// );
+/// // output: [4]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class InputIterator,
+         class KeysIterator,
+         class OutputIterator,
+         class BinaryPredicate
+         = ::rocprim::equal_to<typename std::iterator_traits<InputIterator>::value_type>>
+inline hipError_t find_first_of(void*           temporary_storage,
+                                size_t&         storage_size,
+                                InputIterator   input,
+                                KeysIterator    keys,
+                                OutputIterator  output,
+                                size_t          size,
+                                size_t          keys_size,
+                                BinaryPredicate compare_function  = BinaryPredicate(),
+                                hipStream_t     stream            = 0,
+                                bool            debug_synchronous = false)
+{
+    using value_type = typename std::iterator_traits<InputIterator>::value_type;
+    using flag_op_type = detail::find_first_of_flag_op<InputIterator, KeysIterator, BinaryPredicate>;
+
+    // Nothing can match an empty range of keys
+    const size_t search_size = keys_size == 0 ? 0 : size;
+
+    return detail::find_first_impl<Config, value_type>(
+        temporary_storage,
+        storage_size,
+        flag_op_type{input, keys, keys_size, compare_function},
+        output,
+        search_size,
+        size,
+        stream,
+        debug_synchronous);
+}
+
+/// \brief Parallel adjacent_find primitive for device level.
+///
+/// adjacent_find function writes to \p output the index of the first item of the range of
+/// \p input that is equal to the next item, or \p size if there is no such item. Blocks skip
+/// all tiles after the first item found so far.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Range specified by \p input must have at least \p size elements.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p transform_config or a custom class with the same members.
+/// \tparam InputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam OutputIterator - random-access iterator type of the output. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam BinaryPredicate - type of binary function object used to compare adjacent items.
+/// The signature of the function should be equivalent to the following:
+/// <tt>bool f(const T &a, const T &b);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the objects passed to it.
+/// Default is \p rocprim::equal_to<T>.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the search.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to search.
+/// \param [out] output - iterator to the index of the first element of the matching pair.
+/// \param [in] size - number of element in the input range.
+/// \param [in] compare_function - binary function object returning \p true if an item
+/// and the next one match. Default is \p rocprim::equal_to<T>.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful search; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level search for the first pair of equal adjacent \p int values
+/// is performed.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size;      // e.g., 8
+/// int * input;            // e.g., [1, 2, 3, 4, 4, 6, 6, 8]
+/// size_t * output;        // empty array of 1 element
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::adjacent_find(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // search
+/// rocprim::adjacent_find(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size
+/// );
+/// // output: [3]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class InputIterator,
+         class OutputIterator,
+         class BinaryPredicate
+         = ::rocprim::equal_to<typename std::iterator_traits<InputIterator>::value_type>>
+inline hipError_t adjacent_find(void*           temporary_storage,
+                                size_t&         storage_size,
+                                InputIterator   input,
+                                OutputIterator  output,
+                                size_t          size,
+                                BinaryPredicate compare_function  = BinaryPredicate(),
+                                hipStream_t     stream            = 0,
+                                bool            debug_synchronous = false)
+{
+    using value_type = typename std::iterator_traits<InputIterator>::value_type;
+    using flag_op_type = detail::adjacent_find_flag_op<InputIterator, BinaryPredicate>;
+
+    // The last item has no next item to be compared with
+    const size_t search_size = size == 0 ? 0 : size - 1;
+
+    return detail::find_first_impl<Config, value_type>(temporary_storage,
+                                                       storage_size,
+                                                       flag_op_type{input, compare_function},
+                                                       output,
+                                                       search_size,
+                                                       size,
+                                                       stream,
+                                                       debug_synchronous);
+}
+
+/// \brief Parallel mismatch primitive for device level.
+///
+/// mismatch function writes to \p output the index of the first position at which the items
+/// of the ranges of \p input1 and \p input2 differ, or \p size if the ranges are equal.
+/// Blocks skip all tiles after the first mismatch found so far.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p input1 and \p input2 must have at least \p size elements.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p transform_config or a custom class with the same members.
+/// \tparam InputIterator1 - random-access iterator type of the first input range. Must meet
+/// the requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam InputIterator2 - random-access iterator type of the second input range. Must meet
+/// the requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam OutputIterator - random-access iterator type of the output. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam BinaryPredicate - type of binary function object used to compare the items.
+/// The signature of the function should be equivalent to the following:
+/// <tt>bool f(const T &a, const U &b);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the objects passed to it.
+/// Default is \p rocprim::equal_to<T>.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the search.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input1 - iterator to the first element in the first range.
+/// \param [in] input2 - iterator to the first element in the second range.
+/// \param [out] output - iterator to the index of the first mismatch.
+/// \param [in] size - number of element in the input ranges.
+/// \param [in] compare_function - binary function object returning \p true if the items
+/// at the same position match. Default is \p rocprim::equal_to<T>.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful search; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level comparison of two ranges of \p int values is performed.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size;      // e.g., 8
+/// int * input1;           // e.g., [1, 2, 3, 4, 5, 6, 7, 8]
+/// int * input2;           // e.g., [1, 2, 3, 4, 0, 6, 0, 8]
+/// size_t * output;        // empty array of 1 element
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::mismatch(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input1, input2, output, input_size
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // compare
+/// rocprim::mismatch(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input1, input2, output, input_size
+/// );
+/// // output: [4]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class InputIterator1,
+         class InputIterator2,
+         class OutputIterator,
+         class BinaryPredicate
+         = ::rocprim::equal_to<typename std::iterator_traits<InputIterator1>::value_type>>
+inline hipError_t mismatch(void*           temporary_storage,
+                           size_t&         storage_size,
+                           InputIterator1  input1,
+                           InputIterator2  input2,
+                           OutputIterator  output,
+                           size_t          size,
+                           BinaryPredicate compare_function  = BinaryPredicate(),
+                           hipStream_t     stream            = 0,
+                           bool            debug_synchronous = false)
+{
+    using value_type = typename std::iterator_traits<InputIterator1>::value_type;
+    using flag_op_type = detail::mismatch_flag_op<InputIterator1, InputIterator2, BinaryPredicate>;
+
+    return detail::find_first_impl<Config, value_type>(temporary_storage,
+                                                       storage_size,
+                                                       flag_op_type{input1, input2, compare_function},
+                                                       output,
+                                                       size,
+                                                       size,
+                                                       stream,
+                                                       debug_synchronous);
+}
+
+/// @}
+// end of group devicemodule
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_FIND_HPP_
@@ -21,6 +21,7 @@
 #ifndef ROCPRIM_DEVICE_DEVICE_HISTOGRAM_HPP_
 #define ROCPRIM_DEVICE_DEVICE_HISTOGRAM_HPP_
 
+#include <chrono>
 #include <cmath>
 #include <iostream>
 #include <iterator>
@@ -29,9 +30,14 @@
 #include "../config.hpp"
 #include "../detail/various.hpp"
 #include "../functional.hpp"
+#include "../iterator/counting_iterator.hpp"
+#include "../iterator/transform_iterator.hpp"
 
 #include "detail/device_histogram.hpp"
+#include "detail/device_host_native.hpp"
 #include "device_histogram_config.hpp"
+#include "device_radix_sort.hpp"
+#include "device_trace.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -41,22 +47,21 @@ BEGIN_ROCPRIM_NAMESPACE
 namespace detail
 {
 
-template<unsigned int BlockSize, unsigned int ActiveChannels, class Counter>
-ROCPRIM_KERNEL __launch_bounds__(BlockSize) void init_histogram_kernel(
+template<class Config, unsigned int ActiveChannels, class Counter>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::histogram::block_size) void init_histogram_kernel(
     fixed_array<Counter*, ActiveChannels> histogram, fixed_array<unsigned int, ActiveChannels> bins)
 {
-    init_histogram<BlockSize, ActiveChannels>(histogram, bins);
+    using config = device_target_arch_config_t<Config>;
+    init_histogram<config::histogram::block_size, ActiveChannels>(histogram, bins);
 }
 
-template<unsigned int BlockSize,
-         unsigned int ItemsPerThread,
+template<class Config,
          unsigned int Channels,
          unsigned int ActiveChannels,
-         unsigned int SharedHistograms,
          class SampleIterator,
          class Counter,
          class SampleToBinOp>
-ROCPRIM_KERNEL __launch_bounds__(BlockSize) void histogram_shared_kernel(
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::histogram::block_size) void histogram_shared_kernel(
     SampleIterator                             samples,
     unsigned int                               columns,
     unsigned int                               rows,
@@ -66,9 +71,14 @@ ROCPRIM_KERNEL __launch_bounds__(BlockSize) void histogram_shared_kernel(
     fixed_array<SampleToBinOp, ActiveChannels> sample_to_bin_op,
     fixed_array<unsigned int, ActiveChannels>  bins)
 {
+    using config = device_target_arch_config_t<Config>;
     HIP_DYNAMIC_SHARED(unsigned int, block_histogram);
 
-    histogram_shared<BlockSize, ItemsPerThread, Channels, ActiveChannels, SharedHistograms>(
+    histogram_shared<config::histogram::block_size,
+                     config::histogram::items_per_thread,
+                     Channels,
+                     ActiveChannels,
+                     config::shared_impl_histograms>(
         samples,
         columns,
         rows,
@@ -80,14 +90,13 @@ ROCPRIM_KERNEL __launch_bounds__(BlockSize) void histogram_shared_kernel(
         block_histogram);
 }
 
-template<unsigned int BlockSize,
-         unsigned int ItemsPerThread,
+template<class Config,
          unsigned int Channels,
          unsigned int ActiveChannels,
          class SampleIterator,
          class Counter,
          class SampleToBinOp>
-ROCPRIM_KERNEL __launch_bounds__(BlockSize) void histogram_global_kernel(
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::histogram::block_size) void histogram_global_kernel(
     SampleIterator                             samples,
     unsigned int                               columns,
     unsigned int                               row_stride,
@@ -95,12 +104,113 @@ ROCPRIM_KERNEL __launch_bounds__(BlockSize) void histogram_global_kernel(
     fixed_array<SampleToBinOp, ActiveChannels> sample_to_bin_op,
     fixed_array<unsigned int, ActiveChannels>  bins_bits)
 {
-    histogram_global<BlockSize, ItemsPerThread, Channels, ActiveChannels>(samples,
-                                                                          columns,
-                                                                          row_stride,
-                                                                          histogram,
-                                                                          sample_to_bin_op,
-                                                                          bins_bits);
+    using config = device_target_arch_config_t<Config>;
+    histogram_global<config::histogram::block_size,
+                     config::histogram::items_per_thread,
+                     Channels,
+                     ActiveChannels>(samples,
+                                     columns,
+                                     row_stride,
+                                     histogram,
+                                     sample_to_bin_op,
+                                     bins_bits);
+}
+
+template<class Config,
+         unsigned int Channels,
+         unsigned int ActiveChannels,
+         class SampleIterator,
+         class Counter,
+         class SampleToBinOp>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::histogram::block_size) void histogram_tiled_kernel(
+    SampleIterator                             samples,
+    unsigned int                               columns,
+    unsigned int                               rows,
+    unsigned int                               row_stride,
+    unsigned int                               rows_per_block,
+    fixed_array<Counter*, ActiveChannels>      histogram,
+    fixed_array<SampleToBinOp, ActiveChannels> sample_to_bin_op,
+    fixed_array<unsigned int, ActiveChannels>  bins,
+    unsigned int                               tile_bins)
+{
+    using config = device_target_arch_config_t<Config>;
+    HIP_DYNAMIC_SHARED(unsigned int, block_histogram);
+
+    histogram_tiled<config::histogram::block_size,
+                    config::histogram::items_per_thread,
+                    Channels,
+                    ActiveChannels>(samples,
+                                    columns,
+                                    rows,
+                                    row_stride,
+                                    rows_per_block,
+                                    histogram,
+                                    sample_to_bin_op,
+                                    bins,
+                                    tile_bins,
+                                    block_histogram);
+}
+
+template<class Config, class Counter>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::histogram::block_size) void histogram_sorted_runs_kernel(
+    const unsigned int* sorted_bins, size_t size, Counter* histogram, unsigned int bins)
+{
+    histogram_sorted_runs<device_target_arch_config_t<Config>::histogram::block_size>(sorted_bins,
+                                                                                    size,
+                                                                                    histogram,
+                                                                                    bins);
+}
+
+template<class Config,
+         class SampleIterator,
+         class WeightIterator,
+         class Weight,
+         class SampleToBinOp>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::histogram::block_size) void histogram_weighted_shared_kernel(
+    SampleIterator samples,
+    WeightIterator weights,
+    unsigned int   size,
+    Weight*        histogram,
+    SampleToBinOp  sample_to_bin_op,
+    unsigned int   bins,
+    unsigned int   tile_bins)
+{
+    using config = device_target_arch_config_t<Config>;
+    // A single type for the dynamic shared memory of all instantiations, aligned for double
+    HIP_DYNAMIC_SHARED(double, block_histogram_storage);
+
+    histogram_weighted_shared<config::histogram::block_size,
+                              config::histogram::items_per_thread,
+                              config::shared_impl_histograms>(
+        samples,
+        weights,
+        size,
+        histogram,
+        sample_to_bin_op,
+        bins,
+        tile_bins,
+        reinterpret_cast<Weight*>(block_histogram_storage));
+}
+
+template<class Config,
+         class SampleIterator,
+         class WeightIterator,
+         class Weight,
+         class SampleToBinOp>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::histogram::block_size) void histogram_weighted_global_kernel(
+    SampleIterator samples,
+    WeightIterator weights,
+    unsigned int   size,
+    Weight*        histogram,
+    SampleToBinOp  sample_to_bin_op)
+{
+    using config = device_target_arch_config_t<Config>;
+    histogram_weighted_global<config::histogram::block_size,
+                              config::histogram::items_per_thread>(samples,
+                                                                   weights,
+                                                                   size,
+                                                                   histogram,
+                                                                   sample_to_bin_op);
 }
 
 #define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start)                           \
@@ -108,6 +218,7 @@ ROCPRIM_KERNEL __launch_bounds__(BlockSize) void histogram_global_kernel(
         auto _error = hipGetLastError();                                                         \
         if(_error != hipSuccess)                                                                 \
             return _error;                                                                       \
+        ::rocprim::detail::kernel_trace_end(name, size, stream);                                 \
         if(debug_synchronous)                                                                    \
         {                                                                                        \
             std::cout << name << "(" << size << ")";                                             \
@@ -120,34 +231,47 @@ ROCPRIM_KERNEL __launch_bounds__(BlockSize) void histogram_global_kernel(
         }                                                                                        \
     }
 
+// Largest number of bin tiles for which the tiled implementation is used, i.e. the number
+// of times the samples are read. Larger histograms are computed by sorting the bins of the
+// samples (if there are enough samples to amortize the sort) or with global memory atomics.
+static constexpr unsigned int histogram_tiled_max_tiles = 8;
+
 template<unsigned int Channels,
          unsigned int ActiveChannels,
          class Config,
+         class ArchConfig,
          class SampleIterator,
          class Counter,
          class SampleToBinOp>
-inline hipError_t histogram_impl(void*          temporary_storage,
-                                 size_t&        storage_size,
-                                 SampleIterator samples,
-                                 unsigned int   columns,
-                                 unsigned int   rows,
-                                 size_t         row_stride_bytes,
-                                 Counter*       histogram[ActiveChannels],
-                                 unsigned int   levels[ActiveChannels],
-                                 SampleToBinOp  sample_to_bin_op[ActiveChannels],
-                                 hipStream_t    stream,
-                                 bool           debug_synchronous)
+inline hipError_t histogram_arch_impl(void*          temporary_storage,
+                                      size_t&        storage_size,
+                                      SampleIterator samples,
+                                      unsigned int   columns,
+                                      unsigned int   rows,
+                                      size_t         row_stride_bytes,
+                                      Counter*       histogram[ActiveChannels],
+                                      unsigned int   levels[ActiveChannels],
+                                      SampleToBinOp  sample_to_bin_op[ActiveChannels],
+                                      hipStream_t    stream,
+                                      bool           debug_synchronous)
 {
     using sample_type = typename std::iterator_traits<SampleIterator>::value_type;
 
-    using config = default_or_custom_config<
-        Config,
-        default_histogram_config<ROCPRIM_TARGET_ARCH, sample_type, Channels, ActiveChannels>>;
+    using config = ArchConfig;
+
+    using bin_key_op_type = histogram_sample_to_bin_key_op<Channels, SampleIterator, SampleToBinOp>;
+    using bin_key_iterator_type
+        = transform_iterator<counting_iterator<size_t>, bin_key_op_type, unsigned int>;
 
     static constexpr unsigned int block_size       = config::histogram::block_size;
     static constexpr unsigned int items_per_thread = config::histogram::items_per_thread;
     static constexpr unsigned int items_per_block  = block_size * items_per_thread;
 
+    // The tiled implementation uses the shared memory of all shared_impl_histograms histograms
+    // of the shared implementation for a single histogram tile
+    static constexpr unsigned int tile_bins
+        = config::shared_impl_max_bins * config::shared_impl_histograms;
+
     if(row_stride_bytes % sizeof(sample_type) != 0)
     {
         // Row stride must be a whole multiple of the sample data type size
@@ -157,11 +281,59 @@ inline hipError_t histogram_impl(void*          temporary_storage,
     const unsigned int blocks_x   = ::rocprim::detail::ceiling_div(columns, items_per_block);
     const unsigned int row_stride = row_stride_bytes / sizeof(sample_type);
 
+    unsigned int bins[ActiveChannels];
+    unsigned int bins_bits[ActiveChannels];
+    unsigned int total_bins = 0;
+    unsigned int max_bins   = 0;
+    for(unsigned int channel = 0; channel < ActiveChannels; channel++)
+    {
+        bins[channel] = levels[channel] - 1;
+        bins_bits[channel]
+            = static_cast<unsigned int>(std::log2(detail::next_power_of_two(bins[channel])));
+        total_bins += bins[channel];
+        max_bins = std::max(max_bins, bins[channel]);
+    }
+
+    const size_t       samples_count = static_cast<size_t>(columns) * rows;
+    const unsigned int tiles         = ::rocprim::detail::ceiling_div(total_bins, tile_bins);
+
+    const bool use_shared = total_bins <= config::shared_impl_max_bins;
+    const bool use_tiled  = !use_shared && tiles <= histogram_tiled_max_tiles;
+    const bool use_sorted = !use_shared && !use_tiled && samples_count >= total_bins;
+
+    // Bits of the sort keys, samples outside of the bins have key max_bins
+    unsigned int sort_bits = 0;
+    while((size_t(1) << sort_bits) <= max_bins)
+    {
+        sort_bits++;
+    }
+
+    const size_t sorted_bins_bytes
+        = use_sorted ? ::rocprim::detail::align_size(samples_count * sizeof(unsigned int)) : 0;
+    size_t sort_storage_bytes = 0;
+    if(use_sorted)
+    {
+        const bin_key_iterator_type bin_keys(counting_iterator<size_t>(0), bin_key_op_type{});
+        hipError_t                  error = ::rocprim::radix_sort_keys(nullptr,
+                                                      sort_storage_bytes,
+                                                      bin_keys,
+                                                      static_cast<unsigned int*>(nullptr),
+                                                      samples_count,
+                                                      0,
+                                                      sort_bits,
+                                                      stream,
+                                                      debug_synchronous);
+        if(error != hipSuccess)
+        {
+            return error;
+        }
+    }
+
     if(temporary_storage == nullptr)
     {
         // Make sure user won't try to allocate 0 bytes memory, because
         // hipMalloc will return nullptr.
-        storage_size = 4;
+        storage_size = use_sorted ? sorted_bins_bytes + sort_storage_bytes : 4;
         return hipSuccess;
     }
 
@@ -170,6 +342,10 @@ inline hipError_t histogram_impl(void*          temporary_storage,
         std::cout << "columns " << columns << '\n';
         std::cout << "rows " << rows << '\n';
         std::cout << "blocks_x " << blocks_x << '\n';
+        std::cout << "total_bins " << total_bins << '\n';
+        std::cout << "implementation "
+                  << (use_shared ? "shared" : use_tiled ? "tiled" : use_sorted ? "sorted" : "global")
+                  << '\n';
         hipError_t error = hipStreamSynchronize(stream);
         if(error != hipSuccess)
         {
@@ -177,26 +353,13 @@ inline hipError_t histogram_impl(void*          temporary_storage,
         }
     }
 
-    unsigned int bins[ActiveChannels];
-    unsigned int bins_bits[ActiveChannels];
-    unsigned int total_bins = 0;
-    unsigned int max_bins   = 0;
-    for(unsigned int channel = 0; channel < ActiveChannels; channel++)
-    {
-        bins[channel] = levels[channel] - 1;
-        bins_bits[channel]
-            = static_cast<unsigned int>(std::log2(detail::next_power_of_two(bins[channel])));
-        total_bins += bins[channel];
-        max_bins = std::max(max_bins, bins[channel]);
-    }
-
     std::chrono::high_resolution_clock::time_point start;
 
     if(debug_synchronous)
     {
         start = std::chrono::high_resolution_clock::now();
     }
-    hipLaunchKernelGGL(HIP_KERNEL_NAME(init_histogram_kernel<block_size, ActiveChannels>),
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(init_histogram_kernel<Config, ActiveChannels>),
                        dim3(::rocprim::detail::ceiling_div(max_bins, block_size)),
                        dim3(block_size),
                        0,
@@ -210,7 +373,7 @@ inline hipError_t histogram_impl(void*          temporary_storage,
         return hipSuccess;
     }
 
-    if(total_bins <= config::shared_impl_max_bins)
+    if(use_shared)
     {
         dim3 grid_size;
         grid_size.x = std::min(config::max_grid_size, blocks_x);
@@ -223,11 +386,8 @@ inline hipError_t histogram_impl(void*          temporary_storage,
         }
         // use config::shared_impl_histograms histograms in shared memory to reduce bank conflicts
         // for the case of samples concentrated in one bin
-        hipLaunchKernelGGL(HIP_KERNEL_NAME(histogram_shared_kernel<block_size,
-                                                                   items_per_thread,
-                                                                   Channels,
-                                                                   ActiveChannels,
-                                                                   config::shared_impl_histograms>),
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(histogram_shared_kernel<Config, Channels, ActiveChannels>),
                            grid_size,
                            dim3(block_size, 1),
                            config::shared_impl_histograms * block_histogram_bytes,
@@ -244,6 +404,88 @@ inline hipError_t histogram_impl(void*          temporary_storage,
                                                     grid_size.x * grid_size.y * block_size,
                                                     start);
     }
+    else if(use_tiled)
+    {
+        // Blocks of all tiles run concurrently, so the samples of a tile are mostly read from
+        // the cache by the blocks of the other tiles
+        dim3 grid_size;
+        grid_size.x = std::min(config::max_grid_size / tiles, blocks_x);
+        grid_size.y = std::min(rows, config::max_grid_size / tiles / grid_size.x);
+        grid_size.z = tiles;
+        const unsigned int rows_per_block = ::rocprim::detail::ceiling_div(rows, grid_size.y);
+        if(debug_synchronous)
+        {
+            start = std::chrono::high_resolution_clock::now();
+        }
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(histogram_tiled_kernel<Config, Channels, ActiveChannels>),
+            grid_size,
+            dim3(block_size, 1),
+            tile_bins * sizeof(unsigned int),
+            stream,
+            samples,
+            columns,
+            rows,
+            row_stride,
+            rows_per_block,
+            fixed_array<Counter*, ActiveChannels>(histogram),
+            fixed_array<SampleToBinOp, ActiveChannels>(sample_to_bin_op),
+            fixed_array<unsigned int, ActiveChannels>(bins),
+            tile_bins);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("histogram_tiled",
+                                                    grid_size.x * grid_size.y * grid_size.z
+                                                        * block_size,
+                                                    start);
+    }
+    else if(use_sorted)
+    {
+        // Sort the bins of the samples of each channel and write the lengths of the runs of
+        // equal bins, no atomics are needed regardless of the distribution of the samples
+        auto* sorted_bins  = static_cast<unsigned int*>(temporary_storage);
+        void* sort_storage = static_cast<char*>(temporary_storage) + sorted_bins_bytes;
+        for(unsigned int channel = 0; channel < ActiveChannels; channel++)
+        {
+            const bin_key_iterator_type bin_keys(
+                counting_iterator<size_t>(0),
+                bin_key_op_type{samples,
+                                columns,
+                                row_stride,
+                                channel,
+                                bins[channel],
+                                sample_to_bin_op[channel]});
+            hipError_t error = ::rocprim::radix_sort_keys(sort_storage,
+                                                          sort_storage_bytes,
+                                                          bin_keys,
+                                                          sorted_bins,
+                                                          samples_count,
+                                                          0,
+                                                          sort_bits,
+                                                          stream,
+                                                          debug_synchronous);
+            if(error != hipSuccess)
+            {
+                return error;
+            }
+
+            if(debug_synchronous)
+            {
+                start = std::chrono::high_resolution_clock::now();
+            }
+            hipLaunchKernelGGL(HIP_KERNEL_NAME(histogram_sorted_runs_kernel<Config>),
+                               dim3(static_cast<unsigned int>(
+                                   ::rocprim::detail::ceiling_div(samples_count, block_size))),
+                               dim3(block_size),
+                               0,
+                               stream,
+                               sorted_bins,
+                               samples_count,
+                               histogram[channel],
+                               bins[channel]);
+            ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("histogram_sorted_runs",
+                                                        samples_count,
+                                                        start);
+        }
+    }
     else
     {
         if(debug_synchronous)
@@ -251,8 +493,7 @@ inline hipError_t histogram_impl(void*          temporary_storage,
             start = std::chrono::high_resolution_clock::now();
         }
         hipLaunchKernelGGL(
-            HIP_KERNEL_NAME(
-                histogram_global_kernel<block_size, items_per_thread, Channels, ActiveChannels>),
+            HIP_KERNEL_NAME(histogram_global_kernel<Config, Channels, ActiveChannels>),
             dim3(blocks_x, rows),
             dim3(block_size, 1),
             0,
@@ -271,6 +512,66 @@ inline hipError_t histogram_impl(void*          temporary_storage,
     return hipSuccess;
 }
 
+template<unsigned int Channels,
+         unsigned int ActiveChannels,
+         class Config,
+         class SampleIterator,
+         class Counter,
+         class SampleToBinOp>
+inline hipError_t histogram_impl(void*          temporary_storage,
+                                 size_t&        storage_size,
+                                 SampleIterator samples,
+                                 unsigned int   columns,
+                                 unsigned int   rows,
+                                 size_t         row_stride_bytes,
+                                 Counter*       histogram[ActiveChannels],
+                                 unsigned int   levels[ActiveChannels],
+                                 SampleToBinOp  sample_to_bin_op[ActiveChannels],
+                                 hipStream_t    stream,
+                                 bool           debug_synchronous)
+{
+#if ROCPRIM_DETAIL_USE_HOST_NATIVE
+    return host_native_histogram<Channels, ActiveChannels>(temporary_storage,
+                                                           storage_size,
+                                                           samples,
+                                                           columns,
+                                                           rows,
+                                                           row_stride_bytes,
+                                                           histogram,
+                                                           levels,
+                                                           sample_to_bin_op,
+                                                           stream,
+                                                           debug_synchronous);
+#else
+
+    using sample_type = typename std::iterator_traits<SampleIterator>::value_type;
+
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = wrapped_histogram_config<Config, sample_type, Channels, ActiveChannels>;
+
+    return dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            return histogram_arch_impl<Channels,
+                                       ActiveChannels,
+                                       config,
+                                       typename decltype(arch_config)::type>(
+                temporary_storage,
+                storage_size,
+                samples,
+                columns,
+                rows,
+                row_stride_bytes,
+                histogram,
+                levels,
+                sample_to_bin_op,
+                stream,
+                debug_synchronous);
+        });
+#endif
+}
+
 template<unsigned int Channels,
          unsigned int ActiveChannels,
          class Config,
@@ -367,6 +668,182 @@ inline hipError_t histogram_range_impl(void*          temporary_storage,
                                                             debug_synchronous);
 }
 
+template<class Config,
+         class ArchConfig,
+         class SampleIterator,
+         class WeightIterator,
+         class Weight,
+         class SampleToBinOp>
+inline hipError_t histogram_weighted_arch_impl(void*          temporary_storage,
+                                               size_t&        storage_size,
+                                               SampleIterator samples,
+                                               WeightIterator weights,
+                                               unsigned int   size,
+                                               Weight*        histogram,
+                                               unsigned int   levels,
+                                               SampleToBinOp  sample_to_bin_op,
+                                               hipStream_t    stream,
+                                               bool           debug_synchronous)
+{
+    using config = ArchConfig;
+
+    static constexpr unsigned int block_size       = config::histogram::block_size;
+    static constexpr unsigned int items_per_thread = config::histogram::items_per_thread;
+    static constexpr unsigned int items_per_block  = block_size * items_per_thread;
+
+    // Weighted bins use the same amount of shared memory as the counters of the shared
+    // implementation, i.e. there are fewer of them for 64-bit weights
+    static constexpr unsigned int tile_bins = ::rocprim::max(
+        1u,
+        static_cast<unsigned int>(config::shared_impl_max_bins * sizeof(unsigned int)
+                                  / sizeof(Weight)));
+
+    static_assert(sizeof(Weight) <= sizeof(double),
+                  "Weight must not be larger than double to be privatized in shared memory");
+
+    if(temporary_storage == nullptr)
+    {
+        // Make sure user won't try to allocate 0 bytes memory, because
+        // hipMalloc will return nullptr.
+        storage_size = 4;
+        return hipSuccess;
+    }
+
+    const unsigned int bins     = levels - 1;
+    const unsigned int blocks   = ::rocprim::detail::ceiling_div(size, items_per_block);
+    const unsigned int tiles    = ::rocprim::detail::ceiling_div(bins, tile_bins);
+    const bool         use_shared = tiles <= histogram_tiled_max_tiles;
+
+    if(debug_synchronous)
+    {
+        std::cout << "size " << size << '\n';
+        std::cout << "bins " << bins << '\n';
+        std::cout << "blocks " << blocks << '\n';
+        std::cout << "tiles " << tiles << '\n';
+        std::cout << "implementation " << (use_shared ? "shared" : "global") << '\n';
+        hipError_t error = hipStreamSynchronize(stream);
+        if(error != hipSuccess)
+        {
+            return error;
+        }
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(debug_synchronous)
+    {
+        start = std::chrono::high_resolution_clock::now();
+    }
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(init_histogram_kernel<Config, 1>),
+                       dim3(::rocprim::detail::ceiling_div(bins, block_size)),
+                       dim3(block_size),
+                       0,
+                       stream,
+                       fixed_array<Weight*, 1>(&histogram),
+                       fixed_array<unsigned int, 1>(&bins));
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("init_histogram", bins, start);
+
+    if(size == 0)
+    {
+        return hipSuccess;
+    }
+
+    if(use_shared)
+    {
+        dim3 grid_size;
+        grid_size.x = std::min(config::max_grid_size / tiles, blocks);
+        grid_size.z = tiles;
+        if(debug_synchronous)
+        {
+            start = std::chrono::high_resolution_clock::now();
+        }
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(histogram_weighted_shared_kernel<Config>),
+            grid_size,
+            dim3(block_size),
+            config::shared_impl_histograms * tile_bins * sizeof(Weight),
+            stream,
+            samples,
+            weights,
+            size,
+            histogram,
+            sample_to_bin_op,
+            bins,
+            tile_bins);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("histogram_weighted_shared",
+                                                    grid_size.x * grid_size.z * block_size,
+                                                    start);
+    }
+    else
+    {
+        if(debug_synchronous)
+        {
+            start = std::chrono::high_resolution_clock::now();
+        }
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(histogram_weighted_global_kernel<Config>),
+            dim3(blocks),
+            dim3(block_size),
+            0,
+            stream,
+            samples,
+            weights,
+            size,
+            histogram,
+            sample_to_bin_op);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("histogram_weighted_global",
+                                                    blocks * block_size,
+                                                    start);
+    }
+
+    return hipSuccess;
+}
+
+template<class Config,
+         class SampleIterator,
+         class WeightIterator,
+         class Weight,
+         class SampleToBinOp>
+inline hipError_t histogram_weighted_impl(void*          temporary_storage,
+                                          size_t&        storage_size,
+                                          SampleIterator samples,
+                                          WeightIterator weights,
+                                          unsigned int   size,
+                                          Weight*        histogram,
+                                          unsigned int   levels,
+                                          SampleToBinOp  sample_to_bin_op,
+                                          hipStream_t    stream,
+                                          bool           debug_synchronous)
+{
+    using sample_type = typename std::iterator_traits<SampleIterator>::value_type;
+
+    if(levels < 2)
+    {
+        // Histogram must have at least 1 bin
+        return hipErrorInvalidValue;
+    }
+
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = wrapped_histogram_config<Config, sample_type, 1, 1>;
+
+    return dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            return histogram_weighted_arch_impl<config, typename decltype(arch_config)::type>(
+                temporary_storage,
+                storage_size,
+                samples,
+                weights,
+                size,
+                histogram,
+                levels,
+                sample_to_bin_op,
+                stream,
+                debug_synchronous);
+        });
+}
+
 #undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
 
 } // namespace detail
@@ -581,6 +1058,120 @@ inline hipError_t histogram_even(void*          temporary_storage,
                                                      debug_synchronous);
 }
 
+/// \brief Computes a weighted histogram from a sequence of samples using equal-width bins.
+///
+/// \par
+/// * Instead of counting the samples, the weight of every sample is added to its bin, e.g. to
+/// compute a weighted density estimate in a single pass.
+/// * The number of histogram bins is (\p levels - 1).
+/// * Bins are evenly-segmented and include the same width of sample values:
+/// (\p upper_level - \p lower_level) / (\p levels - 1).
+/// * The bins are accumulated in shared memory and then added to \p histogram, so the order
+/// in which weights are added is not specified and floating point results may differ between
+/// runs by rounding errors.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p histogram_config or
+/// a custom class with the same members.
+/// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam WeightIterator - random-access iterator type of the weights range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam Weight - type of histogram bins: \p float, \p double, or an integer type supported
+/// by atomic addition (\p int, <tt>unsigned int</tt>, <tt>unsigned long long</tt>).
+/// \tparam Level - type of histogram boundaries (levels)
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the reduction operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] samples - iterator to the first element in the range of input samples.
+/// \param [in] weights - iterator to the first element in the range of weights of the samples.
+/// \param [in] size - number of elements in the samples and weights ranges.
+/// \param [out] histogram - pointer to the first element in the histogram range.
+/// \param [in] levels - number of boundaries (levels) for histogram bins.
+/// \param [in] lower_level - lower sample value bound (inclusive) for the first histogram bin.
+/// \param [in] upper_level - upper sample value bound (exclusive) for the last histogram bin.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful histogram operation; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level weighted histogram of 5 bins is computed on an array of
+/// float samples.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// unsigned int size;        // e.g., 8
+/// float * samples;          // e.g., [-10.0, 0.3, 9.5, 8.1, 1.5, 1.9, 100.0, 5.1]
+/// float * weights;          // e.g., [1.0, 0.5, 0.5, 2.0, 1.0, 0.25, 1.0, 3.0]
+/// float * histogram;        // empty array of at least 5 elements
+/// unsigned int levels;      // e.g., 6 (for 5 bins)
+/// float lower_level;        // e.g., 0.0
+/// float upper_level;        // e.g., 10.0
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::histogram_even(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     samples, weights, size,
+///     histogram, levels, lower_level, upper_level
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // compute histogram
+/// rocprim::histogram_even(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     samples, weights, size,
+///     histogram, levels, lower_level, upper_level
+/// );
+/// // histogram: [1.75, 0.0, 3.0, 0.0, 2.5]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class SampleIterator,
+         class WeightIterator,
+         class Weight,
+         class Level>
+inline hipError_t histogram_even(void*          temporary_storage,
+                                 size_t&        storage_size,
+                                 SampleIterator samples,
+                                 WeightIterator weights,
+                                 unsigned int   size,
+                                 Weight*        histogram,
+                                 unsigned int   levels,
+                                 Level          lower_level,
+                                 Level          upper_level,
+                                 hipStream_t    stream            = 0,
+                                 bool           debug_synchronous = false)
+{
+    const detail::sample_to_bin_even<Level> sample_to_bin_op(
+        levels < 2 ? 1 : levels - 1,
+        lower_level,
+        upper_level);
+
+    return detail::histogram_weighted_impl<Config>(temporary_storage,
+                                                   storage_size,
+                                                   samples,
+                                                   weights,
+                                                   size,
+                                                   histogram,
+                                                   levels,
+                                                   sample_to_bin_op,
+                                                   stream,
+                                                   debug_synchronous);
+}
+
 /// \brief Computes histograms from a sequence of multi-channel samples using equal-width bins.
 ///
 /// \par
@@ -1007,6 +1598,115 @@ inline hipError_t histogram_range(void*          temporary_storage,
                                                       debug_synchronous);
 }
 
+/// \brief Computes a weighted histogram from a sequence of samples using the specified bin
+/// boundary levels.
+///
+/// \par
+/// * Instead of counting the samples, the weight of every sample is added to its bin, e.g. to
+/// compute a weighted density estimate in a single pass.
+/// * The number of histogram bins is (\p levels - 1).
+/// * The range for bin<sub><em>j</em></sub> is [<tt>level_values[j]</tt>, <tt>level_values[j+1]</tt>).
+/// * The bins are accumulated in shared memory and then added to \p histogram, so the order
+/// in which weights are added is not specified and floating point results may differ between
+/// runs by rounding errors.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p histogram_config or
+/// a custom class with the same members.
+/// \tparam SampleIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam WeightIterator - random-access iterator type of the weights range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam Weight - type of histogram bins: \p float, \p double, or an integer type supported
+/// by atomic addition (\p int, <tt>unsigned int</tt>, <tt>unsigned long long</tt>).
+/// \tparam Level - type of histogram boundaries (levels)
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the reduction operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] samples - iterator to the first element in the range of input samples.
+/// \param [in] weights - iterator to the first element in the range of weights of the samples.
+/// \param [in] size - number of elements in the samples and weights ranges.
+/// \param [out] histogram - pointer to the first element in the histogram range.
+/// \param [in] levels - number of boundaries (levels) for histogram bins.
+/// \param [in] level_values - pointer to the array of bin boundaries.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful histogram operation; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level weighted histogram of 5 bins is computed on an array of
+/// float samples.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// unsigned int size;        // e.g., 8
+/// float * samples;          // e.g., [-10.0, 0.3, 2.4, 4.7, 20.0, 13.2, 100.0, 5.1]
+/// double * weights;         // e.g., [1.0, 0.5, 0.5, 2.0, 1.0, 0.25, 1.0, 3.0]
+/// double * histogram;       // empty array of at least 5 elements
+/// unsigned int levels;      // e.g., 6 (for 5 bins)
+/// float * level_values;     // e.g., [0.0, 1.0, 5.0, 10.0, 20.0, 50.0]
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::histogram_range(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     samples, weights, size,
+///     histogram, levels, level_values
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // compute histogram
+/// rocprim::histogram_range(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     samples, weights, size,
+///     histogram, levels, level_values
+/// );
+/// // histogram: [0.5, 2.5, 3.0, 0.25, 1.0]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class SampleIterator,
+         class WeightIterator,
+         class Weight,
+         class Level>
+inline hipError_t histogram_range(void*          temporary_storage,
+                                  size_t&        storage_size,
+                                  SampleIterator samples,
+                                  WeightIterator weights,
+                                  unsigned int   size,
+                                  Weight*        histogram,
+                                  unsigned int   levels,
+                                  Level*         level_values,
+                                  hipStream_t    stream            = 0,
+                                  bool           debug_synchronous = false)
+{
+    const detail::sample_to_bin_range<Level> sample_to_bin_op(levels < 2 ? 1 : levels - 1,
+                                                              level_values);
+
+    return detail::histogram_weighted_impl<Config>(temporary_storage,
+                                                   storage_size,
+                                                   samples,
+                                                   weights,
+                                                   size,
+                                                   histogram,
+                                                   levels,
+                                                   sample_to_bin_op,
+                                                   stream,
+                                                   debug_synchronous);
+}
+
 /// \brief Computes histograms from a sequence of multi-channel samples using the specified bin boundary levels.
 ///
 /// \par
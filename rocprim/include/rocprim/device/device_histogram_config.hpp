@@ -38,8 +38,10 @@ BEGIN_ROCPRIM_NAMESPACE
 /// \tparam HistogramConfig - configuration of histogram kernel. Must be \p kernel_config.
 /// \tparam MaxGridSize - maximim number of blocks to launch.
 /// \tparam SharedImplMaxBins - maximum total number of bins for all active channels
-/// for the shared memory histogram implementation (samples -> shared memory bins -> global memory bins),
-/// when exceeded the global memory implementation is used (samples -> global memory bins).
+/// for the shared memory histogram implementation (samples -> shared memory bins -> global memory bins).
+/// When exceeded, the bins are processed in tiles of <tt>SharedImplMaxBins * SharedImplHistograms</tt>
+/// bins in shared memory, or, for histograms of many tiles, the bins of the samples are sorted
+/// (or counted with global memory atomics if there are fewer samples than bins).
 /// \tparam SharedImplHistograms - number of histograms in the shared memory to reduce bank conflicts
 /// for atomic operations with narrow sample distributions. Sweetspot for 9xx and 10xx is 3.
 template<class HistogramConfig,
@@ -129,6 +131,18 @@ struct default_histogram_config
         histogram_config_900<Sample, Channels, ActiveChannels>
     > { };
 
+// Config of histogram_even and histogram_range, single and multi-channel per target architecture.
+template<class Config, class Sample, unsigned int Channels, unsigned int ActiveChannels>
+struct wrapped_histogram_config
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        using type
+            = arch_config_t<Config, default_histogram_config<static_cast<unsigned int>(Arch), Sample, Channels, ActiveChannels>>;
+    };
+};
+
 } // end namespace detail
 
 END_ROCPRIM_NAMESPACE
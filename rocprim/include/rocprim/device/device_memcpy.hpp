@@ -0,0 +1,457 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_MEMCPY_HPP_
+#define ROCPRIM_DEVICE_DEVICE_MEMCPY_HPP_
+
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+
+#include "detail/device_batch_memcpy.hpp"
+#include "device_memcpy_config.hpp"
+#include "device_trace.hpp"
+
+/// \file
+///
+/// Device level batched copy primitives
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule
+/// @{
+
+namespace detail
+{
+
+template<class Config,
+         bool IsMemCpy,
+         class InputBufferIterator,
+         class OutputBufferIterator,
+         class BufferSizeIterator>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::block_size) void batch_copy_small_and_medium_kernel(
+    InputBufferIterator  sources,
+    OutputBufferIterator destinations,
+    BufferSizeIterator   sizes,
+    const unsigned int   num_copies,
+    unsigned int*        large_buffer_indices,
+    unsigned int*        large_buffer_count)
+{
+    batch_copy_small_and_medium<device_target_arch_config_t<Config>, IsMemCpy>(
+        sources,
+        destinations,
+        sizes,
+        num_copies,
+        large_buffer_indices,
+        large_buffer_count);
+}
+
+template<class Config, bool IsMemCpy, class InputBufferIterator, class BufferSizeIterator>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::block_size) void batch_copy_large_tile_offsets_kernel(
+    BufferSizeIterator        sizes,
+    const unsigned int* const large_buffer_indices,
+    const unsigned int* const large_buffer_count,
+    size_t*                   large_buffer_tile_offsets)
+{
+    batch_copy_large_tile_offsets<device_target_arch_config_t<Config>, IsMemCpy, InputBufferIterator>(
+        sizes,
+        large_buffer_indices,
+        large_buffer_count,
+        large_buffer_tile_offsets);
+}
+
+template<class Config,
+         bool IsMemCpy,
+         class InputBufferIterator,
+         class OutputBufferIterator,
+         class BufferSizeIterator>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::block_size) void batch_copy_large_kernel(
+    InputBufferIterator       sources,
+    OutputBufferIterator      destinations,
+    BufferSizeIterator        sizes,
+    const unsigned int* const large_buffer_indices,
+    const unsigned int* const large_buffer_count,
+    const size_t* const       large_buffer_tile_offsets)
+{
+    batch_copy_large<device_target_arch_config_t<Config>, IsMemCpy>(sources,
+                                                                    destinations,
+                                                                    sizes,
+                                                                    large_buffer_indices,
+                                                                    large_buffer_count,
+                                                                    large_buffer_tile_offsets);
+}
+
+#define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start)                           \
+    {                                                                                            \
+        auto _error = hipGetLastError();                                                         \
+        if(_error != hipSuccess)                                                                 \
+            return _error;                                                                       \
+        ::rocprim::detail::kernel_trace_end(name, size, stream);                                 \
+        if(debug_synchronous)                                                                    \
+        {                                                                                        \
+            std::cout << name << "(" << size << ")";                                             \
+            auto __error = hipStreamSynchronize(stream);                                         \
+            if(__error != hipSuccess)                                                            \
+                return __error;                                                                  \
+            auto _end = std::chrono::high_resolution_clock::now();                               \
+            auto _d   = std::chrono::duration_cast<std::chrono::duration<double>>(_end - start); \
+            std::cout << " " << _d.count() * 1000 << " ms" << '\n';                              \
+        }                                                                                        \
+    }
+
+inline hipError_t batch_copy_multiprocessor_count(const hipStream_t stream, int& count)
+{
+    int device_id;
+#ifdef WIN32
+    (void)stream;
+    hipError_t result = hipGetDevice(&device_id);
+#else
+    hipError_t result = get_device_from_stream(stream, device_id);
+#endif
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    return hipDeviceGetAttribute(&count, hipDeviceAttributeMultiprocessorCount, device_id);
+}
+
+template<class Config,
+         class ArchConfig,
+         bool IsMemCpy,
+         class InputBufferIterator,
+         class OutputBufferIterator,
+         class BufferSizeIterator>
+inline hipError_t batch_copy_arch_impl(void*                temporary_storage,
+                                       size_t&              storage_size,
+                                       InputBufferIterator  sources,
+                                       OutputBufferIterator destinations,
+                                       BufferSizeIterator   sizes,
+                                       const unsigned int   num_copies,
+                                       const hipStream_t    stream,
+                                       const bool           debug_synchronous)
+{
+    using config = ArchConfig;
+
+    constexpr unsigned int block_size = config::block_size;
+
+    const size_t large_buffer_indices_bytes      = align_size(num_copies * sizeof(unsigned int));
+    const size_t large_buffer_count_bytes        = align_size(sizeof(unsigned int));
+    const size_t large_buffer_tile_offsets_bytes = align_size(num_copies * sizeof(size_t));
+    if(temporary_storage == nullptr)
+    {
+        storage_size = large_buffer_indices_bytes + large_buffer_count_bytes
+                       + large_buffer_tile_offsets_bytes;
+        return hipSuccess;
+    }
+
+    if(num_copies == 0)
+    {
+        return hipSuccess;
+    }
+
+    auto* ptr                = static_cast<char*>(temporary_storage);
+    auto* large_buffer_count = reinterpret_cast<unsigned int*>(ptr);
+    ptr += large_buffer_count_bytes;
+    auto* large_buffer_indices = reinterpret_cast<unsigned int*>(ptr);
+    ptr += large_buffer_indices_bytes;
+    auto* large_buffer_tile_offsets = reinterpret_cast<size_t*>(ptr);
+
+    int        multiprocessor_count;
+    hipError_t result = batch_copy_multiprocessor_count(stream, multiprocessor_count);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+
+    const unsigned int number_of_blocks = ceiling_div(num_copies, block_size);
+    const unsigned int large_number_of_blocks
+        = ::rocprim::max(1u,
+                         static_cast<unsigned int>(multiprocessor_count)
+                             * config::large_blocks_per_processor);
+
+    if(debug_synchronous)
+    {
+        std::cout << "num_copies:             " << num_copies << '\n';
+        std::cout << "block_size:             " << block_size << '\n';
+        std::cout << "number of blocks:       " << number_of_blocks << '\n';
+        std::cout << "large number of blocks: " << large_number_of_blocks << '\n';
+    }
+
+    result = hipMemsetAsync(large_buffer_count, 0, sizeof(unsigned int), stream);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(debug_synchronous)
+        start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(batch_copy_small_and_medium_kernel<Config, IsMemCpy>),
+                       dim3(number_of_blocks),
+                       dim3(block_size),
+                       0,
+                       stream,
+                       sources,
+                       destinations,
+                       sizes,
+                       num_copies,
+                       large_buffer_indices,
+                       large_buffer_count);
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("batch_copy_small_and_medium_kernel",
+                                                num_copies,
+                                                start);
+
+    if(debug_synchronous)
+        start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(batch_copy_large_tile_offsets_kernel<Config, IsMemCpy, InputBufferIterator>),
+        dim3(1),
+        dim3(block_size),
+        0,
+        stream,
+        sizes,
+        large_buffer_indices,
+        large_buffer_count,
+        large_buffer_tile_offsets);
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("batch_copy_large_tile_offsets_kernel",
+                                                num_copies,
+                                                start);
+
+    if(debug_synchronous)
+        start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(batch_copy_large_kernel<Config, IsMemCpy>),
+                       dim3(large_number_of_blocks),
+                       dim3(block_size),
+                       0,
+                       stream,
+                       sources,
+                       destinations,
+                       sizes,
+                       large_buffer_indices,
+                       large_buffer_count,
+                       large_buffer_tile_offsets);
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("batch_copy_large_kernel", num_copies, start);
+
+    return hipSuccess;
+}
+
+template<class Config,
+         bool IsMemCpy,
+         class InputBufferIterator,
+         class OutputBufferIterator,
+         class BufferSizeIterator>
+inline hipError_t batch_copy_impl(void*                temporary_storage,
+                                  size_t&              storage_size,
+                                  InputBufferIterator  sources,
+                                  OutputBufferIterator destinations,
+                                  BufferSizeIterator   sizes,
+                                  const unsigned int   num_copies,
+                                  const hipStream_t    stream,
+                                  const bool           debug_synchronous)
+{
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = wrapped_batch_memcpy_config<Config>;
+
+    return dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            return batch_copy_arch_impl<config, typename decltype(arch_config)::type, IsMemCpy>(
+                temporary_storage,
+                storage_size,
+                sources,
+                destinations,
+                sizes,
+                num_copies,
+                stream,
+                debug_synchronous);
+        });
+}
+
+#undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
+
+} // end namespace detail
+
+/// \brief Parallel batched memcpy primitive for device level.
+///
+/// batch_memcpy function copies \p num_copies buffers of bytes: the <tt>sizes[i]</tt> bytes
+/// starting at <tt>sources[i]</tt> are copied to <tt>destinations[i]</tt>. All copies are
+/// performed by three kernel launches, regardless of their number.
+///
+/// \par Overview
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Small buffers are copied by single threads, medium buffers by logical warps and large
+/// buffers by whole blocks, see \p batch_memcpy_config.
+/// * Parts of buffers in which the source and the destination are equally aligned are copied
+/// with vector loads and stores.
+/// * The source and the destination buffers must not overlap.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p batch_memcpy_config or a custom class with the same members.
+/// \tparam InputBufferIterator - random-access iterator type of the source pointers. Its value
+/// type must be convertible to <tt>const void*</tt>.
+/// \tparam OutputBufferIterator - random-access iterator type of the destination pointers. Its
+/// value type must be convertible to <tt>void*</tt>.
+/// \tparam BufferSizeIterator - random-access iterator type of the buffer sizes. Its value
+/// type must be an integral type.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the copies.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] sources - iterator to the first source pointer.
+/// \param [in] destinations - iterator to the first destination pointer.
+/// \param [in] sizes - iterator to the first buffer size (in bytes).
+/// \param [in] num_copies - number of buffers to copy.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful copy; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example three buffers are copied.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// unsigned int num_copies;     // e.g., 3
+/// void ** sources;             // e.g., [a, b, c]
+/// void ** destinations;        // e.g., [x, y, z]
+/// size_t * sizes;              // e.g., [20, 3000, 100000]
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::batch_memcpy(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     sources, destinations, sizes, num_copies
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // copy
+/// rocprim::batch_memcpy(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     sources, destinations, sizes, num_copies
+/// );
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class InputBufferIterator,
+         class OutputBufferIterator,
+         class BufferSizeIterator>
+inline hipError_t batch_memcpy(void*                temporary_storage,
+                               size_t&              storage_size,
+                               InputBufferIterator  sources,
+                               OutputBufferIterator destinations,
+                               BufferSizeIterator   sizes,
+                               unsigned int         num_copies,
+                               hipStream_t          stream            = 0,
+                               bool                 debug_synchronous = false)
+{
+    return detail::batch_copy_impl<Config, true>(temporary_storage,
+                                                 storage_size,
+                                                 sources,
+                                                 destinations,
+                                                 sizes,
+                                                 num_copies,
+                                                 stream,
+                                                 debug_synchronous);
+}
+
+/// \brief Parallel batched copy primitive for device level.
+///
+/// batch_copy function copies \p num_copies ranges of elements: the <tt>sizes[i]</tt> elements
+/// of the range starting at <tt>sources[i]</tt> are copied to the range starting at
+/// <tt>destinations[i]</tt>. All copies are performed by three kernel launches, regardless of
+/// their number.
+///
+/// \par Overview
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges are classified by their size in bytes: small ranges are copied by single threads,
+/// medium ranges by logical warps and large ranges by whole blocks, see \p batch_memcpy_config.
+/// * The source and the destination ranges must not overlap.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p batch_memcpy_config or a custom class with the same members.
+/// \tparam InputBufferIterator - random-access iterator type of the source ranges. Its value
+/// type must be a random-access iterator meeting the requirements of a C++ InputIterator
+/// concept. It can be a simple pointer type.
+/// \tparam OutputBufferIterator - random-access iterator type of the destination ranges. Its
+/// value type must be a random-access iterator meeting the requirements of a C++ OutputIterator
+/// concept. It can be a simple pointer type.
+/// \tparam BufferSizeIterator - random-access iterator type of the range sizes. Its value
+/// type must be an integral type.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the copies.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] sources - iterator to the first source range.
+/// \param [in] destinations - iterator to the first destination range.
+/// \param [in] sizes - iterator to the first range size (in elements).
+/// \param [in] num_copies - number of ranges to copy.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful copy; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<class Config = default_config,
+         class InputBufferIterator,
+         class OutputBufferIterator,
+         class BufferSizeIterator>
+inline hipError_t batch_copy(void*                temporary_storage,
+                             size_t&              storage_size,
+                             InputBufferIterator  sources,
+                             OutputBufferIterator destinations,
+                             BufferSizeIterator   sizes,
+                             unsigned int         num_copies,
+                             hipStream_t          stream            = 0,
+                             bool                 debug_synchronous = false)
+{
+    return detail::batch_copy_impl<Config, false>(temporary_storage,
+                                                  storage_size,
+                                                  sources,
+                                                  destinations,
+                                                  sizes,
+                                                  num_copies,
+                                                  stream,
+                                                  debug_synchronous);
+}
+
+/// @}
+// end of group devicemodule
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_MEMCPY_HPP_
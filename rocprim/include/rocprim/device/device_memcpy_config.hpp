@@ -0,0 +1,98 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_MEMCPY_CONFIG_HPP_
+#define ROCPRIM_DEVICE_DEVICE_MEMCPY_CONFIG_HPP_
+
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+
+#include "config_types.hpp"
+
+/// \addtogroup primitivesmodule_deviceconfigs
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \brief Configuration of device-level batched copy primitives (\p batch_memcpy and
+/// \p batch_copy).
+///
+/// Buffers of at most \p SmallBufferSizeThreshold bytes are small, buffers of at most
+/// \p MediumBufferSizeThreshold bytes are medium. Every small buffer is copied by a single thread,
+/// every medium buffer by a logical warp of \p LogicalWarpSize threads, and the remaining
+/// buffers are copied by all blocks of a separate kernel.
+///
+/// \tparam BlockSize - number of threads in a block.
+/// \tparam LogicalWarpSize - number of threads copying a medium buffer. Must divide \p BlockSize.
+/// \tparam SmallBufferSizeThreshold - maximum size (in bytes) of a small buffer.
+/// \tparam MediumBufferSizeThreshold - maximum size (in bytes) of a medium buffer.
+/// \tparam LargeBlocksPerProcessor - number of blocks per multiprocessor that copy the large
+/// buffers.
+template<unsigned int BlockSize,
+         unsigned int LogicalWarpSize,
+         unsigned int SmallBufferSizeThreshold,
+         unsigned int MediumBufferSizeThreshold,
+         unsigned int LargeBlocksPerProcessor = 4>
+struct batch_memcpy_config
+{
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    static constexpr unsigned int block_size                   = BlockSize;
+    static constexpr unsigned int logical_warp_size            = LogicalWarpSize;
+    static constexpr unsigned int small_buffer_size_threshold  = SmallBufferSizeThreshold;
+    static constexpr unsigned int medium_buffer_size_threshold = MediumBufferSizeThreshold;
+    static constexpr unsigned int large_blocks_per_processor   = LargeBlocksPerProcessor;
+#endif
+};
+
+namespace detail
+{
+
+struct batch_memcpy_config_fallback
+{
+    using type = batch_memcpy_config<256, 32, 64, 4096>;
+};
+
+template<unsigned int TargetArch>
+struct default_batch_memcpy_config : select_arch<TargetArch, batch_memcpy_config_fallback>
+{
+};
+
+// Config of batch_memcpy and batch_copy per target architecture.
+template<class Config>
+struct wrapped_batch_memcpy_config
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        using type
+            = arch_config_t<Config, default_batch_memcpy_config<static_cast<unsigned int>(Arch)>>;
+    };
+};
+
+} // end namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+/// @}
+// end of group primitivesmodule_deviceconfigs
+
+#endif // ROCPRIM_DEVICE_DEVICE_MEMCPY_CONFIG_HPP_
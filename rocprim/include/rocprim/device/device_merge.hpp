@@ -30,6 +30,7 @@
 
 #include "device_merge_config.hpp"
 #include "detail/device_merge.hpp"
+#include "device_trace.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -62,8 +63,7 @@ void partition_kernel(IndexIterator index,
 }
 
 template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
+    class Config,
     class IndexIterator,
     class KeysInputIterator1,
     class KeysInputIterator2,
@@ -74,7 +74,7 @@ template<
     class BinaryFunction
 >
 ROCPRIM_KERNEL
-__launch_bounds__(BlockSize)
+__launch_bounds__(device_target_arch_config_t<Config>::block_size)
 void merge_kernel(IndexIterator index,
                   KeysInputIterator1 keys_input1,
                   KeysInputIterator2 keys_input2,
@@ -86,7 +86,8 @@ void merge_kernel(IndexIterator index,
                   const size_t input2_size,
                   BinaryFunction compare_function)
 {
-    merge_kernel_impl<BlockSize, ItemsPerThread>(
+    using config = device_target_arch_config_t<Config>;
+    merge_kernel_impl<config::block_size, config::items_per_thread>(
         index, keys_input1, keys_input2, keys_output,
         values_input1, values_input2, values_output,
         input1_size, input2_size, compare_function
@@ -97,6 +98,7 @@ void merge_kernel(IndexIterator index,
     { \
         auto _error = hipGetLastError(); \
         if(_error != hipSuccess) return _error; \
+        ::rocprim::detail::kernel_trace_end(name, size, stream); \
         if(debug_synchronous) \
         { \
             std::cout << name << "(" << size << ")"; \
@@ -110,6 +112,7 @@ void merge_kernel(IndexIterator index,
 
 template<
     class Config,
+    class ArchConfig,
     class KeysInputIterator1,
     class KeysInputIterator2,
     class KeysOutputIterator,
@@ -119,29 +122,22 @@ template<
     class BinaryFunction
 >
 inline
-hipError_t merge_impl(void * temporary_storage,
-                      size_t& storage_size,
-                      KeysInputIterator1 keys_input1,
-                      KeysInputIterator2 keys_input2,
-                      KeysOutputIterator keys_output,
-                      ValuesInputIterator1 values_input1,
-                      ValuesInputIterator2 values_input2,
-                      ValuesOutputIterator values_output,
-                      const size_t input1_size,
-                      const size_t input2_size,
-                      BinaryFunction compare_function,
-                      const hipStream_t stream,
-                      bool debug_synchronous)
+hipError_t merge_arch_impl(void * temporary_storage,
+                           size_t& storage_size,
+                           KeysInputIterator1 keys_input1,
+                           KeysInputIterator2 keys_input2,
+                           KeysOutputIterator keys_output,
+                           ValuesInputIterator1 values_input1,
+                           ValuesInputIterator2 values_input2,
+                           ValuesOutputIterator values_output,
+                           const size_t input1_size,
+                           const size_t input2_size,
+                           BinaryFunction compare_function,
+                           const hipStream_t stream,
+                           bool debug_synchronous)
 
 {
-    using key_type = typename std::iterator_traits<KeysInputIterator1>::value_type;
-    using value_type = typename std::iterator_traits<ValuesInputIterator1>::value_type;
-
-    // Get default config if Config is default_config
-    using config = detail::default_or_custom_config<
-        Config,
-        detail::default_merge_config<ROCPRIM_TARGET_ARCH, key_type, value_type>
-    >;
+    using config = ArchConfig;
 
     static constexpr unsigned int block_size = config::block_size;
     static constexpr unsigned int half_block = block_size / 2;
@@ -187,7 +183,7 @@ hipError_t merge_impl(void * temporary_storage,
 
     if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
     hipLaunchKernelGGL(
-        HIP_KERNEL_NAME(detail::merge_kernel<block_size, items_per_thread>),
+        HIP_KERNEL_NAME(detail::merge_kernel<Config>),
         dim3(number_of_blocks), dim3(block_size), 0, stream,
         index, keys_input1, keys_input2, keys_output,
         values_input1, values_input2, values_output,
@@ -198,6 +194,59 @@ hipError_t merge_impl(void * temporary_storage,
     return hipSuccess;
 }
 
+template<
+    class Config,
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class KeysOutputIterator,
+    class ValuesInputIterator1,
+    class ValuesInputIterator2,
+    class ValuesOutputIterator,
+    class BinaryFunction
+>
+inline
+hipError_t merge_impl(void * temporary_storage,
+                      size_t& storage_size,
+                      KeysInputIterator1 keys_input1,
+                      KeysInputIterator2 keys_input2,
+                      KeysOutputIterator keys_output,
+                      ValuesInputIterator1 values_input1,
+                      ValuesInputIterator2 values_input2,
+                      ValuesOutputIterator values_output,
+                      const size_t input1_size,
+                      const size_t input2_size,
+                      BinaryFunction compare_function,
+                      const hipStream_t stream,
+                      bool debug_synchronous)
+
+{
+    using key_type = typename std::iterator_traits<KeysInputIterator1>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator1>::value_type;
+
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = wrapped_merge_config<Config, key_type, value_type>;
+
+    return dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            return merge_arch_impl<config, typename decltype(arch_config)::type>(
+                temporary_storage,
+                storage_size,
+                keys_input1,
+                keys_input2,
+                keys_output,
+                values_input1,
+                values_input2,
+                values_output,
+                input1_size,
+                input2_size,
+                compare_function,
+                stream,
+                debug_synchronous);
+        });
+}
+
 #undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
 
 } // end of detail namespace
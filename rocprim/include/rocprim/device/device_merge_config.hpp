@@ -150,6 +150,18 @@ struct default_merge_config
         merge_config_900<Key, Value>
     > { };
 
+// Config of merge and the sorted binary searches per target architecture.
+template<class Config, class Key, class Value>
+struct wrapped_merge_config
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        using type
+            = arch_config_t<Config, default_merge_config<static_cast<unsigned int>(Arch), Key, Value>>;
+    };
+};
+
 } // end namespace detail
 
 END_ROCPRIM_NAMESPACE
@@ -27,12 +27,15 @@
 
 #include "../config.hpp"
 #include "../detail/various.hpp"
+#include "../iterator/counting_iterator.hpp"
 
+#include "detail/device_host_native.hpp"
 #include "detail/device_merge.hpp"
 #include "detail/device_merge_sort.hpp"
 #include "detail/device_merge_sort_mergepath.hpp"
 #include "device_transform.hpp"
 #include "device_merge_sort_config.hpp"
+#include "device_trace.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -42,8 +45,7 @@ BEGIN_ROCPRIM_NAMESPACE
 namespace detail
 {
 
-template<unsigned int BlockSize,
-         unsigned int ItemsPerThread,
+template<class Config,
          class KeysInputIterator,
          class KeysOutputIterator,
          class ValuesInputIterator,
@@ -51,23 +53,25 @@ template<unsigned int BlockSize,
          class OffsetT,
          class BinaryFunction>
 ROCPRIM_KERNEL
-    __launch_bounds__(BlockSize) void block_sort_kernel(KeysInputIterator    keys_input,
-                                                        KeysOutputIterator   keys_output,
-                                                        ValuesInputIterator  values_input,
-                                                        ValuesOutputIterator values_output,
-                                                        const OffsetT        sorted_block_size,
-                                                        BinaryFunction       compare_function)
+    __launch_bounds__(device_target_arch_config_t<Config>::sort_config::block_size) void block_sort_kernel(
+        KeysInputIterator    keys_input,
+        KeysOutputIterator   keys_output,
+        ValuesInputIterator  values_input,
+        ValuesOutputIterator values_output,
+        const OffsetT        sorted_block_size,
+        BinaryFunction       compare_function)
 {
-    block_sort_kernel_impl<BlockSize, ItemsPerThread>(keys_input,
-                                                      keys_output,
-                                                      values_input,
-                                                      values_output,
-                                                      sorted_block_size,
-                                                      compare_function);
+    using sort_config = typename device_target_arch_config_t<Config>::sort_config;
+    block_sort_kernel_impl<sort_config::block_size, sort_config::items_per_thread>(
+        keys_input,
+        keys_output,
+        values_input,
+        values_output,
+        sorted_block_size,
+        compare_function);
 }
 
-template<unsigned int BlockSize,
-         unsigned int ItemsPerThread,
+template<class Config,
          class KeysInputIterator,
          class KeysOutputIterator,
          class ValuesInputIterator,
@@ -75,26 +79,28 @@ template<unsigned int BlockSize,
          class OffsetT,
          class BinaryFunction>
 ROCPRIM_KERNEL
-    __launch_bounds__(BlockSize) void block_merge_kernel(KeysInputIterator    keys_input,
-                                                         KeysOutputIterator   keys_output,
-                                                         ValuesInputIterator  values_input,
-                                                         ValuesOutputIterator values_output,
-                                                         const OffsetT        input_size,
-                                                         const OffsetT        sorted_block_size,
-                                                         BinaryFunction       compare_function)
+    __launch_bounds__(device_target_arch_config_t<Config>::merge_impl1_config::block_size) void block_merge_kernel(
+        KeysInputIterator    keys_input,
+        KeysOutputIterator   keys_output,
+        ValuesInputIterator  values_input,
+        ValuesOutputIterator values_output,
+        const OffsetT        input_size,
+        const OffsetT        sorted_block_size,
+        BinaryFunction       compare_function)
 {
-    block_merge_kernel_impl<BlockSize, ItemsPerThread>(keys_input,
-                                                       keys_output,
-                                                       values_input,
-                                                       values_output,
-                                                       input_size,
-                                                       sorted_block_size,
-                                                       compare_function);
+    using merge_config = typename device_target_arch_config_t<Config>::merge_impl1_config;
+    block_merge_kernel_impl<merge_config::block_size, merge_config::items_per_thread>(
+        keys_input,
+        keys_output,
+        values_input,
+        values_output,
+        input_size,
+        sorted_block_size,
+        compare_function);
 }
 
 template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
+    class Config,
     class KeysInputIterator,
     class KeysOutputIterator,
     class ValuesInputIterator,
@@ -103,7 +109,7 @@ template<
     class BinaryFunction
 >
 ROCPRIM_KERNEL
-__launch_bounds__(BlockSize)
+__launch_bounds__(device_target_arch_config_t<Config>::merge_mergepath_config::block_size)
 void block_merge_kernel(KeysInputIterator keys_input,
                         KeysOutputIterator keys_output,
                         ValuesInputIterator values_input,
@@ -113,7 +119,8 @@ void block_merge_kernel(KeysInputIterator keys_input,
                         BinaryFunction compare_function,
                         const OffsetT* merge_partitions)
 {
-    block_merge_kernel_impl<BlockSize, ItemsPerThread>(keys_input,
+    using merge_config = typename device_target_arch_config_t<Config>::merge_mergepath_config;
+    block_merge_kernel_impl<merge_config::block_size, merge_config::items_per_thread>(keys_input,
                                                        keys_output,
                                                        values_input,
                                                        values_output,
@@ -138,6 +145,7 @@ void block_merge_kernel(KeysInputIterator keys_input,
     { \
         auto _error = hipGetLastError(); \
         if(_error != hipSuccess) return _error; \
+        ::rocprim::detail::kernel_trace_end(name, size, stream); \
         if(debug_synchronous) \
         { \
             std::cout << name << "(" << size << ")"; \
@@ -149,13 +157,12 @@ void block_merge_kernel(KeysInputIterator keys_input,
         } \
     }
 
-template <unsigned int BlockSize, // BlockSize of the partition kernel
-          unsigned int ItemsPerTile, // ItemsPerTile of the block merge kernel
+template <typename Config,
           typename KeysInputIterator,
           typename OffsetT,
           typename CompareOpT>
 ROCPRIM_KERNEL
-__launch_bounds__(BlockSize)
+__launch_bounds__(device_target_arch_config_t<Config>::merge_mergepath_partition_config::block_size)
 void device_mergepath_partition_kernel(KeysInputIterator keys,
                              const OffsetT input_size,
                              const unsigned int num_partitions,
@@ -163,6 +170,13 @@ void device_mergepath_partition_kernel(KeysInputIterator keys,
                              const CompareOpT compare_op,
                              const OffsetT sorted_block_size)
 {
+    using config = device_target_arch_config_t<Config>;
+    // BlockSize of the partition kernel
+    constexpr unsigned int BlockSize = config::merge_mergepath_partition_config::block_size;
+    // ItemsPerTile of the block merge kernel
+    constexpr unsigned int ItemsPerTile = config::merge_mergepath_config::block_size
+                                          * config::merge_mergepath_config::items_per_thread;
+
     const OffsetT partition_id = blockIdx.x * BlockSize + threadIdx.x;
 
     if (partition_id >= num_partitions)
@@ -197,6 +211,7 @@ void device_mergepath_partition_kernel(KeysInputIterator keys,
 
 template<
     class Config,
+    class ArchConfig,
     class KeysInputIterator,
     class KeysOutputIterator,
     class ValuesInputIterator,
@@ -204,27 +219,23 @@ template<
     class BinaryFunction
 >
 inline
-hipError_t merge_sort_impl(void * temporary_storage,
-                           size_t& storage_size,
-                           KeysInputIterator keys_input,
-                           KeysOutputIterator keys_output,
-                           ValuesInputIterator values_input,
-                           ValuesOutputIterator values_output,
-                           const unsigned int size,
-                           BinaryFunction compare_function,
-                           const hipStream_t stream,
-                           bool debug_synchronous)
+hipError_t merge_sort_arch_impl(void * temporary_storage,
+                                size_t& storage_size,
+                                KeysInputIterator keys_input,
+                                KeysOutputIterator keys_output,
+                                ValuesInputIterator values_input,
+                                ValuesOutputIterator values_output,
+                                const unsigned int size,
+                                BinaryFunction compare_function,
+                                const hipStream_t stream,
+                                bool debug_synchronous)
 {
     using OffsetT = unsigned int;
     using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
     using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
     constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
 
-    // Get default config if Config is default_config
-    using config = default_or_custom_config<
-        Config,
-        default_merge_sort_config<ROCPRIM_TARGET_ARCH, key_type, value_type>
-    >;
+    using config = ArchConfig;
 
     static constexpr unsigned int sort_block_size = config::sort_config::block_size;
     static constexpr unsigned int sort_items_per_thread = config::sort_config::items_per_thread;
@@ -296,12 +307,21 @@ hipError_t merge_sort_impl(void * temporary_storage,
     ptr += keys_bytes;
     value_type * values_buffer = with_values ? reinterpret_cast<value_type*>(ptr) : nullptr;
 
+    // Every pass reads and writes all keys and values
+    const size_t pass_bytes = size_t(size) * (sizeof(key_type) + (with_values ? sizeof(value_type) : 0));
+
     // Start point for time measurements
     std::chrono::high_resolution_clock::time_point start;
+    kernel_trace_begin(stream,
+                       dim3(sort_number_of_blocks),
+                       dim3(sort_block_size),
+                       sort_items_per_thread,
+                       pass_bytes,
+                       pass_bytes);
     if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
 
     hipLaunchKernelGGL(
-        HIP_KERNEL_NAME(block_sort_kernel<sort_block_size, sort_items_per_thread>),
+        HIP_KERNEL_NAME(block_sort_kernel<Config>),
         dim3(sort_number_of_blocks), dim3(sort_block_size), 0, stream,
         keys_input, keys_buffer, values_input, values_buffer,
         size, compare_function
@@ -319,16 +339,29 @@ hipError_t merge_sort_impl(void * temporary_storage,
                                     auto values_output_) -> hipError_t {
             if(use_mergepath)
             {
+                // Every partition point is found by a binary search in the keys
+                kernel_trace_begin(stream,
+                                   dim3(merge_partition_number_of_blocks),
+                                   dim3(merge_partition_block_size),
+                                   1,
+                                   merge_num_partitions * sizeof(key_type),
+                                   merge_num_partitions * sizeof(OffsetT));
                 if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-                hipLaunchKernelGGL(HIP_KERNEL_NAME(device_mergepath_partition_kernel<merge_partition_block_size, merge_mergepath_items_per_block>),
+                hipLaunchKernelGGL(HIP_KERNEL_NAME(device_mergepath_partition_kernel<Config>),
                                    dim3(merge_partition_number_of_blocks), dim3(merge_partition_block_size), 0, stream,
                                    keys_input_, size, merge_num_partitions, d_merge_partitions,
                                    compare_function, block);
                 ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("device_mergepath_partition_kernel", size, start);
 
+                kernel_trace_begin(stream,
+                                   dim3(merge_mergepath_number_of_blocks),
+                                   dim3(merge_mergepath_block_size),
+                                   merge_mergepath_items_per_thread,
+                                   pass_bytes + merge_num_partitions * sizeof(OffsetT),
+                                   pass_bytes);
                 if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
                 hipLaunchKernelGGL(
-                    HIP_KERNEL_NAME(block_merge_kernel<merge_mergepath_block_size, merge_mergepath_items_per_thread>),
+                    HIP_KERNEL_NAME(block_merge_kernel<Config>),
                     dim3(merge_mergepath_number_of_blocks), dim3(merge_mergepath_block_size), 0, stream,
                     keys_input_, keys_output_, values_input_, values_output_,
                     size, block, compare_function, d_merge_partitions
@@ -337,10 +370,15 @@ hipError_t merge_sort_impl(void * temporary_storage,
             }
             else
             {
+                kernel_trace_begin(stream,
+                                   dim3(merge_impl1_number_of_blocks),
+                                   dim3(merge_impl1_block_size),
+                                   merge_impl1_items_per_thread,
+                                   pass_bytes,
+                                   pass_bytes);
                 if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
                 hipLaunchKernelGGL(
-                    HIP_KERNEL_NAME(
-                        block_merge_kernel<merge_impl1_block_size, merge_impl1_items_per_thread>),
+                    HIP_KERNEL_NAME(block_merge_kernel<Config>),
                     dim3(merge_impl1_number_of_blocks),
                     dim3(merge_impl1_block_size),
                     0,
@@ -390,6 +428,176 @@ hipError_t merge_sort_impl(void * temporary_storage,
     return hipSuccess;
 }
 
+// Values are small enough to be moved by the merge steps.
+template<
+    class Config,
+    target_arch Arch,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class BinaryFunction
+>
+inline
+hipError_t merge_sort_indirect_impl(std::false_type /*is_indirect*/,
+                                    void * temporary_storage,
+                                    size_t& storage_size,
+                                    KeysInputIterator keys_input,
+                                    KeysOutputIterator keys_output,
+                                    ValuesInputIterator values_input,
+                                    ValuesOutputIterator values_output,
+                                    const unsigned int size,
+                                    BinaryFunction compare_function,
+                                    const hipStream_t stream,
+                                    bool debug_synchronous)
+{
+    return merge_sort_arch_impl<Config, target_arch_config_t<Config, Arch>>(
+        temporary_storage, storage_size,
+        keys_input, keys_output, values_input, values_output, size,
+        compare_function, stream, debug_synchronous
+    );
+}
+
+// Large values are not moved by the merge steps: keys are sorted together with 32-bit indices
+// of their values (tuned as pairs with unsigned int values), then the values are gathered once.
+// Inputs sorted by a single block and in-place sorts are sorted directly.
+template<
+    class Config,
+    target_arch Arch,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class BinaryFunction
+>
+inline
+hipError_t merge_sort_indirect_impl(std::true_type /*is_indirect*/,
+                                    void * temporary_storage,
+                                    size_t& storage_size,
+                                    KeysInputIterator keys_input,
+                                    KeysOutputIterator keys_output,
+                                    ValuesInputIterator values_input,
+                                    ValuesOutputIterator values_output,
+                                    const unsigned int size,
+                                    BinaryFunction compare_function,
+                                    const hipStream_t stream,
+                                    bool debug_synchronous)
+{
+    using index_type = unsigned int;
+
+    using arch_config = target_arch_config_t<Config, Arch>;
+    // The indices are sorted with the config of the same architecture, without dispatching again
+    using index_config = typename Config::template with_value<index_type>;
+
+    constexpr unsigned int sort_items_per_block
+        = arch_config::sort_config::block_size * arch_config::sort_config::items_per_thread;
+
+    if(size <= sort_items_per_block
+       || ::rocprim::detail::are_iterators_equal(values_input, values_output))
+    {
+        return merge_sort_arch_impl<Config, arch_config>(
+            temporary_storage, storage_size,
+            keys_input, keys_output, values_input, values_output, size,
+            compare_function, stream, debug_synchronous
+        );
+    }
+
+    const size_t indices_bytes = ::rocprim::detail::align_size(size * sizeof(index_type));
+
+    index_type * indices_output = nullptr;
+    size_t sort_storage_size;
+    hipError_t error = merge_sort_arch_impl<index_config, target_arch_config_t<index_config, Arch>>(
+        nullptr, sort_storage_size,
+        keys_input, keys_output,
+        ::rocprim::counting_iterator<index_type>(0), indices_output, size,
+        compare_function, stream, debug_synchronous
+    );
+    if(error != hipSuccess) return error;
+
+    if(temporary_storage == nullptr)
+    {
+        storage_size = indices_bytes + sort_storage_size;
+        return hipSuccess;
+    }
+
+    char * ptr = reinterpret_cast<char *>(temporary_storage);
+    indices_output = reinterpret_cast<index_type *>(ptr);
+    ptr += indices_bytes;
+
+    error = merge_sort_arch_impl<index_config, target_arch_config_t<index_config, Arch>>(
+        ptr, sort_storage_size,
+        keys_input, keys_output,
+        ::rocprim::counting_iterator<index_type>(0), indices_output, size,
+        compare_function, stream, debug_synchronous
+    );
+    if(error != hipSuccess) return error;
+
+    return ::rocprim::transform(
+        indices_output, values_output, size,
+        indirect_gather_op<ValuesInputIterator>{values_input}, stream, debug_synchronous
+    );
+}
+
+template<
+    class Config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class BinaryFunction
+>
+inline
+hipError_t merge_sort_impl(void * temporary_storage,
+                           size_t& storage_size,
+                           KeysInputIterator keys_input,
+                           KeysOutputIterator keys_output,
+                           ValuesInputIterator values_input,
+                           ValuesOutputIterator values_output,
+                           const unsigned int size,
+                           BinaryFunction compare_function,
+                           const hipStream_t stream,
+                           bool debug_synchronous)
+{
+#if ROCPRIM_DETAIL_USE_HOST_NATIVE
+    return host_native_merge_sort(temporary_storage,
+                                  storage_size,
+                                  keys_input,
+                                  keys_output,
+                                  values_input,
+                                  values_output,
+                                  size,
+                                  compare_function,
+                                  stream,
+                                  debug_synchronous);
+#else
+
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = wrapped_merge_sort_config<Config, key_type, value_type>;
+
+    return dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            using arch_config_type = typename decltype(arch_config)::type;
+            return merge_sort_indirect_impl<config, decltype(arch_config)::arch>(
+                is_indirect_sort<arch_config_type, value_type>{},
+                temporary_storage,
+                storage_size,
+                keys_input,
+                keys_output,
+                values_input,
+                values_output,
+                size,
+                compare_function,
+                stream,
+                debug_synchronous);
+        });
+#endif
+}
+
 #undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
 #undef ROCPRIM_DETAIL_HIP_SYNC
 
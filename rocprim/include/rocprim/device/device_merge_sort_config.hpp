@@ -169,6 +169,22 @@ struct default_merge_sort_config
         merge_sort_config_900<Key, Value>
     > { };
 
+// Config of merge_sort per target architecture.
+template<class Config, class Key, class Value>
+struct wrapped_merge_sort_config
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        using type
+            = arch_config_t<Config, default_merge_sort_config<static_cast<unsigned int>(Arch), Key, Value>>;
+    };
+
+    // The wrapped config of the same Config for sorting with values of type OtherValue
+    template<class OtherValue>
+    using with_value = wrapped_merge_sort_config<Config, Key, OtherValue>;
+};
+
 } // end namespace detail
 
 END_ROCPRIM_NAMESPACE
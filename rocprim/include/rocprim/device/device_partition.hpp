@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <type_traits>
 
 #include "../config.hpp"
@@ -36,6 +37,7 @@
 #include "detail/device_scan_common.hpp"
 #include "detail/device_partition.hpp"
 #include "device_transform.hpp"
+#include "device_trace.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -56,36 +58,33 @@ template<select_method SelectMethod,
          class InequalityOp,
          class OffsetLookbackScanState,
          class... UnaryPredicates>
-ROCPRIM_KERNEL __launch_bounds__(Config::block_size) void partition_kernel(
-    KeyIterator                    keys_input,
-    ValueIterator                  values_input,
-    FlagIterator                   flags,
-    OutputKeyIterator              keys_output,
-    OutputValueIterator            values_output,
-    size_t*                        selected_count,
-    size_t*                        prev_selected_count,
-    size_t                         prev_processed,
-    const size_t                   total_size,
-    InequalityOp                   inequality_op,
-    OffsetLookbackScanState        offset_scan_state,
-    const unsigned int             number_of_blocks,
-    ordered_block_id<unsigned int> ordered_bid,
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::block_size) void partition_kernel(
+    KeyIterator                             keys_input,
+    ValueIterator                           values_input,
+    FlagIterator                            flags,
+    OutputKeyIterator                       keys_output,
+    OutputValueIterator                     values_output,
+    size_t*                                 selected_count,
+    const size_t                            total_size,
+    InequalityOp                            inequality_op,
+    OffsetLookbackScanState                 offset_scan_state,
+    const size_t                            number_of_tiles,
+    ordered_block_id<lookback_tile_id_type> ordered_tile_id,
     UnaryPredicates... predicates)
 {
-    partition_kernel_impl<SelectMethod, OnlySelected, Config>(keys_input,
-                                                              values_input,
-                                                              flags,
-                                                              keys_output,
-                                                              values_output,
-                                                              selected_count,
-                                                              prev_selected_count,
-                                                              prev_processed,
-                                                              total_size,
-                                                              inequality_op,
-                                                              offset_scan_state,
-                                                              number_of_blocks,
-                                                              ordered_bid,
-                                                              predicates...);
+    partition_kernel_impl<SelectMethod, OnlySelected, device_target_arch_config_t<Config>>(
+        keys_input,
+        values_input,
+        flags,
+        keys_output,
+        values_output,
+        selected_count,
+        total_size,
+        inequality_op,
+        offset_scan_state,
+        number_of_tiles,
+        ordered_tile_id,
+        predicates...);
 }
 
 #define ROCPRIM_DETAIL_HIP_SYNC(name, size, start) \
@@ -103,6 +102,7 @@ ROCPRIM_KERNEL __launch_bounds__(Config::block_size) void partition_kernel(
     { \
         auto _error = hipGetLastError(); \
         if(_error != hipSuccess) return _error; \
+        ::rocprim::detail::kernel_trace_end(name, size, stream); \
         if(debug_synchronous) \
         { \
             std::cout << name << "(" << size << ")"; \
@@ -120,6 +120,7 @@ template<
      // if true, it doesn't copy rejected values to output
     bool OnlySelected,
     class Config,
+    class ArchConfig,
     class OffsetT,
     class KeyIterator,
     class ValueIterator, // can be rocprim::empty_type* for key only
@@ -131,34 +132,26 @@ template<
     class... UnaryPredicates
 >
 inline
-hipError_t partition_impl(void * temporary_storage,
-                          size_t& storage_size,
-                          KeyIterator keys_input,
-                          ValueIterator values_input,
-                          FlagIterator flags,
-                          OutputKeyIterator keys_output,
-                          OutputValueIterator values_output,
-                          SelectedCountOutputIterator selected_count_output,
-                          const size_t size,
-                          InequalityOp inequality_op,
-                          const hipStream_t stream,
-                          bool debug_synchronous,
-                          UnaryPredicates... predicates)
+hipError_t partition_arch_impl(void * temporary_storage,
+                               size_t& storage_size,
+                               KeyIterator keys_input,
+                               ValueIterator values_input,
+                               FlagIterator flags,
+                               OutputKeyIterator keys_output,
+                               OutputValueIterator values_output,
+                               SelectedCountOutputIterator selected_count_output,
+                               const size_t size,
+                               InequalityOp inequality_op,
+                               const hipStream_t stream,
+                               bool debug_synchronous,
+                               UnaryPredicates... predicates)
 {
     using offset_type = OffsetT;
-    using key_type = typename std::iterator_traits<KeyIterator>::value_type;
-    using value_type = typename std::iterator_traits<ValueIterator>::value_type;
-
-    // Get default config if Config is default_config
-    using config = default_or_custom_config<
-        Config,
-        default_select_config<ROCPRIM_TARGET_ARCH, key_type, value_type>
-    >;
+    using config = ArchConfig;
 
     using offset_scan_state_type = detail::lookback_scan_state<offset_type>;
     using offset_scan_state_with_sleep_type = detail::lookback_scan_state<offset_type, true>;
-    using ordered_block_id_type = detail::ordered_block_id<unsigned int>;
-
+    using ordered_tile_id_type = detail::ordered_block_id<lookback_tile_id_type>;
 
     static constexpr unsigned int block_size = config::block_size;
     static constexpr unsigned int items_per_thread = config::items_per_thread;
@@ -166,28 +159,22 @@ hipError_t partition_impl(void * temporary_storage,
 
     static constexpr bool is_three_way = sizeof...(UnaryPredicates) == 2;
 
-    static constexpr size_t size_limit = config::size_limit;
-    static constexpr size_t aligned_size_limit = ::rocprim::max<size_t>(size_limit - (size_limit % items_per_block), items_per_block);
-    const size_t limited_size = std::min<size_t>(size, aligned_size_limit);
-    const bool use_limited_size = limited_size == aligned_size_limit;
-
-    const unsigned int number_of_blocks = 
-        static_cast<unsigned int>(::rocprim::detail::ceiling_div(limited_size, items_per_block));
+    const size_t number_of_tiles = ::rocprim::detail::ceiling_div(size, items_per_block);
 
     // Calculate required temporary storage
     size_t offset_scan_state_bytes = ::rocprim::detail::align_size(
         // This is valid even with offset_scan_state_with_sleep_type
-        offset_scan_state_type::get_storage_size(number_of_blocks)
+        offset_scan_state_type::get_storage_size(number_of_tiles)
     );
-    size_t ordered_block_id_bytes = ::rocprim::detail::align_size(
-        ordered_block_id_type::get_storage_size(),
+    size_t ordered_tile_id_bytes = ::rocprim::detail::align_size(
+        ordered_tile_id_type::get_storage_size(),
         alignof(size_t)
     );
 
     if(temporary_storage == nullptr)
     {
         // storage_size is never zero
-        storage_size = offset_scan_state_bytes + ordered_block_id_bytes + (sizeof(size_t) * 2 * (is_three_way ? 2 : 1));
+        storage_size = offset_scan_state_bytes + ordered_tile_id_bytes + (sizeof(size_t) * (is_three_way ? 2 : 1));
 
         return hipSuccess;
     }
@@ -197,29 +184,26 @@ hipError_t partition_impl(void * temporary_storage,
 
     // Create and initialize lookback_scan_state obj
     auto offset_scan_state = offset_scan_state_type::create(
-        temporary_storage, number_of_blocks
+        temporary_storage, number_of_tiles
     );
     auto offset_scan_state_with_sleep = offset_scan_state_with_sleep_type::create(
-        temporary_storage, number_of_blocks
+        temporary_storage, number_of_tiles
     );
     // Create ad initialize ordered_block_id obj
     auto ptr = reinterpret_cast<char*>(temporary_storage);
-    auto ordered_bid = ordered_block_id_type::create(
-        reinterpret_cast<ordered_block_id_type::id_type*>(ptr + offset_scan_state_bytes)
+    auto ordered_tile_id = ordered_tile_id_type::create(
+        reinterpret_cast<ordered_tile_id_type::id_type*>(ptr + offset_scan_state_bytes)
     );
 
     size_t* selected_count = reinterpret_cast<size_t*>(ptr + offset_scan_state_bytes
-                                                       + ordered_block_id_bytes);
-    size_t* prev_selected_count
-        = reinterpret_cast<size_t*>(ptr + offset_scan_state_bytes + ordered_block_id_bytes
-                                    + (is_three_way ? 2 : 1) * sizeof(size_t));
+                                                       + ordered_tile_id_bytes);
 
     hipError_t error;
 
-    // Memset selected_count and prev_selected_count at once
+    // Memset selected_count, it stays zero if there are no tiles
     error = hipMemsetAsync(selected_count,
                            0,
-                           sizeof(*selected_count) * 2 * (is_three_way ? 2 : 1),
+                           sizeof(*selected_count) * (is_three_way ? 2 : 1),
                            stream);
     if (error != hipSuccess) return error;
 
@@ -234,34 +218,32 @@ hipError_t partition_impl(void * temporary_storage,
     int asicRevision = 0;
 #endif
 
-    const size_t number_of_launches = ::rocprim::detail::ceiling_div(size, aligned_size_limit);
+    // All tiles are processed by a single launch, blocks take several tiles if the tiles would
+    // exceed config::size_limit items
+    const unsigned int grid_size
+        = lookback_grid_size(number_of_tiles, items_per_block, config::size_limit);
 
     if(debug_synchronous)
     {
-        std::cout << "use_limited_size " << use_limited_size << '\n';
-        std::cout << "aligned_size_limit " << aligned_size_limit << '\n';
-        std::cout << "number_of_launches " << number_of_launches << '\n';
         std::cout << "size " << size << '\n';
         std::cout << "block_size " << block_size << '\n';
-        std::cout << "number of blocks " << number_of_blocks << '\n';
+        std::cout << "number of tiles " << number_of_tiles << '\n';
+        std::cout << "number of blocks " << grid_size << '\n';
         std::cout << "items_per_block " << items_per_block << '\n';
     }
 
-    for(size_t i = 0, prev_processed = 0; i < number_of_launches;
-        i++, prev_processed += limited_size)
+    if(number_of_tiles > 0)
     {
-        const unsigned int current_size
-            = static_cast<unsigned int>(std::min<size_t>(size - prev_processed, limited_size));
-
-        const unsigned int current_number_of_blocks = ::rocprim::detail::ceiling_div(current_size, items_per_block);
-
-        auto grid_size = ::rocprim::detail::ceiling_div(number_of_blocks, block_size);
+        const unsigned int init_grid_size = ::rocprim::detail::ceiling_div(number_of_tiles, block_size);
 
+        kernel_trace_begin(stream,
+                           dim3(init_grid_size),
+                           dim3(block_size),
+                           1,
+                           0,
+                           offset_scan_state_type::get_storage_size(number_of_tiles));
         if(debug_synchronous)
         {
-            std::cout << "current size " << current_size << '\n';
-            std::cout << "current number of blocks " << current_number_of_blocks << '\n';
-
             start = std::chrono::high_resolution_clock::now();
         }
 
@@ -269,77 +251,79 @@ hipError_t partition_impl(void * temporary_storage,
         {
             hipLaunchKernelGGL(
                 HIP_KERNEL_NAME(init_lookback_scan_state_kernel<offset_scan_state_with_sleep_type>),
-                dim3(grid_size), dim3(block_size), 0, stream,
-                offset_scan_state_with_sleep, current_number_of_blocks, ordered_bid
+                dim3(init_grid_size), dim3(block_size), 0, stream,
+                offset_scan_state_with_sleep, number_of_tiles, ordered_tile_id
             );
         } else
         {
             hipLaunchKernelGGL(
                 HIP_KERNEL_NAME(init_lookback_scan_state_kernel<offset_scan_state_type>),
-                dim3(grid_size), dim3(block_size), 0, stream,
-                offset_scan_state, current_number_of_blocks, ordered_bid
+                dim3(init_grid_size), dim3(block_size), 0, stream,
+                offset_scan_state, number_of_tiles, ordered_tile_id
             );
         }
 
-        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("init_offset_scan_state_kernel", current_number_of_blocks, start)
-
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("init_offset_scan_state_kernel", number_of_tiles, start)
+
+        // Every item is read once and written to one of the outputs, unless only the selected
+        // items are written
+        const size_t item_bytes = kernel_trace_item_bytes<KeyIterator>()
+                                  + kernel_trace_item_bytes<ValueIterator>();
+        kernel_trace_begin(stream,
+                           dim3(grid_size),
+                           dim3(block_size),
+                           items_per_thread,
+                           size * (item_bytes + kernel_trace_item_bytes<FlagIterator>()),
+                           size * item_bytes);
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
 
-        grid_size = current_number_of_blocks;
-        
         if (prop.gcnArch == 908 && asicRevision < 2)
         {
             hipLaunchKernelGGL(
-                HIP_KERNEL_NAME(partition_kernel<SelectMethod, OnlySelected, config>),
+                HIP_KERNEL_NAME(partition_kernel<SelectMethod, OnlySelected, Config>),
                 dim3(grid_size),
                 dim3(block_size),
                 0,
                 stream,
-                keys_input + prev_processed,
-                values_input + prev_processed,
-                flags + prev_processed,
+                keys_input,
+                values_input,
+                flags,
                 keys_output,
                 values_output,
                 selected_count,
-                prev_selected_count,
-                prev_processed,
                 size,
                 inequality_op,
                 offset_scan_state_with_sleep,
-                current_number_of_blocks,
-                ordered_bid,
+                number_of_tiles,
+                ordered_tile_id,
                 predicates...);
         } else
         {
             hipLaunchKernelGGL(
-                HIP_KERNEL_NAME(partition_kernel<SelectMethod, OnlySelected, config>),
+                HIP_KERNEL_NAME(partition_kernel<SelectMethod, OnlySelected, Config>),
                 dim3(grid_size),
                 dim3(block_size),
                 0,
                 stream,
-                keys_input + prev_processed,
-                values_input + prev_processed,
-                flags + prev_processed,
+                keys_input,
+                values_input,
+                flags,
                 keys_output,
                 values_output,
                 selected_count,
-                prev_selected_count,
-                prev_processed,
                 size,
                 inequality_op,
                 offset_scan_state,
-                current_number_of_blocks,
-                ordered_bid,
+                number_of_tiles,
+                ordered_tile_id,
                 predicates...);
         }
 
         ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("partition_kernel", size, start)
-
-        std::swap(selected_count, prev_selected_count);
     }
 
     error = ::rocprim::transform(
-        prev_selected_count, selected_count_output, (is_three_way ? 2 : 1), 
+        selected_count, selected_count_output, (is_three_way ? 2 : 1),
         ::rocprim::identity<>{},
         stream, debug_synchronous
     );
@@ -348,6 +332,107 @@ hipError_t partition_impl(void * temporary_storage,
     return hipSuccess;
 }
 
+// 64-bit offset type used instead of OffsetT for inputs with more than 2^32 - 1 items
+template<class OffsetT>
+struct partition_large_offset;
+
+template<>
+struct partition_large_offset<unsigned int>
+{
+    using type = size_t;
+};
+
+template<>
+struct partition_large_offset<uint2>
+{
+    using type = ulonglong2;
+};
+
+template<class OffsetT>
+using partition_large_offset_t = typename partition_large_offset<OffsetT>::type;
+
+template<
+    // Method of selection: flag, predicate, unique
+    select_method SelectMethod,
+     // if true, it doesn't copy rejected values to output
+    bool OnlySelected,
+    class Config,
+    class OffsetT,
+    class KeyIterator,
+    class ValueIterator, // can be rocprim::empty_type* for key only
+    class FlagIterator,
+    class OutputKeyIterator,
+    class OutputValueIterator, // can be rocprim::empty_type* for key only
+    class InequalityOp,
+    class SelectedCountOutputIterator,
+    class... UnaryPredicates
+>
+inline
+hipError_t partition_impl(void * temporary_storage,
+                          size_t& storage_size,
+                          KeyIterator keys_input,
+                          ValueIterator values_input,
+                          FlagIterator flags,
+                          OutputKeyIterator keys_output,
+                          OutputValueIterator values_output,
+                          SelectedCountOutputIterator selected_count_output,
+                          const size_t size,
+                          InequalityOp inequality_op,
+                          const hipStream_t stream,
+                          bool debug_synchronous,
+                          UnaryPredicates... predicates)
+{
+    using key_type = typename std::iterator_traits<KeyIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValueIterator>::value_type;
+
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = wrapped_select_config<Config, key_type, value_type>;
+
+    return dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            // 32-bit offsets are scanned unless the input is too large for them
+            if(size <= std::numeric_limits<unsigned int>::max())
+            {
+                return partition_arch_impl<SelectMethod,
+                                           OnlySelected,
+                                           config,
+                                           typename decltype(arch_config)::type,
+                                           OffsetT>(temporary_storage,
+                                                    storage_size,
+                                                    keys_input,
+                                                    values_input,
+                                                    flags,
+                                                    keys_output,
+                                                    values_output,
+                                                    selected_count_output,
+                                                    size,
+                                                    inequality_op,
+                                                    stream,
+                                                    debug_synchronous,
+                                                    predicates...);
+            }
+            return partition_arch_impl<SelectMethod,
+                                       OnlySelected,
+                                       config,
+                                       typename decltype(arch_config)::type,
+                                       partition_large_offset_t<OffsetT>>(temporary_storage,
+                                                                          storage_size,
+                                                                          keys_input,
+                                                                          values_input,
+                                                                          flags,
+                                                                          keys_output,
+                                                                          values_output,
+                                                                          selected_count_output,
+                                                                          size,
+                                                                          inequality_op,
+                                                                          stream,
+                                                                          debug_synchronous,
+                                                                          predicates...);
+        });
+}
+
 #undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
 #undef ROCPRIM_DETAIL_HIP_SYNC
 
@@ -755,6 +840,130 @@ hipError_t partition_three_way(void * temporary_storage,
     );
 }
 
+namespace detail
+{
+
+// Partitioners of segment indices by segment length, used by segmented algorithms to process
+// short and long segments with different kernels.
+struct TwoWayPartitioner
+{
+    template<typename InputIterator,
+             typename FirstOutputIterator,
+             typename SecondOutputIterator,
+             typename UnselectedOutputIterator,
+             typename SelectedCountOutputIterator,
+             typename FirstUnaryPredicate,
+             typename SecondUnaryPredicate>
+    hipError_t operator()(void*               temporary_storage,
+                          size_t&             storage_size,
+                          InputIterator       input,
+                          FirstOutputIterator output_first_part,
+                          SecondOutputIterator /*output_second_part*/,
+                          UnselectedOutputIterator /*output_unselected*/,
+                          SelectedCountOutputIterator selected_count_output,
+                          const size_t                size,
+                          FirstUnaryPredicate         select_first_part_op,
+                          SecondUnaryPredicate /*select_second_part_op*/,
+                          const hipStream_t stream,
+                          const bool        debug_synchronous)
+    {
+        return partition(temporary_storage,
+                         storage_size,
+                         input,
+                         output_first_part,
+                         selected_count_output,
+                         size,
+                         select_first_part_op,
+                         stream,
+                         debug_synchronous);
+    }
+};
+
+struct ThreeWayPartitioner
+{
+    template<typename InputIterator,
+             typename FirstOutputIterator,
+             typename SecondOutputIterator,
+             typename UnselectedOutputIterator,
+             typename SelectedCountOutputIterator,
+             typename FirstUnaryPredicate,
+             typename SecondUnaryPredicate>
+    hipError_t operator()(void*                       temporary_storage,
+                          size_t&                     storage_size,
+                          InputIterator               input,
+                          FirstOutputIterator         output_first_part,
+                          SecondOutputIterator        output_second_part,
+                          UnselectedOutputIterator    output_unselected,
+                          SelectedCountOutputIterator selected_count_output,
+                          const size_t                size,
+                          FirstUnaryPredicate         select_first_part_op,
+                          SecondUnaryPredicate        select_second_part_op,
+                          const hipStream_t           stream,
+                          const bool                  debug_synchronous)
+    {
+        return partition_three_way(temporary_storage,
+                                   storage_size,
+                                   input,
+                                   output_first_part,
+                                   output_second_part,
+                                   output_unselected,
+                                   selected_count_output,
+                                   size,
+                                   select_first_part_op,
+                                   select_second_part_op,
+                                   stream,
+                                   debug_synchronous);
+    }
+};
+
+// Selects the segments longer than max_length for the partitioners of segmented algorithms.
+// The length is a member instead of a constant of the config, so the partition kernels are
+// the same for the configs of all architectures.
+template<class OffsetIterator>
+struct segment_length_greater_op
+{
+    OffsetIterator begin_offsets;
+    OffsetIterator end_offsets;
+    unsigned int   max_length;
+
+    ROCPRIM_HOST_DEVICE ROCPRIM_INLINE
+    bool operator()(const unsigned int segment_index)
+    {
+        const unsigned int segment_length
+            = end_offsets[segment_index] - begin_offsets[segment_index];
+        return segment_length > max_length;
+    }
+};
+
+// Reads the number of segments of a partition from the counts written by a partitioner
+// on the device, so the kernels of the partitions can be launched without copying the counts
+// to the host. The last partition is not counted by the partitioner, its count is the remainder.
+template<unsigned int PartitionCountSize>
+struct segment_partition_count
+{
+    const unsigned int* partition_counts;
+    unsigned int        partition;
+    unsigned int        segments;
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    unsigned int operator()() const
+    {
+        if(partition < PartitionCountSize)
+        {
+            return partition_counts[partition];
+        }
+        unsigned int count = segments;
+        ROCPRIM_UNROLL
+        for(unsigned int i = 0; i < PartitionCountSize; i++)
+        {
+            count -= partition_counts[i];
+        }
+        return count;
+    }
+};
+
+} // end namespace detail
+
 /// @}
 // end of group devicemodule
 
@@ -0,0 +1,458 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_PARTITION_BUCKETS_HPP_
+#define ROCPRIM_DEVICE_DEVICE_PARTITION_BUCKETS_HPP_
+
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+
+#include "detail/device_partition_buckets.hpp"
+#include "device_partition_buckets_config.hpp"
+#include "device_trace.hpp"
+
+/// \file
+///
+/// Device level bucket partitioning primitive
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule
+/// @{
+
+namespace detail
+{
+
+template<class Config, class InputIterator, class BucketOp>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::block_size) void partition_buckets_count_kernel(
+    InputIterator      input,
+    const size_t       size,
+    BucketOp           bucket_op,
+    const unsigned int num_buckets,
+    size_t*            batch_bucket_counts,
+    const unsigned int batches,
+    const unsigned int tiles_per_full_batch,
+    const unsigned int full_batches)
+{
+    partition_buckets_count<device_target_arch_config_t<Config>>(input,
+                                                                 size,
+                                                                 bucket_op,
+                                                                 num_buckets,
+                                                                 batch_bucket_counts,
+                                                                 batches,
+                                                                 tiles_per_full_batch,
+                                                                 full_batches);
+}
+
+template<class Config>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::block_size) void partition_buckets_scan_batches_kernel(
+    size_t* batch_bucket_counts, size_t* bucket_counts, const unsigned int batches)
+{
+    partition_buckets_scan_batches<device_target_arch_config_t<Config>>(batch_bucket_counts,
+                                                                        bucket_counts,
+                                                                        batches);
+}
+
+template<class Config, class OffsetsOutputIterator>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::block_size) void partition_buckets_scan_buckets_kernel(
+    size_t* bucket_starts, OffsetsOutputIterator bucket_offsets, const unsigned int num_buckets)
+{
+    partition_buckets_scan_buckets<device_target_arch_config_t<Config>>(bucket_starts,
+                                                                        bucket_offsets,
+                                                                        num_buckets);
+}
+
+template<class Config, class InputIterator, class OutputIterator, class BucketOp>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::block_size) void partition_buckets_scatter_kernel(
+    InputIterator       input,
+    OutputIterator      output,
+    const size_t        size,
+    BucketOp            bucket_op,
+    const unsigned int  num_buckets,
+    const unsigned int  bucket_bits,
+    const size_t* const batch_bucket_starts,
+    const size_t* const bucket_starts,
+    const unsigned int  batches,
+    const unsigned int  tiles_per_full_batch,
+    const unsigned int  full_batches)
+{
+    partition_buckets_scatter<device_target_arch_config_t<Config>>(input,
+                                                                   output,
+                                                                   size,
+                                                                   bucket_op,
+                                                                   num_buckets,
+                                                                   bucket_bits,
+                                                                   batch_bucket_starts,
+                                                                   bucket_starts,
+                                                                   batches,
+                                                                   tiles_per_full_batch,
+                                                                   full_batches);
+}
+
+#define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start)                           \
+    {                                                                                            \
+        auto _error = hipGetLastError();                                                         \
+        if(_error != hipSuccess)                                                                 \
+            return _error;                                                                       \
+        ::rocprim::detail::kernel_trace_end(name, size, stream);                                 \
+        if(debug_synchronous)                                                                    \
+        {                                                                                        \
+            std::cout << name << "(" << size << ")";                                             \
+            auto __error = hipStreamSynchronize(stream);                                         \
+            if(__error != hipSuccess)                                                            \
+                return __error;                                                                  \
+            auto _end = std::chrono::high_resolution_clock::now();                               \
+            auto _d   = std::chrono::duration_cast<std::chrono::duration<double>>(_end - start); \
+            std::cout << " " << _d.count() * 1000 << " ms" << '\n';                              \
+        }                                                                                        \
+    }
+
+template<class Config,
+         class ArchConfig,
+         class InputIterator,
+         class OutputIterator,
+         class OffsetsOutputIterator,
+         class BucketOp>
+inline hipError_t partition_buckets_arch_impl(void*                 temporary_storage,
+                                              size_t&               storage_size,
+                                              InputIterator         input,
+                                              OutputIterator        output,
+                                              OffsetsOutputIterator bucket_offsets,
+                                              const size_t          size,
+                                              const unsigned int    num_buckets,
+                                              BucketOp              bucket_op,
+                                              const hipStream_t     stream,
+                                              const bool            debug_synchronous)
+{
+    using config = ArchConfig;
+
+    constexpr unsigned int block_size     = config::block_size;
+    constexpr unsigned int items_per_tile = block_size * config::items_per_thread;
+    constexpr unsigned int max_buckets    = config::max_buckets;
+
+    static_assert(max_buckets <= items_per_tile,
+                  "max_buckets must not exceed BlockSize * ItemsPerThread");
+
+    if(num_buckets == 0 || num_buckets > max_buckets)
+    {
+        return hipErrorInvalidValue;
+    }
+
+    // Consecutive tiles are grouped into at most items_per_tile batches, so the counts of
+    // a bucket in all batches are scanned by a single block
+    const size_t       tiles = ceiling_div(size, items_per_tile);
+    const unsigned int tiles_per_full_batch
+        = static_cast<unsigned int>(ceiling_div(tiles, items_per_tile));
+    const unsigned int full_batches = tiles % items_per_tile != 0
+                                          ? static_cast<unsigned int>(tiles % items_per_tile)
+                                          : items_per_tile;
+    const unsigned int batches = tiles_per_full_batch == 1 ? full_batches : items_per_tile;
+
+    unsigned int bucket_bits = 0;
+    while((1u << bucket_bits) < num_buckets)
+    {
+        bucket_bits++;
+    }
+
+    const size_t batch_bucket_counts_bytes
+        = align_size(static_cast<size_t>(batches) * num_buckets * sizeof(size_t));
+    const size_t bucket_counts_bytes = align_size(num_buckets * sizeof(size_t));
+    if(temporary_storage == nullptr)
+    {
+        // storage_size is never zero
+        storage_size = batch_bucket_counts_bytes + bucket_counts_bytes;
+        return hipSuccess;
+    }
+
+    auto* ptr                 = static_cast<char*>(temporary_storage);
+    auto* batch_bucket_counts = reinterpret_cast<size_t*>(ptr);
+    ptr += batch_bucket_counts_bytes;
+    auto* bucket_counts = reinterpret_cast<size_t*>(ptr);
+
+    if(debug_synchronous)
+    {
+        std::cout << "size:                 " << size << '\n';
+        std::cout << "num_buckets:          " << num_buckets << '\n';
+        std::cout << "bucket_bits:          " << bucket_bits << '\n';
+        std::cout << "block_size:           " << block_size << '\n';
+        std::cout << "items_per_tile:       " << items_per_tile << '\n';
+        std::cout << "batches:              " << batches << '\n';
+        std::cout << "tiles_per_full_batch: " << tiles_per_full_batch << '\n';
+        std::cout << "full_batches:         " << full_batches << '\n';
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(size > 0)
+    {
+        if(debug_synchronous)
+            start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(partition_buckets_count_kernel<Config>),
+                           dim3(batches),
+                           dim3(block_size),
+                           0,
+                           stream,
+                           input,
+                           size,
+                           bucket_op,
+                           num_buckets,
+                           batch_bucket_counts,
+                           batches,
+                           tiles_per_full_batch,
+                           full_batches);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("partition_buckets_count_kernel", size, start);
+
+        if(debug_synchronous)
+            start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(partition_buckets_scan_batches_kernel<Config>),
+                           dim3(num_buckets),
+                           dim3(block_size),
+                           0,
+                           stream,
+                           batch_bucket_counts,
+                           bucket_counts,
+                           batches);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("partition_buckets_scan_batches_kernel",
+                                                    num_buckets * batches,
+                                                    start);
+    }
+    else
+    {
+        hipError_t error
+            = hipMemsetAsync(bucket_counts, 0, num_buckets * sizeof(size_t), stream);
+        if(error != hipSuccess)
+            return error;
+    }
+
+    // The offsets are written even if there are no items
+    if(debug_synchronous)
+        start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(partition_buckets_scan_buckets_kernel<Config>),
+                       dim3(1),
+                       dim3(block_size),
+                       0,
+                       stream,
+                       bucket_counts,
+                       bucket_offsets,
+                       num_buckets);
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("partition_buckets_scan_buckets_kernel",
+                                                num_buckets,
+                                                start);
+
+    if(size == 0)
+    {
+        return hipSuccess;
+    }
+
+    if(debug_synchronous)
+        start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(partition_buckets_scatter_kernel<Config>),
+                       dim3(batches),
+                       dim3(block_size),
+                       0,
+                       stream,
+                       input,
+                       output,
+                       size,
+                       bucket_op,
+                       num_buckets,
+                       bucket_bits,
+                       batch_bucket_counts,
+                       bucket_counts,
+                       batches,
+                       tiles_per_full_batch,
+                       full_batches);
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("partition_buckets_scatter_kernel", size, start);
+
+    return hipSuccess;
+}
+
+template<class Config,
+         class InputIterator,
+         class OutputIterator,
+         class OffsetsOutputIterator,
+         class BucketOp>
+inline hipError_t partition_buckets_impl(void*                 temporary_storage,
+                                         size_t&               storage_size,
+                                         InputIterator         input,
+                                         OutputIterator        output,
+                                         OffsetsOutputIterator bucket_offsets,
+                                         const size_t          size,
+                                         const unsigned int    num_buckets,
+                                         BucketOp              bucket_op,
+                                         const hipStream_t     stream,
+                                         const bool            debug_synchronous)
+{
+    using value_type = typename std::iterator_traits<InputIterator>::value_type;
+
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = wrapped_partition_buckets_config<Config, value_type>;
+
+    return dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            return partition_buckets_arch_impl<config, typename decltype(arch_config)::type>(
+                temporary_storage,
+                storage_size,
+                input,
+                output,
+                bucket_offsets,
+                size,
+                num_buckets,
+                bucket_op,
+                stream,
+                debug_synchronous);
+        });
+}
+
+#undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
+
+} // end namespace detail
+
+/// \brief Parallel bucket partition primitive for device level.
+///
+/// partition_buckets function scatters the items of the range of \p input into \p num_buckets
+/// buckets chosen by \p bucket_op. The items of bucket \p b are written to \p output
+/// starting at <tt>bucket_offsets[b]</tt>, in the same order as in \p input (the partitioning
+/// is stable). It is a generalization of \p partition and \p partition_three_way to more
+/// outputs, and replaces a radix sort by bucket ids: the buckets are counted per batch of
+/// tiles, the counts are scanned and every tile is scattered once.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Range specified by \p input must have at least \p size elements.
+/// * Range specified by \p output must have at least \p size elements.
+/// * Range specified by \p bucket_offsets must have at least <tt>num_buckets + 1</tt> elements.
+/// <tt>bucket_offsets[num_buckets]</tt> is \p size, so \p bucket_offsets and
+/// <tt>bucket_offsets + 1</tt> can be passed as begin and end offsets of the buckets to
+/// segmented primitives.
+/// * \p num_buckets must be in range <tt>[1; config::max_buckets]</tt> (1024 for the default
+/// config), otherwise \p hipErrorInvalidValue is returned.
+/// * \p bucket_op must return a bucket less than \p num_buckets for every item.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p partition_buckets_config or a custom class with the same members.
+/// \tparam InputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam OffsetsOutputIterator - random-access iterator type of the bucket offsets. Must meet
+/// the requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam BucketOp - type of unary function object used to choose the bucket of an item.
+/// The signature of the function should be equivalent to the following:
+/// <tt>unsigned int f(const T &a);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the object passed to it.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the partitioning.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to partition.
+/// \param [out] output - iterator to the first element in the output range.
+/// \param [out] bucket_offsets - iterator to the first of <tt>num_buckets + 1</tt> offsets
+/// of the buckets in \p output.
+/// \param [in] size - number of element in the input range.
+/// \param [in] num_buckets - number of buckets.
+/// \param [in] bucket_op - unary function object returning the bucket of an item.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful partitioning; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level partitioning of \p int values into 3 buckets by their
+/// remainder is performed.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// auto bucket_op = [] __device__ (int a) -> unsigned int { return a % 3; };
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size;      // e.g., 8
+/// int * input;            // e.g., [1, 2, 3, 4, 5, 6, 7, 8]
+/// int * output;           // empty array of 8 elements
+/// size_t * offsets;       // empty array of 4 elements
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::partition_buckets(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, offsets, input_size, 3, bucket_op
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // partition
+/// rocprim::partition_buckets(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, offsets, input_size, 3, bucket_op
+/// );
+/// // output: [3, 6, 1, 4, 7, 2, 5, 8]
+/// // offsets: [0, 2, 5, 8]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class InputIterator,
+         class OutputIterator,
+         class OffsetsOutputIterator,
+         class BucketOp>
+inline hipError_t partition_buckets(void*                 temporary_storage,
+                                    size_t&               storage_size,
+                                    InputIterator         input,
+                                    OutputIterator        output,
+                                    OffsetsOutputIterator bucket_offsets,
+                                    size_t                size,
+                                    unsigned int          num_buckets,
+                                    BucketOp              bucket_op,
+                                    hipStream_t           stream            = 0,
+                                    bool                  debug_synchronous = false)
+{
+    return detail::partition_buckets_impl<Config>(temporary_storage,
+                                                  storage_size,
+                                                  input,
+                                                  output,
+                                                  bucket_offsets,
+                                                  size,
+                                                  num_buckets,
+                                                  bucket_op,
+                                                  stream,
+                                                  debug_synchronous);
+}
+
+/// @}
+// end of group devicemodule
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_PARTITION_BUCKETS_HPP_
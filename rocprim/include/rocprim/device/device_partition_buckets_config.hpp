@@ -0,0 +1,87 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_PARTITION_BUCKETS_CONFIG_HPP_
+#define ROCPRIM_DEVICE_DEVICE_PARTITION_BUCKETS_CONFIG_HPP_
+
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+
+#include "config_types.hpp"
+
+/// \addtogroup primitivesmodule_deviceconfigs
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \brief Configuration of device-level bucket partitioning (\p partition_buckets).
+///
+/// \tparam BlockSize - number of threads in a block.
+/// \tparam ItemsPerThread - number of items processed by each thread.
+/// \tparam MaxBuckets - the largest number of buckets supported by the config. Shared memory
+/// usage grows linearly with it. Must not exceed <tt>BlockSize * ItemsPerThread</tt>.
+template<unsigned int BlockSize, unsigned int ItemsPerThread, unsigned int MaxBuckets = 1024>
+struct partition_buckets_config : kernel_config<BlockSize, ItemsPerThread>
+{
+    /// \brief The largest number of buckets supported by the config.
+    static constexpr unsigned int max_buckets = MaxBuckets;
+};
+
+namespace detail
+{
+
+template<class Value>
+struct partition_buckets_config_fallback
+{
+    static constexpr unsigned int item_scale
+        = ::rocprim::detail::ceiling_div<unsigned int>(sizeof(Value), sizeof(int));
+
+    using type = partition_buckets_config<256, ::rocprim::max(4u, 16u / item_scale)>;
+};
+
+template<unsigned int TargetArch, class Value>
+struct default_partition_buckets_config
+    : select_arch<TargetArch, partition_buckets_config_fallback<Value>>
+{
+};
+
+// Config of partition_buckets per target architecture.
+template<class Config, class Value>
+struct wrapped_partition_buckets_config
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        using type = arch_config_t<
+            Config,
+            default_partition_buckets_config<static_cast<unsigned int>(Arch), Value>>;
+    };
+};
+
+} // end namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+/// @}
+// end of group primitivesmodule_deviceconfigs
+
+#endif // ROCPRIM_DEVICE_DEVICE_PARTITION_BUCKETS_CONFIG_HPP_
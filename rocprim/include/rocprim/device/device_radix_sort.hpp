@@ -23,6 +23,7 @@
 
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <type_traits>
 #include <utility>
 
@@ -34,11 +35,16 @@
 #include "../functional.hpp"
 #include "../types.hpp"
 
+#include "../iterator/counting_iterator.hpp"
+
 #include "device_radix_sort_config.hpp"
 #include "device_transform.hpp"
+#include "detail/device_host_native.hpp"
 #include "detail/device_radix_sort.hpp"
+#include "detail/device_scan_common.hpp"
 #include "specialization/device_radix_single_sort.hpp"
 #include "specialization/device_radix_merge_sort.hpp"
+#include "device_trace.hpp"
 
 /// \addtogroup devicemodule
 /// @{
@@ -49,87 +55,89 @@ namespace detail
 {
 
 template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
-    unsigned int RadixBits,
+    class Config,
     bool Descending,
     class KeysInputIterator,
-    class Offset
+    class Decomposer
 >
 ROCPRIM_KERNEL
-__launch_bounds__(BlockSize)
-void fill_digit_counts_kernel(KeysInputIterator keys_input,
-                              Offset size,
-                              Offset * batch_digit_counts,
-                              unsigned int bit,
-                              unsigned int current_radix_bits,
-                              unsigned int blocks_per_full_batch,
-                              unsigned int full_batches)
+__launch_bounds__(device_target_arch_config_t<Config>::scan::block_size)
+void onesweep_histograms_kernel(KeysInputIterator keys_input,
+                                unsigned int * histograms,
+                                unsigned int size,
+                                unsigned int begin_bit,
+                                unsigned int end_bit,
+                                unsigned int long_iterations,
+                                unsigned int iterations,
+                                Decomposer decomposer)
 {
-    fill_digit_counts<BlockSize, ItemsPerThread, RadixBits, Descending>(
-        keys_input, size,
-        batch_digit_counts,
-        bit, current_radix_bits,
-        blocks_per_full_batch, full_batches
+    using config = device_target_arch_config_t<Config>;
+    onesweep_histograms<config::scan::block_size,
+                        config::scan::items_per_thread,
+                        config::long_radix_bits,
+                        config::short_radix_bits,
+                        Descending>(
+        keys_input, histograms, size,
+        begin_bit, end_bit,
+        long_iterations, iterations,
+        decomposer
     );
 }
 
 template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
-    unsigned int RadixBits,
-    class Offset
->
-ROCPRIM_KERNEL
-__launch_bounds__(BlockSize)
-void scan_batches_kernel(Offset * batch_digit_counts,
-                         Offset * digit_counts,
-                         unsigned int batches)
-{
-    scan_batches<BlockSize, ItemsPerThread, RadixBits>(batch_digit_counts, digit_counts, batches);
-}
-
-template<
-    unsigned int RadixBits,
+    class Config,
     class Offset
 >
 ROCPRIM_KERNEL
 __launch_bounds__(ROCPRIM_DEFAULT_MAX_BLOCK_SIZE)
-void scan_digits_kernel(Offset * digit_counts)
+void onesweep_scan_histograms_kernel(const unsigned int * histograms,
+                                     Offset * digit_offsets,
+                                     unsigned int portions,
+                                     unsigned int iterations)
 {
-    scan_digits<RadixBits>(digit_counts);
+    onesweep_scan_histograms<device_target_arch_config_t<Config>::long_radix_bits>(
+        histograms, digit_offsets, portions, iterations);
 }
 
+// Passes with long and short digits differ only in LongIteration, so a single wrapped config
+// instantiates two iteration kernels.
 template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
-    unsigned int RadixBits,
+    class Config,
+    bool LongIteration,
     bool Descending,
     class KeysInputIterator,
     class KeysOutputIterator,
     class ValuesInputIterator,
     class ValuesOutputIterator,
-    class Offset
+    class Offset,
+    class LookbackScanState,
+    class Decomposer
 >
 ROCPRIM_KERNEL
-__launch_bounds__(BlockSize)
-void sort_and_scatter_kernel(KeysInputIterator keys_input,
-                             KeysOutputIterator keys_output,
-                             ValuesInputIterator values_input,
-                             ValuesOutputIterator values_output,
-                             Offset size,
-                             const Offset * batch_digit_starts,
-                             const Offset * digit_starts,
-                             unsigned int bit,
-                             unsigned int current_radix_bits,
-                             unsigned int blocks_per_full_batch,
-                             unsigned int full_batches)
+__launch_bounds__(device_target_arch_config_t<Config>::sort::block_size)
+void onesweep_iteration_kernel(KeysInputIterator keys_input,
+                               KeysOutputIterator keys_output,
+                               ValuesInputIterator values_input,
+                               ValuesOutputIterator values_output,
+                               unsigned int size,
+                               const Offset * digit_offsets,
+                               Offset * next_digit_offsets,
+                               LookbackScanState lookback_scan_state,
+                               ordered_block_id<unsigned int> ordered_bid,
+                               unsigned int bit,
+                               unsigned int current_radix_bits,
+                               Decomposer decomposer)
 {
-    sort_and_scatter<BlockSize, ItemsPerThread, RadixBits, Descending>(
+    using config = device_target_arch_config_t<Config>;
+    onesweep_iteration<config::sort::block_size,
+                       config::sort::items_per_thread,
+                       LongIteration ? config::long_radix_bits : config::short_radix_bits,
+                       Descending>(
         keys_input, keys_output, values_input, values_output, size,
-        batch_digit_starts, digit_starts,
+        digit_offsets, next_digit_offsets,
+        lookback_scan_state, ordered_bid,
         bit, current_radix_bits,
-        blocks_per_full_batch, full_batches
+        decomposer
     );
 }
 
@@ -139,6 +147,7 @@ void sort_and_scatter_kernel(KeysInputIterator keys_input,
     { \
         auto _error = hipGetLastError(); \
         if(_error != hipSuccess) return _error; \
+        ::rocprim::detail::kernel_trace_end(name, size, stream); \
         if(debug_synchronous) \
         { \
             std::cout << name << "(" << size << ")"; \
@@ -154,35 +163,48 @@ void sort_and_scatter_kernel(KeysInputIterator keys_input,
 
 template<
     class Config,
-    unsigned int RadixBits,
+    class ArchConfig,
+    bool LongIteration,
     bool Descending,
     class KeysInputIterator,
     class KeysOutputIterator,
     class ValuesInputIterator,
     class ValuesOutputIterator,
-    class Offset
+    class Offset,
+    class LookbackScanState,
+    class Decomposer
 >
 inline
-hipError_t radix_sort_iteration(KeysInputIterator keys_input,
-                                typename std::iterator_traits<KeysInputIterator>::value_type * keys_tmp,
-                                KeysOutputIterator keys_output,
-                                ValuesInputIterator values_input,
-                                typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
-                                ValuesOutputIterator values_output,
-                                Offset size,
-                                Offset * batch_digit_counts,
-                                Offset * digit_counts,
-                                bool from_input,
-                                bool to_output,
-                                unsigned int bit,
-                                unsigned int end_bit,
-                                unsigned int blocks_per_full_batch,
-                                unsigned int full_batches,
-                                unsigned int batches,
-                                hipStream_t stream,
-                                bool debug_synchronous)
+hipError_t radix_sort_onesweep_iteration(KeysInputIterator keys_input,
+                                         typename std::iterator_traits<KeysInputIterator>::value_type * keys_tmp,
+                                         KeysOutputIterator keys_output,
+                                         ValuesInputIterator values_input,
+                                         typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
+                                         ValuesOutputIterator values_output,
+                                         size_t size,
+                                         const Offset * digit_offsets,
+                                         Offset * portion_digit_offsets,
+                                         LookbackScanState lookback_scan_state,
+                                         ordered_block_id<unsigned int> ordered_bid,
+                                         bool from_input,
+                                         bool to_output,
+                                         unsigned int bit,
+                                         unsigned int end_bit,
+                                         Decomposer decomposer,
+                                         size_t portion_size,
+                                         hipStream_t stream,
+                                         bool debug_synchronous)
 {
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+    static constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
+    constexpr unsigned int RadixBits
+        = LongIteration ? ArchConfig::long_radix_bits : ArchConfig::short_radix_bits;
     constexpr unsigned int radix_size = 1 << RadixBits;
+    constexpr unsigned int block_size = ArchConfig::sort::block_size;
+    constexpr unsigned int items_per_thread = ArchConfig::sort::items_per_thread;
+    constexpr unsigned int items_per_block = block_size * items_per_thread;
 
     // Handle cases when (end_bit - bit) is not divisible by RadixBits, i.e. the last
     // iteration has a shorter mask.
@@ -197,142 +219,106 @@ hipError_t radix_sort_iteration(KeysInputIterator keys_input,
         std::cout << "current_radix_bits " << current_radix_bits << '\n';
     }
 
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    if(from_input)
+    for(size_t offset = 0; offset < size; offset += portion_size)
     {
+        const unsigned int current_size = static_cast<unsigned int>(std::min(size - offset, portion_size));
+        const unsigned int blocks = ::rocprim::detail::ceiling_div(current_size, items_per_block);
+        const unsigned int lookback_size = blocks * radix_size;
+
+        // Digits of the first portion start at the global offsets of the pass, the last tile
+        // of every portion writes where the digits of the next one start (double-buffered,
+        // because the next launch overwrites the offsets read by the previous one)
+        const size_t portion = offset / portion_size;
+        const Offset * current_digit_offsets
+            = portion == 0 ? digit_offsets : portion_digit_offsets + ((portion - 1) % 2) * radix_size;
+        Offset * next_digit_offsets
+            = offset + portion_size < size ? portion_digit_offsets + (portion % 2) * radix_size : nullptr;
+
+        kernel_trace_begin(stream,
+                           dim3(::rocprim::detail::ceiling_div(lookback_size, block_size)),
+                           dim3(block_size),
+                           1,
+                           0,
+                           LookbackScanState::get_storage_size(lookback_size));
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
         hipLaunchKernelGGL(
-            HIP_KERNEL_NAME(fill_digit_counts_kernel<
-                Config::sort::block_size, Config::sort::items_per_thread, RadixBits, Descending
-            >),
-            dim3(batches), dim3(Config::sort::block_size), 0, stream,
-            keys_input, size,
-            batch_digit_counts,
-            bit, current_radix_bits,
-            blocks_per_full_batch, full_batches
+            HIP_KERNEL_NAME(init_lookback_scan_state_kernel<LookbackScanState>),
+            dim3(::rocprim::detail::ceiling_div(lookback_size, block_size)), dim3(block_size), 0, stream,
+            lookback_scan_state, lookback_size, ordered_bid
         );
-    }
-    else
-    {
-        if(to_output)
-        {
-            hipLaunchKernelGGL(
-                HIP_KERNEL_NAME(fill_digit_counts_kernel<
-                    Config::sort::block_size, Config::sort::items_per_thread, RadixBits, Descending
-                >),
-                dim3(batches), dim3(Config::sort::block_size), 0, stream,
-                keys_tmp, size,
-                batch_digit_counts,
-                bit, current_radix_bits,
-                blocks_per_full_batch, full_batches
-            );
-        }
-        else
-        {
-            hipLaunchKernelGGL(
-                HIP_KERNEL_NAME(fill_digit_counts_kernel<
-                    Config::sort::block_size, Config::sort::items_per_thread, RadixBits, Descending
-                >),
-                dim3(batches), dim3(Config::sort::block_size), 0, stream,
-                keys_output, size,
-                batch_digit_counts,
-                bit, current_radix_bits,
-                blocks_per_full_batch, full_batches
-            );
-        }
-    }
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("fill_digit_counts", size, start)
-
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    hipLaunchKernelGGL(
-        HIP_KERNEL_NAME(scan_batches_kernel<Config::scan::block_size, Config::scan::items_per_thread, RadixBits>),
-        dim3(radix_size), dim3(Config::scan::block_size), 0, stream,
-        batch_digit_counts, digit_counts, batches
-    );
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("scan_batches", radix_size * Config::scan::block_size, start)
-
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    hipLaunchKernelGGL(
-        HIP_KERNEL_NAME(scan_digits_kernel<RadixBits>),
-        dim3(1), dim3(radix_size), 0, stream,
-        digit_counts
-    );
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("scan_digits", radix_size, start)
-
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    if(from_input)
-    {
-        if(to_output)
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("init_lookback_scan_state", lookback_size, start)
+
+        // Every item is read and scattered once
+        const size_t item_bytes
+            = current_size * (sizeof(key_type) + (with_values ? sizeof(value_type) : 0));
+        kernel_trace_begin(stream,
+                           dim3(blocks),
+                           dim3(block_size),
+                           items_per_thread,
+                           item_bytes + radix_size * sizeof(Offset),
+                           item_bytes);
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        if(from_input)
         {
-            hipLaunchKernelGGL(
-                HIP_KERNEL_NAME(sort_and_scatter_kernel<
-                    Config::sort::block_size, Config::sort::items_per_thread, RadixBits, Descending
-                >),
-                dim3(batches), dim3(Config::sort::block_size), 0, stream,
-                keys_input, keys_output, values_input, values_output, size,
-                const_cast<const Offset *>(batch_digit_counts),
-                const_cast<const Offset *>(digit_counts),
-                bit, current_radix_bits,
-                blocks_per_full_batch, full_batches
-            );
-        }
-        else
-        {
-            hipLaunchKernelGGL(
-                HIP_KERNEL_NAME(sort_and_scatter_kernel<
-                    Config::sort::block_size, Config::sort::items_per_thread, RadixBits, Descending
-                >),
-                dim3(batches), dim3(Config::sort::block_size), 0, stream,
-                keys_input, keys_tmp, values_input, values_tmp, size,
-                const_cast<const Offset *>(batch_digit_counts),
-                const_cast<const Offset *>(digit_counts),
-                bit, current_radix_bits,
-                blocks_per_full_batch, full_batches
-            );
-        }
-    }
-    else
-    {
-        if(to_output)
-        {
-            hipLaunchKernelGGL(
-                HIP_KERNEL_NAME(sort_and_scatter_kernel<
-                    Config::sort::block_size, Config::sort::items_per_thread, RadixBits, Descending
-                >),
-                dim3(batches), dim3(Config::sort::block_size), 0, stream,
-                keys_tmp, keys_output, values_tmp, values_output, size,
-                const_cast<const Offset *>(batch_digit_counts),
-                const_cast<const Offset *>(digit_counts),
-                bit, current_radix_bits,
-                blocks_per_full_batch, full_batches
-            );
+            if(to_output)
+            {
+                hipLaunchKernelGGL(
+                    HIP_KERNEL_NAME(onesweep_iteration_kernel<Config, LongIteration, Descending>),
+                    dim3(blocks), dim3(block_size), 0, stream,
+                    keys_input + offset, keys_output, values_input + offset, values_output, current_size,
+                    current_digit_offsets, next_digit_offsets, lookback_scan_state, ordered_bid,
+                    bit, current_radix_bits, decomposer
+                );
+            }
+            else
+            {
+                hipLaunchKernelGGL(
+                    HIP_KERNEL_NAME(onesweep_iteration_kernel<Config, LongIteration, Descending>),
+                    dim3(blocks), dim3(block_size), 0, stream,
+                    keys_input + offset, keys_tmp, values_input + offset, values_tmp, current_size,
+                    current_digit_offsets, next_digit_offsets, lookback_scan_state, ordered_bid,
+                    bit, current_radix_bits, decomposer
+                );
+            }
         }
         else
         {
-            hipLaunchKernelGGL(
-                HIP_KERNEL_NAME(sort_and_scatter_kernel<
-                    Config::sort::block_size, Config::sort::items_per_thread, RadixBits, Descending
-                >),
-                dim3(batches), dim3(Config::sort::block_size), 0, stream,
-                keys_output, keys_tmp, values_output, values_tmp, size,
-                const_cast<const Offset *>(batch_digit_counts),
-                const_cast<const Offset *>(digit_counts),
-                bit, current_radix_bits,
-                blocks_per_full_batch, full_batches
-            );
+            if(to_output)
+            {
+                hipLaunchKernelGGL(
+                    HIP_KERNEL_NAME(onesweep_iteration_kernel<Config, LongIteration, Descending>),
+                    dim3(blocks), dim3(block_size), 0, stream,
+                    keys_tmp + offset, keys_output, values_tmp + offset, values_output, current_size,
+                    current_digit_offsets, next_digit_offsets, lookback_scan_state, ordered_bid,
+                    bit, current_radix_bits, decomposer
+                );
+            }
+            else
+            {
+                hipLaunchKernelGGL(
+                    HIP_KERNEL_NAME(onesweep_iteration_kernel<Config, LongIteration, Descending>),
+                    dim3(blocks), dim3(block_size), 0, stream,
+                    keys_output + offset, keys_tmp, values_output + offset, values_tmp, current_size,
+                    current_digit_offsets, next_digit_offsets, lookback_scan_state, ordered_bid,
+                    bit, current_radix_bits, decomposer
+                );
+            }
         }
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("onesweep_iteration", current_size, start)
     }
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("sort_and_scatter", size, start)
 
     return hipSuccess;
 }
 
 template<
     class Config,
+    class ArchConfig,
     bool Descending,
     class KeysInputIterator,
     class KeysOutputIterator,
     class ValuesInputIterator,
-    class ValuesOutputIterator
+    class ValuesOutputIterator,
+    class Decomposer
 >
 inline
 hipError_t radix_sort_single_impl(void * temporary_storage,
@@ -345,16 +331,13 @@ hipError_t radix_sort_single_impl(void * temporary_storage,
                                  bool& is_result_in_output,
                                  unsigned int begin_bit,
                                  unsigned int end_bit,
+                                 Decomposer decomposer,
                                  hipStream_t stream,
                                  bool debug_synchronous)
 {
-    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
-    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
-
-    using config = default_or_custom_config<
-        Config,
-        default_radix_sort_config<ROCPRIM_TARGET_ARCH, key_type, value_type>
-    >;
+    // The single block kernels are keyed on their block size and items per thread, so the
+    // configs of all architectures share them
+    using config = ArchConfig;
 
     const size_t minimum_bytes = ::rocprim::detail::align_size(1);
     if(temporary_storage == nullptr)
@@ -375,7 +358,7 @@ hipError_t radix_sort_single_impl(void * temporary_storage,
 
     hipError_t error = radix_sort_single<config, Descending>(
         keys_input, keys_output, values_input, values_output, size,
-        begin_bit, end_bit,
+        begin_bit, end_bit, decomposer,
         stream, debug_synchronous
     );
     if(error != hipSuccess) return error;
@@ -386,6 +369,7 @@ hipError_t radix_sort_single_impl(void * temporary_storage,
 
 template<
     class Config,
+    class ArchConfig,
     bool Descending,
     class KeysInputIterator,
     class KeysOutputIterator,
@@ -411,11 +395,6 @@ hipError_t radix_sort_merge_impl(void * temporary_storage,
     using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
     using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
 
-    using config = default_or_custom_config<
-        Config,
-        default_radix_sort_config<ROCPRIM_TARGET_ARCH, key_type, value_type>
-    >;
-
     constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
 
     const bool with_double_buffer = keys_tmp != nullptr;
@@ -447,7 +426,7 @@ hipError_t radix_sort_merge_impl(void * temporary_storage,
         values_tmp = with_values ? reinterpret_cast<value_type *>(ptr) : nullptr;
     }
 
-    hipError_t error = radix_sort_merge<config, Descending>(
+    hipError_t error = radix_sort_merge<Config, ArchConfig, Descending>(
         keys_input, keys_tmp, keys_output, values_input, values_tmp, values_output, size,
         begin_bit, end_bit,
         stream, debug_synchronous
@@ -467,51 +446,59 @@ using offset_type_t = std::conditional_t<
 
 template<
     class Config,
+    class ArchConfig,
     bool Descending,
     class KeysInputIterator,
     class KeysOutputIterator,
     class ValuesInputIterator,
     class ValuesOutputIterator,
-    class Size
+    class Size,
+    class Decomposer
 >
 inline
-hipError_t radix_sort_iterations_impl(void * temporary_storage,
-                                      size_t& storage_size,
-                                      KeysInputIterator keys_input,
-                                      typename std::iterator_traits<KeysInputIterator>::value_type * keys_tmp,
-                                      KeysOutputIterator keys_output,
-                                      ValuesInputIterator values_input,
-                                      typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
-                                      ValuesOutputIterator values_output,
-                                      Size size,
-                                      bool& is_result_in_output,
-                                      unsigned int begin_bit,
-                                      unsigned int end_bit,
-                                      hipStream_t stream,
-                                      bool debug_synchronous)
+hipError_t radix_sort_onesweep_impl(void * temporary_storage,
+                                    size_t& storage_size,
+                                    KeysInputIterator keys_input,
+                                    typename std::iterator_traits<KeysInputIterator>::value_type * keys_tmp,
+                                    KeysOutputIterator keys_output,
+                                    ValuesInputIterator values_input,
+                                    typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
+                                    ValuesOutputIterator values_output,
+                                    Size size,
+                                    bool& is_result_in_output,
+                                    unsigned int begin_bit,
+                                    unsigned int end_bit,
+                                    Decomposer decomposer,
+                                    hipStream_t stream,
+                                    bool debug_synchronous)
 {
     using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
     using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
     using offset_type = offset_type_t<Size>;
 
-    using config = default_or_custom_config<
-        Config,
-        default_radix_sort_config<ROCPRIM_TARGET_ARCH, key_type, value_type>
-    >;
+    using config = ArchConfig;
+
+    using scan_state_type = ::rocprim::detail::lookback_scan_state<unsigned int>;
+    using scan_state_with_sleep_type = ::rocprim::detail::lookback_scan_state<unsigned int, true>;
+    using ordered_block_id_type = ::rocprim::detail::ordered_block_id<unsigned int>;
 
     constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
 
     constexpr unsigned int max_radix_size = 1 << config::long_radix_bits;
 
-    constexpr unsigned int scan_size = config::scan::block_size * config::scan::items_per_thread;
+    constexpr unsigned int histogram_size = config::scan::block_size * config::scan::items_per_thread;
     constexpr unsigned int sort_size = config::sort::block_size * config::sort::items_per_thread;
 
-    const unsigned int blocks = static_cast<unsigned int>(::rocprim::detail::ceiling_div(size, sort_size));
-    const unsigned int blocks_per_full_batch = ::rocprim::detail::ceiling_div(blocks, scan_size);
-    const unsigned int full_batches = blocks % scan_size != 0
-        ? blocks % scan_size
-        : scan_size;
-    const unsigned int batches = (blocks_per_full_batch == 1 ? full_batches : scan_size);
+    // Every digit of a tile has its own look-back entry, so the input is split into portions
+    // to keep the look-back storage bounded and in-portion offsets 32-bit.
+    constexpr size_t max_portion_size = ::rocprim::min<size_t>(config::sort::size_limit, 1u << 28);
+    constexpr size_t portion_size = ::rocprim::max<size_t>(max_portion_size - max_portion_size % sort_size, sort_size);
+    // Blocks of the histogram kernel loop over their tiles, only totals are written to global memory.
+    constexpr unsigned int max_histogram_blocks = 1024;
+
+    const size_t portions = ::rocprim::detail::ceiling_div<size_t>(size, portion_size);
+    const unsigned int blocks_per_portion = static_cast<unsigned int>(
+        ::rocprim::detail::ceiling_div<size_t>(::rocprim::min<size_t>(size, portion_size), sort_size));
     const bool with_double_buffer = keys_tmp != nullptr;
 
     const unsigned int bits = end_bit - begin_bit;
@@ -522,14 +509,23 @@ hipError_t radix_sort_iterations_impl(void * temporary_storage,
         : 0;
     const unsigned int long_iterations = iterations - short_iterations;
 
-    const size_t batch_digit_counts_bytes =
-        ::rocprim::detail::align_size(batches * max_radix_size * sizeof(offset_type));
-    const size_t digit_counts_bytes = ::rocprim::detail::align_size(max_radix_size * sizeof(offset_type));
+    const size_t histograms_size = portions * iterations * max_radix_size;
+    const size_t histograms_bytes = ::rocprim::detail::align_size(histograms_size * sizeof(unsigned int));
+    const size_t digit_offsets_size = iterations * max_radix_size;
+    const size_t digit_offsets_bytes = ::rocprim::detail::align_size(digit_offsets_size * sizeof(offset_type));
+    const size_t portion_digit_offsets_bytes = portions > 1
+        ? ::rocprim::detail::align_size(2 * max_radix_size * sizeof(offset_type))
+        : 0;
+    // This is valid even with scan_state_with_sleep_type
+    const size_t scan_state_bytes = ::rocprim::detail::align_size(
+        scan_state_type::get_storage_size(blocks_per_portion * max_radix_size));
+    const size_t ordered_block_id_bytes = ::rocprim::detail::align_size(ordered_block_id_type::get_storage_size());
     const size_t keys_bytes = ::rocprim::detail::align_size(size * sizeof(key_type));
     const size_t values_bytes = with_values ? ::rocprim::detail::align_size(size * sizeof(value_type)) : 0;
     if(temporary_storage == nullptr)
     {
-        storage_size = batch_digit_counts_bytes + digit_counts_bytes;
+        storage_size = histograms_bytes + digit_offsets_bytes + portion_digit_offsets_bytes
+            + scan_state_bytes + ordered_block_id_bytes;
         if(!with_double_buffer)
         {
             storage_size += keys_bytes + values_bytes;
@@ -542,12 +538,11 @@ hipError_t radix_sort_iterations_impl(void * temporary_storage,
 
     if(debug_synchronous)
     {
-        std::cout << "scan_size " << scan_size << '\n';
+        std::cout << "histogram_size " << histogram_size << '\n';
         std::cout << "sort_size " << sort_size << '\n';
-        std::cout << "blocks " << blocks << '\n';
-        std::cout << "blocks_per_full_batch " << blocks_per_full_batch << '\n';
-        std::cout << "full_batches " << full_batches << '\n';
-        std::cout << "batches " << batches << '\n';
+        std::cout << "portion_size " << portion_size << '\n';
+        std::cout << "portions " << portions << '\n';
+        std::cout << "blocks_per_portion " << blocks_per_portion << '\n';
         std::cout << "iterations " << iterations << '\n';
         std::cout << "long_iterations " << long_iterations << '\n';
         std::cout << "short_iterations " << short_iterations << '\n';
@@ -555,11 +550,22 @@ hipError_t radix_sort_iterations_impl(void * temporary_storage,
         if(error != hipSuccess) return error;
     }
 
+    bool use_sleep;
+    hipError_t error = is_sleep_scan_state_used(use_sleep);
+    if(error != hipSuccess) return error;
+
     char * ptr = reinterpret_cast<char *>(temporary_storage);
-    offset_type * batch_digit_counts = reinterpret_cast<offset_type *>(ptr);
-    ptr += batch_digit_counts_bytes;
-    offset_type * digit_counts = reinterpret_cast<offset_type *>(ptr);
-    ptr += digit_counts_bytes;
+    unsigned int * histograms = reinterpret_cast<unsigned int *>(ptr);
+    ptr += histograms_bytes;
+    offset_type * digit_offsets = reinterpret_cast<offset_type *>(ptr);
+    ptr += digit_offsets_bytes;
+    offset_type * portion_digit_offsets = portions > 1 ? reinterpret_cast<offset_type *>(ptr) : nullptr;
+    ptr += portion_digit_offsets_bytes;
+    void * scan_state_storage = ptr;
+    ptr += scan_state_bytes;
+    const auto ordered_bid = ordered_block_id_type::create(
+        reinterpret_cast<ordered_block_id_type::id_type *>(ptr));
+    ptr += ordered_block_id_bytes;
     if(!with_double_buffer)
     {
         keys_tmp = reinterpret_cast<key_type *>(ptr);
@@ -567,6 +573,70 @@ hipError_t radix_sort_iterations_impl(void * temporary_storage,
         values_tmp = with_values ? reinterpret_cast<value_type *>(ptr) : nullptr;
     }
 
+    // Call the provided function with either scan_state or scan_state_with_sleep based on
+    // the value of use_sleep
+    auto with_scan_state
+        = [use_sleep,
+           scan_state            = scan_state_type::create(scan_state_storage, blocks_per_portion * max_radix_size),
+           scan_state_with_sleep = scan_state_with_sleep_type::create(
+               scan_state_storage, blocks_per_portion * max_radix_size)](auto&& func) mutable -> decltype(auto) {
+        if(use_sleep)
+        {
+            return func(scan_state_with_sleep);
+        }
+        else
+        {
+            return func(scan_state);
+        }
+    };
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    // Compute digit counts of all iterations in a single pass over the input keys
+    error = hipMemsetAsync(histograms, 0, histograms_size * sizeof(unsigned int), stream);
+    if(error != hipSuccess) return error;
+
+    for(size_t offset = 0; offset < size; offset += portion_size)
+    {
+        const unsigned int current_size = static_cast<unsigned int>(std::min<size_t>(size - offset, portion_size));
+        const unsigned int histogram_blocks = ::rocprim::min(
+            ::rocprim::detail::ceiling_div(current_size, histogram_size), max_histogram_blocks);
+
+        kernel_trace_begin(stream,
+                           dim3(histogram_blocks),
+                           dim3(config::scan::block_size),
+                           config::scan::items_per_thread,
+                           current_size * sizeof(key_type),
+                           iterations * max_radix_size * sizeof(unsigned int));
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(onesweep_histograms_kernel<Config, Descending>),
+            dim3(histogram_blocks), dim3(config::scan::block_size), 0, stream,
+            keys_input + offset,
+            histograms + (offset / portion_size) * iterations * max_radix_size,
+            current_size,
+            begin_bit, end_bit,
+            long_iterations, iterations,
+            decomposer
+        );
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("onesweep_histograms", current_size, start)
+    }
+
+    kernel_trace_begin(stream,
+                       dim3(iterations),
+                       dim3(max_radix_size),
+                       1,
+                       histograms_size * sizeof(unsigned int),
+                       digit_offsets_size * sizeof(offset_type));
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(
+        HIP_KERNEL_NAME(onesweep_scan_histograms_kernel<Config>),
+        dim3(iterations), dim3(max_radix_size), 0, stream,
+        as_const_ptr(histograms), digit_offsets,
+        static_cast<unsigned int>(portions), iterations
+    );
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("onesweep_scan_histograms", iterations * max_radix_size, start)
+
     bool to_output = with_double_buffer || (iterations - 1) % 2 == 0;
     bool from_input = true;
     if(!with_double_buffer && to_output)
@@ -576,7 +646,7 @@ hipError_t radix_sort_iterations_impl(void * temporary_storage,
         const bool values_equal = with_values && ::rocprim::detail::are_iterators_equal(values_input, values_output);
         if(keys_equal || values_equal)
         {
-            hipError_t error = ::rocprim::transform(
+            error = ::rocprim::transform(
                 keys_input, keys_tmp, size,
                 ::rocprim::identity<key_type>(), stream, debug_synchronous
             );
@@ -584,7 +654,7 @@ hipError_t radix_sort_iterations_impl(void * temporary_storage,
 
             if(with_values)
             {
-                hipError_t error = ::rocprim::transform(
+                error = ::rocprim::transform(
                     values_input, values_tmp, size,
                     ::rocprim::identity<value_type>(), stream, debug_synchronous
                 );
@@ -596,46 +666,53 @@ hipError_t radix_sort_iterations_impl(void * temporary_storage,
     }
 
     unsigned int bit = begin_bit;
-    for(unsigned int i = 0; i < long_iterations; i++)
-    {
-        hipError_t error = radix_sort_iteration<config, config::long_radix_bits, Descending>(
-            keys_input, keys_tmp, keys_output, values_input, values_tmp, values_output,
-            static_cast<offset_type>(size), batch_digit_counts, digit_counts,
-            from_input, to_output,
-            bit, end_bit,
-            blocks_per_full_batch, full_batches, batches,
-            stream, debug_synchronous
-        );
-        if(error != hipSuccess) return error;
-
-        is_result_in_output = to_output;
-        from_input = false;
-        to_output = !to_output;
-        bit += config::long_radix_bits;
-    }
-    for(unsigned int i = 0; i < short_iterations; i++)
+    for(unsigned int i = 0; i < iterations; i++)
     {
-        hipError_t error = radix_sort_iteration<config, config::short_radix_bits, Descending>(
-            keys_input, keys_tmp, keys_output, values_input, values_tmp, values_output,
-            static_cast<offset_type>(size), batch_digit_counts, digit_counts,
-            from_input, to_output,
-            bit, end_bit,
-            blocks_per_full_batch, full_batches, batches,
-            stream, debug_synchronous
-        );
+        const bool is_long_iteration = i < long_iterations;
+        error = with_scan_state(
+            [&](const auto scan_state)
+            {
+                if(is_long_iteration)
+                {
+                    return radix_sort_onesweep_iteration<Config, ArchConfig, true, Descending>(
+                        keys_input, keys_tmp, keys_output, values_input, values_tmp, values_output,
+                        size, as_const_ptr(digit_offsets + i * max_radix_size), portion_digit_offsets,
+                        scan_state, ordered_bid,
+                        from_input, to_output,
+                        bit, end_bit, decomposer,
+                        portion_size,
+                        stream, debug_synchronous
+                    );
+                }
+                else
+                {
+                    return radix_sort_onesweep_iteration<Config, ArchConfig, false, Descending>(
+                        keys_input, keys_tmp, keys_output, values_input, values_tmp, values_output,
+                        size, as_const_ptr(digit_offsets + i * max_radix_size), portion_digit_offsets,
+                        scan_state, ordered_bid,
+                        from_input, to_output,
+                        bit, end_bit, decomposer,
+                        portion_size,
+                        stream, debug_synchronous
+                    );
+                }
+            });
         if(error != hipSuccess) return error;
 
         is_result_in_output = to_output;
         from_input = false;
         to_output = !to_output;
-        bit += config::short_radix_bits;
+        bit += is_long_iteration ? config::long_radix_bits : config::short_radix_bits;
     }
 
     return hipSuccess;
 }
 
+// Inputs which do not fit into a single block are sorted by merge sort (if they are not too
+// large) or by onesweep radix sort.
 template<
     class Config,
+    class ArchConfig,
     bool Descending,
     class KeysInputIterator,
     class KeysOutputIterator,
@@ -644,49 +721,36 @@ template<
     class Size
 >
 inline
-hipError_t radix_sort_impl(void * temporary_storage,
-                           size_t& storage_size,
-                           KeysInputIterator keys_input,
-                           typename std::iterator_traits<KeysInputIterator>::value_type * keys_tmp,
-                           KeysOutputIterator keys_output,
-                           ValuesInputIterator values_input,
-                           typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
-                           ValuesOutputIterator values_output,
-                           Size size,
-                           bool& is_result_in_output,
-                           unsigned int begin_bit,
-                           unsigned int end_bit,
-                           hipStream_t stream,
-                           bool debug_synchronous)
+hipError_t radix_sort_multi_block_impl(void * temporary_storage,
+                                       size_t& storage_size,
+                                       KeysInputIterator keys_input,
+                                       typename std::iterator_traits<KeysInputIterator>::value_type * keys_tmp,
+                                       KeysOutputIterator keys_output,
+                                       ValuesInputIterator values_input,
+                                       typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
+                                       ValuesOutputIterator values_output,
+                                       Size size,
+                                       bool& is_result_in_output,
+                                       unsigned int begin_bit,
+                                       unsigned int end_bit,
+                                       identity_decomposer decomposer,
+                                       hipStream_t stream,
+                                       bool debug_synchronous)
 {
-    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
-    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+    using config = ArchConfig;
 
-    static_assert(
-        std::is_same<key_type, typename std::iterator_traits<KeysOutputIterator>::value_type>::value,
-        "KeysInputIterator and KeysOutputIterator must have the same value_type"
-    );
-    static_assert(
-        std::is_same<value_type, typename std::iterator_traits<ValuesOutputIterator>::value_type>::value,
-        "ValuesInputIterator and ValuesOutputIterator must have the same value_type"
-    );
-
-    using config = default_or_custom_config<
-        Config,
-        default_radix_sort_config<ROCPRIM_TARGET_ARCH, key_type, value_type>
-    >;
-
-    constexpr unsigned int single_sort_limit = config::sort_single::block_size * config::sort_single::items_per_thread;
     constexpr unsigned int merge_sort_limit = config::sort_merge::block_size * config::sort_merge::items_per_thread * config::merge_size_limit_blocks;
 
-    if( size <= single_sort_limit )
+    if( size <= merge_sort_limit )
     {
-        return radix_sort_single_impl<Config, Descending>(
+        return radix_sort_merge_impl<Config, ArchConfig, Descending>(
             temporary_storage,
             storage_size,
             keys_input,
+            keys_tmp,
             keys_output,
             values_input,
+            values_tmp,
             values_output,
             static_cast<unsigned int>(size),
             is_result_in_output,
@@ -696,9 +760,9 @@ hipError_t radix_sort_impl(void * temporary_storage,
             debug_synchronous
         );
     }
-    else if( size <= merge_sort_limit )
+    else
     {
-        return radix_sort_merge_impl<Config, Descending>(
+        return radix_sort_onesweep_impl<Config, ArchConfig, Descending>(
             temporary_storage,
             storage_size,
             keys_input,
@@ -707,17 +771,130 @@ hipError_t radix_sort_impl(void * temporary_storage,
             values_input,
             values_tmp,
             values_output,
+            size,
+            is_result_in_output,
+            begin_bit,
+            end_bit,
+            decomposer,
+            stream,
+            debug_synchronous
+        );
+    }
+}
+
+// Merge sort compares whole keys, so composite keys are always sorted by onesweep radix sort.
+template<
+    class Config,
+    class ArchConfig,
+    bool Descending,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class Size,
+    class Decomposer
+>
+inline
+hipError_t radix_sort_multi_block_impl(void * temporary_storage,
+                                       size_t& storage_size,
+                                       KeysInputIterator keys_input,
+                                       typename std::iterator_traits<KeysInputIterator>::value_type * keys_tmp,
+                                       KeysOutputIterator keys_output,
+                                       ValuesInputIterator values_input,
+                                       typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
+                                       ValuesOutputIterator values_output,
+                                       Size size,
+                                       bool& is_result_in_output,
+                                       unsigned int begin_bit,
+                                       unsigned int end_bit,
+                                       Decomposer decomposer,
+                                       hipStream_t stream,
+                                       bool debug_synchronous)
+{
+    return radix_sort_onesweep_impl<Config, ArchConfig, Descending>(
+        temporary_storage,
+        storage_size,
+        keys_input,
+        keys_tmp,
+        keys_output,
+        values_input,
+        values_tmp,
+        values_output,
+        size,
+        is_result_in_output,
+        begin_bit,
+        end_bit,
+        decomposer,
+        stream,
+        debug_synchronous
+    );
+}
+
+template<
+    class Config,
+    class ArchConfig,
+    bool Descending,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class Size,
+    class Decomposer
+>
+inline
+hipError_t radix_sort_arch_impl(void * temporary_storage,
+                                size_t& storage_size,
+                                KeysInputIterator keys_input,
+                                typename std::iterator_traits<KeysInputIterator>::value_type * keys_tmp,
+                                KeysOutputIterator keys_output,
+                                ValuesInputIterator values_input,
+                                typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
+                                ValuesOutputIterator values_output,
+                                Size size,
+                                bool& is_result_in_output,
+                                unsigned int begin_bit,
+                                unsigned int end_bit,
+                                Decomposer decomposer,
+                                hipStream_t stream,
+                                bool debug_synchronous)
+{
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+
+    static_assert(
+        std::is_same<key_type, typename std::iterator_traits<KeysOutputIterator>::value_type>::value,
+        "KeysInputIterator and KeysOutputIterator must have the same value_type"
+    );
+    static_assert(
+        std::is_same<value_type, typename std::iterator_traits<ValuesOutputIterator>::value_type>::value,
+        "ValuesInputIterator and ValuesOutputIterator must have the same value_type"
+    );
+
+    using config = ArchConfig;
+
+    constexpr unsigned int single_sort_limit = config::sort_single::block_size * config::sort_single::items_per_thread;
+
+    if( size <= single_sort_limit )
+    {
+        return radix_sort_single_impl<Config, ArchConfig, Descending>(
+            temporary_storage,
+            storage_size,
+            keys_input,
+            keys_output,
+            values_input,
+            values_output,
             static_cast<unsigned int>(size),
             is_result_in_output,
             begin_bit,
             end_bit,
+            decomposer,
             stream,
             debug_synchronous
         );
     }
     else
     {
-        return radix_sort_iterations_impl<Config, Descending>(
+        return radix_sort_multi_block_impl<Config, ArchConfig, Descending>(
             temporary_storage,
             storage_size,
             keys_input,
@@ -730,12 +907,248 @@ hipError_t radix_sort_impl(void * temporary_storage,
             is_result_in_output,
             begin_bit,
             end_bit,
+            decomposer,
             stream,
             debug_synchronous
         );
     }
 }
 
+// Values are small enough to be moved by the sorting passes.
+template<
+    class Config,
+    target_arch Arch,
+    bool Descending,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class Size,
+    class Decomposer
+>
+inline
+hipError_t radix_sort_indirect_impl(std::false_type /*is_indirect*/,
+                                    void * temporary_storage,
+                                    size_t& storage_size,
+                                    KeysInputIterator keys_input,
+                                    typename std::iterator_traits<KeysInputIterator>::value_type * keys_tmp,
+                                    KeysOutputIterator keys_output,
+                                    ValuesInputIterator values_input,
+                                    typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
+                                    ValuesOutputIterator values_output,
+                                    Size size,
+                                    bool& is_result_in_output,
+                                    unsigned int begin_bit,
+                                    unsigned int end_bit,
+                                    Decomposer decomposer,
+                                    hipStream_t stream,
+                                    bool debug_synchronous)
+{
+    return radix_sort_arch_impl<Config, target_arch_config_t<Config, Arch>, Descending>(
+        temporary_storage, storage_size,
+        keys_input, keys_tmp, keys_output,
+        values_input, values_tmp, values_output,
+        size, is_result_in_output,
+        begin_bit, end_bit, decomposer,
+        stream, debug_synchronous
+    );
+}
+
+// Large values are not moved by the sorting passes: keys are sorted together with 32-bit indices
+// of their values (tuned as pairs with unsigned int values), then the values are gathered once.
+// Inputs sorted by a single block, in-place sorts and inputs which can't be indexed with 32 bits
+// are sorted directly. The indices are sorted with the config of the same architecture, without
+// dispatching again.
+template<
+    class Config,
+    target_arch Arch,
+    bool Descending,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class Size,
+    class Decomposer
+>
+inline
+hipError_t radix_sort_indirect_impl(std::true_type /*is_indirect*/,
+                                    void * temporary_storage,
+                                    size_t& storage_size,
+                                    KeysInputIterator keys_input,
+                                    typename std::iterator_traits<KeysInputIterator>::value_type * keys_tmp,
+                                    KeysOutputIterator keys_output,
+                                    ValuesInputIterator values_input,
+                                    typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
+                                    ValuesOutputIterator values_output,
+                                    Size size,
+                                    bool& is_result_in_output,
+                                    unsigned int begin_bit,
+                                    unsigned int end_bit,
+                                    Decomposer decomposer,
+                                    hipStream_t stream,
+                                    bool debug_synchronous)
+{
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using index_type = unsigned int;
+
+    using arch_config = target_arch_config_t<Config, Arch>;
+    using index_config = typename Config::template with_value<index_type>;
+    using index_arch_config = target_arch_config_t<index_config, Arch>;
+
+    constexpr unsigned int single_sort_limit
+        = arch_config::sort_single::block_size * arch_config::sort_single::items_per_thread;
+
+    const bool with_double_buffer = keys_tmp != nullptr;
+    if(static_cast<size_t>(size) <= single_sort_limit
+       || static_cast<size_t>(size) > std::numeric_limits<index_type>::max()
+       || (!with_double_buffer && ::rocprim::detail::are_iterators_equal(values_input, values_output)))
+    {
+        return radix_sort_arch_impl<Config, arch_config, Descending>(
+            temporary_storage, storage_size,
+            keys_input, keys_tmp, keys_output,
+            values_input, values_tmp, values_output,
+            size, is_result_in_output,
+            begin_bit, end_bit, decomposer,
+            stream, debug_synchronous
+        );
+    }
+
+    const size_t indices_bytes = ::rocprim::detail::align_size(size * sizeof(index_type));
+    const size_t indices_tmp_bytes = with_double_buffer ? indices_bytes : 0;
+
+    index_type * indices_tmp = nullptr;
+    index_type * indices_output = nullptr;
+    size_t sort_storage_size;
+    hipError_t error = radix_sort_arch_impl<index_config, index_arch_config, Descending>(
+        nullptr, sort_storage_size,
+        keys_input, keys_tmp, keys_output,
+        ::rocprim::counting_iterator<index_type>(0), indices_tmp, indices_output,
+        size, is_result_in_output,
+        begin_bit, end_bit, decomposer,
+        stream, debug_synchronous
+    );
+    if(error != hipSuccess) return error;
+
+    if(temporary_storage == nullptr)
+    {
+        storage_size = indices_bytes + indices_tmp_bytes + sort_storage_size;
+        return hipSuccess;
+    }
+
+    char * ptr = reinterpret_cast<char *>(temporary_storage);
+    indices_output = reinterpret_cast<index_type *>(ptr);
+    ptr += indices_bytes;
+    if(with_double_buffer)
+    {
+        indices_tmp = reinterpret_cast<index_type *>(ptr);
+        ptr += indices_tmp_bytes;
+    }
+
+    error = radix_sort_arch_impl<index_config, index_arch_config, Descending>(
+        ptr, sort_storage_size,
+        keys_input, keys_tmp, keys_output,
+        ::rocprim::counting_iterator<index_type>(0), indices_tmp, indices_output,
+        size, is_result_in_output,
+        begin_bit, end_bit, decomposer,
+        stream, debug_synchronous
+    );
+    if(error != hipSuccess) return error;
+
+    // Values are gathered into the output, so keys of double buffers must end up there too
+    const index_type * indices = is_result_in_output ? indices_output : indices_tmp;
+    if(!is_result_in_output)
+    {
+        error = ::rocprim::transform(
+            keys_tmp, keys_output, size,
+            ::rocprim::identity<key_type>(), stream, debug_synchronous
+        );
+        if(error != hipSuccess) return error;
+        is_result_in_output = true;
+    }
+
+    return ::rocprim::transform(
+        indices, values_output, size,
+        indirect_gather_op<ValuesInputIterator>{values_input}, stream, debug_synchronous
+    );
+}
+
+template<
+    class Config,
+    bool Descending,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class Size,
+    class Decomposer
+>
+inline
+hipError_t radix_sort_impl(void * temporary_storage,
+                           size_t& storage_size,
+                           KeysInputIterator keys_input,
+                           typename std::iterator_traits<KeysInputIterator>::value_type * keys_tmp,
+                           KeysOutputIterator keys_output,
+                           ValuesInputIterator values_input,
+                           typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
+                           ValuesOutputIterator values_output,
+                           Size size,
+                           bool& is_result_in_output,
+                           unsigned int begin_bit,
+                           unsigned int end_bit,
+                           Decomposer decomposer,
+                           hipStream_t stream,
+                           bool debug_synchronous)
+{
+#if ROCPRIM_DETAIL_USE_HOST_NATIVE
+    return host_native_radix_sort<Descending>(temporary_storage,
+                                              storage_size,
+                                              keys_input,
+                                              keys_tmp,
+                                              keys_output,
+                                              values_input,
+                                              values_tmp,
+                                              values_output,
+                                              size,
+                                              is_result_in_output,
+                                              begin_bit,
+                                              end_bit,
+                                              decomposer,
+                                              stream,
+                                              debug_synchronous);
+#else
+
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = wrapped_radix_sort_config<Config, key_type, value_type>;
+
+    return dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            using arch_config_type = typename decltype(arch_config)::type;
+            return radix_sort_indirect_impl<config, decltype(arch_config)::arch, Descending>(
+                is_indirect_sort<arch_config_type, value_type>{},
+                temporary_storage,
+                storage_size,
+                keys_input,
+                keys_tmp,
+                keys_output,
+                values_input,
+                values_tmp,
+                values_output,
+                size,
+                is_result_in_output,
+                begin_bit,
+                end_bit,
+                decomposer,
+                stream,
+                debug_synchronous);
+        });
+#endif
+}
+
 #undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
 
 } // end namespace detail
@@ -843,6 +1256,88 @@ hipError_t radix_sort_keys(void * temporary_storage,
         values, nullptr, values,
         size, ignored,
         begin_bit, end_bit,
+        detail::identity_decomposer(),
+        stream, debug_synchronous
+    );
+}
+
+/// \overload
+/// \brief Parallel ascending radix sort of keys with composite keys for device level.
+///
+/// \p Key can be any type (for example, a struct) which can be decomposed into arithmetic fields,
+/// except \p bool, by \p decomposer. All fields are encoded in the same way as arithmetic keys,
+/// and the key is sorted as one bit string which is the concatenation of the encoded fields.
+/// \p begin_bit and \p end_bit are indices of bits of this concatenation.
+///
+/// \tparam Decomposer - type of function object which returns a ::rocprim::tuple of references
+/// to fields of a key, from the most significant to the least significant field. Its signature
+/// should be <tt>::rocprim::tuple<T1&, T2&, ...> f(Key& key) const</tt>.
+///
+/// \param [in] decomposer - function object that decomposes keys into fields.
+/// \param [in] begin_bit - [optional] index of the first (least significant) bit used in
+/// key comparison. Default value: \p 0.
+/// \param [in] end_bit - [optional] past-the-end index (most significant) bit used in
+/// key comparison. Must not exceed the total number of bits of the fields, which is the default
+/// value.
+///
+/// The remaining parameters are the same as the parameters of the overload without \p decomposer.
+///
+/// \par Example
+/// \parblock
+/// \code{.cpp}
+/// struct custom_key
+/// {
+///     int a;
+///     float b;
+/// };
+///
+/// struct custom_key_decomposer
+/// {
+///     __host__ __device__
+///     ::rocprim::tuple<int&, float&> operator()(custom_key& key) const
+///     {
+///         return ::rocprim::tuple<int&, float&>{key.a, key.b};
+///     }
+/// };
+///
+/// // keys are ordered by a, and by b if a is equal
+/// rocprim::radix_sort_keys(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size, custom_key_decomposer()
+/// );
+/// \endcode
+/// \endparblock
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class Size,
+    class Key = typename std::iterator_traits<KeysInputIterator>::value_type,
+    class Decomposer,
+    class = typename std::enable_if<!std::is_integral<Decomposer>::value>::type
+>
+inline
+hipError_t radix_sort_keys(void * temporary_storage,
+                           size_t& storage_size,
+                           KeysInputIterator keys_input,
+                           KeysOutputIterator keys_output,
+                           Size size,
+                           Decomposer decomposer,
+                           unsigned int begin_bit = 0,
+                           unsigned int end_bit = detail::radix_key_bits<Key, Decomposer>::value,
+                           hipStream_t stream = 0,
+                           bool debug_synchronous = false)
+{
+    static_assert(std::is_integral<Size>::value, "Size must be an integral type.");
+    empty_type * values = nullptr;
+    bool ignored;
+    return detail::radix_sort_impl<Config, false>(
+        temporary_storage, storage_size,
+        keys_input, nullptr, keys_output,
+        values, nullptr, values,
+        size, ignored,
+        begin_bit, end_bit,
+        decomposer,
         stream, debug_synchronous
     );
 }
@@ -904,31 +1399,81 @@ hipError_t radix_sort_keys(void * temporary_storage,
 /// int * input;          // e.g., [6, 3, 5, 4, 2, 8, 1, 7]
 /// int * output;         // empty array of 8 elements
 ///
-/// size_t temporary_storage_size_bytes;
-/// void * temporary_storage_ptr = nullptr;
-/// // Get required size of the temporary storage
-/// rocprim::radix_sort_keys_desc(
-///     temporary_storage_ptr, temporary_storage_size_bytes,
-///     input, output, input_size
-/// );
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::radix_sort_keys_desc(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // perform sort
+/// rocprim::radix_sort_keys_desc(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size
+/// );
+/// // keys_output: [8, 7, 6, 5, 4, 3, 2, 1]
+/// \endcode
+/// \endparblock
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class Size,
+    class Key = typename std::iterator_traits<KeysInputIterator>::value_type
+>
+inline
+hipError_t radix_sort_keys_desc(void * temporary_storage,
+                                size_t& storage_size,
+                                KeysInputIterator keys_input,
+                                KeysOutputIterator keys_output,
+                                Size size,
+                                unsigned int begin_bit = 0,
+                                unsigned int end_bit = 8 * sizeof(Key),
+                                hipStream_t stream = 0,
+                                bool debug_synchronous = false)
+{
+    static_assert(std::is_integral<Size>::value, "Size must be an integral type.");
+    empty_type * values = nullptr;
+    bool ignored;
+    return detail::radix_sort_impl<Config, true>(
+        temporary_storage, storage_size,
+        keys_input, nullptr, keys_output,
+        values, nullptr, values,
+        size, ignored,
+        begin_bit, end_bit,
+        detail::identity_decomposer(),
+        stream, debug_synchronous
+    );
+}
+
+/// \overload
+/// \brief Parallel descending radix sort of keys with composite keys for device level.
+///
+/// \p Key can be any type (for example, a struct) which can be decomposed into arithmetic fields,
+/// except \p bool, by \p decomposer. See the overload of \p radix_sort_keys with a decomposer
+/// for details.
 ///
-/// // allocate temporary storage
-/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+/// \tparam Decomposer - type of function object which returns a ::rocprim::tuple of references
+/// to fields of a key, from the most significant to the least significant field.
 ///
-/// // perform sort
-/// rocprim::radix_sort_keys_desc(
-///     temporary_storage_ptr, temporary_storage_size_bytes,
-///     input, output, input_size
-/// );
-/// // keys_output: [8, 7, 6, 5, 4, 3, 2, 1]
-/// \endcode
-/// \endparblock
+/// \param [in] decomposer - function object that decomposes keys into fields.
+/// \param [in] begin_bit - [optional] index of the first (least significant) bit used in
+/// key comparison. Default value: \p 0.
+/// \param [in] end_bit - [optional] past-the-end index (most significant) bit used in
+/// key comparison. Must not exceed the total number of bits of the fields, which is the default
+/// value.
 template<
     class Config = default_config,
     class KeysInputIterator,
     class KeysOutputIterator,
     class Size,
-    class Key = typename std::iterator_traits<KeysInputIterator>::value_type
+    class Key = typename std::iterator_traits<KeysInputIterator>::value_type,
+    class Decomposer,
+    class = typename std::enable_if<!std::is_integral<Decomposer>::value>::type
 >
 inline
 hipError_t radix_sort_keys_desc(void * temporary_storage,
@@ -936,8 +1481,9 @@ hipError_t radix_sort_keys_desc(void * temporary_storage,
                                 KeysInputIterator keys_input,
                                 KeysOutputIterator keys_output,
                                 Size size,
+                                Decomposer decomposer,
                                 unsigned int begin_bit = 0,
-                                unsigned int end_bit = 8 * sizeof(Key),
+                                unsigned int end_bit = detail::radix_key_bits<Key, Decomposer>::value,
                                 hipStream_t stream = 0,
                                 bool debug_synchronous = false)
 {
@@ -950,6 +1496,7 @@ hipError_t radix_sort_keys_desc(void * temporary_storage,
         values, nullptr, values,
         size, ignored,
         begin_bit, end_bit,
+        decomposer,
         stream, debug_synchronous
     );
 }
@@ -1076,6 +1623,61 @@ hipError_t radix_sort_pairs(void * temporary_storage,
         values_input, nullptr, values_output,
         size, ignored,
         begin_bit, end_bit,
+        detail::identity_decomposer(),
+        stream, debug_synchronous
+    );
+}
+
+/// \overload
+/// \brief Parallel ascending radix sort of key-value pairs with composite keys for device level.
+///
+/// \p Key can be any type (for example, a struct) which can be decomposed into arithmetic fields,
+/// except \p bool, by \p decomposer. See the overload of \p radix_sort_keys with a decomposer
+/// for details.
+///
+/// \tparam Decomposer - type of function object which returns a ::rocprim::tuple of references
+/// to fields of a key, from the most significant to the least significant field.
+///
+/// \param [in] decomposer - function object that decomposes keys into fields.
+/// \param [in] begin_bit - [optional] index of the first (least significant) bit used in
+/// key comparison. Default value: \p 0.
+/// \param [in] end_bit - [optional] past-the-end index (most significant) bit used in
+/// key comparison. Must not exceed the total number of bits of the fields, which is the default
+/// value.
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class Size,
+    class Key = typename std::iterator_traits<KeysInputIterator>::value_type,
+    class Decomposer,
+    class = typename std::enable_if<!std::is_integral<Decomposer>::value>::type
+>
+inline
+hipError_t radix_sort_pairs(void * temporary_storage,
+                            size_t& storage_size,
+                            KeysInputIterator keys_input,
+                            KeysOutputIterator keys_output,
+                            ValuesInputIterator values_input,
+                            ValuesOutputIterator values_output,
+                            Size size,
+                            Decomposer decomposer,
+                            unsigned int begin_bit = 0,
+                            unsigned int end_bit = detail::radix_key_bits<Key, Decomposer>::value,
+                            hipStream_t stream = 0,
+                            bool debug_synchronous = false)
+{
+    static_assert(std::is_integral<Size>::value, "Size must be an integral type.");
+    bool ignored;
+    return detail::radix_sort_impl<Config, false>(
+        temporary_storage, storage_size,
+        keys_input, nullptr, keys_output,
+        values_input, nullptr, values_output,
+        size, ignored,
+        begin_bit, end_bit,
+        decomposer,
         stream, debug_synchronous
     );
 }
@@ -1198,6 +1800,61 @@ hipError_t radix_sort_pairs_desc(void * temporary_storage,
         values_input, nullptr, values_output,
         size, ignored,
         begin_bit, end_bit,
+        detail::identity_decomposer(),
+        stream, debug_synchronous
+    );
+}
+
+/// \overload
+/// \brief Parallel descending radix sort of key-value pairs with composite keys for device level.
+///
+/// \p Key can be any type (for example, a struct) which can be decomposed into arithmetic fields,
+/// except \p bool, by \p decomposer. See the overload of \p radix_sort_keys with a decomposer
+/// for details.
+///
+/// \tparam Decomposer - type of function object which returns a ::rocprim::tuple of references
+/// to fields of a key, from the most significant to the least significant field.
+///
+/// \param [in] decomposer - function object that decomposes keys into fields.
+/// \param [in] begin_bit - [optional] index of the first (least significant) bit used in
+/// key comparison. Default value: \p 0.
+/// \param [in] end_bit - [optional] past-the-end index (most significant) bit used in
+/// key comparison. Must not exceed the total number of bits of the fields, which is the default
+/// value.
+template<
+    class Config = default_config,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class Size,
+    class Key = typename std::iterator_traits<KeysInputIterator>::value_type,
+    class Decomposer,
+    class = typename std::enable_if<!std::is_integral<Decomposer>::value>::type
+>
+inline
+hipError_t radix_sort_pairs_desc(void * temporary_storage,
+                                 size_t& storage_size,
+                                 KeysInputIterator keys_input,
+                                 KeysOutputIterator keys_output,
+                                 ValuesInputIterator values_input,
+                                 ValuesOutputIterator values_output,
+                                 Size size,
+                                 Decomposer decomposer,
+                                 unsigned int begin_bit = 0,
+                                 unsigned int end_bit = detail::radix_key_bits<Key, Decomposer>::value,
+                                 hipStream_t stream = 0,
+                                 bool debug_synchronous = false)
+{
+    static_assert(std::is_integral<Size>::value, "Size must be an integral type.");
+    bool ignored;
+    return detail::radix_sort_impl<Config, true>(
+        temporary_storage, storage_size,
+        keys_input, nullptr, keys_output,
+        values_input, nullptr, values_output,
+        size, ignored,
+        begin_bit, end_bit,
+        decomposer,
         stream, debug_synchronous
     );
 }
@@ -1306,6 +1963,60 @@ hipError_t radix_sort_keys(void * temporary_storage,
         values, values, values,
         size, is_result_in_output,
         begin_bit, end_bit,
+        detail::identity_decomposer(),
+        stream, debug_synchronous
+    );
+    if(temporary_storage != nullptr && is_result_in_output)
+    {
+        keys.swap();
+    }
+    return error;
+}
+
+/// \overload
+/// \brief Parallel ascending radix sort of keys with composite keys for device level.
+///
+/// \p Key can be any type (for example, a struct) which can be decomposed into arithmetic fields,
+/// except \p bool, by \p decomposer. See the overload of \p radix_sort_keys with a decomposer
+/// for details.
+///
+/// \tparam Decomposer - type of function object which returns a ::rocprim::tuple of references
+/// to fields of a key, from the most significant to the least significant field.
+///
+/// \param [in] decomposer - function object that decomposes keys into fields.
+/// \param [in] begin_bit - [optional] index of the first (least significant) bit used in
+/// key comparison. Default value: \p 0.
+/// \param [in] end_bit - [optional] past-the-end index (most significant) bit used in
+/// key comparison. Must not exceed the total number of bits of the fields, which is the default
+/// value.
+template<
+    class Config = default_config,
+    class Key,
+    class Size,
+    class Decomposer,
+    class = typename std::enable_if<!std::is_integral<Decomposer>::value>::type
+>
+inline
+hipError_t radix_sort_keys(void * temporary_storage,
+                           size_t& storage_size,
+                           double_buffer<Key>& keys,
+                           Size size,
+                           Decomposer decomposer,
+                           unsigned int begin_bit = 0,
+                           unsigned int end_bit = detail::radix_key_bits<Key, Decomposer>::value,
+                           hipStream_t stream = 0,
+                           bool debug_synchronous = false)
+{
+    static_assert(std::is_integral<Size>::value, "Size must be an integral type.");
+    empty_type * values = nullptr;
+    bool is_result_in_output;
+    hipError_t error = detail::radix_sort_impl<Config, false>(
+        temporary_storage, storage_size,
+        keys.current(), keys.current(), keys.alternate(),
+        values, values, values,
+        size, is_result_in_output,
+        begin_bit, end_bit,
+        decomposer,
         stream, debug_synchronous
     );
     if(temporary_storage != nullptr && is_result_in_output)
@@ -1419,6 +2130,60 @@ hipError_t radix_sort_keys_desc(void * temporary_storage,
         values, values, values,
         size, is_result_in_output,
         begin_bit, end_bit,
+        detail::identity_decomposer(),
+        stream, debug_synchronous
+    );
+    if(temporary_storage != nullptr && is_result_in_output)
+    {
+        keys.swap();
+    }
+    return error;
+}
+
+/// \overload
+/// \brief Parallel descending radix sort of keys with composite keys for device level.
+///
+/// \p Key can be any type (for example, a struct) which can be decomposed into arithmetic fields,
+/// except \p bool, by \p decomposer. See the overload of \p radix_sort_keys with a decomposer
+/// for details.
+///
+/// \tparam Decomposer - type of function object which returns a ::rocprim::tuple of references
+/// to fields of a key, from the most significant to the least significant field.
+///
+/// \param [in] decomposer - function object that decomposes keys into fields.
+/// \param [in] begin_bit - [optional] index of the first (least significant) bit used in
+/// key comparison. Default value: \p 0.
+/// \param [in] end_bit - [optional] past-the-end index (most significant) bit used in
+/// key comparison. Must not exceed the total number of bits of the fields, which is the default
+/// value.
+template<
+    class Config = default_config,
+    class Key,
+    class Size,
+    class Decomposer,
+    class = typename std::enable_if<!std::is_integral<Decomposer>::value>::type
+>
+inline
+hipError_t radix_sort_keys_desc(void * temporary_storage,
+                                size_t& storage_size,
+                                double_buffer<Key>& keys,
+                                Size size,
+                                Decomposer decomposer,
+                                unsigned int begin_bit = 0,
+                                unsigned int end_bit = detail::radix_key_bits<Key, Decomposer>::value,
+                                hipStream_t stream = 0,
+                                bool debug_synchronous = false)
+{
+    static_assert(std::is_integral<Size>::value, "Size must be an integral type.");
+    empty_type * values = nullptr;
+    bool is_result_in_output;
+    hipError_t error = detail::radix_sort_impl<Config, true>(
+        temporary_storage, storage_size,
+        keys.current(), keys.current(), keys.alternate(),
+        values, values, values,
+        size, is_result_in_output,
+        begin_bit, end_bit,
+        decomposer,
         stream, debug_synchronous
     );
     if(temporary_storage != nullptr && is_result_in_output)
@@ -1546,6 +2311,62 @@ hipError_t radix_sort_pairs(void * temporary_storage,
         values.current(), values.current(), values.alternate(),
         size, is_result_in_output,
         begin_bit, end_bit,
+        detail::identity_decomposer(),
+        stream, debug_synchronous
+    );
+    if(temporary_storage != nullptr && is_result_in_output)
+    {
+        keys.swap();
+        values.swap();
+    }
+    return error;
+}
+
+/// \overload
+/// \brief Parallel ascending radix sort of key-value pairs with composite keys for device level.
+///
+/// \p Key can be any type (for example, a struct) which can be decomposed into arithmetic fields,
+/// except \p bool, by \p decomposer. See the overload of \p radix_sort_keys with a decomposer
+/// for details.
+///
+/// \tparam Decomposer - type of function object which returns a ::rocprim::tuple of references
+/// to fields of a key, from the most significant to the least significant field.
+///
+/// \param [in] decomposer - function object that decomposes keys into fields.
+/// \param [in] begin_bit - [optional] index of the first (least significant) bit used in
+/// key comparison. Default value: \p 0.
+/// \param [in] end_bit - [optional] past-the-end index (most significant) bit used in
+/// key comparison. Must not exceed the total number of bits of the fields, which is the default
+/// value.
+template<
+    class Config = default_config,
+    class Key,
+    class Value,
+    class Size,
+    class Decomposer,
+    class = typename std::enable_if<!std::is_integral<Decomposer>::value>::type
+>
+inline
+hipError_t radix_sort_pairs(void * temporary_storage,
+                            size_t& storage_size,
+                            double_buffer<Key>& keys,
+                            double_buffer<Value>& values,
+                            Size size,
+                            Decomposer decomposer,
+                            unsigned int begin_bit = 0,
+                            unsigned int end_bit = detail::radix_key_bits<Key, Decomposer>::value,
+                            hipStream_t stream = 0,
+                            bool debug_synchronous = false)
+{
+    static_assert(std::is_integral<Size>::value, "Size must be an integral type.");
+    bool is_result_in_output;
+    hipError_t error = detail::radix_sort_impl<Config, false>(
+        temporary_storage, storage_size,
+        keys.current(), keys.current(), keys.alternate(),
+        values.current(), values.current(), values.alternate(),
+        size, is_result_in_output,
+        begin_bit, end_bit,
+        decomposer,
         stream, debug_synchronous
     );
     if(temporary_storage != nullptr && is_result_in_output)
@@ -1668,6 +2489,62 @@ hipError_t radix_sort_pairs_desc(void * temporary_storage,
         values.current(), values.current(), values.alternate(),
         size, is_result_in_output,
         begin_bit, end_bit,
+        detail::identity_decomposer(),
+        stream, debug_synchronous
+    );
+    if(temporary_storage != nullptr && is_result_in_output)
+    {
+        keys.swap();
+        values.swap();
+    }
+    return error;
+}
+
+/// \overload
+/// \brief Parallel descending radix sort of key-value pairs with composite keys for device level.
+///
+/// \p Key can be any type (for example, a struct) which can be decomposed into arithmetic fields,
+/// except \p bool, by \p decomposer. See the overload of \p radix_sort_keys with a decomposer
+/// for details.
+///
+/// \tparam Decomposer - type of function object which returns a ::rocprim::tuple of references
+/// to fields of a key, from the most significant to the least significant field.
+///
+/// \param [in] decomposer - function object that decomposes keys into fields.
+/// \param [in] begin_bit - [optional] index of the first (least significant) bit used in
+/// key comparison. Default value: \p 0.
+/// \param [in] end_bit - [optional] past-the-end index (most significant) bit used in
+/// key comparison. Must not exceed the total number of bits of the fields, which is the default
+/// value.
+template<
+    class Config = default_config,
+    class Key,
+    class Value,
+    class Size,
+    class Decomposer,
+    class = typename std::enable_if<!std::is_integral<Decomposer>::value>::type
+>
+inline
+hipError_t radix_sort_pairs_desc(void * temporary_storage,
+                                 size_t& storage_size,
+                                 double_buffer<Key>& keys,
+                                 double_buffer<Value>& values,
+                                 Size size,
+                                 Decomposer decomposer,
+                                 unsigned int begin_bit = 0,
+                                 unsigned int end_bit = detail::radix_key_bits<Key, Decomposer>::value,
+                                 hipStream_t stream = 0,
+                                 bool debug_synchronous = false)
+{
+    static_assert(std::is_integral<Size>::value, "Size must be an integral type.");
+    bool is_result_in_output;
+    hipError_t error = detail::radix_sort_impl<Config, true>(
+        temporary_storage, storage_size,
+        keys.current(), keys.current(), keys.alternate(),
+        values.current(), values.current(), values.alternate(),
+        size, is_result_in_output,
+        begin_bit, end_bit,
+        decomposer,
         stream, debug_synchronous
     );
     if(temporary_storage != nullptr && is_result_in_output)
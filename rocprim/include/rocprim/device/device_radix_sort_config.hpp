@@ -38,6 +38,20 @@ BEGIN_ROCPRIM_NAMESPACE
 namespace detail
 {
 
+// Keys-only configuration for keys of other sizes (e.g. composite keys sorted with a decomposer)
+template<class Key>
+struct radix_sort_keys_fallback_config
+{
+    static constexpr unsigned int item_scale =
+        ::rocprim::detail::ceiling_div<unsigned int>(sizeof(Key), sizeof(int));
+
+    using type = radix_sort_config<
+        6, 4, kernel_config<256, 2>,
+        kernel_config<256, ::rocprim::max(1u, 10u / item_scale)>,
+        kernel_config<256, ::rocprim::max(1u, 15u / item_scale)>
+    >;
+};
+
 template<class Key, class Value>
 struct radix_sort_config_803
 {
@@ -99,7 +113,8 @@ struct radix_sort_config_803<Key, empty_type>
         select_type_case<sizeof(Key) == 1, radix_sort_config<8, 7, kernel_config<256, 2>, kernel_config<256, 10>, kernel_config<256, 19> > >,
         select_type_case<sizeof(Key) == 2, radix_sort_config<8, 7, kernel_config<256, 2>, kernel_config<256, 10>, kernel_config<256, 16> > >,
         select_type_case<sizeof(Key) == 4, radix_sort_config<7, 6, kernel_config<256, 2>, kernel_config<256, 9>, kernel_config<256, 15> > >,
-        select_type_case<sizeof(Key) == 8, radix_sort_config<7, 6, kernel_config<256, 2>, kernel_config<256, 7>, kernel_config<256, 12> > >
+        select_type_case<sizeof(Key) == 8, radix_sort_config<7, 6, kernel_config<256, 2>, kernel_config<256, 7>, kernel_config<256, 12> > >,
+        typename radix_sort_keys_fallback_config<Key>::type
     > { };
 
 template<class Key, class Value>
@@ -155,7 +170,8 @@ struct radix_sort_config_900<Key, empty_type>
         select_type_case<sizeof(Key) == 1, radix_sort_config<4, 3, kernel_config<256, 2>, kernel_config<256, 10>, kernel_config<256, 19> > >,
         select_type_case<sizeof(Key) == 2, radix_sort_config<6, 5, kernel_config<256, 2>, kernel_config<256, 10>, kernel_config<256, 16> > >,
         select_type_case<sizeof(Key) == 4, radix_sort_config<7, 6, kernel_config<256, 2>, kernel_config<256, 17>, kernel_config<256, 15> > >,
-        select_type_case<sizeof(Key) == 8, radix_sort_config<7, 6, kernel_config<256, 2>, kernel_config<256, 15>, kernel_config<256, 12> > >
+        select_type_case<sizeof(Key) == 8, radix_sort_config<7, 6, kernel_config<256, 2>, kernel_config<256, 15>, kernel_config<256, 12> > >,
+        typename radix_sort_keys_fallback_config<Key>::type
     > { };
 
 
@@ -212,7 +228,8 @@ struct radix_sort_config_908<Key, empty_type>
         select_type_case<sizeof(Key) == 1, radix_sort_config<4, 3, kernel_config<256, 2>, kernel_config<256, 10>, kernel_config<256, 19> > >,
         select_type_case<sizeof(Key) == 2, radix_sort_config<6, 5, kernel_config<256, 2>, kernel_config<256, 10>, kernel_config<256, 17> > >,
         select_type_case<sizeof(Key) == 4, radix_sort_config<7, 6, kernel_config<256, 4>, kernel_config<256, 17>, kernel_config<256, 15> > >,
-        select_type_case<sizeof(Key) == 8, radix_sort_config<7, 6, kernel_config<256, 4>, kernel_config<256, 15>, kernel_config<256, 12> > >
+        select_type_case<sizeof(Key) == 8, radix_sort_config<7, 6, kernel_config<256, 4>, kernel_config<256, 15>, kernel_config<256, 12> > >,
+        typename radix_sort_keys_fallback_config<Key>::type
     > { };
 
 // TODO: We need to update these parameters
@@ -265,7 +282,8 @@ struct radix_sort_config_90a<Key, empty_type>
         select_type_case<sizeof(Key) == 1, radix_sort_config<4, 3, kernel_config<256, 1>, kernel_config<256, 5>, kernel_config<256, 19> > >,
         select_type_case<sizeof(Key) == 2, radix_sort_config<6, 5, kernel_config<256, 1>, kernel_config<256, 5>, kernel_config<256, 17> > >,
         select_type_case<sizeof(Key) == 4, radix_sort_config<7, 6, kernel_config<256, 1>, kernel_config<256, 8>, kernel_config<256, 15> > >,
-        select_type_case<sizeof(Key) == 8, radix_sort_config<7, 6, kernel_config<256, 1>, kernel_config<256, 7>, kernel_config<256, 14> > >
+        select_type_case<sizeof(Key) == 8, radix_sort_config<7, 6, kernel_config<256, 1>, kernel_config<256, 7>, kernel_config<256, 14> > >,
+        typename radix_sort_keys_fallback_config<Key>::type
     > { };
 
 // TODO: We need to update these parameters
@@ -322,7 +340,8 @@ struct radix_sort_config_1030<Key, empty_type>
         select_type_case<sizeof(Key) == 1, radix_sort_config<4, 3, kernel_config<256, 2>, kernel_config<256, 10>, kernel_config<256, 19> > >,
         select_type_case<sizeof(Key) == 2, radix_sort_config<6, 5, kernel_config<256, 2>, kernel_config<256, 10>, kernel_config<256, 19> > >,
         select_type_case<sizeof(Key) == 4, radix_sort_config<7, 6, kernel_config<256, 2>, kernel_config<256, 17>, kernel_config<256, 17> > >,
-        select_type_case<sizeof(Key) == 8, radix_sort_config<7, 6, kernel_config<256, 2>, kernel_config<256, 15>, kernel_config<256, 15> > >
+        select_type_case<sizeof(Key) == 8, radix_sort_config<7, 6, kernel_config<256, 2>, kernel_config<256, 15>, kernel_config<256, 15> > >,
+        typename radix_sort_keys_fallback_config<Key>::type
     > { };
 
 template<unsigned int TargetArch, class Key, class Value>
@@ -337,6 +356,22 @@ struct default_radix_sort_config
         radix_sort_config_900<Key, Value>
     > { };
 
+// Config of radix_sort_keys and radix_sort_pairs per target architecture.
+template<class Config, class Key, class Value>
+struct wrapped_radix_sort_config
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        using type
+            = arch_config_t<Config, default_radix_sort_config<static_cast<unsigned int>(Arch), Key, Value>>;
+    };
+
+    // The wrapped config of the same Config for sorting with values of type OtherValue
+    template<class OtherValue>
+    using with_value = wrapped_radix_sort_config<Config, Key, OtherValue>;
+};
+
 } // end namespace detail
 
 END_ROCPRIM_NAMESPACE
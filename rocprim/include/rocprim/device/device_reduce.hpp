@@ -33,8 +33,10 @@
 #include "../detail/match_result_type.hpp"
 
 #include "detail/device_config_helper.hpp"
+#include "detail/device_host_native.hpp"
 #include "detail/device_reduce.hpp"
 #include "device_reduce_config.hpp"
+#include "device_trace.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -78,6 +80,7 @@ ROCPRIM_KERNEL __launch_bounds__(device_params<Config>().block_size) void block_
     { \
         auto _error = hipGetLastError(); \
         if(_error != hipSuccess) return _error; \
+        ::rocprim::detail::kernel_trace_end(name, size, stream); \
         if(debug_synchronous) \
         { \
             std::cout << name << "(" << size << ")"; \
@@ -109,6 +112,17 @@ hipError_t reduce_impl(void * temporary_storage,
                        const hipStream_t stream,
                        bool debug_synchronous)
 {
+#if ROCPRIM_DETAIL_USE_HOST_NATIVE
+    return host_native_reduce<WithInitialValue>(temporary_storage,
+                                                storage_size,
+                                                input,
+                                                output,
+                                                initial_value,
+                                                size,
+                                                reduce_op,
+                                                stream,
+                                                debug_synchronous);
+#else
     using input_type = typename std::iterator_traits<InputIterator>::value_type;
     using result_type = typename ::rocprim::detail::match_result_type<
         input_type, BinaryFunction
@@ -163,6 +177,12 @@ hipError_t reduce_impl(void * temporary_storage,
             const auto current_size = std::min<size_t>(size - offset, aligned_size_limit);
             const auto current_blocks = (current_size + items_per_block - 1) / items_per_block;
 
+            kernel_trace_begin(stream,
+                               dim3(current_blocks),
+                               dim3(block_size),
+                               items_per_thread,
+                               current_size * kernel_trace_item_bytes<InputIterator>(),
+                               current_blocks * sizeof(result_type));
             if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
             hipLaunchKernelGGL(
                 HIP_KERNEL_NAME(detail::block_reduce_kernel<false, config, result_type>),
@@ -196,6 +216,12 @@ hipError_t reduce_impl(void * temporary_storage,
     }
     else
     {
+        kernel_trace_begin(stream,
+                           dim3(1),
+                           dim3(block_size),
+                           items_per_thread,
+                           size * kernel_trace_item_bytes<InputIterator>(),
+                           sizeof(result_type));
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
         hipLaunchKernelGGL(
             HIP_KERNEL_NAME(detail::block_reduce_kernel<WithInitialValue, config, result_type>),
@@ -206,6 +232,7 @@ hipError_t reduce_impl(void * temporary_storage,
     }
 
     return hipSuccess;
+#endif
 }
 
 #undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
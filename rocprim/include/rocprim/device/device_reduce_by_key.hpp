@@ -34,10 +34,12 @@
 #include "../detail/various.hpp"
 #include "../functional.hpp"
 #include "../iterator/constant_iterator.hpp"
+#include "device_trace.hpp"
 
 #include <chrono>
 #include <iostream>
 #include <iterator>
+#include <limits>
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -50,50 +52,23 @@ namespace detail
 namespace reduce_by_key
 {
 
-template<typename LookBackScanState, typename AccumulatorType>
+template<typename LookBackScanState>
 ROCPRIM_KERNEL __launch_bounds__(ROCPRIM_DEFAULT_MAX_BLOCK_SIZE) void init_kernel(
-    LookBackScanState              lookback_scan_state,
-    const unsigned int             number_of_tiles,
-    ordered_block_id<unsigned int> ordered_bid,
-    const bool                     is_first_launch,
-    const unsigned int             tile_save_idx,
-    std::size_t* const             global_head_count,
-    AccumulatorType* const         previous_accumulated)
+    LookBackScanState                       lookback_scan_state,
+    const std::size_t                       number_of_tiles,
+    ordered_block_id<lookback_tile_id_type> ordered_bid)
 {
-    const unsigned int block_id        = ::rocprim::detail::block_id<0>();
+    const std::size_t  block_id        = ::rocprim::detail::block_id<0>();
     const unsigned int block_size      = ::rocprim::detail::block_size<0>();
     const unsigned int block_thread_id = ::rocprim::detail::block_thread_id<0>();
-    const unsigned int flat_thread_id  = (block_id * block_size) + block_thread_id;
-
-    if(is_first_launch)
-    {
-        if(global_head_count != nullptr && flat_thread_id == 0)
-        {
-            // If there are subsequent launches, initialize the accumulated head flags
-            // over previous launches to zero.
-            *global_head_count = 0;
-        }
-    }
-    else
-    {
-        // Use the reduction of the last launch to update the across-launch variables.
-        const auto update_func = [&](typename LookBackScanState::value_type value)
-        {
-            *global_head_count += ::rocprim::get<0>(value);
-            *previous_accumulated = ::rocprim::get<1>(value);
-        };
-        access_indexed_lookback_value(lookback_scan_state,
-                                      number_of_tiles,
-                                      tile_save_idx,
-                                      flat_thread_id,
-                                      update_func);
-    }
+    const std::size_t  flat_thread_id  = (block_id * block_size) + block_thread_id;
 
     init_lookback_scan_state(lookback_scan_state, number_of_tiles, ordered_bid, flat_thread_id);
 }
 
 template<typename Config,
          typename AccumulatorType,
+         typename OffsetType,
          typename KeyIterator,
          typename ValueIterator,
          typename UniqueIterator,
@@ -102,38 +77,31 @@ template<typename Config,
          typename CompareFunction,
          typename BinaryOp,
          typename LookbackScanState>
-ROCPRIM_KERNEL __launch_bounds__(Config::block_size) void kernel(
-    const KeyIterator                    keys_input,
-    const ValueIterator                  values_input,
-    const UniqueIterator                 unique_keys,
-    const ReductionIterator              reductions,
-    const UniqueCountIterator            unique_count,
-    const BinaryOp                       reduce_op,
-    const CompareFunction                compare,
-    const LookbackScanState              scan_state,
-    const ordered_block_id<unsigned int> ordered_tile_id,
-    const std::size_t                    starting_tile,
-    const std::size_t                    total_number_of_tiles,
-    const std::size_t                    size,
-    const std::size_t* const             global_head_count,
-    const AccumulatorType* const         previous_accumulated,
-    const std::size_t                    number_of_tiles_launch)
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::block_size) void kernel(
+    const KeyIterator                             keys_input,
+    const ValueIterator                           values_input,
+    const UniqueIterator                          unique_keys,
+    const ReductionIterator                       reductions,
+    const UniqueCountIterator                     unique_count,
+    const BinaryOp                                reduce_op,
+    const CompareFunction                         compare,
+    const LookbackScanState                       scan_state,
+    const ordered_block_id<lookback_tile_id_type> ordered_tile_id,
+    const std::size_t                             number_of_tiles,
+    const std::size_t                             size)
 {
-    reduce_by_key::kernel_impl<Config>(keys_input,
-                                       values_input,
-                                       unique_keys,
-                                       reductions,
-                                       unique_count,
-                                       reduce_op,
-                                       compare,
-                                       scan_state,
-                                       ordered_tile_id,
-                                       starting_tile,
-                                       total_number_of_tiles,
-                                       size,
-                                       global_head_count,
-                                       previous_accumulated,
-                                       number_of_tiles_launch);
+    reduce_by_key::kernel_impl<device_target_arch_config_t<Config>, AccumulatorType, OffsetType>(
+        keys_input,
+        values_input,
+        unique_keys,
+        reductions,
+        unique_count,
+        reduce_op,
+        compare,
+        scan_state,
+        ordered_tile_id,
+        number_of_tiles,
+        size);
 }
 
 #define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start)                           \
@@ -142,6 +110,7 @@ ROCPRIM_KERNEL __launch_bounds__(Config::block_size) void kernel(
         auto _error = hipGetLastError();                                                         \
         if(_error != hipSuccess)                                                                 \
             return _error;                                                                       \
+        ::rocprim::detail::kernel_trace_end(name, size, stream);                                 \
         if(debug_synchronous)                                                                    \
         {                                                                                        \
             std::cout << name << "(" << size << ")";                                             \
@@ -156,6 +125,8 @@ ROCPRIM_KERNEL __launch_bounds__(Config::block_size) void kernel(
     while(false)
 
 template<class Config,
+         class ArchConfig,
+         class OffsetType,
          class KeysInputIterator,
          class ValuesInputIterator,
          class UniqueOutputIterator,
@@ -163,77 +134,64 @@ template<class Config,
          class UniqueCountOutputIterator,
          class BinaryFunction,
          class KeyCompareFunction>
-hipError_t reduce_by_key_impl(void*                     temporary_storage,
-                              size_t&                   storage_size,
-                              KeysInputIterator         keys_input,
-                              ValuesInputIterator       values_input,
-                              const size_t              size,
-                              UniqueOutputIterator      unique_output,
-                              AggregatesOutputIterator  aggregates_output,
-                              UniqueCountOutputIterator unique_count_output,
-                              BinaryFunction            reduce_op,
-                              KeyCompareFunction        key_compare_op,
-                              const hipStream_t         stream,
-                              const bool                debug_synchronous)
+hipError_t reduce_by_key_arch_impl(void*                     temporary_storage,
+                                   size_t&                   storage_size,
+                                   KeysInputIterator         keys_input,
+                                   ValuesInputIterator       values_input,
+                                   const size_t              size,
+                                   UniqueOutputIterator      unique_output,
+                                   AggregatesOutputIterator  aggregates_output,
+                                   UniqueCountOutputIterator unique_count_output,
+                                   BinaryFunction            reduce_op,
+                                   KeyCompareFunction        key_compare_op,
+                                   const hipStream_t         stream,
+                                   const bool                debug_synchronous)
 {
-    using key_type         = reduce_by_key::value_type_t<KeysInputIterator>;
     using accumulator_type = reduce_by_key::accumulator_type_t<ValuesInputIterator, BinaryFunction>;
 
-    using config = detail::default_or_custom_config<
-        Config,
-        reduce_by_key::default_config<ROCPRIM_TARGET_ARCH, key_type, accumulator_type>>;
+    using config = ArchConfig;
 
     using scan_state_type
-        = reduce_by_key::lookback_scan_state_t<accumulator_type, /*UseSleep=*/false>;
+        = reduce_by_key::lookback_scan_state_t<accumulator_type, OffsetType, /*UseSleep=*/false>;
     using scan_state_with_sleep_type
-        = reduce_by_key::lookback_scan_state_t<accumulator_type, /*UseSleep=*/true>;
+        = reduce_by_key::lookback_scan_state_t<accumulator_type, OffsetType, /*UseSleep=*/true>;
 
-    using ordered_tile_id_type = detail::ordered_block_id<unsigned int>;
+    using ordered_tile_id_type = detail::ordered_block_id<lookback_tile_id_type>;
 
     constexpr unsigned int block_size      = config::block_size;
     constexpr unsigned int tiles_per_block = config::tiles_per_block;
     constexpr unsigned int items_per_tile  = block_size * config::items_per_thread;
     constexpr unsigned int items_per_block = items_per_tile * tiles_per_block;
 
-    static constexpr size_t size_limit = config::size_limit;
-    static constexpr size_t aligned_size_limit
-        = ::rocprim::max<size_t>(size_limit - size_limit % items_per_block, items_per_block);
-
-    const size_t limited_size     = std::min<size_t>(size, aligned_size_limit);
-    const bool   use_limited_size = limited_size == aligned_size_limit;
-
-    // Number of tiles in a single launch (or the only launch if it fits)
-    const std::size_t number_of_tiles  = detail::ceiling_div(limited_size, items_per_tile);
+    const std::size_t number_of_tiles  = detail::ceiling_div(size, items_per_tile);
     const std::size_t number_of_blocks = detail::ceiling_div(number_of_tiles, tiles_per_block);
 
     // Calculate required temporary storage
     // scan_state_bytes is valid even with scan_state_with_sleep_type
-    const std::size_t scan_state_bytes       = scan_state_type::get_storage_size(number_of_tiles);
-    const std::size_t block_id_bytes         = ordered_tile_id_type::get_storage_size();
-    const std::size_t head_count_bytes       = sizeof(size_t);
-    const std::size_t prev_accumulated_bytes = sizeof(accumulator_type);
+    const std::size_t scan_state_bytes = scan_state_type::get_storage_size(number_of_tiles);
+    const std::size_t block_id_bytes   = ordered_tile_id_type::get_storage_size();
 
     const std::size_t block_id_offset = align_size(scan_state_bytes, alignof(std::size_t));
-    const std::size_t head_count_offset
-        = align_size(block_id_offset + block_id_bytes, alignof(ordered_tile_id_type));
-    const std::size_t prev_accumulated_offset
-        = align_size(head_count_offset + head_count_bytes, alignof(accumulator_type));
 
     if(temporary_storage == nullptr)
     {
         // storage_size is never zero
-        if(use_limited_size)
-        {
-            storage_size = block_id_offset + block_id_bytes;
-        }
-        else
-        {
-            storage_size = prev_accumulated_offset + prev_accumulated_bytes;
-        }
+        storage_size = block_id_offset + block_id_bytes;
 
         return hipSuccess;
     }
 
+    if(size == 0)
+    {
+        // Fill out unique_count_output with zero
+        return rocprim::transform(rocprim::constant_iterator<std::size_t>(0),
+                                  unique_count_output,
+                                  1,
+                                  rocprim::identity<std::size_t>{},
+                                  stream,
+                                  debug_synchronous);
+    }
+
     bool             use_sleep;
     const hipError_t result = detail::is_sleep_scan_state_used(use_sleep);
     if(result != hipSuccess)
@@ -261,115 +219,139 @@ hipError_t reduce_by_key_impl(void*                     temporary_storage,
     auto  ordered_bid      = ordered_tile_id_type::create(
         reinterpret_cast<ordered_tile_id_type::id_type*>(temp_storage_ptr + block_id_offset));
 
-    // The number of segment heads in previous launches.
-    std::size_t* d_global_head_count = nullptr;
-    // The running accumulation across the launch boundary.
-    accumulator_type* d_previous_accumulated = nullptr;
-    if(use_limited_size)
-    {
-        d_global_head_count = reinterpret_cast<std::size_t*>(temp_storage_ptr + head_count_offset);
-        d_previous_accumulated
-            = reinterpret_cast<accumulator_type*>(temp_storage_ptr + prev_accumulated_offset);
-    }
-
-    if(size == 0)
-    {
-        // Fill out unique_count_output with zero
-        return rocprim::transform(rocprim::constant_iterator<std::size_t>(0),
-                                  unique_count_output,
-                                  1,
-                                  rocprim::identity<std::size_t>{},
-                                  stream,
-                                  debug_synchronous);
-    }
-
-    // Total number of tiles in all launches
-    const std::size_t total_number_of_tiles = ceiling_div(size, items_per_tile);
-    const std::size_t number_of_launch      = ceiling_div(size, limited_size);
+    // All tiles are processed by a single launch, the grid is limited so that it does not cover
+    // more than config::size_limit items at once
+    const unsigned int grid_size
+        = lookback_grid_size(number_of_blocks, items_per_block, config::size_limit);
+    const std::size_t init_grid_size = detail::ceiling_div(number_of_tiles, block_size);
 
+    // Start point for time measurements
+    std::chrono::high_resolution_clock::time_point start;
     if(debug_synchronous)
     {
         std::cout << "size:               " << size << '\n';
-        std::cout << "aligned_size_limit: " << aligned_size_limit << '\n';
-        std::cout << "use_limited_size:   " << std::boolalpha << use_limited_size << '\n';
-        std::cout << "number_of_launch:   " << number_of_launch << '\n';
         std::cout << "block_size:         " << block_size << '\n';
         std::cout << "tiles_per_block:    " << tiles_per_block << '\n';
         std::cout << "number_of_tiles:    " << number_of_tiles << '\n';
-        std::cout << "number_of_blocks:   " << number_of_blocks << '\n';
+        std::cout << "number_of_blocks:   " << grid_size << '\n';
         std::cout << "items_per_tile:     " << items_per_tile << '\n';
+
+        start = std::chrono::high_resolution_clock::now();
     }
 
-    for(size_t i = 0, offset = 0; i < number_of_launch; i++, offset += limited_size)
-    {
-        const std::size_t current_size = std::min<std::size_t>(size - offset, limited_size);
-        const std::size_t number_of_tiles_launch = ceiling_div(current_size, items_per_tile);
-        const std::size_t number_of_blocks_launch
-            = ceiling_div(number_of_tiles_launch, tiles_per_block);
-        const std::size_t init_grid_size = detail::ceiling_div(number_of_tiles_launch, block_size);
-
-        // Start point for time measurements
-        std::chrono::high_resolution_clock::time_point start;
-        if(debug_synchronous)
+    with_scan_state(
+        [&](const auto scan_state)
         {
-            std::cout << "index:            " << i << '\n';
-            std::cout << "current_size:     " << current_size << '\n';
-            std::cout << "number of tiles:  " << number_of_tiles_launch << '\n';
-            std::cout << "number of blocks: " << number_of_blocks_launch << '\n';
+            hipLaunchKernelGGL(init_kernel,
+                               dim3(init_grid_size),
+                               dim3(block_size),
+                               0,
+                               stream,
+                               scan_state,
+                               number_of_tiles,
+                               ordered_bid);
+        });
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("init_lookback_scan_state_kernel",
+                                                number_of_tiles,
+                                                start);
 
-            start = std::chrono::high_resolution_clock::now();
-        }
-
-        with_scan_state(
-            [&](const auto scan_state)
-            {
-                hipLaunchKernelGGL(init_kernel,
-                                   dim3(init_grid_size),
-                                   dim3(block_size),
-                                   0,
-                                   stream,
-                                   scan_state,
-                                   number_of_tiles_launch,
-                                   ordered_bid,
-                                   i == 0,
-                                   number_of_tiles - 1,
-                                   d_global_head_count,
-                                   d_previous_accumulated);
-            });
-        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("init_lookback_scan_state_kernel",
-                                                    number_of_tiles_launch,
-                                                    start);
-
-        with_scan_state(
-            [&](const auto scan_state)
-            {
-                hipLaunchKernelGGL(reduce_by_key::kernel<config>,
-                                   dim3(number_of_blocks_launch),
-                                   dim3(block_size),
-                                   0,
-                                   stream,
-                                   keys_input + offset,
-                                   values_input + offset,
-                                   unique_output,
-                                   aggregates_output,
-                                   unique_count_output,
-                                   reduce_op,
-                                   key_compare_op,
-                                   scan_state,
-                                   ordered_bid,
-                                   i * number_of_tiles,
-                                   total_number_of_tiles,
-                                   size,
-                                   i > 0 ? d_global_head_count : nullptr,
-                                   i > 0 ? d_previous_accumulated : nullptr,
-                                   number_of_tiles_launch);
-            });
-        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("reduce_by_key_kernel", current_size, start);
+    if(debug_synchronous)
+    {
+        start = std::chrono::high_resolution_clock::now();
     }
+    with_scan_state(
+        [&](const auto scan_state)
+        {
+            hipLaunchKernelGGL(HIP_KERNEL_NAME(
+                                   reduce_by_key::kernel<Config, accumulator_type, OffsetType>),
+                               dim3(grid_size),
+                               dim3(block_size),
+                               0,
+                               stream,
+                               keys_input,
+                               values_input,
+                               unique_output,
+                               aggregates_output,
+                               unique_count_output,
+                               reduce_op,
+                               key_compare_op,
+                               scan_state,
+                               ordered_bid,
+                               number_of_tiles,
+                               size);
+        });
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("reduce_by_key_kernel", size, start);
 
     return hipSuccess;
 }
 
+template<class Config,
+         class KeysInputIterator,
+         class ValuesInputIterator,
+         class UniqueOutputIterator,
+         class AggregatesOutputIterator,
+         class UniqueCountOutputIterator,
+         class BinaryFunction,
+         class KeyCompareFunction>
+hipError_t reduce_by_key_impl(void*                     temporary_storage,
+                              size_t&                   storage_size,
+                              KeysInputIterator         keys_input,
+                              ValuesInputIterator       values_input,
+                              const size_t              size,
+                              UniqueOutputIterator      unique_output,
+                              AggregatesOutputIterator  aggregates_output,
+                              UniqueCountOutputIterator unique_count_output,
+                              BinaryFunction            reduce_op,
+                              KeyCompareFunction        key_compare_op,
+                              const hipStream_t         stream,
+                              const bool                debug_synchronous)
+{
+    using key_type         = reduce_by_key::value_type_t<KeysInputIterator>;
+    using accumulator_type = reduce_by_key::accumulator_type_t<ValuesInputIterator, BinaryFunction>;
+
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = reduce_by_key::wrapped_config<Config, key_type, accumulator_type>;
+
+    return dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            // Segment heads are counted in 32 bits unless the input is too large for them
+            if(size <= std::numeric_limits<unsigned int>::max())
+            {
+                return reduce_by_key_arch_impl<config,
+                                               typename decltype(arch_config)::type,
+                                               unsigned int>(temporary_storage,
+                                                             storage_size,
+                                                             keys_input,
+                                                             values_input,
+                                                             size,
+                                                             unique_output,
+                                                             aggregates_output,
+                                                             unique_count_output,
+                                                             reduce_op,
+                                                             key_compare_op,
+                                                             stream,
+                                                             debug_synchronous);
+            }
+            return reduce_by_key_arch_impl<config,
+                                           typename decltype(arch_config)::type,
+                                           std::size_t>(
+                temporary_storage,
+                storage_size,
+                keys_input,
+                values_input,
+                size,
+                unique_output,
+                aggregates_output,
+                unique_count_output,
+                reduce_op,
+                key_compare_op,
+                stream,
+                debug_synchronous);
+        });
+}
+
 #undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
 
 } // namespace reduce_by_key
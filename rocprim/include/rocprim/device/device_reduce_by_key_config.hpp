@@ -45,7 +45,8 @@ BEGIN_ROCPRIM_NAMESPACE
  * \tparam LoadValuesMethod method of loading values
  * \tparam ScanAlgorithm block level scan algorithm to use
  * \tparam TilesPerBlock number of tiles (`BlockSize` * `ItemsPerThread` items) to process per block
- * \tparam SizeLimit limit on the number of items for a single reduce_by_key kernel launch.
+ * \tparam SizeLimit limit on the number of items covered at once by the blocks of a reduce_by_key
+ * kernel launch. Larger inputs are still processed by a single launch.
  */
 template<unsigned int         BlockSize,
          unsigned int         ItemsPerThread,
@@ -111,18 +112,36 @@ struct fallback_config
                                   2>;
 };
 
+template<typename Key, typename Value>
+struct universal_config
+{
+    using type
+        = std::conditional_t<std::max(sizeof(Key), sizeof(Value)) <= 16,
+                             rocprim::reduce_by_key_config_v2<256,
+                                                              15,
+                                                              block_load_method::block_load_transpose,
+                                                              block_load_method::block_load_transpose,
+                                                              block_scan_algorithm::using_warp_scan,
+                                                              sizeof(Value) < 16 ? 1 : 2>,
+                             typename reduce_by_key::fallback_config<Key, Value>::type>;
+};
+
 template<unsigned int TargetArch, class Key, class Value>
-struct default_config
-    : std::conditional_t<std::max(sizeof(Key), sizeof(Value)) <= 16,
-                         rocprim::reduce_by_key_config_v2<256,
-                                                          15,
-                                                          block_load_method::block_load_transpose,
-                                                          block_load_method::block_load_transpose,
-                                                          block_scan_algorithm::using_warp_scan,
-                                                          sizeof(Value) < 16 ? 1 : 2>,
-                         typename reduce_by_key::fallback_config<Key, Value>::type>
+struct default_config : select_arch<TargetArch, universal_config<Key, Value>>
 {};
 
+// Config of reduce_by_key and run_length_encode_non_trivial_runs per target architecture.
+template<class Config, class Key, class Value>
+struct wrapped_config
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        using type
+            = arch_config_t<Config, default_config<static_cast<unsigned int>(Arch), Key, Value>>;
+    };
+};
+
 } // namespace reduce_by_key
 
 } // end namespace detail
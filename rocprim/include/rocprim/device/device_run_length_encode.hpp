@@ -21,6 +21,7 @@
 #ifndef ROCPRIM_DEVICE_DEVICE_RUN_LENGTH_ENCODE_HPP_
 #define ROCPRIM_DEVICE_DEVICE_RUN_LENGTH_ENCODE_HPP_
 
+#include <chrono>
 #include <iostream>
 #include <iterator>
 #include <type_traits>
@@ -28,14 +29,18 @@
 #include "../config.hpp"
 #include "../detail/various.hpp"
 
+#include "../functional.hpp"
 #include "../iterator/constant_iterator.hpp"
-#include "../iterator/counting_iterator.hpp"
-#include "../iterator/discard_iterator.hpp"
-#include "../iterator/zip_iterator.hpp"
+
+#include "detail/device_run_length_encode.hpp"
+#include "detail/device_scan_common.hpp"
+#include "detail/lookback_scan_state.hpp"
+#include "detail/ordered_block_id.hpp"
 
 #include "device_run_length_encode_config.hpp"
 #include "device_reduce_by_key.hpp"
-#include "device_select.hpp"
+#include "device_transform.hpp"
+#include "device_trace.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -45,9 +50,40 @@ BEGIN_ROCPRIM_NAMESPACE
 namespace detail
 {
 
+template<class Config,
+         class KeyIterator,
+         class OffsetsOutputIterator,
+         class CountsOutputIterator,
+         class RunsCountOutputIterator,
+         class CompareFunction,
+         class LookbackScanState>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::block_size) void non_trivial_runs_kernel(
+    const KeyIterator                    keys_input,
+    const OffsetsOutputIterator          offsets_output,
+    const CountsOutputIterator           counts_output,
+    const RunsCountOutputIterator        runs_count_output,
+    const CompareFunction                compare,
+    const LookbackScanState              scan_state,
+    const ordered_block_id<unsigned int> ordered_tile_id,
+    const unsigned int                   number_of_tiles,
+    const unsigned int                   size)
+{
+    run_length_encode::non_trivial_runs_kernel_impl<device_target_arch_config_t<Config>>(
+        keys_input,
+        offsets_output,
+        counts_output,
+        runs_count_output,
+        compare,
+        scan_state,
+        ordered_tile_id,
+        number_of_tiles,
+        size);
+}
+
 #define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start) \
     { \
         if(error != hipSuccess) return error; \
+        ::rocprim::detail::kernel_trace_end(name, size, stream); \
         if(debug_synchronous) \
         { \
             std::cout << name << "(" << size << ")"; \
@@ -59,6 +95,138 @@ namespace detail
         } \
     }
 
+// The non-trivial runs kernel shares the configuration of reduce-by-key, KernelConfig is the
+// wrapped reduce-by-key config and ArchKernelConfig its config of the target architecture.
+template<
+    class KernelConfig,
+    class ArchKernelConfig,
+    class InputIterator,
+    class OffsetsOutputIterator,
+    class CountsOutputIterator,
+    class RunsCountOutputIterator
+>
+inline
+hipError_t run_length_encode_non_trivial_runs_impl(void * temporary_storage,
+                                                   size_t& storage_size,
+                                                   InputIterator input,
+                                                   unsigned int size,
+                                                   OffsetsOutputIterator offsets_output,
+                                                   CountsOutputIterator counts_output,
+                                                   RunsCountOutputIterator runs_count_output,
+                                                   hipStream_t stream,
+                                                   bool debug_synchronous)
+{
+    using input_type = typename std::iterator_traits<InputIterator>::value_type;
+
+    using kernel_config = ArchKernelConfig;
+
+    using scan_state_type = detail::run_length_encode::non_trivial_runs_scan_state_t<false>;
+    using scan_state_with_sleep_type = detail::run_length_encode::non_trivial_runs_scan_state_t<true>;
+    using ordered_tile_id_type = detail::ordered_block_id<unsigned int>;
+
+    constexpr unsigned int block_size = kernel_config::block_size;
+    constexpr unsigned int tiles_per_block = kernel_config::tiles_per_block;
+    constexpr unsigned int items_per_tile = block_size * kernel_config::items_per_thread;
+
+    const unsigned int number_of_tiles = detail::ceiling_div(size, items_per_tile);
+    const unsigned int number_of_blocks = detail::ceiling_div(number_of_tiles, tiles_per_block);
+
+    // Calculate required temporary storage
+    // scan_state_bytes is valid even with scan_state_with_sleep_type
+    const size_t scan_state_bytes =
+        ::rocprim::detail::align_size(scan_state_type::get_storage_size(number_of_tiles));
+    const size_t ordered_tile_id_bytes = ordered_tile_id_type::get_storage_size();
+    if(temporary_storage == nullptr)
+    {
+        storage_size = scan_state_bytes + ordered_tile_id_bytes;
+        return hipSuccess;
+    }
+
+    hipError_t error;
+
+    if(size == 0)
+    {
+        // Fill out runs_count_output with zero
+        return ::rocprim::transform(
+            ::rocprim::constant_iterator<unsigned int>(0),
+            runs_count_output, 1,
+            ::rocprim::identity<unsigned int>(),
+            stream, debug_synchronous
+        );
+    }
+
+    bool use_sleep;
+    error = detail::is_sleep_scan_state_used(use_sleep);
+    if(error != hipSuccess) return error;
+
+    auto * ptr = reinterpret_cast<char *>(temporary_storage);
+    auto scan_state = scan_state_type::create(ptr, number_of_tiles);
+    auto scan_state_with_sleep = scan_state_with_sleep_type::create(ptr, number_of_tiles);
+    ptr += scan_state_bytes;
+    auto ordered_tile_id = ordered_tile_id_type::create(
+        reinterpret_cast<ordered_tile_id_type::id_type *>(ptr)
+    );
+
+    if(debug_synchronous)
+    {
+        std::cout << "size:             " << size << '\n';
+        std::cout << "block_size:       " << block_size << '\n';
+        std::cout << "tiles_per_block:  " << tiles_per_block << '\n';
+        std::cout << "number_of_tiles:  " << number_of_tiles << '\n';
+        std::cout << "number_of_blocks: " << number_of_blocks << '\n';
+        std::cout << "items_per_tile:   " << items_per_tile << '\n';
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    const unsigned int init_grid_size = detail::ceiling_div(number_of_tiles, block_size);
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    if(use_sleep)
+    {
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(detail::init_lookback_scan_state_kernel<scan_state_with_sleep_type>),
+            dim3(init_grid_size), dim3(block_size), 0, stream,
+            scan_state_with_sleep, number_of_tiles, ordered_tile_id
+        );
+    }
+    else
+    {
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(detail::init_lookback_scan_state_kernel<scan_state_type>),
+            dim3(init_grid_size), dim3(block_size), 0, stream,
+            scan_state, number_of_tiles, ordered_tile_id
+        );
+    }
+    error = hipGetLastError();
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("init_lookback_scan_state_kernel", number_of_tiles, start)
+
+    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+    if(use_sleep)
+    {
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(detail::non_trivial_runs_kernel<KernelConfig>),
+            dim3(number_of_blocks), dim3(block_size), 0, stream,
+            input, offsets_output, counts_output, runs_count_output,
+            ::rocprim::equal_to<input_type>(),
+            scan_state_with_sleep, ordered_tile_id, number_of_tiles, size
+        );
+    }
+    else
+    {
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(detail::non_trivial_runs_kernel<KernelConfig>),
+            dim3(number_of_blocks), dim3(block_size), 0, stream,
+            input, offsets_output, counts_output, runs_count_output,
+            ::rocprim::equal_to<input_type>(),
+            scan_state, ordered_tile_id, number_of_tiles, size
+        );
+    }
+    error = hipGetLastError();
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("non_trivial_runs_kernel", size, start)
+
+    return hipSuccess;
+}
+
 } // end detail namespace
 
 /// \brief Parallel run-length encoding for device level.
@@ -191,6 +359,9 @@ hipError_t run_length_encode(void * temporary_storage,
 /// * Range specified by \p runs_count_output must have at least 1 element.
 /// * Ranges specified by \p offsets_output and \p counts_output must have at least
 /// <tt>*runs_count_output</tt> (i.e. the number of non-trivial runs) elements.
+/// * The non-trivial runs are found and written by a single kernel using decoupled look-back,
+/// trivial runs (runs of one element) are never stored.
+/// * The kernel is configured by the \p reduce_by_key member of \p Config.
 ///
 /// \tparam Config - [optional] configuration of the primitive. It can be \p run_length_encode_config or
 /// a custom class with the same members.
@@ -276,131 +447,32 @@ hipError_t run_length_encode_non_trivial_runs(void * temporary_storage,
                                               bool debug_synchronous = false)
 {
     using input_type = typename std::iterator_traits<InputIterator>::value_type;
-    using offset_type = unsigned int;
-    using count_type = unsigned int;
-    using offset_count_pair = typename ::rocprim::tuple<offset_type, count_type>;
 
     using config = detail::default_or_custom_config<
         Config,
         detail::default_run_length_encode_config
     >;
+    // Get the reduce-by-key config of the target architecture, or config::reduce_by_key
+    // if it is not default_config
+    using kernel_config = detail::reduce_by_key::
+        wrapped_config<typename config::reduce_by_key, input_type, unsigned int>;
 
-    hipError_t error;
-
-    auto reduce_op = [] __device__ (const offset_count_pair& a, const offset_count_pair& b)
-    {
-        return offset_count_pair(
-            ::rocprim::get<0>(a), // Always use offset of the first item of the run
-            ::rocprim::get<1>(a) + ::rocprim::get<1>(b) // Number of items in the run
-        );
-    };
-    auto non_trivial_runs_select_op = [] __device__ (const offset_count_pair& a)
-    {
-        return ::rocprim::get<1>(a) > 1;
-    };
-
-    offset_type * offsets_tmp = nullptr;
-    count_type * counts_tmp = nullptr;
-    count_type * all_runs_count_tmp = nullptr;
-
-    // Calculate size of temporary storage for reduce_by_key operation
-    size_t reduce_by_key_bytes;
-    error = ::rocprim::reduce_by_key<typename config::reduce_by_key>(
-        nullptr, reduce_by_key_bytes,
-        input,
-        ::rocprim::make_zip_iterator(
-            ::rocprim::make_tuple(
-                ::rocprim::make_counting_iterator<offset_type>(0),
-                ::rocprim::make_constant_iterator<count_type>(1)
-            )
-        ),
-        size,
-        ::rocprim::make_discard_iterator(),
-        ::rocprim::make_zip_iterator(::rocprim::make_tuple(offsets_tmp, counts_tmp)),
-        all_runs_count_tmp,
-        reduce_op, ::rocprim::equal_to<input_type>(),
-        stream, debug_synchronous
-    );
-    if(error != hipSuccess) return error;
-    reduce_by_key_bytes = ::rocprim::detail::align_size(reduce_by_key_bytes);
-
-    // Calculate size of temporary storage for select operation
-    size_t select_bytes;
-    error = ::rocprim::select<typename config::select>(
-        nullptr, select_bytes,
-        ::rocprim::make_zip_iterator(::rocprim::make_tuple(offsets_tmp, counts_tmp)),
-        ::rocprim::make_zip_iterator(::rocprim::make_tuple(offsets_output, counts_output)),
-        runs_count_output,
-        size,
-        non_trivial_runs_select_op,
-        stream, debug_synchronous
-    );
-    if(error != hipSuccess) return error;
-    select_bytes = ::rocprim::detail::align_size(select_bytes);
-
-    const size_t offsets_tmp_bytes = ::rocprim::detail::align_size(size * sizeof(offset_type));
-    const size_t counts_tmp_bytes = ::rocprim::detail::align_size(size * sizeof(count_type));
-    const size_t all_runs_count_tmp_bytes = sizeof(count_type);
-    if(temporary_storage == nullptr)
-    {
-        storage_size = ::rocprim::max(reduce_by_key_bytes, select_bytes) +
-            offsets_tmp_bytes + counts_tmp_bytes + all_runs_count_tmp_bytes;
-        return hipSuccess;
-    }
-
-    char * ptr = reinterpret_cast<char *>(temporary_storage);
-    ptr += ::rocprim::max(reduce_by_key_bytes, select_bytes);
-    offsets_tmp = reinterpret_cast<offset_type *>(ptr);
-    ptr += offsets_tmp_bytes;
-    counts_tmp = reinterpret_cast<count_type *>(ptr);
-    ptr += counts_tmp_bytes;
-    all_runs_count_tmp = reinterpret_cast<count_type *>(ptr);
-
-    std::chrono::high_resolution_clock::time_point start;
-
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    error = ::rocprim::reduce_by_key<typename config::reduce_by_key>(
-        temporary_storage, reduce_by_key_bytes,
-        input,
-        ::rocprim::make_zip_iterator(
-            ::rocprim::make_tuple(
-                ::rocprim::make_counting_iterator<offset_type>(0),
-                ::rocprim::make_constant_iterator<count_type>(1)
-            )
-        ),
-        size,
-        ::rocprim::make_discard_iterator(), // Ignore unique output
-        ::rocprim::make_zip_iterator(rocprim::make_tuple(offsets_tmp, counts_tmp)),
-        all_runs_count_tmp,
-        reduce_op, ::rocprim::equal_to<input_type>(),
-        stream, debug_synchronous
-    );
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("rocprim::reduce_by_key", size, start)
-
-    // Read count of all runs (including trivial runs)
-    count_type all_runs_count;
-    error = detail::memcpy_and_sync(&all_runs_count,
-                                    all_runs_count_tmp,
-                                    sizeof(count_type),
-                                    hipMemcpyDeviceToHost,
-                                    stream);
-    if(error != hipSuccess)
-        return error;
-
-    // Select non-trivial runs
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    error = ::rocprim::select<typename config::select>(
-        temporary_storage, select_bytes,
-        ::rocprim::make_zip_iterator(::rocprim::make_tuple(offsets_tmp, counts_tmp)),
-        ::rocprim::make_zip_iterator(::rocprim::make_tuple(offsets_output, counts_output)),
-        runs_count_output,
-        all_runs_count,
-        non_trivial_runs_select_op,
-        stream, debug_synchronous
-    );
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("rocprim::select", all_runs_count, start)
-
-    return hipSuccess;
+    return detail::dispatch_target_arch_config<kernel_config>(
+        stream,
+        [&](auto arch_config)
+        {
+            return detail::run_length_encode_non_trivial_runs_impl<
+                kernel_config,
+                typename decltype(arch_config)::type>(temporary_storage,
+                                                      storage_size,
+                                                      input,
+                                                      size,
+                                                      offsets_output,
+                                                      counts_output,
+                                                      runs_count_output,
+                                                      stream,
+                                                      debug_synchronous);
+        });
 }
 
 #undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
@@ -35,10 +35,11 @@ BEGIN_ROCPRIM_NAMESPACE
 
 /// \brief Configuration of device-level run-length encoding operation.
 ///
-/// \tparam ReduceByKeyConfig - configuration of device-level reduce-by-key operation.
+/// \tparam ReduceByKeyConfig - configuration of device-level reduce-by-key operation, also used
+/// by the kernel of \p run_length_encode_non_trivial_runs.
 /// Must be \p reduce_by_key_config_v2 or \p default_config.
-/// \tparam SelectConfig - configuration of device-level select operation.
-/// Must be \p select_config or \p default_config.
+/// \tparam SelectConfig - configuration of device-level select operation. It is no longer used
+/// and only kept for compatibility. Must be \p select_config or \p default_config.
 template<
     class ReduceByKeyConfig,
     class SelectConfig = default_config
@@ -33,9 +33,11 @@
 
 #include "device_scan_config.hpp"
 #include "device_transform.hpp"
+#include "detail/device_host_native.hpp"
 #include "detail/device_scan_common.hpp"
 #include "detail/device_scan_lookback.hpp"
 #include "detail/device_scan_reduce_then_scan.hpp"
+#include "device_trace.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -55,14 +57,14 @@ template<
     class InitValueType
 >
 ROCPRIM_KERNEL
-__launch_bounds__(ROCPRIM_DEFAULT_MAX_BLOCK_SIZE)
+__launch_bounds__(device_target_arch_config_t<Config>::block_size)
 void single_scan_kernel(InputIterator input,
                         const size_t size,
                         const InitValueType initial_value,
                         OutputIterator output,
                         BinaryFunction scan_op)
 {
-    single_scan_kernel_impl<Exclusive, Config>(
+    single_scan_kernel_impl<Exclusive, device_target_arch_config_t<Config>>(
         input, size, get_input_value(initial_value), output, scan_op
     );
 }
@@ -78,12 +80,12 @@ template<
     class ResultType
 >
 ROCPRIM_KERNEL
-__launch_bounds__(ROCPRIM_DEFAULT_MAX_BLOCK_SIZE)
+__launch_bounds__(device_target_arch_config_t<Config>::block_size)
 void block_reduce_kernel(InputIterator input,
                          BinaryFunction scan_op,
                          ResultType * block_prefixes)
 {
-    block_reduce_kernel_impl<Config>(
+    block_reduce_kernel_impl<device_target_arch_config_t<Config>>(
         input, scan_op, block_prefixes
     );
 }
@@ -97,7 +99,7 @@ template<
     class InitValueType
 >
 ROCPRIM_KERNEL
-__launch_bounds__(ROCPRIM_DEFAULT_MAX_BLOCK_SIZE)
+__launch_bounds__(device_target_arch_config_t<Config>::block_size)
 void final_scan_kernel(InputIterator input,
                        const size_t size,
                        OutputIterator output,
@@ -109,7 +111,7 @@ void final_scan_kernel(InputIterator input,
                        bool override_first_value = false,
                        bool save_last_value = false)
 {
-    final_scan_kernel_impl<Exclusive, Config>(
+    final_scan_kernel_impl<Exclusive, device_target_arch_config_t<Config>>(
         input, size, output, get_input_value(initial_value),
         scan_op, block_prefixes,
         previous_last_element, new_last_element,
@@ -129,25 +131,19 @@ template<
     class LookBackScanState
 >
 ROCPRIM_KERNEL
-__launch_bounds__(ROCPRIM_DEFAULT_MAX_BLOCK_SIZE)
+__launch_bounds__(device_target_arch_config_t<Config>::block_size)
 void lookback_scan_kernel(InputIterator input,
                           OutputIterator output,
                           const size_t size,
                           const InitValueType initial_value,
                           BinaryFunction scan_op,
                           LookBackScanState lookback_scan_state,
-                          const unsigned int number_of_blocks,
-                          ordered_block_id<unsigned int> ordered_bid,
-                          input_type_t<InitValueType>* previous_last_element = nullptr,
-                          input_type_t<InitValueType>* new_last_element = nullptr,
-                          bool override_first_value = false,
-                          bool save_last_value = false)
+                          const size_t number_of_tiles,
+                          ordered_block_id<lookback_tile_id_type> ordered_tile_id)
 {
-    lookback_scan_kernel_impl<Exclusive, Config>(
+    lookback_scan_kernel_impl<Exclusive, device_target_arch_config_t<Config>>(
         input, output, size, get_input_value(initial_value), scan_op,
-        lookback_scan_state, number_of_blocks, ordered_bid,
-        previous_last_element, new_last_element,
-        override_first_value, save_last_value
+        lookback_scan_state, number_of_tiles, ordered_tile_id
     );
 }
 
@@ -166,6 +162,7 @@ void lookback_scan_kernel(InputIterator input,
     { \
         auto _error = hipGetLastError(); \
         if(_error != hipSuccess) return _error; \
+        ::rocprim::detail::kernel_trace_end(name, size, stream); \
         if(debug_synchronous) \
         { \
             std::cout << name << "(" << size << ")"; \
@@ -180,6 +177,7 @@ void lookback_scan_kernel(InputIterator input,
 template<
     bool Exclusive,
     class Config,
+    class ArchConfig,
     class InputIterator,
     class OutputIterator,
     class InitValueType,
@@ -195,9 +193,9 @@ auto scan_impl(void * temporary_storage,
                BinaryFunction scan_op,
                const hipStream_t stream,
                bool debug_synchronous)
-    -> typename std::enable_if<!Config::use_lookback, hipError_t>::type
+    -> typename std::enable_if<!ArchConfig::use_lookback, hipError_t>::type
 {
-    using config = Config;
+    using config = ArchConfig;
     using real_init_value_type = input_type_t<InitValueType>;
 
     constexpr unsigned int block_size = config::block_size;
@@ -271,10 +269,17 @@ auto scan_impl(void * temporary_storage,
             auto grid_size = number_of_blocks - 1;
             if( grid_size != 0 )
             {
+                kernel_trace_begin(stream,
+                                   dim3(grid_size),
+                                   dim3(block_size),
+                                   items_per_thread,
+                                   (grid_size * items_per_block)
+                                       * kernel_trace_item_bytes<InputIterator>(),
+                                   grid_size * sizeof(real_init_value_type));
                 if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
                 hipLaunchKernelGGL(
                     HIP_KERNEL_NAME(detail::block_reduce_kernel<
-                        config, InputIterator, BinaryFunction, real_init_value_type
+                        Config, InputIterator, BinaryFunction, real_init_value_type
                     >),
                     dim3(grid_size), dim3(block_size), 0, stream,
                     input + offset, scan_op, block_prefixes
@@ -298,7 +303,7 @@ auto scan_impl(void * temporary_storage,
                 auto nested_temp_storage_size = storage_size - (number_of_blocks * sizeof(real_init_value_type));
 
                 if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-                auto error = scan_impl<false, config>(
+                auto error = scan_impl<false, Config, ArchConfig>(
                     nested_temp_storage,
                     nested_temp_storage_size,
                     block_prefixes, // input
@@ -316,11 +321,18 @@ auto scan_impl(void * temporary_storage,
 
             // Grid size for final_scan_kernel
             grid_size = number_of_blocks;
+            kernel_trace_begin(stream,
+                               dim3(grid_size),
+                               dim3(block_size),
+                               items_per_thread,
+                               current_size * kernel_trace_item_bytes<InputIterator>()
+                                   + number_of_blocks * sizeof(real_init_value_type),
+                               current_size * sizeof(real_init_value_type));
             if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
             hipLaunchKernelGGL(
                 HIP_KERNEL_NAME(detail::final_scan_kernel<
                     Exclusive, // flag for exclusive scan operation
-                    config, // kernel configuration (block size, ipt)
+                    Config, // kernel configuration (block size, ipt)
                     InputIterator, OutputIterator,
                     BinaryFunction, InitValueType
                 >),
@@ -359,11 +371,17 @@ auto scan_impl(void * temporary_storage,
             std::cout << "items_per_block " << items_per_block << '\n';
         }
 
+        kernel_trace_begin(stream,
+                           dim3(1),
+                           dim3(block_size),
+                           items_per_thread,
+                           size * kernel_trace_item_bytes<InputIterator>(),
+                           size * sizeof(real_init_value_type));
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
         hipLaunchKernelGGL(
             HIP_KERNEL_NAME(detail::single_scan_kernel<
                 Exclusive, // flag for exclusive scan operation
-                config, // kernel configuration (block size, ipt)
+                Config, // kernel configuration (block size, ipt)
                 InputIterator, OutputIterator, BinaryFunction
             >),
             dim3(1), dim3(block_size), 0, stream,
@@ -377,6 +395,7 @@ auto scan_impl(void * temporary_storage,
 template<
     bool Exclusive,
     class Config,
+    class ArchConfig,
     class InputIterator,
     class OutputIterator,
     class InitValueType,
@@ -392,39 +411,31 @@ auto scan_impl(void * temporary_storage,
                BinaryFunction scan_op,
                const hipStream_t stream,
                bool debug_synchronous)
-    -> typename std::enable_if<Config::use_lookback, hipError_t>::type
+    -> typename std::enable_if<ArchConfig::use_lookback, hipError_t>::type
 {
-    using config = Config;
+    using config = ArchConfig;
     using real_init_value_type = input_type_t<InitValueType>;
 
     using scan_state_type = detail::lookback_scan_state<real_init_value_type>;
     using scan_state_with_sleep_type = detail::lookback_scan_state<real_init_value_type, true>;
-    using ordered_block_id_type = detail::ordered_block_id<unsigned int>;
+    using ordered_tile_id_type = detail::ordered_block_id<lookback_tile_id_type>;
 
     constexpr unsigned int block_size = config::block_size;
     constexpr unsigned int items_per_thread = config::items_per_thread;
     constexpr auto items_per_block = block_size * items_per_thread;
 
-    static constexpr size_t size_limit = config::size_limit;
-    static constexpr size_t aligned_size_limit = ::rocprim::max<size_t>(size_limit - size_limit % items_per_block, items_per_block);
-    size_t limited_size = std::min<size_t>(size, aligned_size_limit);
-    const bool use_limited_size = limited_size == aligned_size_limit;
-
-    unsigned int number_of_blocks = (limited_size + items_per_block - 1)/items_per_block;
+    const size_t number_of_tiles = ::rocprim::detail::ceiling_div(size, items_per_block);
 
     // Calculate required temporary storage
     size_t scan_state_bytes = ::rocprim::detail::align_size(
         // This is valid even with scan_state_with_sleep_type
-        scan_state_type::get_storage_size(number_of_blocks)
+        scan_state_type::get_storage_size(number_of_tiles)
     );
-    size_t ordered_block_id_bytes = ordered_block_id_type::get_storage_size();
+    size_t ordered_tile_id_bytes = ordered_tile_id_type::get_storage_size();
     if(temporary_storage == nullptr)
     {
         // storage_size is never zero
-        storage_size = scan_state_bytes + ordered_block_id_bytes;
-
-        if(use_limited_size)
-            storage_size += 2 * sizeof(real_init_value_type);
+        storage_size = scan_state_bytes + ordered_tile_id_bytes;
 
         return hipSuccess;
     }
@@ -432,137 +443,109 @@ auto scan_impl(void * temporary_storage,
     // Start point for time measurements
     std::chrono::high_resolution_clock::time_point start;
 
-    if( number_of_blocks == 0u )
+    if( number_of_tiles == 0u )
         return hipSuccess;
 
-    if(number_of_blocks > 1 || use_limited_size)
+    if(number_of_tiles > 1)
     {
         // Create and initialize lookback_scan_state obj
-        auto scan_state = scan_state_type::create(temporary_storage, number_of_blocks);
-        auto scan_state_with_sleep = scan_state_with_sleep_type::create(temporary_storage, number_of_blocks);
+        auto scan_state = scan_state_type::create(temporary_storage, number_of_tiles);
+        auto scan_state_with_sleep = scan_state_with_sleep_type::create(temporary_storage, number_of_tiles);
         // Create ad initialize ordered_block_id obj
         auto ptr = reinterpret_cast<char*>(temporary_storage);
-        auto ordered_bid = ordered_block_id_type::create(
-            reinterpret_cast<ordered_block_id_type::id_type*>(ptr + scan_state_bytes)
+        auto ordered_tile_id = ordered_tile_id_type::create(
+            reinterpret_cast<ordered_tile_id_type::id_type*>(ptr + scan_state_bytes)
         );
 
-        // The last element
-        real_init_value_type* previous_last_element = nullptr;
-        real_init_value_type* new_last_element = nullptr;
-        if(use_limited_size)
-        {
-            ptr += storage_size - sizeof(real_init_value_type);
-            new_last_element = reinterpret_cast<real_init_value_type*>(ptr);
-            ptr -= sizeof(real_init_value_type);
-            previous_last_element = reinterpret_cast<real_init_value_type*>(ptr);
-        }
-
         hipDeviceProp_t prop;
         int deviceId;
         static_cast<void>(hipGetDevice(&deviceId));
         static_cast<void>(hipGetDeviceProperties(&prop, deviceId));
 
-        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-
 #if HIP_VERSION >= 307
         int asicRevision = prop.asicRevision;
 #else
         int asicRevision = 0;
 #endif
 
-        size_t number_of_launch = (size + limited_size - 1)/limited_size;
-        for (size_t i = 0, offset = 0; i < number_of_launch; i++, offset+=limited_size )
-        {
-            size_t current_size = std::min<size_t>(size - offset, limited_size);
-            number_of_blocks = (current_size + items_per_block - 1)/items_per_block;
-            auto grid_size = (number_of_blocks + block_size - 1)/block_size;
-
-            if(debug_synchronous)
-            {
-                std::cout << "use_limited_size " << use_limited_size << '\n';
-                std::cout << "aligned_size_limit " << aligned_size_limit << '\n';
-                std::cout << "number_of_launch " << number_of_launch << '\n';
-                std::cout << "index " << i << '\n';
-                std::cout << "size " << current_size << '\n';
-                std::cout << "block_size " << block_size << '\n';
-                std::cout << "number of blocks " << number_of_blocks << '\n';
-                std::cout << "items_per_block " << items_per_block << '\n';
-            }
+        auto grid_size = ::rocprim::detail::ceiling_div(number_of_tiles, block_size);
 
-            if (prop.gcnArch == 908 && asicRevision < 2)
-            {
-                hipLaunchKernelGGL(
-                    HIP_KERNEL_NAME(init_lookback_scan_state_kernel<scan_state_with_sleep_type>),
-                    dim3(grid_size), dim3(block_size), 0, stream,
-                    scan_state_with_sleep, number_of_blocks, ordered_bid
-                );
-            } else
-            {
-                hipLaunchKernelGGL(
-                    HIP_KERNEL_NAME(init_lookback_scan_state_kernel<scan_state_type>),
-                    dim3(grid_size), dim3(block_size), 0, stream,
-                    scan_state, number_of_blocks, ordered_bid
-                );
-            }
-            ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("init_lookback_scan_state_kernel", number_of_blocks, start)
+        if(debug_synchronous)
+        {
+            std::cout << "size " << size << '\n';
+            std::cout << "block_size " << block_size << '\n';
+            std::cout << "number of tiles " << number_of_tiles << '\n';
+            std::cout << "items_per_block " << items_per_block << '\n';
+            start = std::chrono::high_resolution_clock::now();
+        }
 
-            if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-            grid_size = number_of_blocks;
-            if (prop.gcnArch == 908 && asicRevision < 2)
-            {
-                hipLaunchKernelGGL(
-                    HIP_KERNEL_NAME(lookback_scan_kernel<
-                        Exclusive, // flag for exclusive scan operation
-                        config, // kernel configuration (block size, ipt)
-                        InputIterator, OutputIterator,
-                        BinaryFunction, InitValueType, scan_state_with_sleep_type
-                    >),
-                    dim3(grid_size), dim3(block_size), 0, stream,
-                    input + offset, output + offset, current_size, initial_value,
-                    scan_op, scan_state_with_sleep, number_of_blocks, ordered_bid,
-                    previous_last_element, new_last_element,
-                    i != size_t(0), number_of_launch > 1
-                );
-            }
-            else
-            {
-                if(debug_synchronous)
-                {
-                    std::cout << "use_limited_size " << use_limited_size << '\n';
-                    std::cout << "aligned_size_limit " << aligned_size_limit << '\n';
-                    std::cout << "size " << current_size << '\n';
-                    std::cout << "block_size " << block_size << '\n';
-                    std::cout << "number of blocks " << number_of_blocks << '\n';
-                    std::cout << "items_per_block " << items_per_block << '\n';
-                }
+        kernel_trace_begin(stream,
+                           dim3(grid_size),
+                           dim3(block_size),
+                           1,
+                           0,
+                           scan_state_bytes + ordered_tile_id_bytes);
+        if (prop.gcnArch == 908 && asicRevision < 2)
+        {
+            hipLaunchKernelGGL(
+                HIP_KERNEL_NAME(init_lookback_scan_state_kernel<scan_state_with_sleep_type>),
+                dim3(grid_size), dim3(block_size), 0, stream,
+                scan_state_with_sleep, number_of_tiles, ordered_tile_id
+            );
+        } else
+        {
+            hipLaunchKernelGGL(
+                HIP_KERNEL_NAME(init_lookback_scan_state_kernel<scan_state_type>),
+                dim3(grid_size), dim3(block_size), 0, stream,
+                scan_state, number_of_tiles, ordered_tile_id
+            );
+        }
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("init_lookback_scan_state_kernel", number_of_tiles, start)
 
-                hipLaunchKernelGGL(
-                    HIP_KERNEL_NAME(lookback_scan_kernel<
-                        Exclusive, // flag for exclusive scan operation
-                        config, // kernel configuration (block size, ipt)
-                        InputIterator, OutputIterator,
-                        BinaryFunction, InitValueType, scan_state_type
-                    >),
-                    dim3(grid_size), dim3(block_size), 0, stream,
-                    input + offset, output + offset, current_size, initial_value,
-                    scan_op, scan_state, number_of_blocks, ordered_bid,
-                    previous_last_element, new_last_element,
-                    i != size_t(0), number_of_launch > 1
-                );
-            }
-            ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("lookback_scan_kernel", current_size, start)
+        // All tiles are scanned by a single launch, with fewer blocks than tiles if the tiles
+        // would exceed config::size_limit items
+        grid_size = lookback_grid_size(number_of_tiles, items_per_block, config::size_limit);
+        if(debug_synchronous)
+        {
+            std::cout << "number of blocks " << grid_size << '\n';
+            start = std::chrono::high_resolution_clock::now();
+        }
 
-            // Swap the last_elements
-            if(number_of_launch > 1)
-            {
-                hipError_t error = ::rocprim::transform(
-                    new_last_element, previous_last_element, 1,
-                    ::rocprim::identity<real_init_value_type>(),
-                    stream, debug_synchronous
-                );
-                if(error != hipSuccess) return error;
-            }
+        kernel_trace_begin(stream,
+                           dim3(grid_size),
+                           dim3(block_size),
+                           items_per_thread,
+                           size * kernel_trace_item_bytes<InputIterator>(),
+                           size * sizeof(real_init_value_type));
+        if (prop.gcnArch == 908 && asicRevision < 2)
+        {
+            hipLaunchKernelGGL(
+                HIP_KERNEL_NAME(lookback_scan_kernel<
+                    Exclusive, // flag for exclusive scan operation
+                    Config, // kernel configuration (block size, ipt)
+                    InputIterator, OutputIterator,
+                    BinaryFunction, InitValueType, scan_state_with_sleep_type
+                >),
+                dim3(grid_size), dim3(block_size), 0, stream,
+                input, output, size, initial_value,
+                scan_op, scan_state_with_sleep, number_of_tiles, ordered_tile_id
+            );
+        }
+        else
+        {
+            hipLaunchKernelGGL(
+                HIP_KERNEL_NAME(lookback_scan_kernel<
+                    Exclusive, // flag for exclusive scan operation
+                    Config, // kernel configuration (block size, ipt)
+                    InputIterator, OutputIterator,
+                    BinaryFunction, InitValueType, scan_state_type
+                >),
+                dim3(grid_size), dim3(block_size), 0, stream,
+                input, output, size, initial_value,
+                scan_op, scan_state, number_of_tiles, ordered_tile_id
+            );
         }
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("lookback_scan_kernel", size, start)
     }
     else
     {
@@ -570,15 +553,21 @@ auto scan_impl(void * temporary_storage,
         {
             std::cout << "size " << size << '\n';
             std::cout << "block_size " << block_size << '\n';
-            std::cout << "number of blocks " << number_of_blocks << '\n';
+            std::cout << "number of tiles " << number_of_tiles << '\n';
             std::cout << "items_per_block " << items_per_block << '\n';
         }
 
+        kernel_trace_begin(stream,
+                           dim3(1),
+                           dim3(block_size),
+                           items_per_thread,
+                           size * kernel_trace_item_bytes<InputIterator>(),
+                           size * sizeof(real_init_value_type));
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
         hipLaunchKernelGGL(
             HIP_KERNEL_NAME(single_scan_kernel<
                 Exclusive, // flag for exclusive scan operation
-                config, // kernel configuration (block size, ipt)
+                Config, // kernel configuration (block size, ipt)
                 InputIterator, OutputIterator, BinaryFunction
             >),
             dim3(1), dim3(block_size), 0, stream,
@@ -718,18 +707,33 @@ hipError_t inclusive_scan(void * temporary_storage,
 {
     using input_type = typename std::iterator_traits<InputIterator>::value_type;
 
-    // Get default config if Config is default_config
-    using config = detail::default_or_custom_config<
-        Config,
-        detail::default_scan_config<ROCPRIM_TARGET_ARCH, input_type>
-        >;
-
-    return detail::scan_impl<false, config>(
-        temporary_storage, storage_size,
-        // input_type() is a dummy initial value (not used)
-        input, output, input_type(), size,
-        scan_op, stream, debug_synchronous
-    );
+#if ROCPRIM_DETAIL_USE_HOST_NATIVE
+    return detail::host_native_scan<false>(temporary_storage,
+                                           storage_size,
+                                           input,
+                                           output,
+                                           input_type(),
+                                           size,
+                                           scan_op,
+                                           stream,
+                                           debug_synchronous);
+#else
+
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = detail::wrapped_scan_config<Config, input_type>;
+
+    return detail::dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            return detail::scan_impl<false, config, typename decltype(arch_config)::type>(
+                temporary_storage, storage_size,
+                // input_type() is a dummy initial value (not used)
+                input, output, input_type(), size,
+                scan_op, stream, debug_synchronous
+            );
+        });
+#endif
 }
 
 /// \brief Parallel exclusive scan primitive for device level.
@@ -835,19 +839,33 @@ hipError_t exclusive_scan(void * temporary_storage,
                           const hipStream_t stream = 0,
                           bool debug_synchronous = false)
 {
+#if ROCPRIM_DETAIL_USE_HOST_NATIVE
+    return detail::host_native_scan<true>(temporary_storage,
+                                          storage_size,
+                                          input,
+                                          output,
+                                          initial_value,
+                                          size,
+                                          scan_op,
+                                          stream,
+                                          debug_synchronous);
+#else
     using real_init_value_type = detail::input_type_t<InitValueType>;
 
-    // Get default config if Config is default_config
-    using config = detail::default_or_custom_config<
-        Config,
-        detail::default_scan_config<ROCPRIM_TARGET_ARCH, real_init_value_type>
-    >;
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = detail::wrapped_scan_config<Config, real_init_value_type>;
 
-    return detail::scan_impl<true, config>(
-        temporary_storage, storage_size,
-        input, output, initial_value, size,
-        scan_op, stream, debug_synchronous
-    );
+    return detail::dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            return detail::scan_impl<true, config, typename decltype(arch_config)::type>(
+                temporary_storage, storage_size,
+                input, output, initial_value, size,
+                scan_op, stream, debug_synchronous
+            );
+        });
+#endif
 }
 
 /// @}
@@ -33,6 +33,7 @@
 #include "../functional.hpp"
 #include "../types/future_value.hpp"
 #include "../types/tuple.hpp"
+#include "device_trace.hpp"
 
 #include <hip/hip_runtime.h>
 
@@ -53,34 +54,31 @@ namespace detail
               typename InitialValueType,
               typename CompareFunction,
               typename BinaryFunction,
-              typename LookbackScanState,
-              typename ResultType>
-    void __global__ __launch_bounds__(Config::block_size) device_scan_by_key_kernel(
-        const KeyInputIterator                          keys,
-        const InputIterator                             values,
-        const OutputIterator                            output,
-        const InitialValueType                          initial_value,
-        const CompareFunction                           compare,
-        const BinaryFunction                            scan_op,
-        const LookbackScanState                         scan_state,
-        const size_t                                    size,
-        const size_t                                    starting_block,
-        const size_t                                    number_of_blocks,
-        const ordered_block_id<unsigned int>            ordered_bid,
-        const ::rocprim::tuple<ResultType, bool>* const previous_last_value)
+              typename LookbackScanState>
+    void __global__ __launch_bounds__(device_target_arch_config_t<Config>::block_size)
+        device_scan_by_key_kernel(
+        const KeyInputIterator                        keys,
+        const InputIterator                           values,
+        const OutputIterator                          output,
+        const InitialValueType                        initial_value,
+        const CompareFunction                         compare,
+        const BinaryFunction                          scan_op,
+        const LookbackScanState                       scan_state,
+        const size_t                                  size,
+        const size_t                                  number_of_tiles,
+        const ordered_block_id<lookback_tile_id_type> ordered_tile_id)
     {
-        device_scan_by_key_kernel_impl<Exclusive, Config>(keys,
-                                                          values,
-                                                          output,
-                                                          get_input_value(initial_value),
-                                                          compare,
-                                                          scan_op,
-                                                          scan_state,
-                                                          size,
-                                                          starting_block,
-                                                          number_of_blocks,
-                                                          ordered_bid,
-                                                          previous_last_value);
+        device_scan_by_key_kernel_impl<Exclusive, device_target_arch_config_t<Config>>(
+            keys,
+            values,
+            output,
+            get_input_value(initial_value),
+            compare,
+            scan_op,
+            scan_state,
+            size,
+            number_of_tiles,
+            ordered_tile_id);
     }
 
 #define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start)                           \
@@ -89,6 +87,7 @@ namespace detail
         auto _error = hipGetLastError();                                                         \
         if(_error != hipSuccess)                                                                 \
             return _error;                                                                       \
+        ::rocprim::detail::kernel_trace_end(name, size, stream);                                 \
         if(debug_synchronous)                                                                    \
         {                                                                                        \
             std::cout << name << "(" << size << ")";                                             \
@@ -103,6 +102,7 @@ namespace detail
 
     template <bool Exclusive,
               typename Config,
+              typename ArchConfig,
               typename KeysInputIterator,
               typename InputIterator,
               typename OutputIterator,
@@ -121,46 +121,33 @@ namespace detail
                                        const hipStream_t     stream,
                                        const bool            debug_synchronous)
     {
-        using config               = Config;
+        using config               = ArchConfig;
         using real_init_value_type = input_type_t<InitValueType>;
 
         using wrapped_type = ::rocprim::tuple<real_init_value_type, bool>;
 
         using scan_state_type            = detail::lookback_scan_state<wrapped_type>;
         using scan_state_with_sleep_type = detail::lookback_scan_state<wrapped_type, true>;
-        using ordered_block_id_type      = detail::ordered_block_id<unsigned int>;
+        using ordered_tile_id_type       = detail::ordered_block_id<lookback_tile_id_type>;
 
         constexpr unsigned int block_size       = config::block_size;
         constexpr unsigned int items_per_thread = config::items_per_thread;
         constexpr unsigned int items_per_block  = block_size * items_per_thread;
 
-        static constexpr unsigned int size_limit = config::size_limit;
-        static constexpr unsigned int aligned_size_limit
-            = std::max(size_limit - size_limit % items_per_block, items_per_block);
-
-        const unsigned int limited_size
-            = static_cast<unsigned int>(std::min<size_t>(size, aligned_size_limit));
-        const bool use_limited_size = limited_size == aligned_size_limit;
-
-        // Number of blocks in a single launch (or the only launch if it fits)
-        const unsigned int number_of_blocks = ceiling_div(limited_size, items_per_block);
+        const size_t number_of_tiles = ceiling_div(size, items_per_block);
 
         // Calculate required temporary storage, this is valid even with scan_state_with_sleep_type
         const size_t scan_state_bytes
-            = align_size(scan_state_type::get_storage_size(number_of_blocks));
+            = align_size(scan_state_type::get_storage_size(number_of_tiles));
         if(temporary_storage == nullptr)
         {
-            const size_t ordered_block_id_bytes
-                = align_size(ordered_block_id_type::get_storage_size(), alignof(wrapped_type));
-
             // storage_size is never zero
-            storage_size = scan_state_bytes + ordered_block_id_bytes
-                           + (use_limited_size ? sizeof(wrapped_type) : 0);
+            storage_size = scan_state_bytes + ordered_tile_id_type::get_storage_size();
 
             return hipSuccess;
         }
 
-        if(number_of_blocks == 0u)
+        if(number_of_tiles == 0u)
         {
             return hipSuccess;
         }
@@ -175,9 +162,9 @@ namespace detail
         // the value of use_sleep_scan_state
         auto with_scan_state
             = [use_sleep,
-               scan_state            = scan_state_type::create(temporary_storage, number_of_blocks),
+               scan_state            = scan_state_type::create(temporary_storage, number_of_tiles),
                scan_state_with_sleep = scan_state_with_sleep_type::create(
-                   temporary_storage, number_of_blocks)](auto&& func) mutable -> decltype(auto) {
+                   temporary_storage, number_of_tiles)](auto&& func) mutable -> decltype(auto) {
             if(use_sleep)
             {
                 return func(scan_state_with_sleep);
@@ -189,97 +176,69 @@ namespace detail
         };
 
         // Create and initialize ordered_block_id obj
-        auto* const ptr         = static_cast<char*>(temporary_storage);
-        const auto  ordered_bid = ordered_block_id_type::create(
-             reinterpret_cast<ordered_block_id_type::id_type*>(ptr + scan_state_bytes));
-
-        // The last element
-        auto* const previous_last_value
-            = use_limited_size
-                  ? reinterpret_cast<wrapped_type*>(ptr + storage_size - sizeof(wrapped_type))
-                  : nullptr;
-
-        // Total number of blocks in all launches
-        const auto   total_number_of_blocks = ceiling_div(size, items_per_block);
-        const size_t number_of_launch       = ceiling_div(size, limited_size);
-
+        auto* const ptr             = static_cast<char*>(temporary_storage);
+        const auto  ordered_tile_id = ordered_tile_id_type::create(
+            reinterpret_cast<ordered_tile_id_type::id_type*>(ptr + scan_state_bytes));
+
+        // All tiles are scanned by a single launch, with fewer blocks than tiles if the tiles
+        // would exceed config::size_limit items
+        const unsigned int init_grid_size = ceiling_div(number_of_tiles, block_size);
+        const unsigned int grid_size
+            = lookback_grid_size(number_of_tiles, items_per_block, config::size_limit);
+
+        // Start point for time measurements
+        std::chrono::high_resolution_clock::time_point start;
         if(debug_synchronous)
         {
             std::cout << "----------------------------------\n";
             std::cout << "size:               " << size << '\n';
-            std::cout << "aligned_size_limit: " << aligned_size_limit << '\n';
-            std::cout << "use_limited_size:   " << std::boolalpha << use_limited_size << '\n';
-            std::cout << "number_of_launch:   " << number_of_launch << '\n';
             std::cout << "block_size:         " << block_size << '\n';
             std::cout << "items_per_block:    " << items_per_block << '\n';
+            std::cout << "number of tiles:    " << number_of_tiles << '\n';
+            std::cout << "number of blocks:   " << grid_size << '\n';
             std::cout << "----------------------------------\n";
+
+            start = std::chrono::high_resolution_clock::now();
         }
 
-        for(size_t i = 0, offset = 0; i < number_of_launch; i++, offset += limited_size)
+        with_scan_state([&](const auto scan_state) {
+            hipLaunchKernelGGL(init_lookback_scan_state_kernel,
+                               dim3(init_grid_size),
+                               dim3(block_size),
+                               0,
+                               stream,
+                               scan_state,
+                               number_of_tiles,
+                               ordered_tile_id);
+        });
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(
+            "init_lookback_scan_state_kernel", number_of_tiles, start);
+
+        if(debug_synchronous)
         {
-            // limited_size is of type unsigned int, so current_size also fits in an unsigned int
-            // size_t is necessary as type of std::min because 'size - offset' can exceed the
-            // upper limit of unsigned int and converting it can lead to wrong results
-            const unsigned int current_size
-                = static_cast<unsigned int>(std::min<size_t>(size - offset, limited_size));
-            const unsigned int scan_blocks    = ceiling_div(current_size, items_per_block);
-            const unsigned int init_grid_size = ceiling_div(scan_blocks, block_size);
-
-            // Start point for time measurements
-            std::chrono::high_resolution_clock::time_point start;
-            if(debug_synchronous)
+            start = std::chrono::high_resolution_clock::now();
+        }
+        with_scan_state(
+            [&](auto& scan_state)
             {
-                std::cout << "index:            " << i << '\n';
-                std::cout << "current_size:     " << current_size << '\n';
-                std::cout << "number of blocks: " << scan_blocks << '\n';
-
-                start = std::chrono::high_resolution_clock::now();
-            }
-
-            with_scan_state([&](const auto scan_state) {
-                hipLaunchKernelGGL(init_lookback_scan_state_kernel,
-                                   dim3(init_grid_size),
-                                   dim3(block_size),
-                                   0,
-                                   stream,
-                                   scan_state,
-                                   scan_blocks,
-                                   ordered_bid,
-                                   number_of_blocks - 1,
-                                   i > 0 ? previous_last_value : nullptr);
+                hipLaunchKernelGGL(
+                    HIP_KERNEL_NAME(device_scan_by_key_kernel<Exclusive, Config>),
+                    dim3(grid_size),
+                    dim3(block_size),
+                    0,
+                    stream,
+                    keys,
+                    input,
+                    output,
+                    initial_value,
+                    compare,
+                    scan_op,
+                    scan_state,
+                    size,
+                    number_of_tiles,
+                    ordered_tile_id);
             });
-            ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(
-                "init_lookback_scan_state_kernel", scan_blocks, start);
-
-            if(debug_synchronous)
-            {
-                start = std::chrono::high_resolution_clock::now();
-            }
-            with_scan_state(
-                [&](auto& scan_state)
-                {
-                    hipLaunchKernelGGL(
-                        HIP_KERNEL_NAME(device_scan_by_key_kernel<Exclusive, config>),
-                        dim3(scan_blocks),
-                        dim3(block_size),
-                        0,
-                        stream,
-                        keys + offset,
-                        input + offset,
-                        output + offset,
-                        initial_value,
-                        compare,
-                        scan_op,
-                        scan_state,
-                        size,
-                        i * number_of_blocks,
-                        total_number_of_blocks,
-                        ordered_bid,
-                        i > 0 ? as_const_ptr(previous_last_value) : nullptr);
-                });
-            ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(
-                "device_scan_by_key_kernel", current_size, start);
-        }
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("device_scan_by_key_kernel", size, start);
         return hipSuccess;
     }
 
@@ -402,22 +361,26 @@ inline hipError_t inclusive_scan_by_key(void* const                temporary_sto
     using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
     using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
 
-    // Get default config if Config is default_config
-    using config = detail::default_or_custom_config<
-        Config,
-        detail::default_scan_by_key_config<ROCPRIM_TARGET_ARCH, key_type, value_type>>;
-
-    return detail::scan_by_key_impl<false, config>(temporary_storage,
-                                                   storage_size,
-                                                   keys_input,
-                                                   values_input,
-                                                   values_output,
-                                                   value_type(),
-                                                   size,
-                                                   scan_op,
-                                                   key_compare_op,
-                                                   stream,
-                                                   debug_synchronous);
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = detail::wrapped_scan_by_key_config<Config, key_type, value_type>;
+
+    return detail::dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            return detail::scan_by_key_impl<false, config, typename decltype(arch_config)::type>(
+                temporary_storage,
+                storage_size,
+                keys_input,
+                values_input,
+                values_output,
+                value_type(),
+                size,
+                scan_op,
+                key_compare_op,
+                stream,
+                debug_synchronous);
+        });
 }
 
 /// \brief Parallel exclusive scan-by-key primitive for device level.
@@ -539,23 +502,26 @@ inline hipError_t exclusive_scan_by_key(void* const                temporary_sto
     using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
     using real_init_value_type = detail::input_type_t<InitialValueType>;
 
-    // Get default config if Config is default_config
-    using config = detail::default_or_custom_config<
-        Config,
-        detail::default_scan_by_key_config<ROCPRIM_TARGET_ARCH, key_type, real_init_value_type>
-    >;
-
-    return detail::scan_by_key_impl<true, config>(temporary_storage,
-                                                  storage_size,
-                                                  keys_input,
-                                                  values_input,
-                                                  values_output,
-                                                  initial_value,
-                                                  size,
-                                                  scan_op,
-                                                  key_compare_op,
-                                                  stream,
-                                                  debug_synchronous);
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = detail::wrapped_scan_by_key_config<Config, key_type, real_init_value_type>;
+
+    return detail::dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            return detail::scan_by_key_impl<true, config, typename decltype(arch_config)::type>(
+                temporary_storage,
+                storage_size,
+                keys_input,
+                values_input,
+                values_output,
+                initial_value,
+                size,
+                scan_op,
+                key_compare_op,
+                stream,
+                debug_synchronous);
+        });
 }
 
 /// @}
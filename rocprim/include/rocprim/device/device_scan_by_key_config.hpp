@@ -119,6 +119,18 @@ struct default_scan_by_key_config
         scan_by_key_config_900<Key, Value>
     > { };
 
+// Config of inclusive_scan_by_key and exclusive_scan_by_key per target architecture.
+template<class Config, class Key, class Value>
+struct wrapped_scan_by_key_config
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        using type
+            = arch_config_t<Config, default_scan_by_key_config<static_cast<unsigned int>(Arch), Key, Value>>;
+    };
+};
+
 } // end namespace detail
 
 END_ROCPRIM_NAMESPACE
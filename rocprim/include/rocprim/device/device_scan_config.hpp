@@ -135,6 +135,18 @@ struct default_scan_config
         scan_config_900<Value>
     > { };
 
+// Config of inclusive_scan, exclusive_scan and the segmented scans per target architecture.
+template<class Config, class Value>
+struct wrapped_scan_config
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        using type
+            = arch_config_t<Config, default_scan_config<static_cast<unsigned int>(Arch), Value>>;
+    };
+};
+
 } // end namespace detail
 
 END_ROCPRIM_NAMESPACE
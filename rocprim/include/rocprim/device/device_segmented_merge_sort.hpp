@@ -0,0 +1,937 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_SEGMENTED_MERGE_SORT_HPP_
+#define ROCPRIM_DEVICE_DEVICE_SEGMENTED_MERGE_SORT_HPP_
+
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+#include "../functional.hpp"
+#include "../types.hpp"
+
+#include "../iterator/counting_iterator.hpp"
+#include "../iterator/reverse_iterator.hpp"
+#include "../iterator/transform_iterator.hpp"
+#include "detail/device_config_helper.hpp"
+#include "detail/device_segmented_merge_sort.hpp"
+#include "device_partition.hpp"
+#include "device_scan.hpp"
+#include "device_segmented_merge_sort_config.hpp"
+#include "device_trace.hpp"
+
+/// \addtogroup devicemodule
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+namespace detail
+{
+
+template<class Config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class SegmentCount,
+         class SegmentIndexIterator,
+         class OffsetIterator,
+         class BinaryFunction>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::warp_block_size) void segmented_merge_sort_small_kernel(
+    KeysInputIterator    keys_input,
+    KeysOutputIterator   keys_output,
+    ValuesInputIterator  values_input,
+    ValuesOutputIterator values_output,
+    SegmentCount         segment_count,
+    SegmentIndexIterator segment_indices,
+    OffsetIterator       begin_offsets,
+    OffsetIterator       end_offsets,
+    BinaryFunction       compare_function)
+{
+    segmented_merge_sort_small<device_target_arch_config_t<Config>>(keys_input,
+                                                                    keys_output,
+                                                                    values_input,
+                                                                    values_output,
+                                                                    segment_count,
+                                                                    segment_indices,
+                                                                    begin_offsets,
+                                                                    end_offsets,
+                                                                    compare_function);
+}
+
+template<class Config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class SegmentCount,
+         class SegmentIndexIterator,
+         class OffsetIterator,
+         class BinaryFunction>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::block_size) void segmented_merge_sort_medium_kernel(
+    KeysInputIterator    keys_input,
+    KeysOutputIterator   keys_output,
+    ValuesInputIterator  values_input,
+    ValuesOutputIterator values_output,
+    SegmentCount         segment_count,
+    SegmentIndexIterator segment_indices,
+    OffsetIterator       begin_offsets,
+    OffsetIterator       end_offsets,
+    BinaryFunction       compare_function)
+{
+    segmented_merge_sort_medium<device_target_arch_config_t<Config>>(keys_input,
+                                                                     keys_output,
+                                                                     values_input,
+                                                                     values_output,
+                                                                     segment_count,
+                                                                     segment_indices,
+                                                                     begin_offsets,
+                                                                     end_offsets,
+                                                                     compare_function);
+}
+
+template<class Config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class SegmentCount,
+         class SegmentIndexIterator,
+         class OffsetIterator,
+         class BinaryFunction>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::block_size) void segmented_merge_sort_large_tiles_kernel(
+    KeysInputIterator                                               keys_input,
+    typename std::iterator_traits<KeysInputIterator>::value_type*   keys_tmp,
+    KeysOutputIterator                                              keys_output,
+    ValuesInputIterator                                             values_input,
+    typename std::iterator_traits<ValuesInputIterator>::value_type* values_tmp,
+    ValuesOutputIterator                                            values_output,
+    const unsigned int*                                             tile_ends,
+    SegmentCount                                                    segment_count,
+    SegmentIndexIterator                                            segment_indices,
+    OffsetIterator                                                  begin_offsets,
+    OffsetIterator                                                  end_offsets,
+    BinaryFunction                                                  compare_function)
+{
+    segmented_merge_sort_large_tiles<device_target_arch_config_t<Config>>(keys_input,
+                                                                          keys_tmp,
+                                                                          keys_output,
+                                                                          values_input,
+                                                                          values_tmp,
+                                                                          values_output,
+                                                                          tile_ends,
+                                                                          segment_count,
+                                                                          segment_indices,
+                                                                          begin_offsets,
+                                                                          end_offsets,
+                                                                          compare_function);
+}
+
+template<class Config,
+         class KeysOutputIterator,
+         class ValuesOutputIterator,
+         class SegmentCount,
+         class SegmentIndexIterator,
+         class OffsetIterator,
+         class BinaryFunction>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::block_size) void segmented_merge_sort_large_merge_kernel(
+    typename std::iterator_traits<KeysOutputIterator>::value_type*   keys_tmp,
+    KeysOutputIterator                                               keys_output,
+    typename std::iterator_traits<ValuesOutputIterator>::value_type* values_tmp,
+    ValuesOutputIterator                                             values_output,
+    const unsigned int*                                              tile_ends,
+    SegmentCount                                                     segment_count,
+    SegmentIndexIterator                                             segment_indices,
+    OffsetIterator                                                   begin_offsets,
+    OffsetIterator                                                   end_offsets,
+    const unsigned int                                               sorted_size,
+    const unsigned int                                               pass,
+    BinaryFunction                                                   compare_function)
+{
+    segmented_merge_sort_large_merge<device_target_arch_config_t<Config>>(keys_tmp,
+                                                                          keys_output,
+                                                                          values_tmp,
+                                                                          values_output,
+                                                                          tile_ends,
+                                                                          segment_count,
+                                                                          segment_indices,
+                                                                          begin_offsets,
+                                                                          end_offsets,
+                                                                          sorted_size,
+                                                                          pass,
+                                                                          compare_function);
+}
+
+#define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start)                           \
+    {                                                                                            \
+        auto _error = hipGetLastError();                                                         \
+        if(_error != hipSuccess)                                                                 \
+            return _error;                                                                       \
+        ::rocprim::detail::kernel_trace_end(name, size, stream);                                 \
+        if(debug_synchronous)                                                                    \
+        {                                                                                        \
+            std::cout << name << "(" << size << ")";                                             \
+            auto __error = hipStreamSynchronize(stream);                                         \
+            if(__error != hipSuccess)                                                            \
+                return __error;                                                                  \
+            auto _end = std::chrono::high_resolution_clock::now();                               \
+            auto _d   = std::chrono::duration_cast<std::chrono::duration<double>>(_end - start); \
+            std::cout << " " << _d.count() * 1000 << " ms" << '\n';                             \
+        }                                                                                        \
+    }
+
+// Sorts segments longer than a tile with their tiles spread across the grid. The inclusive scan
+// of the numbers of tiles of the segments maps blocks to tiles, one kernel sorts the tiles and
+// one kernel per pass merges pairs of sorted runs. The segment count stays on the device, so the
+// grids are sized for the most tiles max_segment_count segments of size items can have.
+// Returns the storage of the scan in scan_storage_size if scan_temporary_storage is nullptr.
+template<class Config,
+         class ArchConfig,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class SegmentCount,
+         class SegmentIndexIterator,
+         class OffsetIterator,
+         class BinaryFunction>
+inline hipError_t segmented_merge_sort_large_segments(
+    void*                                                           scan_temporary_storage,
+    size_t&                                                         scan_storage_size,
+    unsigned int*                                                   tile_ends,
+    KeysInputIterator                                               keys_input,
+    typename std::iterator_traits<KeysInputIterator>::value_type*   keys_tmp,
+    KeysOutputIterator                                              keys_output,
+    ValuesInputIterator                                             values_input,
+    typename std::iterator_traits<ValuesInputIterator>::value_type* values_tmp,
+    ValuesOutputIterator                                            values_output,
+    const unsigned int                                              size,
+    const unsigned int                                              max_segment_count,
+    SegmentCount                                                    segment_count,
+    SegmentIndexIterator                                            segment_indices,
+    OffsetIterator                                                  begin_offsets,
+    OffsetIterator                                                  end_offsets,
+    BinaryFunction                                                  compare_function,
+    const hipStream_t                                               stream,
+    const bool                                                      debug_synchronous)
+{
+    using config = ArchConfig;
+
+    static constexpr unsigned int items_per_tile = config::block_size * config::items_per_thread;
+
+    using tile_count_op_type = segmented_merge_sort_tile_count_op<SegmentCount,
+                                                                  SegmentIndexIterator,
+                                                                  OffsetIterator>;
+    using tile_count_iterator_type
+        = transform_iterator<counting_iterator<unsigned int>, tile_count_op_type, unsigned int>;
+    const tile_count_iterator_type tile_counts(
+        counting_iterator<unsigned int>(0),
+        tile_count_op_type{segment_count, segment_indices, begin_offsets, end_offsets, items_per_tile});
+
+    hipError_t result = ::rocprim::inclusive_scan(scan_temporary_storage,
+                                                  scan_storage_size,
+                                                  tile_counts,
+                                                  tile_ends,
+                                                  max_segment_count,
+                                                  ::rocprim::plus<unsigned int>(),
+                                                  stream,
+                                                  debug_synchronous);
+    if(result != hipSuccess || scan_temporary_storage == nullptr)
+    {
+        return result;
+    }
+
+    // Every segment has at most one partial tile, and every tile has at least one item
+    const unsigned int max_tiles = ::rocprim::min(
+        size,
+        ::rocprim::detail::ceiling_div(size, items_per_tile) + max_segment_count);
+    if(max_tiles == 0)
+    {
+        return hipSuccess;
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+    if(debug_synchronous)
+        start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(segmented_merge_sort_large_tiles_kernel<Config>),
+                       dim3(max_tiles),
+                       dim3(config::block_size),
+                       0,
+                       stream,
+                       keys_input,
+                       keys_tmp,
+                       keys_output,
+                       values_input,
+                       values_tmp,
+                       values_output,
+                       tile_ends,
+                       segment_count,
+                       segment_indices,
+                       begin_offsets,
+                       end_offsets,
+                       compare_function);
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_merge_sort_large_tiles_kernel",
+                                                max_tiles,
+                                                start);
+
+    // No segment is longer than size, blocks of segments sorted in fewer passes exit
+    unsigned int pass = 0;
+    for(size_t sorted_size = items_per_tile; sorted_size < size; sorted_size *= 2, pass++)
+    {
+        if(debug_synchronous)
+            start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(segmented_merge_sort_large_merge_kernel<Config>),
+                           dim3(max_tiles),
+                           dim3(config::block_size),
+                           0,
+                           stream,
+                           keys_tmp,
+                           keys_output,
+                           values_tmp,
+                           values_output,
+                           tile_ends,
+                           segment_count,
+                           segment_indices,
+                           begin_offsets,
+                           end_offsets,
+                           static_cast<unsigned int>(sorted_size),
+                           pass,
+                           compare_function);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_merge_sort_large_merge_kernel",
+                                                    max_tiles,
+                                                    start);
+    }
+    return hipSuccess;
+}
+
+template<class Config,
+         class ArchConfig,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class OffsetIterator,
+         class BinaryFunction>
+inline hipError_t segmented_merge_sort_arch_impl(void*                temporary_storage,
+                                                 size_t&              storage_size,
+                                                 KeysInputIterator    keys_input,
+                                                 KeysOutputIterator   keys_output,
+                                                 ValuesInputIterator  values_input,
+                                                 ValuesOutputIterator values_output,
+                                                 const unsigned int   size,
+                                                 const unsigned int   segments,
+                                                 OffsetIterator       begin_offsets,
+                                                 OffsetIterator       end_offsets,
+                                                 BinaryFunction       compare_function,
+                                                 const hipStream_t    stream,
+                                                 const bool           debug_synchronous)
+{
+    using key_type               = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type             = typename std::iterator_traits<ValuesInputIterator>::value_type;
+    using segment_index_type     = unsigned int;
+    using segment_index_iterator = counting_iterator<segment_index_type>;
+
+    using config = ArchConfig;
+
+    static constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+    static constexpr unsigned int max_small_segment_length
+        = config::logical_warp_size * config::warp_items_per_thread;
+    static constexpr unsigned int small_segments_per_block
+        = config::warp_block_size / config::logical_warp_size;
+    static constexpr unsigned int max_medium_segment_length
+        = config::block_size * config::items_per_thread;
+    static_assert(
+        max_small_segment_length <= max_medium_segment_length,
+        "The max length of small segments cannot be higher than the max length of medium segments");
+
+    using segment_selector_type = segment_length_greater_op<OffsetIterator>;
+    const segment_selector_type large_segment_selector{begin_offsets,
+                                                       end_offsets,
+                                                       max_medium_segment_length};
+    const segment_selector_type medium_segment_selector{begin_offsets,
+                                                        end_offsets,
+                                                        max_small_segment_length};
+    ThreeWayPartitioner partitioner;
+
+    const bool do_partitioning = segments >= config::partitioning_threshold;
+
+    // Large segments are merged through the temporary buffers
+    const size_t keys_bytes = ::rocprim::detail::align_size(size * sizeof(key_type));
+    const size_t values_bytes
+        = with_values ? ::rocprim::detail::align_size(size * sizeof(value_type)) : 0;
+    const size_t segment_indices_bytes
+        = ::rocprim::detail::align_size(segments * sizeof(segment_index_type));
+    const size_t segment_count_output_bytes
+        = ::rocprim::detail::align_size(2 * sizeof(segment_index_type));
+    // Tiles of large segments are mapped to blocks by the scan of their numbers of tiles
+    const size_t tile_ends_bytes = ::rocprim::detail::align_size(segments * sizeof(unsigned int));
+
+    key_type*           keys_tmp{};
+    value_type*         values_tmp{};
+    segment_index_type* large_segment_indices_output{};
+    // The total number of large and small segments is not above the number of segments
+    // The same buffer is filled with the large and small indices from both directions
+    auto small_segment_indices_output
+        = make_reverse_iterator(large_segment_indices_output + segments);
+    segment_index_type* medium_segment_indices_output{};
+    segment_index_type* segment_count_output{};
+    unsigned int*       tile_ends{};
+    size_t              partition_storage_size{};
+    void*               partition_temporary_storage{};
+    size_t              scan_storage_size{};
+    void*               scan_temporary_storage{};
+
+    const auto sort_large_segments = [&](const unsigned int max_segment_count,
+                                         auto               segment_count,
+                                         auto               segment_indices)
+    {
+        return segmented_merge_sort_large_segments<Config, config>(scan_temporary_storage,
+                                                                   scan_storage_size,
+                                                                   tile_ends,
+                                                                   keys_input,
+                                                                   keys_tmp,
+                                                                   keys_output,
+                                                                   values_input,
+                                                                   values_tmp,
+                                                                   values_output,
+                                                                   size,
+                                                                   max_segment_count,
+                                                                   segment_count,
+                                                                   segment_indices,
+                                                                   begin_offsets,
+                                                                   end_offsets,
+                                                                   compare_function,
+                                                                   stream,
+                                                                   debug_synchronous);
+    };
+
+    // The storage of the scan of the numbers of tiles only depends on the number of segments,
+    // it is sized for all segments in both paths
+    const hipError_t scan_result = sort_large_segments(segments,
+                                                       segmented_merge_sort_segment_count{segments},
+                                                       segment_index_iterator{});
+    if(hipSuccess != scan_result)
+    {
+        return scan_result;
+    }
+    if(temporary_storage == nullptr)
+    {
+        storage_size = keys_bytes + values_bytes + tile_ends_bytes + scan_storage_size;
+        if(do_partitioning)
+        {
+            storage_size += 2 * segment_indices_bytes;
+            storage_size += segment_count_output_bytes;
+            const hipError_t partition_result = partitioner(partition_temporary_storage,
+                                                            partition_storage_size,
+                                                            segment_index_iterator{},
+                                                            large_segment_indices_output,
+                                                            medium_segment_indices_output,
+                                                            small_segment_indices_output,
+                                                            segment_count_output,
+                                                            segments,
+                                                            large_segment_selector,
+                                                            medium_segment_selector,
+                                                            stream,
+                                                            debug_synchronous);
+            if(hipSuccess != partition_result)
+            {
+                return partition_result;
+            }
+            storage_size += partition_storage_size;
+        }
+
+        // Make sure user won't try to allocate 0 bytes memory, otherwise
+        // user may again pass nullptr as temporary_storage
+        storage_size = storage_size == 0 ? 4 : storage_size;
+        return hipSuccess;
+    }
+    if(segments == 0u)
+    {
+        return hipSuccess;
+    }
+    if(debug_synchronous)
+    {
+        std::cout << "segments " << segments << '\n';
+        std::cout << "storage_size " << storage_size << '\n';
+        std::cout << "do_partitioning " << do_partitioning << '\n';
+        std::cout << "max_small_segment_length " << max_small_segment_length << '\n';
+        std::cout << "max_medium_segment_length " << max_medium_segment_length << '\n';
+        hipError_t error = hipStreamSynchronize(stream);
+        if(error != hipSuccess)
+            return error;
+    }
+
+    char* ptr = reinterpret_cast<char*>(temporary_storage);
+    keys_tmp  = reinterpret_cast<key_type*>(ptr);
+    ptr += keys_bytes;
+    values_tmp = with_values ? reinterpret_cast<value_type*>(ptr) : nullptr;
+    ptr += values_bytes;
+    tile_ends = reinterpret_cast<unsigned int*>(ptr);
+    ptr += tile_ends_bytes;
+    scan_temporary_storage = ptr;
+    ptr += scan_storage_size;
+
+    std::chrono::high_resolution_clock::time_point start;
+    if(!do_partitioning)
+    {
+        // Segments of any length are sorted with their tiles spread across the grid
+        return sort_large_segments(segments,
+                                   segmented_merge_sort_segment_count{segments},
+                                   segment_index_iterator{});
+    }
+
+    large_segment_indices_output = reinterpret_cast<segment_index_type*>(ptr);
+    ptr += segment_indices_bytes;
+    medium_segment_indices_output = reinterpret_cast<segment_index_type*>(ptr);
+    ptr += segment_indices_bytes;
+    small_segment_indices_output = make_reverse_iterator(large_segment_indices_output + segments);
+    segment_count_output         = reinterpret_cast<segment_index_type*>(ptr);
+    ptr += segment_count_output_bytes;
+    partition_temporary_storage = ptr;
+
+    hipError_t result = partitioner(partition_temporary_storage,
+                                    partition_storage_size,
+                                    segment_index_iterator{},
+                                    large_segment_indices_output,
+                                    medium_segment_indices_output,
+                                    small_segment_indices_output,
+                                    segment_count_output,
+                                    segments,
+                                    large_segment_selector,
+                                    medium_segment_selector,
+                                    stream,
+                                    debug_synchronous);
+    if(hipSuccess != result)
+    {
+        return result;
+    }
+    // The segment counts stay on the device: the kernels are launched with grids sized for
+    // the largest possible number of segments of their partition and the surplus blocks
+    // exit. Segments do not overlap, so a partition cannot have more segments than
+    // the number of items divided by the minimum length of its segments.
+    using partition_count_type = segment_partition_count<2>;
+    const partition_count_type large_segment_count{segment_count_output, 0, segments};
+    const partition_count_type medium_segment_count{segment_count_output, 1, segments};
+    const partition_count_type small_segment_count{segment_count_output, 2, segments};
+    const unsigned int         max_large_segment_count
+        = ::rocprim::min(segments, size / (max_medium_segment_length + 1));
+    const unsigned int max_medium_segment_count
+        = ::rocprim::min(segments, size / (max_small_segment_length + 1));
+    if(debug_synchronous)
+    {
+        segment_index_type segment_counts[2]{};
+        result = detail::memcpy_and_sync(&segment_counts,
+                                         segment_count_output,
+                                         sizeof(segment_counts),
+                                         hipMemcpyDeviceToHost,
+                                         stream);
+        if(hipSuccess != result)
+        {
+            return result;
+        }
+        std::cout << "large_segment_count " << segment_counts[0] << '\n';
+        std::cout << "medium_segment_count " << segment_counts[1] << '\n';
+        std::cout << "small_segment_count " << segments - segment_counts[0] - segment_counts[1]
+                  << '\n';
+    }
+
+    if(max_large_segment_count > 0)
+    {
+        result = sort_large_segments(max_large_segment_count,
+                                     large_segment_count,
+                                     large_segment_indices_output);
+        if(hipSuccess != result)
+        {
+            return result;
+        }
+    }
+    if(max_medium_segment_count > 0)
+    {
+        if(debug_synchronous)
+            start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(segmented_merge_sort_medium_kernel<Config>),
+                           dim3(max_medium_segment_count),
+                           dim3(config::block_size),
+                           0,
+                           stream,
+                           keys_input,
+                           keys_output,
+                           values_input,
+                           values_output,
+                           medium_segment_count,
+                           medium_segment_indices_output,
+                           begin_offsets,
+                           end_offsets,
+                           compare_function);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_merge_sort:medium_segments",
+                                                    max_medium_segment_count,
+                                                    start);
+    }
+    {
+        const auto small_segment_grid_size
+            = ::rocprim::detail::ceiling_div(segments, small_segments_per_block);
+        if(debug_synchronous)
+            start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(segmented_merge_sort_small_kernel<Config>),
+                           dim3(small_segment_grid_size),
+                           dim3(config::warp_block_size),
+                           0,
+                           stream,
+                           keys_input,
+                           keys_output,
+                           values_input,
+                           values_output,
+                           small_segment_count,
+                           small_segment_indices_output,
+                           begin_offsets,
+                           end_offsets,
+                           compare_function);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_merge_sort:small_segments",
+                                                    segments,
+                                                    start);
+    }
+    return hipSuccess;
+}
+
+template<class Config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class OffsetIterator,
+         class BinaryFunction>
+inline hipError_t segmented_merge_sort_impl(void*                temporary_storage,
+                                            size_t&              storage_size,
+                                            KeysInputIterator    keys_input,
+                                            KeysOutputIterator   keys_output,
+                                            ValuesInputIterator  values_input,
+                                            ValuesOutputIterator values_output,
+                                            const unsigned int   size,
+                                            const unsigned int   segments,
+                                            OffsetIterator       begin_offsets,
+                                            OffsetIterator       end_offsets,
+                                            BinaryFunction       compare_function,
+                                            const hipStream_t    stream,
+                                            const bool           debug_synchronous)
+{
+    using key_type   = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+
+    static_assert(
+        std::is_same<key_type, typename std::iterator_traits<KeysOutputIterator>::value_type>::value,
+        "KeysInputIterator and KeysOutputIterator must have the same value_type");
+    static_assert(
+        std::is_same<value_type,
+                     typename std::iterator_traits<ValuesOutputIterator>::value_type>::value,
+        "ValuesInputIterator and ValuesOutputIterator must have the same value_type");
+
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = wrapped_segmented_merge_sort_config<Config, key_type, value_type>;
+
+    return dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            return segmented_merge_sort_arch_impl<config, typename decltype(arch_config)::type>(
+                temporary_storage,
+                storage_size,
+                keys_input,
+                keys_output,
+                values_input,
+                values_output,
+                size,
+                segments,
+                begin_offsets,
+                end_offsets,
+                compare_function,
+                stream,
+                debug_synchronous);
+        });
+}
+
+#undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
+
+} // end namespace detail
+
+/// \brief Parallel segmented merge sort primitive for device level.
+///
+/// \p segmented_merge_sort_keys function performs a device-wide stable sort of multiple,
+/// non-overlapping sequences of keys using a comparison function. Unlike
+/// \p segmented_radix_sort_keys, keys can be of any type which \p compare_function orders.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the sorting function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * The sort is stable: equal keys of a segment keep their relative order.
+/// * Ranges specified by \p keys_input and \p keys_output must have at least \p size elements.
+/// * Ranges specified by \p begin_offsets and \p end_offsets must have
+/// at least \p segments elements. They may use the same sequence <tt>offsets</tt> of at least
+/// <tt>segments + 1</tt> elements: <tt>offsets</tt> for \p begin_offsets and
+/// <tt>offsets + 1</tt> for \p end_offsets.
+/// * Segments are partitioned by their lengths: small segments are sorted by logical warps,
+/// medium segments by blocks and large segments by blocks which merge their sorted tiles.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p segmented_merge_sort_config or a custom class with the same members.
+/// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam OffsetIterator - random-access iterator type of segment offsets. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam BinaryFunction - type of binary function used for sorting. Default type
+/// is \p rocprim::less<T>, where \p T is a \p value_type of \p KeysInputIterator.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the sort operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - pointer to the first element in the range to sort.
+/// \param [out] keys_output - pointer to the first element in the output range.
+/// \param [in] size - number of element in the input range.
+/// \param [in] segments - number of segments in the input range.
+/// \param [in] begin_offsets - iterator to the first element in the range of beginning offsets.
+/// \param [in] end_offsets - iterator to the first element in the range of ending offsets.
+/// \param [in] compare_function - binary operation function object that will be used for sorting.
+/// The signature of the function should be equivalent to the following:
+/// <tt>bool f(const T &a, const T &b);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the objects passed to it.
+/// The default value is \p BinaryFunction().
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful sort; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level descending sort is performed on segments of \p float values.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size;      // e.g., 8
+/// float * input;          // e.g., [0.6, 0.3, 0.65, 0.4, 0.2, 0.08, 1, 0.7]
+/// float * output;         // empty array of 8 elements
+/// unsigned int segments;  // e.g., 3
+/// int * offsets;          // e.g. [0, 2, 3, 8]
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::segmented_merge_sort_keys(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size,
+///     segments, offsets, offsets + 1, rocprim::greater<float>()
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // perform sort
+/// rocprim::segmented_merge_sort_keys(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size,
+///     segments, offsets, offsets + 1, rocprim::greater<float>()
+/// );
+/// // keys_output: [0.6, 0.3, 0.65, 1, 0.7, 0.4, 0.2, 0.08]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class OffsetIterator,
+         class BinaryFunction
+         = ::rocprim::less<typename std::iterator_traits<KeysInputIterator>::value_type>>
+inline hipError_t segmented_merge_sort_keys(void*              temporary_storage,
+                                            size_t&            storage_size,
+                                            KeysInputIterator  keys_input,
+                                            KeysOutputIterator keys_output,
+                                            unsigned int       size,
+                                            unsigned int       segments,
+                                            OffsetIterator     begin_offsets,
+                                            OffsetIterator     end_offsets,
+                                            BinaryFunction     compare_function = BinaryFunction(),
+                                            hipStream_t        stream           = 0,
+                                            bool               debug_synchronous = false)
+{
+    empty_type* values = nullptr;
+    return detail::segmented_merge_sort_impl<Config>(temporary_storage,
+                                                     storage_size,
+                                                     keys_input,
+                                                     keys_output,
+                                                     values,
+                                                     values,
+                                                     size,
+                                                     segments,
+                                                     begin_offsets,
+                                                     end_offsets,
+                                                     compare_function,
+                                                     stream,
+                                                     debug_synchronous);
+}
+
+/// \brief Parallel segmented merge sort-by-key primitive for device level.
+///
+/// \p segmented_merge_sort_pairs function performs a device-wide stable sort of multiple,
+/// non-overlapping sequences of (key, value) pairs using a comparison function of keys.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the sorting function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * The sort is stable: pairs with equal keys of a segment keep their relative order.
+/// * Ranges specified by \p keys_input, \p keys_output, \p values_input and \p values_output must
+/// have at least \p size elements.
+/// * Ranges specified by \p begin_offsets and \p end_offsets must have
+/// at least \p segments elements. They may use the same sequence <tt>offsets</tt> of at least
+/// <tt>segments + 1</tt> elements: <tt>offsets</tt> for \p begin_offsets and
+/// <tt>offsets + 1</tt> for \p end_offsets.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be
+/// \p segmented_merge_sort_config or a custom class with the same members.
+/// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam OffsetIterator - random-access iterator type of segment offsets. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam BinaryFunction - type of binary function used for sorting. Default type
+/// is \p rocprim::less<T>, where \p T is a \p value_type of \p KeysInputIterator.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the sort operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - pointer to the first element in the range to sort.
+/// \param [out] keys_output - pointer to the first element in the output range.
+/// \param [in] values_input - pointer to the first element in the range of values to sort.
+/// \param [out] values_output - pointer to the first element in the output range of values.
+/// \param [in] size - number of element in the input range.
+/// \param [in] segments - number of segments in the input range.
+/// \param [in] begin_offsets - iterator to the first element in the range of beginning offsets.
+/// \param [in] end_offsets - iterator to the first element in the range of ending offsets.
+/// \param [in] compare_function - binary operation function object that will be used for sorting.
+/// The signature of the function should be equivalent to the following:
+/// <tt>bool f(const T &a, const T &b);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the objects passed to it.
+/// The default value is \p BinaryFunction().
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful sort; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level ascending sort is performed on segments of integer keys
+/// with \p double values.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size;          // e.g., 8
+/// int * keys_input;           // e.g., [ 6, 3,  5, 4,  1,  8,  1, 7]
+/// double * values_input;      // e.g., [-5, 2, -4, 3, -1, -8, -2, 7]
+/// int * keys_output;          // empty array of 8 elements
+/// double * values_output;     // empty array of 8 elements
+/// unsigned int segments;      // e.g., 3
+/// int * offsets;              // e.g. [0, 2, 3, 8]
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::segmented_merge_sort_pairs(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     keys_input, keys_output, values_input, values_output,
+///     input_size,
+///     segments, offsets, offsets + 1
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // perform sort
+/// rocprim::segmented_merge_sort_pairs(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     keys_input, keys_output, values_input, values_output,
+///     input_size,
+///     segments, offsets, offsets + 1
+/// );
+/// // keys_output:   [3,  6,  5,  1,  1, 4, 7,  8]
+/// // values_output: [2, -5, -4, -1, -2, 3, 7, -8]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class OffsetIterator,
+         class BinaryFunction
+         = ::rocprim::less<typename std::iterator_traits<KeysInputIterator>::value_type>>
+inline hipError_t segmented_merge_sort_pairs(void*                temporary_storage,
+                                             size_t&              storage_size,
+                                             KeysInputIterator    keys_input,
+                                             KeysOutputIterator   keys_output,
+                                             ValuesInputIterator  values_input,
+                                             ValuesOutputIterator values_output,
+                                             unsigned int         size,
+                                             unsigned int         segments,
+                                             OffsetIterator       begin_offsets,
+                                             OffsetIterator       end_offsets,
+                                             BinaryFunction compare_function = BinaryFunction(),
+                                             hipStream_t    stream           = 0,
+                                             bool           debug_synchronous = false)
+{
+    return detail::segmented_merge_sort_impl<Config>(temporary_storage,
+                                                     storage_size,
+                                                     keys_input,
+                                                     keys_output,
+                                                     values_input,
+                                                     values_output,
+                                                     size,
+                                                     segments,
+                                                     begin_offsets,
+                                                     end_offsets,
+                                                     compare_function,
+                                                     stream,
+                                                     debug_synchronous);
+}
+
+END_ROCPRIM_NAMESPACE
+
+/// @}
+// end of group devicemodule
+
+#endif // ROCPRIM_DEVICE_DEVICE_SEGMENTED_MERGE_SORT_HPP_
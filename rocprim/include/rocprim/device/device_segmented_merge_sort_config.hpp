@@ -0,0 +1,116 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_SEGMENTED_MERGE_SORT_CONFIG_HPP_
+#define ROCPRIM_DEVICE_DEVICE_SEGMENTED_MERGE_SORT_CONFIG_HPP_
+
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+
+#include "config_types.hpp"
+
+/// \addtogroup primitivesmodule_deviceconfigs
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \brief Configuration of device-level segmented merge sort (\p segmented_merge_sort_keys and
+/// \p segmented_merge_sort_pairs).
+///
+/// Segments are partitioned by their lengths. Small segments (up to
+/// <tt>LogicalWarpSize * WarpItemsPerThread</tt> items) are sorted by logical warps, medium
+/// segments (up to <tt>BlockSize * ItemsPerThread</tt> items) by blocks, and the tiles of large
+/// segments are spread across the grid: a block sorts one tile, then merges one tile of each pass
+/// merging pairs of sorted runs.
+///
+/// \tparam LogicalWarpSize - number of threads of logical warps sorting small segments.
+/// \tparam WarpItemsPerThread - number of items processed by each thread of those warps.
+/// \tparam WarpBlockSize - number of threads in blocks of logical warps, must be a multiple of
+/// \p LogicalWarpSize.
+/// \tparam BlockSize - number of threads in blocks sorting medium and large segments.
+/// \tparam ItemsPerThread - number of items processed by each thread of those blocks.
+/// \tparam PartitioningThreshold - segments are only partitioned by their lengths if there are at
+/// least this many of them. Otherwise all segments are sorted like large segments.
+template<unsigned int LogicalWarpSize,
+         unsigned int WarpItemsPerThread,
+         unsigned int WarpBlockSize,
+         unsigned int BlockSize,
+         unsigned int ItemsPerThread,
+         unsigned int PartitioningThreshold = 256>
+struct segmented_merge_sort_config
+{
+    /// \brief Number of threads of logical warps sorting small segments.
+    static constexpr unsigned int logical_warp_size = LogicalWarpSize;
+    /// \brief Number of items processed by each thread of logical warps.
+    static constexpr unsigned int warp_items_per_thread = WarpItemsPerThread;
+    /// \brief Number of threads in blocks of logical warps.
+    static constexpr unsigned int warp_block_size = WarpBlockSize;
+    /// \brief Number of threads in blocks sorting medium and large segments.
+    static constexpr unsigned int block_size = BlockSize;
+    /// \brief Number of items processed by each thread of those blocks.
+    static constexpr unsigned int items_per_thread = ItemsPerThread;
+    /// \brief The smallest number of segments which are partitioned by their lengths.
+    static constexpr unsigned int partitioning_threshold = PartitioningThreshold;
+};
+
+namespace detail
+{
+
+template<class Key, class Value>
+struct segmented_merge_sort_config_fallback
+{
+    static constexpr unsigned int item_scale = ::rocprim::detail::ceiling_div<unsigned int>(
+        sizeof(Key) + sizeof(unsigned int) + sizeof(Value), 2 * sizeof(int));
+
+    using type = segmented_merge_sort_config<16,
+                                             ::rocprim::max(1u, 8u / item_scale),
+                                             256,
+                                             256,
+                                             ::rocprim::max(1u, 4u / item_scale)>;
+};
+
+template<unsigned int TargetArch, class Key, class Value>
+struct default_segmented_merge_sort_config
+    : select_arch<TargetArch, segmented_merge_sort_config_fallback<Key, Value>>
+{};
+
+// Config of segmented_merge_sort_keys and segmented_merge_sort_pairs per target architecture.
+template<class Config, class Key, class Value>
+struct wrapped_segmented_merge_sort_config
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        using type = arch_config_t<
+            Config,
+            default_segmented_merge_sort_config<static_cast<unsigned int>(Arch), Key, Value>>;
+    };
+};
+
+} // end namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+/// @}
+// end of group primitivesmodule_deviceconfigs
+
+#endif // ROCPRIM_DEVICE_DEVICE_SEGMENTED_MERGE_SORT_CONFIG_HPP_
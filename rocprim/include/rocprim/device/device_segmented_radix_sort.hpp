@@ -40,6 +40,7 @@
 #include "detail/device_segmented_radix_sort.hpp"
 #include "device_partition.hpp"
 #include "device_segmented_radix_sort_config.hpp"
+#include "device_trace.hpp"
 
 /// \addtogroup devicemodule
 /// @{
@@ -52,7 +53,6 @@ namespace detail
 template<
     class Config,
     bool Descending,
-    unsigned int BlockSize,
     class KeysInputIterator,
     class KeysOutputIterator,
     class ValuesInputIterator,
@@ -60,7 +60,7 @@ template<
     class OffsetIterator
 >
 ROCPRIM_KERNEL
-__launch_bounds__(BlockSize)
+__launch_bounds__(device_target_arch_config_t<Config>::sort::block_size)
 void segmented_sort_kernel(KeysInputIterator keys_input,
                            typename std::iterator_traits<KeysInputIterator>::value_type * keys_tmp,
                            KeysOutputIterator keys_output,
@@ -75,7 +75,7 @@ void segmented_sort_kernel(KeysInputIterator keys_input,
                            unsigned int begin_bit,
                            unsigned int end_bit)
 {
-    segmented_sort<Config, Descending>(
+    segmented_sort<device_target_arch_config_t<Config>, Descending>(
         keys_input, keys_tmp, keys_output, values_input, values_tmp, values_output,
         to_output,
         begin_offsets, end_offsets,
@@ -87,16 +87,16 @@ void segmented_sort_kernel(KeysInputIterator keys_input,
 template<
     class Config,
     bool Descending,
-    unsigned int BlockSize,
     class KeysInputIterator,
     class KeysOutputIterator,
     class ValuesInputIterator,
     class ValuesOutputIterator,
     class SegmentIndexIterator,
-    class OffsetIterator
+    class OffsetIterator,
+    class SegmentCount
 >
 ROCPRIM_KERNEL
-__launch_bounds__(BlockSize)
+__launch_bounds__(device_target_arch_config_t<Config>::sort::block_size)
 void segmented_sort_large_kernel(KeysInputIterator keys_input,
                                  typename std::iterator_traits<KeysInputIterator>::value_type * keys_tmp,
                                  KeysOutputIterator keys_output,
@@ -104,6 +104,7 @@ void segmented_sort_large_kernel(KeysInputIterator keys_input,
                                  typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
                                  ValuesOutputIterator values_output,
                                  bool to_output,
+                                 SegmentCount segment_count,
                                  SegmentIndexIterator segment_indices,
                                  OffsetIterator begin_offsets,
                                  OffsetIterator end_offsets,
@@ -112,9 +113,9 @@ void segmented_sort_large_kernel(KeysInputIterator keys_input,
                                  unsigned int begin_bit,
                                  unsigned int end_bit)
 {
-    segmented_sort_large<Config, Descending>(
+    segmented_sort_large<device_target_arch_config_t<Config>, Descending>(
         keys_input, keys_tmp, keys_output, values_input, values_tmp, values_output,
-        to_output, segment_indices,
+        to_output, segment_count, segment_indices,
         begin_offsets, end_offsets,
         long_iterations, short_iterations,
         begin_bit, end_bit
@@ -122,15 +123,18 @@ void segmented_sort_large_kernel(KeysInputIterator keys_input,
 }
 
 template<class Config,
-         bool         Descending,
-         unsigned int BlockSize,
+         bool Medium,
+         bool Descending,
          class KeysInputIterator,
          class KeysOutputIterator,
          class ValuesInputIterator,
          class ValuesOutputIterator,
          class SegmentIndexIterator,
-         class OffsetIterator>
-ROCPRIM_KERNEL __launch_bounds__(BlockSize) void segmented_sort_small_or_medium_kernel(
+         class OffsetIterator,
+         class SegmentCount>
+ROCPRIM_KERNEL __launch_bounds__(
+    select_warp_sort_helper_config_t<device_target_arch_config_t<Config>, Medium>::block_size)
+void segmented_sort_small_or_medium_kernel(
     KeysInputIterator                                               keys_input,
     typename std::iterator_traits<KeysInputIterator>::value_type*   keys_tmp,
     KeysOutputIterator                                              keys_output,
@@ -138,16 +142,18 @@ ROCPRIM_KERNEL __launch_bounds__(BlockSize) void segmented_sort_small_or_medium_
     typename std::iterator_traits<ValuesInputIterator>::value_type* values_tmp,
     ValuesOutputIterator                                            values_output,
     bool                                                            to_output,
-    unsigned int                                                    num_segments,
+    SegmentCount                                                    segment_count,
     SegmentIndexIterator                                            segment_indices,
     OffsetIterator                                                  begin_offsets,
     OffsetIterator                                                  end_offsets,
     unsigned int                                                    begin_bit,
     unsigned int                                                    end_bit)
 {
-    segmented_sort_small<Config, Descending>(
+    segmented_sort_small<
+        select_warp_sort_helper_config_t<device_target_arch_config_t<Config>, Medium>,
+        Descending>(
         keys_input, keys_tmp, keys_output, values_input, values_tmp, values_output,
-        to_output, num_segments, segment_indices,
+        to_output, segment_count, segment_indices,
         begin_offsets, end_offsets,
         begin_bit, end_bit
     );
@@ -157,6 +163,7 @@ ROCPRIM_KERNEL __launch_bounds__(BlockSize) void segmented_sort_small_or_medium_
     { \
         auto _error = hipGetLastError(); \
         if(_error != hipSuccess) return _error; \
+        ::rocprim::detail::kernel_trace_end(name, size, stream); \
         if(debug_synchronous) \
         { \
             std::cout << name << "(" << size << ")"; \
@@ -168,79 +175,9 @@ ROCPRIM_KERNEL __launch_bounds__(BlockSize) void segmented_sort_small_or_medium_
         } \
     }
 
-struct TwoWayPartitioner
-{
-    template<typename InputIterator,
-             typename FirstOutputIterator,
-             typename SecondOutputIterator,
-             typename UnselectedOutputIterator,
-             typename SelectedCountOutputIterator,
-             typename FirstUnaryPredicate,
-             typename SecondUnaryPredicate>
-    hipError_t operator()(void*               temporary_storage,
-                          size_t&             storage_size,
-                          InputIterator       input,
-                          FirstOutputIterator output_first_part,
-                          SecondOutputIterator /*output_second_part*/,
-                          UnselectedOutputIterator /*output_unselected*/,
-                          SelectedCountOutputIterator selected_count_output,
-                          const size_t                size,
-                          FirstUnaryPredicate         select_first_part_op,
-                          SecondUnaryPredicate /*select_second_part_op*/,
-                          const hipStream_t stream,
-                          const bool        debug_synchronous)
-    {
-        return partition(temporary_storage,
-                         storage_size,
-                         input,
-                         output_first_part,
-                         selected_count_output,
-                         size,
-                         select_first_part_op,
-                         stream,
-                         debug_synchronous);
-    }
-};
-
-struct ThreeWayPartitioner
-{
-    template<typename InputIterator,
-             typename FirstOutputIterator,
-             typename SecondOutputIterator,
-             typename UnselectedOutputIterator,
-             typename SelectedCountOutputIterator,
-             typename FirstUnaryPredicate,
-             typename SecondUnaryPredicate>
-    hipError_t operator()(void*                       temporary_storage,
-                          size_t&                     storage_size,
-                          InputIterator               input,
-                          FirstOutputIterator         output_first_part,
-                          SecondOutputIterator        output_second_part,
-                          UnselectedOutputIterator    output_unselected,
-                          SelectedCountOutputIterator selected_count_output,
-                          const size_t                size,
-                          FirstUnaryPredicate         select_first_part_op,
-                          SecondUnaryPredicate        select_second_part_op,
-                          const hipStream_t           stream,
-                          const bool                  debug_synchronous)
-    {
-        return partition_three_way(temporary_storage,
-                                   storage_size,
-                                   input,
-                                   output_first_part,
-                                   output_second_part,
-                                   output_unselected,
-                                   selected_count_output,
-                                   size,
-                                   select_first_part_op,
-                                   select_second_part_op,
-                                   stream,
-                                   debug_synchronous);
-    }
-};
-
 template<
     class Config,
+    class ArchConfig,
     bool Descending,
     class KeysInputIterator,
     class KeysOutputIterator,
@@ -249,23 +186,23 @@ template<
     class OffsetIterator
 >
 inline
-hipError_t segmented_radix_sort_impl(void * temporary_storage,
-                                     size_t& storage_size,
-                                     KeysInputIterator keys_input,
-                                     typename std::iterator_traits<KeysInputIterator>::value_type * keys_tmp,
-                                     KeysOutputIterator keys_output,
-                                     ValuesInputIterator values_input,
-                                     typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
-                                     ValuesOutputIterator values_output,
-                                     unsigned int size,
-                                     bool& is_result_in_output,
-                                     unsigned int segments,
-                                     OffsetIterator begin_offsets,
-                                     OffsetIterator end_offsets,
-                                     unsigned int begin_bit,
-                                     unsigned int end_bit,
-                                     hipStream_t stream,
-                                     bool debug_synchronous)
+hipError_t segmented_radix_sort_arch_impl(void * temporary_storage,
+                                          size_t& storage_size,
+                                          KeysInputIterator keys_input,
+                                          typename std::iterator_traits<KeysInputIterator>::value_type * keys_tmp,
+                                          KeysOutputIterator keys_output,
+                                          ValuesInputIterator values_input,
+                                          typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
+                                          ValuesOutputIterator values_output,
+                                          unsigned int size,
+                                          bool& is_result_in_output,
+                                          unsigned int segments,
+                                          OffsetIterator begin_offsets,
+                                          OffsetIterator end_offsets,
+                                          unsigned int begin_bit,
+                                          unsigned int end_bit,
+                                          hipStream_t stream,
+                                          bool debug_synchronous)
 {
     using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
     using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
@@ -281,10 +218,7 @@ hipError_t segmented_radix_sort_impl(void * temporary_storage,
         "ValuesInputIterator and ValuesOutputIterator must have the same value_type"
     );
 
-    using config = default_or_custom_config<
-        Config,
-        default_segmented_radix_sort_config<ROCPRIM_TARGET_ARCH, key_type, value_type>
-    >;
+    using config = ArchConfig;
 
     static constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
     static constexpr bool partitioning_allowed =
@@ -311,17 +245,13 @@ hipError_t segmented_radix_sort_impl(void * temporary_storage,
         = std::conditional_t<three_way_partitioning, ThreeWayPartitioner, TwoWayPartitioner>;
     partitioner_type partitioner;
 
-    const auto large_segment_selector = [=](const unsigned int segment_index) mutable -> bool
-    {
-        const unsigned int segment_length
-            = end_offsets[segment_index] - begin_offsets[segment_index];
-        return segment_length > max_medium_segment_length;
-    };
-    const auto medium_segment_selector = [=](const unsigned int segment_index) mutable -> bool
-    {
-        const unsigned int segment_length = end_offsets[segment_index] - begin_offsets[segment_index];
-        return segment_length > max_small_segment_length;
-    };
+    using segment_selector_type = segment_length_greater_op<OffsetIterator>;
+    const segment_selector_type large_segment_selector{begin_offsets,
+                                                       end_offsets,
+                                                       max_medium_segment_length};
+    const segment_selector_type medium_segment_selector{begin_offsets,
+                                                        end_offsets,
+                                                        max_small_segment_length};
 
     const bool with_double_buffer = keys_tmp != nullptr;
     const unsigned int bits = end_bit - begin_bit;
@@ -447,55 +377,79 @@ hipError_t segmented_radix_sort_impl(void * temporary_storage,
         {
             return result;
         }
-        segment_index_type segment_counts[segment_count_output_size]{};
-        result = detail::memcpy_and_sync(&segment_counts,
-                                         segment_count_output,
-                                         segment_count_output_bytes,
-                                         hipMemcpyDeviceToHost,
-                                         stream);
-        if(hipSuccess != result)
-        {
-            return result;
-        }
-        const auto large_segment_count  = segment_counts[0];
-        const auto medium_segment_count = three_way_partitioning ? segment_counts[1] : 0;
-        const auto small_segment_count  = segments - large_segment_count - medium_segment_count;
+        // The segment counts stay on the device: the kernels are launched with grids sized for
+        // the largest possible number of segments of their partition and the surplus blocks
+        // exit. Segments do not overlap, so a partition cannot have more segments than
+        // the number of items divided by the minimum length of its segments.
+        using partition_count_type = segment_partition_count<segment_count_output_size>;
+        const partition_count_type large_segment_count{segment_count_output, 0, segments};
+        const partition_count_type medium_segment_count{segment_count_output, 1, segments};
+        const partition_count_type small_segment_count{segment_count_output,
+                                                       segment_count_output_size,
+                                                       segments};
+        const unsigned int max_large_segment_count
+            = ::rocprim::min(segments, size / (max_medium_segment_length + 1));
+        const unsigned int max_medium_segment_count
+            = three_way_partitioning
+                  ? ::rocprim::min(segments, size / (max_small_segment_length + 1))
+                  : 0;
         if(debug_synchronous)
         {
-            std::cout << "large_segment_count " << large_segment_count << '\n';
-            std::cout << "medium_segment_count " << medium_segment_count << '\n';
-            std::cout << "small_segment_count " << small_segment_count << '\n';
+            segment_index_type segment_counts[segment_count_output_size]{};
+            result = detail::memcpy_and_sync(&segment_counts,
+                                             segment_count_output,
+                                             sizeof(segment_counts),
+                                             hipMemcpyDeviceToHost,
+                                             stream);
+            if(hipSuccess != result)
+            {
+                return result;
+            }
+            const auto large_count  = segment_counts[0];
+            const auto medium_count = three_way_partitioning ? segment_counts[1] : 0;
+            std::cout << "large_segment_count " << large_count << '\n';
+            std::cout << "medium_segment_count " << medium_count << '\n';
+            std::cout << "small_segment_count " << segments - large_count - medium_count << '\n';
         }
-        if(large_segment_count > 0)
+        if(max_large_segment_count > 0)
         {
             std::chrono::high_resolution_clock::time_point start;
+            kernel_trace_begin(stream,
+                               dim3(max_large_segment_count),
+                               dim3(config::sort::block_size),
+                               config::sort::items_per_thread,
+                               0,
+                               0);
             if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
             hipLaunchKernelGGL(
-                HIP_KERNEL_NAME(segmented_sort_large_kernel<config, Descending, config::sort::block_size>),
-                dim3(large_segment_count), dim3(config::sort::block_size), 0, stream,
+                HIP_KERNEL_NAME(segmented_sort_large_kernel<Config, Descending>),
+                dim3(max_large_segment_count), dim3(config::sort::block_size), 0, stream,
                 keys_input, keys_tmp, keys_output, values_input, values_tmp, values_output,
-                to_output, large_segment_indices_output,
+                to_output, large_segment_count, large_segment_indices_output,
                 begin_offsets, end_offsets,
                 long_iterations, short_iterations,
                 begin_bit, end_bit
             );
             ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_sort:large_segments",
-                                                        large_segment_count,
+                                                        max_large_segment_count,
                                                         start)
         }
-        if(three_way_partitioning && medium_segment_count > 0)
+        if(three_way_partitioning && max_medium_segment_count > 0)
         {
             const auto medium_segment_grid_size
-                = ::rocprim::detail::ceiling_div(medium_segment_count, medium_segments_per_block);
+                = ::rocprim::detail::ceiling_div(max_medium_segment_count, medium_segments_per_block);
             std::chrono::high_resolution_clock::time_point start;
+            kernel_trace_begin(stream,
+                               dim3(medium_segment_grid_size),
+                               dim3(config::warp_sort_config::block_size_medium),
+                               config::warp_sort_config::items_per_thread_medium,
+                               0,
+                               0);
             if(debug_synchronous)
                 start = std::chrono::high_resolution_clock::now();
             hipLaunchKernelGGL(
                 HIP_KERNEL_NAME(
-                    segmented_sort_small_or_medium_kernel<
-                        select_warp_sort_helper_config_medium_t<typename config::warp_sort_config>,
-                        Descending,
-                        config::warp_sort_config::block_size_medium>),
+                    segmented_sort_small_or_medium_kernel<Config, true, Descending>),
                 dim3(medium_segment_grid_size),
                 dim3(config::warp_sort_config::block_size_medium),
                 0,
@@ -514,21 +468,23 @@ hipError_t segmented_radix_sort_impl(void * temporary_storage,
                 begin_bit,
                 end_bit);
             ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_sort:medium_segments",
-                                                        medium_segment_count,
+                                                        max_medium_segment_count,
                                                         start)
         }
-        if(small_segment_count > 0)
         {
-            const auto small_segment_grid_size = ::rocprim::detail::ceiling_div(small_segment_count,
+            const auto small_segment_grid_size = ::rocprim::detail::ceiling_div(segments,
                                                                                 small_segments_per_block);
             std::chrono::high_resolution_clock::time_point start;
+            kernel_trace_begin(stream,
+                               dim3(small_segment_grid_size),
+                               dim3(config::warp_sort_config::block_size_small),
+                               config::warp_sort_config::items_per_thread_small,
+                               0,
+                               0);
             if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
             hipLaunchKernelGGL(
                 HIP_KERNEL_NAME(
-                    segmented_sort_small_or_medium_kernel<
-                        select_warp_sort_helper_config_small_t<typename config::warp_sort_config>,
-                        Descending,
-                        config::warp_sort_config::block_size_small>),
+                    segmented_sort_small_or_medium_kernel<Config, false, Descending>),
                 dim3(small_segment_grid_size),
                 dim3(config::warp_sort_config::block_size_small),
                 0,
@@ -547,16 +503,22 @@ hipError_t segmented_radix_sort_impl(void * temporary_storage,
                 begin_bit,
                 end_bit);
             ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_sort:small_segments",
-                                                        small_segment_count,
+                                                        segments,
                                                         start)
         }
     }
     else
     {
         std::chrono::high_resolution_clock::time_point start;
+        kernel_trace_begin(stream,
+                           dim3(segments),
+                           dim3(config::sort::block_size),
+                           config::sort::items_per_thread,
+                           0,
+                           0);
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
         hipLaunchKernelGGL(
-            HIP_KERNEL_NAME(segmented_sort_kernel<config, Descending, config::sort::block_size>),
+            HIP_KERNEL_NAME(segmented_sort_kernel<Config, Descending>),
             dim3(segments), dim3(config::sort::block_size), 0, stream,
             keys_input, keys_tmp, keys_output, values_input, values_tmp, values_output,
             to_output,
@@ -569,6 +531,67 @@ hipError_t segmented_radix_sort_impl(void * temporary_storage,
     return hipSuccess;
 }
 
+template<
+    class Config,
+    bool Descending,
+    class KeysInputIterator,
+    class KeysOutputIterator,
+    class ValuesInputIterator,
+    class ValuesOutputIterator,
+    class OffsetIterator
+>
+inline
+hipError_t segmented_radix_sort_impl(void * temporary_storage,
+                                     size_t& storage_size,
+                                     KeysInputIterator keys_input,
+                                     typename std::iterator_traits<KeysInputIterator>::value_type * keys_tmp,
+                                     KeysOutputIterator keys_output,
+                                     ValuesInputIterator values_input,
+                                     typename std::iterator_traits<ValuesInputIterator>::value_type * values_tmp,
+                                     ValuesOutputIterator values_output,
+                                     unsigned int size,
+                                     bool& is_result_in_output,
+                                     unsigned int segments,
+                                     OffsetIterator begin_offsets,
+                                     OffsetIterator end_offsets,
+                                     unsigned int begin_bit,
+                                     unsigned int end_bit,
+                                     hipStream_t stream,
+                                     bool debug_synchronous)
+{
+    using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = wrapped_segmented_radix_sort_config<Config, key_type, value_type>;
+
+    return dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            return segmented_radix_sort_arch_impl<config,
+                                                  typename decltype(arch_config)::type,
+                                                  Descending>(
+                temporary_storage,
+                storage_size,
+                keys_input,
+                keys_tmp,
+                keys_output,
+                values_input,
+                values_tmp,
+                values_output,
+                size,
+                is_result_in_output,
+                segments,
+                begin_offsets,
+                end_offsets,
+                begin_bit,
+                end_bit,
+                stream,
+                debug_synchronous);
+        });
+}
+
 #undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
 
 } // end namespace detail
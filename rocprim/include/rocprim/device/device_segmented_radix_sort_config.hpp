@@ -353,6 +353,18 @@ struct default_segmented_radix_sort_config
           detail::segmented_radix_sort_config_900<Key, Value>>
 {};
 
+// Config of segmented_radix_sort_keys and segmented_radix_sort_pairs per target architecture.
+template<class Config, class Key, class Value>
+struct wrapped_segmented_radix_sort_config
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        using type
+            = arch_config_t<Config, default_segmented_radix_sort_config<static_cast<unsigned int>(Arch), Key, Value>>;
+    };
+};
+
 } // end namespace detail
 
 END_ROCPRIM_NAMESPACE
@@ -25,14 +25,19 @@
 #include <iterator>
 #include <type_traits>
 
+#include "device_partition.hpp"
 #include "device_reduce_config.hpp"
+#include "device_segmented_reduce_config.hpp"
 
 #include "../config.hpp"
 #include "../functional.hpp"
 #include "../detail/various.hpp"
 #include "../detail/match_result_type.hpp"
+#include "../iterator/counting_iterator.hpp"
+#include "../iterator/reverse_iterator.hpp"
 
 #include "detail/device_segmented_reduce.hpp"
+#include "device_trace.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -58,6 +63,67 @@ ROCPRIM_KERNEL __launch_bounds__(device_params<Config>().block_size) void segmen
 {
     segmented_reduce<Config>(
         input, output,
+        ::rocprim::detail::block_id<0>(),
+        begin_offsets, end_offsets,
+        reduce_op, initial_value
+    );
+}
+
+template<class Config,
+         class InputIterator,
+         class OutputIterator,
+         class SegmentCount,
+         class SegmentIndexIterator,
+         class OffsetIterator,
+         class ResultType,
+         class BinaryFunction>
+ROCPRIM_KERNEL __launch_bounds__(device_params<Config>().block_size) void segmented_reduce_large_kernel(
+    InputIterator        input,
+    OutputIterator       output,
+    SegmentCount         segment_count,
+    SegmentIndexIterator segment_indices,
+    OffsetIterator       begin_offsets,
+    OffsetIterator       end_offsets,
+    BinaryFunction       reduce_op,
+    ResultType           initial_value)
+{
+    // The grid is sized for the worst case, the surplus blocks exit
+    const unsigned int block_id = ::rocprim::detail::block_id<0>();
+    if(block_id >= segment_count())
+    {
+        return;
+    }
+    segmented_reduce<Config>(
+        input, output,
+        segment_indices[block_id],
+        begin_offsets, end_offsets,
+        reduce_op, initial_value
+    );
+}
+
+template<unsigned int LogicalWarpSize,
+         unsigned int ItemsPerThread,
+         unsigned int BlockSize,
+         class InputIterator,
+         class OutputIterator,
+         class SegmentCount,
+         class SegmentIndexIterator,
+         class OffsetIterator,
+         class ResultType,
+         class BinaryFunction>
+ROCPRIM_KERNEL __launch_bounds__(BlockSize) void segmented_reduce_small_or_medium_kernel(
+    InputIterator        input,
+    OutputIterator       output,
+    SegmentCount         segment_count,
+    SegmentIndexIterator segment_indices,
+    OffsetIterator       begin_offsets,
+    OffsetIterator       end_offsets,
+    BinaryFunction       reduce_op,
+    ResultType           initial_value)
+{
+    segmented_warp_reduce<LogicalWarpSize, ItemsPerThread, BlockSize>(
+        input, output,
+        segment_count(), segment_indices,
         begin_offsets, end_offsets,
         reduce_op, initial_value
     );
@@ -67,6 +133,7 @@ ROCPRIM_KERNEL __launch_bounds__(device_params<Config>().block_size) void segmen
     { \
         auto _error = hipGetLastError(); \
         if(_error != hipSuccess) return _error; \
+        ::rocprim::detail::kernel_trace_end(name, size, stream); \
         if(debug_synchronous) \
         { \
             std::cout << name << "(" << size << ")"; \
@@ -104,7 +171,48 @@ hipError_t segmented_reduce_impl(void * temporary_storage,
         input_type, BinaryFunction
     >::type;
 
-    using config = wrapped_reduce_config<Config, result_type>;
+    using segment_index_type = unsigned int;
+    using segment_index_iterator = counting_iterator<segment_index_type>;
+
+    using config_parts = segmented_reduce_config_parts<Config, result_type>;
+    using config = wrapped_reduce_config<typename config_parts::reduce, result_type>;
+    using warp_reduce_config = typename config_parts::warp_reduce_config;
+
+    static constexpr bool partitioning_allowed =
+        !std::is_same<warp_reduce_config, DisabledWarpReduceConfig>::value;
+    static constexpr unsigned int max_small_segment_length
+        = warp_reduce_config::items_per_thread_small
+          * warp_reduce_config::logical_warp_size_small;
+    static constexpr unsigned int small_segments_per_block
+        = warp_reduce_config::block_size_small
+          / warp_reduce_config::logical_warp_size_small;
+    static constexpr unsigned int max_medium_segment_length
+        = warp_reduce_config::items_per_thread_medium
+          * warp_reduce_config::logical_warp_size_medium;
+    static constexpr unsigned int medium_segments_per_block
+        = warp_reduce_config::block_size_medium
+          / warp_reduce_config::logical_warp_size_medium;
+    static_assert(
+        max_small_segment_length <= max_medium_segment_length,
+        "The max length of small segments cannot be higher than the max length of medium segments");
+    // Don't waste cycles on 3-way partitioning, if the small and medium segments are equal length
+    static constexpr bool three_way_partitioning
+        = max_small_segment_length < max_medium_segment_length;
+    using partitioner_type
+        = std::conditional_t<three_way_partitioning, ThreeWayPartitioner, TwoWayPartitioner>;
+    partitioner_type partitioner;
+
+    const auto large_segment_selector = [=](const unsigned int segment_index) mutable -> bool
+    {
+        const unsigned int segment_length
+            = end_offsets[segment_index] - begin_offsets[segment_index];
+        return segment_length > max_medium_segment_length;
+    };
+    const auto medium_segment_selector = [=](const unsigned int segment_index) mutable -> bool
+    {
+        const unsigned int segment_length = end_offsets[segment_index] - begin_offsets[segment_index];
+        return segment_length > max_small_segment_length;
+    };
 
     detail::target_arch target_arch;
     hipError_t          result = host_target_arch(stream, target_arch);
@@ -116,11 +224,58 @@ hipError_t segmented_reduce_impl(void * temporary_storage,
 
     const unsigned int block_size = params.block_size;
 
+    const bool do_partitioning = partitioning_allowed
+        && segments >= warp_reduce_config::partitioning_threshold;
+
+    const size_t large_and_small_segment_indices_bytes
+        = ::rocprim::detail::align_size(segments * sizeof(segment_index_type));
+    const size_t medium_segment_indices_bytes
+        = three_way_partitioning
+              ? ::rocprim::detail::align_size(segments * sizeof(segment_index_type))
+              : 0;
+    static constexpr size_t segment_count_output_size = three_way_partitioning ? 2 : 1;
+    const size_t            segment_count_output_bytes
+        = ::rocprim::detail::align_size(segment_count_output_size * sizeof(segment_index_type));
+
+    segment_index_type* large_segment_indices_output{};
+    // The total number of large and small segments is not above the number of segments
+    // The same buffer is filled with the large and small indices from both directions
+    auto small_segment_indices_output
+        = make_reverse_iterator(large_segment_indices_output + segments);
+    segment_index_type* medium_segment_indices_output{};
+    segment_index_type* segment_count_output{};
+    size_t              partition_storage_size{};
+    void*               partition_temporary_storage{};
     if(temporary_storage == nullptr)
     {
+        storage_size = 0;
+        if(do_partitioning)
+        {
+            storage_size += large_and_small_segment_indices_bytes;
+            storage_size += medium_segment_indices_bytes;
+            storage_size += segment_count_output_bytes;
+            const auto partition_result = partitioner(partition_temporary_storage,
+                                                      partition_storage_size,
+                                                      segment_index_iterator{},
+                                                      large_segment_indices_output,
+                                                      medium_segment_indices_output,
+                                                      small_segment_indices_output,
+                                                      segment_count_output,
+                                                      segments,
+                                                      large_segment_selector,
+                                                      medium_segment_selector,
+                                                      stream,
+                                                      debug_synchronous);
+            if(hipSuccess != partition_result)
+            {
+                return partition_result;
+            }
+            storage_size += partition_storage_size;
+        }
+
         // Make sure user won't try to allocate 0 bytes memory, because
         // hipMalloc will return nullptr when size is zero.
-        storage_size = 4;
+        storage_size = storage_size == 0 ? 4 : storage_size;
         return hipSuccess;
     }
 
@@ -129,15 +284,131 @@ hipError_t segmented_reduce_impl(void * temporary_storage,
 
     std::chrono::high_resolution_clock::time_point start;
 
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    hipLaunchKernelGGL(
-        HIP_KERNEL_NAME(segmented_reduce_kernel<config>),
-        dim3(segments), dim3(block_size), 0, stream,
-        input, output,
-        begin_offsets, end_offsets,
-        reduce_op, static_cast<result_type>(initial_value)
-    );
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_reduce", segments, start);
+    if(!do_partitioning)
+    {
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(segmented_reduce_kernel<config>),
+            dim3(segments), dim3(block_size), 0, stream,
+            input, output,
+            begin_offsets, end_offsets,
+            reduce_op, static_cast<result_type>(initial_value)
+        );
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_reduce", segments, start);
+
+        return hipSuccess;
+    }
+
+    char* ptr = reinterpret_cast<char*>(temporary_storage);
+    large_segment_indices_output = reinterpret_cast<segment_index_type*>(ptr);
+    ptr += large_and_small_segment_indices_bytes;
+    medium_segment_indices_output = reinterpret_cast<segment_index_type*>(ptr);
+    ptr += medium_segment_indices_bytes;
+    small_segment_indices_output = make_reverse_iterator(large_segment_indices_output + segments);
+    segment_count_output         = reinterpret_cast<segment_index_type*>(ptr);
+    ptr += segment_count_output_bytes;
+    partition_temporary_storage = ptr;
+
+    result = partitioner(partition_temporary_storage,
+                         partition_storage_size,
+                         segment_index_iterator{},
+                         large_segment_indices_output,
+                         medium_segment_indices_output,
+                         small_segment_indices_output,
+                         segment_count_output,
+                         segments,
+                         large_segment_selector,
+                         medium_segment_selector,
+                         stream,
+                         debug_synchronous);
+    if(hipSuccess != result)
+    {
+        return result;
+    }
+    // The segment counts stay on the device: the kernels are launched with grids sized for
+    // all segments and the blocks and logical warps past the count of their partition exit.
+    // The total number of items is not known here, so the number of large segments can
+    // only be bounded by the number of segments.
+    using partition_count_type = segment_partition_count<segment_count_output_size>;
+    const partition_count_type large_segment_count{segment_count_output, 0, segments};
+    const partition_count_type medium_segment_count{segment_count_output, 1, segments};
+    const partition_count_type small_segment_count{segment_count_output,
+                                                   segment_count_output_size,
+                                                   segments};
+    if(debug_synchronous)
+    {
+        segment_index_type segment_counts[segment_count_output_size]{};
+        result = detail::memcpy_and_sync(&segment_counts,
+                                         segment_count_output,
+                                         sizeof(segment_counts),
+                                         hipMemcpyDeviceToHost,
+                                         stream);
+        if(hipSuccess != result)
+        {
+            return result;
+        }
+        const auto large_count  = segment_counts[0];
+        const auto medium_count = three_way_partitioning ? segment_counts[1] : 0;
+        std::cout << "large_segment_count " << large_count << '\n';
+        std::cout << "medium_segment_count " << medium_count << '\n';
+        std::cout << "small_segment_count " << segments - large_count - medium_count << '\n';
+    }
+
+    {
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(segmented_reduce_large_kernel<config>),
+            dim3(segments), dim3(block_size), 0, stream,
+            input, output,
+            large_segment_count, large_segment_indices_output,
+            begin_offsets, end_offsets,
+            reduce_op, static_cast<result_type>(initial_value)
+        );
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_reduce:large_segments",
+                                                    segments,
+                                                    start);
+    }
+    if(three_way_partitioning)
+    {
+        const auto medium_segment_grid_size
+            = ::rocprim::detail::ceiling_div(segments, medium_segments_per_block);
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(
+                segmented_reduce_small_or_medium_kernel<
+                    warp_reduce_config::logical_warp_size_medium,
+                    warp_reduce_config::items_per_thread_medium,
+                    warp_reduce_config::block_size_medium>),
+            dim3(medium_segment_grid_size), dim3(warp_reduce_config::block_size_medium), 0, stream,
+            input, output,
+            medium_segment_count, medium_segment_indices_output,
+            begin_offsets, end_offsets,
+            reduce_op, static_cast<result_type>(initial_value)
+        );
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_reduce:medium_segments",
+                                                    segments,
+                                                    start);
+    }
+    {
+        const auto small_segment_grid_size
+            = ::rocprim::detail::ceiling_div(segments, small_segments_per_block);
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(
+                segmented_reduce_small_or_medium_kernel<
+                    warp_reduce_config::logical_warp_size_small,
+                    warp_reduce_config::items_per_thread_small,
+                    warp_reduce_config::block_size_small>),
+            dim3(small_segment_grid_size), dim3(warp_reduce_config::block_size_small), 0, stream,
+            input, output,
+            small_segment_count, small_segment_indices_output,
+            begin_offsets, end_offsets,
+            reduce_op, static_cast<result_type>(initial_value)
+        );
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_reduce:small_segments",
+                                                    segments,
+                                                    start);
+    }
 
     return hipSuccess;
 }
@@ -160,9 +431,13 @@ hipError_t segmented_reduce_impl(void * temporary_storage,
 /// at least \p segments elements. They may use the same sequence <tt>offsets</tt> of at least
 /// <tt>segments + 1</tt> elements: <tt>offsets</tt> for \p begin_offsets and
 /// <tt>offsets + 1</tt> for \p end_offsets.
+/// * If the number of segments is at least the partitioning threshold of the warp reduce
+/// configuration, the segments are partitioned by their length: small and medium segments are
+/// reduced by logical warps (or single threads), the remaining segments by whole blocks.
 ///
-/// \tparam Config - [optional] configuration of the primitive. It can be \p reduce_config or
-/// a custom class with the same members.
+/// \tparam Config - [optional] configuration of the primitive. It can be \p reduce_config,
+/// \p segmented_reduce_config or a custom class with the same members. If it is a
+/// \p reduce_config, the warp reduce configuration is selected by \p select_warp_reduce_config_t.
 /// \tparam InputIterator - random-access iterator type of the input range. Must meet the
 /// requirements of a C++ InputIterator concept. It can be a simple pointer type.
 /// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
@@ -0,0 +1,166 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_SEGMENTED_REDUCE_CONFIG_HPP_
+#define ROCPRIM_DEVICE_DEVICE_SEGMENTED_REDUCE_CONFIG_HPP_
+
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+#include "../functional.hpp"
+
+#include "config_types.hpp"
+
+/// \addtogroup primitivesmodule_deviceconfigs
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \brief Configuration of the warp reduce part of the device segmented reduce operation.
+/// Short enough segments are reduced on warp level.
+///
+/// Segments of at most <tt>LogicalWarpSizeSmall * ItemsPerThreadSmall</tt> items are small,
+/// segments of at most <tt>LogicalWarpSizeMedium * ItemsPerThreadMedium</tt> items are medium.
+/// Every small and every medium segment is reduced by a single logical warp, while the remaining
+/// segments are reduced by whole blocks. A logical warp size of 1 assigns a single thread
+/// to every segment.
+///
+/// \tparam LogicalWarpSizeSmall - number of threads in the logical warp of the kernel
+/// that processes small segments.
+/// \tparam ItemsPerThreadSmall - number of items processed by a thread in the kernel that processes
+/// small segments.
+/// \tparam BlockSizeSmall - number of threads per block in the kernel which processes the small segments.
+/// \tparam PartitioningThreshold - if the number of segments is at least this threshold, the
+/// segments are partitioned to a small, a medium and a large segment collection. The collections
+/// are reduced by different kernels. Otherwise, all segments are reduced by a single kernel.
+/// \tparam LogicalWarpSizeMedium - number of threads in the logical warp of the kernel
+/// that processes medium segments.
+/// \tparam ItemsPerThreadMedium - number of items processed by a thread in the kernel that processes
+/// medium segments.
+/// \tparam BlockSizeMedium - number of threads per block in the kernel which processes the medium segments.
+template<unsigned int LogicalWarpSizeSmall,
+         unsigned int ItemsPerThreadSmall,
+         unsigned int BlockSizeSmall        = 256,
+         unsigned int PartitioningThreshold = 3000,
+         unsigned int LogicalWarpSizeMedium = ::rocprim::max(32u, LogicalWarpSizeSmall),
+         unsigned int ItemsPerThreadMedium  = ItemsPerThreadSmall,
+         unsigned int BlockSizeMedium       = 256>
+struct WarpReduceConfig
+{
+    static_assert(LogicalWarpSizeSmall * ItemsPerThreadSmall
+                      <= LogicalWarpSizeMedium * ItemsPerThreadMedium,
+                  "The number of items processed by a small warp cannot be larger than the number "
+                  "of items processed by a medium warp");
+    /// \brief The number of threads in the logical warp in the small segment processing kernel.
+    static constexpr unsigned int logical_warp_size_small = LogicalWarpSizeSmall;
+    /// \brief The number of items processed by a thread in the small segment processing kernel.
+    static constexpr unsigned int items_per_thread_small = ItemsPerThreadSmall;
+    /// \brief The number of threads per block in the small segment processing kernel.
+    static constexpr unsigned int block_size_small = BlockSizeSmall;
+    /// \brief If the number of segments is at least \p partitioning_threshold, then the segments are partitioned into
+    /// small, medium and large segment groups, and each group is handled by a different, specialized kernel.
+    static constexpr unsigned int partitioning_threshold = PartitioningThreshold;
+    /// \brief The number of threads in the logical warp in the medium segment processing kernel.
+    static constexpr unsigned int logical_warp_size_medium = LogicalWarpSizeMedium;
+    /// \brief The number of items processed by a thread in the medium segment processing kernel.
+    static constexpr unsigned int items_per_thread_medium = ItemsPerThreadMedium;
+    /// \brief The number of threads per block in the medium segment processing kernel.
+    static constexpr unsigned int block_size_medium = BlockSizeMedium;
+};
+
+/// \brief Indicates if the warp level reduction is disabled in the
+/// device segmented reduce configuration.
+struct DisabledWarpReduceConfig
+{
+    /// \brief The number of threads in the logical warp in the small segment processing kernel.
+    static constexpr unsigned int logical_warp_size_small = 1;
+    /// \brief The number of items processed by a thread in the small segment processing kernel.
+    static constexpr unsigned int items_per_thread_small = 1;
+    /// \brief The number of threads per block in the small segment processing kernel.
+    static constexpr unsigned int block_size_small = 1;
+    /// \brief If the number of segments is at least \p partitioning_threshold, then the segments are partitioned into
+    /// small, medium and large segment groups, and each group is handled by a different, specialized kernel.
+    static constexpr unsigned int partitioning_threshold = 0;
+    /// \brief The number of threads in the logical warp in the medium segment processing kernel.
+    static constexpr unsigned int logical_warp_size_medium = 1;
+    /// \brief The number of items processed by a thread in the medium segment processing kernel.
+    static constexpr unsigned int items_per_thread_medium = 1;
+    /// \brief The number of threads per block in the medium segment processing kernel.
+    static constexpr unsigned int block_size_medium = 1;
+};
+
+/// \brief Selects the appropriate \p WarpReduceConfig based on the size of the reduced type.
+///
+/// \tparam Value - the type of the reduced values.
+/// \tparam MediumWarpSize - the logical warp size of the medium segment processing kernel.
+template<class Value, unsigned int MediumWarpSize = ROCPRIM_WARP_SIZE_32>
+using select_warp_reduce_config_t = WarpReduceConfig<
+    1, //< logical warp size - small kernel
+    ::rocprim::max(1u, static_cast<unsigned int>(8 / ::rocprim::detail::ceiling_div(sizeof(Value), sizeof(int)))), //< items per thread - small kernel
+    256, //< block size - small kernel
+    3000, //< partitioning threshold
+    MediumWarpSize, //< logical warp size - medium kernel
+    4, //< items per thread - medium kernel
+    256 //< block size - medium kernel
+    >;
+
+/// \brief Configuration of device-level segmented reduce operation.
+///
+/// \tparam ReduceConfig - configuration of the kernel reducing large segments by whole blocks.
+/// Must be \p reduce_config or \p default_config.
+/// \tparam WarpReduceConfig - configuration of the warp reduce that is used on the small and
+/// medium segments. Must be \p WarpReduceConfig or \p DisabledWarpReduceConfig.
+template<class ReduceConfig, class WarpReduceConfig = DisabledWarpReduceConfig>
+struct segmented_reduce_config
+{
+    /// \brief Configuration of the block reduce kernel.
+    using reduce = ReduceConfig;
+    /// \brief Configuration of the warp reduce method.
+    using warp_reduce_config = WarpReduceConfig;
+};
+
+namespace detail
+{
+
+// segmented_reduce accepts both a segmented_reduce_config and a plain reduce_config (or
+// default_config), in the latter case the default warp reduce configuration is used.
+template<class Config, class Value, class = void>
+struct segmented_reduce_config_parts
+{
+    using reduce = Config;
+    using warp_reduce_config = select_warp_reduce_config_t<Value>;
+};
+
+template<class Config, class Value>
+struct segmented_reduce_config_parts<Config, Value, void_t<typename Config::warp_reduce_config>>
+{
+    using reduce = typename Config::reduce;
+    using warp_reduce_config = typename Config::warp_reduce_config;
+};
+
+} // end namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+/// @}
+// end of group primitivesmodule_deviceconfigs
+
+#endif // ROCPRIM_DEVICE_DEVICE_SEGMENTED_REDUCE_CONFIG_HPP_
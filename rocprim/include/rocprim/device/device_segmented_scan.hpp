@@ -38,6 +38,7 @@
 #include "device_scan_config.hpp"
 #include "device_scan.hpp"
 #include "detail/device_segmented_scan.hpp"
+#include "device_trace.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -58,7 +59,7 @@ template<
     class BinaryFunction
 >
 ROCPRIM_KERNEL
-__launch_bounds__(ROCPRIM_DEFAULT_MAX_BLOCK_SIZE)
+__launch_bounds__(device_target_arch_config_t<Config>::block_size)
 void segmented_scan_kernel(InputIterator input,
                            OutputIterator output,
                            OffsetIterator begin_offsets,
@@ -66,7 +67,7 @@ void segmented_scan_kernel(InputIterator input,
                            InitValueType initial_value,
                            BinaryFunction scan_op)
 {
-    segmented_scan<Exclusive, Config, ResultType>(
+    segmented_scan<Exclusive, device_target_arch_config_t<Config>, ResultType>(
         input, output, begin_offsets, end_offsets,
         static_cast<ResultType>(initial_value), scan_op
     );
@@ -76,6 +77,7 @@ void segmented_scan_kernel(InputIterator input,
     { \
         auto _error = hipGetLastError(); \
         if(_error != hipSuccess) return _error; \
+        ::rocprim::detail::kernel_trace_end(name, size, stream); \
         if(debug_synchronous) \
         { \
             std::cout << name << "(" << size << ")"; \
@@ -112,14 +114,6 @@ hipError_t segmented_scan_impl(void * temporary_storage,
     using input_type = typename std::iterator_traits<InputIterator>::value_type;
     using result_type = typename std::conditional<Exclusive, InitValueType, input_type>::type;
 
-    // Get default config if Config is default_config
-    using config = default_or_custom_config<
-        Config,
-        default_scan_config<ROCPRIM_TARGET_ARCH, result_type>
-    >;
-
-    constexpr unsigned int block_size = config::block_size;
-
     if(temporary_storage == nullptr)
     {
         // Make sure user won't try to allocate 0 bytes memory, because
@@ -131,17 +125,29 @@ hipError_t segmented_scan_impl(void * temporary_storage,
     if( segments == 0u )
         return hipSuccess;
 
-    std::chrono::high_resolution_clock::time_point start;
-    if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-    hipLaunchKernelGGL(
-        HIP_KERNEL_NAME(segmented_scan_kernel<Exclusive, config, result_type>),
-        dim3(segments), dim3(block_size), 0, stream,
-        input, output,
-        begin_offsets, end_offsets,
-        initial_value, scan_op
-    );
-    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_scan", segments, start);
-    return hipSuccess;
+    // Get the config of the target architecture, or Config if it is not default_config
+    using wrapped_config = wrapped_scan_config<Config, result_type>;
+
+    return dispatch_target_arch_config<wrapped_config>(
+        stream,
+        [&](auto arch_config) -> hipError_t
+        {
+            using config = typename decltype(arch_config)::type;
+
+            constexpr unsigned int block_size = config::block_size;
+
+            std::chrono::high_resolution_clock::time_point start;
+            if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+            hipLaunchKernelGGL(
+                HIP_KERNEL_NAME(segmented_scan_kernel<Exclusive, wrapped_config, result_type>),
+                dim3(segments), dim3(block_size), 0, stream,
+                input, output,
+                begin_offsets, end_offsets,
+                initial_value, scan_op
+            );
+            ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_scan", segments, start);
+            return hipSuccess;
+        });
 }
 
 #undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
@@ -0,0 +1,416 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_SEGMENTED_TOPK_HPP_
+#define ROCPRIM_DEVICE_DEVICE_SEGMENTED_TOPK_HPP_
+
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+#include "../types.hpp"
+
+#include "detail/device_topk.hpp"
+#include "device_topk_config.hpp"
+#include "device_trace.hpp"
+
+/// \file
+///
+/// Device level segmented top-k selection primitives
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule
+/// @{
+
+namespace detail
+{
+
+template<class Config,
+         bool Descending,
+         bool WithValues,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class OffsetIterator>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::block_size) void segmented_topk_kernel(
+    KeysInputIterator    keys_input,
+    KeysOutputIterator   keys_output,
+    ValuesInputIterator  values_input,
+    ValuesOutputIterator values_output,
+    OffsetIterator       begin_offsets,
+    OffsetIterator       end_offsets,
+    const unsigned int   k)
+{
+    segmented_topk<device_target_arch_config_t<Config>, Descending, WithValues>(keys_input,
+                                                                                keys_output,
+                                                                                values_input,
+                                                                                values_output,
+                                                                                begin_offsets,
+                                                                                end_offsets,
+                                                                                k);
+}
+
+#define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start)                           \
+    {                                                                                            \
+        auto _error = hipGetLastError();                                                         \
+        if(_error != hipSuccess)                                                                 \
+            return _error;                                                                       \
+        ::rocprim::detail::kernel_trace_end(name, size, stream);                                 \
+        if(debug_synchronous)                                                                    \
+        {                                                                                        \
+            std::cout << name << "(" << size << ")";                                             \
+            auto __error = hipStreamSynchronize(stream);                                         \
+            if(__error != hipSuccess)                                                            \
+                return __error;                                                                  \
+            auto _end = std::chrono::high_resolution_clock::now();                               \
+            auto _d   = std::chrono::duration_cast<std::chrono::duration<double>>(_end - start); \
+            std::cout << " " << _d.count() * 1000 << " ms" << '\n';                              \
+        }                                                                                        \
+    }
+
+template<class Config,
+         class ArchConfig,
+         bool Descending,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class OffsetIterator>
+inline hipError_t segmented_topk_arch_impl(void*                temporary_storage,
+                                           size_t&              storage_size,
+                                           KeysInputIterator    keys_input,
+                                           KeysOutputIterator   keys_output,
+                                           ValuesInputIterator  values_input,
+                                           ValuesOutputIterator values_output,
+                                           const unsigned int   segments,
+                                           OffsetIterator       begin_offsets,
+                                           OffsetIterator       end_offsets,
+                                           const unsigned int   k,
+                                           const hipStream_t    stream,
+                                           const bool           debug_synchronous)
+{
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+
+    using config = ArchConfig;
+
+    constexpr bool         with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+    constexpr unsigned int block_size  = config::block_size;
+
+    static_assert((1u << config::radix_bits) <= block_size,
+                  "Radix size must not exceed BlockSize");
+
+    if(temporary_storage == nullptr)
+    {
+        // Make sure user won't try to allocate 0 bytes memory, because
+        // hipMalloc will return nullptr when size is zero.
+        storage_size = 4;
+        return hipSuccess;
+    }
+
+    if(segments == 0 || k == 0)
+    {
+        return hipSuccess;
+    }
+
+    if(debug_synchronous)
+    {
+        std::cout << "segments:   " << segments << '\n';
+        std::cout << "k:          " << k << '\n';
+        std::cout << "block_size: " << block_size << '\n';
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+    if(debug_synchronous)
+        start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(segmented_topk_kernel<Config, Descending, with_values>),
+                       dim3(segments),
+                       dim3(block_size),
+                       0,
+                       stream,
+                       keys_input,
+                       keys_output,
+                       values_input,
+                       values_output,
+                       begin_offsets,
+                       end_offsets,
+                       k);
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("segmented_topk_kernel", segments, start);
+
+    return hipSuccess;
+}
+
+template<class Config,
+         bool Descending,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class OffsetIterator>
+inline hipError_t segmented_topk_impl(void*                temporary_storage,
+                                      size_t&              storage_size,
+                                      KeysInputIterator    keys_input,
+                                      KeysOutputIterator   keys_output,
+                                      ValuesInputIterator  values_input,
+                                      ValuesOutputIterator values_output,
+                                      const unsigned int   segments,
+                                      OffsetIterator       begin_offsets,
+                                      OffsetIterator       end_offsets,
+                                      const unsigned int   k,
+                                      const hipStream_t    stream,
+                                      const bool           debug_synchronous)
+{
+    using key_type   = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = wrapped_topk_config<Config, key_type, value_type>;
+
+    return dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            return segmented_topk_arch_impl<config,
+                                            typename decltype(arch_config)::type,
+                                            Descending>(
+                temporary_storage,
+                storage_size,
+                keys_input,
+                keys_output,
+                values_input,
+                values_output,
+                segments,
+                begin_offsets,
+                end_offsets,
+                k,
+                stream,
+                debug_synchronous);
+        });
+}
+
+#undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
+
+} // end namespace detail
+
+/// \brief Parallel segmented top-k selection primitive for device level.
+///
+/// segmented_topk_keys function selects the \p k largest keys of every segment of
+/// \p keys_input. The selected keys of segment \p i are written to
+/// <tt>keys_output[i * k]</tt>, ..., <tt>keys_output[i * k + min(k, size of the segment) - 1]</tt>
+/// in their input order. Each segment is processed by a single block with a radix select,
+/// like \p topk_keys, so no sort is performed.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p begin_offsets and \p end_offsets must have
+/// at least \p segments elements. They may use the same sequence <tt>offsets</tt> of at least
+/// <tt>segments + 1</tt> elements: <tt>offsets</tt> for \p begin_offsets and
+/// <tt>offsets + 1</tt> for \p end_offsets.
+/// * Range specified by \p keys_output must have at least <tt>segments * k</tt> elements.
+/// Elements after the selected keys of segments with less than \p k keys are not modified.
+/// * If there are several keys equal to the k-th largest key of a segment, the first ones
+/// (in input order) are selected.
+/// * Supports the same key types as \p radix_sort_keys (without a decomposer).
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p topk_config or
+/// a custom class with the same members.
+/// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam OffsetIterator - random-access iterator type of segment offsets. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the selection.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - pointer to the first element in the range to select from.
+/// \param [out] keys_output - pointer to the first element in the output range.
+/// \param [in] segments - number of segments in the input range.
+/// \param [in] begin_offsets - iterator to the first element in the range of beginning offsets.
+/// \param [in] end_offsets - iterator to the first element in the range of ending offsets.
+/// \param [in] k - number of keys to select from each segment.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful selection; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example the 2 largest keys of each segment are selected.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// float * input;          // e.g., [0.6, 0.3, 0.65, 0.4, 0.2, 0.08, 1, 0.7]
+/// unsigned int segments;  // e.g., 3
+/// int * offsets;          // e.g. [0, 2, 3, 8]
+/// float * output;         // empty array of 6 elements
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::segmented_topk_keys(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, segments, offsets, offsets + 1, 2
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // select
+/// rocprim::segmented_topk_keys(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, segments, offsets, offsets + 1, 2
+/// );
+/// // output: [0.6, 0.3, 0.65, -, 1, 0.7]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class OffsetIterator>
+inline hipError_t segmented_topk_keys(void*              temporary_storage,
+                                      size_t&            storage_size,
+                                      KeysInputIterator  keys_input,
+                                      KeysOutputIterator keys_output,
+                                      unsigned int       segments,
+                                      OffsetIterator     begin_offsets,
+                                      OffsetIterator     end_offsets,
+                                      unsigned int       k,
+                                      hipStream_t        stream            = 0,
+                                      bool               debug_synchronous = false)
+{
+    ::rocprim::empty_type* values = nullptr;
+    return detail::segmented_topk_impl<Config, true>(temporary_storage,
+                                                     storage_size,
+                                                     keys_input,
+                                                     keys_output,
+                                                     values,
+                                                     values,
+                                                     segments,
+                                                     begin_offsets,
+                                                     end_offsets,
+                                                     k,
+                                                     stream,
+                                                     debug_synchronous);
+}
+
+/// \brief Parallel segmented top-k selection primitive for device level, with values.
+///
+/// segmented_topk_pairs function selects the \p k largest keys of every segment of
+/// \p keys_input, together with their associated values. The selected pairs of segment \p i
+/// are written to <tt>keys_output[i * k]</tt> and <tt>values_output[i * k]</tt> onwards,
+/// in their input order (see \p segmented_topk_keys).
+///
+/// \par Overview
+/// * The contents of the inputs are not altered.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p begin_offsets and \p end_offsets must have
+/// at least \p segments elements. They may use the same sequence <tt>offsets</tt> of at least
+/// <tt>segments + 1</tt> elements: <tt>offsets</tt> for \p begin_offsets and
+/// <tt>offsets + 1</tt> for \p end_offsets.
+/// * Ranges specified by \p keys_output and \p values_output must have at least
+/// <tt>segments * k</tt> elements.
+/// * If there are several keys equal to the k-th largest key of a segment, the first ones
+/// (in input order) are selected.
+/// * Supports the same key types as \p radix_sort_keys (without a decomposer).
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p topk_config or
+/// a custom class with the same members.
+/// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam OffsetIterator - random-access iterator type of segment offsets. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the selection.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - pointer to the first element in the range of keys to select from.
+/// \param [out] keys_output - pointer to the first element in the output range of keys.
+/// \param [in] values_input - pointer to the first element in the range of values.
+/// \param [out] values_output - pointer to the first element in the output range of values.
+/// \param [in] segments - number of segments in the input range.
+/// \param [in] begin_offsets - iterator to the first element in the range of beginning offsets.
+/// \param [in] end_offsets - iterator to the first element in the range of ending offsets.
+/// \param [in] k - number of pairs to select from each segment.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful selection; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<class Config = default_config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class OffsetIterator>
+inline hipError_t segmented_topk_pairs(void*                temporary_storage,
+                                       size_t&              storage_size,
+                                       KeysInputIterator    keys_input,
+                                       KeysOutputIterator   keys_output,
+                                       ValuesInputIterator  values_input,
+                                       ValuesOutputIterator values_output,
+                                       unsigned int         segments,
+                                       OffsetIterator       begin_offsets,
+                                       OffsetIterator       end_offsets,
+                                       unsigned int         k,
+                                       hipStream_t          stream            = 0,
+                                       bool                 debug_synchronous = false)
+{
+    return detail::segmented_topk_impl<Config, true>(temporary_storage,
+                                                     storage_size,
+                                                     keys_input,
+                                                     keys_output,
+                                                     values_input,
+                                                     values_output,
+                                                     segments,
+                                                     begin_offsets,
+                                                     end_offsets,
+                                                     k,
+                                                     stream,
+                                                     debug_synchronous);
+}
+
+/// @}
+// end of group devicemodule
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_SEGMENTED_TOPK_HPP_
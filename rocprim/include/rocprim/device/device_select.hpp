@@ -30,6 +30,7 @@
 
 #include "../iterator/transform_iterator.hpp"
 
+#include "detail/device_host_native.hpp"
 #include "device_scan.hpp"
 #include "device_partition.hpp"
 
@@ -140,6 +141,17 @@ hipError_t select(void * temporary_storage,
                   const hipStream_t stream = 0,
                   const bool debug_synchronous = false)
 {
+#if ROCPRIM_DETAIL_USE_HOST_NATIVE
+    return detail::host_native_select(temporary_storage,
+                                      storage_size,
+                                      input,
+                                      output,
+                                      selected_count_output,
+                                      size,
+                                      [&](const size_t i) -> bool { return flags[i]; },
+                                      stream,
+                                      debug_synchronous);
+#else
     // Dummy unary predicate
     using unary_predicate_type = ::rocprim::empty_type;
     // Dummy inequality operation
@@ -151,6 +163,7 @@ hipError_t select(void * temporary_storage,
         temporary_storage, storage_size, input, no_values, flags, output, no_values, selected_count_output,
         size, inequality_op_type(), stream, debug_synchronous, unary_predicate_type()
     );
+#endif
 }
 
 /// \brief Parallel select primitive for device level using selection operator.
@@ -253,6 +266,17 @@ hipError_t select(void * temporary_storage,
                   const hipStream_t stream = 0,
                   const bool debug_synchronous = false)
 {
+#if ROCPRIM_DETAIL_USE_HOST_NATIVE
+    return detail::host_native_select(temporary_storage,
+                                      storage_size,
+                                      input,
+                                      output,
+                                      selected_count_output,
+                                      size,
+                                      [&](const size_t i) -> bool { return predicate(input[i]); },
+                                      stream,
+                                      debug_synchronous);
+#else
     // Dummy flag type
     using flag_type = ::rocprim::empty_type;
     using offset_type = unsigned int;
@@ -265,6 +289,7 @@ hipError_t select(void * temporary_storage,
         temporary_storage, storage_size, input, no_values, flags, output, no_values, selected_count_output,
         size, inequality_op_type(), stream, debug_synchronous, predicate
     );
+#endif
 }
 
 /// \brief Device-level parallel unique primitive.
@@ -45,7 +45,8 @@ BEGIN_ROCPRIM_NAMESPACE
 /// \tparam ValueBlockLoadMethod - method for loading input values.
 /// \tparam FlagBlockLoadMethod - method for loading flag values.
 /// \tparam BlockScanMethod - algorithm for block scan.
-/// \tparam SizeLimit - limit on the number of items for a single select kernel launch.
+/// \tparam SizeLimit - limit on the number of items covered at once by the blocks of a select
+/// kernel launch. Larger inputs are still processed by a single launch.
 template<
     unsigned int BlockSize,
     unsigned int ItemsPerThread,
@@ -69,7 +70,7 @@ struct select_config
     static constexpr block_load_method flag_block_load_method = FlagBlockLoadMethod;
     /// \brief Algorithm for block scan.
     static constexpr block_scan_algorithm block_scan_method = BlockScanMethod;
-    /// \brief Limit on the number of items for a single select kernel launch.
+    /// \brief Limit on the number of items covered at once by the blocks of a select kernel launch.
     static constexpr unsigned int size_limit = SizeLimit;
 };
 
@@ -152,6 +153,18 @@ struct default_select_config
         select_config_803<Key>
     > { };
 
+// Config of select, partition and unique per target architecture.
+template<class Config, class Key, class Value>
+struct wrapped_select_config
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        using type
+            = arch_config_t<Config, default_select_config<static_cast<unsigned int>(Arch), Key, Value>>;
+    };
+};
+
 } // end namespace detail
 
 END_ROCPRIM_NAMESPACE
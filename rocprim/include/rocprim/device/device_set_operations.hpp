@@ -0,0 +1,1237 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_SET_OPERATIONS_HPP_
+#define ROCPRIM_DEVICE_DEVICE_SET_OPERATIONS_HPP_
+
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../functional.hpp"
+#include "../types.hpp"
+#include "../detail/various.hpp"
+
+#include "detail/device_scan_common.hpp"
+#include "detail/device_set_operations.hpp"
+
+#include "device_merge_config.hpp"
+#include "device_transform.hpp"
+#include "device_trace.hpp"
+
+/// \file
+///
+/// Device level set operations on sorted ranges
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule
+/// @{
+
+namespace detail
+{
+
+template<class KeysInputIterator1, class KeysInputIterator2, class BinaryFunction>
+ROCPRIM_KERNEL
+__launch_bounds__(ROCPRIM_DEFAULT_MAX_BLOCK_SIZE)
+void set_operation_partition_kernel(size_t* indices,
+                                    KeysInputIterator1 keys_input1,
+                                    KeysInputIterator2 keys_input2,
+                                    const size_t input1_size,
+                                    const size_t input2_size,
+                                    const size_t number_of_tiles,
+                                    const unsigned int spacing,
+                                    BinaryFunction compare_function)
+{
+    set_operation_partition_kernel_impl(
+        indices, keys_input1, keys_input2, input1_size, input2_size,
+        number_of_tiles, spacing, compare_function
+    );
+}
+
+template<
+    class SetOp,
+    class Config,
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class KeysOutputIterator,
+    class ValuesInputIterator1,
+    class ValuesInputIterator2,
+    class ValuesOutputIterator,
+    class BinaryFunction,
+    class OffsetLookbackScanState
+>
+ROCPRIM_KERNEL
+__launch_bounds__(device_target_arch_config_t<Config>::block_size)
+void set_operation_kernel(const size_t* indices,
+                          KeysInputIterator1 keys_input1,
+                          KeysInputIterator2 keys_input2,
+                          KeysOutputIterator keys_output,
+                          ValuesInputIterator1 values_input1,
+                          ValuesInputIterator2 values_input2,
+                          ValuesOutputIterator values_output,
+                          size_t* output_count,
+                          const size_t input1_size,
+                          const size_t input2_size,
+                          BinaryFunction compare_function,
+                          OffsetLookbackScanState offset_scan_state,
+                          const size_t number_of_tiles,
+                          ordered_block_id<lookback_tile_id_type> ordered_tile_id)
+{
+    set_operation_kernel_impl<SetOp, device_target_arch_config_t<Config>>(
+        indices, keys_input1, keys_input2, keys_output,
+        values_input1, values_input2, values_output, output_count,
+        input1_size, input2_size, compare_function,
+        offset_scan_state, number_of_tiles, ordered_tile_id
+    );
+}
+
+#define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start) \
+    { \
+        auto _error = hipGetLastError(); \
+        if(_error != hipSuccess) return _error; \
+        ::rocprim::detail::kernel_trace_end(name, size, stream); \
+        if(debug_synchronous) \
+        { \
+            std::cout << name << "(" << size << ")"; \
+            auto __error = hipStreamSynchronize(stream); \
+            if(__error != hipSuccess) return __error; \
+            auto _end = std::chrono::high_resolution_clock::now(); \
+            auto _d = std::chrono::duration_cast<std::chrono::duration<double>>(_end - start); \
+            std::cout << " " << _d.count() * 1000 << " ms" << '\n'; \
+        } \
+    }
+
+template<
+    class SetOp,
+    class Config,
+    class ArchConfig,
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class KeysOutputIterator,
+    class ValuesInputIterator1,
+    class ValuesInputIterator2,
+    class ValuesOutputIterator,
+    class OutputCountIterator,
+    class BinaryFunction
+>
+inline
+hipError_t set_operation_arch_impl(void * temporary_storage,
+                                   size_t& storage_size,
+                                   KeysInputIterator1 keys_input1,
+                                   KeysInputIterator2 keys_input2,
+                                   KeysOutputIterator keys_output,
+                                   ValuesInputIterator1 values_input1,
+                                   ValuesInputIterator2 values_input2,
+                                   ValuesOutputIterator values_output,
+                                   OutputCountIterator output_count,
+                                   const size_t input1_size,
+                                   const size_t input2_size,
+                                   BinaryFunction compare_function,
+                                   const hipStream_t stream,
+                                   bool debug_synchronous)
+{
+    using config = ArchConfig;
+
+    using offset_scan_state_type = detail::lookback_scan_state<size_t>;
+    using offset_scan_state_with_sleep_type = detail::lookback_scan_state<size_t, true>;
+    using ordered_tile_id_type = detail::ordered_block_id<lookback_tile_id_type>;
+
+    static constexpr unsigned int block_size = config::block_size;
+    static constexpr unsigned int items_per_thread = config::items_per_thread;
+    static constexpr unsigned int items_per_block = block_size * items_per_thread;
+
+    const size_t number_of_tiles = ceiling_div(input1_size + input2_size, items_per_block);
+
+    // Calculate required temporary storage
+    const size_t partition_bytes = align_size((number_of_tiles + 1) * sizeof(size_t));
+    const size_t offset_scan_state_bytes = align_size(
+        // This is valid even with offset_scan_state_with_sleep_type
+        offset_scan_state_type::get_storage_size(number_of_tiles)
+    );
+    const size_t ordered_tile_id_bytes = align_size(
+        ordered_tile_id_type::get_storage_size(),
+        alignof(size_t)
+    );
+
+    if(temporary_storage == nullptr)
+    {
+        // storage_size is never zero
+        storage_size = partition_bytes + offset_scan_state_bytes + ordered_tile_id_bytes
+            + sizeof(size_t);
+        return hipSuccess;
+    }
+
+    // Start point for time measurements
+    std::chrono::high_resolution_clock::time_point start;
+
+    auto ptr = reinterpret_cast<char*>(temporary_storage);
+    size_t* indices = reinterpret_cast<size_t*>(ptr);
+    ptr += partition_bytes;
+    auto offset_scan_state = offset_scan_state_type::create(ptr, number_of_tiles);
+    auto offset_scan_state_with_sleep = offset_scan_state_with_sleep_type::create(ptr, number_of_tiles);
+    ptr += offset_scan_state_bytes;
+    auto ordered_tile_id = ordered_tile_id_type::create(
+        reinterpret_cast<ordered_tile_id_type::id_type*>(ptr)
+    );
+    ptr += ordered_tile_id_bytes;
+    size_t* count = reinterpret_cast<size_t*>(ptr);
+
+    // Memset count, it stays zero if there are no tiles
+    hipError_t error = hipMemsetAsync(count, 0, sizeof(*count), stream);
+    if(error != hipSuccess) return error;
+
+    hipDeviceProp_t prop;
+    int deviceId;
+    static_cast<void>(hipGetDevice(&deviceId));
+    static_cast<void>(hipGetDeviceProperties(&prop, deviceId));
+
+#if HIP_VERSION >= 307
+    int asicRevision = prop.asicRevision;
+#else
+    int asicRevision = 0;
+#endif
+    const bool use_sleep = prop.gcnArch == 908 && asicRevision < 2;
+
+    // All tiles are processed by a single launch, blocks take several tiles if the tiles would
+    // exceed config::size_limit items
+    const unsigned int grid_size
+        = lookback_grid_size(number_of_tiles, items_per_block, config::size_limit);
+
+    if(debug_synchronous)
+    {
+        std::cout << "input1_size " << input1_size << '\n';
+        std::cout << "input2_size " << input2_size << '\n';
+        std::cout << "block_size " << block_size << '\n';
+        std::cout << "number of tiles " << number_of_tiles << '\n';
+        std::cout << "number of blocks " << grid_size << '\n';
+        std::cout << "items_per_block " << items_per_block << '\n';
+    }
+
+    if(number_of_tiles > 0)
+    {
+        const size_t partition_blocks = ceiling_div(number_of_tiles + 1, block_size);
+
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(detail::set_operation_partition_kernel),
+            dim3(partition_blocks), dim3(block_size), 0, stream,
+            indices, keys_input1, keys_input2, input1_size, input2_size,
+            number_of_tiles, items_per_block, compare_function
+        );
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("set_operation_partition_kernel", number_of_tiles + 1, start);
+
+        const unsigned int init_grid_size = ceiling_div(number_of_tiles, block_size);
+
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        if(use_sleep)
+        {
+            hipLaunchKernelGGL(
+                HIP_KERNEL_NAME(init_lookback_scan_state_kernel<offset_scan_state_with_sleep_type>),
+                dim3(init_grid_size), dim3(block_size), 0, stream,
+                offset_scan_state_with_sleep, number_of_tiles, ordered_tile_id
+            );
+        }
+        else
+        {
+            hipLaunchKernelGGL(
+                HIP_KERNEL_NAME(init_lookback_scan_state_kernel<offset_scan_state_type>),
+                dim3(init_grid_size), dim3(block_size), 0, stream,
+                offset_scan_state, number_of_tiles, ordered_tile_id
+            );
+        }
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("init_offset_scan_state_kernel", number_of_tiles, start);
+
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        if(use_sleep)
+        {
+            hipLaunchKernelGGL(
+                HIP_KERNEL_NAME(detail::set_operation_kernel<SetOp, Config>),
+                dim3(grid_size), dim3(block_size), 0, stream,
+                indices, keys_input1, keys_input2, keys_output,
+                values_input1, values_input2, values_output, count,
+                input1_size, input2_size, compare_function,
+                offset_scan_state_with_sleep, number_of_tiles, ordered_tile_id
+            );
+        }
+        else
+        {
+            hipLaunchKernelGGL(
+                HIP_KERNEL_NAME(detail::set_operation_kernel<SetOp, Config>),
+                dim3(grid_size), dim3(block_size), 0, stream,
+                indices, keys_input1, keys_input2, keys_output,
+                values_input1, values_input2, values_output, count,
+                input1_size, input2_size, compare_function,
+                offset_scan_state, number_of_tiles, ordered_tile_id
+            );
+        }
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("set_operation_kernel", input1_size + input2_size, start);
+    }
+
+    return ::rocprim::transform(
+        count, output_count, 1,
+        ::rocprim::identity<>{},
+        stream, debug_synchronous
+    );
+}
+
+template<
+    class SetOp,
+    class Config,
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class KeysOutputIterator,
+    class ValuesInputIterator1,
+    class ValuesInputIterator2,
+    class ValuesOutputIterator,
+    class OutputCountIterator,
+    class BinaryFunction
+>
+inline
+hipError_t set_operation_impl(void * temporary_storage,
+                              size_t& storage_size,
+                              KeysInputIterator1 keys_input1,
+                              KeysInputIterator2 keys_input2,
+                              KeysOutputIterator keys_output,
+                              ValuesInputIterator1 values_input1,
+                              ValuesInputIterator2 values_input2,
+                              ValuesOutputIterator values_output,
+                              OutputCountIterator output_count,
+                              const size_t input1_size,
+                              const size_t input2_size,
+                              BinaryFunction compare_function,
+                              const hipStream_t stream,
+                              bool debug_synchronous)
+{
+    using key_type = typename std::iterator_traits<KeysInputIterator1>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator1>::value_type;
+
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = wrapped_merge_config<Config, key_type, value_type>;
+
+    return dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            return set_operation_arch_impl<SetOp, config, typename decltype(arch_config)::type>(
+                temporary_storage,
+                storage_size,
+                keys_input1,
+                keys_input2,
+                keys_output,
+                values_input1,
+                values_input2,
+                values_output,
+                output_count,
+                input1_size,
+                input2_size,
+                compare_function,
+                stream,
+                debug_synchronous);
+        });
+}
+
+#undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
+
+} // end of detail namespace
+
+/// \brief Parallel union of sorted ranges for device level.
+///
+/// \p set_union function computes the union of two sorted ranges: the items of the first range and
+/// the items of the second range which are not matched by items of the first range. A key that
+/// occurs \p m times in the first range and \p n times in the second range occurs <tt>max(m,
+/// n)</tt> times in the output.
+/// Both ranges are partitioned into tiles of their merged order with merge path. Each block merges
+/// its tile in shared memory, selects the output items and writes them at offsets computed with a
+/// single-pass look-back scan, so the inputs are read once.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p keys_input1 and \p keys_input2 must be sorted with respect to
+/// \p compare_function.
+/// * The output is sorted with respect to \p compare_function. Equal keys of the first range
+/// precede equal keys of the second range.
+/// * Range specified by \p keys_output must have at least as many elements as the result,
+/// which is never more than <tt>input1_size + input2_size</tt>.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p merge_config or
+/// a custom class with the same members.
+/// \tparam KeysInputIterator1 - random-access iterator type of the first input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysInputIterator2 - random-access iterator type of the second input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam OutputCountIterator - random-access iterator type of the output count. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam BinaryFunction - type of binary function used for comparisons. Default type
+/// is \p rocprim::less<T>, where \p T is a \p value_type of \p KeysInputIterator1.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input1 - iterator to the first element in the first sorted range.
+/// \param [in] keys_input2 - iterator to the first element in the second sorted range.
+/// \param [out] keys_output - iterator to the first element in the output range.
+/// \param [out] output_count - iterator to the number of elements written to the output range.
+/// \param [in] input1_size - number of element in the first input range.
+/// \param [in] input2_size - number of element in the second input range.
+/// \param [in] compare_function - binary operation function object that will be used for comparison.
+/// The signature of the function should be equivalent to the following:
+/// <tt>bool f(const T &a, const T &b);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the objects passed to it.
+/// The default value is \p BinaryFunction().
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful operation; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level union of two ranges of \p int values is computed.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input1_size;     // e.g., 5
+/// size_t input2_size;     // e.g., 4
+/// int * input1;           // e.g., [1, 2, 2, 5, 6]
+/// int * input2;           // e.g., [2, 3, 5, 7]
+/// int * output;           // empty array of 9 elements
+/// size_t * output_count;  // empty array of 1 element
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::set_union(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input1, input2, output, output_count, input1_size, input2_size
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // perform union
+/// rocprim::set_union(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input1, input2, output, output_count, input1_size, input2_size
+/// );
+/// // output: [1, 2, 2, 3, 5, 6, 7]
+/// // output_count: 7
+/// \endcode
+/// \endparblock
+template<
+    class Config = default_config,
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class KeysOutputIterator,
+    class OutputCountIterator,
+    class BinaryFunction = ::rocprim::less<typename std::iterator_traits<KeysInputIterator1>::value_type>
+>
+inline
+hipError_t set_union(void * temporary_storage,
+                     size_t& storage_size,
+                     KeysInputIterator1 keys_input1,
+                     KeysInputIterator2 keys_input2,
+                     KeysOutputIterator keys_output,
+                     OutputCountIterator output_count,
+                     const size_t input1_size,
+                     const size_t input2_size,
+                     BinaryFunction compare_function = BinaryFunction(),
+                     const hipStream_t stream = 0,
+                     bool debug_synchronous = false)
+{
+    empty_type * values = nullptr;
+    return detail::set_operation_impl<detail::set_union_op, Config>(
+        temporary_storage, storage_size,
+        keys_input1, keys_input2, keys_output,
+        values, values, values,
+        output_count, input1_size, input2_size, compare_function,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief Parallel union of sorted ranges of (key, value) pairs for device level.
+///
+/// \p set_union_by_key function computes the union of two ranges of (key, value) pairs sorted by
+/// keys, in the same way as \p set_union does for keys. The value of every output item is the value
+/// of the input item its key is taken from.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p keys_input1 and \p keys_input2 must be sorted with respect to
+/// \p compare_function.
+/// * The output is sorted with respect to \p compare_function. Equal keys of the first range
+/// precede equal keys of the second range.
+/// * Range specified by \p keys_output must have at least as many elements as the result,
+/// which is never more than <tt>input1_size + input2_size</tt>.
+/// * Range specified by \p values_output must have as many elements as \p keys_output.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p merge_config or
+/// a custom class with the same members.
+/// \tparam KeysInputIterator1 - random-access iterator type of the first keys input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysInputIterator2 - random-access iterator type of the second keys input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the keys output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesInputIterator1 - random-access iterator type of the first values input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesInputIterator2 - random-access iterator type of the second values input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesOutputIterator - random-access iterator type of the values output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam OutputCountIterator - random-access iterator type of the output count. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam BinaryFunction - type of binary function used for key comparisons. Default type
+/// is \p rocprim::less<T>, where \p T is a \p value_type of \p KeysInputIterator1.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input1 - iterator to the first key in the first sorted range.
+/// \param [in] keys_input2 - iterator to the first key in the second sorted range.
+/// \param [out] keys_output - iterator to the first key in the output range.
+/// \param [in] values_input1 - iterator to the first value in the first range.
+/// \param [in] values_input2 - iterator to the first value in the second range.
+/// \param [out] values_output - iterator to the first value in the output range.
+/// \param [out] output_count - iterator to the number of pairs written to the output ranges.
+/// \param [in] input1_size - number of element in the first input range.
+/// \param [in] input2_size - number of element in the second input range.
+/// \param [in] compare_function - binary operation function object that will be used for key comparison.
+/// The signature of the function should be equivalent to the following:
+/// <tt>bool f(const T &a, const T &b);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the objects passed to it.
+/// The default value is \p BinaryFunction().
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful operation; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<
+    class Config = default_config,
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class KeysOutputIterator,
+    class ValuesInputIterator1,
+    class ValuesInputIterator2,
+    class ValuesOutputIterator,
+    class OutputCountIterator,
+    class BinaryFunction = ::rocprim::less<typename std::iterator_traits<KeysInputIterator1>::value_type>
+>
+inline
+hipError_t set_union_by_key(void * temporary_storage,
+                            size_t& storage_size,
+                            KeysInputIterator1 keys_input1,
+                            KeysInputIterator2 keys_input2,
+                            KeysOutputIterator keys_output,
+                            ValuesInputIterator1 values_input1,
+                            ValuesInputIterator2 values_input2,
+                            ValuesOutputIterator values_output,
+                            OutputCountIterator output_count,
+                            const size_t input1_size,
+                            const size_t input2_size,
+                            BinaryFunction compare_function = BinaryFunction(),
+                            const hipStream_t stream = 0,
+                            bool debug_synchronous = false)
+{
+    return detail::set_operation_impl<detail::set_union_op, Config>(
+        temporary_storage, storage_size,
+        keys_input1, keys_input2, keys_output,
+        values_input1, values_input2, values_output,
+        output_count, input1_size, input2_size, compare_function,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief Parallel intersection of sorted ranges for device level.
+///
+/// \p set_intersection function computes the intersection of two sorted ranges: the items of the
+/// first range which are matched by items of the second range. A key that occurs \p m times in the
+/// first range and \p n times in the second range occurs <tt>min(m, n)</tt> times in the output.
+/// Both ranges are partitioned into tiles of their merged order with merge path. Each block merges
+/// its tile in shared memory, selects the output items and writes them at offsets computed with a
+/// single-pass look-back scan, so the inputs are read once.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p keys_input1 and \p keys_input2 must be sorted with respect to
+/// \p compare_function.
+/// * The output is sorted with respect to \p compare_function. Equal keys of the first range
+/// precede equal keys of the second range.
+/// * Range specified by \p keys_output must have at least as many elements as the result,
+/// which is never more than <tt>input1_size + input2_size</tt>.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p merge_config or
+/// a custom class with the same members.
+/// \tparam KeysInputIterator1 - random-access iterator type of the first input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysInputIterator2 - random-access iterator type of the second input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam OutputCountIterator - random-access iterator type of the output count. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam BinaryFunction - type of binary function used for comparisons. Default type
+/// is \p rocprim::less<T>, where \p T is a \p value_type of \p KeysInputIterator1.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input1 - iterator to the first element in the first sorted range.
+/// \param [in] keys_input2 - iterator to the first element in the second sorted range.
+/// \param [out] keys_output - iterator to the first element in the output range.
+/// \param [out] output_count - iterator to the number of elements written to the output range.
+/// \param [in] input1_size - number of element in the first input range.
+/// \param [in] input2_size - number of element in the second input range.
+/// \param [in] compare_function - binary operation function object that will be used for comparison.
+/// The signature of the function should be equivalent to the following:
+/// <tt>bool f(const T &a, const T &b);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the objects passed to it.
+/// The default value is \p BinaryFunction().
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful operation; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level intersection of two ranges of \p int values is computed.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input1_size;     // e.g., 5
+/// size_t input2_size;     // e.g., 4
+/// int * input1;           // e.g., [1, 2, 2, 5, 6]
+/// int * input2;           // e.g., [2, 3, 5, 7]
+/// int * output;           // empty array of 9 elements
+/// size_t * output_count;  // empty array of 1 element
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::set_intersection(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input1, input2, output, output_count, input1_size, input2_size
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // perform intersection
+/// rocprim::set_intersection(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input1, input2, output, output_count, input1_size, input2_size
+/// );
+/// // output: [2, 5]
+/// // output_count: 2
+/// \endcode
+/// \endparblock
+template<
+    class Config = default_config,
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class KeysOutputIterator,
+    class OutputCountIterator,
+    class BinaryFunction = ::rocprim::less<typename std::iterator_traits<KeysInputIterator1>::value_type>
+>
+inline
+hipError_t set_intersection(void * temporary_storage,
+                            size_t& storage_size,
+                            KeysInputIterator1 keys_input1,
+                            KeysInputIterator2 keys_input2,
+                            KeysOutputIterator keys_output,
+                            OutputCountIterator output_count,
+                            const size_t input1_size,
+                            const size_t input2_size,
+                            BinaryFunction compare_function = BinaryFunction(),
+                            const hipStream_t stream = 0,
+                            bool debug_synchronous = false)
+{
+    empty_type * values = nullptr;
+    return detail::set_operation_impl<detail::set_intersection_op, Config>(
+        temporary_storage, storage_size,
+        keys_input1, keys_input2, keys_output,
+        values, values, values,
+        output_count, input1_size, input2_size, compare_function,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief Parallel intersection of sorted ranges of (key, value) pairs for device level.
+///
+/// \p set_intersection_by_key function computes the intersection of two ranges of (key, value)
+/// pairs sorted by keys, in the same way as \p set_intersection does for keys. The value of every
+/// output item is the value of the input item its key is taken from.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p keys_input1 and \p keys_input2 must be sorted with respect to
+/// \p compare_function.
+/// * The output is sorted with respect to \p compare_function. Equal keys of the first range
+/// precede equal keys of the second range.
+/// * Range specified by \p keys_output must have at least as many elements as the result,
+/// which is never more than <tt>input1_size + input2_size</tt>.
+/// * Range specified by \p values_output must have as many elements as \p keys_output.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p merge_config or
+/// a custom class with the same members.
+/// \tparam KeysInputIterator1 - random-access iterator type of the first keys input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysInputIterator2 - random-access iterator type of the second keys input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the keys output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesInputIterator1 - random-access iterator type of the first values input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesInputIterator2 - random-access iterator type of the second values input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesOutputIterator - random-access iterator type of the values output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam OutputCountIterator - random-access iterator type of the output count. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam BinaryFunction - type of binary function used for key comparisons. Default type
+/// is \p rocprim::less<T>, where \p T is a \p value_type of \p KeysInputIterator1.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input1 - iterator to the first key in the first sorted range.
+/// \param [in] keys_input2 - iterator to the first key in the second sorted range.
+/// \param [out] keys_output - iterator to the first key in the output range.
+/// \param [in] values_input1 - iterator to the first value in the first range.
+/// \param [in] values_input2 - iterator to the first value in the second range.
+/// \param [out] values_output - iterator to the first value in the output range.
+/// \param [out] output_count - iterator to the number of pairs written to the output ranges.
+/// \param [in] input1_size - number of element in the first input range.
+/// \param [in] input2_size - number of element in the second input range.
+/// \param [in] compare_function - binary operation function object that will be used for key comparison.
+/// The signature of the function should be equivalent to the following:
+/// <tt>bool f(const T &a, const T &b);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the objects passed to it.
+/// The default value is \p BinaryFunction().
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful operation; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<
+    class Config = default_config,
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class KeysOutputIterator,
+    class ValuesInputIterator1,
+    class ValuesInputIterator2,
+    class ValuesOutputIterator,
+    class OutputCountIterator,
+    class BinaryFunction = ::rocprim::less<typename std::iterator_traits<KeysInputIterator1>::value_type>
+>
+inline
+hipError_t set_intersection_by_key(void * temporary_storage,
+                                   size_t& storage_size,
+                                   KeysInputIterator1 keys_input1,
+                                   KeysInputIterator2 keys_input2,
+                                   KeysOutputIterator keys_output,
+                                   ValuesInputIterator1 values_input1,
+                                   ValuesInputIterator2 values_input2,
+                                   ValuesOutputIterator values_output,
+                                   OutputCountIterator output_count,
+                                   const size_t input1_size,
+                                   const size_t input2_size,
+                                   BinaryFunction compare_function = BinaryFunction(),
+                                   const hipStream_t stream = 0,
+                                   bool debug_synchronous = false)
+{
+    return detail::set_operation_impl<detail::set_intersection_op, Config>(
+        temporary_storage, storage_size,
+        keys_input1, keys_input2, keys_output,
+        values_input1, values_input2, values_output,
+        output_count, input1_size, input2_size, compare_function,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief Parallel difference of sorted ranges for device level.
+///
+/// \p set_difference function computes the difference of two sorted ranges: the items of the first
+/// range which are not matched by items of the second range. A key that occurs \p m times in the
+/// first range and \p n times in the second range occurs <tt>max(m - n, 0)</tt> times in the
+/// output.
+/// Both ranges are partitioned into tiles of their merged order with merge path. Each block merges
+/// its tile in shared memory, selects the output items and writes them at offsets computed with a
+/// single-pass look-back scan, so the inputs are read once.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p keys_input1 and \p keys_input2 must be sorted with respect to
+/// \p compare_function.
+/// * The output is sorted with respect to \p compare_function. Equal keys of the first range
+/// precede equal keys of the second range.
+/// * Range specified by \p keys_output must have at least as many elements as the result,
+/// which is never more than <tt>input1_size + input2_size</tt>.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p merge_config or
+/// a custom class with the same members.
+/// \tparam KeysInputIterator1 - random-access iterator type of the first input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysInputIterator2 - random-access iterator type of the second input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam OutputCountIterator - random-access iterator type of the output count. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam BinaryFunction - type of binary function used for comparisons. Default type
+/// is \p rocprim::less<T>, where \p T is a \p value_type of \p KeysInputIterator1.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input1 - iterator to the first element in the first sorted range.
+/// \param [in] keys_input2 - iterator to the first element in the second sorted range.
+/// \param [out] keys_output - iterator to the first element in the output range.
+/// \param [out] output_count - iterator to the number of elements written to the output range.
+/// \param [in] input1_size - number of element in the first input range.
+/// \param [in] input2_size - number of element in the second input range.
+/// \param [in] compare_function - binary operation function object that will be used for comparison.
+/// The signature of the function should be equivalent to the following:
+/// <tt>bool f(const T &a, const T &b);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the objects passed to it.
+/// The default value is \p BinaryFunction().
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful operation; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level difference of two ranges of \p int values is computed.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input1_size;     // e.g., 5
+/// size_t input2_size;     // e.g., 4
+/// int * input1;           // e.g., [1, 2, 2, 5, 6]
+/// int * input2;           // e.g., [2, 3, 5, 7]
+/// int * output;           // empty array of 9 elements
+/// size_t * output_count;  // empty array of 1 element
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::set_difference(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input1, input2, output, output_count, input1_size, input2_size
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // perform difference
+/// rocprim::set_difference(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input1, input2, output, output_count, input1_size, input2_size
+/// );
+/// // output: [1, 2, 6]
+/// // output_count: 3
+/// \endcode
+/// \endparblock
+template<
+    class Config = default_config,
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class KeysOutputIterator,
+    class OutputCountIterator,
+    class BinaryFunction = ::rocprim::less<typename std::iterator_traits<KeysInputIterator1>::value_type>
+>
+inline
+hipError_t set_difference(void * temporary_storage,
+                          size_t& storage_size,
+                          KeysInputIterator1 keys_input1,
+                          KeysInputIterator2 keys_input2,
+                          KeysOutputIterator keys_output,
+                          OutputCountIterator output_count,
+                          const size_t input1_size,
+                          const size_t input2_size,
+                          BinaryFunction compare_function = BinaryFunction(),
+                          const hipStream_t stream = 0,
+                          bool debug_synchronous = false)
+{
+    empty_type * values = nullptr;
+    return detail::set_operation_impl<detail::set_difference_op, Config>(
+        temporary_storage, storage_size,
+        keys_input1, keys_input2, keys_output,
+        values, values, values,
+        output_count, input1_size, input2_size, compare_function,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief Parallel difference of sorted ranges of (key, value) pairs for device level.
+///
+/// \p set_difference_by_key function computes the difference of two ranges of (key, value) pairs
+/// sorted by keys, in the same way as \p set_difference does for keys. The value of every output
+/// item is the value of the input item its key is taken from.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p keys_input1 and \p keys_input2 must be sorted with respect to
+/// \p compare_function.
+/// * The output is sorted with respect to \p compare_function. Equal keys of the first range
+/// precede equal keys of the second range.
+/// * Range specified by \p keys_output must have at least as many elements as the result,
+/// which is never more than <tt>input1_size + input2_size</tt>.
+/// * Range specified by \p values_output must have as many elements as \p keys_output.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p merge_config or
+/// a custom class with the same members.
+/// \tparam KeysInputIterator1 - random-access iterator type of the first keys input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysInputIterator2 - random-access iterator type of the second keys input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the keys output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesInputIterator1 - random-access iterator type of the first values input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesInputIterator2 - random-access iterator type of the second values input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesOutputIterator - random-access iterator type of the values output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam OutputCountIterator - random-access iterator type of the output count. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam BinaryFunction - type of binary function used for key comparisons. Default type
+/// is \p rocprim::less<T>, where \p T is a \p value_type of \p KeysInputIterator1.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input1 - iterator to the first key in the first sorted range.
+/// \param [in] keys_input2 - iterator to the first key in the second sorted range.
+/// \param [out] keys_output - iterator to the first key in the output range.
+/// \param [in] values_input1 - iterator to the first value in the first range.
+/// \param [in] values_input2 - iterator to the first value in the second range.
+/// \param [out] values_output - iterator to the first value in the output range.
+/// \param [out] output_count - iterator to the number of pairs written to the output ranges.
+/// \param [in] input1_size - number of element in the first input range.
+/// \param [in] input2_size - number of element in the second input range.
+/// \param [in] compare_function - binary operation function object that will be used for key comparison.
+/// The signature of the function should be equivalent to the following:
+/// <tt>bool f(const T &a, const T &b);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the objects passed to it.
+/// The default value is \p BinaryFunction().
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful operation; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<
+    class Config = default_config,
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class KeysOutputIterator,
+    class ValuesInputIterator1,
+    class ValuesInputIterator2,
+    class ValuesOutputIterator,
+    class OutputCountIterator,
+    class BinaryFunction = ::rocprim::less<typename std::iterator_traits<KeysInputIterator1>::value_type>
+>
+inline
+hipError_t set_difference_by_key(void * temporary_storage,
+                                 size_t& storage_size,
+                                 KeysInputIterator1 keys_input1,
+                                 KeysInputIterator2 keys_input2,
+                                 KeysOutputIterator keys_output,
+                                 ValuesInputIterator1 values_input1,
+                                 ValuesInputIterator2 values_input2,
+                                 ValuesOutputIterator values_output,
+                                 OutputCountIterator output_count,
+                                 const size_t input1_size,
+                                 const size_t input2_size,
+                                 BinaryFunction compare_function = BinaryFunction(),
+                                 const hipStream_t stream = 0,
+                                 bool debug_synchronous = false)
+{
+    return detail::set_operation_impl<detail::set_difference_op, Config>(
+        temporary_storage, storage_size,
+        keys_input1, keys_input2, keys_output,
+        values_input1, values_input2, values_output,
+        output_count, input1_size, input2_size, compare_function,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief Parallel symmetric difference of sorted ranges for device level.
+///
+/// \p set_symmetric_difference function computes the symmetric difference of two sorted ranges: the
+/// items of both ranges which are not matched by items of the other range. A key that occurs \p m
+/// times in the first range and \p n times in the second range occurs <tt>|m - n|</tt> times in the
+/// output.
+/// Both ranges are partitioned into tiles of their merged order with merge path. Each block merges
+/// its tile in shared memory, selects the output items and writes them at offsets computed with a
+/// single-pass look-back scan, so the inputs are read once.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p keys_input1 and \p keys_input2 must be sorted with respect to
+/// \p compare_function.
+/// * The output is sorted with respect to \p compare_function. Equal keys of the first range
+/// precede equal keys of the second range.
+/// * Range specified by \p keys_output must have at least as many elements as the result,
+/// which is never more than <tt>input1_size + input2_size</tt>.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p merge_config or
+/// a custom class with the same members.
+/// \tparam KeysInputIterator1 - random-access iterator type of the first input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysInputIterator2 - random-access iterator type of the second input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam OutputCountIterator - random-access iterator type of the output count. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam BinaryFunction - type of binary function used for comparisons. Default type
+/// is \p rocprim::less<T>, where \p T is a \p value_type of \p KeysInputIterator1.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input1 - iterator to the first element in the first sorted range.
+/// \param [in] keys_input2 - iterator to the first element in the second sorted range.
+/// \param [out] keys_output - iterator to the first element in the output range.
+/// \param [out] output_count - iterator to the number of elements written to the output range.
+/// \param [in] input1_size - number of element in the first input range.
+/// \param [in] input2_size - number of element in the second input range.
+/// \param [in] compare_function - binary operation function object that will be used for comparison.
+/// The signature of the function should be equivalent to the following:
+/// <tt>bool f(const T &a, const T &b);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the objects passed to it.
+/// The default value is \p BinaryFunction().
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful operation; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level symmetric difference of two ranges of \p int values is computed.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input1_size;     // e.g., 5
+/// size_t input2_size;     // e.g., 4
+/// int * input1;           // e.g., [1, 2, 2, 5, 6]
+/// int * input2;           // e.g., [2, 3, 5, 7]
+/// int * output;           // empty array of 9 elements
+/// size_t * output_count;  // empty array of 1 element
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::set_symmetric_difference(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input1, input2, output, output_count, input1_size, input2_size
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // perform symmetric difference
+/// rocprim::set_symmetric_difference(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input1, input2, output, output_count, input1_size, input2_size
+/// );
+/// // output: [1, 2, 3, 6, 7]
+/// // output_count: 5
+/// \endcode
+/// \endparblock
+template<
+    class Config = default_config,
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class KeysOutputIterator,
+    class OutputCountIterator,
+    class BinaryFunction = ::rocprim::less<typename std::iterator_traits<KeysInputIterator1>::value_type>
+>
+inline
+hipError_t set_symmetric_difference(void * temporary_storage,
+                                    size_t& storage_size,
+                                    KeysInputIterator1 keys_input1,
+                                    KeysInputIterator2 keys_input2,
+                                    KeysOutputIterator keys_output,
+                                    OutputCountIterator output_count,
+                                    const size_t input1_size,
+                                    const size_t input2_size,
+                                    BinaryFunction compare_function = BinaryFunction(),
+                                    const hipStream_t stream = 0,
+                                    bool debug_synchronous = false)
+{
+    empty_type * values = nullptr;
+    return detail::set_operation_impl<detail::set_symmetric_difference_op, Config>(
+        temporary_storage, storage_size,
+        keys_input1, keys_input2, keys_output,
+        values, values, values,
+        output_count, input1_size, input2_size, compare_function,
+        stream, debug_synchronous
+    );
+}
+
+/// \brief Parallel symmetric difference of sorted ranges of (key, value) pairs for device level.
+///
+/// \p set_symmetric_difference_by_key function computes the symmetric difference of two ranges of
+/// (key, value) pairs sorted by keys, in the same way as \p set_symmetric_difference does for keys.
+/// The value of every output item is the value of the input item its key is taken from.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered by the function.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p keys_input1 and \p keys_input2 must be sorted with respect to
+/// \p compare_function.
+/// * The output is sorted with respect to \p compare_function. Equal keys of the first range
+/// precede equal keys of the second range.
+/// * Range specified by \p keys_output must have at least as many elements as the result,
+/// which is never more than <tt>input1_size + input2_size</tt>.
+/// * Range specified by \p values_output must have as many elements as \p keys_output.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p merge_config or
+/// a custom class with the same members.
+/// \tparam KeysInputIterator1 - random-access iterator type of the first keys input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysInputIterator2 - random-access iterator type of the second keys input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the keys output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesInputIterator1 - random-access iterator type of the first values input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesInputIterator2 - random-access iterator type of the second values input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesOutputIterator - random-access iterator type of the values output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam OutputCountIterator - random-access iterator type of the output count. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam BinaryFunction - type of binary function used for key comparisons. Default type
+/// is \p rocprim::less<T>, where \p T is a \p value_type of \p KeysInputIterator1.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input1 - iterator to the first key in the first sorted range.
+/// \param [in] keys_input2 - iterator to the first key in the second sorted range.
+/// \param [out] keys_output - iterator to the first key in the output range.
+/// \param [in] values_input1 - iterator to the first value in the first range.
+/// \param [in] values_input2 - iterator to the first value in the second range.
+/// \param [out] values_output - iterator to the first value in the output range.
+/// \param [out] output_count - iterator to the number of pairs written to the output ranges.
+/// \param [in] input1_size - number of element in the first input range.
+/// \param [in] input2_size - number of element in the second input range.
+/// \param [in] compare_function - binary operation function object that will be used for key comparison.
+/// The signature of the function should be equivalent to the following:
+/// <tt>bool f(const T &a, const T &b);</tt>. The signature does not need to have
+/// <tt>const &</tt>, but function object must not modify the objects passed to it.
+/// The default value is \p BinaryFunction().
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful operation; otherwise a HIP runtime error of
+/// type \p hipError_t.
+template<
+    class Config = default_config,
+    class KeysInputIterator1,
+    class KeysInputIterator2,
+    class KeysOutputIterator,
+    class ValuesInputIterator1,
+    class ValuesInputIterator2,
+    class ValuesOutputIterator,
+    class OutputCountIterator,
+    class BinaryFunction = ::rocprim::less<typename std::iterator_traits<KeysInputIterator1>::value_type>
+>
+inline
+hipError_t set_symmetric_difference_by_key(void * temporary_storage,
+                                           size_t& storage_size,
+                                           KeysInputIterator1 keys_input1,
+                                           KeysInputIterator2 keys_input2,
+                                           KeysOutputIterator keys_output,
+                                           ValuesInputIterator1 values_input1,
+                                           ValuesInputIterator2 values_input2,
+                                           ValuesOutputIterator values_output,
+                                           OutputCountIterator output_count,
+                                           const size_t input1_size,
+                                           const size_t input2_size,
+                                           BinaryFunction compare_function = BinaryFunction(),
+                                           const hipStream_t stream = 0,
+                                           bool debug_synchronous = false)
+{
+    return detail::set_operation_impl<detail::set_symmetric_difference_op, Config>(
+        temporary_storage, storage_size,
+        keys_input1, keys_input2, keys_output,
+        values_input1, values_input2, values_output,
+        output_count, input1_size, input2_size, compare_function,
+        stream, debug_synchronous
+    );
+}
+
+/// @}
+// end of group devicemodule
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_SET_OPERATIONS_HPP_
@@ -0,0 +1,637 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_TOPK_HPP_
+#define ROCPRIM_DEVICE_DEVICE_TOPK_HPP_
+
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/radix_sort.hpp"
+#include "../detail/various.hpp"
+#include "../types.hpp"
+
+#include "detail/device_topk.hpp"
+#include "device_topk_config.hpp"
+#include "device_trace.hpp"
+
+/// \file
+///
+/// Device level selection primitives (nth element and top-k)
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule
+/// @{
+
+namespace detail
+{
+
+template<class Config, class BitKey>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::block_size) void topk_init_kernel(
+    topk_state<BitKey>* state, unsigned long long* digit_counts, const unsigned long long rank)
+{
+    topk_init<1u << device_target_arch_config_t<Config>::radix_bits>(state, digit_counts, rank);
+}
+
+template<class Config, bool Descending, class KeysInputIterator, class BitKey>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::block_size) void topk_count_digits_kernel(
+    KeysInputIterator         keys_input,
+    const size_t              size,
+    const topk_state<BitKey>* state,
+    unsigned long long*       digit_counts,
+    const unsigned int        bit,
+    const unsigned int        current_radix_bits)
+{
+    topk_count_digits<device_target_arch_config_t<Config>, Descending>(keys_input,
+                                                                       size,
+                                                                       state,
+                                                                       digit_counts,
+                                                                       bit,
+                                                                       current_radix_bits);
+}
+
+template<class Config, class BitKey>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::block_size) void topk_select_digit_kernel(
+    topk_state<BitKey>* state, unsigned long long* digit_counts, const unsigned int bit)
+{
+    topk_select_digit_device<device_target_arch_config_t<Config>>(state, digit_counts, bit);
+}
+
+template<class Config,
+         bool Descending,
+         bool WithValues,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator,
+         class BitKey>
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::block_size) void topk_scatter_kernel(
+    KeysInputIterator    keys_input,
+    KeysOutputIterator   keys_output,
+    ValuesInputIterator  values_input,
+    ValuesOutputIterator values_output,
+    const size_t         size,
+    const size_t         k,
+    topk_state<BitKey>*  state)
+{
+    topk_scatter<device_target_arch_config_t<Config>, Descending, WithValues>(keys_input,
+                                                                              keys_output,
+                                                                              values_input,
+                                                                              values_output,
+                                                                              size,
+                                                                              k,
+                                                                              state);
+}
+
+template<class Key, bool Descending, class BitKey, class KeysOutputIterator>
+ROCPRIM_KERNEL __launch_bounds__(1) void topk_write_key_kernel(const topk_state<BitKey>* state,
+                                                              KeysOutputIterator key_output)
+{
+    topk_write_key<Key, Descending>(state, key_output);
+}
+
+#define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start)                           \
+    {                                                                                            \
+        auto _error = hipGetLastError();                                                         \
+        if(_error != hipSuccess)                                                                 \
+            return _error;                                                                       \
+        ::rocprim::detail::kernel_trace_end(name, size, stream);                                 \
+        if(debug_synchronous)                                                                    \
+        {                                                                                        \
+            std::cout << name << "(" << size << ")";                                             \
+            auto __error = hipStreamSynchronize(stream);                                         \
+            if(__error != hipSuccess)                                                            \
+                return __error;                                                                  \
+            auto _end = std::chrono::high_resolution_clock::now();                               \
+            auto _d   = std::chrono::duration_cast<std::chrono::duration<double>>(_end - start); \
+            std::cout << " " << _d.count() * 1000 << " ms" << '\n';                              \
+        }                                                                                        \
+    }
+
+// Selects the k smallest keys in the order given by Descending. If OnlyKth is true, only the k-th
+// key is written to keys_output.
+template<class Config,
+         class ArchConfig,
+         bool Descending,
+         bool OnlyKth,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator>
+inline hipError_t topk_arch_impl(void*                temporary_storage,
+                                 size_t&              storage_size,
+                                 KeysInputIterator    keys_input,
+                                 KeysOutputIterator   keys_output,
+                                 ValuesInputIterator  values_input,
+                                 ValuesOutputIterator values_output,
+                                 const size_t         size,
+                                 const size_t         k,
+                                 const hipStream_t    stream,
+                                 const bool           debug_synchronous)
+{
+    using key_type   = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+
+    using config = ArchConfig;
+
+    using key_codec    = radix_key_codec<key_type, Descending>;
+    using bit_key_type = typename key_codec::bit_key_type;
+    using state_type   = topk_state<bit_key_type>;
+
+    constexpr bool         with_values     = !std::is_same<value_type, ::rocprim::empty_type>::value;
+    constexpr unsigned int block_size      = config::block_size;
+    constexpr unsigned int items_per_block = block_size * config::items_per_thread;
+    constexpr unsigned int radix_bits      = config::radix_bits;
+    constexpr unsigned int radix_size      = 1u << radix_bits;
+    constexpr unsigned int key_bits        = 8 * sizeof(bit_key_type);
+
+    static_assert(radix_size <= block_size, "Radix size must not exceed BlockSize");
+
+    const size_t state_bytes        = align_size(sizeof(state_type));
+    const size_t digit_counts_bytes = align_size(radix_size * sizeof(unsigned long long));
+    if(temporary_storage == nullptr)
+    {
+        storage_size = state_bytes + digit_counts_bytes;
+        return hipSuccess;
+    }
+
+    if(size == 0 || k == 0)
+    {
+        return hipSuccess;
+    }
+
+    auto* ptr   = static_cast<char*>(temporary_storage);
+    auto* state = reinterpret_cast<state_type*>(ptr);
+    ptr += state_bytes;
+    auto* digit_counts = reinterpret_cast<unsigned long long*>(ptr);
+
+    const unsigned int number_of_blocks
+        = static_cast<unsigned int>(ceiling_div(size, items_per_block));
+
+    if(debug_synchronous)
+    {
+        std::cout << "size:             " << size << '\n';
+        std::cout << "k:                " << k << '\n';
+        std::cout << "radix_bits:       " << radix_bits << '\n';
+        std::cout << "block_size:       " << block_size << '\n';
+        std::cout << "items_per_block:  " << items_per_block << '\n';
+        std::cout << "number of blocks: " << number_of_blocks << '\n';
+    }
+
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(debug_synchronous)
+        start = std::chrono::high_resolution_clock::now();
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(topk_init_kernel<Config>),
+                       dim3(1),
+                       dim3(block_size),
+                       0,
+                       stream,
+                       state,
+                       digit_counts,
+                       static_cast<unsigned long long>(k - 1));
+    ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("topk_init_kernel", 1, start);
+
+    // Resolve the digits of the k-th key starting from the most significant one
+    for(unsigned int bit = key_bits; bit > 0;)
+    {
+        const unsigned int current_radix_bits = ::rocprim::min(radix_bits, bit);
+        bit -= current_radix_bits;
+
+        if(debug_synchronous)
+            start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(topk_count_digits_kernel<Config, Descending>),
+                           dim3(number_of_blocks),
+                           dim3(block_size),
+                           0,
+                           stream,
+                           keys_input,
+                           size,
+                           state,
+                           digit_counts,
+                           bit,
+                           current_radix_bits);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("topk_count_digits_kernel", size, start);
+
+        if(debug_synchronous)
+            start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(topk_select_digit_kernel<Config>),
+                           dim3(1),
+                           dim3(block_size),
+                           0,
+                           stream,
+                           state,
+                           digit_counts,
+                           bit);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("topk_select_digit_kernel", radix_size, start);
+    }
+
+    if(debug_synchronous)
+        start = std::chrono::high_resolution_clock::now();
+    if(OnlyKth)
+    {
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(topk_write_key_kernel<key_type, Descending>),
+                           dim3(1),
+                           dim3(1),
+                           0,
+                           stream,
+                           state,
+                           keys_output);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("topk_write_key_kernel", 1, start);
+    }
+    else
+    {
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(topk_scatter_kernel<Config, Descending, with_values>),
+                           dim3(number_of_blocks),
+                           dim3(block_size),
+                           0,
+                           stream,
+                           keys_input,
+                           keys_output,
+                           values_input,
+                           values_output,
+                           size,
+                           k,
+                           state);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("topk_scatter_kernel", size, start);
+    }
+
+    return hipSuccess;
+}
+
+template<class Config,
+         bool Descending,
+         bool OnlyKth,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator>
+inline hipError_t topk_impl(void*                temporary_storage,
+                            size_t&              storage_size,
+                            KeysInputIterator    keys_input,
+                            KeysOutputIterator   keys_output,
+                            ValuesInputIterator  values_input,
+                            ValuesOutputIterator values_output,
+                            const size_t         size,
+                            const size_t         k,
+                            const hipStream_t    stream,
+                            const bool           debug_synchronous)
+{
+    using key_type   = typename std::iterator_traits<KeysInputIterator>::value_type;
+    using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = wrapped_topk_config<Config, key_type, value_type>;
+
+    return dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            return topk_arch_impl<config,
+                                  typename decltype(arch_config)::type,
+                                  Descending,
+                                  OnlyKth>(
+                temporary_storage,
+                storage_size,
+                keys_input,
+                keys_output,
+                values_input,
+                values_output,
+                size,
+                k,
+                stream,
+                debug_synchronous);
+        });
+}
+
+#undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
+
+} // end namespace detail
+
+/// \brief Parallel nth element selection primitive for device level.
+///
+/// nth_element function finds the key which would be at position \p nth if the range of
+/// \p keys_input was sorted in ascending order, and writes it to \p nth_output.
+/// The key is found by a radix select: the digits of the key are resolved from the most
+/// significant one by counting the digits of the keys which can still be the selected key,
+/// so no sort is performed and the time is linear in \p size.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Range specified by \p keys_input must have at least \p size elements.
+/// * \p nth must be less than \p size, otherwise \p hipErrorInvalidValue is returned.
+/// * Supports the same key types as \p radix_sort_keys (without a decomposer).
+/// Keys are ordered as by \p radix_sort_keys, e.g. -0.0 is smaller than +0.0.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p topk_config or
+/// a custom class with the same members.
+/// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the selection.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - pointer to the first element in the range to select from.
+/// \param [out] nth_output - iterator to the selected key.
+/// \param [in] size - number of element in the input range.
+/// \param [in] nth - position of the selected key in the sorted range.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful selection; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example a device-level median of an array of \p float values is found.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size;    // e.g., 7
+/// float * input;        // e.g., [0.6, 0.3, 0.65, 0.4, 0.2, 0.08, 1]
+/// float * output;       // empty array of 1 element
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::nth_element(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size, input_size / 2
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // select
+/// rocprim::nth_element(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size, input_size / 2
+/// );
+/// // output: [0.4]
+/// \endcode
+/// \endparblock
+template<class Config = default_config, class KeysInputIterator, class KeysOutputIterator>
+inline hipError_t nth_element(void*              temporary_storage,
+                              size_t&            storage_size,
+                              KeysInputIterator  keys_input,
+                              KeysOutputIterator nth_output,
+                              size_t             size,
+                              size_t             nth,
+                              hipStream_t        stream            = 0,
+                              bool               debug_synchronous = false)
+{
+    if(temporary_storage != nullptr && nth >= size)
+    {
+        return hipErrorInvalidValue;
+    }
+    ::rocprim::empty_type* values = nullptr;
+    return detail::topk_impl<Config, false, true>(temporary_storage,
+                                                  storage_size,
+                                                  keys_input,
+                                                  nth_output,
+                                                  values,
+                                                  values,
+                                                  size,
+                                                  nth + 1,
+                                                  stream,
+                                                  debug_synchronous);
+}
+
+/// \brief Parallel top-k selection primitive for device level.
+///
+/// topk_keys function writes the \p k largest keys of the range of \p keys_input to
+/// \p keys_output. The keys are selected by a radix select: the digits of the k-th largest key
+/// are resolved from the most significant one by counting the digits of the keys which can still
+/// be the k-th largest key, so no sort is performed and the time is linear in \p size.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Range specified by \p keys_input must have at least \p size elements.
+/// * Range specified by \p keys_output must have at least <tt>min(k, size)</tt> elements.
+/// * The order of the selected keys in \p keys_output is unspecified. If there are several keys
+/// equal to the k-th largest key, it is unspecified which of them are selected.
+/// * Supports the same key types as \p radix_sort_keys (without a decomposer).
+/// Keys are ordered as by \p radix_sort_keys, e.g. -0.0 is smaller than +0.0.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p topk_config or
+/// a custom class with the same members.
+/// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the selection.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - pointer to the first element in the range to select from.
+/// \param [out] keys_output - pointer to the first element in the output range.
+/// \param [in] size - number of element in the input range.
+/// \param [in] k - number of keys to select. If it exceeds \p size, all keys are selected.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful selection; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example the 3 largest of an array of \p int values are selected.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size;    // e.g., 8
+/// int * input;          // e.g., [6, 3, 5, 4, 1, 8, 2, 7]
+/// int * output;         // empty array of 3 elements
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::topk_keys(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size, 3
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // select
+/// rocprim::topk_keys(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, input_size, 3
+/// );
+/// // output: [8, 7, 6] (in any order)
+/// \endcode
+/// \endparblock
+template<class Config = default_config, class KeysInputIterator, class KeysOutputIterator>
+inline hipError_t topk_keys(void*              temporary_storage,
+                            size_t&            storage_size,
+                            KeysInputIterator  keys_input,
+                            KeysOutputIterator keys_output,
+                            size_t             size,
+                            size_t             k,
+                            hipStream_t        stream            = 0,
+                            bool               debug_synchronous = false)
+{
+    ::rocprim::empty_type* values = nullptr;
+    return detail::topk_impl<Config, true, false>(temporary_storage,
+                                                  storage_size,
+                                                  keys_input,
+                                                  keys_output,
+                                                  values,
+                                                  values,
+                                                  size,
+                                                  ::rocprim::min(k, size),
+                                                  stream,
+                                                  debug_synchronous);
+}
+
+/// \brief Parallel top-k selection primitive for device level, with values.
+///
+/// topk_pairs function writes the \p k largest keys of the range of \p keys_input to
+/// \p keys_output and their associated values to \p values_output. The keys are selected by
+/// a radix select (see \p topk_keys), so no sort is performed and the time is linear in \p size.
+///
+/// \par Overview
+/// * The contents of the inputs are not altered.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p keys_input and \p values_input must have at least \p size elements.
+/// * Ranges specified by \p keys_output and \p values_output must have at least
+/// <tt>min(k, size)</tt> elements.
+/// * The order of the selected pairs is unspecified. If there are several keys
+/// equal to the k-th largest key, it is unspecified which of them are selected.
+/// * Supports the same key types as \p radix_sort_keys (without a decomposer).
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p topk_config or
+/// a custom class with the same members.
+/// \tparam KeysInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam KeysOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesInputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam ValuesOutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the selection.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] keys_input - pointer to the first element in the range of keys to select from.
+/// \param [out] keys_output - pointer to the first element in the output range of keys.
+/// \param [in] values_input - pointer to the first element in the range of values.
+/// \param [out] values_output - pointer to the first element in the output range of values.
+/// \param [in] size - number of element in the input range.
+/// \param [in] k - number of pairs to select. If it exceeds \p size, all pairs are selected.
+/// \param [in] stream - [optional] HIP stream object. Default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. Default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful selection; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example the indices of the 2 largest scores are selected.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size;          // e.g., 6
+/// float * keys_input;         // e.g., [0.5, 0.9, 0.1, 0.7, 0.3, 0.2]
+/// int * values_input;         // e.g., [0, 1, 2, 3, 4, 5]
+/// float * keys_output;        // empty array of 2 elements
+/// int * values_output;        // empty array of 2 elements
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::topk_pairs(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     keys_input, keys_output, values_input, values_output,
+///     input_size, 2
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // select
+/// rocprim::topk_pairs(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     keys_input, keys_output, values_input, values_output,
+///     input_size, 2
+/// );
+/// // keys_output:   [0.9, 0.7] (in any order)
+/// // values_output: [1, 3]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class KeysInputIterator,
+         class KeysOutputIterator,
+         class ValuesInputIterator,
+         class ValuesOutputIterator>
+inline hipError_t topk_pairs(void*                temporary_storage,
+                             size_t&              storage_size,
+                             KeysInputIterator    keys_input,
+                             KeysOutputIterator   keys_output,
+                             ValuesInputIterator  values_input,
+                             ValuesOutputIterator values_output,
+                             size_t               size,
+                             size_t               k,
+                             hipStream_t          stream            = 0,
+                             bool                 debug_synchronous = false)
+{
+    return detail::topk_impl<Config, true, false>(temporary_storage,
+                                                  storage_size,
+                                                  keys_input,
+                                                  keys_output,
+                                                  values_input,
+                                                  values_output,
+                                                  size,
+                                                  ::rocprim::min(k, size),
+                                                  stream,
+                                                  debug_synchronous);
+}
+
+/// @}
+// end of group devicemodule
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_TOPK_HPP_
@@ -0,0 +1,86 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_TOPK_CONFIG_HPP_
+#define ROCPRIM_DEVICE_DEVICE_TOPK_CONFIG_HPP_
+
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+
+#include "config_types.hpp"
+
+/// \addtogroup primitivesmodule_deviceconfigs
+/// @{
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \brief Configuration of device-level selection primitives (\p nth_element, \p topk_keys,
+/// \p topk_pairs and their segmented variants).
+///
+/// \tparam RadixBits - number of bits of the keys resolved by each pass of the radix select.
+/// <tt>1 << RadixBits</tt> must not exceed \p BlockSize.
+/// \tparam BlockSize - number of threads in a block.
+/// \tparam ItemsPerThread - number of items processed by each thread.
+template<unsigned int RadixBits, unsigned int BlockSize, unsigned int ItemsPerThread>
+struct topk_config : kernel_config<BlockSize, ItemsPerThread>
+{
+    /// \brief Number of bits resolved by each pass.
+    static constexpr unsigned int radix_bits = RadixBits;
+};
+
+namespace detail
+{
+
+template<class Key, class Value>
+struct topk_config_fallback
+{
+    static constexpr unsigned int item_scale = ::rocprim::detail::ceiling_div<unsigned int>(
+        ::rocprim::max(sizeof(Key), sizeof(Value)), sizeof(int));
+
+    using type = topk_config<8, 256, ::rocprim::max(1u, 16u / item_scale)>;
+};
+
+template<unsigned int TargetArch, class Key, class Value>
+struct default_topk_config : select_arch<TargetArch, topk_config_fallback<Key, Value>>
+{
+};
+
+// Config of nth_element, topk and segmented topk per target architecture.
+template<class Config, class Key, class Value>
+struct wrapped_topk_config
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        using type
+            = arch_config_t<Config, default_topk_config<static_cast<unsigned int>(Arch), Key, Value>>;
+    };
+};
+
+} // end namespace detail
+
+END_ROCPRIM_NAMESPACE
+
+/// @}
+// end of group primitivesmodule_deviceconfigs
+
+#endif // ROCPRIM_DEVICE_DEVICE_TOPK_CONFIG_HPP_
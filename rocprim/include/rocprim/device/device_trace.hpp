@@ -0,0 +1,551 @@
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_TRACE_HPP_
+#define ROCPRIM_DEVICE_DEVICE_TRACE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <ostream>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../config.hpp"
+#include "../types.hpp"
+#include "config_types.hpp"
+
+/// \file
+///
+/// Tracing of the kernels launched by device level primitives
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule
+/// @{
+
+/// \brief Description of a kernel launched by a device level primitive.
+///
+/// The name, the stream, the number of items and the config are reported for every kernel.
+/// The launch geometry and the estimated traffic are reported by the kernels of radix sort,
+/// segmented radix sort, partition, select, reduce, scan, transform and merge sort; they are zero
+/// for the kernels of the other primitives.
+struct kernel_trace_record
+{
+    /// Name of the kernel, the same name that is printed when \p debug_synchronous is set.
+    const char* name = "";
+    /// Stream the kernel was launched on.
+    hipStream_t stream = 0;
+    /// Number of items processed by the kernel.
+    size_t items = 0;
+    /// Config of the kernel: the architecture the tuned config was selected for, for example
+    /// \p "gfx90a", or \p "default" if the device has no tuned configs. User supplied configs
+    /// are used on every architecture, then it is the architecture of the device.
+    const char* config = "";
+    /// Grid size of the launch.
+    dim3 grid_size = dim3(0, 0, 0);
+    /// Block size of the launch.
+    dim3 block_size = dim3(0, 0, 0);
+    /// Number of items processed by a thread in the selected configuration.
+    unsigned int items_per_thread = 0;
+    /// Estimated number of bytes read from global memory.
+    size_t bytes_read = 0;
+    /// Estimated number of bytes written to global memory.
+    size_t bytes_written = 0;
+    /// Time between the start and the end of the kernel in milliseconds, measured with events.
+    /// Negative if the kernel was not timed.
+    float elapsed_ms = -1.0f;
+};
+
+/// \brief Type of the function which receives the kernel trace records.
+///
+/// The function is called from the thread which launched the kernel, or from the thread which
+/// reports a timed record once its kernel has completed. It must not call HIP stream functions.
+using kernel_trace_callback = void (*)(const kernel_trace_record& record, void* user_data);
+
+/// \brief Controls how kernels are timed by the kernel trace.
+enum class kernel_trace_timing
+{
+    /// Kernels are not timed, every record is reported right after the launch.
+    none,
+    /// Kernels are timed with HIP events recorded around the launches. The stream is not
+    /// synchronized: the records are reported by later launches once their kernels have
+    /// completed, by \p flush_kernel_traces, or when the \p kernel_trace_scope which
+    /// requested them is destroyed.
+    events
+};
+
+namespace detail
+{
+
+struct kernel_trace_state
+{
+    kernel_trace_callback callback  = nullptr;
+    void*                 user_data = nullptr;
+    kernel_trace_timing   timing    = kernel_trace_timing::none;
+};
+
+struct kernel_trace_pending
+{
+    kernel_trace_record record;
+    kernel_trace_state  state;
+    // The scope which requested the record, nullptr for the global callback
+    const kernel_trace_state* owner;
+    hipEvent_t                start;
+    hipEvent_t                stop;
+};
+
+struct kernel_trace_context
+{
+    std::mutex         mutex;
+    std::atomic<bool>  enabled{false};
+    kernel_trace_state global_state;
+    // Timed records in launch order, per stream. Kernels of a stream complete in order,
+    // kernels of different streams in any order.
+    std::unordered_map<hipStream_t, std::deque<kernel_trace_pending>> pending;
+    std::vector<hipEvent_t>                                           free_events;
+};
+
+inline kernel_trace_context& get_kernel_trace_context()
+{
+    static kernel_trace_context context;
+    return context;
+}
+
+inline const kernel_trace_state*& get_thread_kernel_trace_state()
+{
+    thread_local const kernel_trace_state* state = nullptr;
+    return state;
+}
+
+// Description of the next launch, given before the launch by the primitives which know more
+// than the name and the size of their kernels
+struct kernel_trace_launch
+{
+    bool                valid = false;
+    kernel_trace_record record;
+    hipEvent_t          start = nullptr;
+};
+
+inline kernel_trace_launch& get_kernel_trace_launch()
+{
+    thread_local kernel_trace_launch launch;
+    return launch;
+}
+
+inline bool is_kernel_trace_enabled()
+{
+    return get_thread_kernel_trace_state() != nullptr
+           || get_kernel_trace_context().enabled.load(std::memory_order_relaxed);
+}
+
+inline kernel_trace_state get_kernel_trace_state()
+{
+    if(const kernel_trace_state* state = get_thread_kernel_trace_state())
+    {
+        return *state;
+    }
+    kernel_trace_context&       context = get_kernel_trace_context();
+    std::lock_guard<std::mutex> lock(context.mutex);
+    return context.global_state;
+}
+
+inline hipEvent_t acquire_kernel_trace_event(kernel_trace_context& context)
+{
+    {
+        std::lock_guard<std::mutex> lock(context.mutex);
+        if(!context.free_events.empty())
+        {
+            const hipEvent_t event = context.free_events.back();
+            context.free_events.pop_back();
+            return event;
+        }
+    }
+    hipEvent_t event = nullptr;
+    if(hipEventCreate(&event) != hipSuccess)
+    {
+        return nullptr;
+    }
+    return event;
+}
+
+// A pending record of a kernel_trace_scope is only reported by the thread of the scope, so that
+// its user_data cannot be used by another thread after the scope is destroyed. Records of the
+// global callback are reported by any thread.
+inline bool is_kernel_trace_reportable(const kernel_trace_pending& pending)
+{
+    return pending.owner == nullptr || pending.owner == get_thread_kernel_trace_state();
+}
+
+// Reports the timed records of the calling thread whose kernels have completed. If wait is true,
+// first waits for these records.
+inline void report_kernel_traces(const bool wait)
+{
+    kernel_trace_context& context = get_kernel_trace_context();
+    if(wait)
+    {
+        // Only the last record of every stream is waited for, the earlier ones complete before
+        // it. The events are synchronized without holding the lock. If another thread reports
+        // and reuses an event meanwhile, the wait only lasts until a later kernel.
+        std::vector<hipEvent_t> last_stops;
+        {
+            std::lock_guard<std::mutex> lock(context.mutex);
+            for(const auto& stream_pending : context.pending)
+            {
+                const std::deque<kernel_trace_pending>& queue = stream_pending.second;
+                for(auto it = queue.rbegin(); it != queue.rend(); ++it)
+                {
+                    if(is_kernel_trace_reportable(*it))
+                    {
+                        last_stops.push_back(it->stop);
+                        break;
+                    }
+                }
+            }
+        }
+        for(const hipEvent_t stop : last_stops)
+        {
+            static_cast<void>(hipEventSynchronize(stop));
+        }
+    }
+
+    std::vector<kernel_trace_pending> completed;
+    {
+        std::lock_guard<std::mutex> lock(context.mutex);
+        for(auto stream_it = context.pending.begin(); stream_it != context.pending.end();)
+        {
+            // Kernels of a stream complete in order, so the first incomplete record ends the
+            // search. Records of other threads' scopes are left in the queue.
+            std::deque<kernel_trace_pending>& queue = stream_it->second;
+            for(auto it = queue.begin(); it != queue.end();)
+            {
+                if(!is_kernel_trace_reportable(*it))
+                {
+                    ++it;
+                    continue;
+                }
+                if(hipEventQuery(it->stop) != hipSuccess)
+                {
+                    break;
+                }
+                static_cast<void>(
+                    hipEventElapsedTime(&it->record.elapsed_ms, it->start, it->stop));
+                context.free_events.push_back(it->start);
+                context.free_events.push_back(it->stop);
+                completed.push_back(std::move(*it));
+                it = queue.erase(it);
+            }
+            stream_it = queue.empty() ? context.pending.erase(stream_it) : std::next(stream_it);
+        }
+    }
+    for(const kernel_trace_pending& pending : completed)
+    {
+        pending.state.callback(pending.record, pending.state.user_data);
+    }
+}
+
+inline const char* get_kernel_trace_config(const target_arch arch)
+{
+    switch(arch)
+    {
+        case target_arch::gfx803: return "gfx803";
+        case target_arch::gfx900: return "gfx900";
+        case target_arch::gfx906: return "gfx906";
+        case target_arch::gfx908: return "gfx908";
+        case target_arch::gfx90a: return "gfx90a";
+        case target_arch::gfx1030: return "gfx1030";
+        case target_arch::unknown: return "default";
+        case target_arch::invalid: return "";
+    }
+    return "";
+}
+
+// Size of the items of an input iterator, for estimating the traffic of kernels
+template<class Iterator>
+constexpr size_t kernel_trace_item_bytes()
+{
+    using value_type = typename std::iterator_traits<Iterator>::value_type;
+    return std::is_same<value_type, ::rocprim::empty_type>::value ? 0 : sizeof(value_type);
+}
+
+inline bool is_stream_capturing(const hipStream_t stream)
+{
+    hipStreamCaptureStatus status = hipStreamCaptureStatusNone;
+    return hipStreamIsCapturing(stream, &status) == hipSuccess
+           && status != hipStreamCaptureStatusNone;
+}
+
+/// \brief Describes the next kernel launch on \p stream for the kernel trace, and records the
+/// start event if the kernels are timed. Must be followed by the launch and by
+/// \p kernel_trace_end.
+inline void kernel_trace_begin(const hipStream_t  stream,
+                               const dim3         grid_size,
+                               const dim3         block_size,
+                               const unsigned int items_per_thread,
+                               const size_t       bytes_read,
+                               const size_t       bytes_written)
+{
+    kernel_trace_launch& launch = get_kernel_trace_launch();
+    launch.valid                = false;
+    if(!is_kernel_trace_enabled())
+    {
+        return;
+    }
+    launch.valid                   = true;
+    launch.record                  = kernel_trace_record{};
+    launch.record.stream           = stream;
+    launch.record.grid_size        = grid_size;
+    launch.record.block_size       = block_size;
+    launch.record.items_per_thread = items_per_thread;
+    launch.record.bytes_read       = bytes_read;
+    launch.record.bytes_written    = bytes_written;
+    launch.start                   = nullptr;
+
+    // Events cannot be queried in graphs, launches which are captured are not timed
+    if(get_kernel_trace_state().timing == kernel_trace_timing::events
+       && !is_stream_capturing(stream))
+    {
+        launch.start = acquire_kernel_trace_event(get_kernel_trace_context());
+        if(launch.start != nullptr && hipEventRecord(launch.start, stream) != hipSuccess)
+        {
+            std::lock_guard<std::mutex> lock(get_kernel_trace_context().mutex);
+            get_kernel_trace_context().free_events.push_back(launch.start);
+            launch.start = nullptr;
+        }
+    }
+}
+
+/// \brief Reports the kernel which was just launched on \p stream. Called after every launch
+/// by the device level primitives.
+inline void kernel_trace_end(const char* name, const size_t items, const hipStream_t stream)
+{
+    kernel_trace_launch& launch = get_kernel_trace_launch();
+    if(!is_kernel_trace_enabled())
+    {
+        launch.valid = false;
+        return;
+    }
+    const kernel_trace_state state = get_kernel_trace_state();
+    if(state.callback == nullptr)
+    {
+        launch.valid = false;
+        return;
+    }
+
+    kernel_trace_record record;
+    hipEvent_t          start = nullptr;
+    if(launch.valid && launch.record.stream == stream)
+    {
+        record = launch.record;
+        start  = launch.start;
+    }
+    launch.valid  = false;
+    record.name   = name;
+    record.stream = stream;
+    record.items  = items;
+    record.config = get_kernel_trace_config(get_thread_selected_target_arch());
+
+    kernel_trace_context& context = get_kernel_trace_context();
+    if(start != nullptr)
+    {
+        const hipEvent_t stop = acquire_kernel_trace_event(context);
+        if(stop != nullptr && hipEventRecord(stop, stream) == hipSuccess)
+        {
+            {
+                std::lock_guard<std::mutex> lock(context.mutex);
+                context.pending[stream].push_back(kernel_trace_pending{
+                    record, state, get_thread_kernel_trace_state(), start, stop});
+            }
+            report_kernel_traces(false);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(context.mutex);
+        context.free_events.push_back(start);
+        if(stop != nullptr)
+        {
+            context.free_events.push_back(stop);
+        }
+    }
+    state.callback(record, state.user_data);
+}
+
+} // end namespace detail
+
+/// \brief Sets the function which receives the trace records of the kernels launched by device
+/// level primitives in all threads.
+///
+/// \par Overview
+/// * Tracing does not synchronize the streams. With \p kernel_trace_timing::events the kernels
+/// are timed with events, and the records are reported once the kernels have completed.
+/// * A \p kernel_trace_scope of a thread overrides the global callback in that thread.
+/// * Passing \p nullptr as \p callback disables tracing. The timed records which are not
+/// reported yet are reported by \p flush_kernel_traces.
+///
+/// \param [in] callback - function which receives the records, or \p nullptr.
+/// \param [in] user_data - [optional] pointer passed to \p callback.
+/// \param [in] timing - [optional] how the kernels are timed. Default is
+/// \p kernel_trace_timing::none.
+///
+/// \par Example
+/// \parblock
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// std::ofstream trace_file("trace.jsonl");
+/// rocprim::json_lines_trace_sink sink(trace_file);
+/// rocprim::set_kernel_trace(rocprim::json_lines_trace_sink::callback,
+///                           &sink,
+///                           rocprim::kernel_trace_timing::events);
+///
+/// rocprim::radix_sort_keys(temporary_storage_ptr, temporary_storage_size_bytes,
+///                          input, output, input_size);
+///
+/// // Write the records of the kernels which are still running
+/// rocprim::flush_kernel_traces();
+/// rocprim::set_kernel_trace(nullptr);
+/// \endcode
+/// \endparblock
+inline void set_kernel_trace(kernel_trace_callback callback,
+                             void*                 user_data = nullptr,
+                             kernel_trace_timing   timing    = kernel_trace_timing::none)
+{
+    detail::kernel_trace_context& context = detail::get_kernel_trace_context();
+    std::lock_guard<std::mutex>   lock(context.mutex);
+    context.global_state.callback  = callback;
+    context.global_state.user_data = user_data;
+    context.global_state.timing    = timing;
+    context.enabled.store(callback != nullptr, std::memory_order_relaxed);
+}
+
+/// \brief Waits for the kernels which are timed and not reported yet, and reports them.
+///
+/// Reports the records of the global callback and of the current \p kernel_trace_scope of the
+/// calling thread. The records of other threads' scopes are reported by those threads.
+///
+/// \returns \p hipSuccess (\p 0).
+inline hipError_t flush_kernel_traces()
+{
+    detail::report_kernel_traces(true);
+    return hipSuccess;
+}
+
+/// \brief Sets the kernel trace callback of the calling thread for the lifetime of the object.
+///
+/// This allows tracing single calls of device level primitives: only the kernels launched by the
+/// thread while the scope exists are reported to \p callback. Scopes can be nested, the previous
+/// callback of the thread is restored by the destructor.
+class kernel_trace_scope
+{
+public:
+    /// \brief Sets the callback of the calling thread.
+    ///
+    /// \param [in] callback - function which receives the records, or \p nullptr to disable
+    /// tracing in the scope.
+    /// \param [in] user_data - [optional] pointer passed to \p callback.
+    /// \param [in] timing - [optional] how the kernels are timed. Default is
+    /// \p kernel_trace_timing::none.
+    explicit kernel_trace_scope(kernel_trace_callback callback,
+                                void*                 user_data = nullptr,
+                                kernel_trace_timing   timing    = kernel_trace_timing::none)
+        : previous_(detail::get_thread_kernel_trace_state())
+    {
+        state_.callback                         = callback;
+        state_.user_data                        = user_data;
+        state_.timing                           = timing;
+        detail::get_thread_kernel_trace_state() = &state_;
+    }
+
+    kernel_trace_scope(const kernel_trace_scope&) = delete;
+    kernel_trace_scope& operator=(const kernel_trace_scope&) = delete;
+
+    /// \brief Restores the previous callback of the calling thread.
+    ///
+    /// With \p kernel_trace_timing::events, first waits for the kernels of the scope which
+    /// are not reported yet and reports them, because their records use \p user_data. Records
+    /// of a scope are only reported by its thread, so none are reported after the destructor.
+    ~kernel_trace_scope()
+    {
+        if(state_.timing == kernel_trace_timing::events)
+        {
+            detail::report_kernel_traces(true);
+        }
+        detail::get_thread_kernel_trace_state() = previous_;
+    }
+
+private:
+    detail::kernel_trace_state        state_;
+    const detail::kernel_trace_state* previous_;
+};
+
+/// \brief Kernel trace callback which writes every record as a JSON object on a separate line.
+///
+/// Example of a line:
+/// <tt>{"kernel":"onesweep_iteration","stream":"0x0","items":1048576,"config":"gfx90a",
+/// "grid":[256,1,1],"block":[256,1,1],"items_per_thread":16,"bytes_read":4194304,
+/// "bytes_written":4194304,"elapsed_ms":0.0421}</tt>
+///
+/// Writes are serialized, the sink can be shared by several threads.
+class json_lines_trace_sink
+{
+public:
+    /// \brief Constructs the sink writing to \p stream, which must outlive the sink.
+    explicit json_lines_trace_sink(std::ostream& stream) : stream_(stream) {}
+
+    /// \brief Writes \p record.
+    void operator()(const kernel_trace_record& record)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stream_ << "{\"kernel\":\"" << record.name << "\",\"stream\":\""
+                << static_cast<const void*>(record.stream) << "\",\"items\":" << record.items
+                << ",\"config\":\"" << record.config << "\",\"grid\":[" << record.grid_size.x
+                << ',' << record.grid_size.y << ',' << record.grid_size.z << "],\"block\":["
+                << record.block_size.x << ',' << record.block_size.y << ',' << record.block_size.z
+                << "],\"items_per_thread\":" << record.items_per_thread
+                << ",\"bytes_read\":" << record.bytes_read
+                << ",\"bytes_written\":" << record.bytes_written;
+        if(record.elapsed_ms >= 0.0f)
+        {
+            stream_ << ",\"elapsed_ms\":" << record.elapsed_ms;
+        }
+        stream_ << "}\n";
+    }
+
+    /// \brief Function to pass to \p set_kernel_trace or \p kernel_trace_scope, with the sink
+    /// as \p user_data.
+    static void callback(const kernel_trace_record& record, void* user_data)
+    {
+        (*static_cast<json_lines_trace_sink*>(user_data))(record);
+    }
+
+private:
+    std::mutex    mutex_;
+    std::ostream& stream_;
+};
+
+/// @}
+// end of group devicemodule
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_TRACE_HPP_
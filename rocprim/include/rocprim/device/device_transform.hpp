@@ -34,6 +34,7 @@
 
 #include "device_transform_config.hpp"
 #include "detail/device_transform.hpp"
+#include "device_trace.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -44,21 +45,21 @@ namespace detail
 {
 
 template<
-    unsigned int BlockSize,
-    unsigned int ItemsPerThread,
+    class Config,
     class ResultType,
     class InputIterator,
     class OutputIterator,
     class UnaryFunction
 >
 ROCPRIM_KERNEL
-__launch_bounds__(BlockSize)
+__launch_bounds__(device_target_arch_config_t<Config>::block_size)
 void transform_kernel(InputIterator input,
                       const size_t size,
                       OutputIterator output,
                       UnaryFunction transform_op)
 {
-    transform_kernel_impl<BlockSize, ItemsPerThread, ResultType>(
+    using config = device_target_arch_config_t<Config>;
+    transform_kernel_impl<config::block_size, config::items_per_thread, ResultType>(
         input, size, output, transform_op
     );
 }
@@ -67,6 +68,7 @@ void transform_kernel(InputIterator input,
     { \
         auto _error = hipGetLastError(); \
         if(_error != hipSuccess) return _error; \
+        ::rocprim::detail::kernel_trace_end(name, size, stream); \
         if(debug_synchronous) \
         { \
             std::cout << name << "(" << size << ")"; \
@@ -78,6 +80,75 @@ void transform_kernel(InputIterator input,
         } \
     }
 
+template<
+    class Config,
+    class ArchConfig,
+    class InputIterator,
+    class OutputIterator,
+    class UnaryFunction
+>
+inline
+hipError_t transform_impl(InputIterator input,
+                          OutputIterator output,
+                          const size_t size,
+                          UnaryFunction transform_op,
+                          const hipStream_t stream,
+                          bool debug_synchronous)
+{
+    using input_type = typename std::iterator_traits<InputIterator>::value_type;
+    using result_type = typename ::rocprim::detail::invoke_result<UnaryFunction, input_type>::type;
+
+    using config = ArchConfig;
+
+    static constexpr unsigned int block_size = config::block_size;
+    static constexpr unsigned int items_per_thread = config::items_per_thread;
+    static constexpr auto items_per_block = block_size * items_per_thread;
+
+    // Start point for time measurements
+    std::chrono::high_resolution_clock::time_point start;
+
+    static constexpr auto size_limit = config::size_limit;
+    static constexpr auto number_of_blocks_limit
+        = ::rocprim::max<size_t>(size_limit / items_per_block, 1);
+
+    auto number_of_blocks = (size + items_per_block - 1)/items_per_block;
+    if(debug_synchronous)
+    {
+        std::cout << "block_size " << block_size << '\n';
+        std::cout << "number of blocks " << number_of_blocks << '\n';
+        std::cout << "number of blocks limit " << number_of_blocks_limit << '\n';
+        std::cout << "items_per_block " << items_per_block << '\n';
+    }
+
+    static constexpr auto aligned_size_limit = number_of_blocks_limit * items_per_block;
+
+    // Launch number_of_blocks_limit blocks while there is still at least as many blocks left as the limit
+    const auto number_of_launch = (size + aligned_size_limit - 1) / aligned_size_limit;
+    for(size_t i = 0, offset = 0; i < number_of_launch; ++i, offset += aligned_size_limit) {
+        const auto current_size = std::min(size - offset, aligned_size_limit);
+        const auto current_blocks = (current_size + items_per_block - 1) / items_per_block;
+
+        kernel_trace_begin(stream,
+                           dim3(current_blocks),
+                           dim3(block_size),
+                           items_per_thread,
+                           current_size * kernel_trace_item_bytes<InputIterator>(),
+                           current_size * sizeof(result_type));
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(transform_kernel<
+                Config, result_type,
+                InputIterator, OutputIterator, UnaryFunction
+            >),
+            dim3(current_blocks), dim3(block_size), 0, stream,
+            input + offset, current_size, output + offset, transform_op
+        );
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("transform_kernel", current_size, start);
+    }
+
+    return hipSuccess;
+}
+
 } // end of detail namespace
 
 /// \brief Parallel transform primitive for device level.
@@ -154,53 +225,17 @@ hipError_t transform(InputIterator input,
     using input_type = typename std::iterator_traits<InputIterator>::value_type;
     using result_type = typename ::rocprim::detail::invoke_result<UnaryFunction, input_type>::type;
 
-    // Get default config if Config is default_config
-    using config = detail::default_or_custom_config<
-        Config,
-        detail::default_transform_config<ROCPRIM_TARGET_ARCH, result_type>
-    >;
+    // Get the config of the target architecture, or Config if it is not default_config
+    using config = detail::wrapped_transform_config<Config, result_type>;
 
-    static constexpr unsigned int block_size = config::block_size;
-    static constexpr unsigned int items_per_thread = config::items_per_thread;
-    static constexpr auto items_per_block = block_size * items_per_thread;
-
-    // Start point for time measurements
-    std::chrono::high_resolution_clock::time_point start;
-
-    static constexpr auto size_limit = config::size_limit;
-    static constexpr auto number_of_blocks_limit
-        = ::rocprim::max<size_t>(size_limit / items_per_block, 1);
-
-    auto number_of_blocks = (size + items_per_block - 1)/items_per_block;
-    if(debug_synchronous)
-    {
-        std::cout << "block_size " << block_size << '\n';
-        std::cout << "number of blocks " << number_of_blocks << '\n';
-        std::cout << "number of blocks limit " << number_of_blocks_limit << '\n';
-        std::cout << "items_per_block " << items_per_block << '\n';
-    }
-
-    static constexpr auto aligned_size_limit = number_of_blocks_limit * items_per_block;
-
-    // Launch number_of_blocks_limit blocks while there is still at least as many blocks left as the limit
-    const auto number_of_launch = (size + aligned_size_limit - 1) / aligned_size_limit;
-    for(size_t i = 0, offset = 0; i < number_of_launch; ++i, offset += aligned_size_limit) {
-        const auto current_size = std::min(size - offset, aligned_size_limit);
-        const auto current_blocks = (current_size + items_per_block - 1) / items_per_block;
-
-        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
-        hipLaunchKernelGGL(
-            HIP_KERNEL_NAME(detail::transform_kernel<
-                block_size, items_per_thread, result_type,
-                InputIterator, OutputIterator, UnaryFunction
-            >),
-            dim3(current_blocks), dim3(block_size), 0, stream,
-            input + offset, current_size, output + offset, transform_op
-        );
-        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("transform_kernel", current_size, start);
-    }
-
-    return hipSuccess;
+    return detail::dispatch_target_arch_config<config>(
+        stream,
+        [&](auto arch_config)
+        {
+            return detail::transform_impl<config, typename decltype(arch_config)::type>(
+                input, output, size, transform_op, stream, debug_synchronous
+            );
+        });
 }
 
 /// \brief Parallel device-level transform primitive for two inputs.
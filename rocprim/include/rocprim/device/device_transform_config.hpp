@@ -90,6 +90,18 @@ struct default_transform_config
         transform_config_900<Value>
     > { };
 
+// Config of transform per target architecture.
+template<class Config, class Value>
+struct wrapped_transform_config
+{
+    template<target_arch Arch>
+    struct architecture_config
+    {
+        using type
+            = arch_config_t<Config, default_transform_config<static_cast<unsigned int>(Arch), Value>>;
+    };
+};
+
 } // end namespace detail
 
 END_ROCPRIM_NAMESPACE
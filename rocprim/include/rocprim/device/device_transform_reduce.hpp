@@ -0,0 +1,545 @@
+// Copyright (c) 2017-2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef ROCPRIM_DEVICE_DEVICE_TRANSFORM_REDUCE_HPP_
+#define ROCPRIM_DEVICE_DEVICE_TRANSFORM_REDUCE_HPP_
+
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+
+#include "../config.hpp"
+#include "../detail/various.hpp"
+#include "../functional.hpp"
+#include "../types/integer_sequence.hpp"
+#include "../types/tuple.hpp"
+
+#include "detail/device_transform_reduce.hpp"
+#include "device_reduce.hpp"
+#include "device_reduce_config.hpp"
+#include "device_trace.hpp"
+
+/// \file
+///
+/// Device level transform-reduce and multi-reduce primitives
+
+BEGIN_ROCPRIM_NAMESPACE
+
+/// \addtogroup devicemodule
+/// @{
+
+namespace detail
+{
+
+template<bool WithInitialValue,
+         class Config,
+         class InputIterator,
+         class OutputIterators,
+         class Reductions>
+ROCPRIM_KERNEL __launch_bounds__(device_params<Config>().block_size) void multi_reduce_kernel(
+    InputIterator   input,
+    const size_t    size,
+    OutputIterators outputs,
+    Reductions      reductions)
+{
+    multi_reduce_kernel_impl<WithInitialValue, Config>(
+        input,
+        size,
+        outputs,
+        reductions,
+        ::rocprim::make_index_sequence<::rocprim::tuple_size<Reductions>::value>{});
+}
+
+#define ROCPRIM_DETAIL_HIP_SYNC(name, size, start) \
+    if(debug_synchronous) \
+    { \
+        std::cout << name << "(" << size << ")"; \
+        auto _error = hipStreamSynchronize(stream); \
+        if(_error != hipSuccess) return _error; \
+        auto _end = std::chrono::high_resolution_clock::now(); \
+        auto _d = std::chrono::duration_cast<std::chrono::duration<double>>(_end - start); \
+        std::cout << " " << _d.count() * 1000 << " ms" << '\n'; \
+    }
+
+#define ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR(name, size, start) \
+    { \
+        auto _error = hipGetLastError(); \
+        if(_error != hipSuccess) return _error; \
+        ::rocprim::detail::kernel_trace_end(name, size, stream); \
+        if(debug_synchronous) \
+        { \
+            std::cout << name << "(" << size << ")"; \
+            auto __error = hipStreamSynchronize(stream); \
+            if(__error != hipSuccess) return __error; \
+            auto _end = std::chrono::high_resolution_clock::now(); \
+            auto _d = std::chrono::duration_cast<std::chrono::duration<double>>(_end - start); \
+            std::cout << " " << _d.count() * 1000 << " ms" << '\n'; \
+        } \
+    }
+
+// Reduces the partial results of the blocks of every reduction to its output. Each reduction
+// is a separate reduce of its own accumulator type, so it uses the config tuned for that type.
+// When temporary_storage is a null pointer, storage_size is the largest storage of them.
+template<bool WithInitialValue, class Config, class Partials, class OutputIterators, class Reductions>
+inline hipError_t multi_reduce_partials_impl(std::integral_constant<size_t, 0>,
+                                             void*,
+                                             size_t&,
+                                             const Partials&,
+                                             const size_t,
+                                             const OutputIterators&,
+                                             const Reductions&,
+                                             const hipStream_t,
+                                             const bool)
+{
+    return hipSuccess;
+}
+
+template<bool WithInitialValue,
+         class Config,
+         class Partials,
+         class OutputIterators,
+         class Reductions,
+         size_t Count>
+inline hipError_t multi_reduce_partials_impl(std::integral_constant<size_t, Count>,
+                                             void*                  temporary_storage,
+                                             size_t&                storage_size,
+                                             const Partials&        partials,
+                                             const size_t           number_of_partials,
+                                             const OutputIterators& outputs,
+                                             const Reductions&      reductions,
+                                             const hipStream_t      stream,
+                                             const bool             debug_synchronous)
+{
+    constexpr size_t index = Count - 1;
+    hipError_t       error = multi_reduce_partials_impl<WithInitialValue, Config>(
+        std::integral_constant<size_t, index>{},
+        temporary_storage,
+        storage_size,
+        partials,
+        number_of_partials,
+        outputs,
+        reductions,
+        stream,
+        debug_synchronous);
+    if(error != hipSuccess)
+    {
+        return error;
+    }
+
+    using accumulator_type = multi_reduce_accumulator_t<index, Reductions>;
+    const auto& reduction  = ::rocprim::get<index>(reductions);
+
+    size_t reduce_storage_size = storage_size;
+    error                      = reduce_impl<WithInitialValue, Config>(
+        temporary_storage,
+        reduce_storage_size,
+        ::rocprim::get<index>(partials),
+        ::rocprim::get<index>(outputs),
+        static_cast<accumulator_type>(::rocprim::get<2>(reduction)),
+        number_of_partials,
+        ::rocprim::get<1>(reduction),
+        stream,
+        debug_synchronous);
+    if(temporary_storage == nullptr)
+    {
+        storage_size = ::rocprim::max(storage_size, reduce_storage_size);
+    }
+    return error;
+}
+
+template<bool WithInitialValue, class Config, class InputIterator, class OutputIterators, class Reductions>
+inline hipError_t multi_reduce_impl(void*                  temporary_storage,
+                                    size_t&                storage_size,
+                                    InputIterator          input,
+                                    const OutputIterators& outputs,
+                                    const size_t           size,
+                                    const Reductions&      reductions,
+                                    const hipStream_t      stream,
+                                    const bool             debug_synchronous)
+{
+    using input_type = typename std::iterator_traits<InputIterator>::value_type;
+    using partials   = multi_reduce_partials<Reductions>;
+
+    // The values are loaded once for all reductions, so the config is selected for the input type
+    using config = wrapped_reduce_config<Config, input_type>;
+
+    constexpr size_t reductions_count = ::rocprim::tuple_size<Reductions>::value;
+
+    detail::target_arch target_arch;
+    hipError_t          result = host_target_arch(stream, target_arch);
+    if(result != hipSuccess)
+    {
+        return result;
+    }
+    const reduce_config_params params = dispatch_target_arch<config>(target_arch);
+
+    const unsigned int block_size       = params.block_size;
+    const unsigned int items_per_thread = params.items_per_thread;
+    const auto         items_per_block  = block_size * items_per_thread;
+
+    const size_t number_of_blocks       = (size + items_per_block - 1) / items_per_block;
+    const auto   number_of_blocks_limit
+        = ::rocprim::max<size_t>(params.size_limit / items_per_block, 1);
+    const size_t partials_bytes
+        = number_of_blocks > 1 ? partials::get_storage_bytes(number_of_blocks) : 0;
+
+    if(temporary_storage == nullptr)
+    {
+        size_t reduce_storage_size = 0;
+        if(number_of_blocks > 1)
+        {
+            result = multi_reduce_partials_impl<WithInitialValue, Config>(
+                std::integral_constant<size_t, reductions_count>{},
+                nullptr,
+                reduce_storage_size,
+                typename partials::type{},
+                number_of_blocks,
+                outputs,
+                reductions,
+                stream,
+                debug_synchronous);
+            if(result != hipSuccess)
+            {
+                return result;
+            }
+        }
+        storage_size = partials_bytes + reduce_storage_size;
+        // Make sure user won't try to allocate 0 bytes memory
+        storage_size = storage_size == 0 ? 4 : storage_size;
+        return hipSuccess;
+    }
+
+    // Start point for time measurements
+    std::chrono::high_resolution_clock::time_point start;
+
+    if(debug_synchronous)
+    {
+        std::cout << "block_size " << block_size << '\n';
+        std::cout << "number of blocks " << number_of_blocks << '\n';
+        std::cout << "number of blocks limit " << number_of_blocks_limit << '\n';
+        std::cout << "items_per_block " << items_per_block << '\n';
+    }
+
+    if(number_of_blocks > 1)
+    {
+        const typename partials::type block_partials
+            = partials::get(temporary_storage, number_of_blocks);
+        const auto aligned_size_limit = number_of_blocks_limit * items_per_block;
+
+        // Launch number_of_blocks_limit blocks while there is still at least as many blocks left as the limit
+        const auto number_of_launch = (size + aligned_size_limit - 1) / aligned_size_limit;
+        for(size_t i = 0, offset = 0; i < number_of_launch; ++i, offset += aligned_size_limit)
+        {
+            const auto current_size   = std::min<size_t>(size - offset, aligned_size_limit);
+            const auto current_blocks = (current_size + items_per_block - 1) / items_per_block;
+
+            kernel_trace_begin(stream,
+                               dim3(current_blocks),
+                               dim3(block_size),
+                               items_per_thread,
+                               current_size * kernel_trace_item_bytes<InputIterator>(),
+                               current_blocks * partials::accumulators_bytes());
+            if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+            hipLaunchKernelGGL(HIP_KERNEL_NAME(detail::multi_reduce_kernel<false, config>),
+                               dim3(current_blocks),
+                               dim3(block_size),
+                               0,
+                               stream,
+                               input + offset,
+                               current_size,
+                               partials::advance(block_partials, i * number_of_blocks_limit),
+                               reductions);
+            ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("multi_reduce_kernel", current_size, start);
+        }
+
+        size_t reduce_storage_size = storage_size - partials_bytes;
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        result = multi_reduce_partials_impl<WithInitialValue, Config>(
+            std::integral_constant<size_t, reductions_count>{},
+            static_cast<char*>(temporary_storage) + partials_bytes,
+            reduce_storage_size,
+            block_partials,
+            number_of_blocks,
+            outputs,
+            reductions,
+            stream,
+            debug_synchronous);
+        if(result != hipSuccess) return result;
+        ROCPRIM_DETAIL_HIP_SYNC("nested_device_reduce", number_of_blocks, start);
+    }
+    else
+    {
+        kernel_trace_begin(stream,
+                           dim3(1),
+                           dim3(block_size),
+                           items_per_thread,
+                           size * kernel_trace_item_bytes<InputIterator>(),
+                           partials::accumulators_bytes());
+        if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(detail::multi_reduce_kernel<WithInitialValue, config>),
+                           dim3(1),
+                           dim3(block_size),
+                           0,
+                           stream,
+                           input,
+                           size,
+                           outputs,
+                           reductions);
+        ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("multi_reduce_kernel", size, start);
+    }
+
+    return hipSuccess;
+}
+
+#undef ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR
+#undef ROCPRIM_DETAIL_HIP_SYNC
+
+} // end of detail namespace
+
+/// \brief Parallel transform-reduce primitive for device level.
+///
+/// transform_reduce function applies \p transform_op to every element of the input range and
+/// reduces the results using \p reduce_op, in a single pass over the input. It is equivalent
+/// to \p reduce of a \p transform_iterator, but the accumulator type is the type of
+/// \p initial_value and the default configuration is selected for the input type, as the
+/// input values are loaded before they are transformed.
+///
+/// \par Overview
+/// * Does not support non-commutative reduction operators. Reduction operator should also be
+/// associative. When used with non-associative functions the results may be non-deterministic
+/// and/or vary in precision.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p input must have at least \p size elements, while \p output
+/// only needs one element.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p reduce_config or
+/// a custom class with the same members.
+/// \tparam InputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam OutputIterator - random-access iterator type of the output range. Must meet the
+/// requirements of a C++ OutputIterator concept. It can be a simple pointer type.
+/// \tparam InitValueType - type of the initial value, used as the accumulator type.
+/// \tparam UnaryFunction - type of unary function applied to the input values.
+/// \tparam BinaryFunction - type of binary function used for reduction.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the reduction operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to reduce.
+/// \param [out] output - iterator to the first element in the output range.
+/// \param [in] initial_value - initial value to start the reduction.
+/// \param [in] size - number of element in the input range.
+/// \param [in] transform_op - unary function object applied to every input value. Its result
+/// is converted to \p InitValueType.
+/// \param [in] reduce_op - binary operation function object that will be used for reduction.
+/// The signature of the function should be equivalent to the following:
+/// <tt>T f(const T &a, const T &b);</tt>, where \p T is \p InitValueType.
+/// \param [in] stream - [optional] HIP stream object. The default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. The default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful reduction; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example the sum of squares of an array of \p float values is computed in
+/// \p double precision.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size;    // e.g., 4
+/// float * input;        // e.g., [1, 2, 3, 4]
+/// double * output;      // empty array of 1 element
+///
+/// auto square = [] __device__ (float x) { return x * x; };
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::transform_reduce(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, 0.0, input_size, square, rocprim::plus<double>()
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // perform transform-reduce
+/// rocprim::transform_reduce(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, output, 0.0, input_size, square, rocprim::plus<double>()
+/// );
+/// // output: [30]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class InputIterator,
+         class OutputIterator,
+         class InitValueType,
+         class UnaryFunction,
+         class BinaryFunction = ::rocprim::plus<InitValueType>>
+inline hipError_t transform_reduce(void*               temporary_storage,
+                                   size_t&             storage_size,
+                                   InputIterator       input,
+                                   OutputIterator      output,
+                                   const InitValueType initial_value,
+                                   const size_t        size,
+                                   UnaryFunction       transform_op,
+                                   BinaryFunction      reduce_op         = BinaryFunction(),
+                                   const hipStream_t   stream            = 0,
+                                   bool                debug_synchronous = false)
+{
+    return detail::multi_reduce_impl<true, Config>(
+        temporary_storage,
+        storage_size,
+        input,
+        ::rocprim::make_tuple(output),
+        size,
+        ::rocprim::make_tuple(::rocprim::make_tuple(transform_op, reduce_op, initial_value)),
+        stream,
+        debug_synchronous);
+}
+
+/// \brief Parallel multi-reduce primitive for device level.
+///
+/// multi_reduce function computes several transform-reductions of the same input range in
+/// a single pass over the input, e.g. the minimum, the maximum and the sum of a column.
+/// Every reduction is a tuple of a unary transform, a binary reduction operator and an
+/// initial value, the result of the <tt>I</tt>th reduction is written to the <tt>I</tt>th
+/// output iterator.
+///
+/// \par Overview
+/// * Does not support non-commutative reduction operators. Reduction operators should also be
+/// associative. When used with non-associative functions the results may be non-deterministic
+/// and/or vary in precision.
+/// * Returns the required size of \p temporary_storage in \p storage_size
+/// if \p temporary_storage in a null pointer.
+/// * Ranges specified by \p input must have at least \p size elements, while the output
+/// iterators only need one element.
+/// * The accumulator type of every reduction is the type of its initial value. Every block loads
+/// its input values once and reduces them with each reduction separately, on its own
+/// accumulator type. The default configuration is selected for the input type.
+///
+/// \tparam Config - [optional] configuration of the primitive. It can be \p reduce_config or
+/// a custom class with the same members.
+/// \tparam InputIterator - random-access iterator type of the input range. Must meet the
+/// requirements of a C++ InputIterator concept. It can be a simple pointer type.
+/// \tparam OutputIterators - random-access iterator types of the outputs, one per reduction.
+/// \tparam Reductions - types of the reductions, each is a
+/// <tt>rocprim::tuple<UnaryFunction, BinaryFunction, T></tt>.
+///
+/// \param [in] temporary_storage - pointer to a device-accessible temporary storage. When
+/// a null pointer is passed, the required allocation size (in bytes) is written to
+/// \p storage_size and function returns without performing the reduction operation.
+/// \param [in,out] storage_size - reference to a size (in bytes) of \p temporary_storage.
+/// \param [in] input - iterator to the first element in the range to reduce.
+/// \param [out] outputs - tuple of output iterators, one per reduction.
+/// \param [in] size - number of element in the input range.
+/// \param [in] reductions - tuple of reductions, each is a tuple of a transform, a reduction
+/// operator and an initial value.
+/// \param [in] stream - [optional] HIP stream object. The default is \p 0 (default stream).
+/// \param [in] debug_synchronous - [optional] If true, synchronization after every kernel
+/// launch is forced in order to check for errors. The default value is \p false.
+///
+/// \returns \p hipSuccess (\p 0) after successful reduction; otherwise a HIP runtime error of
+/// type \p hipError_t.
+///
+/// \par Example
+/// \parblock
+/// In this example the minimum, the maximum and the sum of squares of an array of \p float
+/// values are computed in one pass.
+///
+/// \code{.cpp}
+/// #include <rocprim/rocprim.hpp>
+///
+/// // Prepare input and output (declare pointers, allocate device memory etc.)
+/// size_t input_size;    // e.g., 4
+/// float * input;        // e.g., [3, -1, 4, 2]
+/// float * min_output;   // empty array of 1 element
+/// float * max_output;   // empty array of 1 element
+/// double * sum_output;  // empty array of 1 element
+///
+/// auto identity = [] __device__ (float x) { return x; };
+/// auto square = [] __device__ (float x) { return double(x) * x; };
+/// auto reductions = rocprim::make_tuple(
+///     rocprim::make_tuple(identity, rocprim::minimum<float>(), FLT_MAX),
+///     rocprim::make_tuple(identity, rocprim::maximum<float>(), -FLT_MAX),
+///     rocprim::make_tuple(square, rocprim::plus<double>(), 0.0)
+/// );
+/// auto outputs = rocprim::make_tuple(min_output, max_output, sum_output);
+///
+/// size_t temporary_storage_size_bytes;
+/// void * temporary_storage_ptr = nullptr;
+/// // Get required size of the temporary storage
+/// rocprim::multi_reduce(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, outputs, input_size, reductions
+/// );
+///
+/// // allocate temporary storage
+/// hipMalloc(&temporary_storage_ptr, temporary_storage_size_bytes);
+///
+/// // perform the reductions
+/// rocprim::multi_reduce(
+///     temporary_storage_ptr, temporary_storage_size_bytes,
+///     input, outputs, input_size, reductions
+/// );
+/// // min_output: [-1], max_output: [4], sum_output: [30]
+/// \endcode
+/// \endparblock
+template<class Config = default_config,
+         class InputIterator,
+         class... OutputIterators,
+         class... Reductions>
+inline hipError_t multi_reduce(void*                                   temporary_storage,
+                               size_t&                                 storage_size,
+                               InputIterator                           input,
+                               ::rocprim::tuple<OutputIterators...>    outputs,
+                               const size_t                            size,
+                               const ::rocprim::tuple<Reductions...>& reductions,
+                               const hipStream_t                       stream            = 0,
+                               bool                                    debug_synchronous = false)
+{
+    static_assert(sizeof...(OutputIterators) == sizeof...(Reductions),
+                  "The number of outputs must be equal to the number of reductions");
+    static_assert(sizeof...(Reductions) > 0, "At least one reduction is required");
+
+    return detail::multi_reduce_impl<true, Config>(temporary_storage,
+                                                   storage_size,
+                                                   input,
+                                                   outputs,
+                                                   size,
+                                                   reductions,
+                                                   stream,
+                                                   debug_synchronous);
+}
+
+/// @}
+// end of group devicemodule
+
+END_ROCPRIM_NAMESPACE
+
+#endif // ROCPRIM_DEVICE_DEVICE_TRANSFORM_REDUCE_HPP_
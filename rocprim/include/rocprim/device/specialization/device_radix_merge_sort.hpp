@@ -21,6 +21,7 @@
 #ifndef ROCPRIM_DEVICE_SPECIALIZATION_DEVICE_RADIX_MERGE_SORT_HPP_
 #define ROCPRIM_DEVICE_SPECIALIZATION_DEVICE_RADIX_MERGE_SORT_HPP_
 
+#include "../config_types.hpp"
 #include "../detail/device_merge_sort.hpp"
 #include "../detail/device_radix_sort.hpp"
 #include "../specialization/device_radix_single_sort.hpp"
@@ -29,33 +30,34 @@ BEGIN_ROCPRIM_NAMESPACE
 
 namespace detail
 {
-template<unsigned int BlockSize,
-         unsigned int ItemsPerThread,
+template<class Config,
          class KeysInputIterator,
          class KeysOutputIterator,
          class ValuesInputIterator,
          class ValuesOutputIterator,
          class BinaryFunction>
-ROCPRIM_KERNEL
-    __launch_bounds__(BlockSize) void radix_block_merge_kernel(KeysInputIterator    keys_input,
-                                                               KeysOutputIterator   keys_output,
-                                                               ValuesInputIterator  values_input,
-                                                               ValuesOutputIterator values_output,
-                                                               const unsigned int   input_size,
-                                                               const unsigned int sorted_block_size,
-                                                               BinaryFunction     compare_function)
+ROCPRIM_KERNEL __launch_bounds__(device_target_arch_config_t<Config>::sort_merge::block_size) void
+    radix_block_merge_kernel(KeysInputIterator    keys_input,
+                             KeysOutputIterator   keys_output,
+                             ValuesInputIterator  values_input,
+                             ValuesOutputIterator values_output,
+                             const unsigned int   input_size,
+                             const unsigned int   sorted_block_size,
+                             BinaryFunction       compare_function)
 {
-    block_merge_kernel_impl<BlockSize, ItemsPerThread>(keys_input,
-                                                       keys_output,
-                                                       values_input,
-                                                       values_output,
-                                                       input_size,
-                                                       sorted_block_size,
-                                                       compare_function);
+    using config = typename device_target_arch_config_t<Config>::sort_merge;
+    block_merge_kernel_impl<config::block_size, config::items_per_thread>(keys_input,
+                                                                          keys_output,
+                                                                          values_input,
+                                                                          values_output,
+                                                                          input_size,
+                                                                          sorted_block_size,
+                                                                          compare_function);
 }
 
     template<
         class Config,
+        class ArchConfig,
         bool Descending,
         class KeysInputIterator,
         class KeysOutputIterator,
@@ -80,8 +82,8 @@ ROCPRIM_KERNEL
 
         constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
 
-        constexpr unsigned int items_per_thread = Config::sort_merge::items_per_thread;
-        constexpr unsigned int block_size = Config::sort_merge::block_size;
+        constexpr unsigned int items_per_thread = ArchConfig::sort_merge::items_per_thread;
+        constexpr unsigned int block_size = ArchConfig::sort_merge::block_size;
         constexpr unsigned int items_per_block = block_size * items_per_thread;
 
         const unsigned int current_radix_bits = end_bit - bit;
@@ -98,6 +100,14 @@ ROCPRIM_KERNEL
             std::cout << "current_radix_bits " << current_radix_bits << '\n';
         }
 
+        // Every pass reads and writes all keys and values
+        const size_t item_bytes = size * (sizeof(key_type) + (with_values ? sizeof(value_type) : 0));
+        kernel_trace_begin(stream,
+                           dim3(number_of_blocks),
+                           dim3(block_size),
+                           items_per_thread,
+                           item_bytes,
+                           item_bytes);
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
 
         hipLaunchKernelGGL(
@@ -106,7 +116,7 @@ ROCPRIM_KERNEL
             >),
             dim3(number_of_blocks), dim3(block_size), 0, stream,
             keys_input, keys_buffer, values_input, values_buffer,
-            size, bit, current_radix_bits
+            size, bit, current_radix_bits, identity_decomposer()
         );
         ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("radix_sort_single", size, start)
 
@@ -121,12 +131,18 @@ ROCPRIM_KERNEL
                                         auto values_input_,
                                         auto values_output_) -> hipError_t
             {
+                kernel_trace_begin(stream,
+                                   dim3(number_of_blocks),
+                                   dim3(block_size),
+                                   items_per_thread,
+                                   item_bytes,
+                                   item_bytes);
                 if(debug_synchronous)
                     start = std::chrono::high_resolution_clock::now();
                 if(current_radix_bits == sizeof(key_type) * 8)
                 {
                     hipLaunchKernelGGL(
-                        HIP_KERNEL_NAME(radix_block_merge_kernel<block_size, items_per_thread>),
+                        HIP_KERNEL_NAME(radix_block_merge_kernel<Config>),
                         dim3(number_of_blocks),
                         dim3(block_size),
                         0,
@@ -142,7 +158,7 @@ ROCPRIM_KERNEL
                 else
                 {
                     hipLaunchKernelGGL(
-                        HIP_KERNEL_NAME(radix_block_merge_kernel<block_size, items_per_thread>),
+                        HIP_KERNEL_NAME(radix_block_merge_kernel<Config>),
                         dim3(number_of_blocks),
                         dim3(block_size),
                         0,
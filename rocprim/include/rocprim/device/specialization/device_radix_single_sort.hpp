@@ -22,6 +22,7 @@
 #define ROCPRIM_DEVICE_SPECIALIZATION_DEVICE_RADIX_SINGLE_SORT_HPP_
 
 #include "../detail/device_radix_sort.hpp"
+#include "../device_trace.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
@@ -32,6 +33,7 @@ namespace detail
     { \
         auto _error = hipGetLastError(); \
         if(_error != hipSuccess) return _error; \
+        ::rocprim::detail::kernel_trace_end(name, size, stream); \
         if(debug_synchronous) \
         { \
             std::cout << name << "(" << size << ")"; \
@@ -50,7 +52,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     ROCPRIM_KERNEL
    __launch_bounds__(BlockSize)
@@ -60,12 +63,14 @@ namespace detail
                            ValuesOutputIterator values_output,
                            unsigned int         size,
                            unsigned int         bit,
-                           unsigned int         current_radix_bits)
+                           unsigned int         current_radix_bits,
+                           Decomposer           decomposer)
    {
        sort_single<BlockSize, ItemsPerThread, Descending>(
            keys_input, keys_output,
            values_input, values_output,
-           size, bit, current_radix_bits
+           size, bit, current_radix_bits,
+           decomposer
        );
    }
 
@@ -76,7 +81,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     hipError_t radix_sort_single(KeysInputIterator keys_input,
@@ -86,9 +92,14 @@ namespace detail
                                 unsigned int size,
                                 unsigned int bit,
                                 unsigned int end_bit,
+                                Decomposer decomposer,
                                 hipStream_t stream,
                                 bool debug_synchronous)
     {
+        using key_type = typename std::iterator_traits<KeysInputIterator>::value_type;
+        using value_type = typename std::iterator_traits<ValuesInputIterator>::value_type;
+        constexpr bool with_values = !std::is_same<value_type, ::rocprim::empty_type>::value;
+
         const unsigned int current_radix_bits = end_bit - bit;
 
         std::chrono::high_resolution_clock::time_point start;
@@ -100,6 +111,8 @@ namespace detail
             std::cout << "current_radix_bits " << current_radix_bits << '\n';
         }
 
+        const size_t item_bytes = size * (sizeof(key_type) + (with_values ? sizeof(value_type) : 0));
+        kernel_trace_begin(stream, dim3(1), dim3(BlockSize), ItemsPerThread, item_bytes, item_bytes);
         if(debug_synchronous) start = std::chrono::high_resolution_clock::now();
 
         hipLaunchKernelGGL(
@@ -108,7 +121,7 @@ namespace detail
             >),
             dim3(1), dim3(BlockSize), 0, stream,
             keys_input, keys_output, values_input, values_output,
-            size, bit, current_radix_bits
+            size, bit, current_radix_bits, decomposer
         );
         ROCPRIM_DETAIL_HIP_SYNC_AND_RETURN_ON_ERROR("radix_sort_single", size, start)
 
@@ -122,7 +135,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     hipError_t radix_sort_single_limit64(KeysInputIterator keys_input,
@@ -132,12 +146,13 @@ namespace detail
                                          unsigned int size,
                                          unsigned int bit,
                                          unsigned int end_bit,
+                                         Decomposer decomposer,
                                          hipStream_t stream,
                                          bool debug_synchronous)
     {
         return radix_sort_single<64U, 1U, Descending>(
             keys_input, keys_output, values_input, values_output,
-            size, bit, end_bit, stream, debug_synchronous
+            size, bit, end_bit, decomposer, stream, debug_synchronous
         );
     }
 
@@ -147,7 +162,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     hipError_t radix_sort_single_limit128(KeysInputIterator keys_input,
@@ -157,18 +173,19 @@ namespace detail
                                           unsigned int size,
                                           unsigned int bit,
                                           unsigned int end_bit,
+                                          Decomposer decomposer,
                                           hipStream_t stream,
                                           bool debug_synchronous)
     {
         if( !Config::force_single_kernel_config && size <= 64U )
             return radix_sort_single_limit64<Config, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
         else
             return radix_sort_single<64U, 2U, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
     }
 
@@ -178,7 +195,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     hipError_t radix_sort_single_limit192(KeysInputIterator keys_input,
@@ -188,18 +206,19 @@ namespace detail
                                           unsigned int size,
                                           unsigned int bit,
                                           unsigned int end_bit,
+                                          Decomposer decomposer,
                                           hipStream_t stream,
                                           bool debug_synchronous)
     {
         if( !Config::force_single_kernel_config && size <= 128U )
             return radix_sort_single_limit128<Config, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
         else
             return radix_sort_single<64U, 3U, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
     }
 
@@ -209,7 +228,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     hipError_t radix_sort_single_limit256(KeysInputIterator keys_input,
@@ -219,18 +239,19 @@ namespace detail
                                           unsigned int size,
                                           unsigned int bit,
                                           unsigned int end_bit,
+                                          Decomposer decomposer,
                                           hipStream_t stream,
                                           bool debug_synchronous)
     {
         if( !Config::force_single_kernel_config && size <= 192U )
             return radix_sort_single_limit192<Config, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
         else
             return radix_sort_single<64U, 4U, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
     }
 
@@ -240,7 +261,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     hipError_t radix_sort_single_limit320(KeysInputIterator keys_input,
@@ -250,18 +272,19 @@ namespace detail
                                           unsigned int size,
                                           unsigned int bit,
                                           unsigned int end_bit,
+                                          Decomposer decomposer,
                                           hipStream_t stream,
                                           bool debug_synchronous)
     {
         if( !Config::force_single_kernel_config && size <= 256U )
             return radix_sort_single_limit256<Config, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
         else
             return radix_sort_single<64U, 5U, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
     }
 
@@ -271,7 +294,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     hipError_t radix_sort_single_limit512(KeysInputIterator keys_input,
@@ -281,18 +305,19 @@ namespace detail
                                           unsigned int size,
                                           unsigned int bit,
                                           unsigned int end_bit,
+                                          Decomposer decomposer,
                                           hipStream_t stream,
                                           bool debug_synchronous)
     {
         if( !Config::force_single_kernel_config && size <= 320U )
             return radix_sort_single_limit320<Config, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
         else
             return radix_sort_single<256U, 2U, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
     }
 
@@ -302,7 +327,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     hipError_t radix_sort_single_limit768(KeysInputIterator keys_input,
@@ -312,18 +338,19 @@ namespace detail
                                           unsigned int size,
                                           unsigned int bit,
                                           unsigned int end_bit,
+                                          Decomposer decomposer,
                                           hipStream_t stream,
                                           bool debug_synchronous)
     {
         if( !Config::force_single_kernel_config && size <= 512U )
             return radix_sort_single_limit512<Config, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
         else
             return radix_sort_single<256U, 3U, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
     }
 
@@ -333,7 +360,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     hipError_t radix_sort_single_limit1024(KeysInputIterator keys_input,
@@ -343,18 +371,19 @@ namespace detail
                                            unsigned int size,
                                            unsigned int bit,
                                            unsigned int end_bit,
+                                           Decomposer decomposer,
                                            hipStream_t stream,
                                            bool debug_synchronous)
     {
         if( !Config::force_single_kernel_config && size <= 768U )
             return radix_sort_single_limit768<Config, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
         else
             return radix_sort_single<256U, 4U, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
     }
 
@@ -366,7 +395,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     hipError_t radix_sort_single_limit1536(KeysInputIterator keys_input,
@@ -376,18 +406,19 @@ namespace detail
                                            unsigned int size,
                                            unsigned int bit,
                                            unsigned int end_bit,
+                                           Decomposer decomposer,
                                            hipStream_t stream,
                                            bool debug_synchronous)
     {
         if( !Config::force_single_kernel_config && size <= 1024U )
             return radix_sort_single_limit1024<Config, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
         else
             return radix_sort_single<256U, 6U, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
     }
 
@@ -397,7 +428,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     hipError_t radix_sort_single_limit2048(KeysInputIterator keys_input,
@@ -407,18 +439,19 @@ namespace detail
                                            unsigned int size,
                                            unsigned int bit,
                                            unsigned int end_bit,
+                                           Decomposer decomposer,
                                            hipStream_t stream,
                                            bool debug_synchronous)
     {
         if( !Config::force_single_kernel_config && size <= 1536U )
             return radix_sort_single_limit1536<Config, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
         else
             return radix_sort_single<256U, 8U, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
     }
 
@@ -428,7 +461,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     hipError_t radix_sort_single_limit2560(KeysInputIterator keys_input,
@@ -438,18 +472,19 @@ namespace detail
                                            unsigned int size,
                                            unsigned int bit,
                                            unsigned int end_bit,
+                                           Decomposer decomposer,
                                            hipStream_t stream,
                                            bool debug_synchronous)
     {
         if( !Config::force_single_kernel_config && size <= 2048U )
             return radix_sort_single_limit2048<Config, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
         else
             return radix_sort_single<256U, 10U, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
     }
 
@@ -459,7 +494,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     hipError_t radix_sort_single_limit3072(KeysInputIterator keys_input,
@@ -469,18 +505,19 @@ namespace detail
                                            unsigned int size,
                                            unsigned int bit,
                                            unsigned int end_bit,
+                                           Decomposer decomposer,
                                            hipStream_t stream,
                                            bool debug_synchronous)
     {
         if( !Config::force_single_kernel_config && size <= 2560U )
             return radix_sort_single_limit2560<Config, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
         else
             return radix_sort_single<256U, 12U, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
     }
 
@@ -490,7 +527,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     hipError_t radix_sort_single_limit3584(KeysInputIterator keys_input,
@@ -500,18 +538,19 @@ namespace detail
                                            unsigned int size,
                                            unsigned int bit,
                                            unsigned int end_bit,
+                                           Decomposer decomposer,
                                            hipStream_t stream,
                                            bool debug_synchronous)
     {
         if( !Config::force_single_kernel_config && size <= 3072U )
             return radix_sort_single_limit3072<Config, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
         else
             return radix_sort_single<256U, 14U, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
     }
 
@@ -521,7 +560,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     hipError_t radix_sort_single_limit4096(KeysInputIterator keys_input,
@@ -531,18 +571,19 @@ namespace detail
                                            unsigned int size,
                                            unsigned int bit,
                                            unsigned int end_bit,
+                                           Decomposer decomposer,
                                            hipStream_t stream,
                                            bool debug_synchronous)
     {
         if( !Config::force_single_kernel_config && size <= 3584U )
             return radix_sort_single_limit3584<Config, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
         else
             return radix_sort_single<256U, 16U, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
     }
 
@@ -552,7 +593,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     auto radix_sort_single(KeysInputIterator keys_input,
@@ -562,6 +604,7 @@ namespace detail
                            unsigned int size,
                            unsigned int bit,
                            unsigned int end_bit,
+                           Decomposer decomposer,
                            hipStream_t stream,
                            bool debug_synchronous)
         -> typename std::enable_if<
@@ -571,7 +614,7 @@ namespace detail
     {
         return radix_sort_single_limit64<Config, Descending>(
             keys_input, keys_output, values_input, values_output,
-            size, bit, end_bit, stream, debug_synchronous
+            size, bit, end_bit, decomposer, stream, debug_synchronous
         );
     }
 
@@ -581,7 +624,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     auto radix_sort_single(KeysInputIterator keys_input,
@@ -591,6 +635,7 @@ namespace detail
                            unsigned int size,
                            unsigned int bit,
                            unsigned int end_bit,
+                           Decomposer decomposer,
                            hipStream_t stream,
                            bool debug_synchronous)
         -> typename std::enable_if<
@@ -601,7 +646,7 @@ namespace detail
     {
         return radix_sort_single_limit128<Config, Descending>(
             keys_input, keys_output, values_input, values_output,
-            size, bit, end_bit, stream, debug_synchronous
+            size, bit, end_bit, decomposer, stream, debug_synchronous
         );
     }
 
@@ -611,7 +656,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     auto radix_sort_single(KeysInputIterator keys_input,
@@ -621,6 +667,7 @@ namespace detail
                            unsigned int size,
                            unsigned int bit,
                            unsigned int end_bit,
+                           Decomposer decomposer,
                            hipStream_t stream,
                            bool debug_synchronous)
         -> typename std::enable_if<
@@ -631,7 +678,7 @@ namespace detail
     {
         return radix_sort_single_limit192<Config, Descending>(
             keys_input, keys_output, values_input, values_output,
-            size, bit, end_bit, stream, debug_synchronous
+            size, bit, end_bit, decomposer, stream, debug_synchronous
         );
     }
 
@@ -641,7 +688,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     auto radix_sort_single(KeysInputIterator keys_input,
@@ -651,6 +699,7 @@ namespace detail
                            unsigned int size,
                            unsigned int bit,
                            unsigned int end_bit,
+                           Decomposer decomposer,
                            hipStream_t stream,
                            bool debug_synchronous)
         -> typename std::enable_if<
@@ -661,7 +710,7 @@ namespace detail
     {
         return radix_sort_single_limit256<Config, Descending>(
             keys_input, keys_output, values_input, values_output,
-            size, bit, end_bit, stream, debug_synchronous
+            size, bit, end_bit, decomposer, stream, debug_synchronous
         );
     }
 
@@ -671,7 +720,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     auto radix_sort_single(KeysInputIterator keys_input,
@@ -681,6 +731,7 @@ namespace detail
                            unsigned int size,
                            unsigned int bit,
                            unsigned int end_bit,
+                           Decomposer decomposer,
                            hipStream_t stream,
                            bool debug_synchronous)
         -> typename std::enable_if<
@@ -691,7 +742,7 @@ namespace detail
     {
         return radix_sort_single_limit320<Config, Descending>(
             keys_input, keys_output, values_input, values_output,
-            size, bit, end_bit, stream, debug_synchronous
+            size, bit, end_bit, decomposer, stream, debug_synchronous
         );
     }
 
@@ -701,7 +752,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     auto radix_sort_single(KeysInputIterator keys_input,
@@ -711,6 +763,7 @@ namespace detail
                            unsigned int size,
                            unsigned int bit,
                            unsigned int end_bit,
+                           Decomposer decomposer,
                            hipStream_t stream,
                            bool debug_synchronous)
         -> typename std::enable_if<
@@ -721,7 +774,7 @@ namespace detail
     {
         return radix_sort_single_limit512<Config, Descending>(
             keys_input, keys_output, values_input, values_output,
-            size, bit, end_bit, stream, debug_synchronous
+            size, bit, end_bit, decomposer, stream, debug_synchronous
         );
     }
 
@@ -731,7 +784,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     auto radix_sort_single(KeysInputIterator keys_input,
@@ -741,6 +795,7 @@ namespace detail
                            unsigned int size,
                            unsigned int bit,
                            unsigned int end_bit,
+                           Decomposer decomposer,
                            hipStream_t stream,
                            bool debug_synchronous)
         -> typename std::enable_if<
@@ -751,7 +806,7 @@ namespace detail
     {
         return radix_sort_single_limit768<Config, Descending>(
             keys_input, keys_output, values_input, values_output,
-            size, bit, end_bit, stream, debug_synchronous
+            size, bit, end_bit, decomposer, stream, debug_synchronous
         );
     }
 
@@ -761,7 +816,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     auto radix_sort_single(KeysInputIterator keys_input,
@@ -771,6 +827,7 @@ namespace detail
                            unsigned int size,
                            unsigned int bit,
                            unsigned int end_bit,
+                           Decomposer decomposer,
                            hipStream_t stream,
                            bool debug_synchronous)
         -> typename std::enable_if<
@@ -781,7 +838,7 @@ namespace detail
     {
         return radix_sort_single_limit1024<Config, Descending>(
             keys_input, keys_output, values_input, values_output,
-            size, bit, end_bit, stream, debug_synchronous
+            size, bit, end_bit, decomposer, stream, debug_synchronous
         );
     }
 
@@ -791,7 +848,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     auto radix_sort_single(KeysInputIterator keys_input,
@@ -801,6 +859,7 @@ namespace detail
                            unsigned int size,
                            unsigned int bit,
                            unsigned int end_bit,
+                           Decomposer decomposer,
                            hipStream_t stream,
                            bool debug_synchronous)
         -> typename std::enable_if<
@@ -811,7 +870,7 @@ namespace detail
     {
         return radix_sort_single_limit1536<Config, Descending>(
             keys_input, keys_output, values_input, values_output,
-            size, bit, end_bit, stream, debug_synchronous
+            size, bit, end_bit, decomposer, stream, debug_synchronous
         );
     }
 
@@ -821,7 +880,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     auto radix_sort_single(KeysInputIterator keys_input,
@@ -831,6 +891,7 @@ namespace detail
                            unsigned int size,
                            unsigned int bit,
                            unsigned int end_bit,
+                           Decomposer decomposer,
                            hipStream_t stream,
                            bool debug_synchronous)
         -> typename std::enable_if<
@@ -841,7 +902,7 @@ namespace detail
     {
         return radix_sort_single_limit2048<Config, Descending>(
             keys_input, keys_output, values_input, values_output,
-            size, bit, end_bit, stream, debug_synchronous
+            size, bit, end_bit, decomposer, stream, debug_synchronous
         );
     }
 
@@ -851,7 +912,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     auto radix_sort_single(KeysInputIterator keys_input,
@@ -861,6 +923,7 @@ namespace detail
                            unsigned int size,
                            unsigned int bit,
                            unsigned int end_bit,
+                           Decomposer decomposer,
                            hipStream_t stream,
                            bool debug_synchronous)
         -> typename std::enable_if<
@@ -871,7 +934,7 @@ namespace detail
     {
         return radix_sort_single_limit2560<Config, Descending>(
             keys_input, keys_output, values_input, values_output,
-            size, bit, end_bit, stream, debug_synchronous
+            size, bit, end_bit, decomposer, stream, debug_synchronous
         );
     }
 
@@ -881,7 +944,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     auto radix_sort_single(KeysInputIterator keys_input,
@@ -891,6 +955,7 @@ namespace detail
                            unsigned int size,
                            unsigned int bit,
                            unsigned int end_bit,
+                           Decomposer decomposer,
                            hipStream_t stream,
                            bool debug_synchronous)
         -> typename std::enable_if<
@@ -901,7 +966,7 @@ namespace detail
     {
         return radix_sort_single_limit3072<Config, Descending>(
             keys_input, keys_output, values_input, values_output,
-            size, bit, end_bit, stream, debug_synchronous
+            size, bit, end_bit, decomposer, stream, debug_synchronous
         );
     }
 
@@ -911,7 +976,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     auto radix_sort_single(KeysInputIterator keys_input,
@@ -921,6 +987,7 @@ namespace detail
                            unsigned int size,
                            unsigned int bit,
                            unsigned int end_bit,
+                           Decomposer decomposer,
                            hipStream_t stream,
                            bool debug_synchronous)
         -> typename std::enable_if<
@@ -931,7 +998,7 @@ namespace detail
     {
         return radix_sort_single_limit3584<Config, Descending>(
             keys_input, keys_output, values_input, values_output,
-            size, bit, end_bit, stream, debug_synchronous
+            size, bit, end_bit, decomposer, stream, debug_synchronous
         );
     }
 
@@ -941,7 +1008,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     auto radix_sort_single(KeysInputIterator keys_input,
@@ -951,6 +1019,7 @@ namespace detail
                            unsigned int size,
                            unsigned int bit,
                            unsigned int end_bit,
+                           Decomposer decomposer,
                            hipStream_t stream,
                            bool debug_synchronous)
         -> typename std::enable_if<
@@ -961,7 +1030,7 @@ namespace detail
     {
         return radix_sort_single_limit4096<Config, Descending>(
             keys_input, keys_output, values_input, values_output,
-            size, bit, end_bit, stream, debug_synchronous
+            size, bit, end_bit, decomposer, stream, debug_synchronous
         );
     }
 
@@ -971,7 +1040,8 @@ namespace detail
         class KeysInputIterator,
         class KeysOutputIterator,
         class ValuesInputIterator,
-        class ValuesOutputIterator
+        class ValuesOutputIterator,
+        class Decomposer
     >
     inline
     auto radix_sort_single(KeysInputIterator keys_input,
@@ -981,6 +1051,7 @@ namespace detail
                            unsigned int size,
                            unsigned int bit,
                            unsigned int end_bit,
+                           Decomposer decomposer,
                            hipStream_t stream,
                            bool debug_synchronous)
         -> typename std::enable_if<
@@ -991,7 +1062,7 @@ namespace detail
         if( size < 4096 )
             return radix_sort_single_limit4096<Config, Descending>(
                 keys_input, keys_output, values_input, values_output,
-                size, bit, end_bit, stream, debug_synchronous
+                size, bit, end_bit, decomposer, stream, debug_synchronous
             );
         else
             return radix_sort_single<
@@ -1000,7 +1071,7 @@ namespace detail
                 Descending
             >(
                     keys_input, keys_output, values_input, values_output,
-                    size, bit, end_bit, stream, debug_synchronous
+                    size, bit, end_bit, decomposer, stream, debug_synchronous
             );
     }
 
@@ -51,6 +51,24 @@ namespace detail
         return ::atomicAdd(address, value);
     }
 
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    double atomic_add(double * address, double value)
+    {
+        return ::atomicAdd(address, value);
+    }
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    unsigned int atomic_min(unsigned int * address, unsigned int value)
+    {
+        return ::atomicMin(address, value);
+    }
+
+    ROCPRIM_DEVICE ROCPRIM_INLINE
+    unsigned long long atomic_min(unsigned long long * address, unsigned long long value)
+    {
+        return ::atomicMin(address, value);
+    }
+
     ROCPRIM_DEVICE ROCPRIM_INLINE
     unsigned int atomic_wrapinc(unsigned int * address, unsigned int value)
     {
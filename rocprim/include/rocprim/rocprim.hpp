@@ -44,28 +44,39 @@
 #include "block/block_exchange.hpp"
 #include "block/block_histogram.hpp"
 #include "block/block_load.hpp"
+#include "block/block_radix_rank.hpp"
 #include "block/block_radix_sort.hpp"
 #include "block/block_scan.hpp"
 #include "block/block_sort.hpp"
 #include "block/block_store.hpp"
 
+#include "device/caching_allocator.hpp"
 #include "device/device_adjacent_difference.hpp"
 #include "device/device_binary_search.hpp"
+#include "device/device_find.hpp"
 #include "device/device_histogram.hpp"
+#include "device/device_memcpy.hpp"
 #include "device/device_merge.hpp"
 #include "device/device_merge_sort.hpp"
 #include "device/device_partition.hpp"
+#include "device/device_partition_buckets.hpp"
 #include "device/device_radix_sort.hpp"
 #include "device/device_reduce_by_key.hpp"
 #include "device/device_reduce.hpp"
 #include "device/device_run_length_encode.hpp"
 #include "device/device_scan_by_key.hpp"
 #include "device/device_scan.hpp"
+#include "device/device_segmented_merge_sort.hpp"
 #include "device/device_segmented_radix_sort.hpp"
 #include "device/device_segmented_reduce.hpp"
 #include "device/device_segmented_scan.hpp"
+#include "device/device_segmented_topk.hpp"
 #include "device/device_select.hpp"
+#include "device/device_set_operations.hpp"
+#include "device/device_topk.hpp"
+#include "device/device_trace.hpp"
 #include "device/device_transform.hpp"
+#include "device/device_transform_reduce.hpp"
 
 BEGIN_ROCPRIM_NAMESPACE
 
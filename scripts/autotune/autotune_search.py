@@ -0,0 +1,370 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+"""
+This Python script searches the configurations of the rocPRIM algorithms with
+successive halving, instead of benchmarking the full product of the lists in
+benchmark/ConfigAutotuneSettings.cmake. Every round only the remaining candidates
+are compiled from the .parallel.cpp.in templates (BENCHMARK_CONFIG_TUNING_CANDIDATES)
+and benchmarked with more trials, the best half (1/eta) of the candidates of every
+type is kept and their neighbours in the parameter grid are added. The benchmark results of the last round are passed to
+create_optimization.py, which writes the per-architecture configuration headers.
+
+The candidates are evaluated by building and running the benchmarks, which also works
+with a HIP-CPU build, or by a mock timing source (--mock) to test the search itself.
+"""
+
+import argparse
+import json
+import math
+import os
+import random
+import re
+import subprocess
+import sys
+from collections import OrderedDict
+from dataclasses import dataclass
+from typing import Callable, Dict, List, Optional, Tuple
+
+import create_optimization
+
+# A candidate is a type (a value of the type name of the search space) and a value for each parameter
+Candidate = Tuple[str, Tuple[str, ...]]
+
+@dataclass
+class SearchSpace:
+    """
+    The configurations of a benchmark which can be tuned. The names are the names of
+    benchmark/ConfigAutotuneSettings.cmake, the type name first.
+    """
+    target: str
+    type_name: str
+    types: List[str]
+    parameters: 'OrderedDict[str, List[str]]'
+    # Regex of the benchmark names, the same as get_name_pattern() of the benchmark
+    name_pattern: str
+    # Returns the candidate of the named groups of a benchmark name
+    candidate_of: Callable[[Dict[str, str]], Candidate]
+    # Returns the name of a benchmark of the candidate, used by the mock timing source
+    benchmark_name: Callable[[Candidate], str]
+
+def key_value_type(groups: Dict[str, str]) -> str:
+    return groups['key_type'] + (',' + groups['value_type'] if groups.get('value_type') else '')
+
+def key_value_prefix(type_value: str) -> str:
+    # Only the first comma outside of template arguments separates the key and value type
+    depth = 0
+    for index, character in enumerate(type_value):
+        depth += {'<': 1, '>': -1}.get(character, 0)
+        if character == ',' and depth == 0:
+            return type_value[:index] + ', ' + type_value[index + 1:] + ', '
+    return type_value + ', '
+
+KEY_VALUE_TYPES = [
+    'int', 'int64_t', 'int8_t', 'uint8_t', 'rocprim::half', 'short',
+    'int,float', 'int,double', 'int,float2', 'int,custom_type<float,float>', 'int,double2',
+    'int,custom_type<double,double>', 'int64_t,float', 'int64_t,double', 'int64_t,float2',
+    'int64_t,custom_type<float,float>', 'int64_t,double2', 'int64_t,custom_type<double,double>',
+    'int8_t,int8_t', 'uint8_t,uint8_t', 'rocprim::half,rocprim::half']
+
+SEARCH_SPACES: Dict[str, SearchSpace] = {
+    'device_reduce': SearchSpace(
+        target='benchmark_device_reduce',
+        type_name='DataType',
+        types=['int', 'float', 'double', 'int8_t', 'int64_t', 'rocprim::half'],
+        parameters=OrderedDict([
+            ('BlockSize', ['64', '128', '256']),
+            ('ItemsPerThread', ['1', '2', '4', '8', '16'])]),
+        name_pattern=r'(?P<algo>\S*?)<(?P<datatype>\S*),\s*reduce_config<'
+                     r'\s*(?P<block_size>[0-9]+),\s*(?P<items_per_thread>[0-9]+)>>',
+        candidate_of=lambda groups: (groups['datatype'],
+                                     (groups['block_size'], groups['items_per_thread'])),
+        benchmark_name=lambda candidate:
+            f'device_reduce<{candidate[0]}, reduce_config<{candidate[1][0]}, {candidate[1][1]}>>'),
+    'device_radix_sort': SearchSpace(
+        target='benchmark_device_radix_sort',
+        type_name='KeyType_ValueType',
+        types=KEY_VALUE_TYPES,
+        parameters=OrderedDict([
+            ('LongRadixBits_ShortRadixBits', ['4,3', '5,4', '6,4', '7,6', '8,7']),
+            ('ItemsPerThread2', ['1', '2', '4', '8'])]),
+        name_pattern=r'(?P<algo>\S*?)<(?P<key_type>\S*),(?:\s*(?P<value_type>\S*),)?\s*radix_sort_config<'
+                     r'(?P<long_radix_bits>[0-9]+),\s*(?P<short_radix_bits>[0-9]+),\s*'
+                     r'kernel_config<\s*(?P<scan_block_size>[0-9]+),\s*(?P<scan_items_per_thread>[0-9]+)>,\s*'
+                     r'kernel_config<\s*(?P<sort_block_size>[0-9]+),\s*(?P<sort_items_per_thread>[0-9]+)>,\s*'
+                     r'kernel_config<\s*(?P<sort_single_block_size>[0-9]+),\s*(?P<sort_single_items_per_thread>[0-9]+)>,\s*'
+                     r'kernel_config<\s*(?P<sort_merge_block_size>[0-9]+),\s*(?P<sort_merge_items_per_thread>[0-9]+)>,\s*'
+                     r'(?P<force_single_kernel_config>[0-9]+)>>',
+        candidate_of=lambda groups: (key_value_type(groups),
+                                     (groups['long_radix_bits'] + ',' + groups['short_radix_bits'],
+                                      groups['sort_items_per_thread'])),
+        benchmark_name=lambda candidate:
+            f'device_radix_sort<{key_value_prefix(candidate[0])}radix_sort_config<'
+            f'{candidate[1][0].replace(",", ", ")}, kernel_config< 256,  4>, '
+            f'kernel_config< 256, {candidate[1][1]:>2}>, kernel_config< 256, 10>, '
+            f'kernel_config<1024,  1>, 0>>'),
+    'device_merge_sort': SearchSpace(
+        target='benchmark_device_merge_sort',
+        type_name='KeyType_ValueType',
+        types=['int', 'int64_t', 'int8_t', 'uint8_t', 'rocprim::half', 'short',
+               'int,float', 'int64_t,double', 'int8_t,int8_t', 'uint8_t,uint8_t',
+               'rocprim::half,rocprim::half', 'short,short', 'int,custom_type<float,float>',
+               'int64_t,custom_type<double,double>', 'custom_type<double,double>,custom_type<double,double>',
+               'custom_type<int,int>,custom_type<double,double>', 'custom_type<int,int>,custom_type<char,double>',
+               'custom_type<int,int>,custom_type<int64_t,double>'],
+        parameters=OrderedDict([
+            ('MergeBlockSizeExponent', ['6', '7', '8', '9', '10']),
+            ('SortBlockSizeExponent', ['7', '8', '9', '10'])]),
+        name_pattern=r'(?P<algo>\S*?)<(?P<key_type>\S*),(?:\s*(?P<value_type>\S*),)?\s*merge_sort_config<\s*'
+                     r'(?P<sort_block_size>[0-9]+),\s*(?P<sort_items_per_thread>[0-9]+),\s*(?P<merge_block_size>[0-9]+)>>',
+        candidate_of=lambda groups: (key_value_type(groups),
+                                     (str(int(groups['merge_block_size']).bit_length() - 1),
+                                      str(int(groups['sort_block_size']).bit_length() - 1))),
+        benchmark_name=lambda candidate:
+            f'device_merge_sort<{key_value_prefix(candidate[0])}merge_sort_config<'
+            f'{1 << int(candidate[1][1])}, 4, {1 << int(candidate[1][0])}>>'),
+}
+
+class BuildEvaluator:
+    """
+    Evaluates candidates by compiling them with BENCHMARK_CONFIG_TUNING_CANDIDATES and running
+    the benchmark, the budget is the number of trials.
+    """
+
+    def __init__(self, source_dir: str, build_dir: str, cmake_args: List[str], size: Optional[int]):
+        self.source_dir = source_dir
+        self.build_dir = build_dir
+        self.cmake_args = cmake_args
+        self.size = size
+        self.round = 0
+
+    def evaluate(self, space: SearchSpace, candidates: List[Candidate], budget: int) -> str:
+        os.makedirs(self.build_dir, exist_ok=True)
+        candidates_path = os.path.join(self.build_dir, 'autotune_candidates.cmake')
+        with open(candidates_path, 'w') as candidates_file:
+            values = ' '.join(f'"{" ".join((type_value,) + parameters)}"'
+                              for type_value, parameters in candidates)
+            candidates_file.write(f'set({space.target}_candidates {values})\n')
+
+        subprocess.run(['cmake', '-S', self.source_dir, '-B', self.build_dir,
+                        '-DBUILD_BENCHMARK=ON', '-DBENCHMARK_CONFIG_TUNING=ON',
+                        f'-DBENCHMARK_CONFIG_TUNING_CANDIDATES={candidates_path}']
+                       + self.cmake_args, check=True)
+        subprocess.run(['cmake', '--build', self.build_dir, '--target', space.target,
+                        '--parallel'], check=True)
+
+        output_path = os.path.join(self.build_dir, f'{space.target}_round{self.round}.json')
+        self.round += 1
+        command = [os.path.join(self.build_dir, 'benchmark', space.target),
+                   f'--benchmark_out={output_path}', '--benchmark_out_format=json',
+                   '--trials', str(budget)]
+        if self.size:
+            command += ['--size', str(self.size)]
+        subprocess.run(command, check=True)
+        return output_path
+
+class MockEvaluator:
+    """
+    Evaluates candidates with a synthetic timing model to test the search without a device:
+    every type has a random optimal value of each parameter, the items per second decrease
+    with the distance of the parameter values from the optimum. The noise decreases with the
+    number of trials, like the noise of the benchmarks.
+    """
+
+    def __init__(self, output_dir: str, arch: str, seed: int, noise: float):
+        self.output_dir = output_dir
+        self.arch = arch
+        self.rng = random.Random(seed)
+        self.noise = noise
+        self.optimum: Dict[Tuple[str, str], Tuple[int, ...]] = {}
+        self.round = 0
+        self.evaluations = 0
+
+    def optimal_candidate(self, space: SearchSpace, type_value: str) -> Candidate:
+        key = (space.target, type_value)
+        if key not in self.optimum:
+            self.optimum[key] = tuple(
+                self.rng.randrange(len(values)) for values in space.parameters.values())
+        return (type_value, tuple(values[index] for values, index
+                                  in zip(space.parameters.values(), self.optimum[key])))
+
+    def items_per_second(self, space: SearchSpace, candidate: Candidate, budget: int) -> float:
+        optimal = self.optimal_candidate(space, candidate[0])[1]
+        distance = sum((values.index(value) - values.index(optimal_value)) ** 2
+                       for values, value, optimal_value
+                       in zip(space.parameters.values(), candidate[1], optimal))
+        return 1e9 * math.exp(-distance / 4) * (1 + self.rng.gauss(0, self.noise / math.sqrt(budget)))
+
+    def evaluate(self, space: SearchSpace, candidates: List[Candidate], budget: int) -> str:
+        self.evaluations += len(candidates)
+        benchmarks = [{'name': space.benchmark_name(candidate),
+                       'run_type': 'iteration',
+                       'items_per_second': self.items_per_second(space, candidate, budget)}
+                      for candidate in candidates]
+        output = {'context': {'hdp_gcn_arch_name': self.arch,
+                              'autotune_config_pattern': space.name_pattern},
+                  'benchmarks': benchmarks}
+        os.makedirs(self.output_dir, exist_ok=True)
+        output_path = os.path.join(self.output_dir, f'{space.target}_round{self.round}.json')
+        self.round += 1
+        with open(output_path, 'w') as output_file:
+            json.dump(output, output_file, indent=2)
+        return output_path
+
+def read_scores(space: SearchSpace, output_path: str) -> Dict[Candidate, float]:
+    """
+    Returns the best items per second of the benchmarks of every candidate, a candidate
+    may register several benchmarks (e.g. for every items per thread of a kernel).
+    """
+
+    with open(output_path) as output_file:
+        output = json.load(output_file)
+    scores: Dict[Candidate, float] = {}
+    for benchmark in output['benchmarks']:
+        if benchmark.get('run_type', 'iteration') != 'iteration' or benchmark.get('error_occurred'):
+            continue
+        match = re.search(space.name_pattern, benchmark['name'])
+        if not match:
+            raise RuntimeError(f"ERROR: cannot tokenize \"{benchmark['name']}\" with regex:\n{space.name_pattern}")
+        candidate = space.candidate_of(match.groupdict())
+        scores[candidate] = max(scores.get(candidate, 0.0), benchmark['items_per_second'])
+    return scores
+
+def neighbours(space: SearchSpace, parameters: Tuple[str, ...]) -> List[Tuple[str, ...]]:
+    """
+    Returns the parameter values which differ from parameters by one step of a single parameter.
+    """
+
+    result: List[Tuple[str, ...]] = []
+    for index, values in enumerate(space.parameters.values()):
+        position = values.index(parameters[index])
+        for step in (-1, 1):
+            if 0 <= position + step < len(values):
+                result.append(parameters[:index] + (values[position + step],) + parameters[index + 1:])
+    return result
+
+def successive_halving(space: SearchSpace, evaluator, types: List[str], initial_candidates: int,
+                       eta: int, min_trials: int, max_trials: int,
+                       rng: random.Random) -> Tuple[Dict[str, Candidate], str]:
+    """
+    Searches the best candidate of every type. Starts with at most initial_candidates random
+    candidates per type evaluated with min_trials, keeps the best 1/eta of them and multiplies
+    the trials by eta. After every halving the neighbours of the kept candidates which were not
+    evaluated yet are added, so the search is refined outside of the random sample. When a single
+    candidate per type is left and all its neighbours were evaluated, the last round is evaluated
+    with max_trials. Returns the best candidate of every type and the results of the last round.
+    """
+
+    grid = [tuple(values) for values in _product(list(space.parameters.values()))]
+    population: Dict[str, List[Candidate]] = {}
+    evaluated: Dict[str, set] = {}
+    for type_value in types:
+        parameters = rng.sample(grid, min(initial_candidates, len(grid)))
+        population[type_value] = [(type_value, p) for p in parameters]
+        evaluated[type_value] = set(parameters)
+
+    trials = min_trials
+    last_round = False
+    while True:
+        if last_round:
+            trials = max_trials
+        candidates = [c for type_candidates in population.values() for c in type_candidates]
+        print(f'{space.target}: evaluating {len(candidates)} candidates with {trials} trials',
+              file=sys.stderr)
+        output_path = evaluator.evaluate(space, candidates, trials)
+        scores = read_scores(space, output_path)
+        if last_round:
+            return {type_value: type_candidates[0]
+                    for type_value, type_candidates in population.items()}, output_path
+
+        # Every round either evaluates new parameters or halves the candidates, so the search
+        # terminates
+        last_round = True
+        for type_value, type_candidates in population.items():
+            ranked = sorted(type_candidates, key=lambda c: scores.get(c, 0.0), reverse=True)
+            kept = ranked[:max(1, len(ranked) // eta)]
+            added = []
+            for _, parameters in kept:
+                for neighbour in neighbours(space, parameters):
+                    if neighbour not in evaluated[type_value]:
+                        evaluated[type_value].add(neighbour)
+                        added.append((type_value, neighbour))
+            population[type_value] = kept + added
+            last_round = last_round and len(population[type_value]) == 1
+        trials = min(trials * eta, max_trials)
+
+def _product(lists: List[List[str]]) -> List[List[str]]:
+    result: List[List[str]] = [[]]
+    for values in lists:
+        result = [prefix + [value] for prefix in result for value in values]
+    return result
+
+def main():
+    current_dir = os.path.dirname(os.path.abspath(__file__))
+    source_dir = os.path.abspath(os.path.join(current_dir, '..', '..'))
+
+    parser = argparse.ArgumentParser(description="Tool for searching optimized launch parameters for rocPRIM with successive halving")
+    parser.add_argument('-a', '--algorithms', nargs='+', default=list(SEARCH_SPACES.keys()), choices=list(SEARCH_SPACES.keys()), help="Algorithms to tune")
+    parser.add_argument('-t', '--types', nargs='+', help="Types to tune, the values of the type names in benchmark/ConfigAutotuneSettings.cmake (default: all)")
+    parser.add_argument("-p", "--out_basedir", type=str, help="Base dir for the configuration files, for each algorithm a new file will be created in this directory", required=True)
+    parser.add_argument("-c", "--fallback_configuration", type=argparse.FileType('r'), default=os.path.join(current_dir, "fallback_config.json"), help="Configuration for fallbacks for not tested datatypes")
+    parser.add_argument('-b', '--build_dir', type=str, default=os.path.join(source_dir, 'build-autotune'), help="Build directory of the benchmarks")
+    parser.add_argument('--cmake_args', nargs='*', default=[], help="Additional CMake arguments, e.g. -DUSE_HIP_CPU=ON or -DAMDGPU_TARGETS=gfx90a")
+    parser.add_argument('--size', type=int, help="Number of items of the benchmarks")
+    parser.add_argument('--initial_candidates', type=int, default=16, help="Random candidates per type in the first round")
+    parser.add_argument('--eta', type=int, default=2, help="Fraction (1/eta) of the candidates kept every round")
+    parser.add_argument('--min_trials', type=int, default=5, help="Trials of the first round")
+    parser.add_argument('--max_trials', type=int, default=50, help="Trials of the last round")
+    parser.add_argument('--seed', type=int, default=0, help="Seed of the random candidates and the mock timing source")
+    parser.add_argument('--mock', action='store_true', help="Use the mock timing source instead of building and running the benchmarks")
+    parser.add_argument('--mock_arch', type=str, default='gfx90a', help="Architecture reported by the mock timing source")
+    parser.add_argument('--mock_noise', type=float, default=0.2, help="Relative noise of a single trial of the mock timing source")
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    if args.mock:
+        evaluator = MockEvaluator(args.build_dir, args.mock_arch, args.seed, args.mock_noise)
+    else:
+        evaluator = BuildEvaluator(source_dir, args.build_dir, args.cmake_args, args.size)
+
+    benchmark_manager = create_optimization.BenchmarkDataManager(args.fallback_configuration)
+    found_optimum = True
+    for algorithm in args.algorithms:
+        space = SEARCH_SPACES[algorithm]
+        types = [t for t in space.types if not args.types or t in args.types]
+        best, output_path = successive_halving(space, evaluator, types, args.initial_candidates,
+                                               args.eta, args.min_trials, args.max_trials, rng)
+        for type_value, candidate in best.items():
+            print(f"{algorithm}<{type_value}>: {', '.join(f'{name}={value}' for name, value in zip(space.parameters.keys(), candidate[1]))}")
+            if args.mock:
+                found_optimum = found_optimum and candidate == evaluator.optimal_candidate(space, type_value)
+        benchmark_manager.add_run(output_path)
+
+    os.makedirs(args.out_basedir, exist_ok=True)
+    benchmark_manager.write_configs_to_files(args.out_basedir)
+
+    if args.mock:
+        print(f'{evaluator.evaluations} evaluations, '
+              f"{'found' if found_optimum else 'did not find'} the optimum of every type", file=sys.stderr)
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+"""
+Tests the search of autotune_search.py with the mock timing source.
+Run with: python3 -m unittest test_autotune_search
+"""
+
+import contextlib
+import io
+import random
+import tempfile
+import unittest
+
+import autotune_search
+
+class SuccessiveHalvingTest(unittest.TestCase):
+
+    def search(self, algorithm: str, seed: int, initial_candidates: int):
+        space = autotune_search.SEARCH_SPACES[algorithm]
+        with tempfile.TemporaryDirectory() as output_dir, contextlib.redirect_stderr(io.StringIO()):
+            evaluator = autotune_search.MockEvaluator(output_dir, 'gfx90a', seed, 0.2)
+            best, _ = autotune_search.successive_halving(space, evaluator, space.types,
+                                                         initial_candidates, 2, 5, 50,
+                                                         random.Random(seed))
+        return space, evaluator, best
+
+    def test_finds_optimum(self):
+        for algorithm in autotune_search.SEARCH_SPACES:
+            for seed in range(3):
+                with self.subTest(algorithm=algorithm, seed=seed):
+                    space, evaluator, best = self.search(algorithm, seed, 16)
+                    self.assertEqual(set(best.keys()), set(space.types))
+                    for type_value, candidate in best.items():
+                        self.assertEqual(candidate, evaluator.optimal_candidate(space, type_value))
+
+    def test_refines_outside_of_initial_sample(self):
+        # A single random candidate per type is rarely the optimum, it is found by the refinement
+        for algorithm in autotune_search.SEARCH_SPACES:
+            with self.subTest(algorithm=algorithm):
+                space, evaluator, best = self.search(algorithm, 7, 1)
+                for type_value, candidate in best.items():
+                    self.assertEqual(candidate, evaluator.optimal_candidate(space, type_value))
+
+    def test_neighbours(self):
+        space = autotune_search.SEARCH_SPACES['device_reduce']
+        self.assertEqual(sorted(autotune_search.neighbours(space, ('64', '1'))),
+                         sorted([('128', '1'), ('64', '2')]))
+        self.assertEqual(len(autotune_search.neighbours(space, ('128', '4'))), 4)
+
+if __name__ == '__main__':
+    unittest.main()
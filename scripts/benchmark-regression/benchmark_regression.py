@@ -0,0 +1,294 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+"""
+This Python script tracks the performance of the rocPRIM benchmarks between runs.
+It runs the benchmark executables (or reads their Google Benchmark JSON output),
+stores the bytes and items per second of every benchmark in a baseline file,
+flags statistically significant regressions between two baselines, and reports
+the achieved bandwidth as a fraction of the peak bandwidth.
+
+The script only relies on the Google Benchmark output and the context written by
+benchmark_utils.hpp, so it works the same for HIP and HIP-CPU builds.
+"""
+
+import argparse
+import json
+import math
+import os
+import re
+import subprocess
+import sys
+import tempfile
+from typing import Dict, List, Optional, Tuple
+
+BASELINE_VERSION = 1
+
+# Throughput metrics, higher is better
+THROUGHPUT_METRICS = ['bytes_per_second', 'items_per_second']
+
+def algorithm_name(benchmark_name: str, name_regex: Optional[str]) -> str:
+    """
+    Returns the algorithm of a benchmark, the 'algo' group of the autotune name pattern
+    if the benchmark has one, otherwise the part of the name before the template arguments.
+    """
+
+    if name_regex:
+        match = re.search(name_regex, benchmark_name)
+        if match and 'algo' in match.groupdict():
+            return match.group('algo')
+    return re.split(r'[<(/ ]', benchmark_name, maxsplit=1)[0]
+
+def load_benchmark_output(path: str) -> Dict:
+    """
+    Converts a Google Benchmark JSON output file to the baseline format.
+    Every repetition of a benchmark is a sample, aggregates are recomputed from the samples.
+    """
+
+    with open(path) as file_handle:
+        output = json.load(file_handle)
+
+    context = output.get('context', {})
+    executable = os.path.basename(context.get('executable', path))
+    name_regex = context.get('autotune_config_pattern')
+    peak_bandwidth = float(context.get('peak_bandwidth', 0))
+
+    benchmarks = {}
+    for run in output.get('benchmarks', []):
+        if run.get('run_type', 'iteration') != 'iteration' or run.get('error_occurred', False):
+            continue
+        name = run.get('run_name', run['name'])
+        key = f'{executable}/{name}'
+        entry = benchmarks.setdefault(key, {
+            'executable': executable,
+            'name': name,
+            'algorithm': algorithm_name(name, name_regex),
+            'distribution': context.get('distribution', 'uniform'),
+            'peak_bandwidth': peak_bandwidth,
+            'time_unit': run.get('time_unit', 'ns'),
+            'real_time': [],
+        })
+        entry['real_time'].append(run['real_time'])
+        for metric in THROUGHPUT_METRICS:
+            if metric in run:
+                entry.setdefault(metric, []).append(run[metric])
+
+    return {'version': BASELINE_VERSION, 'context': {executable: context}, 'benchmarks': benchmarks}
+
+def load_results(path: str) -> Dict:
+    """
+    Loads a baseline file, or a Google Benchmark JSON output file.
+    """
+
+    with open(path) as file_handle:
+        data = json.load(file_handle)
+    if data.get('version') == BASELINE_VERSION:
+        return data
+    return load_benchmark_output(path)
+
+def merge_results(results: List[Dict]) -> Dict:
+    merged = {'version': BASELINE_VERSION, 'context': {}, 'benchmarks': {}}
+    for result in results:
+        merged['context'].update(result['context'])
+        merged['benchmarks'].update(result['benchmarks'])
+    return merged
+
+def write_results(results: Dict, path: str):
+    with open(path, 'w') as file_handle:
+        json.dump(results, file_handle, indent=2)
+        file_handle.write('\n')
+
+def mean(samples: List[float]) -> float:
+    return sum(samples) / len(samples)
+
+def variance(samples: List[float]) -> float:
+    sample_mean = mean(samples)
+    return sum((x - sample_mean) ** 2 for x in samples) / (len(samples) - 1)
+
+def incomplete_beta(a: float, b: float, x: float) -> float:
+    """
+    Regularized incomplete beta function I_x(a, b), evaluated with a continued fraction.
+    """
+
+    if x <= 0:
+        return 0.0
+    if x >= 1:
+        return 1.0
+    if x > (a + 1) / (a + b + 2):
+        return 1.0 - incomplete_beta(b, a, 1.0 - x)
+
+    log_front = math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b) \
+        + a * math.log(x) + b * math.log(1.0 - x)
+    tiny = 1e-300
+    c = 1.0
+    d = 1.0 - (a + b) * x / (a + 1)
+    d = 1.0 / (d if abs(d) > tiny else tiny)
+    fraction = d
+    for m in range(1, 200):
+        for numerator in (m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m)),
+                          -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1))):
+            d = 1.0 + numerator * d
+            d = 1.0 / (d if abs(d) > tiny else tiny)
+            c = 1.0 + numerator / c
+            c = c if abs(c) > tiny else tiny
+            fraction *= c * d
+        if abs(c * d - 1.0) < 1e-12:
+            break
+    return math.exp(log_front) * fraction / a
+
+def welch_t_test(samples1: List[float], samples2: List[float]) -> Optional[float]:
+    """
+    Returns the two-sided p-value of Welch's t-test, or None if there are too few samples.
+    """
+
+    if len(samples1) < 2 or len(samples2) < 2:
+        return None
+    standard_error1 = variance(samples1) / len(samples1)
+    standard_error2 = variance(samples2) / len(samples2)
+    standard_error = standard_error1 + standard_error2
+    if standard_error == 0:
+        return 1.0 if mean(samples1) == mean(samples2) else 0.0
+    t = (mean(samples1) - mean(samples2)) / math.sqrt(standard_error)
+    degrees_of_freedom = standard_error ** 2 / (
+        standard_error1 ** 2 / (len(samples1) - 1) + standard_error2 ** 2 / (len(samples2) - 1))
+    return incomplete_beta(degrees_of_freedom / 2, 0.5,
+                           degrees_of_freedom / (degrees_of_freedom + t * t))
+
+def comparison_metric(baseline: Dict, current: Dict) -> Tuple[str, List[float], List[float]]:
+    """
+    Returns the metric compared between two runs of a benchmark, and its samples as throughputs:
+    bytes or items per second when available, otherwise the inverse of the time.
+    """
+
+    for metric in THROUGHPUT_METRICS:
+        if metric in baseline and metric in current:
+            return metric, baseline[metric], current[metric]
+    return 'real_time', [1.0 / t for t in baseline['real_time']], \
+        [1.0 / t for t in current['real_time']]
+
+def format_rate(value: float) -> str:
+    for unit in ['', 'k', 'M', 'G', 'T']:
+        if abs(value) < 1000 or unit == 'T':
+            return f'{value:.3f}{unit}'
+        value /= 1000
+    return ''
+
+def bandwidth_of_peak(entry: Dict, peak_bandwidth: float) -> Optional[float]:
+    peak = peak_bandwidth or entry.get('peak_bandwidth', 0)
+    if peak <= 0 or 'bytes_per_second' not in entry:
+        return None
+    return mean(entry['bytes_per_second']) / (peak * 1e9)
+
+def run_benchmarks(args) -> int:
+    results = []
+    for executable in args.executables:
+        with tempfile.TemporaryDirectory() as output_dir:
+            output_path = os.path.join(output_dir, 'output.json')
+            command = [executable,
+                       f'--benchmark_out={output_path}',
+                       '--benchmark_out_format=json',
+                       f'--benchmark_repetitions={args.repetitions}']
+            if args.peak_bandwidth:
+                command += ['--peak_bandwidth', str(args.peak_bandwidth)]
+            command += args.benchmark_args
+            print('Running ' + ' '.join(command), file=sys.stderr)
+            subprocess.run(command, check=True)
+            results.append(load_benchmark_output(output_path))
+    write_results(merge_results(results), args.output)
+    return 0
+
+def record_results(args) -> int:
+    write_results(merge_results([load_results(path) for path in args.inputs]), args.output)
+    return 0
+
+def report_results(args) -> int:
+    results = load_results(args.results)
+    print(f"{'benchmark':<80} {'bytes/s':>12} {'items/s':>12} {'of peak':>8}")
+    for key, entry in sorted(results['benchmarks'].items()):
+        rates = [format_rate(mean(entry[metric])) if metric in entry else '-'
+                 for metric in THROUGHPUT_METRICS]
+        fraction = bandwidth_of_peak(entry, args.peak_bandwidth)
+        fraction_text = f'{fraction:.1%}' if fraction is not None else '-'
+        print(f'{key:<80} {rates[0]:>12} {rates[1]:>12} {fraction_text:>8}')
+    return 0
+
+def compare_results(args) -> int:
+    baseline = load_results(args.baseline)['benchmarks']
+    current = load_results(args.current)['benchmarks']
+
+    regressions = 0
+    print(f"{'benchmark':<80} {'metric':>16} {'change':>8} {'p-value':>8}  status")
+    for key in sorted(baseline.keys() | current.keys()):
+        if key not in current or key not in baseline:
+            print(f"{key:<80} {'':>16} {'':>8} {'':>8}  {'removed' if key not in current else 'new'}")
+            continue
+        metric, baseline_samples, current_samples = comparison_metric(baseline[key], current[key])
+        change = mean(current_samples) / mean(baseline_samples) - 1.0
+        p_value = welch_t_test(baseline_samples, current_samples)
+        # Without repetitions only the threshold can be checked
+        significant = p_value is None or p_value < args.alpha
+        status = ''
+        if significant and change < -args.threshold:
+            status = 'REGRESSION'
+            regressions += 1
+        elif significant and change > args.threshold:
+            status = 'improvement'
+        p_value_text = f'{p_value:.4f}' if p_value is not None else '-'
+        print(f'{key:<80} {metric:>16} {change:>+8.1%} {p_value_text:>8}  {status}')
+
+    print(f'{regressions} regression(s) found', file=sys.stderr)
+    return 1 if regressions > 0 else 0
+
+def main():
+    parser = argparse.ArgumentParser(description="Tool for tracking the performance of the rocPRIM benchmarks between runs")
+    subparsers = parser.add_subparsers(dest='command', required=True)
+
+    run_parser = subparsers.add_parser('run', help="Run benchmark executables and store their results as a baseline")
+    run_parser.add_argument('executables', nargs='+', help="Benchmark executables, e.g. benchmark/benchmark_device_radix_sort")
+    run_parser.add_argument('-o', '--output', required=True, help="Baseline file to write")
+    run_parser.add_argument('-r', '--repetitions', type=int, default=5, help="Repetitions of every benchmark, the samples of the significance test")
+    run_parser.add_argument('--peak_bandwidth', type=float, default=0, help="Peak memory bandwidth in GB/s, 0 to use the bandwidth of the device")
+    run_parser.add_argument('--benchmark_args', nargs=argparse.REMAINDER, default=[], help="Remaining arguments are passed to the benchmarks")
+    run_parser.set_defaults(function=run_benchmarks)
+
+    record_parser = subparsers.add_parser('record', help="Store Google Benchmark JSON outputs as a baseline")
+    record_parser.add_argument('inputs', nargs='+', help="Outputs of --benchmark_out=<file> --benchmark_out_format=json")
+    record_parser.add_argument('-o', '--output', required=True, help="Baseline file to write")
+    record_parser.set_defaults(function=record_results)
+
+    report_parser = subparsers.add_parser('report', help="Report the throughput and the fraction of the peak bandwidth")
+    report_parser.add_argument('results', help="Baseline file or Google Benchmark JSON output")
+    report_parser.add_argument('--peak_bandwidth', type=float, default=0, help="Peak memory bandwidth in GB/s, overrides the bandwidth of the run")
+    report_parser.set_defaults(function=report_results)
+
+    compare_parser = subparsers.add_parser('compare', help="Flag significant regressions between two runs, exits with 1 if any is found")
+    compare_parser.add_argument('baseline', help="Baseline file or Google Benchmark JSON output")
+    compare_parser.add_argument('current', help="Baseline file or Google Benchmark JSON output")
+    compare_parser.add_argument('--alpha', type=float, default=0.05, help="Significance level of Welch's t-test")
+    compare_parser.add_argument('--threshold', type=float, default=0.03, help="Smallest relative change that is reported")
+    compare_parser.set_defaults(function=compare_results)
+
+    args = parser.parse_args()
+    sys.exit(args.function(args))
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,243 @@
+// MIT License
+//
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "common_test_header.hpp"
+
+#include <cstring>
+
+// required rocprim headers
+#include <rocprim/block/block_radix_rank.hpp>
+
+// required test headers
+#include "test_utils.hpp"
+
+template<
+    class Key,
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    unsigned int RadixBits,
+    unsigned int BeginBit,
+    unsigned int PassBits,
+    bool Descending
+>
+struct params
+{
+    using key_type = Key;
+    static constexpr unsigned int block_size = BlockSize;
+    static constexpr unsigned int items_per_thread = ItemsPerThread;
+    static constexpr unsigned int radix_bits = RadixBits;
+    static constexpr unsigned int begin_bit = BeginBit;
+    static constexpr unsigned int pass_bits = PassBits;
+    static constexpr bool descending = Descending;
+};
+
+template<class Params>
+class RocprimBlockRadixRank : public ::testing::Test
+{
+public:
+    using params = Params;
+};
+
+typedef ::testing::Types<
+    params<unsigned int, 64U, 1U, 4U, 0U, 4U, false>,
+    params<unsigned int, 128U, 4U, 4U, 4U, 4U, false>,
+    params<unsigned int, 64U, 3U, 8U, 8U, 8U, false>,
+    params<unsigned int, 129U, 2U, 5U, 3U, 5U, true>,
+    params<unsigned int, 162U, 7U, 4U, 28U, 4U, true>,
+    params<int, 256U, 4U, 6U, 26U, 6U, false>,
+    params<int, 255U, 2U, 4U, 0U, 3U, true>,
+    params<uint8_t, 96U, 8U, 8U, 0U, 8U, false>,
+    params<unsigned short, 192U, 2U, 7U, 9U, 7U, true>,
+    params<unsigned long long, 256U, 2U, 4U, 60U, 4U, false>,
+    params<float, 128U, 3U, 4U, 28U, 4U, false>,
+    params<double, 64U, 5U, 8U, 56U, 8U, true>
+> Params;
+
+TYPED_TEST_SUITE(RocprimBlockRadixRank, Params);
+
+// Host version of the order-preserving key transformation used by radix sort
+template<bool Descending, class Key>
+unsigned long long host_bit_key(Key key)
+{
+    using bit_key_type = typename rocprim::get_unsigned_bits_type<Key>::unsigned_type;
+    constexpr bit_key_type sign_bit = bit_key_type(1) << (8 * sizeof(Key) - 1);
+
+    bit_key_type bit_key;
+    std::memcpy(&bit_key, &key, sizeof(Key));
+    if(rocprim::is_floating_point<Key>::value)
+    {
+        bit_key = (bit_key & sign_bit) ? bit_key_type(~bit_key) : bit_key_type(bit_key ^ sign_bit);
+    }
+    else if(std::is_signed<Key>::value)
+    {
+        bit_key ^= sign_bit;
+    }
+    return Descending ? bit_key_type(~bit_key) : bit_key;
+}
+
+template<
+    unsigned int BlockSize,
+    unsigned int ItemsPerThread,
+    unsigned int RadixBits,
+    bool Descending,
+    class Key
+>
+__global__
+__launch_bounds__(BlockSize)
+void rank_kernel(const Key* keys_input,
+                 unsigned int* ranks_output,
+                 unsigned int begin_bit,
+                 unsigned int pass_bits)
+{
+    using block_rank_type = rocprim::block_radix_rank<BlockSize, RadixBits>;
+
+    constexpr unsigned int items_per_block = BlockSize * ItemsPerThread;
+    const unsigned int lid = threadIdx.x;
+    const unsigned int block_offset = blockIdx.x * items_per_block;
+
+    ROCPRIM_SHARED_MEMORY typename block_rank_type::storage_type storage;
+
+    Key keys[ItemsPerThread];
+    unsigned int ranks[ItemsPerThread];
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        keys[i] = keys_input[block_offset + lid * ItemsPerThread + i];
+    }
+
+    if(Descending)
+    {
+        block_rank_type().rank_keys_desc(keys, ranks, storage, begin_bit, pass_bits);
+    }
+    else
+    {
+        block_rank_type().rank_keys(keys, ranks, storage, begin_bit, pass_bits);
+    }
+
+    for(unsigned int i = 0; i < ItemsPerThread; i++)
+    {
+        ranks_output[block_offset + lid * ItemsPerThread + i] = ranks[i];
+    }
+}
+
+TYPED_TEST(RocprimBlockRadixRank, RankKeys)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using key_type = typename TestFixture::params::key_type;
+    constexpr unsigned int block_size = TestFixture::params::block_size;
+    constexpr unsigned int items_per_thread = TestFixture::params::items_per_thread;
+    constexpr unsigned int radix_bits = TestFixture::params::radix_bits;
+    constexpr unsigned int begin_bit = TestFixture::params::begin_bit;
+    constexpr unsigned int pass_bits = TestFixture::params::pass_bits;
+    constexpr bool descending = TestFixture::params::descending;
+    constexpr unsigned int items_per_block = block_size * items_per_thread;
+
+    // Given block size not supported
+    if(block_size > test_utils::get_max_block_size())
+    {
+        return;
+    }
+
+    const size_t grid_size = 7;
+    const size_t size = items_per_block * grid_size;
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value = seed_index < random_seeds_count  ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        std::vector<key_type> keys;
+        if(rocprim::is_floating_point<key_type>::value)
+        {
+            keys = test_utils::get_random_data<key_type>(size, -1000, +1000, seed_value);
+        }
+        else
+        {
+            keys = test_utils::get_random_data<key_type>(
+                size,
+                std::numeric_limits<key_type>::min(),
+                std::numeric_limits<key_type>::max(),
+                seed_value
+            );
+        }
+
+        // Expected rank: the number of items in the block with a lesser digit, plus the number
+        // of preceding items with the same digit
+        std::vector<unsigned int> expected(size);
+        for(size_t b = 0; b < grid_size; b++)
+        {
+            std::vector<unsigned int> digit_counts(1u << radix_bits, 0);
+            std::vector<unsigned int> digits(items_per_block);
+            for(size_t i = 0; i < items_per_block; i++)
+            {
+                const unsigned long long bit_key
+                    = host_bit_key<descending>(keys[b * items_per_block + i]);
+                digits[i] = static_cast<unsigned int>(bit_key >> begin_bit) & ((1u << pass_bits) - 1);
+                digit_counts[digits[i]]++;
+            }
+            std::vector<unsigned int> digit_starts(1u << radix_bits, 0);
+            for(size_t d = 1; d < digit_starts.size(); d++)
+            {
+                digit_starts[d] = digit_starts[d - 1] + digit_counts[d - 1];
+            }
+            for(size_t i = 0; i < items_per_block; i++)
+            {
+                expected[b * items_per_block + i] = digit_starts[digits[i]]++;
+            }
+        }
+
+        key_type* d_keys;
+        unsigned int* d_ranks;
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys, size * sizeof(key_type)));
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_ranks, size * sizeof(unsigned int)));
+        HIP_CHECK(
+            hipMemcpy(
+                d_keys, keys.data(),
+                size * sizeof(key_type),
+                hipMemcpyHostToDevice
+            )
+        );
+
+        hipLaunchKernelGGL(
+            HIP_KERNEL_NAME(rank_kernel<block_size, items_per_thread, radix_bits, descending, key_type>),
+            dim3(grid_size), dim3(block_size), 0, 0,
+            d_keys, d_ranks, begin_bit, pass_bits
+        );
+        HIP_CHECK(hipGetLastError());
+
+        std::vector<unsigned int> ranks(size);
+        HIP_CHECK(
+            hipMemcpy(
+                ranks.data(), d_ranks,
+                size * sizeof(unsigned int),
+                hipMemcpyDeviceToHost
+            )
+        );
+
+        ASSERT_EQ(ranks, expected);
+
+        HIP_CHECK(hipFree(d_keys));
+        HIP_CHECK(hipFree(d_ranks));
+    }
+}
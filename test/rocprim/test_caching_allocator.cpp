@@ -0,0 +1,218 @@
+// MIT License
+//
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "common_test_header.hpp"
+
+// required rocprim headers
+#include <rocprim/device/caching_allocator.hpp>
+#include <rocprim/device/device_reduce.hpp>
+
+// required test headers
+#include "test_utils_types.hpp"
+
+TEST(RocprimCachingAllocatorTests, Bins)
+{
+    rocprim::caching_allocator allocator(8, 3, 7);
+
+    ASSERT_EQ(allocator.bin_bytes(0), size_t(512));
+    ASSERT_EQ(allocator.bin_bytes(1), size_t(512));
+    ASSERT_EQ(allocator.bin_bytes(512), size_t(512));
+    ASSERT_EQ(allocator.bin_bytes(513), size_t(4096));
+    ASSERT_EQ(allocator.bin_bytes(2 * 1024 * 1024), size_t(2 * 1024 * 1024));
+    // Larger than the largest bin: not rounded up
+    ASSERT_EQ(allocator.bin_bytes(2 * 1024 * 1024 + 1), size_t(2 * 1024 * 1024 + 1));
+}
+
+TEST(RocprimCachingAllocatorTests, Reuse)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    rocprim::caching_allocator allocator;
+    const hipStream_t          stream = 0;
+
+    void* a;
+    HIP_CHECK(allocator.allocate(&a, 1000, stream));
+    ASSERT_NE(a, nullptr);
+    ASSERT_EQ(allocator.statistics().misses, size_t(1));
+    ASSERT_EQ(allocator.statistics().live_bytes, allocator.bin_bytes(1000));
+
+    // The block is in use, a second allocation of the same bin needs a new block
+    void* b;
+    HIP_CHECK(allocator.allocate(&b, 1000, stream));
+    ASSERT_NE(a, b);
+    ASSERT_EQ(allocator.statistics().misses, size_t(2));
+
+    HIP_CHECK(allocator.deallocate(a));
+    ASSERT_EQ(allocator.statistics().cached_bytes, allocator.bin_bytes(1000));
+
+    // A smaller request of the same bin on the same stream reuses the block
+    void* c;
+    HIP_CHECK(allocator.allocate(&c, 600, stream));
+    ASSERT_EQ(c, a);
+    ASSERT_EQ(allocator.statistics().hits, size_t(1));
+    ASSERT_EQ(allocator.statistics().misses, size_t(2));
+    ASSERT_EQ(allocator.statistics().cached_bytes, size_t(0));
+
+    // A request of another bin does not
+    HIP_CHECK(allocator.deallocate(c));
+    void* d;
+    HIP_CHECK(allocator.allocate(&d, 100, stream));
+    ASSERT_NE(d, a);
+    ASSERT_EQ(allocator.statistics().misses, size_t(3));
+
+    // The memory is usable
+    HIP_CHECK(hipMemset(b, 1, 1000));
+    HIP_CHECK(hipMemset(d, 1, 100));
+
+    HIP_CHECK(allocator.deallocate(b));
+    HIP_CHECK(allocator.deallocate(d));
+    ASSERT_EQ(allocator.statistics().live_bytes, size_t(0));
+
+    allocator.reset_statistics();
+    ASSERT_EQ(allocator.statistics().hits, size_t(0));
+    ASSERT_EQ(allocator.statistics().misses, size_t(0));
+}
+
+TEST(RocprimCachingAllocatorTests, OtherStream)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    rocprim::caching_allocator allocator;
+
+    hipStream_t stream;
+    HIP_CHECK(hipStreamCreate(&stream));
+
+    void* a;
+    HIP_CHECK(allocator.allocate(&a, 1000, stream));
+    HIP_CHECK(hipMemsetAsync(a, 0, 1000, stream));
+    HIP_CHECK(allocator.deallocate(a));
+
+    // After the work on the first stream completed the block can be used by other streams
+    HIP_CHECK(hipStreamSynchronize(stream));
+    void* b;
+    HIP_CHECK(allocator.allocate(&b, 1000, 0));
+    ASSERT_EQ(b, a);
+    ASSERT_EQ(allocator.statistics().hits, size_t(1));
+    HIP_CHECK(allocator.deallocate(b));
+
+    HIP_CHECK(hipStreamDestroy(stream));
+}
+
+TEST(RocprimCachingAllocatorTests, LimitsAndTrim)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    // Bins of 512, 4096 and 32768 bytes, at most 40000 bytes cached
+    rocprim::caching_allocator allocator(8, 3, 5, 40000);
+
+    void* large;
+    HIP_CHECK(allocator.allocate(&large, 50000));
+    ASSERT_EQ(allocator.statistics().live_bytes, size_t(50000));
+    // Larger than the largest bin: freed, not cached
+    HIP_CHECK(allocator.deallocate(large));
+    ASSERT_EQ(allocator.statistics().cached_bytes, size_t(0));
+    ASSERT_EQ(allocator.statistics().live_bytes, size_t(0));
+
+    void* ptrs[3];
+    HIP_CHECK(allocator.allocate(&ptrs[0], 30000));
+    HIP_CHECK(allocator.allocate(&ptrs[1], 4000));
+    HIP_CHECK(allocator.allocate(&ptrs[2], 30000));
+    for(void* ptr : ptrs)
+    {
+        HIP_CHECK(allocator.deallocate(ptr));
+    }
+    // The second 32768 bytes block does not fit into the cache
+    ASSERT_EQ(allocator.statistics().cached_bytes, size_t(32768 + 4096));
+
+    // The largest blocks are freed first
+    HIP_CHECK(allocator.trim(5000));
+    ASSERT_EQ(allocator.statistics().cached_bytes, size_t(4096));
+    HIP_CHECK(allocator.trim());
+    ASSERT_EQ(allocator.statistics().cached_bytes, size_t(0));
+
+    // Not allocated by the allocator
+    int dummy;
+    ASSERT_EQ(allocator.deallocate(&dummy), hipErrorInvalidValue);
+}
+
+TEST(RocprimCachingAllocatorTests, RunWithAllocator)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    const hipStream_t stream = 0;
+
+    rocprim::caching_allocator allocator;
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        const size_t     size  = 12345;
+        std::vector<int> input = test_utils::get_random_data<int>(size, -100, 100, seed_value);
+        const int        expected = std::accumulate(input.begin(), input.end(), 0);
+
+        int* d_input;
+        int* d_output;
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, size * sizeof(int)));
+        HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, sizeof(int)));
+        HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(int), hipMemcpyHostToDevice));
+
+        for(int i = 0; i < 3; i++)
+        {
+            HIP_CHECK(rocprim::run_with_allocator(
+                allocator,
+                stream,
+                [&](void* temporary_storage, size_t& storage_size)
+                {
+                    return rocprim::reduce(temporary_storage,
+                                           storage_size,
+                                           d_input,
+                                           d_output,
+                                           size,
+                                           rocprim::plus<int>(),
+                                           stream);
+                }));
+
+            int output;
+            HIP_CHECK(hipMemcpy(&output, d_output, sizeof(int), hipMemcpyDeviceToHost));
+            ASSERT_EQ(output, expected);
+        }
+
+        HIP_CHECK(hipFree(d_input));
+        HIP_CHECK(hipFree(d_output));
+    }
+
+    // Only the first reduction allocated the temporary storage
+    ASSERT_EQ(allocator.statistics().misses, size_t(1));
+    ASSERT_EQ(allocator.statistics().hits, 3 * (random_seeds_count + seed_size) - 1);
+    ASSERT_EQ(allocator.statistics().live_bytes, size_t(0));
+}
@@ -1,6 +1,20 @@
 #include "common_test_header.hpp"
 
 #include <rocprim/device/config_types.hpp>
+#include <rocprim/device/device_adjacent_difference_config.hpp>
+#include <rocprim/device/device_histogram_config.hpp>
+#include <rocprim/device/device_memcpy_config.hpp>
+#include <rocprim/device/device_merge_config.hpp>
+#include <rocprim/device/device_merge_sort_config.hpp>
+#include <rocprim/device/device_radix_sort_config.hpp>
+#include <rocprim/device/device_reduce_by_key_config.hpp>
+#include <rocprim/device/device_reduce_config.hpp>
+#include <rocprim/device/device_scan_by_key_config.hpp>
+#include <rocprim/device/device_scan_config.hpp>
+#include <rocprim/device/device_segmented_radix_sort_config.hpp>
+#include <rocprim/device/device_select_config.hpp>
+#include <rocprim/device/device_topk_config.hpp>
+#include <rocprim/device/device_transform_config.hpp>
 
 #include <hip/hip_runtime.h>
 
@@ -12,6 +26,14 @@ __global__ void write_target_arch(target_arch* dest_arch)
     *dest_arch                 = arch;
 }
 
+// Kernels are instantiated once per wrapped config and select the config of the architecture
+// they are compiled for, like the kernels of the device algorithms.
+template<class WrappedConfig>
+__global__ void write_items_per_thread(unsigned int* dest)
+{
+    *dest = rocprim::detail::device_target_arch_config_t<WrappedConfig>::items_per_thread;
+}
+
 // If this compile then
 TEST(RocprimConfigDispatchTests, StrEqualN)
 {
@@ -108,3 +130,406 @@ TEST(RocprimConfigDispatchTests, DeviceIdFromStream)
     ASSERT_EQ(result, device_id);
 }
 #endif
+
+namespace
+{
+
+using rocprim::detail::dispatch_target_arch_config;
+
+constexpr target_arch dispatched_arches[] = {target_arch::unknown,
+                                             target_arch::gfx803,
+                                             target_arch::gfx900,
+                                             target_arch::gfx906,
+                                             target_arch::gfx908,
+                                             target_arch::gfx90a,
+                                             target_arch::gfx1030};
+
+// Checks that the wrapped config selects Expected when dispatched for Arch at runtime.
+template<class WrappedConfig, target_arch Arch, class Expected>
+void test_arch_selects()
+{
+    SCOPED_TRACE(testing::Message() << "with arch= " << static_cast<unsigned int>(Arch));
+    const bool selected = dispatch_target_arch_config<WrappedConfig>(
+        Arch,
+        [](auto arch_config)
+        { return std::is_same<typename decltype(arch_config)::type, Expected>::value; });
+    ASSERT_TRUE(selected);
+}
+
+// Checks that default_config selects the tuned config DefaultConfig<Arch> for every
+// architecture, and that a custom config is selected for every architecture.
+template<template<target_arch> class WrappedConfig,
+         template<unsigned int>
+         class DefaultConfig,
+         class CustomConfig>
+void test_config_dispatch()
+{
+    using rocprim::detail::extract_type;
+
+    test_arch_selects<WrappedConfig<target_arch::unknown>,
+                      target_arch::unknown,
+                      extract_type<DefaultConfig<static_cast<unsigned int>(target_arch::unknown)>>>();
+    test_arch_selects<WrappedConfig<target_arch::gfx803>,
+                      target_arch::gfx803,
+                      extract_type<DefaultConfig<803>>>();
+    test_arch_selects<WrappedConfig<target_arch::gfx900>,
+                      target_arch::gfx900,
+                      extract_type<DefaultConfig<900>>>();
+    test_arch_selects<WrappedConfig<target_arch::gfx906>,
+                      target_arch::gfx906,
+                      extract_type<DefaultConfig<906>>>();
+    test_arch_selects<WrappedConfig<target_arch::gfx908>,
+                      target_arch::gfx908,
+                      extract_type<DefaultConfig<908>>>();
+    test_arch_selects<WrappedConfig<target_arch::gfx90a>,
+                      target_arch::gfx90a,
+                      extract_type<DefaultConfig<ROCPRIM_ARCH_90a>>>();
+    test_arch_selects<WrappedConfig<target_arch::gfx1030>,
+                      target_arch::gfx1030,
+                      extract_type<DefaultConfig<1030>>>();
+
+    for(const target_arch arch : dispatched_arches)
+    {
+        SCOPED_TRACE(testing::Message() << "with arch= " << static_cast<unsigned int>(arch));
+        const bool selected = dispatch_target_arch_config<WrappedConfig<target_arch::invalid>>(
+            arch,
+            [](auto arch_config)
+            { return std::is_same<typename decltype(arch_config)::type, CustomConfig>::value; });
+        ASSERT_TRUE(selected);
+    }
+}
+
+// The first template argument of the wrappers below is only used to switch between the
+// default config (any valid architecture) and a custom config (target_arch::invalid).
+template<target_arch Arch, class Custom>
+using default_or_custom = typename std::
+    conditional<Arch == target_arch::invalid, Custom, rocprim::default_config>::type;
+
+using custom_scan = rocprim::scan_config<64,
+                                         3,
+                                         true,
+                                         rocprim::block_load_method::block_load_direct,
+                                         rocprim::block_store_method::block_store_direct,
+                                         rocprim::block_scan_algorithm::reduce_then_scan>;
+template<target_arch Arch>
+using wrapped_scan = rocprim::detail::wrapped_scan_config<default_or_custom<Arch, custom_scan>, int>;
+template<unsigned int Arch>
+using default_scan = rocprim::detail::default_scan_config<Arch, int>;
+
+using custom_scan_by_key = custom_scan;
+template<target_arch Arch>
+using wrapped_scan_by_key = rocprim::detail::
+    wrapped_scan_by_key_config<default_or_custom<Arch, custom_scan_by_key>, int, double>;
+template<unsigned int Arch>
+using default_scan_by_key = rocprim::detail::default_scan_by_key_config<Arch, int, double>;
+
+using custom_select = rocprim::select_config<64,
+                                             3,
+                                             rocprim::block_load_method::block_load_direct,
+                                             rocprim::block_load_method::block_load_direct,
+                                             rocprim::block_load_method::block_load_direct,
+                                             rocprim::block_scan_algorithm::reduce_then_scan>;
+template<target_arch Arch>
+using wrapped_select = rocprim::detail::
+    wrapped_select_config<default_or_custom<Arch, custom_select>, short, rocprim::empty_type>;
+template<unsigned int Arch>
+using default_select = rocprim::detail::default_select_config<Arch, short, rocprim::empty_type>;
+
+using custom_histogram = rocprim::histogram_config<rocprim::kernel_config<64, 3>>;
+template<target_arch Arch>
+using wrapped_histogram = rocprim::detail::
+    wrapped_histogram_config<default_or_custom<Arch, custom_histogram>, unsigned char, 4, 3>;
+template<unsigned int Arch>
+using default_histogram = rocprim::detail::default_histogram_config<Arch, unsigned char, 4, 3>;
+
+using custom_merge = rocprim::merge_config<64, 3>;
+template<target_arch Arch>
+using wrapped_merge = rocprim::detail::
+    wrapped_merge_config<default_or_custom<Arch, custom_merge>, float, rocprim::empty_type>;
+template<unsigned int Arch>
+using default_merge = rocprim::detail::default_merge_config<Arch, float, rocprim::empty_type>;
+
+using custom_merge_sort = rocprim::merge_sort_config<64>;
+template<target_arch Arch>
+using wrapped_merge_sort = rocprim::detail::
+    wrapped_merge_sort_config<default_or_custom<Arch, custom_merge_sort>, double, int>;
+template<unsigned int Arch>
+using default_merge_sort = rocprim::detail::default_merge_sort_config<Arch, double, int>;
+
+using custom_radix_sort = rocprim::radix_sort_config<4,
+                                                     3,
+                                                     rocprim::kernel_config<64, 2>,
+                                                     rocprim::kernel_config<64, 3>,
+                                                     rocprim::kernel_config<64, 4>>;
+template<target_arch Arch>
+using wrapped_radix_sort = rocprim::detail::
+    wrapped_radix_sort_config<default_or_custom<Arch, custom_radix_sort>, int, rocprim::empty_type>;
+template<unsigned int Arch>
+using default_radix_sort
+    = rocprim::detail::default_radix_sort_config<Arch, int, rocprim::empty_type>;
+
+using custom_segmented_radix_sort
+    = rocprim::segmented_radix_sort_config<4, 3, rocprim::kernel_config<64, 3>>;
+template<target_arch Arch>
+using wrapped_segmented_radix_sort = rocprim::detail::wrapped_segmented_radix_sort_config<
+    default_or_custom<Arch, custom_segmented_radix_sort>,
+    long long,
+    int>;
+template<unsigned int Arch>
+using default_segmented_radix_sort
+    = rocprim::detail::default_segmented_radix_sort_config<Arch, long long, int>;
+
+using custom_transform = rocprim::transform_config<64, 3>;
+template<target_arch Arch>
+using wrapped_transform
+    = rocprim::detail::wrapped_transform_config<default_or_custom<Arch, custom_transform>, int>;
+template<unsigned int Arch>
+using default_transform = rocprim::detail::default_transform_config<Arch, int>;
+
+using custom_adjacent_difference = rocprim::adjacent_difference_config<64, 3>;
+template<target_arch Arch>
+using wrapped_adjacent_difference = rocprim::detail::
+    wrapped_adjacent_difference_config<default_or_custom<Arch, custom_adjacent_difference>, int>;
+template<unsigned int Arch>
+using default_adjacent_difference = rocprim::detail::default_adjacent_difference_config<Arch, int>;
+
+using custom_topk = rocprim::topk_config<8, 64, 3>;
+template<target_arch Arch>
+using wrapped_topk = rocprim::detail::
+    wrapped_topk_config<default_or_custom<Arch, custom_topk>, float, rocprim::empty_type>;
+template<unsigned int Arch>
+using default_topk = rocprim::detail::default_topk_config<Arch, float, rocprim::empty_type>;
+
+using custom_batch_memcpy = rocprim::batch_memcpy_config<64, 16, 32, 1024>;
+template<target_arch Arch>
+using wrapped_batch_memcpy = rocprim::detail::wrapped_batch_memcpy_config<
+    default_or_custom<Arch, custom_batch_memcpy>>;
+template<unsigned int Arch>
+using default_batch_memcpy = rocprim::detail::default_batch_memcpy_config<Arch>;
+
+using custom_reduce_by_key = rocprim::reduce_by_key_config_v2<64, 3>;
+template<target_arch Arch>
+using wrapped_reduce_by_key = rocprim::detail::reduce_by_key::
+    wrapped_config<default_or_custom<Arch, custom_reduce_by_key>, int, double>;
+template<unsigned int Arch>
+using default_reduce_by_key = rocprim::detail::reduce_by_key::default_config<Arch, int, double>;
+
+} // namespace
+
+TEST(RocprimConfigDispatchTests, DeviceConfigMatchesHost)
+{
+    const int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    const hipStream_t stream = 0;
+    using config             = wrapped_scan_by_key<target_arch::gfx908>;
+
+    const unsigned int host_items_per_thread = dispatch_target_arch_config<config>(
+        stream,
+        [](auto arch_config) { return decltype(arch_config)::type::items_per_thread; });
+
+    unsigned int* device_items_per_thread_ptr;
+    HIP_CHECK(hipMalloc(&device_items_per_thread_ptr, sizeof(*device_items_per_thread_ptr)));
+
+    hipLaunchKernelGGL(write_items_per_thread<config>,
+                       dim3(1),
+                       dim3(1),
+                       0,
+                       stream,
+                       device_items_per_thread_ptr);
+    HIP_CHECK(hipGetLastError());
+
+    unsigned int device_items_per_thread;
+    HIP_CHECK(hipMemcpy(&device_items_per_thread,
+                        device_items_per_thread_ptr,
+                        sizeof(device_items_per_thread),
+                        hipMemcpyDeviceToHost));
+    HIP_CHECK(hipFree(device_items_per_thread_ptr));
+
+    ASSERT_EQ(host_items_per_thread, device_items_per_thread);
+}
+
+TEST(RocprimConfigDispatchTests, Scan)
+{
+    test_config_dispatch<wrapped_scan, default_scan, custom_scan>();
+
+    // gfx908 has its own tuned scan config, which must not be replaced by the fallback
+    const unsigned int items_per_thread = dispatch_target_arch_config<wrapped_scan<target_arch::gfx908>>(
+        target_arch::gfx908,
+        [](auto arch_config) { return decltype(arch_config)::type::items_per_thread; });
+    ASSERT_EQ(items_per_thread, rocprim::detail::scan_config_908<int>::type::items_per_thread);
+    ASSERT_NE(items_per_thread, rocprim::detail::scan_config_900<int>::type::items_per_thread);
+}
+
+TEST(RocprimConfigDispatchTests, ScanByKey)
+{
+    test_config_dispatch<wrapped_scan_by_key, default_scan_by_key, custom_scan_by_key>();
+
+    // gfx908 has its own tuned config, the fallback of 900 has fewer items per thread
+    const unsigned int items_per_thread
+        = dispatch_target_arch_config<wrapped_scan_by_key<target_arch::gfx908>>(
+            target_arch::gfx908,
+            [](auto arch_config) { return decltype(arch_config)::type::items_per_thread; });
+    ASSERT_EQ(items_per_thread, 10u);
+    ASSERT_NE(items_per_thread,
+              (rocprim::detail::scan_by_key_config_900<int, double>::type::items_per_thread));
+}
+
+TEST(RocprimConfigDispatchTests, Select)
+{
+    test_config_dispatch<wrapped_select, default_select, custom_select>();
+
+    // gfx900 has its own tuned config, the fallback is the config of 803
+    const unsigned int items_per_thread = dispatch_target_arch_config<wrapped_select<target_arch::gfx900>>(
+        target_arch::gfx900,
+        [](auto arch_config) { return decltype(arch_config)::type::items_per_thread; });
+    ASSERT_EQ(items_per_thread, 15u);
+    ASSERT_NE(items_per_thread, rocprim::detail::select_config_803<short>::type::items_per_thread);
+}
+
+TEST(RocprimConfigDispatchTests, Histogram)
+{
+    test_config_dispatch<wrapped_histogram, default_histogram, custom_histogram>();
+
+    // gfx803 has its own tuned config, which differs from the fallback for single channels
+    using single_channel = rocprim::detail::
+        wrapped_histogram_config<rocprim::default_config, unsigned char, 1, 1>;
+    const unsigned int items_per_thread = dispatch_target_arch_config<single_channel>(
+        target_arch::gfx803,
+        [](auto arch_config)
+        { return decltype(arch_config)::type::histogram::items_per_thread; });
+    ASSERT_EQ(items_per_thread, 10u);
+    ASSERT_NE(items_per_thread,
+              (rocprim::detail::histogram_config_900<unsigned char, 1, 1>::type::histogram::
+                   items_per_thread));
+}
+
+TEST(RocprimConfigDispatchTests, Merge)
+{
+    test_config_dispatch<wrapped_merge, default_merge, custom_merge>();
+
+    // All architectures share the tuning of keys-only merges
+    const unsigned int items_per_thread = dispatch_target_arch_config<wrapped_merge<target_arch::gfx90a>>(
+        target_arch::gfx90a,
+        [](auto arch_config) { return decltype(arch_config)::type::items_per_thread; });
+    ASSERT_EQ(items_per_thread, 10u);
+}
+
+TEST(RocprimConfigDispatchTests, MergeSort)
+{
+    test_config_dispatch<wrapped_merge_sort, default_merge_sort, custom_merge_sort>();
+
+    // gfx1030 has its own tuned config, which sorts tiles with larger blocks than the fallback
+    const unsigned int block_size
+        = dispatch_target_arch_config<wrapped_merge_sort<target_arch::gfx1030>>(
+            target_arch::gfx1030,
+            [](auto arch_config) { return decltype(arch_config)::type::sort_config::block_size; });
+    ASSERT_EQ(block_size, 1024u);
+    ASSERT_NE(block_size,
+              (rocprim::detail::merge_sort_config_900<double, int>::type::sort_config::block_size));
+}
+
+TEST(RocprimConfigDispatchTests, RadixSort)
+{
+    test_config_dispatch<wrapped_radix_sort, default_radix_sort, custom_radix_sort>();
+
+    // gfx90a has its own tuned config, the fallback is the config of 900
+    const unsigned int items_per_thread
+        = dispatch_target_arch_config<wrapped_radix_sort<target_arch::gfx90a>>(
+            target_arch::gfx90a,
+            [](auto arch_config) { return decltype(arch_config)::type::sort::items_per_thread; });
+    ASSERT_EQ(items_per_thread, 8u);
+    ASSERT_NE(items_per_thread,
+              (rocprim::detail::radix_sort_config_900<int, rocprim::empty_type>::sort::
+                   items_per_thread));
+}
+
+TEST(RocprimConfigDispatchTests, SegmentedRadixSort)
+{
+    test_config_dispatch<wrapped_segmented_radix_sort,
+                         default_segmented_radix_sort,
+                         custom_segmented_radix_sort>();
+
+    // gfx803 has its own tuned config, the fallback is the config of 900
+    const unsigned int items_per_thread
+        = dispatch_target_arch_config<wrapped_segmented_radix_sort<target_arch::gfx803>>(
+            target_arch::gfx803,
+            [](auto arch_config) { return decltype(arch_config)::type::sort::items_per_thread; });
+    ASSERT_EQ(items_per_thread, 13u);
+    ASSERT_NE(items_per_thread,
+              (rocprim::detail::segmented_radix_sort_config_900<long long, int>::type::sort::
+                   items_per_thread));
+}
+
+TEST(RocprimConfigDispatchTests, Transform)
+{
+    test_config_dispatch<wrapped_transform, default_transform, custom_transform>();
+
+    const unsigned int items_per_thread
+        = dispatch_target_arch_config<wrapped_transform<target_arch::gfx90a>>(
+            target_arch::gfx90a,
+            [](auto arch_config) { return decltype(arch_config)::type::items_per_thread; });
+    ASSERT_EQ(items_per_thread, 16u);
+}
+
+TEST(RocprimConfigDispatchTests, AdjacentDifference)
+{
+    test_config_dispatch<wrapped_adjacent_difference,
+                         default_adjacent_difference,
+                         custom_adjacent_difference>();
+
+    const unsigned int items_per_thread
+        = dispatch_target_arch_config<wrapped_adjacent_difference<target_arch::gfx90a>>(
+            target_arch::gfx90a,
+            [](auto arch_config) { return decltype(arch_config)::type::items_per_thread; });
+    ASSERT_EQ(items_per_thread, 16u);
+}
+
+TEST(RocprimConfigDispatchTests, Topk)
+{
+    test_config_dispatch<wrapped_topk, default_topk, custom_topk>();
+
+    const unsigned int items_per_thread = dispatch_target_arch_config<wrapped_topk<target_arch::gfx90a>>(
+        target_arch::gfx90a,
+        [](auto arch_config) { return decltype(arch_config)::type::items_per_thread; });
+    ASSERT_EQ(items_per_thread, 16u);
+}
+
+TEST(RocprimConfigDispatchTests, BatchMemcpy)
+{
+    test_config_dispatch<wrapped_batch_memcpy, default_batch_memcpy, custom_batch_memcpy>();
+
+    const unsigned int logical_warp_size
+        = dispatch_target_arch_config<wrapped_batch_memcpy<target_arch::gfx90a>>(
+            target_arch::gfx90a,
+            [](auto arch_config) { return decltype(arch_config)::type::logical_warp_size; });
+    ASSERT_EQ(logical_warp_size, 32u);
+}
+
+TEST(RocprimConfigDispatchTests, ReduceByKey)
+{
+    test_config_dispatch<wrapped_reduce_by_key, default_reduce_by_key, custom_reduce_by_key>();
+
+    const unsigned int items_per_thread
+        = dispatch_target_arch_config<wrapped_reduce_by_key<target_arch::gfx90a>>(
+            target_arch::gfx90a,
+            [](auto arch_config) { return decltype(arch_config)::type::items_per_thread; });
+    ASSERT_EQ(items_per_thread, 15u);
+}
+
+TEST(RocprimConfigDispatchTests, Reduce)
+{
+    using rocprim::detail::dispatch_target_arch;
+    using rocprim::detail::reduce_config_params;
+    using config = rocprim::detail::wrapped_reduce_config<rocprim::default_config, double>;
+
+    const reduce_config_params params_1030 = dispatch_target_arch<config>(target_arch::gfx1030);
+    const reduce_config_params params_900  = dispatch_target_arch<config>(target_arch::gfx900);
+    using expected_1030 = rocprim::detail::default_reduce_config<1030, double>;
+    using expected_900  = rocprim::detail::default_reduce_config<900, double>;
+    ASSERT_EQ(params_1030.block_size, expected_1030::block_size);
+    ASSERT_EQ(params_1030.items_per_thread, expected_1030::items_per_thread);
+    ASSERT_EQ(params_900.block_size, expected_900::block_size);
+    ASSERT_EQ(params_900.items_per_thread, expected_900::items_per_thread);
+}
@@ -438,3 +438,162 @@ TYPED_TEST(RocprimDeviceBinarySearch, BinarySearch)
         }
     }
 }
+
+template<class SearchFunction, class Haystack, class Needle, class Output, class CompareFunction>
+void test_sorted_search(SearchFunction search_function,
+                        const std::vector<Haystack>& haystack,
+                        const std::vector<Needle>& needles,
+                        const std::vector<Output>& expected,
+                        CompareFunction compare_op)
+{
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    const size_t haystack_size = haystack.size();
+    const size_t needles_size = needles.size();
+
+    Haystack * d_haystack;
+    Needle * d_needles;
+    Output * d_output;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_haystack, haystack_size * sizeof(Haystack)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_needles, needles_size * sizeof(Needle)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, needles_size * sizeof(Output)));
+    HIP_CHECK(
+        hipMemcpy(
+            d_haystack, haystack.data(),
+            haystack_size * sizeof(Haystack),
+            hipMemcpyHostToDevice
+        )
+    );
+    HIP_CHECK(
+        hipMemcpy(
+            d_needles, needles.data(),
+            needles_size * sizeof(Needle),
+            hipMemcpyHostToDevice
+        )
+    );
+
+    void * d_temporary_storage = nullptr;
+    size_t temporary_storage_bytes;
+    HIP_CHECK(
+        search_function(
+            d_temporary_storage, temporary_storage_bytes,
+            d_haystack, d_needles, d_output,
+            haystack_size, needles_size,
+            compare_op,
+            stream, debug_synchronous
+        )
+    );
+
+    ASSERT_GT(temporary_storage_bytes, 0);
+
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage, temporary_storage_bytes));
+
+    HIP_CHECK(
+        search_function(
+            d_temporary_storage, temporary_storage_bytes,
+            d_haystack, d_needles, d_output,
+            haystack_size, needles_size,
+            compare_op,
+            stream, debug_synchronous
+        )
+    );
+
+    std::vector<Output> output(needles_size);
+    HIP_CHECK(
+        hipMemcpy(
+            output.data(), d_output,
+            needles_size * sizeof(Output),
+            hipMemcpyDeviceToHost
+        )
+    );
+
+    HIP_CHECK(hipFree(d_temporary_storage));
+    HIP_CHECK(hipFree(d_haystack));
+    HIP_CHECK(hipFree(d_needles));
+    HIP_CHECK(hipFree(d_output));
+
+    ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(output, expected));
+}
+
+TYPED_TEST(RocprimDeviceBinarySearch, SortedNeedles)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using haystack_type = typename TestFixture::params::haystack_type;
+    using needle_type = typename TestFixture::params::needle_type;
+    using output_type = typename TestFixture::params::output_type;
+    using compare_op_type = typename TestFixture::params::compare_op_type;
+
+    compare_op_type compare_op;
+
+    for (size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value = seed_index < random_seeds_count  ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        for(size_t size : get_sizes(seed_value))
+        {
+            if (size == 0 && test_common_utils::use_hmm())
+            {
+                // hipMallocManaged() currently doesnt support zero byte allocation
+                continue;
+            }
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            // Test both sparse and dense needles, as the merge of both sequences may put
+            // many needles or many haystack values into the same block
+            for(size_t needles_size : { (size_t)std::sqrt(size), size / 2 + 1, 2 * size })
+            {
+                SCOPED_TRACE(testing::Message() << "with needles_size = " << needles_size);
+
+                const size_t haystack_size = size;
+                const size_t d = haystack_size / 100;
+
+                // Generate data
+                std::vector<haystack_type> haystack = test_utils::get_random_data<haystack_type>(
+                    haystack_size, 0, haystack_size + 2 * d, seed_value
+                );
+                std::sort(haystack.begin(), haystack.end(), compare_op);
+
+                // Use a narrower range for needles for checking out-of-haystack cases
+                std::vector<needle_type> needles = test_utils::get_random_data<needle_type>(
+                    needles_size, d, haystack_size + d, seed_value + 1
+                );
+                std::sort(needles.begin(), needles.end(), compare_op);
+
+                // Calculate expected results on host
+                std::vector<output_type> expected_lower_bound(needles_size);
+                std::vector<output_type> expected_upper_bound(needles_size);
+                std::vector<output_type> expected_binary_search(needles_size);
+                for(size_t i = 0; i < needles_size; i++)
+                {
+                    expected_lower_bound[i] =
+                        std::lower_bound(haystack.begin(), haystack.end(), needles[i], compare_op) -
+                        haystack.begin();
+                    expected_upper_bound[i] =
+                        std::upper_bound(haystack.begin(), haystack.end(), needles[i], compare_op) -
+                        haystack.begin();
+                    expected_binary_search[i] =
+                        std::binary_search(haystack.begin(), haystack.end(), needles[i], compare_op);
+                }
+
+                ASSERT_NO_FATAL_FAILURE(test_sorted_search(
+                    [](auto&&... args) { return rocprim::sorted_lower_bound(args...); },
+                    haystack, needles, expected_lower_bound, compare_op
+                ));
+                ASSERT_NO_FATAL_FAILURE(test_sorted_search(
+                    [](auto&&... args) { return rocprim::sorted_upper_bound(args...); },
+                    haystack, needles, expected_upper_bound, compare_op
+                ));
+                ASSERT_NO_FATAL_FAILURE(test_sorted_search(
+                    [](auto&&... args) { return rocprim::sorted_binary_search(args...); },
+                    haystack, needles, expected_binary_search, compare_op
+                ));
+            }
+        }
+    }
+}
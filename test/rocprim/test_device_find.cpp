@@ -0,0 +1,395 @@
+// MIT License
+//
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "common_test_header.hpp"
+
+// required rocprim headers
+#include <rocprim/device/device_find.hpp>
+
+// required test headers
+#include "test_utils_types.hpp"
+
+#include <algorithm>
+
+template<class Value, class Config = rocprim::default_config>
+struct params
+{
+    using value_type = Value;
+    using config     = Config;
+};
+
+template<class Params>
+class RocprimDeviceFind : public ::testing::Test
+{
+public:
+    using params = Params;
+};
+
+typedef ::testing::Types<params<int>,
+                         params<unsigned int, rocprim::transform_config<64, 2>>,
+                         params<float>,
+                         params<double, rocprim::transform_config<128, 8>>,
+                         params<uint8_t>,
+                         params<unsigned short, rocprim::transform_config<256, 1>>,
+                         params<long long>>
+    Params;
+
+TYPED_TEST_SUITE(RocprimDeviceFind, Params);
+
+template<class T>
+struct equal_to_value
+{
+    T value;
+
+    ROCPRIM_HOST_DEVICE
+    bool operator()(const T& a) const
+    {
+        return a == value;
+    }
+};
+
+std::vector<size_t> get_sizes(int seed_value)
+{
+    std::vector<size_t> sizes = {0, 1, 10, 53, 211, 1024, 2345, 4096, 34567, (1 << 16) - 1220};
+    const std::vector<size_t> random_sizes
+        = test_utils::get_random_data<size_t>(3, 1, 1000000, seed_value);
+    sizes.insert(sizes.end(), random_sizes.begin(), random_sizes.end());
+    return sizes;
+}
+
+// Positions at which the searched items are planted: none, the first item, the last item and
+// a few random ones (only the first of them is expected to be found)
+std::vector<std::vector<size_t>> get_hit_positions(size_t size, int seed_value)
+{
+    std::vector<std::vector<size_t>> hit_positions = {{}};
+    if(size == 0)
+    {
+        return hit_positions;
+    }
+    hit_positions.push_back({0});
+    hit_positions.push_back({size - 1});
+    hit_positions.push_back(test_utils::get_random_data<size_t>(1, 0, size - 1, seed_value));
+    hit_positions.push_back(test_utils::get_random_data<size_t>(4, 0, size - 1, seed_value + 1));
+    return hit_positions;
+}
+
+// Values in [1; 100], so 0 and values over 100 are never present unless planted
+template<class T>
+std::vector<T> get_input(size_t size, int seed_value)
+{
+    return test_utils::get_random_data<T>(size, 1, 100, seed_value);
+}
+
+template<class T>
+void copy_to_device(T** d_ptr, const std::vector<T>& data)
+{
+    HIP_CHECK(
+        test_common_utils::hipMallocHelper(d_ptr, std::max<size_t>(data.size(), 1) * sizeof(T)));
+    HIP_CHECK(hipMemcpy(*d_ptr, data.data(), data.size() * sizeof(T), hipMemcpyHostToDevice));
+}
+
+template<class Function>
+size_t run_find(Function find_function)
+{
+    size_t* d_output;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, sizeof(size_t)));
+
+    size_t temporary_storage_bytes;
+    HIP_CHECK(find_function(nullptr, temporary_storage_bytes, d_output));
+    EXPECT_GT(temporary_storage_bytes, 0);
+
+    void* d_temporary_storage;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage, temporary_storage_bytes));
+
+    HIP_CHECK(find_function(d_temporary_storage, temporary_storage_bytes, d_output));
+    HIP_CHECK(hipGetLastError());
+
+    size_t output;
+    HIP_CHECK(hipMemcpy(&output, d_output, sizeof(size_t), hipMemcpyDeviceToHost));
+
+    HIP_CHECK(hipFree(d_temporary_storage));
+    HIP_CHECK(hipFree(d_output));
+    return output;
+}
+
+TYPED_TEST(RocprimDeviceFind, FindIf)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using value_type = typename TestFixture::params::value_type;
+    using config     = typename TestFixture::params::config;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        for(size_t size : get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            for(const auto& hits : get_hit_positions(size, seed_value))
+            {
+                std::vector<value_type> input = get_input<value_type>(size, seed_value);
+                for(size_t hit : hits)
+                {
+                    input[hit] = value_type(0);
+                }
+                const equal_to_value<value_type> predicate{value_type(0)};
+                const size_t                     expected
+                    = std::find_if(input.begin(), input.end(), predicate) - input.begin();
+                SCOPED_TRACE(testing::Message() << "with expected = " << expected);
+
+                value_type* d_input;
+                copy_to_device(&d_input, input);
+
+                const size_t output = run_find(
+                    [&](void* d_temporary_storage, size_t& temporary_storage_bytes, size_t* d_output)
+                    {
+                        return rocprim::find_if<config>(d_temporary_storage,
+                                                        temporary_storage_bytes,
+                                                        d_input,
+                                                        d_output,
+                                                        size,
+                                                        predicate,
+                                                        stream,
+                                                        debug_synchronous);
+                    });
+                ASSERT_EQ(output, expected);
+
+                HIP_CHECK(hipFree(d_input));
+            }
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceFind, FindFirstOf)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using value_type = typename TestFixture::params::value_type;
+    using config     = typename TestFixture::params::config;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    const std::vector<value_type> keys = {value_type(110), value_type(0), value_type(120)};
+
+    value_type* d_keys;
+    copy_to_device(&d_keys, keys);
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        for(size_t size : get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            for(const auto& hits : get_hit_positions(size, seed_value))
+            {
+                std::vector<value_type> input = get_input<value_type>(size, seed_value);
+                for(size_t i = 0; i < hits.size(); i++)
+                {
+                    input[hits[i]] = keys[i % keys.size()];
+                }
+
+                for(size_t keys_size : {size_t(0), size_t(1), keys.size()})
+                {
+                    SCOPED_TRACE(testing::Message() << "with keys_size = " << keys_size);
+
+                    const size_t expected = std::find_first_of(input.begin(),
+                                                               input.end(),
+                                                               keys.begin(),
+                                                               keys.begin() + keys_size)
+                                            - input.begin();
+                    SCOPED_TRACE(testing::Message() << "with expected = " << expected);
+
+                    value_type* d_input;
+                    copy_to_device(&d_input, input);
+
+                    const size_t output = run_find(
+                        [&](void*   d_temporary_storage,
+                            size_t& temporary_storage_bytes,
+                            size_t* d_output)
+                        {
+                            return rocprim::find_first_of<config>(d_temporary_storage,
+                                                                  temporary_storage_bytes,
+                                                                  d_input,
+                                                                  d_keys,
+                                                                  d_output,
+                                                                  size,
+                                                                  keys_size,
+                                                                  rocprim::equal_to<value_type>(),
+                                                                  stream,
+                                                                  debug_synchronous);
+                        });
+                    ASSERT_EQ(output, expected);
+
+                    HIP_CHECK(hipFree(d_input));
+                }
+            }
+        }
+    }
+
+    HIP_CHECK(hipFree(d_keys));
+}
+
+TYPED_TEST(RocprimDeviceFind, AdjacentFind)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using value_type = typename TestFixture::params::value_type;
+    using config     = typename TestFixture::params::config;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        for(size_t size : get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            for(const auto& hits : get_hit_positions(size, seed_value))
+            {
+                // Alternating values have no equal adjacent items
+                std::vector<value_type> input(size);
+                for(size_t i = 0; i < size; i++)
+                {
+                    input[i] = value_type(i % 2 + 1);
+                }
+                for(size_t hit : hits)
+                {
+                    if(hit + 1 < size)
+                    {
+                        input[hit + 1] = input[hit];
+                    }
+                }
+                const size_t expected
+                    = std::adjacent_find(input.begin(), input.end()) - input.begin();
+                SCOPED_TRACE(testing::Message() << "with expected = " << expected);
+
+                value_type* d_input;
+                copy_to_device(&d_input, input);
+
+                const size_t output = run_find(
+                    [&](void* d_temporary_storage, size_t& temporary_storage_bytes, size_t* d_output)
+                    {
+                        return rocprim::adjacent_find<config>(d_temporary_storage,
+                                                              temporary_storage_bytes,
+                                                              d_input,
+                                                              d_output,
+                                                              size,
+                                                              rocprim::equal_to<value_type>(),
+                                                              stream,
+                                                              debug_synchronous);
+                    });
+                ASSERT_EQ(output, expected);
+
+                HIP_CHECK(hipFree(d_input));
+            }
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceFind, Mismatch)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using value_type = typename TestFixture::params::value_type;
+    using config     = typename TestFixture::params::config;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        for(size_t size : get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            for(const auto& hits : get_hit_positions(size, seed_value))
+            {
+                const std::vector<value_type> input1 = get_input<value_type>(size, seed_value);
+                std::vector<value_type>       input2 = input1;
+                for(size_t hit : hits)
+                {
+                    input2[hit] = value_type(0);
+                }
+                const size_t expected
+                    = std::mismatch(input1.begin(), input1.end(), input2.begin()).first
+                      - input1.begin();
+                SCOPED_TRACE(testing::Message() << "with expected = " << expected);
+
+                value_type* d_input1;
+                value_type* d_input2;
+                copy_to_device(&d_input1, input1);
+                copy_to_device(&d_input2, input2);
+
+                const size_t output = run_find(
+                    [&](void* d_temporary_storage, size_t& temporary_storage_bytes, size_t* d_output)
+                    {
+                        return rocprim::mismatch<config>(d_temporary_storage,
+                                                         temporary_storage_bytes,
+                                                         d_input1,
+                                                         d_input2,
+                                                         d_output,
+                                                         size,
+                                                         rocprim::equal_to<value_type>(),
+                                                         stream,
+                                                         debug_synchronous);
+                    });
+                ASSERT_EQ(output, expected);
+
+                HIP_CHECK(hipFree(d_input1));
+                HIP_CHECK(hipFree(d_input2));
+            }
+        }
+    }
+}
@@ -129,6 +129,7 @@ typedef ::testing::Types<
     params1<int, 128, 0, 256>,
     params1<unsigned int, 12345, 10, 12355, short>,
     params1<unsigned short, 65536, 0, 65536, int>,
+    params1<int, 250000, 0, 1000000, int, unsigned int>,
     params1<unsigned char, 10, 20, 240, unsigned char, unsigned int>,
     params1<unsigned char, 256, 0, 256, short>,
 
@@ -338,6 +339,7 @@ typedef ::testing::Types<
     params2<unsigned char, 5, 10, 10, 20>,
     params2<unsigned int, 10000, 0, 1, 100>,
     params2<unsigned short, 65536, 0, 1, 1, int>,
+    params2<int, 100000, 0, 1, 4>,
     params2<unsigned char, 256, 0, 1, 1, unsigned short>,
 
     params2<float, 456, -100, 1, 123>,
@@ -577,6 +579,7 @@ typedef ::testing::Types<
     params3<int, 3, 3, 128, 0, 256>,
     params3<unsigned int, 1, 1, 12345, 10, 12355, short>,
     params3<unsigned short, 4, 4, 65536, 0, 65536, int>,
+    params3<int, 2, 2, 20000, 0, 20000>,
     params3<unsigned char, 3, 1, 10, 20, 240, unsigned char, unsigned int>,
     params3<unsigned char, 2, 2, 256, 0, 256, short>,
 
@@ -1077,3 +1080,171 @@ TYPED_TEST(RocprimDeviceHistogramMultiRange, MultiRange)
 
     }
 }
+
+template<
+    class SampleType,
+    class WeightType,
+    unsigned int Bins,
+    int LowerLevel,
+    int UpperLevel
+>
+struct params5
+{
+    using sample_type = SampleType;
+    using weight_type = WeightType;
+    static constexpr unsigned int bins = Bins;
+    static constexpr int lower_level = LowerLevel;
+    static constexpr int upper_level = UpperLevel;
+};
+
+template<class Params>
+class RocprimDeviceHistogramWeighted : public ::testing::Test {
+public:
+    using params = Params;
+};
+
+typedef ::testing::Types<
+    params5<int, float, 10, 0, 10>,
+    params5<unsigned short, double, 1000, 0, 10000>,
+    params5<int, float, 3000, -1000, 2000>,
+    params5<int, double, 100000, 0, 100000>,
+    params5<unsigned char, unsigned int, 256, 0, 256>
+> Params5;
+
+TYPED_TEST_SUITE(RocprimDeviceHistogramWeighted, Params5);
+
+TYPED_TEST(RocprimDeviceHistogramWeighted, Weighted)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using sample_type = typename TestFixture::params::sample_type;
+    using weight_type = typename TestFixture::params::weight_type;
+    constexpr unsigned int bins = TestFixture::params::bins;
+    using level_type = int;
+    constexpr level_type lower_level = TestFixture::params::lower_level;
+    constexpr level_type upper_level = TestFixture::params::upper_level;
+    constexpr level_type scale = (upper_level - lower_level) / bins;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    std::vector<level_type> level_values(bins + 1);
+    for(unsigned int i = 0; i <= bins; i++)
+    {
+        level_values[i] = lower_level + i * scale;
+    }
+    level_type * d_levels;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_levels, (bins + 1) * sizeof(level_type)));
+    HIP_CHECK(
+        hipMemcpy(
+            d_levels, level_values.data(),
+            (bins + 1) * sizeof(level_type),
+            hipMemcpyHostToDevice
+        )
+    );
+
+    for(auto dim : get_dims())
+    {
+        // Weighted histograms only support one-dimensional samples
+        if(std::get<0>(dim) != 1)
+        {
+            continue;
+        }
+        const size_t size = std::get<1>(dim);
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        for (size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+        {
+            unsigned int seed_value = seed_index < random_seeds_count  ? rand() : seeds[seed_index - random_seeds_count];
+            SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+            // Small integral weights, so floating point sums are exact in any order
+            std::vector<sample_type> input = get_random_samples<sample_type>(size, lower_level, upper_level, seed_value);
+            const std::vector<int> int_weights = test_utils::get_random_data<int>(size, 0, 7, seed_value);
+            const std::vector<weight_type> weights(int_weights.begin(), int_weights.end());
+
+            sample_type * d_input;
+            weight_type * d_weights;
+            weight_type * d_histogram;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, std::max<size_t>(1, size) * sizeof(sample_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_weights, std::max<size_t>(1, size) * sizeof(weight_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_histogram, bins * sizeof(weight_type)));
+            HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(sample_type), hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemcpy(d_weights, weights.data(), size * sizeof(weight_type), hipMemcpyHostToDevice));
+
+            // Calculate expected results on host
+            std::vector<weight_type> histogram_expected(bins, 0);
+            for(size_t i = 0; i < size; i++)
+            {
+                const level_type s = static_cast<level_type>(input[i]);
+                if(s >= lower_level && s < upper_level)
+                {
+                    histogram_expected[(s - lower_level) / scale] += weights[i];
+                }
+            }
+
+            using config = rocprim::histogram_config<rocprim::kernel_config<128, 5>>;
+
+            for(bool use_range : {false, true})
+            {
+                SCOPED_TRACE(testing::Message() << "with range = " << use_range);
+
+                auto run = [&](void * d_temporary_storage, size_t& temporary_storage_bytes)
+                {
+                    if(use_range)
+                    {
+                        return rocprim::histogram_range<config>(
+                            d_temporary_storage, temporary_storage_bytes,
+                            d_input, d_weights, static_cast<unsigned int>(size),
+                            d_histogram,
+                            bins + 1, d_levels,
+                            stream, debug_synchronous
+                        );
+                    }
+                    return rocprim::histogram_even<config>(
+                        d_temporary_storage, temporary_storage_bytes,
+                        d_input, d_weights, static_cast<unsigned int>(size),
+                        d_histogram,
+                        bins + 1, lower_level, upper_level,
+                        stream, debug_synchronous
+                    );
+                };
+
+                size_t temporary_storage_bytes = 0;
+                HIP_CHECK(run(nullptr, temporary_storage_bytes));
+
+                ASSERT_GT(temporary_storage_bytes, 0U);
+
+                void * d_temporary_storage;
+                HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage, temporary_storage_bytes));
+
+                HIP_CHECK(run(d_temporary_storage, temporary_storage_bytes));
+
+                std::vector<weight_type> histogram(bins);
+                HIP_CHECK(
+                    hipMemcpy(
+                        histogram.data(), d_histogram,
+                        bins * sizeof(weight_type),
+                        hipMemcpyDeviceToHost
+                    )
+                );
+
+                HIP_CHECK(hipFree(d_temporary_storage));
+
+                for(size_t i = 0; i < bins; i++)
+                {
+                    ASSERT_EQ(histogram[i], histogram_expected[i]);
+                }
+            }
+
+            HIP_CHECK(hipFree(d_input));
+            HIP_CHECK(hipFree(d_weights));
+            HIP_CHECK(hipFree(d_histogram));
+        }
+    }
+
+    HIP_CHECK(hipFree(d_levels));
+}
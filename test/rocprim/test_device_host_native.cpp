@@ -0,0 +1,437 @@
+// MIT License
+//
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Host-native implementations of the device algorithms are used with the HIP-CPU runtime.
+// They split inputs into tiles, so the sizes cover empty inputs, single items, partial tiles
+// and several tiles, and the results are compared with the algorithms of the standard library.
+
+#include "common_test_header.hpp"
+
+// required rocprim headers
+#include <rocprim/device/device_histogram.hpp>
+#include <rocprim/device/device_merge_sort.hpp>
+#include <rocprim/device/device_radix_sort.hpp>
+#include <rocprim/device/device_reduce.hpp>
+#include <rocprim/device/device_scan.hpp>
+#include <rocprim/device/device_select.hpp>
+
+// required test headers
+#include "test_utils_types.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+static_assert(ROCPRIM_DETAIL_USE_HOST_NATIVE, "This test is only built with the HIP-CPU runtime");
+
+namespace
+{
+
+const std::vector<size_t> host_native_sizes = {0, 1, 100, 16384, 16385, 100000};
+
+template<class T>
+T* device_copy(const std::vector<T>& host)
+{
+    T* device;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&device, std::max<size_t>(1, host.size()) * sizeof(T)));
+    if(!host.empty())
+    {
+        HIP_CHECK(hipMemcpy(device, host.data(), host.size() * sizeof(T), hipMemcpyHostToDevice));
+    }
+    return device;
+}
+
+template<class T>
+std::vector<T> host_copy(const T* device, const size_t size)
+{
+    std::vector<T> host(size);
+    if(size != 0)
+    {
+        HIP_CHECK(hipMemcpy(host.data(), device, size * sizeof(T), hipMemcpyDeviceToHost));
+    }
+    return host;
+}
+
+// Queries the temporary storage size of the algorithm, allocates it and runs the algorithm
+template<class Algorithm>
+void run_with_temporary_storage(Algorithm algorithm)
+{
+    size_t temporary_storage_bytes = 0;
+    HIP_CHECK(algorithm(nullptr, temporary_storage_bytes));
+    ASSERT_GT(temporary_storage_bytes, 0);
+
+    void* d_temporary_storage;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage, temporary_storage_bytes));
+    HIP_CHECK(algorithm(d_temporary_storage, temporary_storage_bytes));
+    HIP_CHECK(hipDeviceSynchronize());
+    HIP_CHECK(hipFree(d_temporary_storage));
+}
+
+// Affine function x -> a * x + b, composition is associative but not commutative
+struct affine
+{
+    unsigned int a;
+    unsigned int b;
+
+    bool operator==(const affine& other) const
+    {
+        return a == other.a && b == other.b;
+    }
+};
+
+// Applies f then g
+struct compose_affine
+{
+    ROCPRIM_HOST_DEVICE
+    affine operator()(const affine& f, const affine& g) const
+    {
+        return affine{g.a * f.a, g.a * f.b + g.b};
+    }
+};
+
+std::vector<affine> get_random_affines(const size_t size, const unsigned int seed_value)
+{
+    const std::vector<unsigned int> a = test_utils::get_random_data<unsigned int>(size, 0, 1000, seed_value);
+    const std::vector<unsigned int> b = test_utils::get_random_data<unsigned int>(size, 0, 1000, seed_value + 1);
+    std::vector<affine> affines(size);
+    for(size_t i = 0; i < size; i++)
+    {
+        affines[i] = affine{a[i], b[i]};
+    }
+    return affines;
+}
+
+} // namespace
+
+TEST(RocprimDeviceHostNativeTests, Reduce)
+{
+    for(size_t size : host_native_sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        const std::vector<int> input = test_utils::get_random_data<int>(size, -1000, 1000, 0);
+        int*                   d_input  = device_copy(input);
+        int*                   d_output = device_copy(std::vector<int>(1));
+
+        run_with_temporary_storage(
+            [&](void* temporary_storage, size_t& storage_size)
+            {
+                return rocprim::reduce(temporary_storage,
+                                       storage_size,
+                                       d_input,
+                                       d_output,
+                                       17,
+                                       size,
+                                       rocprim::plus<int>());
+            });
+        ASSERT_EQ(host_copy(d_output, 1)[0], std::accumulate(input.begin(), input.end(), 17));
+
+        if(size != 0)
+        {
+            run_with_temporary_storage(
+                [&](void* temporary_storage, size_t& storage_size)
+                {
+                    return rocprim::reduce(temporary_storage,
+                                           storage_size,
+                                           d_input,
+                                           d_output,
+                                           size,
+                                           rocprim::maximum<int>());
+                });
+            ASSERT_EQ(host_copy(d_output, 1)[0], *std::max_element(input.begin(), input.end()));
+        }
+
+        HIP_CHECK(hipFree(d_input));
+        HIP_CHECK(hipFree(d_output));
+    }
+}
+
+TEST(RocprimDeviceHostNativeTests, Scan)
+{
+    for(size_t size : host_native_sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        const std::vector<affine> input    = get_random_affines(size, 1);
+        affine*                   d_input  = device_copy(input);
+        affine*                   d_output = device_copy(std::vector<affine>(size));
+
+        std::vector<affine> expected(size);
+        std::partial_sum(input.begin(), input.end(), expected.begin(), compose_affine());
+        run_with_temporary_storage(
+            [&](void* temporary_storage, size_t& storage_size)
+            {
+                return rocprim::inclusive_scan(temporary_storage,
+                                               storage_size,
+                                               d_input,
+                                               d_output,
+                                               size,
+                                               compose_affine());
+            });
+        ASSERT_EQ(host_copy(d_output, size), expected);
+
+        const affine initial_value{3, 5};
+        affine       prefix = initial_value;
+        for(size_t i = 0; i < size; i++)
+        {
+            expected[i] = prefix;
+            prefix      = compose_affine()(prefix, input[i]);
+        }
+        // In-place
+        run_with_temporary_storage(
+            [&](void* temporary_storage, size_t& storage_size)
+            {
+                return rocprim::exclusive_scan(temporary_storage,
+                                               storage_size,
+                                               d_input,
+                                               d_input,
+                                               initial_value,
+                                               size,
+                                               compose_affine());
+            });
+        ASSERT_EQ(host_copy(d_input, size), expected);
+
+        HIP_CHECK(hipFree(d_input));
+        HIP_CHECK(hipFree(d_output));
+    }
+}
+
+TEST(RocprimDeviceHostNativeTests, Select)
+{
+    for(size_t size : host_native_sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        const std::vector<int>           input = test_utils::get_random_data<int>(size, 0, 100, 2);
+        const std::vector<unsigned char> flags
+            = test_utils::get_random_data<unsigned char>(size, 0, 1, 3);
+        int*           d_input          = device_copy(input);
+        unsigned char* d_flags          = device_copy(flags);
+        int*           d_output         = device_copy(std::vector<int>(size));
+        size_t*        d_selected_count = device_copy(std::vector<size_t>(1));
+
+        std::vector<int> expected;
+        for(size_t i = 0; i < size; i++)
+        {
+            if(flags[i])
+            {
+                expected.push_back(input[i]);
+            }
+        }
+        run_with_temporary_storage(
+            [&](void* temporary_storage, size_t& storage_size)
+            {
+                return rocprim::select(temporary_storage,
+                                       storage_size,
+                                       d_input,
+                                       d_flags,
+                                       d_output,
+                                       d_selected_count,
+                                       size);
+            });
+        ASSERT_EQ(host_copy(d_selected_count, 1)[0], expected.size());
+        ASSERT_EQ(host_copy(d_output, expected.size()), expected);
+
+        const auto is_even = [](const int value) { return value % 2 == 0; };
+        expected.clear();
+        std::copy_if(input.begin(), input.end(), std::back_inserter(expected), is_even);
+        run_with_temporary_storage(
+            [&](void* temporary_storage, size_t& storage_size)
+            {
+                return rocprim::select(temporary_storage,
+                                       storage_size,
+                                       d_input,
+                                       d_output,
+                                       d_selected_count,
+                                       size,
+                                       is_even);
+            });
+        ASSERT_EQ(host_copy(d_selected_count, 1)[0], expected.size());
+        ASSERT_EQ(host_copy(d_output, expected.size()), expected);
+
+        HIP_CHECK(hipFree(d_input));
+        HIP_CHECK(hipFree(d_flags));
+        HIP_CHECK(hipFree(d_output));
+        HIP_CHECK(hipFree(d_selected_count));
+    }
+}
+
+TEST(RocprimDeviceHostNativeTests, HistogramEven)
+{
+    constexpr unsigned int bins = 100;
+
+    for(size_t size : host_native_sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Samples outside of [0, 1000) are not counted, every bin is 10 wide
+        const std::vector<int> input = test_utils::get_random_data<int>(size, -50, 1050, 4);
+        int*                   d_input     = device_copy(input);
+        unsigned int*          d_histogram = device_copy(std::vector<unsigned int>(bins));
+
+        std::vector<unsigned int> expected(bins, 0);
+        for(const int sample : input)
+        {
+            if(sample >= 0 && sample < 1000)
+            {
+                expected[sample / 10]++;
+            }
+        }
+        run_with_temporary_storage(
+            [&](void* temporary_storage, size_t& storage_size)
+            {
+                return rocprim::histogram_even(temporary_storage,
+                                               storage_size,
+                                               d_input,
+                                               static_cast<unsigned int>(size),
+                                               d_histogram,
+                                               bins + 1,
+                                               0,
+                                               1000);
+            });
+        ASSERT_EQ(host_copy(d_histogram, bins), expected);
+
+        HIP_CHECK(hipFree(d_input));
+        HIP_CHECK(hipFree(d_histogram));
+    }
+}
+
+TEST(RocprimDeviceHostNativeTests, RadixSortPairs)
+{
+    for(size_t size : host_native_sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        for(bool descending : {false, true})
+        {
+            SCOPED_TRACE(testing::Message() << "with descending = " << descending);
+
+            // Only bits [4, 20) are sorted, so the order of equal keys is checked too
+            constexpr unsigned int begin_bit = 4;
+            constexpr unsigned int end_bit   = 20;
+            const std::vector<unsigned int> keys
+                = test_utils::get_random_data<unsigned int>(size, 0, 1u << 24, 5);
+            std::vector<unsigned int> values(size);
+            std::iota(values.begin(), values.end(), 0u);
+            unsigned int* d_keys_input    = device_copy(keys);
+            unsigned int* d_keys_output   = device_copy(std::vector<unsigned int>(size));
+            unsigned int* d_values_input  = device_copy(values);
+            unsigned int* d_values_output = device_copy(std::vector<unsigned int>(size));
+
+            const auto sorted_bits = [](const unsigned int key)
+            { return (key >> begin_bit) & ((1u << (end_bit - begin_bit)) - 1); };
+            std::vector<unsigned int> expected_values(values);
+            std::stable_sort(expected_values.begin(),
+                             expected_values.end(),
+                             [&](const unsigned int lhs, const unsigned int rhs)
+                             {
+                                 return descending
+                                            ? sorted_bits(keys[rhs]) < sorted_bits(keys[lhs])
+                                            : sorted_bits(keys[lhs]) < sorted_bits(keys[rhs]);
+                             });
+            std::vector<unsigned int> expected_keys(size);
+            for(size_t i = 0; i < size; i++)
+            {
+                expected_keys[i] = keys[expected_values[i]];
+            }
+
+            run_with_temporary_storage(
+                [&](void* temporary_storage, size_t& storage_size)
+                {
+                    return descending ? rocprim::radix_sort_pairs_desc(temporary_storage,
+                                                                       storage_size,
+                                                                       d_keys_input,
+                                                                       d_keys_output,
+                                                                       d_values_input,
+                                                                       d_values_output,
+                                                                       size,
+                                                                       begin_bit,
+                                                                       end_bit)
+                                      : rocprim::radix_sort_pairs(temporary_storage,
+                                                                  storage_size,
+                                                                  d_keys_input,
+                                                                  d_keys_output,
+                                                                  d_values_input,
+                                                                  d_values_output,
+                                                                  size,
+                                                                  begin_bit,
+                                                                  end_bit);
+                });
+            ASSERT_EQ(host_copy(d_keys_output, size), expected_keys);
+            ASSERT_EQ(host_copy(d_values_output, size), expected_values);
+
+            HIP_CHECK(hipFree(d_keys_input));
+            HIP_CHECK(hipFree(d_keys_output));
+            HIP_CHECK(hipFree(d_values_input));
+            HIP_CHECK(hipFree(d_values_output));
+        }
+    }
+}
+
+TEST(RocprimDeviceHostNativeTests, MergeSortPairs)
+{
+    for(size_t size : host_native_sizes)
+    {
+        SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+        // Keys are compared by their last decimal digit, so the order of equal keys is checked too
+        const auto compare = [](const int lhs, const int rhs) { return lhs % 10 < rhs % 10; };
+        const std::vector<int> keys = test_utils::get_random_data<int>(size, 0, 1000, 6);
+        std::vector<unsigned int> values(size);
+        std::iota(values.begin(), values.end(), 0u);
+        int*          d_keys_input    = device_copy(keys);
+        int*          d_keys_output   = device_copy(std::vector<int>(size));
+        unsigned int* d_values_input  = device_copy(values);
+        unsigned int* d_values_output = device_copy(std::vector<unsigned int>(size));
+
+        std::vector<unsigned int> expected_values(values);
+        std::stable_sort(expected_values.begin(),
+                         expected_values.end(),
+                         [&](const unsigned int lhs, const unsigned int rhs)
+                         { return compare(keys[lhs], keys[rhs]); });
+        std::vector<int> expected_keys(size);
+        for(size_t i = 0; i < size; i++)
+        {
+            expected_keys[i] = keys[expected_values[i]];
+        }
+
+        run_with_temporary_storage(
+            [&](void* temporary_storage, size_t& storage_size)
+            {
+                return rocprim::merge_sort(temporary_storage,
+                                           storage_size,
+                                           d_keys_input,
+                                           d_keys_output,
+                                           d_values_input,
+                                           d_values_output,
+                                           size,
+                                           compare);
+            });
+        ASSERT_EQ(host_copy(d_keys_output, size), expected_keys);
+        ASSERT_EQ(host_copy(d_values_output, size), expected_values);
+
+        HIP_CHECK(hipFree(d_keys_input));
+        HIP_CHECK(hipFree(d_keys_output));
+        HIP_CHECK(hipFree(d_values_input));
+        HIP_CHECK(hipFree(d_values_output));
+    }
+}
@@ -0,0 +1,360 @@
+// MIT License
+//
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "common_test_header.hpp"
+
+// required rocprim headers
+#include <rocprim/device/device_memcpy.hpp>
+
+// required test headers
+#include "test_utils_types.hpp"
+
+template<class Value,
+         class Size,
+         class Config = rocprim::default_config>
+struct params
+{
+    using value_type = Value;
+    using size_type  = Size;
+    using config     = Config;
+};
+
+template<class Params>
+class RocprimDeviceBatchMemcpy : public ::testing::Test
+{
+public:
+    using params = Params;
+};
+
+typedef ::testing::Types<params<unsigned char, size_t>,
+                         params<int, unsigned int>,
+                         params<double, size_t, rocprim::batch_memcpy_config<128, 16, 32, 1024, 1>>,
+                         params<short, int, rocprim::batch_memcpy_config<64, 64, 8, 256, 2>>,
+                         params<test_utils::custom_test_type<int>, size_t>,
+                         params<uint8_t,
+                                unsigned int,
+                                rocprim::batch_memcpy_config<256, 1, 0, 64, 8>>>
+    Params;
+
+TYPED_TEST_SUITE(RocprimDeviceBatchMemcpy, Params);
+
+// Buffers of a mix of small, medium and large sizes (in elements) and their offsets in a single
+// allocation. The offsets are not aligned, so some buffers can be copied with vector words and
+// some can not.
+template<class Size>
+void generate_buffers(const unsigned int   num_copies,
+                      const unsigned int   seed_value,
+                      std::vector<Size>&   sizes,
+                      std::vector<size_t>& source_offsets,
+                      std::vector<size_t>& destination_offsets,
+                      size_t&              total_size)
+{
+    std::default_random_engine              gen(seed_value);
+    std::uniform_int_distribution<int>      class_dis(0, 99);
+    std::uniform_int_distribution<unsigned> small_dis(0, 64);
+    std::uniform_int_distribution<unsigned> medium_dis(65, 4096);
+    std::uniform_int_distribution<unsigned> large_dis(4097, 150000);
+    std::uniform_int_distribution<unsigned> gap_dis(0, 17);
+
+    sizes.resize(num_copies);
+    source_offsets.resize(num_copies);
+    destination_offsets.resize(num_copies);
+
+    size_t source_offset      = 0;
+    size_t destination_offset = 0;
+    for(unsigned int i = 0; i < num_copies; i++)
+    {
+        const int buffer_class = class_dis(gen);
+        const unsigned int size = buffer_class < 70   ? small_dis(gen)
+                                  : buffer_class < 97 ? medium_dis(gen)
+                                                      : large_dis(gen);
+        sizes[i] = static_cast<Size>(size);
+
+        source_offset += gap_dis(gen);
+        destination_offset += gap_dis(gen);
+        source_offsets[i]      = source_offset;
+        destination_offsets[i] = destination_offset;
+        source_offset += size;
+        destination_offset += size;
+    }
+    total_size = std::max(source_offset, destination_offset);
+}
+
+TYPED_TEST(RocprimDeviceBatchMemcpy, BatchMemcpy)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using size_type = typename TestFixture::params::size_type;
+    using config    = typename TestFixture::params::config;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        for(unsigned int num_copies : {0u, 1u, 10u, 255u, 1000u, 4321u})
+        {
+            SCOPED_TRACE(testing::Message() << "with num_copies = " << num_copies);
+
+            std::vector<size_type> sizes;
+            std::vector<size_t>    source_offsets;
+            std::vector<size_t>    destination_offsets;
+            size_t                 total_size;
+            generate_buffers(num_copies,
+                             seed_value,
+                             sizes,
+                             source_offsets,
+                             destination_offsets,
+                             total_size);
+
+            std::vector<unsigned char> input = test_utils::get_random_data<unsigned char>(
+                total_size, 0, 255, seed_value);
+            std::vector<unsigned char> output(total_size, 0);
+
+            unsigned char* d_input;
+            unsigned char* d_output;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, total_size + 1));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, total_size + 1));
+            HIP_CHECK(hipMemcpy(d_input, input.data(), total_size, hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemset(d_output, 0, total_size + 1));
+
+            std::vector<void*> sources(num_copies);
+            std::vector<void*> destinations(num_copies);
+            for(unsigned int i = 0; i < num_copies; i++)
+            {
+                sources[i]      = d_input + source_offsets[i];
+                destinations[i] = d_output + destination_offsets[i];
+            }
+
+            void**     d_sources;
+            void**     d_destinations;
+            size_type* d_sizes;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_sources,
+                                                         (num_copies + 1) * sizeof(void*)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_destinations,
+                                                         (num_copies + 1) * sizeof(void*)));
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_sizes, (num_copies + 1) * sizeof(size_type)));
+            HIP_CHECK(hipMemcpy(d_sources,
+                                sources.data(),
+                                num_copies * sizeof(void*),
+                                hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemcpy(d_destinations,
+                                destinations.data(),
+                                num_copies * sizeof(void*),
+                                hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemcpy(d_sizes,
+                                sizes.data(),
+                                num_copies * sizeof(size_type),
+                                hipMemcpyHostToDevice));
+
+            size_t temporary_storage_bytes;
+            HIP_CHECK(rocprim::batch_memcpy<config>(nullptr,
+                                                    temporary_storage_bytes,
+                                                    d_sources,
+                                                    d_destinations,
+                                                    d_sizes,
+                                                    num_copies,
+                                                    stream,
+                                                    debug_synchronous));
+
+            ASSERT_GT(temporary_storage_bytes, 0);
+
+            void* d_temporary_storage;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage,
+                                                         temporary_storage_bytes));
+
+            HIP_CHECK(rocprim::batch_memcpy<config>(d_temporary_storage,
+                                                    temporary_storage_bytes,
+                                                    d_sources,
+                                                    d_destinations,
+                                                    d_sizes,
+                                                    num_copies,
+                                                    stream,
+                                                    debug_synchronous));
+            HIP_CHECK(hipGetLastError());
+            HIP_CHECK(hipDeviceSynchronize());
+
+            HIP_CHECK(hipMemcpy(output.data(), d_output, total_size, hipMemcpyDeviceToHost));
+
+            // Bytes outside of the buffers must not be written
+            std::vector<unsigned char> expected(total_size, 0);
+            for(unsigned int i = 0; i < num_copies; i++)
+            {
+                std::copy_n(input.begin() + source_offsets[i],
+                            static_cast<size_t>(sizes[i]),
+                            expected.begin() + destination_offsets[i]);
+            }
+            ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(output, expected));
+
+            HIP_CHECK(hipFree(d_temporary_storage));
+            HIP_CHECK(hipFree(d_input));
+            HIP_CHECK(hipFree(d_output));
+            HIP_CHECK(hipFree(d_sources));
+            HIP_CHECK(hipFree(d_destinations));
+            HIP_CHECK(hipFree(d_sizes));
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceBatchMemcpy, BatchCopy)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using value_type = typename TestFixture::params::value_type;
+    using size_type  = typename TestFixture::params::size_type;
+    using config     = typename TestFixture::params::config;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        for(unsigned int num_copies : {0u, 1u, 10u, 255u, 1000u, 4321u})
+        {
+            SCOPED_TRACE(testing::Message() << "with num_copies = " << num_copies);
+
+            // Sizes are in elements here
+            std::vector<size_type> sizes;
+            std::vector<size_t>    source_offsets;
+            std::vector<size_t>    destination_offsets;
+            size_t                 total_size;
+            generate_buffers(num_copies,
+                             seed_value,
+                             sizes,
+                             source_offsets,
+                             destination_offsets,
+                             total_size);
+
+            std::vector<value_type> input
+                = test_utils::get_random_data<value_type>(total_size, 0, 100, seed_value);
+            std::vector<value_type> output(total_size, value_type(0));
+
+            value_type* d_input;
+            value_type* d_output;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_input,
+                                                         (total_size + 1) * sizeof(value_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_output,
+                                                         (total_size + 1) * sizeof(value_type)));
+            HIP_CHECK(hipMemcpy(d_input,
+                                input.data(),
+                                total_size * sizeof(value_type),
+                                hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemcpy(d_output,
+                                output.data(),
+                                total_size * sizeof(value_type),
+                                hipMemcpyHostToDevice));
+
+            std::vector<value_type*> sources(num_copies);
+            std::vector<value_type*> destinations(num_copies);
+            for(unsigned int i = 0; i < num_copies; i++)
+            {
+                sources[i]      = d_input + source_offsets[i];
+                destinations[i] = d_output + destination_offsets[i];
+            }
+
+            value_type** d_sources;
+            value_type** d_destinations;
+            size_type*   d_sizes;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_sources,
+                                                         (num_copies + 1) * sizeof(value_type*)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_destinations,
+                                                         (num_copies + 1) * sizeof(value_type*)));
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_sizes, (num_copies + 1) * sizeof(size_type)));
+            HIP_CHECK(hipMemcpy(d_sources,
+                                sources.data(),
+                                num_copies * sizeof(value_type*),
+                                hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemcpy(d_destinations,
+                                destinations.data(),
+                                num_copies * sizeof(value_type*),
+                                hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemcpy(d_sizes,
+                                sizes.data(),
+                                num_copies * sizeof(size_type),
+                                hipMemcpyHostToDevice));
+
+            size_t temporary_storage_bytes;
+            HIP_CHECK(rocprim::batch_copy<config>(nullptr,
+                                                  temporary_storage_bytes,
+                                                  d_sources,
+                                                  d_destinations,
+                                                  d_sizes,
+                                                  num_copies,
+                                                  stream,
+                                                  debug_synchronous));
+
+            ASSERT_GT(temporary_storage_bytes, 0);
+
+            void* d_temporary_storage;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage,
+                                                         temporary_storage_bytes));
+
+            HIP_CHECK(rocprim::batch_copy<config>(d_temporary_storage,
+                                                  temporary_storage_bytes,
+                                                  d_sources,
+                                                  d_destinations,
+                                                  d_sizes,
+                                                  num_copies,
+                                                  stream,
+                                                  debug_synchronous));
+            HIP_CHECK(hipGetLastError());
+            HIP_CHECK(hipDeviceSynchronize());
+
+            HIP_CHECK(hipMemcpy(output.data(),
+                                d_output,
+                                total_size * sizeof(value_type),
+                                hipMemcpyDeviceToHost));
+
+            std::vector<value_type> expected(total_size, value_type(0));
+            for(unsigned int i = 0; i < num_copies; i++)
+            {
+                std::copy_n(input.begin() + source_offsets[i],
+                            static_cast<size_t>(sizes[i]),
+                            expected.begin() + destination_offsets[i]);
+            }
+            ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(output, expected));
+
+            HIP_CHECK(hipFree(d_temporary_storage));
+            HIP_CHECK(hipFree(d_input));
+            HIP_CHECK(hipFree(d_output));
+            HIP_CHECK(hipFree(d_sources));
+            HIP_CHECK(hipFree(d_destinations));
+            HIP_CHECK(hipFree(d_sizes));
+        }
+    }
+}
@@ -36,7 +36,8 @@ template<
     class InputType,
     class OutputType = InputType,
     class FlagType = unsigned int,
-    bool UseIdentityIterator = false
+    bool UseIdentityIterator = false,
+    unsigned int SizeLimit = ROCPRIM_GRID_SIZE_LIMIT
 >
 struct DevicePartitionParams
 {
@@ -44,6 +45,7 @@ struct DevicePartitionParams
     using output_type = OutputType;
     using flag_type = FlagType;
     static constexpr bool use_identity_iterator = UseIdentityIterator;
+    static constexpr unsigned int size_limit = SizeLimit;
 };
 
 template<class Params>
@@ -55,10 +57,14 @@ public:
     using flag_type = typename Params::flag_type;
     const bool debug_synchronous = false;
     static constexpr bool use_identity_iterator = Params::use_identity_iterator;
+    static constexpr unsigned int size_limit = Params::size_limit;
 };
 
 typedef ::testing::Types<
     DevicePartitionParams<int, int, unsigned char, true>,
+    // Blocks take several tiles when the size limit is smaller than the input
+    DevicePartitionParams<int, int, unsigned char, false, 1000>,
+    DevicePartitionParams<unsigned int, unsigned long, unsigned int, false, 8192>,
     DevicePartitionParams<unsigned int, unsigned long>,
     DevicePartitionParams<unsigned char, float>,
     DevicePartitionParams<int8_t, int8_t>,
@@ -83,6 +89,27 @@ std::vector<size_t> get_sizes(int seed_value)
     return sizes;
 }
 
+template<unsigned int SizeLimit>
+struct size_limit_config
+{
+    using type = rocprim::select_config<128,
+                                        4,
+                                        rocprim::block_load_method::block_load_transpose,
+                                        rocprim::block_load_method::block_load_transpose,
+                                        rocprim::block_load_method::block_load_transpose,
+                                        rocprim::block_scan_algorithm::using_warp_scan,
+                                        SizeLimit>;
+};
+
+template<>
+struct size_limit_config<ROCPRIM_GRID_SIZE_LIMIT>
+{
+    using type = rocprim::default_config;
+};
+
+template<unsigned int SizeLimit>
+using size_limit_config_t = typename size_limit_config<SizeLimit>::type;
+
 TYPED_TEST_SUITE(RocprimDevicePartitionTests, RocprimDevicePartitionTestsParams);
 
 TYPED_TEST(RocprimDevicePartitionTests, Flagged)
@@ -96,6 +123,7 @@ TYPED_TEST(RocprimDevicePartitionTests, Flagged)
     using F = typename TestFixture::flag_type;
     static constexpr bool use_identity_iterator = TestFixture::use_identity_iterator;
     const bool debug_synchronous = TestFixture::debug_synchronous;
+    using Config = size_limit_config_t<TestFixture::size_limit>;
 
     hipStream_t stream = 0; // default stream
 
@@ -164,7 +192,7 @@ TYPED_TEST(RocprimDevicePartitionTests, Flagged)
             size_t temp_storage_size_bytes;
             // Get size of d_temp_storage
             HIP_CHECK(
-                rocprim::partition(
+                rocprim::partition<Config>(
                     nullptr,
                     temp_storage_size_bytes,
                     d_input,
@@ -188,7 +216,7 @@ TYPED_TEST(RocprimDevicePartitionTests, Flagged)
 
             // Run
             HIP_CHECK(
-                rocprim::partition(
+                rocprim::partition<Config>(
                     d_temp_storage,
                     temp_storage_size_bytes,
                     d_input,
@@ -347,6 +375,7 @@ TYPED_TEST(RocprimDevicePartitionTests, Predicate)
     using U = typename TestFixture::output_type;
     static constexpr bool use_identity_iterator = TestFixture::use_identity_iterator;
     const bool debug_synchronous = TestFixture::debug_synchronous;
+    using Config = size_limit_config_t<TestFixture::size_limit>;
 
     hipStream_t stream = 0; // default stream
 
@@ -411,7 +440,7 @@ TYPED_TEST(RocprimDevicePartitionTests, Predicate)
             size_t temp_storage_size_bytes;
             // Get size of d_temp_storage
             HIP_CHECK(
-                rocprim::partition(
+                rocprim::partition<Config>(
                     nullptr,
                     temp_storage_size_bytes,
                     d_input,
@@ -435,7 +464,7 @@ TYPED_TEST(RocprimDevicePartitionTests, Predicate)
 
             // Run
             HIP_CHECK(
-                rocprim::partition(
+                rocprim::partition<Config>(
                     d_temp_storage,
                     temp_storage_size_bytes,
                     d_input,
@@ -511,6 +540,7 @@ TYPED_TEST(RocprimDevicePartitionTests, PredicateThreeWay)
     using U = typename TestFixture::output_type;
     static constexpr bool use_identity_iterator = TestFixture::use_identity_iterator;
     const bool debug_synchronous = TestFixture::debug_synchronous;
+    using Config = size_limit_config_t<TestFixture::size_limit>;
 
     const hipStream_t stream = 0; // default stream
     const std::vector<std::array<T,2>> limit_pairs{
@@ -584,7 +614,7 @@ TYPED_TEST(RocprimDevicePartitionTests, PredicateThreeWay)
                 size_t temp_storage_size_bytes;
                 // Get size of d_temp_storage
                 HIP_CHECK(
-                    rocprim::partition_three_way(
+                    rocprim::partition_three_way<Config>(
                         nullptr,
                         temp_storage_size_bytes,
                         d_input,
@@ -609,7 +639,7 @@ TYPED_TEST(RocprimDevicePartitionTests, PredicateThreeWay)
 
                 // Run
                 HIP_CHECK(
-                    rocprim::partition_three_way(
+                    rocprim::partition_three_way<Config>(
                         d_temp_storage,
                         temp_storage_size_bytes,
                         d_input,
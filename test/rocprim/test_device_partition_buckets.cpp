@@ -0,0 +1,204 @@
+// MIT License
+//
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "common_test_header.hpp"
+
+// required rocprim headers
+#include <rocprim/device/device_partition_buckets.hpp>
+
+// required test headers
+#include "test_utils_types.hpp"
+
+template<class Value, class Config = rocprim::default_config>
+struct params
+{
+    using value_type = Value;
+    using config     = Config;
+};
+
+template<class Params>
+class RocprimDevicePartitionBuckets : public ::testing::Test
+{
+public:
+    using params = Params;
+};
+
+typedef ::testing::Types<params<int>,
+                         params<unsigned int, rocprim::partition_buckets_config<64, 2, 128>>,
+                         params<float>,
+                         params<double, rocprim::partition_buckets_config<128, 8, 1024>>,
+                         params<uint8_t>,
+                         params<unsigned short, rocprim::partition_buckets_config<256, 1, 256>>,
+                         params<long long>>
+    Params;
+
+TYPED_TEST_SUITE(RocprimDevicePartitionBuckets, Params);
+
+template<class T>
+struct mod_bucket_op
+{
+    unsigned int num_buckets;
+
+    ROCPRIM_HOST_DEVICE
+    unsigned int operator()(const T& value) const
+    {
+        return static_cast<unsigned int>(value) % num_buckets;
+    }
+};
+
+std::vector<size_t> get_sizes(int seed_value)
+{
+    std::vector<size_t> sizes = {0, 1, 10, 53, 211, 1024, 2345, 4096, 34567, (1 << 16) - 1220};
+    const std::vector<size_t> random_sizes
+        = test_utils::get_random_data<size_t>(3, 1, 1000000, seed_value);
+    sizes.insert(sizes.end(), random_sizes.begin(), random_sizes.end());
+    return sizes;
+}
+
+TYPED_TEST(RocprimDevicePartitionBuckets, PartitionBuckets)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using value_type  = typename TestFixture::params::value_type;
+    using config      = typename TestFixture::params::config;
+    using offset_type = size_t;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        for(size_t size : get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            std::vector<value_type> input = test_utils::get_random_data<value_type>(
+                size,
+                0,
+                std::is_same<value_type, uint8_t>::value ? 255 : 10000,
+                seed_value);
+
+            value_type*  d_input;
+            value_type*  d_output;
+            offset_type* d_offsets;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, size * sizeof(value_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, size * sizeof(value_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_offsets, 129 * sizeof(offset_type)));
+            HIP_CHECK(
+                hipMemcpy(d_input, input.data(), size * sizeof(value_type), hipMemcpyHostToDevice));
+
+            for(unsigned int num_buckets : {1u, 2u, 3u, 16u, 77u, 128u})
+            {
+                SCOPED_TRACE(testing::Message() << "with num_buckets = " << num_buckets);
+
+                const mod_bucket_op<value_type> bucket_op{num_buckets};
+
+                // Stable partition on host
+                std::vector<value_type>  expected;
+                std::vector<offset_type> expected_offsets;
+                expected.reserve(size);
+                for(unsigned int bucket = 0; bucket < num_buckets; bucket++)
+                {
+                    expected_offsets.push_back(expected.size());
+                    for(const value_type& value : input)
+                    {
+                        if(bucket_op(value) == bucket)
+                        {
+                            expected.push_back(value);
+                        }
+                    }
+                }
+                expected_offsets.push_back(expected.size());
+
+                size_t temporary_storage_bytes;
+                HIP_CHECK(rocprim::partition_buckets<config>(nullptr,
+                                                             temporary_storage_bytes,
+                                                             d_input,
+                                                             d_output,
+                                                             d_offsets,
+                                                             size,
+                                                             num_buckets,
+                                                             bucket_op,
+                                                             stream,
+                                                             debug_synchronous));
+
+                ASSERT_GT(temporary_storage_bytes, 0);
+
+                void* d_temporary_storage;
+                HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage,
+                                                             temporary_storage_bytes));
+
+                HIP_CHECK(rocprim::partition_buckets<config>(d_temporary_storage,
+                                                             temporary_storage_bytes,
+                                                             d_input,
+                                                             d_output,
+                                                             d_offsets,
+                                                             size,
+                                                             num_buckets,
+                                                             bucket_op,
+                                                             stream,
+                                                             debug_synchronous));
+                HIP_CHECK(hipGetLastError());
+
+                std::vector<value_type>  output(size);
+                std::vector<offset_type> offsets(num_buckets + 1);
+                HIP_CHECK(hipMemcpy(output.data(),
+                                    d_output,
+                                    size * sizeof(value_type),
+                                    hipMemcpyDeviceToHost));
+                HIP_CHECK(hipMemcpy(offsets.data(),
+                                    d_offsets,
+                                    (num_buckets + 1) * sizeof(offset_type),
+                                    hipMemcpyDeviceToHost));
+
+                ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(offsets, expected_offsets));
+                ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(output, expected));
+
+                HIP_CHECK(hipFree(d_temporary_storage));
+            }
+
+            size_t temporary_storage_bytes;
+            ASSERT_EQ(rocprim::partition_buckets<config>(nullptr,
+                                                         temporary_storage_bytes,
+                                                         d_input,
+                                                         d_output,
+                                                         d_offsets,
+                                                         size,
+                                                         0,
+                                                         mod_bucket_op<value_type>{1},
+                                                         stream,
+                                                         debug_synchronous),
+                      hipErrorInvalidValue);
+
+            HIP_CHECK(hipFree(d_input));
+            HIP_CHECK(hipFree(d_output));
+            HIP_CHECK(hipFree(d_offsets));
+        }
+    }
+}
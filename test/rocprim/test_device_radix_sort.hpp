@@ -25,6 +25,9 @@
 
 #include "common_test_header.hpp"
 
+#include <cstring>
+#include <numeric>
+
 // required rocprim headers
 #include <rocprim/device/device_radix_sort.hpp>
 
@@ -788,4 +791,479 @@ inline void sort_keys_over_4g()
     HIP_CHECK(hipFree(d_temporary_storage));
 }
 
+struct custom_radix_key
+{
+    int           a;
+    float         b;
+    unsigned char c;
+};
+
+struct custom_radix_key_decomposer
+{
+    __host__ __device__
+    rocprim::tuple<int&, float&, unsigned char&> operator()(custom_radix_key& key) const
+    {
+        return rocprim::tuple<int&, float&, unsigned char&>{key.a, key.b, key.c};
+    }
+};
+
+// Bits of the concatenated encoded fields of custom_radix_key: [a:32][b:32][c:8]
+inline unsigned __int128 custom_radix_key_bits(const custom_radix_key& key)
+{
+    unsigned int a_bits;
+    unsigned int b_bits;
+    std::memcpy(&a_bits, &key.a, sizeof(a_bits));
+    std::memcpy(&b_bits, &key.b, sizeof(b_bits));
+    a_bits ^= 0x80000000u;
+    b_bits = (b_bits & 0x80000000u) ? ~b_bits : (b_bits ^ 0x80000000u);
+    return (static_cast<unsigned __int128>(a_bits) << 40)
+           | (static_cast<unsigned __int128>(b_bits) << 8) | key.c;
+}
+
+inline std::vector<custom_radix_key> get_custom_radix_keys(size_t size, unsigned int seed_value)
+{
+    // Narrow ranges so fields of many keys are equal and less significant fields matter
+    const std::vector<int> a = test_utils::get_random_data<int>(size, -4, 4, seed_value);
+    const std::vector<float> b
+        = test_utils::get_random_data<float>(size, -100.0f, 100.0f, seed_value + 1);
+    const std::vector<unsigned char> c
+        = test_utils::get_random_data<unsigned char>(size, 0, 255, seed_value + 2);
+    std::vector<custom_radix_key> keys(size);
+    for(size_t i = 0; i < size; i++)
+    {
+        // Only the fields are compared, the padding is zeroed to compare results bitwise
+        std::memset(&keys[i], 0, sizeof(custom_radix_key));
+        keys[i].a = a[i];
+        keys[i].b = b[i] == 0.0f ? 0.0f : b[i];
+        keys[i].c = c[i];
+    }
+    return keys;
+}
+
+inline void sort_keys_decomposer()
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using key_type = custom_radix_key;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    // The full key, a part of the key crossing field boundaries
+    const std::vector<std::pair<unsigned int, unsigned int>> bit_ranges = { { 0, 72 }, { 5, 50 } };
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        for(unsigned int size : get_sizes(seed_value))
+        {
+            if(size > (1 << 20) || size == 0)
+                continue;
+
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            for(bool descending : { false, true })
+            {
+                for(const auto& bit_range : bit_ranges)
+                {
+                    const unsigned int start_bit = bit_range.first;
+                    const unsigned int end_bit   = bit_range.second;
+                    SCOPED_TRACE(testing::Message() << "with descending = " << descending
+                                                    << ", bits = [" << start_bit << ", "
+                                                    << end_bit << ")");
+
+                    const std::vector<key_type> keys_input
+                        = get_custom_radix_keys(size, seed_value);
+
+                    key_type* d_keys_input;
+                    key_type* d_keys_output;
+                    HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_input,
+                                                                 size * sizeof(key_type)));
+                    HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_output,
+                                                                 size * sizeof(key_type)));
+                    HIP_CHECK(hipMemcpy(d_keys_input,
+                                        keys_input.data(),
+                                        size * sizeof(key_type),
+                                        hipMemcpyHostToDevice));
+
+                    // Calculate expected results on host
+                    const unsigned __int128 mask
+                        = ((static_cast<unsigned __int128>(1) << (end_bit - start_bit)) - 1)
+                          << start_bit;
+                    std::vector<key_type> expected(keys_input);
+                    std::stable_sort(expected.begin(),
+                                     expected.end(),
+                                     [&](const key_type& lhs, const key_type& rhs)
+                                     {
+                                         const unsigned __int128 l
+                                             = custom_radix_key_bits(lhs) & mask;
+                                         const unsigned __int128 r
+                                             = custom_radix_key_bits(rhs) & mask;
+                                         return descending ? r < l : l < r;
+                                     });
+
+                    size_t temporary_storage_bytes;
+                    HIP_CHECK(rocprim::radix_sort_keys(nullptr,
+                                                       temporary_storage_bytes,
+                                                       d_keys_input,
+                                                       d_keys_output,
+                                                       size,
+                                                       custom_radix_key_decomposer(),
+                                                       start_bit,
+                                                       end_bit));
+
+                    ASSERT_GT(temporary_storage_bytes, 0);
+
+                    void* d_temporary_storage;
+                    HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage,
+                                                                 temporary_storage_bytes));
+
+                    if(descending)
+                    {
+                        HIP_CHECK(rocprim::radix_sort_keys_desc(d_temporary_storage,
+                                                                temporary_storage_bytes,
+                                                                d_keys_input,
+                                                                d_keys_output,
+                                                                size,
+                                                                custom_radix_key_decomposer(),
+                                                                start_bit,
+                                                                end_bit,
+                                                                stream,
+                                                                debug_synchronous));
+                    }
+                    else
+                    {
+                        HIP_CHECK(rocprim::radix_sort_keys(d_temporary_storage,
+                                                           temporary_storage_bytes,
+                                                           d_keys_input,
+                                                           d_keys_output,
+                                                           size,
+                                                           custom_radix_key_decomposer(),
+                                                           start_bit,
+                                                           end_bit,
+                                                           stream,
+                                                           debug_synchronous));
+                    }
+
+                    std::vector<key_type> keys_output(size);
+                    HIP_CHECK(hipMemcpy(keys_output.data(),
+                                        d_keys_output,
+                                        size * sizeof(key_type),
+                                        hipMemcpyDeviceToHost));
+
+                    HIP_CHECK(hipFree(d_temporary_storage));
+                    HIP_CHECK(hipFree(d_keys_input));
+                    HIP_CHECK(hipFree(d_keys_output));
+
+                    for(size_t i = 0; i < size; i++)
+                    {
+                        ASSERT_EQ(keys_output[i].a, expected[i].a) << "where index = " << i;
+                        ASSERT_EQ(keys_output[i].b, expected[i].b) << "where index = " << i;
+                        ASSERT_EQ(keys_output[i].c, expected[i].c) << "where index = " << i;
+                    }
+                }
+            }
+        }
+    }
+}
+
+inline void sort_pairs_decomposer()
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using key_type   = custom_radix_key;
+    using value_type = unsigned int;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        for(unsigned int size : get_sizes(seed_value))
+        {
+            if(size > (1 << 20) || size == 0)
+                continue;
+
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            for(bool descending : { false, true })
+            {
+                SCOPED_TRACE(testing::Message() << "with descending = " << descending);
+
+                const std::vector<key_type> keys_input = get_custom_radix_keys(size, seed_value);
+                // Values are indices of keys, so the order of equal keys is checked too
+                std::vector<value_type> values_input(size);
+                std::iota(values_input.begin(), values_input.end(), 0u);
+
+                key_type*   d_keys;
+                value_type* d_values;
+                HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys, size * sizeof(key_type)));
+                HIP_CHECK(
+                    test_common_utils::hipMallocHelper(&d_values, size * sizeof(value_type)));
+                HIP_CHECK(hipMemcpy(d_keys,
+                                    keys_input.data(),
+                                    size * sizeof(key_type),
+                                    hipMemcpyHostToDevice));
+                HIP_CHECK(hipMemcpy(d_values,
+                                    values_input.data(),
+                                    size * sizeof(value_type),
+                                    hipMemcpyHostToDevice));
+
+                // Calculate expected results on host
+                std::vector<value_type> values_expected(values_input);
+                std::stable_sort(values_expected.begin(),
+                                 values_expected.end(),
+                                 [&](const value_type& lhs, const value_type& rhs)
+                                 {
+                                     const unsigned __int128 l
+                                         = custom_radix_key_bits(keys_input[lhs]);
+                                     const unsigned __int128 r
+                                         = custom_radix_key_bits(keys_input[rhs]);
+                                     return descending ? r < l : l < r;
+                                 });
+
+                // In-place sorting with double buffers
+                key_type*   d_keys_tmp;
+                value_type* d_values_tmp;
+                HIP_CHECK(
+                    test_common_utils::hipMallocHelper(&d_keys_tmp, size * sizeof(key_type)));
+                HIP_CHECK(
+                    test_common_utils::hipMallocHelper(&d_values_tmp, size * sizeof(value_type)));
+                rocprim::double_buffer<key_type>   keys(d_keys, d_keys_tmp);
+                rocprim::double_buffer<value_type> values(d_values, d_values_tmp);
+
+                size_t temporary_storage_bytes;
+                HIP_CHECK(rocprim::radix_sort_pairs(nullptr,
+                                                    temporary_storage_bytes,
+                                                    keys,
+                                                    values,
+                                                    size,
+                                                    custom_radix_key_decomposer()));
+
+                ASSERT_GT(temporary_storage_bytes, 0);
+
+                void* d_temporary_storage;
+                HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage,
+                                                             temporary_storage_bytes));
+
+                if(descending)
+                {
+                    HIP_CHECK(rocprim::radix_sort_pairs_desc(d_temporary_storage,
+                                                             temporary_storage_bytes,
+                                                             keys,
+                                                             values,
+                                                             size,
+                                                             custom_radix_key_decomposer(),
+                                                             0,
+                                                             72,
+                                                             stream,
+                                                             debug_synchronous));
+                }
+                else
+                {
+                    HIP_CHECK(rocprim::radix_sort_pairs(d_temporary_storage,
+                                                        temporary_storage_bytes,
+                                                        keys,
+                                                        values,
+                                                        size,
+                                                        custom_radix_key_decomposer(),
+                                                        0,
+                                                        72,
+                                                        stream,
+                                                        debug_synchronous));
+                }
+
+                std::vector<key_type>   keys_output(size);
+                std::vector<value_type> values_output(size);
+                HIP_CHECK(hipMemcpy(keys_output.data(),
+                                    keys.current(),
+                                    size * sizeof(key_type),
+                                    hipMemcpyDeviceToHost));
+                HIP_CHECK(hipMemcpy(values_output.data(),
+                                    values.current(),
+                                    size * sizeof(value_type),
+                                    hipMemcpyDeviceToHost));
+
+                HIP_CHECK(hipFree(d_temporary_storage));
+                HIP_CHECK(hipFree(d_keys));
+                HIP_CHECK(hipFree(d_keys_tmp));
+                HIP_CHECK(hipFree(d_values));
+                HIP_CHECK(hipFree(d_values_tmp));
+
+                ASSERT_EQ(values_output, values_expected);
+                for(size_t i = 0; i < size; i++)
+                {
+                    const key_type& expected = keys_input[values_expected[i]];
+                    ASSERT_EQ(keys_output[i].a, expected.a) << "where index = " << i;
+                    ASSERT_EQ(keys_output[i].b, expected.b) << "where index = " << i;
+                    ASSERT_EQ(keys_output[i].c, expected.c) << "where index = " << i;
+                }
+            }
+        }
+    }
+}
+
+// A small size limit of the sort kernel splits the input into many portions sorted by
+// consecutive launches, every pass must carry the digit offsets from portion to portion
+inline void sort_pairs_onesweep_portions()
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using key_type   = unsigned int;
+    using value_type = unsigned int;
+    // 4 passes of 5 bits and 3 passes of 4 bits, 4096 items per portion,
+    // merge sort is used only for inputs of a single block
+    using config = rocprim::radix_sort_config<5,
+                                              4,
+                                              rocprim::kernel_config<256, 2>,
+                                              rocprim::kernel_config<256, 4, 4096>,
+                                              rocprim::kernel_config<256, 10>,
+                                              rocprim::kernel_config<256, 1>,
+                                              1>;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        for(size_t size : {size_t(5000), size_t(65659), size_t(300000)})
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            for(bool descending : {false, true})
+            {
+                SCOPED_TRACE(testing::Message() << "with descending = " << descending);
+
+                const std::vector<key_type> keys_input
+                    = test_utils::get_random_data<key_type>(size,
+                                                            std::numeric_limits<key_type>::min(),
+                                                            std::numeric_limits<key_type>::max(),
+                                                            seed_value);
+                // Values are indices of keys, so the order of equal keys is checked too
+                std::vector<value_type> values_input(size);
+                std::iota(values_input.begin(), values_input.end(), 0u);
+
+                key_type*   d_keys_input;
+                key_type*   d_keys_output;
+                value_type* d_values_input;
+                value_type* d_values_output;
+                HIP_CHECK(
+                    test_common_utils::hipMallocHelper(&d_keys_input, size * sizeof(key_type)));
+                HIP_CHECK(
+                    test_common_utils::hipMallocHelper(&d_keys_output, size * sizeof(key_type)));
+                HIP_CHECK(test_common_utils::hipMallocHelper(&d_values_input,
+                                                             size * sizeof(value_type)));
+                HIP_CHECK(test_common_utils::hipMallocHelper(&d_values_output,
+                                                             size * sizeof(value_type)));
+                HIP_CHECK(hipMemcpy(d_keys_input,
+                                    keys_input.data(),
+                                    size * sizeof(key_type),
+                                    hipMemcpyHostToDevice));
+                HIP_CHECK(hipMemcpy(d_values_input,
+                                    values_input.data(),
+                                    size * sizeof(value_type),
+                                    hipMemcpyHostToDevice));
+
+                // Calculate expected results on host
+                std::vector<value_type> values_expected(values_input);
+                std::stable_sort(values_expected.begin(),
+                                 values_expected.end(),
+                                 [&](const value_type& lhs, const value_type& rhs)
+                                 {
+                                     return descending ? keys_input[rhs] < keys_input[lhs]
+                                                       : keys_input[lhs] < keys_input[rhs];
+                                 });
+
+                size_t temporary_storage_bytes;
+                HIP_CHECK(rocprim::radix_sort_pairs<config>(nullptr,
+                                                            temporary_storage_bytes,
+                                                            d_keys_input,
+                                                            d_keys_output,
+                                                            d_values_input,
+                                                            d_values_output,
+                                                            size));
+
+                ASSERT_GT(temporary_storage_bytes, 0);
+
+                void* d_temporary_storage;
+                HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage,
+                                                             temporary_storage_bytes));
+
+                if(descending)
+                {
+                    HIP_CHECK(rocprim::radix_sort_pairs_desc<config>(d_temporary_storage,
+                                                                     temporary_storage_bytes,
+                                                                     d_keys_input,
+                                                                     d_keys_output,
+                                                                     d_values_input,
+                                                                     d_values_output,
+                                                                     size,
+                                                                     0,
+                                                                     32,
+                                                                     stream,
+                                                                     debug_synchronous));
+                }
+                else
+                {
+                    HIP_CHECK(rocprim::radix_sort_pairs<config>(d_temporary_storage,
+                                                                temporary_storage_bytes,
+                                                                d_keys_input,
+                                                                d_keys_output,
+                                                                d_values_input,
+                                                                d_values_output,
+                                                                size,
+                                                                0,
+                                                                32,
+                                                                stream,
+                                                                debug_synchronous));
+                }
+
+                std::vector<key_type>   keys_output(size);
+                std::vector<value_type> values_output(size);
+                HIP_CHECK(hipMemcpy(keys_output.data(),
+                                    d_keys_output,
+                                    size * sizeof(key_type),
+                                    hipMemcpyDeviceToHost));
+                HIP_CHECK(hipMemcpy(values_output.data(),
+                                    d_values_output,
+                                    size * sizeof(value_type),
+                                    hipMemcpyDeviceToHost));
+
+                HIP_CHECK(hipFree(d_temporary_storage));
+                HIP_CHECK(hipFree(d_keys_input));
+                HIP_CHECK(hipFree(d_keys_output));
+                HIP_CHECK(hipFree(d_values_input));
+                HIP_CHECK(hipFree(d_values_output));
+
+                ASSERT_EQ(values_output, values_expected);
+                for(size_t i = 0; i < size; i++)
+                {
+                    ASSERT_EQ(keys_output[i], keys_input[values_expected[i]])
+                        << "where index = " << i;
+                }
+            }
+        }
+    }
+}
+
 #endif // TEST_DEVICE_RADIX_SORT_HPP_
@@ -42,7 +42,8 @@ template<
     class Aggregate = Value,
     class KeyCompareFunction = ::rocprim::equal_to<Key>,
     // Tests output iterator with void value_type (OutputIterator concept)
-    bool UseIdentityIterator = false
+    bool UseIdentityIterator = false,
+    unsigned int SizeLimit = ROCPRIM_GRID_SIZE_LIMIT
 >
 struct params
 {
@@ -54,8 +55,30 @@ struct params
     using aggregate_type = Aggregate;
     using key_compare_op = KeyCompareFunction;
     static constexpr bool use_identity_iterator = UseIdentityIterator;
+    static constexpr unsigned int size_limit = SizeLimit;
 };
 
+template<unsigned int SizeLimit>
+struct size_limit_config
+{
+    using type = rocprim::reduce_by_key_config_v2<128,
+                                                  4,
+                                                  rocprim::block_load_method::block_load_transpose,
+                                                  rocprim::block_load_method::block_load_transpose,
+                                                  rocprim::block_scan_algorithm::using_warp_scan,
+                                                  1,
+                                                  SizeLimit>;
+};
+
+template<>
+struct size_limit_config<ROCPRIM_GRID_SIZE_LIMIT>
+{
+    using type = rocprim::default_config;
+};
+
+template<unsigned int SizeLimit>
+using size_limit_config_t = typename size_limit_config<SizeLimit>::type;
+
 template<class Params>
 class RocprimDeviceReduceByKey : public ::testing::Test {
 public:
@@ -107,7 +130,10 @@ typedef ::testing::Types<
     params<long long, short, rocprim::plus<long long>, 1000, 10000, long long>,
     params<unsigned int, double, rocprim::minimum<double>, 1000, 50000>,
     params<unsigned long long, unsigned long long, rocprim::plus<unsigned long long>, 100000, 100000>,
-    params<test_utils::custom_test_array_type<double, 8>, unsigned long, rocprim::plus<>, 69, 420>
+    params<test_utils::custom_test_array_type<double, 8>, unsigned long, rocprim::plus<>, 69, 420>,
+    // Blocks take several tiles when the size limit is smaller than the input
+    params<int, int, rocprim::plus<int>, 1, 30, int, rocprim::equal_to<int>, false, 1000>,
+    params<unsigned int, double, rocprim::minimum<double>, 100, 2000, double, rocprim::equal_to<unsigned int>, false, 8192>
 > Params;
 // clang-format on
 
@@ -154,6 +180,7 @@ TYPED_TEST(RocprimDeviceReduceByKey, ReduceByKey)
 
     constexpr bool use_identity_iterator = TestFixture::params::use_identity_iterator;
     const bool debug_synchronous = false;
+    using Config = size_limit_config_t<TestFixture::params::size_limit>;
 
     reduce_op_type reduce_op;
     key_compare_op_type key_compare_op;
@@ -268,7 +295,7 @@ TYPED_TEST(RocprimDeviceReduceByKey, ReduceByKey)
             size_t temporary_storage_bytes;
 
             HIP_CHECK(
-                rocprim::reduce_by_key(
+                rocprim::reduce_by_key<Config>(
                     nullptr, temporary_storage_bytes,
                     d_keys_input, d_values_input, size,
                     test_utils::wrap_in_identity_iterator<use_identity_iterator>(d_unique_output),
@@ -285,7 +312,7 @@ TYPED_TEST(RocprimDeviceReduceByKey, ReduceByKey)
             HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage, temporary_storage_bytes));
 
             HIP_CHECK(
-                rocprim::reduce_by_key(
+                rocprim::reduce_by_key<Config>(
                     d_temporary_storage, temporary_storage_bytes,
                     d_keys_input, d_values_input, size,
                     d_unique_output, d_aggregates_output,
@@ -58,6 +58,7 @@ typedef ::testing::Types<
     params<int, int, 1, 1, true>,
     params<double, int, 3, 5>,
     params<float, int, 1, 10>,
+    params<int, unsigned int, 1, 3>,
     params<unsigned long long, size_t, 1, 30>,
     params<custom_int2, unsigned int, 20, 100>,
     params<float, unsigned long long, 100, 400>,
@@ -83,6 +83,8 @@ typedef ::testing::Types<
     DeviceScanParams<float, float, rocprim::plus<float>, false, 1024 >,
     DeviceScanParams<int, int, rocprim::plus<int>, false, 524288 >,
     DeviceScanParams<int, int, rocprim::plus<int>, false, 1048576 >,
+    // A few blocks take all tiles of the input
+    DeviceScanParams<unsigned int, unsigned int, rocprim::plus<unsigned int>, false, 12288 >,
     DeviceScanParams<int8_t, int8_t, rocprim::maximum<int8_t>>,
     DeviceScanParams<uint8_t, uint8_t, rocprim::maximum<uint8_t>>,
 #ifndef __HIP__
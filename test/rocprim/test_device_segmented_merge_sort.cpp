@@ -0,0 +1,364 @@
+// MIT License
+//
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "common_test_header.hpp"
+
+// required rocprim headers
+#include <rocprim/device/device_segmented_merge_sort.hpp>
+
+// required test headers
+#include "test_utils_types.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+// Compares only the keys divided by 8, so many keys are equivalent and stability is observable
+template<class T>
+struct coarse_less
+{
+    ROCPRIM_HOST_DEVICE
+    bool operator()(const T& a, const T& b) const
+    {
+        return static_cast<long long>(a) / 8 < static_cast<long long>(b) / 8;
+    }
+};
+
+template<class T>
+T make_value(size_t i)
+{
+    return static_cast<T>(i);
+}
+
+template<>
+rocprim::empty_type make_value<rocprim::empty_type>(size_t)
+{
+    return rocprim::empty_type();
+}
+
+template<class Key,
+         class Value,
+         class CompareFunction,
+         unsigned int MinSegmentLength,
+         unsigned int MaxSegmentLength,
+         class Config = rocprim::default_config>
+struct params
+{
+    using key_type                                   = Key;
+    using value_type                                 = Value;
+    using compare_function                           = CompareFunction;
+    static constexpr unsigned int min_segment_length = MinSegmentLength;
+    static constexpr unsigned int max_segment_length = MaxSegmentLength;
+    using config                                     = Config;
+};
+
+template<class Params>
+class RocprimDeviceSegmentedMergeSort : public ::testing::Test
+{
+public:
+    using params = Params;
+};
+
+using custom_int2 = test_utils::custom_test_type<int>;
+
+// Small segments of at most 64 items, medium of at most 256 items
+using small_tiles_config = rocprim::segmented_merge_sort_config<16, 4, 128, 64, 4>;
+// Every segment is sorted by the kernels of large segments
+using unpartitioned_config
+    = rocprim::segmented_merge_sort_config<16, 4, 128, 64, 4, std::numeric_limits<unsigned int>::max()>;
+// Every launch partitions the segments
+using partitioned_config = rocprim::segmented_merge_sort_config<8, 2, 64, 128, 2, 0>;
+
+typedef ::testing::Types<
+    params<int, rocprim::empty_type, rocprim::less<int>, 0, 1000>,
+    params<unsigned int, rocprim::empty_type, rocprim::greater<unsigned int>, 0, 100>,
+    params<double, rocprim::empty_type, rocprim::less<double>, 1000, 5000>,
+    params<int8_t, rocprim::empty_type, rocprim::greater<int8_t>, 0, 300>,
+    params<custom_int2, rocprim::empty_type, rocprim::less<custom_int2>, 0, 2000>,
+    params<int, int, coarse_less<int>, 0, 1000>,
+    params<float, double, rocprim::greater<float>, 10, 3000>,
+    params<unsigned short, custom_int2, coarse_less<unsigned short>, 0, 20000>,
+    params<int, unsigned int, coarse_less<int>, 0, 2000, small_tiles_config>,
+    params<int, rocprim::empty_type, rocprim::less<int>, 0, 3000, unpartitioned_config>,
+    params<int, unsigned int, coarse_less<int>, 0, 3000, unpartitioned_config>,
+    params<long long, unsigned int, coarse_less<long long>, 0, 1000, partitioned_config>>
+    Params;
+
+TYPED_TEST_SUITE(RocprimDeviceSegmentedMergeSort, Params);
+
+std::vector<size_t> get_sizes(int seed_value)
+{
+    std::vector<size_t> sizes = {1024, 2048, 4096, 1792, 0, 1, 10, 53, 211, 500, 2345, 11001, 34567, 100000};
+    const std::vector<size_t> random_sizes
+        = test_utils::get_random_data<size_t>(3, 1, 300000, seed_value);
+    sizes.insert(sizes.end(), random_sizes.begin(), random_sizes.end());
+    return sizes;
+}
+
+// With OneLargeSegment, a segment of half of the input, much larger than a tile, is placed among
+// the segments of random lengths
+template<class Params, bool UseGraphs = false, bool OneLargeSegment = false>
+void sort_pairs()
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using key_type         = typename Params::key_type;
+    using value_type       = typename Params::value_type;
+    using compare_function = typename Params::compare_function;
+    using config           = typename Params::config;
+    using offset_type      = unsigned int;
+
+    static constexpr bool with_values = !std::is_same<value_type, rocprim::empty_type>::value;
+
+    const bool       debug_synchronous = false;
+    hipStream_t      stream            = 0;
+    if(UseGraphs)
+    {
+        // Default stream does not support hipGraph stream capture, so create one
+        HIP_CHECK(hipStreamCreateWithFlags(&stream, hipStreamNonBlocking));
+    }
+    compare_function compare_op;
+
+    std::random_device                        rd;
+    std::default_random_engine                gen(rd());
+    std::uniform_int_distribution<size_t> segment_length_dis(
+        Params::min_segment_length,
+        Params::max_segment_length);
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        for(size_t size : get_sizes(seed_value))
+        {
+            if(size == 0 && test_common_utils::use_hmm())
+            {
+                // hipMallocManaged() currently doesnt support zero byte allocation
+                continue;
+            }
+
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            std::vector<key_type> keys_input
+                = test_utils::get_random_data<key_type>(size, 0, 100, seed_value);
+            // Values are the original positions so stability can be checked
+            std::vector<value_type> values_input(size);
+            for(size_t i = 0; i < size; i++)
+            {
+                values_input[i] = make_value<value_type>(i);
+            }
+
+            std::vector<offset_type> offsets;
+            unsigned int             segments_count = 0;
+            size_t                   offset         = 0;
+            bool                     large_segment  = OneLargeSegment;
+            while(offset < size)
+            {
+                size_t segment_length = segment_length_dis(gen);
+                if(large_segment && offset >= size / 4)
+                {
+                    segment_length = size / 2;
+                    large_segment  = false;
+                }
+                offsets.push_back(offset);
+                segments_count++;
+                offset += segment_length;
+            }
+            offsets.push_back(size);
+
+            // Calculate expected results on host
+            std::vector<size_t> indices(size);
+            std::iota(indices.begin(), indices.end(), 0);
+            for(unsigned int segment = 0; segment < segments_count; segment++)
+            {
+                const size_t begin = offsets[segment];
+                const size_t end   = offsets[segment + 1];
+                std::stable_sort(indices.begin() + begin,
+                                 indices.begin() + end,
+                                 [&](const size_t a, const size_t b)
+                                 { return compare_op(keys_input[a], keys_input[b]); });
+            }
+            std::vector<key_type>   keys_expected(size);
+            std::vector<value_type> values_expected(size);
+            for(size_t i = 0; i < size; i++)
+            {
+                keys_expected[i]   = keys_input[indices[i]];
+                values_expected[i] = values_input[indices[i]];
+            }
+
+            key_type*    d_keys_input;
+            key_type*    d_keys_output;
+            offset_type* d_offsets;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_input, size * sizeof(key_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_output, size * sizeof(key_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_offsets,
+                                                         (segments_count + 1)
+                                                             * sizeof(offset_type)));
+            HIP_CHECK(hipMemcpy(d_keys_input,
+                                keys_input.data(),
+                                size * sizeof(key_type),
+                                hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemcpy(d_offsets,
+                                offsets.data(),
+                                (segments_count + 1) * sizeof(offset_type),
+                                hipMemcpyHostToDevice));
+
+            value_type* d_values_input  = nullptr;
+            value_type* d_values_output = nullptr;
+            if(with_values)
+            {
+                HIP_CHECK(
+                    test_common_utils::hipMallocHelper(&d_values_input, size * sizeof(value_type)));
+                HIP_CHECK(test_common_utils::hipMallocHelper(&d_values_output,
+                                                             size * sizeof(value_type)));
+                HIP_CHECK(hipMemcpy(d_values_input,
+                                    values_input.data(),
+                                    size * sizeof(value_type),
+                                    hipMemcpyHostToDevice));
+            }
+
+            auto sort = [&](void* d_temporary_storage, size_t& temporary_storage_bytes)
+            {
+                if(with_values)
+                {
+                    return rocprim::segmented_merge_sort_pairs<config>(d_temporary_storage,
+                                                                       temporary_storage_bytes,
+                                                                       d_keys_input,
+                                                                       d_keys_output,
+                                                                       d_values_input,
+                                                                       d_values_output,
+                                                                       size,
+                                                                       segments_count,
+                                                                       d_offsets,
+                                                                       d_offsets + 1,
+                                                                       compare_op,
+                                                                       stream,
+                                                                       debug_synchronous);
+                }
+                return rocprim::segmented_merge_sort_keys<config>(d_temporary_storage,
+                                                                  temporary_storage_bytes,
+                                                                  d_keys_input,
+                                                                  d_keys_output,
+                                                                  size,
+                                                                  segments_count,
+                                                                  d_offsets,
+                                                                  d_offsets + 1,
+                                                                  compare_op,
+                                                                  stream,
+                                                                  debug_synchronous);
+            };
+
+            size_t temporary_storage_bytes;
+            HIP_CHECK(sort(nullptr, temporary_storage_bytes));
+            ASSERT_GT(temporary_storage_bytes, 0);
+
+            void* d_temporary_storage;
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_temporary_storage, temporary_storage_bytes));
+
+            hipGraph_t graph;
+            if(UseGraphs)
+            {
+                // The sort must not synchronize with the host, so it can be captured
+                HIP_CHECK(hipStreamBeginCapture(stream, hipStreamCaptureModeGlobal));
+            }
+
+            HIP_CHECK(sort(d_temporary_storage, temporary_storage_bytes));
+
+            if(UseGraphs)
+            {
+                HIP_CHECK(hipStreamEndCapture(stream, &graph));
+                hipGraphExec_t graph_instance;
+                HIP_CHECK(hipGraphInstantiate(&graph_instance, graph, nullptr, nullptr, 0));
+                HIP_CHECK(hipGraphLaunch(graph_instance, stream));
+                HIP_CHECK(hipStreamSynchronize(stream));
+                HIP_CHECK(hipGraphExecDestroy(graph_instance));
+                HIP_CHECK(hipGraphDestroy(graph));
+            }
+
+            HIP_CHECK(hipGetLastError());
+            HIP_CHECK(hipDeviceSynchronize());
+            HIP_CHECK(hipFree(d_temporary_storage));
+
+            std::vector<key_type> keys_output(size);
+            HIP_CHECK(hipMemcpy(keys_output.data(),
+                                d_keys_output,
+                                size * sizeof(key_type),
+                                hipMemcpyDeviceToHost));
+            ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(keys_output, keys_expected));
+
+            if(with_values)
+            {
+                std::vector<value_type> values_output(size);
+                HIP_CHECK(hipMemcpy(values_output.data(),
+                                    d_values_output,
+                                    size * sizeof(value_type),
+                                    hipMemcpyDeviceToHost));
+                ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(values_output, values_expected));
+                HIP_CHECK(hipFree(d_values_input));
+                HIP_CHECK(hipFree(d_values_output));
+            }
+
+            HIP_CHECK(hipFree(d_keys_input));
+            HIP_CHECK(hipFree(d_keys_output));
+            HIP_CHECK(hipFree(d_offsets));
+        }
+    }
+
+    if(UseGraphs)
+    {
+        HIP_CHECK(hipStreamDestroy(stream));
+    }
+}
+
+TYPED_TEST(RocprimDeviceSegmentedMergeSort, SortPairs)
+{
+    sort_pairs<typename TestFixture::params>();
+}
+
+TEST(RocprimDeviceSegmentedMergeSortGraphs, SortPairsWithGraphs)
+{
+    sort_pairs<params<int, unsigned int, coarse_less<int>, 0, 2000, small_tiles_config>, true>();
+    sort_pairs<params<long long, unsigned int, coarse_less<long long>, 0, 1000, partitioned_config>,
+               true>();
+}
+
+TEST(RocprimDeviceSegmentedMergeSortLargeSegment, SortPairs)
+{
+    sort_pairs<params<int, unsigned int, coarse_less<int>, 0, 100, small_tiles_config>,
+               false,
+               true>();
+    sort_pairs<params<int, unsigned int, coarse_less<int>, 0, 100, unpartitioned_config>,
+               false,
+               true>();
+    sort_pairs<params<long long, rocprim::empty_type, rocprim::less<long long>, 0, 1000, partitioned_config>,
+               false,
+               true>();
+    sort_pairs<params<long long, unsigned int, coarse_less<long long>, 0, 1000, partitioned_config>,
+               true,
+               true>();
+}
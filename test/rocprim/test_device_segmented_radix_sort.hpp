@@ -283,7 +283,7 @@ inline void sort_keys()
     }
 }
 
-template<typename TestFixture>
+template<typename TestFixture, bool UseGraphs = false>
 inline void sort_pairs()
 {
     int device_id = test_common_utils::obtain_device_from_ctest();
@@ -300,6 +300,11 @@ inline void sort_pairs()
     using offset_type = unsigned int;
 
     hipStream_t stream = 0;
+    if(UseGraphs)
+    {
+        // Default stream does not support hipGraph stream capture, so create one
+        HIP_CHECK(hipStreamCreateWithFlags(&stream, hipStreamNonBlocking));
+    }
 
     const bool debug_synchronous = false;
 
@@ -435,6 +440,13 @@ inline void sort_pairs()
             HIP_CHECK(
                 test_common_utils::hipMallocHelper(&d_temporary_storage, temporary_storage_bytes));
 
+            hipGraph_t graph;
+            if(UseGraphs)
+            {
+                // The sort must not synchronize with the host, so it can be captured
+                HIP_CHECK(hipStreamBeginCapture(stream, hipStreamCaptureModeGlobal));
+            }
+
             if(descending)
             {
                 HIP_CHECK(rocprim::segmented_radix_sort_pairs_desc<config>(d_temporary_storage,
@@ -470,6 +482,17 @@ inline void sort_pairs()
                                                                       debug_synchronous));
             }
 
+            if(UseGraphs)
+            {
+                HIP_CHECK(hipStreamEndCapture(stream, &graph));
+                hipGraphExec_t graph_instance;
+                HIP_CHECK(hipGraphInstantiate(&graph_instance, graph, nullptr, nullptr, 0));
+                HIP_CHECK(hipGraphLaunch(graph_instance, stream));
+                HIP_CHECK(hipStreamSynchronize(stream));
+                HIP_CHECK(hipGraphExecDestroy(graph_instance));
+                HIP_CHECK(hipGraphDestroy(graph));
+            }
+
             std::vector<key_type> keys_output(size);
             HIP_CHECK(hipMemcpy(keys_output.data(),
                                 d_keys_output,
@@ -493,6 +516,11 @@ inline void sort_pairs()
             ASSERT_NO_FATAL_FAILURE(test_utils::assert_eq(values_output, values_expected));
         }
     }
+
+    if(UseGraphs)
+    {
+        HIP_CHECK(hipStreamDestroy(stream));
+    }
 }
 
 template<typename TestFixture>
@@ -36,7 +36,8 @@ template<
     unsigned int MinSegmentLength = 0,
     unsigned int MaxSegmentLength = 1000,
     // Tests output iterator with void value_type (OutputIterator concept)
-    bool UseIdentityIterator = false
+    bool UseIdentityIterator = false,
+    class Config = rocprim::default_config
 >
 struct params
 {
@@ -47,6 +48,7 @@ struct params
     static constexpr unsigned int min_segment_length = MinSegmentLength;
     static constexpr unsigned int max_segment_length = MaxSegmentLength;
     static constexpr bool use_identity_iterator = UseIdentityIterator;
+    using config = Config;
 };
 
 template<class Params>
@@ -75,6 +77,14 @@ typedef ::testing::Types<
     params<custom_double2, custom_double2, rocprim::maximum<custom_double2>, 50, 2, 10>,
     params<float, float, rocprim::plus<float>, 123, 100, 200>,
     params<unsigned char, long long, rocprim::plus<int>, 10, 3000, 4000>,
+    params<int, int, rocprim::plus<int>, 0, 0, 32>,
+    params<int, long long, rocprim::plus<long long>, 5, 0, 300, false,
+           rocprim::segmented_reduce_config<rocprim::default_config,
+                                            rocprim::WarpReduceConfig<4, 2, 64, 100, 16, 4, 128>>>,
+    params<float, float, rocprim::plus<float>, 0, 1, 40, true,
+           rocprim::segmented_reduce_config<
+               rocprim::reduce_config<128, 4, rocprim::block_reduce_algorithm::using_warp_reduce>,
+               rocprim::DisabledWarpReduceConfig>>,
 #ifndef __HIP__
     // hip-clang does not allow to convert half to float
     params<rocprim::half, float, rocprim::plus<float>, 0, 10, 300>,
@@ -109,6 +119,7 @@ TYPED_TEST(RocprimDeviceSegmentedReduce, Reduce)
     using input_type = typename TestFixture::params::input_type;
     using output_type = typename TestFixture::params::output_type;
     using reduce_op_type = typename TestFixture::params::reduce_op_type;
+    using config = typename TestFixture::params::config;
     // for bfloat16 and half we use double for host-side accumulation
     using reduce_op_type_host = typename std::conditional<std::is_same<reduce_op_type,test_utils::bfloat16_plus>::value ||
                                                          std::is_same<reduce_op_type,test_utils::half_plus>::value,
@@ -203,7 +214,7 @@ TYPED_TEST(RocprimDeviceSegmentedReduce, Reduce)
             size_t temporary_storage_bytes;
 
             HIP_CHECK(
-                rocprim::segmented_reduce(
+                rocprim::segmented_reduce<config>(
                     nullptr, temporary_storage_bytes,
                     d_values_input, d_aggregates_output,
                     segments_count,
@@ -219,7 +230,7 @@ TYPED_TEST(RocprimDeviceSegmentedReduce, Reduce)
             HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage, temporary_storage_bytes));
 
             HIP_CHECK(
-                rocprim::segmented_reduce(
+                rocprim::segmented_reduce<config>(
                     d_temporary_storage, temporary_storage_bytes,
                     d_values_input,
                     test_utils::wrap_in_identity_iterator<use_identity_iterator>(d_aggregates_output),
@@ -250,3 +261,128 @@ TYPED_TEST(RocprimDeviceSegmentedReduce, Reduce)
     }
 
 }
+
+TEST(RocprimDeviceSegmentedReduceGraphs, PartitionedReduceWithGraphs)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    // Small segments have at most 8 items, medium ones at most 64, and the segments are
+    // partitioned from 100 segments on
+    using config = rocprim::segmented_reduce_config<
+        rocprim::default_config,
+        rocprim::WarpReduceConfig<4, 2, 64, 100, 16, 4, 128>>;
+    using offset_type = unsigned int;
+
+    const bool debug_synchronous = false;
+
+    // Default stream does not support hipGraph stream capture, so create one
+    hipStream_t stream;
+    HIP_CHECK(hipStreamCreateWithFlags(&stream, hipStreamNonBlocking));
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        for(unsigned int segments_count : {100u, 2000u})
+        {
+            SCOPED_TRACE(testing::Message() << "with segments_count = " << segments_count);
+
+            const std::vector<offset_type> segment_lengths
+                = test_utils::get_random_data<offset_type>(segments_count, 0, 300, seed_value);
+            std::vector<offset_type> offsets(segments_count + 1, 0);
+            std::partial_sum(segment_lengths.begin(), segment_lengths.end(), offsets.begin() + 1);
+            const size_t size = offsets.back();
+
+            const std::vector<int> values_input
+                = test_utils::get_random_data<int>(size, -100, 100, seed_value);
+            std::vector<int> aggregates_expected(segments_count);
+            for(unsigned int segment = 0; segment < segments_count; segment++)
+            {
+                aggregates_expected[segment] = std::accumulate(values_input.begin() + offsets[segment],
+                                                               values_input.begin() + offsets[segment + 1],
+                                                               10);
+            }
+
+            int* d_values_input;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_values_input,
+                                                         std::max<size_t>(1, size) * sizeof(int)));
+            HIP_CHECK(hipMemcpy(d_values_input,
+                                values_input.data(),
+                                size * sizeof(int),
+                                hipMemcpyHostToDevice));
+
+            offset_type* d_offsets;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_offsets,
+                                                         (segments_count + 1) * sizeof(offset_type)));
+            HIP_CHECK(hipMemcpy(d_offsets,
+                                offsets.data(),
+                                (segments_count + 1) * sizeof(offset_type),
+                                hipMemcpyHostToDevice));
+
+            int* d_aggregates_output;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_aggregates_output,
+                                                         segments_count * sizeof(int)));
+
+            size_t temporary_storage_bytes;
+            HIP_CHECK(rocprim::segmented_reduce<config>(nullptr,
+                                                        temporary_storage_bytes,
+                                                        d_values_input,
+                                                        d_aggregates_output,
+                                                        segments_count,
+                                                        d_offsets,
+                                                        d_offsets + 1,
+                                                        rocprim::plus<int>(),
+                                                        10,
+                                                        stream,
+                                                        debug_synchronous));
+
+            ASSERT_GT(temporary_storage_bytes, 0);
+
+            void* d_temporary_storage;
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_temporary_storage, temporary_storage_bytes));
+
+            // The reduction must not synchronize with the host, so it can be captured
+            hipGraph_t graph;
+            HIP_CHECK(hipStreamBeginCapture(stream, hipStreamCaptureModeGlobal));
+            HIP_CHECK(rocprim::segmented_reduce<config>(d_temporary_storage,
+                                                        temporary_storage_bytes,
+                                                        d_values_input,
+                                                        d_aggregates_output,
+                                                        segments_count,
+                                                        d_offsets,
+                                                        d_offsets + 1,
+                                                        rocprim::plus<int>(),
+                                                        10,
+                                                        stream,
+                                                        debug_synchronous));
+            HIP_CHECK(hipStreamEndCapture(stream, &graph));
+
+            hipGraphExec_t graph_instance;
+            HIP_CHECK(hipGraphInstantiate(&graph_instance, graph, nullptr, nullptr, 0));
+            HIP_CHECK(hipGraphLaunch(graph_instance, stream));
+            HIP_CHECK(hipStreamSynchronize(stream));
+            HIP_CHECK(hipGraphExecDestroy(graph_instance));
+            HIP_CHECK(hipGraphDestroy(graph));
+
+            std::vector<int> aggregates_output(segments_count);
+            HIP_CHECK(hipMemcpy(aggregates_output.data(),
+                                d_aggregates_output,
+                                segments_count * sizeof(int),
+                                hipMemcpyDeviceToHost));
+
+            HIP_CHECK(hipFree(d_temporary_storage));
+            HIP_CHECK(hipFree(d_values_input));
+            HIP_CHECK(hipFree(d_offsets));
+            HIP_CHECK(hipFree(d_aggregates_output));
+
+            ASSERT_EQ(aggregates_output, aggregates_expected);
+        }
+    }
+
+    HIP_CHECK(hipStreamDestroy(stream));
+}
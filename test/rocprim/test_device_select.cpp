@@ -37,7 +37,8 @@ template<
     class InputType,
     class OutputType = InputType,
     class FlagType = unsigned int,
-    bool UseIdentityIterator = false
+    bool UseIdentityIterator = false,
+    unsigned int SizeLimit = ROCPRIM_GRID_SIZE_LIMIT
 >
 struct DeviceSelectParams
 {
@@ -45,6 +46,7 @@ struct DeviceSelectParams
     using output_type = OutputType;
     using flag_type = FlagType;
     static constexpr bool use_identity_iterator = UseIdentityIterator;
+    static constexpr unsigned int size_limit = SizeLimit;
 };
 
 template<class Params>
@@ -56,10 +58,14 @@ public:
     using flag_type = typename Params::flag_type;
     const bool debug_synchronous = false;
     static constexpr bool use_identity_iterator = Params::use_identity_iterator;
+    static constexpr unsigned int size_limit = Params::size_limit;
 };
 
 typedef ::testing::Types<
     DeviceSelectParams<int, long>,
+    // Blocks take several tiles when the size limit is smaller than the input
+    DeviceSelectParams<int, int, unsigned int, false, 1000>,
+    DeviceSelectParams<double, double, int, false, 8192>,
     DeviceSelectParams<int8_t, int8_t>,
     DeviceSelectParams<uint8_t, uint8_t>,
     DeviceSelectParams<rocprim::half, rocprim::half>,
@@ -83,6 +89,27 @@ std::vector<size_t> get_sizes(int seed_value)
     return sizes;
 }
 
+template<unsigned int SizeLimit>
+struct size_limit_config
+{
+    using type = rocprim::select_config<128,
+                                        4,
+                                        rocprim::block_load_method::block_load_transpose,
+                                        rocprim::block_load_method::block_load_transpose,
+                                        rocprim::block_load_method::block_load_transpose,
+                                        rocprim::block_scan_algorithm::using_warp_scan,
+                                        SizeLimit>;
+};
+
+template<>
+struct size_limit_config<ROCPRIM_GRID_SIZE_LIMIT>
+{
+    using type = rocprim::default_config;
+};
+
+template<unsigned int SizeLimit>
+using size_limit_config_t = typename size_limit_config<SizeLimit>::type;
+
 TYPED_TEST_SUITE(RocprimDeviceSelectTests, RocprimDeviceSelectTestsParams);
 
 TYPED_TEST(RocprimDeviceSelectTests, Flagged)
@@ -96,6 +123,7 @@ TYPED_TEST(RocprimDeviceSelectTests, Flagged)
     using F = typename TestFixture::flag_type;
     static constexpr bool use_identity_iterator = TestFixture::use_identity_iterator;
     const bool debug_synchronous = TestFixture::debug_synchronous;
+    using Config = size_limit_config_t<TestFixture::size_limit>;
 
     hipStream_t stream = 0; // default stream
 
@@ -152,7 +180,7 @@ TYPED_TEST(RocprimDeviceSelectTests, Flagged)
             size_t temp_storage_size_bytes;
             // Get size of d_temp_storage
             HIP_CHECK(
-                rocprim::select(
+                rocprim::select<Config>(
                     nullptr,
                     temp_storage_size_bytes,
                     d_input,
@@ -176,7 +204,7 @@ TYPED_TEST(RocprimDeviceSelectTests, Flagged)
 
             // Run
             HIP_CHECK(
-                rocprim::select(
+                rocprim::select<Config>(
                     d_temp_storage,
                     temp_storage_size_bytes,
                     d_input,
@@ -275,6 +303,7 @@ TYPED_TEST(RocprimDeviceSelectTests, SelectOp)
     using U = typename TestFixture::output_type;
     static constexpr bool use_identity_iterator = TestFixture::use_identity_iterator;
     const bool debug_synchronous = TestFixture::debug_synchronous;
+    using Config = size_limit_config_t<TestFixture::size_limit>;
 
     hipStream_t stream = 0; // default stream
 
@@ -321,7 +350,7 @@ TYPED_TEST(RocprimDeviceSelectTests, SelectOp)
             size_t temp_storage_size_bytes;
             // Get size of d_temp_storage
             HIP_CHECK(
-                rocprim::select(
+                rocprim::select<Config>(
                     nullptr,
                     temp_storage_size_bytes,
                     d_input,
@@ -345,7 +374,7 @@ TYPED_TEST(RocprimDeviceSelectTests, SelectOp)
 
             // Run
             HIP_CHECK(
-                rocprim::select(
+                rocprim::select<Config>(
                     d_temp_storage,
                     temp_storage_size_bytes,
                     d_input,
@@ -478,6 +507,7 @@ TYPED_TEST(RocprimDeviceSelectTests, Unique)
     using scan_op_type = rocprim::plus<T>;
     static constexpr bool use_identity_iterator = TestFixture::use_identity_iterator;
     const bool debug_synchronous = TestFixture::debug_synchronous;
+    using Config = size_limit_config_t<TestFixture::size_limit>;
 
     hipStream_t stream = 0; // default stream
 
@@ -536,7 +566,7 @@ TYPED_TEST(RocprimDeviceSelectTests, Unique)
                 size_t temp_storage_size_bytes;
                 // Get size of d_temp_storage
                 HIP_CHECK(
-                    rocprim::unique(
+                    rocprim::unique<Config>(
                         nullptr,
                         temp_storage_size_bytes,
                         d_input,
@@ -560,7 +590,7 @@ TYPED_TEST(RocprimDeviceSelectTests, Unique)
 
                 // Run
                 HIP_CHECK(
-                    rocprim::unique(
+                    rocprim::unique<Config>(
                         d_temp_storage,
                         temp_storage_size_bytes,
                         d_input,
@@ -0,0 +1,382 @@
+// MIT License
+//
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "common_test_header.hpp"
+
+// required rocprim headers
+#include <rocprim/functional.hpp>
+#include <rocprim/device/device_set_operations.hpp>
+
+// required test headers
+#include "test_utils_types.hpp"
+
+template<class Key, class Value, class Config = rocprim::default_config>
+struct params
+{
+    using key_type   = Key;
+    using value_type = Value;
+    using config     = Config;
+};
+
+template<class Params>
+class RocprimDeviceSetOperations : public ::testing::Test
+{
+public:
+    using params = Params;
+};
+
+typedef ::testing::Types<params<int, int>,
+                         params<unsigned int, size_t, rocprim::merge_config<64, 3>>,
+                         params<float, int>,
+                         params<double, unsigned int, rocprim::merge_config<256, 1>>,
+                         params<uint8_t, int>,
+                         params<unsigned short, int>,
+                         params<long long, char, rocprim::merge_config<128, 8>>>
+    Params;
+
+TYPED_TEST_SUITE(RocprimDeviceSetOperations, Params);
+
+// size1, size2
+std::vector<std::tuple<size_t, size_t>> get_sizes(int seed_value)
+{
+    std::vector<std::tuple<size_t, size_t>> sizes = {
+        std::make_tuple(0, 0),
+        std::make_tuple(0, 10),
+        std::make_tuple(10, 0),
+        std::make_tuple(2, 1),
+        std::make_tuple(111, 111),
+        std::make_tuple(128, 1289),
+        std::make_tuple(12, 1000),
+        std::make_tuple(123, 3000),
+        std::make_tuple(34567, 1000),
+        std::make_tuple(1 << 16, 1 << 15),
+    };
+    const std::vector<size_t> random_sizes
+        = test_utils::get_random_data<size_t>(4, 1, 100000, seed_value);
+    sizes.push_back(std::make_tuple(random_sizes[0], random_sizes[1]));
+    sizes.push_back(std::make_tuple(random_sizes[2], random_sizes[3]));
+    return sizes;
+}
+
+struct set_union_tag
+{
+    template<class... Args>
+    static hipError_t device(Args&&... args)
+    {
+        return rocprim::set_union_by_key(std::forward<Args>(args)...);
+    }
+
+    template<class... Args>
+    static hipError_t device_keys(Args&&... args)
+    {
+        return rocprim::set_union(std::forward<Args>(args)...);
+    }
+
+    template<class InputIt1, class InputIt2, class OutputIt, class Compare>
+    static OutputIt host(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+                         OutputIt output, Compare compare)
+    {
+        return std::set_union(first1, last1, first2, last2, output, compare);
+    }
+};
+
+struct set_intersection_tag
+{
+    template<class... Args>
+    static hipError_t device(Args&&... args)
+    {
+        return rocprim::set_intersection_by_key(std::forward<Args>(args)...);
+    }
+
+    template<class... Args>
+    static hipError_t device_keys(Args&&... args)
+    {
+        return rocprim::set_intersection(std::forward<Args>(args)...);
+    }
+
+    template<class InputIt1, class InputIt2, class OutputIt, class Compare>
+    static OutputIt host(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+                         OutputIt output, Compare compare)
+    {
+        return std::set_intersection(first1, last1, first2, last2, output, compare);
+    }
+};
+
+struct set_difference_tag
+{
+    template<class... Args>
+    static hipError_t device(Args&&... args)
+    {
+        return rocprim::set_difference_by_key(std::forward<Args>(args)...);
+    }
+
+    template<class... Args>
+    static hipError_t device_keys(Args&&... args)
+    {
+        return rocprim::set_difference(std::forward<Args>(args)...);
+    }
+
+    template<class InputIt1, class InputIt2, class OutputIt, class Compare>
+    static OutputIt host(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+                         OutputIt output, Compare compare)
+    {
+        return std::set_difference(first1, last1, first2, last2, output, compare);
+    }
+};
+
+struct set_symmetric_difference_tag
+{
+    template<class... Args>
+    static hipError_t device(Args&&... args)
+    {
+        return rocprim::set_symmetric_difference_by_key(std::forward<Args>(args)...);
+    }
+
+    template<class... Args>
+    static hipError_t device_keys(Args&&... args)
+    {
+        return rocprim::set_symmetric_difference(std::forward<Args>(args)...);
+    }
+
+    template<class InputIt1, class InputIt2, class OutputIt, class Compare>
+    static OutputIt host(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+                         OutputIt output, Compare compare)
+    {
+        return std::set_symmetric_difference(first1, last1, first2, last2, output, compare);
+    }
+};
+
+template<class Params, class SetOp>
+void test_set_operation()
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using key_type   = typename Params::key_type;
+    using value_type = typename Params::value_type;
+    using config     = typename Params::config;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        for(auto sizes : get_sizes(seed_value))
+        {
+            const size_t size1 = std::get<0>(sizes);
+            const size_t size2 = std::get<1>(sizes);
+            SCOPED_TRACE(testing::Message() << "with size1 = " << size1);
+            SCOPED_TRACE(testing::Message() << "with size2 = " << size2);
+
+            // Many duplicates in both ranges, and keys which are only in one of them
+            std::vector<key_type> keys1
+                = test_utils::get_random_data<key_type>(size1, 0, 100, seed_value);
+            std::vector<key_type> keys2
+                = test_utils::get_random_data<key_type>(size2, 50, 150, seed_value + 1);
+            std::sort(keys1.begin(), keys1.end());
+            std::sort(keys2.begin(), keys2.end());
+            // Values identify the input items
+            std::vector<value_type> values1(size1);
+            std::vector<value_type> values2(size2);
+            std::iota(values1.begin(), values1.end(), value_type(0));
+            std::iota(values2.begin(), values2.end(), value_type(size1));
+
+            using pair_type = std::pair<key_type, value_type>;
+            std::vector<pair_type> pairs1(size1);
+            std::vector<pair_type> pairs2(size2);
+            for(size_t i = 0; i < size1; i++)
+            {
+                pairs1[i] = pair_type(keys1[i], values1[i]);
+            }
+            for(size_t i = 0; i < size2; i++)
+            {
+                pairs2[i] = pair_type(keys2[i], values2[i]);
+            }
+            std::vector<pair_type> expected(size1 + size2);
+            expected.resize(SetOp::host(pairs1.begin(),
+                                        pairs1.end(),
+                                        pairs2.begin(),
+                                        pairs2.end(),
+                                        expected.begin(),
+                                        [](const pair_type& a, const pair_type& b)
+                                        { return a.first < b.first; })
+                            - expected.begin());
+
+            key_type*   d_keys_input1;
+            key_type*   d_keys_input2;
+            key_type*   d_keys_output;
+            value_type* d_values_input1;
+            value_type* d_values_input2;
+            value_type* d_values_output;
+            size_t*     d_output_count;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_input1, size1 * sizeof(key_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_input2, size2 * sizeof(key_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_output,
+                                                         (size1 + size2) * sizeof(key_type)));
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_values_input1, size1 * sizeof(value_type)));
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_values_input2, size2 * sizeof(value_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_values_output,
+                                                         (size1 + size2) * sizeof(value_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_output_count, sizeof(size_t)));
+            HIP_CHECK(hipMemcpy(d_keys_input1,
+                                keys1.data(),
+                                size1 * sizeof(key_type),
+                                hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemcpy(d_keys_input2,
+                                keys2.data(),
+                                size2 * sizeof(key_type),
+                                hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemcpy(d_values_input1,
+                                values1.data(),
+                                size1 * sizeof(value_type),
+                                hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemcpy(d_values_input2,
+                                values2.data(),
+                                size2 * sizeof(value_type),
+                                hipMemcpyHostToDevice));
+
+            size_t temporary_storage_bytes;
+            HIP_CHECK(SetOp::device(nullptr,
+                                    temporary_storage_bytes,
+                                    d_keys_input1,
+                                    d_keys_input2,
+                                    d_keys_output,
+                                    d_values_input1,
+                                    d_values_input2,
+                                    d_values_output,
+                                    d_output_count,
+                                    size1,
+                                    size2,
+                                    rocprim::less<key_type>(),
+                                    stream,
+                                    debug_synchronous));
+
+            ASSERT_GT(temporary_storage_bytes, 0);
+
+            void* d_temporary_storage;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage,
+                                                         temporary_storage_bytes));
+
+            HIP_CHECK(SetOp::device(d_temporary_storage,
+                                    temporary_storage_bytes,
+                                    d_keys_input1,
+                                    d_keys_input2,
+                                    d_keys_output,
+                                    d_values_input1,
+                                    d_values_input2,
+                                    d_values_output,
+                                    d_output_count,
+                                    size1,
+                                    size2,
+                                    rocprim::less<key_type>(),
+                                    stream,
+                                    debug_synchronous));
+            HIP_CHECK(hipGetLastError());
+
+            size_t output_count;
+            HIP_CHECK(
+                hipMemcpy(&output_count, d_output_count, sizeof(size_t), hipMemcpyDeviceToHost));
+            ASSERT_EQ(output_count, expected.size());
+
+            std::vector<key_type>   keys_output(output_count);
+            std::vector<value_type> values_output(output_count);
+            HIP_CHECK(hipMemcpy(keys_output.data(),
+                                d_keys_output,
+                                output_count * sizeof(key_type),
+                                hipMemcpyDeviceToHost));
+            HIP_CHECK(hipMemcpy(values_output.data(),
+                                d_values_output,
+                                output_count * sizeof(value_type),
+                                hipMemcpyDeviceToHost));
+
+            for(size_t i = 0; i < output_count; i++)
+            {
+                ASSERT_EQ(keys_output[i], expected[i].first) << "where index = " << i;
+                ASSERT_EQ(values_output[i], expected[i].second) << "where index = " << i;
+            }
+
+            // Keys only
+            HIP_CHECK(hipMemset(d_output_count, 0, sizeof(size_t)));
+            HIP_CHECK(SetOp::device_keys(d_temporary_storage,
+                                         temporary_storage_bytes,
+                                         d_keys_input1,
+                                         d_keys_input2,
+                                         d_keys_output,
+                                         d_output_count,
+                                         size1,
+                                         size2,
+                                         rocprim::less<key_type>(),
+                                         stream,
+                                         debug_synchronous));
+            HIP_CHECK(hipGetLastError());
+
+            HIP_CHECK(
+                hipMemcpy(&output_count, d_output_count, sizeof(size_t), hipMemcpyDeviceToHost));
+            ASSERT_EQ(output_count, expected.size());
+            HIP_CHECK(hipMemcpy(keys_output.data(),
+                                d_keys_output,
+                                output_count * sizeof(key_type),
+                                hipMemcpyDeviceToHost));
+            for(size_t i = 0; i < output_count; i++)
+            {
+                ASSERT_EQ(keys_output[i], expected[i].first) << "where index = " << i;
+            }
+
+            HIP_CHECK(hipFree(d_temporary_storage));
+            HIP_CHECK(hipFree(d_keys_input1));
+            HIP_CHECK(hipFree(d_keys_input2));
+            HIP_CHECK(hipFree(d_keys_output));
+            HIP_CHECK(hipFree(d_values_input1));
+            HIP_CHECK(hipFree(d_values_input2));
+            HIP_CHECK(hipFree(d_values_output));
+            HIP_CHECK(hipFree(d_output_count));
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceSetOperations, SetUnion)
+{
+    test_set_operation<typename TestFixture::params, set_union_tag>();
+}
+
+TYPED_TEST(RocprimDeviceSetOperations, SetIntersection)
+{
+    test_set_operation<typename TestFixture::params, set_intersection_tag>();
+}
+
+TYPED_TEST(RocprimDeviceSetOperations, SetDifference)
+{
+    test_set_operation<typename TestFixture::params, set_difference_tag>();
+}
+
+TYPED_TEST(RocprimDeviceSetOperations, SetSymmetricDifference)
+{
+    test_set_operation<typename TestFixture::params, set_symmetric_difference_tag>();
+}
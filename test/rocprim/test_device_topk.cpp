@@ -0,0 +1,428 @@
+// MIT License
+//
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "common_test_header.hpp"
+
+// required rocprim headers
+#include <rocprim/device/device_segmented_topk.hpp>
+#include <rocprim/device/device_topk.hpp>
+
+// required test headers
+#include "test_utils_types.hpp"
+
+template<class Key, class Value, class Config = rocprim::default_config>
+struct params
+{
+    using key_type   = Key;
+    using value_type = Value;
+    using config     = Config;
+};
+
+template<class Params>
+class RocprimDeviceTopk : public ::testing::Test
+{
+public:
+    using params = Params;
+};
+
+typedef ::testing::Types<params<int, int>,
+                         params<unsigned int, size_t, rocprim::topk_config<4, 64, 3>>,
+                         params<float, int>,
+                         params<double, unsigned int, rocprim::topk_config<6, 128, 2>>,
+                         params<int8_t, int>,
+                         params<uint8_t, int>,
+                         params<unsigned short, int, rocprim::topk_config<8, 256, 1>>,
+                         params<long long, int>>
+    Params;
+
+TYPED_TEST_SUITE(RocprimDeviceTopk, Params);
+
+std::vector<size_t> get_sizes(int seed_value)
+{
+    std::vector<size_t> sizes = {1, 10, 53, 211, 1024, 2345, 4096, 34567, (1 << 16) - 1220};
+    const std::vector<size_t> random_sizes
+        = test_utils::get_random_data<size_t>(3, 1, 100000, seed_value);
+    sizes.insert(sizes.end(), random_sizes.begin(), random_sizes.end());
+    return sizes;
+}
+
+TYPED_TEST(RocprimDeviceTopk, NthElement)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using key_type = typename TestFixture::params::key_type;
+    using config   = typename TestFixture::params::config;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        for(size_t size : get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            // Many duplicates
+            std::vector<key_type> keys
+                = test_utils::get_random_data<key_type>(size, 0, 100, seed_value);
+            std::vector<key_type> sorted_keys(keys);
+            std::sort(sorted_keys.begin(), sorted_keys.end());
+
+            const std::vector<size_t> nths = {0,
+                                              size - 1,
+                                              size / 2,
+                                              test_utils::get_random_value<size_t>(0, size - 1, seed_value)};
+
+            key_type* d_keys;
+            key_type* d_output;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys, size * sizeof(key_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, sizeof(key_type)));
+            HIP_CHECK(
+                hipMemcpy(d_keys, keys.data(), size * sizeof(key_type), hipMemcpyHostToDevice));
+
+            size_t temporary_storage_bytes;
+            HIP_CHECK(rocprim::nth_element<config>(nullptr,
+                                                   temporary_storage_bytes,
+                                                   d_keys,
+                                                   d_output,
+                                                   size,
+                                                   0,
+                                                   stream,
+                                                   debug_synchronous));
+
+            ASSERT_GT(temporary_storage_bytes, 0);
+
+            void* d_temporary_storage;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage,
+                                                         temporary_storage_bytes));
+
+            for(size_t nth : nths)
+            {
+                SCOPED_TRACE(testing::Message() << "with nth = " << nth);
+
+                HIP_CHECK(rocprim::nth_element<config>(d_temporary_storage,
+                                                       temporary_storage_bytes,
+                                                       d_keys,
+                                                       d_output,
+                                                       size,
+                                                       nth,
+                                                       stream,
+                                                       debug_synchronous));
+                HIP_CHECK(hipGetLastError());
+
+                key_type output;
+                HIP_CHECK(hipMemcpy(&output, d_output, sizeof(key_type), hipMemcpyDeviceToHost));
+                ASSERT_EQ(output, sorted_keys[nth]);
+            }
+
+            ASSERT_EQ(rocprim::nth_element<config>(d_temporary_storage,
+                                                   temporary_storage_bytes,
+                                                   d_keys,
+                                                   d_output,
+                                                   size,
+                                                   size,
+                                                   stream,
+                                                   debug_synchronous),
+                      hipErrorInvalidValue);
+
+            HIP_CHECK(hipFree(d_temporary_storage));
+            HIP_CHECK(hipFree(d_keys));
+            HIP_CHECK(hipFree(d_output));
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceTopk, TopkPairs)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using key_type   = typename TestFixture::params::key_type;
+    using value_type = typename TestFixture::params::value_type;
+    using config     = typename TestFixture::params::config;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        for(size_t size : get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            std::vector<key_type> keys = test_utils::get_random_data<key_type>(
+                size,
+                test_utils::numeric_limits<key_type>::min(),
+                test_utils::numeric_limits<key_type>::max(),
+                seed_value);
+            // Values are the indices of the keys, modulo the range of value_type
+            std::vector<value_type> values(size);
+            std::iota(values.begin(), values.end(), value_type(0));
+
+            std::vector<key_type> sorted_keys(keys);
+            std::sort(sorted_keys.begin(), sorted_keys.end(), std::greater<key_type>());
+
+            key_type*   d_keys_input;
+            key_type*   d_keys_output;
+            value_type* d_values_input;
+            value_type* d_values_output;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_input, size * sizeof(key_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_output, size * sizeof(key_type)));
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_values_input, size * sizeof(value_type)));
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_values_output, size * sizeof(value_type)));
+            HIP_CHECK(hipMemcpy(d_keys_input,
+                                keys.data(),
+                                size * sizeof(key_type),
+                                hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemcpy(d_values_input,
+                                values.data(),
+                                size * sizeof(value_type),
+                                hipMemcpyHostToDevice));
+
+            size_t temporary_storage_bytes;
+            HIP_CHECK(rocprim::topk_pairs<config>(nullptr,
+                                                  temporary_storage_bytes,
+                                                  d_keys_input,
+                                                  d_keys_output,
+                                                  d_values_input,
+                                                  d_values_output,
+                                                  size,
+                                                  size,
+                                                  stream,
+                                                  debug_synchronous));
+
+            ASSERT_GT(temporary_storage_bytes, 0);
+
+            void* d_temporary_storage;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage,
+                                                         temporary_storage_bytes));
+
+            for(size_t k : {size_t(1), size_t(1000), size / 3, size, size + 1})
+            {
+                SCOPED_TRACE(testing::Message() << "with k = " << k);
+
+                HIP_CHECK(rocprim::topk_pairs<config>(d_temporary_storage,
+                                                      temporary_storage_bytes,
+                                                      d_keys_input,
+                                                      d_keys_output,
+                                                      d_values_input,
+                                                      d_values_output,
+                                                      size,
+                                                      k,
+                                                      stream,
+                                                      debug_synchronous));
+                HIP_CHECK(hipGetLastError());
+
+                const size_t output_size = std::min(k, size);
+                std::vector<key_type>   keys_output(output_size);
+                std::vector<value_type> values_output(output_size);
+                HIP_CHECK(hipMemcpy(keys_output.data(),
+                                    d_keys_output,
+                                    output_size * sizeof(key_type),
+                                    hipMemcpyDeviceToHost));
+                HIP_CHECK(hipMemcpy(values_output.data(),
+                                    d_values_output,
+                                    output_size * sizeof(value_type),
+                                    hipMemcpyDeviceToHost));
+
+                // The order of the selected pairs is unspecified
+                for(size_t i = 0; i < output_size; i++)
+                {
+                    ASSERT_EQ(keys_output[i], keys[static_cast<size_t>(values_output[i])])
+                        << "where index = " << i;
+                }
+                std::sort(keys_output.begin(), keys_output.end(), std::greater<key_type>());
+                for(size_t i = 0; i < output_size; i++)
+                {
+                    ASSERT_EQ(keys_output[i], sorted_keys[i]) << "where index = " << i;
+                }
+            }
+
+            HIP_CHECK(hipFree(d_temporary_storage));
+            HIP_CHECK(hipFree(d_keys_input));
+            HIP_CHECK(hipFree(d_keys_output));
+            HIP_CHECK(hipFree(d_values_input));
+            HIP_CHECK(hipFree(d_values_output));
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceTopk, SegmentedTopkPairs)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using key_type    = typename TestFixture::params::key_type;
+    using value_type  = typename TestFixture::params::value_type;
+    using config      = typename TestFixture::params::config;
+    using offset_type = unsigned int;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        for(size_t size : get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            std::default_random_engine                  gen(seed_value);
+            std::uniform_int_distribution<offset_type> segment_length_dis(0, 3000);
+
+            std::vector<offset_type> offsets = {0};
+            while(offsets.back() < size)
+            {
+                offsets.push_back(std::min<offset_type>(
+                    static_cast<offset_type>(size), offsets.back() + segment_length_dis(gen)));
+            }
+            const unsigned int segments = static_cast<unsigned int>(offsets.size() - 1);
+
+            // Many duplicates
+            std::vector<key_type> keys
+                = test_utils::get_random_data<key_type>(size, 0, 100, seed_value);
+            std::vector<value_type> values(size);
+            std::iota(values.begin(), values.end(), value_type(0));
+
+            key_type*    d_keys_input;
+            key_type*    d_keys_output;
+            value_type*  d_values_input;
+            value_type*  d_values_output;
+            offset_type* d_offsets;
+            const unsigned int k = 100;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_input, size * sizeof(key_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_output,
+                                                         segments * k * sizeof(key_type)));
+            HIP_CHECK(
+                test_common_utils::hipMallocHelper(&d_values_input, size * sizeof(value_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_values_output,
+                                                         segments * k * sizeof(value_type)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_offsets,
+                                                         offsets.size() * sizeof(offset_type)));
+            HIP_CHECK(hipMemcpy(d_keys_input,
+                                keys.data(),
+                                size * sizeof(key_type),
+                                hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemcpy(d_values_input,
+                                values.data(),
+                                size * sizeof(value_type),
+                                hipMemcpyHostToDevice));
+            HIP_CHECK(hipMemcpy(d_offsets,
+                                offsets.data(),
+                                offsets.size() * sizeof(offset_type),
+                                hipMemcpyHostToDevice));
+
+            size_t temporary_storage_bytes;
+            HIP_CHECK(rocprim::segmented_topk_pairs<config>(nullptr,
+                                                            temporary_storage_bytes,
+                                                            d_keys_input,
+                                                            d_keys_output,
+                                                            d_values_input,
+                                                            d_values_output,
+                                                            segments,
+                                                            d_offsets,
+                                                            d_offsets + 1,
+                                                            k,
+                                                            stream,
+                                                            debug_synchronous));
+
+            ASSERT_GT(temporary_storage_bytes, 0);
+
+            void* d_temporary_storage;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage,
+                                                         temporary_storage_bytes));
+
+            HIP_CHECK(rocprim::segmented_topk_pairs<config>(d_temporary_storage,
+                                                            temporary_storage_bytes,
+                                                            d_keys_input,
+                                                            d_keys_output,
+                                                            d_values_input,
+                                                            d_values_output,
+                                                            segments,
+                                                            d_offsets,
+                                                            d_offsets + 1,
+                                                            k,
+                                                            stream,
+                                                            debug_synchronous));
+            HIP_CHECK(hipGetLastError());
+
+            std::vector<key_type>   keys_output(segments * k);
+            std::vector<value_type> values_output(segments * k);
+            HIP_CHECK(hipMemcpy(keys_output.data(),
+                                d_keys_output,
+                                segments * k * sizeof(key_type),
+                                hipMemcpyDeviceToHost));
+            HIP_CHECK(hipMemcpy(values_output.data(),
+                                d_values_output,
+                                segments * k * sizeof(value_type),
+                                hipMemcpyDeviceToHost));
+
+            for(unsigned int segment = 0; segment < segments; segment++)
+            {
+                SCOPED_TRACE(testing::Message() << "with segment = " << segment);
+
+                // The first k items of a stable descending sort, in their input order
+                std::vector<size_t> indices(offsets[segment + 1] - offsets[segment]);
+                std::iota(indices.begin(), indices.end(), size_t(offsets[segment]));
+                std::stable_sort(indices.begin(),
+                                 indices.end(),
+                                 [&](size_t a, size_t b) { return keys[a] > keys[b]; });
+                indices.resize(std::min<size_t>(indices.size(), k));
+                std::sort(indices.begin(), indices.end());
+
+                for(size_t i = 0; i < indices.size(); i++)
+                {
+                    ASSERT_EQ(keys_output[segment * k + i], keys[indices[i]]) << "where index = " << i;
+                    ASSERT_EQ(values_output[segment * k + i], values[indices[i]])
+                        << "where index = " << i;
+                }
+            }
+
+            HIP_CHECK(hipFree(d_temporary_storage));
+            HIP_CHECK(hipFree(d_keys_input));
+            HIP_CHECK(hipFree(d_keys_output));
+            HIP_CHECK(hipFree(d_values_input));
+            HIP_CHECK(hipFree(d_values_output));
+            HIP_CHECK(hipFree(d_offsets));
+        }
+    }
+}
@@ -0,0 +1,350 @@
+// MIT License
+//
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "common_test_header.hpp"
+
+// required rocprim headers
+#include <rocprim/device/device_partition.hpp>
+#include <rocprim/device/device_radix_sort.hpp>
+#include <rocprim/device/device_reduce.hpp>
+#include <rocprim/device/device_scan.hpp>
+#include <rocprim/device/device_trace.hpp>
+
+// required test headers
+#include "test_utils_types.hpp"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+void collect_record(const rocprim::kernel_trace_record& record, void* user_data)
+{
+    static_cast<std::vector<rocprim::kernel_trace_record>*>(user_data)->push_back(record);
+}
+
+// Sorts size random keys, the records are returned by the callback
+void run_radix_sort(const size_t size, const hipStream_t stream)
+{
+    const std::vector<unsigned int> keys_input
+        = test_utils::get_random_data<unsigned int>(size, 0, 1000000, 0);
+
+    unsigned int* d_keys_input;
+    unsigned int* d_keys_output;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_input, size * sizeof(unsigned int)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_keys_output, size * sizeof(unsigned int)));
+    HIP_CHECK(hipMemcpy(d_keys_input,
+                        keys_input.data(),
+                        size * sizeof(unsigned int),
+                        hipMemcpyHostToDevice));
+
+    size_t temporary_storage_bytes;
+    HIP_CHECK(rocprim::radix_sort_keys(nullptr,
+                                       temporary_storage_bytes,
+                                       d_keys_input,
+                                       d_keys_output,
+                                       size,
+                                       0,
+                                       32,
+                                       stream));
+    void* d_temporary_storage;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage, temporary_storage_bytes));
+    HIP_CHECK(rocprim::radix_sort_keys(d_temporary_storage,
+                                       temporary_storage_bytes,
+                                       d_keys_input,
+                                       d_keys_output,
+                                       size,
+                                       0,
+                                       32,
+                                       stream));
+    HIP_CHECK(hipStreamSynchronize(stream));
+
+    HIP_CHECK(hipFree(d_temporary_storage));
+    HIP_CHECK(hipFree(d_keys_input));
+    HIP_CHECK(hipFree(d_keys_output));
+}
+
+} // namespace
+
+TEST(RocprimDeviceTraceTests, GlobalCallback)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    const hipStream_t stream = 0;
+
+    std::vector<rocprim::kernel_trace_record> records;
+    rocprim::set_kernel_trace(collect_record, &records);
+    run_radix_sort(1 << 20, stream);
+    rocprim::set_kernel_trace(nullptr);
+
+    ASSERT_FALSE(records.empty());
+    bool found_described_launch = false;
+    for(const rocprim::kernel_trace_record& record : records)
+    {
+        ASSERT_NE(std::string(record.name), "");
+        ASSERT_NE(std::string(record.config), "");
+        ASSERT_EQ(record.stream, stream);
+        // Kernels are not timed without events
+        ASSERT_LT(record.elapsed_ms, 0.0f);
+        if(record.grid_size.x > 0 && record.items_per_thread > 0 && record.bytes_read > 0)
+        {
+            found_described_launch = true;
+        }
+    }
+    ASSERT_TRUE(found_described_launch);
+
+    // Nothing is reported once tracing is disabled
+    const size_t count = records.size();
+    run_radix_sort(1 << 20, stream);
+    ASSERT_EQ(records.size(), count);
+}
+
+TEST(RocprimDeviceTraceTests, EventTiming)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    hipStream_t stream;
+    HIP_CHECK(hipStreamCreateWithFlags(&stream, hipStreamNonBlocking));
+
+    std::vector<rocprim::kernel_trace_record> records;
+    {
+        rocprim::kernel_trace_scope scope(collect_record,
+                                          &records,
+                                          rocprim::kernel_trace_timing::events);
+        run_radix_sort(1 << 20, stream);
+        HIP_CHECK(rocprim::flush_kernel_traces());
+    }
+
+    ASSERT_FALSE(records.empty());
+    bool found_timed_launch = false;
+    for(const rocprim::kernel_trace_record& record : records)
+    {
+        ASSERT_EQ(record.stream, stream);
+        if(record.elapsed_ms >= 0.0f)
+        {
+            found_timed_launch = true;
+        }
+    }
+    ASSERT_TRUE(found_timed_launch);
+
+    HIP_CHECK(hipStreamDestroy(stream));
+}
+
+TEST(RocprimDeviceTraceTests, ScopeReportsPendingRecords)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    hipStream_t streams[2];
+    for(hipStream_t& stream : streams)
+    {
+        HIP_CHECK(hipStreamCreateWithFlags(&stream, hipStreamNonBlocking));
+    }
+
+    // The records of both streams are reported when the scope is destroyed, without a flush
+    std::vector<rocprim::kernel_trace_record> records;
+    {
+        rocprim::kernel_trace_scope scope(collect_record,
+                                          &records,
+                                          rocprim::kernel_trace_timing::events);
+        run_radix_sort(1 << 20, streams[0]);
+        run_radix_sort(1 << 20, streams[1]);
+    }
+    const size_t count = records.size();
+    HIP_CHECK(rocprim::flush_kernel_traces());
+    ASSERT_EQ(records.size(), count);
+
+    bool found_timed_launch[2] = {false, false};
+    for(const rocprim::kernel_trace_record& record : records)
+    {
+        for(size_t i = 0; i < 2; i++)
+        {
+            found_timed_launch[i]
+                = found_timed_launch[i] || (record.stream == streams[i] && record.elapsed_ms >= 0.0f);
+        }
+    }
+    ASSERT_TRUE(found_timed_launch[0]);
+    ASSERT_TRUE(found_timed_launch[1]);
+
+    for(const hipStream_t stream : streams)
+    {
+        HIP_CHECK(hipStreamDestroy(stream));
+    }
+}
+
+TEST(RocprimDeviceTraceTests, ScopesOfThreadsReportOwnRecords)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    constexpr size_t thread_count = 4;
+
+    // Every thread has a scope with a sink on its stack, its records are only reported by that
+    // thread, so they are all reported before the scope and the sink are destroyed
+    size_t      counts[thread_count];
+    bool        found_timed_launch[thread_count];
+    bool        foreign_record[thread_count];
+    hipStream_t streams[thread_count];
+
+    std::vector<std::thread> threads;
+    for(size_t t = 0; t < thread_count; t++)
+    {
+        HIP_CHECK(hipStreamCreateWithFlags(&streams[t], hipStreamNonBlocking));
+        threads.emplace_back(
+            [&, t]()
+            {
+                static_cast<void>(hipSetDevice(device_id));
+                std::vector<rocprim::kernel_trace_record> records;
+                {
+                    rocprim::kernel_trace_scope scope(collect_record,
+                                                      &records,
+                                                      rocprim::kernel_trace_timing::events);
+                    run_radix_sort(1 << 20, streams[t]);
+                }
+                counts[t]             = records.size();
+                found_timed_launch[t] = false;
+                foreign_record[t]     = false;
+                for(const rocprim::kernel_trace_record& record : records)
+                {
+                    found_timed_launch[t] = found_timed_launch[t] || record.elapsed_ms >= 0.0f;
+                    foreign_record[t]     = foreign_record[t] || record.stream != streams[t];
+                }
+            });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for(size_t t = 0; t < thread_count; t++)
+    {
+        SCOPED_TRACE(testing::Message() << "with thread = " << t);
+        ASSERT_GT(counts[t], 0);
+        ASSERT_TRUE(found_timed_launch[t]);
+        ASSERT_FALSE(foreign_record[t]);
+        HIP_CHECK(hipStreamDestroy(streams[t]));
+    }
+}
+
+TEST(RocprimDeviceTraceTests, ReduceAndScanDescribeLaunches)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    const size_t           size  = 1 << 20;
+    const std::vector<int> input = test_utils::get_random_data<int>(size, 0, 100, 0);
+    int*                   d_input;
+    int*                   d_output;
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, size * sizeof(int)));
+    HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, size * sizeof(int)));
+    HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(int), hipMemcpyHostToDevice));
+
+    std::vector<rocprim::kernel_trace_record> records;
+    {
+        rocprim::kernel_trace_scope scope(collect_record, &records);
+
+        size_t temporary_storage_bytes;
+        HIP_CHECK(rocprim::reduce(nullptr,
+                                  temporary_storage_bytes,
+                                  d_input,
+                                  d_output,
+                                  size,
+                                  rocprim::plus<int>()));
+        size_t scan_temporary_storage_bytes;
+        HIP_CHECK(rocprim::inclusive_scan(nullptr,
+                                          scan_temporary_storage_bytes,
+                                          d_input,
+                                          d_output,
+                                          size,
+                                          rocprim::plus<int>()));
+        temporary_storage_bytes = std::max(temporary_storage_bytes, scan_temporary_storage_bytes);
+
+        void* d_temporary_storage;
+        HIP_CHECK(
+            test_common_utils::hipMallocHelper(&d_temporary_storage, temporary_storage_bytes));
+        HIP_CHECK(rocprim::reduce(d_temporary_storage,
+                                  temporary_storage_bytes,
+                                  d_input,
+                                  d_output,
+                                  size,
+                                  rocprim::plus<int>()));
+        HIP_CHECK(rocprim::inclusive_scan(d_temporary_storage,
+                                          temporary_storage_bytes,
+                                          d_input,
+                                          d_output,
+                                          size,
+                                          rocprim::plus<int>()));
+        HIP_CHECK(hipDeviceSynchronize());
+        HIP_CHECK(hipFree(d_temporary_storage));
+    }
+
+    ASSERT_FALSE(records.empty());
+    for(const rocprim::kernel_trace_record& record : records)
+    {
+        SCOPED_TRACE(testing::Message() << "with kernel = " << record.name);
+        ASSERT_GT(record.grid_size.x, 0u);
+        ASSERT_GT(record.block_size.x, 0u);
+        ASSERT_GT(record.items_per_thread, 0u);
+        ASSERT_GT(record.bytes_written, size_t(0));
+    }
+
+    HIP_CHECK(hipFree(d_input));
+    HIP_CHECK(hipFree(d_output));
+}
+
+TEST(RocprimDeviceTraceTests, JsonLinesSink)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    std::ostringstream             output;
+    rocprim::json_lines_trace_sink sink(output);
+    {
+        rocprim::kernel_trace_scope scope(rocprim::json_lines_trace_sink::callback, &sink);
+        run_radix_sort(1000, 0);
+    }
+
+    std::istringstream lines(output.str());
+    std::string        line;
+    size_t             line_count = 0;
+    while(std::getline(lines, line))
+    {
+        ASSERT_EQ(line.rfind("{\"kernel\":\"", 0), size_t(0));
+        ASSERT_EQ(line.back(), '}');
+        ASSERT_NE(line.find("\"items\":"), std::string::npos);
+        ASSERT_NE(line.find("\"config\":\""), std::string::npos);
+        ASSERT_NE(line.find("\"grid\":["), std::string::npos);
+        line_count++;
+    }
+    ASSERT_GT(line_count, size_t(0));
+}
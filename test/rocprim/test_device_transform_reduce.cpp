@@ -0,0 +1,292 @@
+// MIT License
+//
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "common_test_header.hpp"
+
+// required rocprim headers
+#include <rocprim/device/device_transform_reduce.hpp>
+#include <rocprim/functional.hpp>
+
+// required test headers
+#include "test_utils_types.hpp"
+
+template<class Input, class Accumulator, class Config = rocprim::default_config>
+struct params
+{
+    using input_type       = Input;
+    using accumulator_type = Accumulator;
+    using config           = Config;
+};
+
+template<class Params>
+class RocprimDeviceTransformReduceTests : public ::testing::Test
+{
+public:
+    using params = Params;
+};
+
+typedef ::testing::Types<
+    params<int, long long>,
+    params<short, int>,
+    params<float, double>,
+    params<unsigned char, unsigned int>,
+    params<int,
+           int,
+           rocprim::reduce_config<256, 16, rocprim::block_reduce_algorithm::default_algorithm, 512>>,
+    params<double,
+           double,
+           rocprim::reduce_config<64, 2, rocprim::block_reduce_algorithm::using_warp_reduce>>>
+    Params;
+
+TYPED_TEST_SUITE(RocprimDeviceTransformReduceTests, Params);
+
+template<class T>
+struct square_op
+{
+    template<class U>
+    ROCPRIM_HOST_DEVICE inline
+    T operator()(const U& value) const
+    {
+        return static_cast<T>(value) * static_cast<T>(value);
+    }
+};
+
+template<class T>
+struct identity_op
+{
+    template<class U>
+    ROCPRIM_HOST_DEVICE inline
+    T operator()(const U& value) const
+    {
+        return static_cast<T>(value);
+    }
+};
+
+std::vector<size_t> get_sizes(int seed_value)
+{
+    std::vector<size_t> sizes = {0, 1, 10, 53, 211, 1024, 2048, 5096, 34567, (1 << 17) - 1220};
+    const std::vector<size_t> random_sizes
+        = test_utils::get_random_data<size_t>(2, 1, 16384, seed_value);
+    sizes.insert(sizes.end(), random_sizes.begin(), random_sizes.end());
+    return sizes;
+}
+
+TYPED_TEST(RocprimDeviceTransformReduceTests, TransformReduce)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using T      = typename TestFixture::params::input_type;
+    using U      = typename TestFixture::params::accumulator_type;
+    using config = typename TestFixture::params::config;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        for(size_t size : get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            std::vector<T> input = test_utils::get_random_data<T>(size, 0, 10, seed_value);
+
+            U expected = U(5);
+            for(const T& value : input)
+            {
+                expected = expected + square_op<U>()(value);
+            }
+
+            T* d_input;
+            U* d_output;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, (size + 1) * sizeof(T)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_output, sizeof(U)));
+            HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(T), hipMemcpyHostToDevice));
+
+            size_t temporary_storage_bytes;
+            HIP_CHECK(rocprim::transform_reduce<config>(nullptr,
+                                                        temporary_storage_bytes,
+                                                        d_input,
+                                                        d_output,
+                                                        U(5),
+                                                        size,
+                                                        square_op<U>(),
+                                                        rocprim::plus<U>(),
+                                                        stream,
+                                                        debug_synchronous));
+
+            ASSERT_GT(temporary_storage_bytes, 0);
+
+            void* d_temporary_storage;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage,
+                                                         temporary_storage_bytes));
+
+            HIP_CHECK(rocprim::transform_reduce<config>(d_temporary_storage,
+                                                        temporary_storage_bytes,
+                                                        d_input,
+                                                        d_output,
+                                                        U(5),
+                                                        size,
+                                                        square_op<U>(),
+                                                        rocprim::plus<U>(),
+                                                        stream,
+                                                        debug_synchronous));
+            HIP_CHECK(hipGetLastError());
+            HIP_CHECK(hipDeviceSynchronize());
+
+            U output;
+            HIP_CHECK(hipMemcpy(&output, d_output, sizeof(U), hipMemcpyDeviceToHost));
+            ASSERT_NO_FATAL_FAILURE(test_utils::assert_near(
+                output, expected, test_utils::precision_threshold<T>::percentage));
+
+            HIP_CHECK(hipFree(d_temporary_storage));
+            HIP_CHECK(hipFree(d_input));
+            HIP_CHECK(hipFree(d_output));
+        }
+    }
+}
+
+TYPED_TEST(RocprimDeviceTransformReduceTests, MultiReduce)
+{
+    int device_id = test_common_utils::obtain_device_from_ctest();
+    SCOPED_TRACE(testing::Message() << "with device_id= " << device_id);
+    HIP_CHECK(hipSetDevice(device_id));
+
+    using T      = typename TestFixture::params::input_type;
+    using U      = typename TestFixture::params::accumulator_type;
+    using config = typename TestFixture::params::config;
+
+    hipStream_t stream = 0;
+
+    const bool debug_synchronous = false;
+
+    // Minimum, maximum, sum and sum of squares
+    const auto reductions = rocprim::make_tuple(
+        rocprim::make_tuple(identity_op<T>(),
+                            rocprim::minimum<T>(),
+                            test_utils::numeric_limits<T>::max()),
+        rocprim::make_tuple(identity_op<T>(),
+                            rocprim::maximum<T>(),
+                            test_utils::numeric_limits<T>::lowest()),
+        rocprim::make_tuple(identity_op<U>(), rocprim::plus<U>(), U(0)),
+        rocprim::make_tuple(square_op<U>(), rocprim::plus<U>(), U(0)));
+
+    for(size_t seed_index = 0; seed_index < random_seeds_count + seed_size; seed_index++)
+    {
+        unsigned int seed_value
+            = seed_index < random_seeds_count ? rand() : seeds[seed_index - random_seeds_count];
+        SCOPED_TRACE(testing::Message() << "with seed= " << seed_value);
+
+        for(size_t size : get_sizes(seed_value))
+        {
+            SCOPED_TRACE(testing::Message() << "with size = " << size);
+
+            std::vector<T> input = test_utils::get_random_data<T>(size, 0, 10, seed_value);
+
+            T expected_min = test_utils::numeric_limits<T>::max();
+            T expected_max = test_utils::numeric_limits<T>::lowest();
+            U expected_sum = U(0);
+            U expected_sum_of_squares = U(0);
+            for(const T& value : input)
+            {
+                expected_min = std::min(expected_min, value);
+                expected_max = std::max(expected_max, value);
+                expected_sum = expected_sum + static_cast<U>(value);
+                expected_sum_of_squares = expected_sum_of_squares + square_op<U>()(value);
+            }
+
+            T* d_input;
+            T* d_min;
+            T* d_max;
+            U* d_sum;
+            U* d_sum_of_squares;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_input, (size + 1) * sizeof(T)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_min, sizeof(T)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_max, sizeof(T)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_sum, sizeof(U)));
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_sum_of_squares, sizeof(U)));
+            HIP_CHECK(hipMemcpy(d_input, input.data(), size * sizeof(T), hipMemcpyHostToDevice));
+
+            const auto outputs = rocprim::make_tuple(d_min, d_max, d_sum, d_sum_of_squares);
+
+            size_t temporary_storage_bytes;
+            HIP_CHECK(rocprim::multi_reduce<config>(nullptr,
+                                                    temporary_storage_bytes,
+                                                    d_input,
+                                                    outputs,
+                                                    size,
+                                                    reductions,
+                                                    stream,
+                                                    debug_synchronous));
+
+            ASSERT_GT(temporary_storage_bytes, 0);
+
+            void* d_temporary_storage;
+            HIP_CHECK(test_common_utils::hipMallocHelper(&d_temporary_storage,
+                                                         temporary_storage_bytes));
+
+            HIP_CHECK(rocprim::multi_reduce<config>(d_temporary_storage,
+                                                    temporary_storage_bytes,
+                                                    d_input,
+                                                    outputs,
+                                                    size,
+                                                    reductions,
+                                                    stream,
+                                                    debug_synchronous));
+            HIP_CHECK(hipGetLastError());
+            HIP_CHECK(hipDeviceSynchronize());
+
+            T output_min;
+            T output_max;
+            U output_sum;
+            U output_sum_of_squares;
+            HIP_CHECK(hipMemcpy(&output_min, d_min, sizeof(T), hipMemcpyDeviceToHost));
+            HIP_CHECK(hipMemcpy(&output_max, d_max, sizeof(T), hipMemcpyDeviceToHost));
+            HIP_CHECK(hipMemcpy(&output_sum, d_sum, sizeof(U), hipMemcpyDeviceToHost));
+            HIP_CHECK(hipMemcpy(&output_sum_of_squares,
+                                d_sum_of_squares,
+                                sizeof(U),
+                                hipMemcpyDeviceToHost));
+            ASSERT_EQ(output_min, expected_min);
+            ASSERT_EQ(output_max, expected_max);
+            ASSERT_NO_FATAL_FAILURE(test_utils::assert_near(
+                output_sum, expected_sum, test_utils::precision_threshold<T>::percentage));
+            ASSERT_NO_FATAL_FAILURE(
+                test_utils::assert_near(output_sum_of_squares,
+                                        expected_sum_of_squares,
+                                        test_utils::precision_threshold<T>::percentage));
+
+            HIP_CHECK(hipFree(d_temporary_storage));
+            HIP_CHECK(hipFree(d_input));
+            HIP_CHECK(hipFree(d_min));
+            HIP_CHECK(hipFree(d_max));
+            HIP_CHECK(hipFree(d_sum));
+            HIP_CHECK(hipFree(d_sum_of_squares));
+        }
+    }
+}